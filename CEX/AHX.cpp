@@ -185,18 +185,20 @@ void AHX::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void AHX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(m_legalKeySizes, KeyParams.Key().size()))
+	SymmetricKeyView keyView(KeyParams);
+
+	if (!SymmetricKeySize::Contains(m_legalKeySizes, keyView.Key().size()))
 		throw CryptoSymmetricCipherException("AHX:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
-	if (m_kdfEngineType != Enumeration::Digests::None && KeyParams.Info().size() > m_kdfInfoMax)
+	if (m_kdfEngineType != Enumeration::Digests::None && keyView.Info().size() > m_kdfInfoMax)
 		throw CryptoSymmetricCipherException("AHX:Initialize", "Invalid info size! Info parameter must be no longer than DistributionCodeMax size.");
 
-	if (KeyParams.Info().size() > 0)
-		m_kdfInfo = KeyParams.Info();
+	if (keyView.Info().size() > 0)
+		m_kdfInfo = keyView.Info();
 
 	m_isEncryption = Encryption;
-	m_cprKeySize = KeyParams.Key().size() * 8;
+	m_cprKeySize = keyView.Key().size() * 8;
 	// expand the key
-	ExpandKey(Encryption, KeyParams.Key());
+	ExpandKey(Encryption, keyView.Key());
 	// ready to transform data
 	m_isInitialized = true;
 }
@@ -439,7 +441,7 @@ void AHX::StandardExpand(const std::vector<byte> &Key)
 	}
 }
 
-void AHX::ExpandRotBlock(std::vector<__m128i> &Key, __m128i* K1, __m128i* K2, __m128i KR, size_t Offset)
+void AHX::ExpandRotBlock(Utility::SecureVector<__m128i> &Key, __m128i* K1, __m128i* K2, __m128i KR, size_t Offset)
 {
 	// 192 bit key expansion method, -requires additional processing
 	__m128i key1 = *K1; 
@@ -470,7 +472,7 @@ void AHX::ExpandRotBlock(std::vector<__m128i> &Key, __m128i* K1, __m128i* K2, __
 	std::memcpy((byte*)Key.data() + Offset, &tmpB[0], 4);
 }
 
-void AHX::ExpandRotBlock(std::vector<__m128i> &Key, const size_t Index, const size_t Offset)
+void AHX::ExpandRotBlock(Utility::SecureVector<__m128i> &Key, const size_t Index, const size_t Offset)
 {
 	// 128, 256, 512 bit key method
 	__m128i pkb = Key[Index - Offset];
@@ -481,7 +483,7 @@ void AHX::ExpandRotBlock(std::vector<__m128i> &Key, const size_t Index, const si
 	Key[Index] = _mm_xor_si128(pkb, Key[Index]);
 }
 
-void AHX::ExpandSubBlock(std::vector<__m128i> &Key, const size_t Index, const size_t Offset)
+void AHX::ExpandSubBlock(Utility::SecureVector<__m128i> &Key, const size_t Index, const size_t Offset)
 {
 	// used with 256 and 512 bit keys
 	__m128i pkb = Key[Index - Offset];
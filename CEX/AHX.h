@@ -37,10 +37,17 @@
 #if defined(__AVX__)
 
 #include "IBlockCipher.h"
+#include "SecureAllocator.h"
 #include <wmmintrin.h>
 
 NAMESPACE_BLOCK
 
+namespace Mode
+{
+	template <class TCipher> class CTRT;
+	template <class TCipher> class ICMT;
+}
+
 /// <summary>
 /// An Rijndael AES-NI configured Cipher extended with an (optional) HKDF powered Key Schedule
 /// </summary> 
@@ -97,6 +104,7 @@ NAMESPACE_BLOCK
 /// <item><description>The internal block size is 16 bytes wide.</description></item>
 /// <item><description>Diffusion rounds assignments are 10 to 38, the default is 22 (128-256 bit key), a 512 bit key is automatically assigned 22 rounds.</description></item>
 /// <item><description>Valid rounds assignments can be found in the <see cref="LegalRounds"/> property.</description></item>
+/// <item><description>The round keys are stored in the page locked <see cref="Utility::SecureArena"/>, and are zeroed when the cipher is destroyed.</description></item>
 /// </list>
 /// 
 /// <description>Guiding Publications:</description>
@@ -116,6 +124,10 @@ class AHX final : public IBlockCipher
 {
 private:
 
+	// the specialized counter modes read the round keys directly
+	friend class Mode::CTRT<AHX>;
+	friend class Mode::ICMT<AHX>;
+
 	static const size_t BLOCK_SIZE = 16;
 	static const std::string CIPHER_NAME;
 	static const std::string CLASS_NAME;
@@ -129,7 +141,7 @@ private:
 	size_t m_cprKeySize;
 	size_t m_blockSize;
 	bool m_destroyEngine;
-	std::vector<__m128i> m_expKey;
+	Utility::SecureVector<__m128i> m_expKey;
 	IDigest* m_kdfEngine;
 	Digests m_kdfEngineType;
 	std::vector<byte> m_kdfInfo;
@@ -385,9 +397,9 @@ private:
 	void Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void Encrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void ExpandKey(bool Encryption, const std::vector<byte> &Key);
-	void ExpandRotBlock(std::vector<__m128i> &Key, __m128i* K1, __m128i* K2, __m128i KR, size_t Offset);
-	void ExpandRotBlock(std::vector<__m128i> &Key, const size_t Index, const size_t Offset);
-	void ExpandSubBlock(std::vector<__m128i> &Key, const size_t Index, const size_t Offset);
+	void ExpandRotBlock(Utility::SecureVector<__m128i> &Key, __m128i* K1, __m128i* K2, __m128i KR, size_t Offset);
+	void ExpandRotBlock(Utility::SecureVector<__m128i> &Key, const size_t Index, const size_t Offset);
+	void ExpandSubBlock(Utility::SecureVector<__m128i> &Key, const size_t Index, const size_t Offset);
 	void LoadState(Digests KdfEngineType);
 	void SecureExpand(const std::vector<byte> &Key);
 	void StandardExpand(const std::vector<byte> &Key);
@@ -0,0 +1,685 @@
+#include "ARGON2.h"
+#include "Blake2B.h"
+#include "Intrinsics.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+
+NAMESPACE_KDF
+
+const std::vector<ulong> ARGON2::BLAKE2B_IV = { 0x6A09E667F3BCC908UL, 0xBB67AE8584CAA73BUL, 0x3C6EF372FE94F82BUL, 0xA54FF53A5F1D36F1UL, 0x510E527FADE682D1UL, 0x9B05688C2B3E6C1FUL, 0x1F83D9ABFB41BD6BUL, 0x5BE0CD19137E2179UL };
+const std::string ARGON2::CLASS_NAME("Argon2id");
+
+//~~~Properties~~~//
+
+const Kdfs ARGON2::Enumeral()
+{
+	return Kdfs::ARGON2;
+}
+
+const bool ARGON2::IsInitialized()
+{
+	return m_isInitialized;
+}
+
+const bool ARGON2::IsParallel()
+{
+	return m_parallelProfile.IsParallel();
+}
+
+size_t ARGON2::MinKeySize()
+{
+	return MIN_SALTLEN;
+}
+
+std::vector<SymmetricKeySize> ARGON2::LegalKeySizes() const
+{
+	return m_legalKeySizes;
+};
+
+const std::string ARGON2::Name()
+{
+	return CLASS_NAME;
+}
+
+ParallelOptions &ARGON2::ParallelProfile()
+{
+	return m_parallelProfile;
+}
+
+std::vector<byte> &ARGON2::Secret()
+{
+	return m_kdfSecret;
+}
+
+//~~~Constructor~~~//
+
+ARGON2::ARGON2(size_t MemoryCost, size_t TimeCost, size_t Parallelism)
+	:
+	m_isDestroyed(false),
+	m_isInitialized(false),
+	m_kdfInfo(0),
+	m_kdfKey(0),
+	m_kdfSalt(0),
+	m_kdfSecret(0),
+	m_legalKeySizes(0),
+	m_memoryMatrix(0),
+	m_argonParameters(MemoryCost, TimeCost, Parallelism),
+	m_parallelProfile(BLOCK_SIZE, false, 0, false)
+{
+	if (TimeCost == 0)
+		throw CryptoKdfException("ARGON2:Ctor", "The time cost must be at least 1!");
+	if (Parallelism > MAX_PARALLEL)
+		throw CryptoKdfException("ARGON2:Ctor", "The parallelism can not exceed 16777215 lanes!");
+
+	Scope();
+}
+
+ARGON2::~ARGON2()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void ARGON2::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_isInitialized = false;
+		m_argonParameters.Reset();
+		m_parallelProfile.Reset();
+
+		Utility::IntUtils::ClearVector(m_kdfInfo);
+		Utility::IntUtils::ClearVector(m_kdfKey);
+		Utility::IntUtils::ClearVector(m_kdfSalt);
+		Utility::IntUtils::ClearVector(m_kdfSecret);
+		Utility::IntUtils::ClearVector(m_legalKeySizes);
+		Utility::IntUtils::ClearVector(m_memoryMatrix);
+	}
+}
+
+size_t ARGON2::Generate(std::vector<byte> &Output)
+{
+	CexAssert(m_isInitialized, "the generator must be initialized before use");
+
+	if (Output.size() < MIN_OUTLEN)
+		throw CryptoKdfException("ARGON2:Generate", "The output size must be at least 4 bytes!");
+
+	return Expand(Output, 0, Output.size());
+}
+
+size_t ARGON2::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length)
+{
+	CexAssert(m_isInitialized, "the generator must be initialized before use");
+	CexAssert(Output.size() - OutOffset >= Length, "the output buffer too small");
+
+	if (Length < MIN_OUTLEN)
+		throw CryptoKdfException("ARGON2:Generate", "The output size must be at least 4 bytes!");
+
+	return Expand(Output, OutOffset, Length);
+}
+
+void ARGON2::Initialize(ISymmetricKey &GenParam)
+{
+	SymmetricKeyView keyView(GenParam);
+
+	if (keyView.Info().size() != 0)
+		Initialize(keyView.Key(), keyView.Nonce(), keyView.Info());
+	else
+		Initialize(keyView.Key(), keyView.Nonce());
+}
+
+void ARGON2::Initialize(const std::vector<byte> &)
+{
+	throw CryptoKdfException("ARGON2:Initialize", "Argon2 requires a salt; use an Initialize function that accepts a salt value!");
+}
+
+void ARGON2::Initialize(const std::vector<byte> &Key, const std::vector<byte> &Salt)
+{
+	if (Salt.size() < MIN_SALTLEN)
+		throw CryptoKdfException("ARGON2:Initialize", "Salt size is too small, must be a minumum of 8 bytes!");
+
+	if (m_isInitialized)
+		Reset();
+
+	m_kdfKey.resize(Key.size());
+	Utility::MemUtils::Copy(Key, 0, m_kdfKey, 0, m_kdfKey.size());
+	m_kdfSalt.resize(Salt.size());
+	Utility::MemUtils::Copy(Salt, 0, m_kdfSalt, 0, m_kdfSalt.size());
+
+	m_isInitialized = true;
+}
+
+void ARGON2::Initialize(const std::vector<byte> &Key, const std::vector<byte> &Salt, const std::vector<byte> &Info)
+{
+	Initialize(Key, Salt);
+
+	m_kdfInfo.resize(Info.size());
+
+	if (Info.size() > 0)
+		Utility::MemUtils::Copy(Info, 0, m_kdfInfo, 0, m_kdfInfo.size());
+}
+
+void ARGON2::ReSeed(const std::vector<byte> &Seed)
+{
+	if (Seed.size() < MIN_SALTLEN)
+		throw CryptoKdfException("ARGON2:ReSeed", "Seed can not be less than 8 bytes in length!");
+
+	m_kdfSalt.resize(Seed.size());
+	Utility::MemUtils::Copy(Seed, 0, m_kdfSalt, 0, Seed.size());
+}
+
+void ARGON2::Reset()
+{
+	Utility::IntUtils::ClearVector(m_kdfInfo);
+	Utility::IntUtils::ClearVector(m_kdfKey);
+	Utility::IntUtils::ClearVector(m_kdfSalt);
+	m_isInitialized = false;
+}
+
+//~~~Private Functions~~~//
+
+#define BLAMKA_G(A, B, C, D, BLAMKA, ROTR, ROT24, ROT16) \
+	A = BLAMKA(A, B); \
+	D = ROTR(XOR(D, A), 32); \
+	C = BLAMKA(C, D); \
+	B = ROT24(XOR(B, C)); \
+	A = BLAMKA(A, B); \
+	D = ROT16(XOR(D, A)); \
+	C = BLAMKA(C, D); \
+	B = ROTR(XOR(B, C), 63);
+
+#if defined(__AVX512__)
+
+#	define XOR(X, Y) _mm512_xor_si512(X, Y)
+#	define BLAMKA512(X, Y) _mm512_add_epi64(_mm512_add_epi64(X, Y), _mm512_slli_epi64(_mm512_mul_epu32(X, Y), 1))
+#	define ROTR512(X, C) _mm512_ror_epi64(X, C)
+#	define ROTR512_24(X) _mm512_ror_epi64(X, 24)
+#	define ROTR512_16(X) _mm512_ror_epi64(X, 16)
+
+void ARGON2::BlaMka(std::vector<ulong> &State, size_t StateOffset)
+{
+	// two independent 16 word groups, one per 256 bit half of each register
+	__m512i A = _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[StateOffset]))), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[StateOffset + 16])), 1);
+	__m512i B = _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[StateOffset + 4]))), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[StateOffset + 20])), 1);
+	__m512i C = _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[StateOffset + 8]))), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[StateOffset + 24])), 1);
+	__m512i D = _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[StateOffset + 12]))), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[StateOffset + 28])), 1);
+
+	BLAMKA_G(A, B, C, D, BLAMKA512, ROTR512, ROTR512_24, ROTR512_16);
+	B = _mm512_permutex_epi64(B, _MM_SHUFFLE(0, 3, 2, 1));
+	C = _mm512_permutex_epi64(C, _MM_SHUFFLE(1, 0, 3, 2));
+	D = _mm512_permutex_epi64(D, _MM_SHUFFLE(2, 1, 0, 3));
+	BLAMKA_G(A, B, C, D, BLAMKA512, ROTR512, ROTR512_24, ROTR512_16);
+	B = _mm512_permutex_epi64(B, _MM_SHUFFLE(2, 1, 0, 3));
+	C = _mm512_permutex_epi64(C, _MM_SHUFFLE(1, 0, 3, 2));
+	D = _mm512_permutex_epi64(D, _MM_SHUFFLE(0, 3, 2, 1));
+
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[StateOffset]), _mm512_castsi512_si256(A));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[StateOffset + 4]), _mm512_castsi512_si256(B));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[StateOffset + 8]), _mm512_castsi512_si256(C));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[StateOffset + 12]), _mm512_castsi512_si256(D));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[StateOffset + 16]), _mm512_extracti64x4_epi64(A, 1));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[StateOffset + 20]), _mm512_extracti64x4_epi64(B, 1));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[StateOffset + 24]), _mm512_extracti64x4_epi64(C, 1));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[StateOffset + 28]), _mm512_extracti64x4_epi64(D, 1));
+}
+
+#	undef XOR
+#	undef BLAMKA512
+#	undef ROTR512
+#	undef ROTR512_24
+#	undef ROTR512_16
+
+#elif defined(__AVX2__)
+
+#	define XOR(X, Y) _mm256_xor_si256(X, Y)
+#	define BLAMKA256(X, Y) _mm256_add_epi64(_mm256_add_epi64(X, Y), _mm256_slli_epi64(_mm256_mul_epu32(X, Y), 1))
+#	define ROTR256(X, C) ((C) == 32 ? _mm256_shuffle_epi32(X, _MM_SHUFFLE(2, 3, 0, 1)) : _mm256_xor_si256(_mm256_srli_epi64(X, 63), _mm256_add_epi64(X, X)))
+#	define ROTR256_24(X) _mm256_shuffle_epi8(X, R24)
+#	define ROTR256_16(X) _mm256_shuffle_epi8(X, R16)
+
+void ARGON2::BlaMka(std::vector<ulong> &State, size_t StateOffset)
+{
+	const __m256i R16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+	const __m256i R24 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+
+	__m256i A = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[StateOffset]));
+	__m256i B = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[StateOffset + 4]));
+	__m256i C = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[StateOffset + 8]));
+	__m256i D = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&State[StateOffset + 12]));
+
+	BLAMKA_G(A, B, C, D, BLAMKA256, ROTR256, ROTR256_24, ROTR256_16);
+	B = _mm256_permute4x64_epi64(B, _MM_SHUFFLE(0, 3, 2, 1));
+	C = _mm256_permute4x64_epi64(C, _MM_SHUFFLE(1, 0, 3, 2));
+	D = _mm256_permute4x64_epi64(D, _MM_SHUFFLE(2, 1, 0, 3));
+	BLAMKA_G(A, B, C, D, BLAMKA256, ROTR256, ROTR256_24, ROTR256_16);
+	B = _mm256_permute4x64_epi64(B, _MM_SHUFFLE(2, 1, 0, 3));
+	C = _mm256_permute4x64_epi64(C, _MM_SHUFFLE(1, 0, 3, 2));
+	D = _mm256_permute4x64_epi64(D, _MM_SHUFFLE(0, 3, 2, 1));
+
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[StateOffset]), A);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[StateOffset + 4]), B);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[StateOffset + 8]), C);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(&State[StateOffset + 12]), D);
+}
+
+#	undef XOR
+#	undef BLAMKA256
+#	undef ROTR256
+#	undef ROTR256_24
+#	undef ROTR256_16
+
+#else
+
+#	define XOR(X, Y) ((X) ^ (Y))
+#	define BLAMKA64(X, Y) ((X) + (Y) + 2 * ((X) & 0xFFFFFFFFULL) * ((Y) & 0xFFFFFFFFULL))
+#	define ROTR64(X, C) Utility::IntUtils::RotFR64(X, C)
+#	define ROTR64_24(X) Utility::IntUtils::RotFR64(X, 24)
+#	define ROTR64_16(X) Utility::IntUtils::RotFR64(X, 16)
+
+void ARGON2::BlaMka(std::vector<ulong> &State, size_t StateOffset)
+{
+	ulong V0 = State[StateOffset];
+	ulong V1 = State[StateOffset + 1];
+	ulong V2 = State[StateOffset + 2];
+	ulong V3 = State[StateOffset + 3];
+	ulong V4 = State[StateOffset + 4];
+	ulong V5 = State[StateOffset + 5];
+	ulong V6 = State[StateOffset + 6];
+	ulong V7 = State[StateOffset + 7];
+	ulong V8 = State[StateOffset + 8];
+	ulong V9 = State[StateOffset + 9];
+	ulong V10 = State[StateOffset + 10];
+	ulong V11 = State[StateOffset + 11];
+	ulong V12 = State[StateOffset + 12];
+	ulong V13 = State[StateOffset + 13];
+	ulong V14 = State[StateOffset + 14];
+	ulong V15 = State[StateOffset + 15];
+
+	BLAMKA_G(V0, V4, V8, V12, BLAMKA64, ROTR64, ROTR64_24, ROTR64_16);
+	BLAMKA_G(V1, V5, V9, V13, BLAMKA64, ROTR64, ROTR64_24, ROTR64_16);
+	BLAMKA_G(V2, V6, V10, V14, BLAMKA64, ROTR64, ROTR64_24, ROTR64_16);
+	BLAMKA_G(V3, V7, V11, V15, BLAMKA64, ROTR64, ROTR64_24, ROTR64_16);
+	BLAMKA_G(V0, V5, V10, V15, BLAMKA64, ROTR64, ROTR64_24, ROTR64_16);
+	BLAMKA_G(V1, V6, V11, V12, BLAMKA64, ROTR64, ROTR64_24, ROTR64_16);
+	BLAMKA_G(V2, V7, V8, V13, BLAMKA64, ROTR64, ROTR64_24, ROTR64_16);
+	BLAMKA_G(V3, V4, V9, V14, BLAMKA64, ROTR64, ROTR64_24, ROTR64_16);
+
+	State[StateOffset] = V0;
+	State[StateOffset + 1] = V1;
+	State[StateOffset + 2] = V2;
+	State[StateOffset + 3] = V3;
+	State[StateOffset + 4] = V4;
+	State[StateOffset + 5] = V5;
+	State[StateOffset + 6] = V6;
+	State[StateOffset + 7] = V7;
+	State[StateOffset + 8] = V8;
+	State[StateOffset + 9] = V9;
+	State[StateOffset + 10] = V10;
+	State[StateOffset + 11] = V11;
+	State[StateOffset + 12] = V12;
+	State[StateOffset + 13] = V13;
+	State[StateOffset + 14] = V14;
+	State[StateOffset + 15] = V15;
+}
+
+#	undef XOR
+#	undef BLAMKA64
+#	undef ROTR64
+#	undef ROTR64_24
+#	undef ROTR64_16
+
+#endif
+
+#undef BLAMKA_G
+
+void ARGON2::Blake2b(const std::vector<byte> &Input, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+{
+	const size_t BLKLEN = 128;
+	Blake2bState state;
+	std::vector<byte> blkBuffer(BLKLEN);
+	std::vector<byte> hashCode(HASH_SIZE);
+	size_t inpOff = 0;
+	size_t inpLen = Input.size();
+
+	// unkeyed sequential parameter block with a variable output length
+	Utility::MemUtils::Copy(BLAKE2B_IV, 0, state.H, 0, state.H.size() * sizeof(ulong));
+	state.H[0] ^= 0x01010000UL ^ static_cast<ulong>(Length);
+
+	while (inpLen > BLKLEN)
+	{
+		Utility::IntUtils::LeIncreaseW(state.T, state.T, BLKLEN);
+		Digest::Blake2B::Compress128(Input, inpOff, state, BLAKE2B_IV);
+		inpOff += BLKLEN;
+		inpLen -= BLKLEN;
+	}
+
+	if (inpLen != 0)
+		Utility::MemUtils::Copy(Input, inpOff, blkBuffer, 0, inpLen);
+
+	Utility::IntUtils::LeIncreaseW(state.T, state.T, inpLen);
+	state.F[0] = ULL_MAX;
+	Digest::Blake2B::Compress128(blkBuffer, 0, state, BLAKE2B_IV);
+
+	Utility::IntUtils::LeULL512ToBlock(state.H, 0, hashCode, 0);
+	Utility::MemUtils::Copy(hashCode, 0, Output, OutOffset, Length);
+	Utility::MemUtils::Clear(hashCode, 0, hashCode.size());
+	Utility::MemUtils::Clear(state.H, 0, state.H.size() * sizeof(ulong));
+}
+
+size_t ARGON2::Expand(std::vector<byte> &Output, size_t OutOffset, size_t Length)
+{
+	const size_t LANES = m_argonParameters.Parallelism;
+	const size_t LANELEN = m_argonParameters.LaneLength;
+	const size_t MTXLEN = m_argonParameters.MemoryBlocks * BLOCK_WORDS;
+	std::vector<byte> blkHash(HASH_SIZE + (2 * sizeof(uint)));
+	std::vector<byte> blkTmp(BLOCK_SIZE);
+	std::vector<byte> tmpH((10 * sizeof(uint)) + m_kdfKey.size() + m_kdfSalt.size() + m_kdfSecret.size() + m_kdfInfo.size());
+	size_t tmpOff = 0;
+
+	// initial hash: H0 = H(p, T, m, t, v, y, |P|, P, |S|, S, |K|, K, |X|, X)
+	Utility::IntUtils::Le32ToBytes(static_cast<uint>(LANES), tmpH, tmpOff);
+	tmpOff += sizeof(uint);
+	Utility::IntUtils::Le32ToBytes(static_cast<uint>(Length), tmpH, tmpOff);
+	tmpOff += sizeof(uint);
+	Utility::IntUtils::Le32ToBytes(static_cast<uint>(m_argonParameters.MemoryCost), tmpH, tmpOff);
+	tmpOff += sizeof(uint);
+	Utility::IntUtils::Le32ToBytes(static_cast<uint>(m_argonParameters.TimeCost), tmpH, tmpOff);
+	tmpOff += sizeof(uint);
+	Utility::IntUtils::Le32ToBytes(ARGON2_VERSION, tmpH, tmpOff);
+	tmpOff += sizeof(uint);
+	Utility::IntUtils::Le32ToBytes(ARGON2_TYPE, tmpH, tmpOff);
+	tmpOff += sizeof(uint);
+	Utility::IntUtils::Le32ToBytes(static_cast<uint>(m_kdfKey.size()), tmpH, tmpOff);
+	tmpOff += sizeof(uint);
+	Utility::MemUtils::Copy(m_kdfKey, 0, tmpH, tmpOff, m_kdfKey.size());
+	tmpOff += m_kdfKey.size();
+	Utility::IntUtils::Le32ToBytes(static_cast<uint>(m_kdfSalt.size()), tmpH, tmpOff);
+	tmpOff += sizeof(uint);
+	Utility::MemUtils::Copy(m_kdfSalt, 0, tmpH, tmpOff, m_kdfSalt.size());
+	tmpOff += m_kdfSalt.size();
+	Utility::IntUtils::Le32ToBytes(static_cast<uint>(m_kdfSecret.size()), tmpH, tmpOff);
+	tmpOff += sizeof(uint);
+	Utility::MemUtils::Copy(m_kdfSecret, 0, tmpH, tmpOff, m_kdfSecret.size());
+	tmpOff += m_kdfSecret.size();
+	Utility::IntUtils::Le32ToBytes(static_cast<uint>(m_kdfInfo.size()), tmpH, tmpOff);
+	tmpOff += sizeof(uint);
+	Utility::MemUtils::Copy(m_kdfInfo, 0, tmpH, tmpOff, m_kdfInfo.size());
+
+	Blake2b(tmpH, blkHash, 0, HASH_SIZE);
+	Utility::MemUtils::Clear(tmpH, 0, tmpH.size());
+
+	// the matrix is retained across derivations and only grows when the memory cost requires it
+	if (m_memoryMatrix.size() < MTXLEN)
+		m_memoryMatrix.resize(MTXLEN);
+
+	// the first two blocks of each lane: B[i][j] = H'(H0 || j || i)
+	for (size_t i = 0; i < LANES; ++i)
+	{
+		for (size_t j = 0; j < 2; ++j)
+		{
+			Utility::IntUtils::Le32ToBytes(static_cast<uint>(j), blkHash, HASH_SIZE);
+			Utility::IntUtils::Le32ToBytes(static_cast<uint>(i), blkHash, HASH_SIZE + sizeof(uint));
+			Hash(blkHash, blkTmp, 0, BLOCK_SIZE);
+			Utility::IntUtils::BlockToLe(blkTmp, 0, m_memoryMatrix, ((i * LANELEN) + j) * BLOCK_WORDS, BLOCK_SIZE);
+		}
+	}
+
+	for (size_t i = 0; i < m_argonParameters.TimeCost; ++i)
+	{
+		for (size_t j = 0; j < SYNC_POINTS; ++j)
+		{
+			// the lanes of a slice are independent, every slice boundary is a synchronization point
+			if (m_parallelProfile.IsParallel() && LANES > 1)
+			{
+				const size_t DEGREE = (LANES < m_parallelProfile.ParallelMaxDegree()) ? LANES : m_parallelProfile.ParallelMaxDegree();
+
+				Utility::ParallelUtils::ParallelFor(0, DEGREE, [this, i, j, DEGREE, LANES](size_t k)
+				{
+					for (size_t l = k; l < LANES; l += DEGREE)
+						FillSegment(i, l, j);
+				});
+			}
+			else
+			{
+				for (size_t k = 0; k < LANES; ++k)
+					FillSegment(i, k, j);
+			}
+		}
+	}
+
+	// xor the last block of each lane and hash to the output length
+	std::vector<ulong> blkFinal(BLOCK_WORDS);
+	Utility::MemUtils::Copy(m_memoryMatrix, (LANELEN - 1) * BLOCK_WORDS, blkFinal, 0, BLOCK_SIZE);
+
+	for (size_t i = 1; i < LANES; ++i)
+		Utility::MemUtils::XorBlock(m_memoryMatrix, ((i * LANELEN) + LANELEN - 1) * BLOCK_WORDS, blkFinal, 0, BLOCK_SIZE);
+
+	Utility::IntUtils::LeToBlock(blkFinal, 0, blkTmp, 0, BLOCK_SIZE);
+	Hash(blkTmp, Output, OutOffset, Length);
+
+	Utility::MemUtils::Clear(blkFinal, 0, BLOCK_SIZE);
+	Utility::MemUtils::Clear(blkHash, 0, blkHash.size());
+	Utility::MemUtils::Clear(blkTmp, 0, blkTmp.size());
+	Utility::MemUtils::Clear(m_memoryMatrix, 0, MTXLEN * sizeof(ulong));
+
+	return Length;
+}
+
+void ARGON2::FillBlock(const std::vector<ulong> &X, size_t XOffset, const std::vector<ulong> &Y, size_t YOffset, std::vector<ulong> &Output, size_t OutOffset, bool XorOutput, std::vector<ulong> &Work)
+{
+#if defined(__AVX512__)
+	const size_t PRMGRP = 2;
+#else
+	const size_t PRMGRP = 1;
+#endif
+	const size_t TMPOFF = BLOCK_WORDS;
+	const size_t COLOFF = 2 * BLOCK_WORDS;
+
+	// R = X ^ Y, Z = R (^ Output)
+	Utility::MemUtils::Copy(X, XOffset, Work, 0, BLOCK_SIZE);
+	Utility::MemUtils::XorBlock(Y, YOffset, Work, 0, BLOCK_SIZE);
+	Utility::MemUtils::Copy(Work, 0, Work, TMPOFF, BLOCK_SIZE);
+
+	if (XorOutput)
+		Utility::MemUtils::XorBlock(Output, OutOffset, Work, TMPOFF, BLOCK_SIZE);
+
+	// permute the eight rows
+	for (size_t i = 0; i < 8; i += PRMGRP)
+		BlaMka(Work, i * 16);
+
+	// permute the eight columns of 128 bit words
+	for (size_t i = 0; i < 8; i += PRMGRP)
+	{
+		for (size_t j = 0; j < PRMGRP; ++j)
+		{
+			for (size_t k = 0; k < 8; ++k)
+			{
+				Work[COLOFF + (j * 16) + (2 * k)] = Work[(2 * (i + j)) + (16 * k)];
+				Work[COLOFF + (j * 16) + (2 * k) + 1] = Work[(2 * (i + j)) + (16 * k) + 1];
+			}
+		}
+
+		BlaMka(Work, COLOFF);
+
+		for (size_t j = 0; j < PRMGRP; ++j)
+		{
+			for (size_t k = 0; k < 8; ++k)
+			{
+				Work[(2 * (i + j)) + (16 * k)] = Work[COLOFF + (j * 16) + (2 * k)];
+				Work[(2 * (i + j)) + (16 * k) + 1] = Work[COLOFF + (j * 16) + (2 * k) + 1];
+			}
+		}
+	}
+
+	Utility::MemUtils::Copy(Work, TMPOFF, Output, OutOffset, BLOCK_SIZE);
+	Utility::MemUtils::XorBlock(Work, 0, Output, OutOffset, BLOCK_SIZE);
+}
+
+void ARGON2::FillSegment(size_t Pass, size_t Lane, size_t Slice)
+{
+	const size_t LANES = m_argonParameters.Parallelism;
+	const size_t LANELEN = m_argonParameters.LaneLength;
+	const size_t SEGLEN = m_argonParameters.SegmentLength;
+	// argon2id: data-independent addressing for the first half of the first pass
+	const bool INDADR = (Pass == 0 && Slice < SYNC_POINTS / 2);
+	std::vector<ulong> work((2 * BLOCK_WORDS) + 32);
+	std::vector<ulong> adrBlock(INDADR ? BLOCK_WORDS : 0);
+	std::vector<ulong> inpBlock(INDADR ? BLOCK_WORDS : 0);
+	std::vector<ulong> zroBlock(INDADR ? BLOCK_WORDS : 0);
+	size_t idx = 0;
+
+	if (INDADR)
+	{
+		inpBlock[0] = Pass;
+		inpBlock[1] = Lane;
+		inpBlock[2] = Slice;
+		inpBlock[3] = m_argonParameters.MemoryBlocks;
+		inpBlock[4] = m_argonParameters.TimeCost;
+		inpBlock[5] = ARGON2_TYPE;
+	}
+
+	if (Pass == 0 && Slice == 0)
+	{
+		// the first two blocks of each lane are already filled
+		idx = 2;
+
+		if (INDADR)
+		{
+			++inpBlock[6];
+			FillBlock(zroBlock, 0, inpBlock, 0, adrBlock, 0, false, work);
+			FillBlock(zroBlock, 0, adrBlock, 0, adrBlock, 0, false, work);
+		}
+	}
+
+	size_t curOff = (Lane * LANELEN) + (Slice * SEGLEN) + idx;
+	size_t prvOff = (curOff % LANELEN == 0) ? curOff + LANELEN - 1 : curOff - 1;
+
+	for (; idx < SEGLEN; ++idx, ++curOff, ++prvOff)
+	{
+		ulong psdRnd;
+
+		if (curOff % LANELEN == 1)
+			prvOff = curOff - 1;
+
+		if (INDADR)
+		{
+			if (idx % BLOCK_WORDS == 0)
+			{
+				++inpBlock[6];
+				FillBlock(zroBlock, 0, inpBlock, 0, adrBlock, 0, false, work);
+				FillBlock(zroBlock, 0, adrBlock, 0, adrBlock, 0, false, work);
+			}
+
+			psdRnd = adrBlock[idx % BLOCK_WORDS];
+		}
+		else
+		{
+			psdRnd = m_memoryMatrix[prvOff * BLOCK_WORDS];
+		}
+
+		const size_t REFLANE = (Pass == 0 && Slice == 0) ? Lane : static_cast<size_t>((psdRnd >> 32) % LANES);
+		const size_t REFIDX = IndexAlpha(Pass, Slice, idx, psdRnd & 0xFFFFFFFFULL, REFLANE == Lane);
+
+		FillBlock(m_memoryMatrix, prvOff * BLOCK_WORDS, m_memoryMatrix, ((REFLANE * LANELEN) + REFIDX) * BLOCK_WORDS, m_memoryMatrix, curOff * BLOCK_WORDS, Pass != 0, work);
+	}
+}
+
+void ARGON2::Hash(const std::vector<byte> &Input, std::vector<byte> &Output, size_t OutOffset, size_t Length)
+{
+	// the variable length hash function H'
+	std::vector<byte> tmpInp(sizeof(uint) + Input.size());
+	Utility::IntUtils::Le32ToBytes(static_cast<uint>(Length), tmpInp, 0);
+	Utility::MemUtils::Copy(Input, 0, tmpInp, sizeof(uint), Input.size());
+
+	if (Length <= HASH_SIZE)
+	{
+		Blake2b(tmpInp, Output, OutOffset, Length);
+	}
+	else
+	{
+		const size_t HLFLEN = HASH_SIZE / 2;
+		std::vector<byte> tmpV(HASH_SIZE);
+		size_t rmdLen = Length - HLFLEN;
+
+		Blake2b(tmpInp, tmpV, 0, HASH_SIZE);
+		Utility::MemUtils::Copy(tmpV, 0, Output, OutOffset, HLFLEN);
+		OutOffset += HLFLEN;
+
+		while (rmdLen > HASH_SIZE)
+		{
+			Blake2b(tmpV, tmpV, 0, HASH_SIZE);
+			Utility::MemUtils::Copy(tmpV, 0, Output, OutOffset, HLFLEN);
+			OutOffset += HLFLEN;
+			rmdLen -= HLFLEN;
+		}
+
+		Blake2b(tmpV, Output, OutOffset, rmdLen);
+		Utility::MemUtils::Clear(tmpV, 0, tmpV.size());
+	}
+
+	Utility::MemUtils::Clear(tmpInp, 0, tmpInp.size());
+}
+
+size_t ARGON2::IndexAlpha(size_t Pass, size_t Slice, size_t Index, ulong PseudoRand, bool SameLane)
+{
+	const size_t LANELEN = m_argonParameters.LaneLength;
+	const size_t SEGLEN = m_argonParameters.SegmentLength;
+	ulong refArea;
+
+	// the number of blocks that may be referenced from this position
+	if (Pass == 0)
+	{
+		if (Slice == 0)
+			refArea = Index - 1;
+		else if (SameLane)
+			refArea = (Slice * SEGLEN) + Index - 1;
+		else
+			refArea = (Slice * SEGLEN) - ((Index == 0) ? 1 : 0);
+	}
+	else
+	{
+		if (SameLane)
+			refArea = LANELEN - SEGLEN + Index - 1;
+		else
+			refArea = LANELEN - SEGLEN - ((Index == 0) ? 1 : 0);
+	}
+
+	// map the pseudo-random value non-uniformly onto the reference area
+	ulong relPos = (PseudoRand * PseudoRand) >> 32;
+	relPos = refArea - 1 - ((refArea * relPos) >> 32);
+
+	const size_t STRPOS = (Pass != 0 && Slice != SYNC_POINTS - 1) ? (Slice + 1) * SEGLEN : 0;
+
+	return static_cast<size_t>((STRPOS + relPos) % LANELEN);
+}
+
+void ARGON2::Scope()
+{
+	// enable/disable multi-threading
+	m_parallelProfile.IsParallel() = (m_argonParameters.Parallelism != 1);
+
+	// auto-set the lanes to the processor count
+	if (m_argonParameters.Parallelism == 0)
+		m_argonParameters.Parallelism = m_parallelProfile.ParallelMaxDegree();
+
+	if (m_argonParameters.MemoryCost < 2 * SYNC_POINTS * m_argonParameters.Parallelism)
+		throw CryptoKdfException("ARGON2:Ctor", "The memory cost must be at least 8 times the parallelism!");
+
+	// round the memory down to a multiple of the lanes and sync points
+	m_argonParameters.SegmentLength = m_argonParameters.MemoryCost / (m_argonParameters.Parallelism * SYNC_POINTS);
+	m_argonParameters.LaneLength = m_argonParameters.SegmentLength * SYNC_POINTS;
+	m_argonParameters.MemoryBlocks = m_argonParameters.LaneLength * m_argonParameters.Parallelism;
+
+	m_legalKeySizes.resize(3);
+	// minimum salt size
+	m_legalKeySizes[0] = SymmetricKeySize(0, MIN_SALTLEN, 0);
+	// recommended salt size
+	m_legalKeySizes[1] = SymmetricKeySize(HASH_SIZE / 2, HASH_SIZE / 4, 0);
+	// max recommended
+	m_legalKeySizes[2] = SymmetricKeySize(HASH_SIZE, HASH_SIZE / 2, 0);
+}
+
+NAMESPACE_KDFEND
@@ -0,0 +1,328 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// An implementation of the Argon2id memory-hard Key Derivation Function (RFC 9106), version 0x13.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_ARGON2_H
+#define CEX_ARGON2_H
+
+#include "IKdf.h"
+#include "ParallelOptions.h"
+
+NAMESPACE_KDF
+
+using Common::ParallelOptions;
+
+/// <summary>
+/// An implementation of the memory-hard Key Derivation Function: Argon2id
+/// </summary>
+///
+/// <example>
+/// <description>Generate an array of pseudo random bytes:</description>
+/// <code>
+/// // 64 MiB of memory, 3 passes, 4 lanes
+/// ARGON2 kdf(65536, 3, 4);
+/// // initialize
+/// kdf.Initialize(Key, Salt, [Info]);
+/// // generate bytes
+/// kdf.Generate(Output, [Offset], [Size]);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description><B>Overview:</B></description>
+/// <para>Argon2 is the winner of the Password Hashing Competition, designed by Alex Biryukov, Daniel Dinu, and Dmitry Khovratovich. \n
+/// Argon2id is the hybrid variant; the first half of the first pass uses data-independent memory addressing (Argon2i) to resist side-channel attacks,
+/// the remaining slices use data-dependent addressing (Argon2d) to resist time-memory trade-off attacks. \n
+/// The memory matrix is divided into lanes that are filled concurrently, each lane is divided into four slices, and the lanes are synchronized at every slice boundary.</para>
+///
+/// <description><B>Description:</B></description> \n
+/// <EM>Legend:</EM> \n
+/// <B>P</B>=passphrase, <B>S</B>=salt, <B>K</B>=secret, <B>X</B>=associated data, <B>p</B>=lanes, <B>m</B>=memory cost, <B>t</B>=passes, <B>T</B>=tag length \n
+/// <para><EM>Generate:</EM> \n
+/// 1) H0 = Blake2b(p || T || m || t || v || y || |P| || P || |S| || S || |K| || K || |X| || X) \n
+/// 2) B[i][0] = H'(H0 || 0 || i), B[i][1] = H'(H0 || 1 || i) \n
+/// 3) B[i][j] = G(B[i][j-1], B[l][z]), where [l][z] is selected by the Argon2id indexing function \n
+/// 4) on subsequent passes, B[i][j] = G(B[i][j-1], B[l][z]) ^ B[i][j] \n
+/// 5) Tag = H'(B[0][q-1] ^ B[1][q-1] ^ ... ^ B[p-1][q-1])</para>
+///
+/// <description><B>Implementation Notes:</B></description>
+/// <list type="bullet">
+/// <item><description>The Key is the passphrase, the Salt (or SymmetricKey Nonce) is the salt, and the Info string is the associated data.</description></item>
+/// <item><description>An optional secret value (a server-side pepper) can be set through the Secret() property.</description></item>
+/// <item><description>The output size of each call to Generate is the Argon2 tag length; the minimum output size is 4 bytes.</description></item>
+/// <item><description>The Blake2b compression function is shared with the Blake512 digest; the BlaMka permutation uses AVX2 and AVX512 intrinsics when available.</description></item>
+/// <item><description>Lanes are processed in parallel by the thread pool, the number of threads is capped by the ParallelProfile() maximum degree.</description></item>
+/// <item><description>The memory matrix is retained between calls to Generate, so repeated derivations do not re-allocate; it is wiped after each derivation and released by Destroy().</description></item>
+/// <item><description>The generator must be initialized with a key and salt using one of the Initialize() functions before output can be generated.</description></item>
+/// </list>
+///
+/// <description><B>Guiding Publications:</B></description>
+/// <list type="number">
+/// <item><description>RFC 9106: <a href="https://tools.ietf.org/html/rfc9106">Argon2 Memory-Hard Function for Password Hashing and Proof-of-Work Applications</a>.</description></item>
+/// <item><description>Argon2: <a href="https://github.com/P-H-C/phc-winner-argon2/blob/master/argon2-specs.pdf">the memory-hard function for password hashing and other applications</a>.</description></item>
+/// </list>
+/// </remarks>
+class ARGON2 : public IKdf
+{
+private:
+
+	struct Argon2Parameters
+	{
+		size_t LaneLength;
+		size_t MemoryBlocks;
+		size_t MemoryCost;
+		size_t Parallelism;
+		size_t SegmentLength;
+		size_t TimeCost;
+
+		explicit Argon2Parameters(size_t Memory, size_t Time, size_t Parallel)
+			:
+			LaneLength(0),
+			MemoryBlocks(0),
+			MemoryCost(Memory),
+			Parallelism(Parallel),
+			SegmentLength(0),
+			TimeCost(Time)
+		{}
+
+		void Reset()
+		{
+			LaneLength = 0;
+			MemoryBlocks = 0;
+			MemoryCost = 0;
+			Parallelism = 0;
+			SegmentLength = 0;
+			TimeCost = 0;
+		}
+	};
+
+	struct Blake2bState
+	{
+		std::vector<ulong> F;
+		std::vector<ulong> H;
+		std::vector<ulong> T;
+
+		Blake2bState()
+			:
+			F(2),
+			H(8),
+			T(2)
+		{
+		}
+	};
+
+	static const std::vector<ulong> BLAKE2B_IV;
+	static const std::string CLASS_NAME;
+	static const size_t BLOCK_SIZE = 1024;
+	static const size_t BLOCK_WORDS = 128;
+	static const size_t HASH_SIZE = 64;
+	static const size_t MAX_PARALLEL = 0x00FFFFFF;
+	static const size_t MIN_OUTLEN = 4;
+	static const size_t MIN_SALTLEN = 8;
+	static const size_t SYNC_POINTS = 4;
+	static const uint ARGON2_TYPE = 2;
+	static const uint ARGON2_VERSION = 0x13;
+	static const ulong ULL_MAX = 18446744073709551615ULL;
+
+	bool m_isDestroyed;
+	bool m_isInitialized;
+	std::vector<byte> m_kdfInfo;
+	std::vector<byte> m_kdfKey;
+	std::vector<byte> m_kdfSalt;
+	std::vector<byte> m_kdfSecret;
+	std::vector<SymmetricKeySize> m_legalKeySizes;
+	std::vector<ulong> m_memoryMatrix;
+	Argon2Parameters m_argonParameters;
+	ParallelOptions m_parallelProfile;
+
+public:
+
+	ARGON2(const ARGON2&) = delete;
+	ARGON2& operator=(const ARGON2&) = delete;
+	ARGON2& operator=(ARGON2&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The Kdf generators type name
+	/// </summary>
+	const Kdfs Enumeral() override;
+
+	/// <summary>
+	/// Get: Generator is ready to produce random
+	/// </summary>
+	const bool IsInitialized() override;
+
+	/// <summary>
+	/// Get: Processor parallelization availability.
+	/// <para>Indicates whether the lanes are processed concurrently.
+	/// The maximum number of threads can be modified through the ParallelProfile() accessor.</para>
+	/// </summary>
+	const bool IsParallel();
+
+	/// <summary>
+	/// Minimum recommended initialization key size in bytes.
+	/// <para>RFC 9106 places no lower bound on the passphrase length; this is the minimum salt size.</para>
+	/// </summary>
+	size_t MinKeySize() override;
+
+	/// <summary>
+	/// Get: Available Kdf Key Sizes in bytes
+	/// </summary>
+	std::vector<SymmetricKeySize> LegalKeySizes() const  override;
+
+	/// <summary>
+	/// Get: The Kdf generators class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Get/Set: Parallel capability flags and sizes
+	/// <para>The maximum number of threads allocated when using multi-threaded processing can be set with the ParallelMaxDegree() property.</para>
+	/// </summary>
+	ParallelOptions &ParallelProfile();
+
+	/// <summary>
+	/// Get/Set: The optional secret value (K) added to the initial hash.
+	/// <para>Used as a server-side pepper; the secret is retained by Reset() and cleared by Destroy().</para>
+	/// </summary>
+	std::vector<byte> &Secret();
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Instantiates an Argon2id generator
+	/// </summary>
+	///
+	/// <param name="MemoryCost">The memory cost in kibibytes; the minimum legal size is 8 times the Parallelism value.
+	/// <para>The default is 65536, or 64 MiB of memory.</para></param>
+	/// <param name="TimeCost">The number of passes over the memory matrix; the minimum is 1, the default value is 3.</param>
+	/// <param name="Parallelism">The number of lanes; the lanes are processed concurrently by the thread pool.
+	/// <para>Setting this value to 0 will automatically use the number of system processor cores, the default value is 4.</para></param>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if invalid parameters are used</exception>
+	explicit ARGON2(size_t MemoryCost = 65536, size_t TimeCost = 3, size_t Parallelism = 4);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~ARGON2() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Generate a block of pseudo random bytes
+	/// </summary>
+	///
+	/// <param name="Output">Output array filled with random bytes; the array size is the tag length</param>
+	///
+	/// <returns>The number of bytes generated</returns>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if the output size is less than 4 bytes</exception>
+	size_t Generate(std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Generate pseudo random bytes using offset and length parameters
+	/// </summary>
+	///
+	/// <param name="Output">Output array filled with random bytes</param>
+	/// <param name="OutOffset">The starting position within the Output array</param>
+	/// <param name="Length">The number of bytes to generate; this is the tag length</param>
+	///
+	/// <returns>The number of bytes generated</returns>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if the output size is less than 4 bytes</exception>
+	size_t Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length) override;
+
+	/// <summary>
+	/// Initialize the generator with a SymmetricKey structure containing the passphrase, salt (nonce), and optional associated data (info).
+	/// </summary>
+	///
+	/// <param name="GenParam">The SymmetricKey containing the generators keying material</param>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if the salt is too small</exception>
+	void Initialize(ISymmetricKey &GenParam) override;
+
+	/// <summary>
+	/// Initialize the generator with a key.
+	/// <para>Argon2 requires a salt; use one of the Initialize functions that accepts a salt value.</para>
+	/// </summary>
+	///
+	/// <param name="Key">The primary key array used to seed the generator</param>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if called without a salt</exception>
+	void Initialize(const std::vector<byte> &Key) override;
+
+	/// <summary>
+	/// Initialize the generator with passphrase and salt arrays
+	/// </summary>
+	///
+	/// <param name="Key">The passphrase array used to seed the generator; as in RFC 9106, the passphrase may be empty</param>
+	/// <param name="Salt">The salt value; the minimum size is 8 bytes</param>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if the salt is too small</exception>
+	void Initialize(const std::vector<byte> &Key, const std::vector<byte> &Salt) override;
+
+	/// <summary>
+	/// Initialize the generator with a passphrase, a salt array, and the associated data
+	/// </summary>
+	///
+	/// <param name="Key">The passphrase array used to seed the generator; as in RFC 9106, the passphrase may be empty</param>
+	/// <param name="Salt">The salt value; the minimum size is 8 bytes</param>
+	/// <param name="Info">The associated data (X) added to the initial hash</param>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if the salt is too small</exception>
+	void Initialize(const std::vector<byte> &Key, const std::vector<byte> &Salt, const std::vector<byte> &Info) override;
+
+	/// <summary>
+	/// Update the generators salt value
+	/// </summary>
+	///
+	/// <param name="Seed">The new salt value array</param>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if the seed is too small</exception>
+	void ReSeed(const std::vector<byte> &Seed) override;
+
+	/// <summary>
+	/// Reset the internal state; Kdf must be re-initialized before it can be used again
+	/// </summary>
+	void Reset() override;
+
+private:
+
+	static void BlaMka(std::vector<ulong> &State, size_t StateOffset);
+	static void Blake2b(const std::vector<byte> &Input, std::vector<byte> &Output, size_t OutOffset, size_t Length);
+	size_t Expand(std::vector<byte> &Output, size_t OutOffset, size_t Length);
+	static void FillBlock(const std::vector<ulong> &X, size_t XOffset, const std::vector<ulong> &Y, size_t YOffset, std::vector<ulong> &Output, size_t OutOffset, bool XorOutput, std::vector<ulong> &Work);
+	void FillSegment(size_t Pass, size_t Lane, size_t Slice);
+	static void Hash(const std::vector<byte> &Input, std::vector<byte> &Output, size_t OutOffset, size_t Length);
+	size_t IndexAlpha(size_t Pass, size_t Slice, size_t Index, ulong PseudoRand, bool SameLane);
+	void Scope();
+};
+
+NAMESPACE_KDFEND
+#endif
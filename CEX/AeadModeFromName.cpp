@@ -2,7 +2,12 @@
 #include "BlockCipherFromName.h"
 #include "EAX.h"
 #include "GCM.h"
+#include "GCMT.h"
 #include "OCB.h"
+#include "CpuDetect.h"
+#if defined(__AVX__)
+#	include "AHX.h"
+#endif
 
 NAMESPACE_HELPER
 
@@ -32,6 +37,18 @@ IAeadMode* AeadModeFromName::GetInstance(AeadModes CipherType, BlockCiphers Engi
 {
 	try
 	{
+#if defined(__AVX__)
+		// the AES-NI GCM mode is specialized on the cipher type; the rounds match those set by BlockCipherFromName
+		Common::CpuDetect detect;
+		if (CipherType == Enumeration::AeadModes::GCM && detect.AESNI())
+		{
+			if (EngineType == BlockCiphers::AHX)
+				return new Cipher::Symmetric::Block::Mode::GCMT<Cipher::Symmetric::Block::AHX>(Enumeration::Digests::SHA256, 22);
+			else if (EngineType == BlockCiphers::Rijndael)
+				return new Cipher::Symmetric::Block::Mode::GCMT<Cipher::Symmetric::Block::AHX>();
+		}
+#endif
+
 		IBlockCipher* cipher = BlockCipherFromName::GetInstance(EngineType);
 
 		switch (CipherType)
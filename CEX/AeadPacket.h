@@ -0,0 +1,149 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_AEADPACKET_H
+#define CEX_AEADPACKET_H
+
+#include "CexDomain.h"
+
+NAMESPACE_MODE
+
+/// <summary>
+/// A packet descriptor used by the batch Seal and Open functions of the AEAD cipher modes.
+/// <para>The descriptor does not own its arrays; they must remain valid for the duration of the batch call.
+/// Input and Output may reference the same array, in which case the packet is transformed in place.
+/// If a packet fails authentication its output is zeroed, unless the output overlaps the input, in which case the cipher-text is left intact.</para>
+/// </summary>
+struct AeadPacket
+{
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// The optional associated data authenticated with the packet; may be null
+	/// </summary>
+	const std::vector<byte>* AssociatedData;
+
+	/// <summary>
+	/// The array containing the plain-text (Seal), or the cipher-text (Open)
+	/// </summary>
+	const std::vector<byte>* Input;
+
+	/// <summary>
+	/// The starting offset within the input array
+	/// </summary>
+	size_t InOffset;
+
+	/// <summary>
+	/// The number of message bytes to transform
+	/// </summary>
+	size_t Length;
+
+	/// <summary>
+	/// The packets unique nonce
+	/// </summary>
+	const std::vector<byte>* Nonce;
+
+	/// <summary>
+	/// The array receiving the cipher-text (Seal), or the plain-text (Open)
+	/// </summary>
+	std::vector<byte>* Output;
+
+	/// <summary>
+	/// The starting offset within the output array
+	/// </summary>
+	size_t OutOffset;
+
+	/// <summary>
+	/// The array receiving the authentication tag (Seal), or containing the expected tag (Open)
+	/// </summary>
+	std::vector<byte>* Tag;
+
+	/// <summary>
+	/// The starting offset within the tag array
+	/// </summary>
+	size_t TagOffset;
+
+	/// <summary>
+	/// Set by the Open function; true if the packets tag is authentic
+	/// </summary>
+	bool Verified;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// An empty packet descriptor
+	/// </summary>
+	AeadPacket()
+		:
+		AssociatedData(nullptr),
+		Input(nullptr),
+		InOffset(0),
+		Length(0),
+		Nonce(nullptr),
+		Output(nullptr),
+		OutOffset(0),
+		Tag(nullptr),
+		TagOffset(0),
+		Verified(false)
+	{
+	}
+
+	/// <summary>
+	/// Initialize the packet descriptor
+	/// </summary>
+	///
+	/// <param name="Nonce">The packets unique nonce</param>
+	/// <param name="Input">The array containing the plain-text (Seal), or the cipher-text (Open)</param>
+	/// <param name="InOffset">The starting offset within the input array</param>
+	/// <param name="Output">The array receiving the cipher-text (Seal), or the plain-text (Open)</param>
+	/// <param name="OutOffset">The starting offset within the output array</param>
+	/// <param name="Length">The number of message bytes to transform</param>
+	/// <param name="Tag">The array receiving, or containing the authentication tag</param>
+	/// <param name="TagOffset">The starting offset within the tag array</param>
+	/// <param name="AssociatedData">The optional associated data; may be null</param>
+	AeadPacket(const std::vector<byte> &Nonce, const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t Length,
+		std::vector<byte> &Tag, size_t TagOffset, const std::vector<byte>* AssociatedData = nullptr)
+		:
+		AssociatedData(AssociatedData),
+		Input(&Input),
+		InOffset(InOffset),
+		Length(Length),
+		Nonce(&Nonce),
+		Output(&Output),
+		OutOffset(OutOffset),
+		Tag(&Tag),
+		TagOffset(TagOffset),
+		Verified(false)
+	{
+	}
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Tests if the output range overlaps the input range of the same array
+	/// </summary>
+	///
+	/// <returns>Returns true if the packet is transformed in place</returns>
+	bool IsInPlace() const
+	{
+		return (Output == Input && InOffset < OutOffset + Length && OutOffset < InOffset + Length);
+	}
+};
+
+NAMESPACE_MODEEND
+#endif
@@ -37,7 +37,19 @@ enum class AsymmetricEngines : byte
 	/// <summary>
 	/// A Supersingular Isogeny Diffie Hellman implementation
 	/// </summary>
-	SIDH = 6
+	SIDH = 6,
+	/// <summary>
+	/// A SPHINCS+ hash based signature scheme implementation
+	/// </summary>
+	SphincsPlus = 7,
+	/// <summary>
+	/// A Dilithium lattice based signature scheme implementation
+	/// </summary>
+	Dilithium = 8,
+	/// <summary>
+	/// A Module-LWE (Kyber) key encapsulation implementation
+	/// </summary>
+	ModuleLWE = 9
 };
 
 NAMESPACE_ENUMERATIONEND
@@ -0,0 +1,1183 @@
+#include "AsyncFileStream.h"
+#include "MemUtils.h"
+#include <cstring>
+
+#if defined(CEX_OS_WINDOWS)
+#	include <Windows.h>
+#	include <malloc.h>
+#elif defined(CEX_OS_LINUX) || defined(CEX_OS_UNIX) || defined(CEX_OS_POSIX) || defined(CEX_OS_ANDROID) || defined(CEX_OS_APPLE)
+#	include <errno.h>
+#	include <fcntl.h>
+#	include <stdlib.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#	define CEX_ASYNCFILE_POSIX
+#	if defined(CEX_OS_LINUX) && defined(__has_include)
+#		if __has_include(<linux/io_uring.h>)
+#			include <linux/io_uring.h>
+#			include <sys/mman.h>
+#			include <sys/syscall.h>
+#			include <sys/uio.h>
+			// the read and write opcodes were added in 5.6; the 5.7 feature flag marks a header that has them
+#			if defined(__NR_io_uring_setup) && defined(IORING_FEAT_FAST_POLL)
+#				define CEX_ASYNCFILE_URING
+#			endif
+#		endif
+#	endif
+#endif
+
+NAMESPACE_IO
+
+const std::string AsyncFileStream::CLASS_NAME("AsyncFileStream");
+
+//~~~Properties~~~//
+
+const AsyncFileStream::FileAccess AsyncFileStream::Access()
+{
+	return m_fileAccess;
+}
+
+const size_t AsyncFileStream::BlockSize()
+{
+	return m_blockSize;
+}
+
+const bool AsyncFileStream::CanRead()
+{
+	return m_fileAccess == FileAccess::Read;
+}
+
+const bool AsyncFileStream::CanSeek()
+{
+	return m_fileAccess == FileAccess::Read;
+}
+
+const bool AsyncFileStream::CanWrite()
+{
+	return m_fileAccess == FileAccess::Write;
+}
+
+const StreamModes AsyncFileStream::Enumeral()
+{
+	return StreamModes::AsyncFileStream;
+}
+
+std::string AsyncFileStream::FileName()
+{
+	return m_fileName;
+}
+
+const bool AsyncFileStream::IsDirect()
+{
+	return m_isDirect;
+}
+
+const bool AsyncFileStream::IsUring()
+{
+	return m_isUring;
+}
+
+const ulong AsyncFileStream::Length()
+{
+	return m_fileSize;
+}
+
+const std::string AsyncFileStream::Name()
+{
+	return CLASS_NAME;
+}
+
+const ulong AsyncFileStream::Position()
+{
+	return m_filePosition;
+}
+
+const size_t AsyncFileStream::QueueDepth()
+{
+	return m_ioSlots.size();
+}
+
+//~~~Constructor~~~//
+
+AsyncFileStream::AsyncFileStream(const std::string &FileName, FileAccess Access, size_t BlockSize, size_t QueueDepth, bool Direct, bool Pooled)
+	:
+	m_blockSize(BlockSize),
+	m_bufferBase(nullptr),
+	m_completeSignal(),
+	m_fileAccess(Access),
+	m_fileHandle(-1),
+	m_fileName(FileName),
+	m_filePosition(0),
+	m_fileReserved(0),
+	m_fileSize(0),
+	m_ioOffset(0),
+	m_ioSlots(0),
+	m_isDestroyed(false),
+	m_isDirect(Direct),
+	m_isFixed(false),
+	m_isStopping(false),
+	m_isUring(false),
+	m_queueMutex(),
+	m_queueSignal(),
+	m_queuedSlots(),
+	m_ringState(),
+	m_slotIndex(0),
+	m_slotPosition(0),
+	m_workerThreads()
+{
+	m_ringState.Handle = -1;
+
+	if (BlockSize == 0 || BlockSize % DIRECT_ALIGN != 0)
+	{
+		throw CryptoProcessingException("AsyncFileStream:CTor", "The block size must be a non-zero multiple of 4096!");
+	}
+	if (QueueDepth == 0 || QueueDepth > MAX_QUEUEDEPTH)
+	{
+		throw CryptoProcessingException("AsyncFileStream:CTor", "The queue depth must be between 1 and 64!");
+	}
+
+	OpenFile();
+
+	try
+	{
+		const size_t BUFLEN = QueueDepth * BlockSize;
+
+		// the buffers are page aligned for direct I/O
+#if defined(CEX_OS_WINDOWS)
+		m_bufferBase = static_cast<byte*>(_aligned_malloc(BUFLEN, DIRECT_ALIGN));
+#elif defined(CEX_ASYNCFILE_POSIX)
+		void* bufPtr = nullptr;
+
+		if (posix_memalign(&bufPtr, DIRECT_ALIGN, BUFLEN) == 0)
+		{
+			m_bufferBase = static_cast<byte*>(bufPtr);
+		}
+#endif
+
+		if (m_bufferBase == nullptr)
+		{
+			throw CryptoProcessingException("AsyncFileStream:CTor", "The buffers could not be allocated!");
+		}
+
+		m_ioSlots.resize(QueueDepth);
+
+		for (size_t i = 0; i < QueueDepth; ++i)
+		{
+			m_ioSlots[i].Buffer = m_bufferBase + (i * BlockSize);
+			m_ioSlots[i].FileOffset = 0;
+			m_ioSlots[i].IsPending = false;
+			m_ioSlots[i].Length = 0;
+			m_ioSlots[i].Result = 0;
+			m_ioSlots[i].Status = 0;
+		}
+
+		if (Pooled || !UringCreate())
+		{
+			PoolCreate();
+		}
+
+		if (m_fileAccess == FileAccess::Read)
+		{
+			StartRead(0);
+		}
+	}
+	catch (std::exception&)
+	{
+		Release();
+		throw;
+	}
+}
+
+AsyncFileStream::~AsyncFileStream()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void AsyncFileStream::Close()
+{
+	if (m_fileHandle == -1)
+	{
+		return;
+	}
+
+	bool isFailed = false;
+
+	try
+	{
+		if (m_fileAccess == FileAccess::Write)
+		{
+			if (m_slotPosition != 0)
+			{
+				size_t wrtLen = m_slotPosition;
+
+				if (m_isDirect)
+				{
+					// direct writes must be a multiple of the sector alignment; the padding is truncated below
+					wrtLen = (wrtLen + DIRECT_ALIGN - 1) - ((wrtLen + DIRECT_ALIGN - 1) % DIRECT_ALIGN);
+					std::memset(m_ioSlots[m_slotIndex].Buffer + m_slotPosition, 0, wrtLen - m_slotPosition);
+				}
+
+				SubmitWrite(wrtLen);
+			}
+
+			Drain(true);
+
+			const ulong FLELEN = (m_fileReserved > m_fileSize) ? m_fileReserved : m_fileSize;
+
+			if (m_ioOffset != FLELEN)
+			{
+				TruncateFile(FLELEN);
+			}
+		}
+		else
+		{
+			Drain(false);
+		}
+	}
+	catch (CryptoProcessingException&)
+	{
+		isFailed = true;
+	}
+
+	Release();
+
+	if (isFailed)
+	{
+		throw CryptoProcessingException("AsyncFileStream:Close", "The final write operations failed!");
+	}
+}
+
+void AsyncFileStream::CopyTo(IByteStream* Destination)
+{
+	CexAssert(m_fileAccess == FileAccess::Read, "The stream is write only");
+
+	std::vector<byte> buffer(m_blockSize);
+	size_t prcLen;
+
+	while ((prcLen = Read(buffer, 0, buffer.size())) != 0)
+	{
+		Destination->Write(buffer, 0, prcLen);
+	}
+}
+
+void AsyncFileStream::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+
+		try
+		{
+			Close();
+		}
+		catch (std::exception&)
+		{
+			// a finalizer can not report the failure
+		}
+
+		m_filePosition = 0;
+		m_fileReserved = 0;
+		m_fileSize = 0;
+		m_ioOffset = 0;
+		m_slotIndex = 0;
+		m_slotPosition = 0;
+	}
+}
+
+void AsyncFileStream::Flush()
+{
+	if (m_fileAccess == FileAccess::Write && !m_ioSlots.empty())
+	{
+		if (m_slotPosition != 0 && !m_isDirect)
+		{
+			SubmitWrite(m_slotPosition);
+		}
+
+		Drain(true);
+	}
+}
+
+size_t AsyncFileStream::Read(std::vector<byte> &Output, size_t Offset, size_t Length)
+{
+	CexAssert(m_fileAccess == FileAccess::Read, "The stream is write only");
+	CexAssert(Output.size() - Offset >= Length, "The output array is too short");
+
+	if (m_ioSlots.empty())
+	{
+		throw CryptoProcessingException("AsyncFileStream:Read", "The stream is closed!");
+	}
+
+	if (Length > m_fileSize - m_filePosition)
+	{
+		Length = static_cast<size_t>(m_fileSize - m_filePosition);
+	}
+
+	size_t prcLen = 0;
+
+	while (prcLen != Length)
+	{
+		IoSlot &slot = m_ioSlots[m_slotIndex];
+
+		if (slot.Length == 0)
+		{
+			break;
+		}
+
+		Wait(m_slotIndex);
+
+		// the file was truncated by another process
+		if (slot.Result <= m_slotPosition)
+		{
+			break;
+		}
+
+		const size_t CPYLEN = (slot.Result - m_slotPosition < Length - prcLen) ? slot.Result - m_slotPosition : Length - prcLen;
+		std::memcpy(&Output[Offset + prcLen], slot.Buffer + m_slotPosition, CPYLEN);
+		prcLen += CPYLEN;
+		m_slotPosition += CPYLEN;
+
+		if (m_slotPosition == slot.Result)
+		{
+			// the buffer is consumed; re-submit it for the next unread block
+			slot.Length = 0;
+
+			if (m_ioOffset < m_fileSize)
+			{
+				slot.FileOffset = m_ioOffset;
+				slot.Length = m_blockSize;
+				m_ioOffset += m_blockSize;
+				Submit(m_slotIndex);
+			}
+
+			m_slotIndex = (m_slotIndex + 1) % m_ioSlots.size();
+			m_slotPosition = 0;
+		}
+	}
+
+	if (m_isUring)
+	{
+		// the reads queued by this call are submitted together
+		UringSubmit(false);
+	}
+
+	m_filePosition += prcLen;
+
+	return prcLen;
+}
+
+byte AsyncFileStream::ReadByte()
+{
+	CexAssert(m_fileSize - m_filePosition >= 1, "Reached end of file");
+
+	std::vector<byte> data(1);
+	Read(data, 0, 1);
+
+	return data[0];
+}
+
+void AsyncFileStream::Reset()
+{
+	if (m_fileAccess == FileAccess::Read)
+	{
+		Seek(0, SeekOrigin::Begin);
+	}
+	else
+	{
+		Drain(false);
+		TruncateFile(0);
+		m_filePosition = 0;
+		m_fileReserved = 0;
+		m_fileSize = 0;
+		m_ioOffset = 0;
+		m_slotIndex = 0;
+		m_slotPosition = 0;
+	}
+}
+
+void AsyncFileStream::Seek(ulong Offset, SeekOrigin Origin)
+{
+	if (m_fileAccess == FileAccess::Write)
+	{
+		throw CryptoProcessingException("AsyncFileStream:Seek", "A write stream can not seek!");
+	}
+
+	ulong pos;
+
+	if (Origin == SeekOrigin::Begin)
+	{
+		pos = Offset;
+	}
+	else if (Origin == SeekOrigin::End)
+	{
+		pos = (Offset < m_fileSize) ? m_fileSize - Offset : 0;
+	}
+	else
+	{
+		pos = m_filePosition + Offset;
+	}
+
+	if (pos > m_fileSize)
+	{
+		pos = m_fileSize;
+	}
+
+	// the read-ahead is discarded, so a failure in it is not reported
+	Drain(false);
+	StartRead(pos);
+}
+
+void AsyncFileStream::SetLength(ulong Length)
+{
+	if (m_fileAccess == FileAccess::Read)
+	{
+		throw CryptoProcessingException("AsyncFileStream:SetLength", "A read stream can not be resized!");
+	}
+	if (Length < m_fileSize)
+	{
+		throw CryptoProcessingException("AsyncFileStream:SetLength", "The length is less than the bytes written!");
+	}
+
+	TruncateFile(Length);
+	m_fileReserved = Length;
+}
+
+void AsyncFileStream::Write(const std::vector<byte> &Input, size_t Offset, size_t Length)
+{
+	CexAssert(m_fileAccess == FileAccess::Write, "The stream is read only");
+	CexAssert(Input.size() - Offset >= Length, "The input array is too short");
+
+	if (m_ioSlots.empty())
+	{
+		throw CryptoProcessingException("AsyncFileStream:Write", "The stream is closed!");
+	}
+
+	while (Length != 0)
+	{
+		IoSlot &slot = m_ioSlots[m_slotIndex];
+
+		// an empty buffer may still be in flight from the previous pass through the ring
+		if (m_slotPosition == 0)
+		{
+			Wait(m_slotIndex);
+		}
+
+		const size_t CPYLEN = (m_blockSize - m_slotPosition < Length) ? m_blockSize - m_slotPosition : Length;
+		std::memcpy(slot.Buffer + m_slotPosition, &Input[Offset], CPYLEN);
+		m_slotPosition += CPYLEN;
+		m_filePosition += CPYLEN;
+		m_fileSize += CPYLEN;
+		Offset += CPYLEN;
+		Length -= CPYLEN;
+
+		if (m_slotPosition == m_blockSize)
+		{
+			SubmitWrite(m_blockSize);
+		}
+	}
+
+	if (m_isUring)
+	{
+		// the writes queued by this call are submitted together
+		UringSubmit(false);
+	}
+}
+
+void AsyncFileStream::WriteByte(byte Value)
+{
+	std::vector<byte> data(1, Value);
+	Write(data, 0, 1);
+}
+
+//~~~Private Functions~~~//
+
+void AsyncFileStream::AlignResume(IoSlot &Slot, size_t Previous)
+{
+	// a direct request must start on the sector alignment, so a short transfer is resumed from the aligned position
+	// below the transfer count, and the bytes above it are transferred again
+	if (Slot.Result % DIRECT_ALIGN == 0)
+	{
+		return;
+	}
+
+	const size_t ALNRES = Slot.Result - (Slot.Result % DIRECT_ALIGN);
+
+	if (ALNRES > Previous)
+	{
+		Slot.Result = ALNRES;
+	}
+	else
+	{
+		// less than a sector was transferred, and the aligned request would make no progress;
+		// the descriptor falls back to buffered I/O, and the remainder is resumed from the unaligned position
+#if defined(CEX_OS_WINDOWS)
+		// an unbuffered handle can not be changed
+		Slot.Status = -1;
+#elif defined(CEX_ASYNCFILE_POSIX) && defined(O_DIRECT)
+		const int FLAGS = fcntl(static_cast<int>(m_fileHandle), F_GETFL);
+
+		if (FLAGS == -1 || fcntl(static_cast<int>(m_fileHandle), F_SETFL, FLAGS & ~O_DIRECT) == -1)
+		{
+			Slot.Status = errno;
+		}
+#endif
+	}
+}
+
+void AsyncFileStream::Drain(bool Report)
+{
+	bool isFailed = false;
+
+	for (size_t i = 0; i < m_ioSlots.size(); ++i)
+	{
+		try
+		{
+			Wait(i);
+		}
+		catch (CryptoProcessingException&)
+		{
+			isFailed = true;
+		}
+	}
+
+	if (isFailed && Report)
+	{
+		throw CryptoProcessingException("AsyncFileStream:Drain", "A file operation failed!");
+	}
+}
+
+void AsyncFileStream::OpenFile()
+{
+#if defined(CEX_OS_WINDOWS)
+	const DWORD ACCESS = (m_fileAccess == FileAccess::Read) ? GENERIC_READ : GENERIC_WRITE;
+	const DWORD CREATE = (m_fileAccess == FileAccess::Read) ? OPEN_EXISTING : CREATE_ALWAYS;
+	// overlapped, so that the pool threads can run positional requests on the same handle concurrently
+	const DWORD FLAGS = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED;
+	HANDLE fileHandle = INVALID_HANDLE_VALUE;
+
+	if (m_isDirect)
+	{
+		fileHandle = CreateFileA(m_fileName.c_str(), ACCESS, FILE_SHARE_READ, nullptr, CREATE, FLAGS | FILE_FLAG_NO_BUFFERING, nullptr);
+	}
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		m_isDirect = false;
+		fileHandle = CreateFileA(m_fileName.c_str(), ACCESS, FILE_SHARE_READ, nullptr, CREATE, FLAGS, nullptr);
+	}
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		throw CryptoProcessingException("AsyncFileStream:CTor", "The file could not be opened!");
+	}
+
+	if (m_fileAccess == FileAccess::Read)
+	{
+		LARGE_INTEGER fileSize;
+
+		if (GetFileSizeEx(fileHandle, &fileSize) == 0)
+		{
+			CloseHandle(fileHandle);
+			throw CryptoProcessingException("AsyncFileStream:CTor", "The file size could not be read!");
+		}
+
+		m_fileSize = static_cast<ulong>(fileSize.QuadPart);
+	}
+
+	m_fileHandle = reinterpret_cast<std::intptr_t>(fileHandle);
+#elif defined(CEX_ASYNCFILE_POSIX)
+	const int FLAGS = (m_fileAccess == FileAccess::Read) ? O_RDONLY : (O_WRONLY | O_CREAT | O_TRUNC);
+	int fileDes = -1;
+
+#	if defined(O_DIRECT)
+	if (m_isDirect)
+	{
+		fileDes = open(m_fileName.c_str(), FLAGS | O_DIRECT, 0644);
+	}
+#	endif
+
+	if (fileDes == -1)
+	{
+		fileDes = open(m_fileName.c_str(), FLAGS, 0644);
+
+		if (fileDes == -1)
+		{
+			throw CryptoProcessingException("AsyncFileStream:CTor", "The file could not be opened!");
+		}
+
+#	if defined(F_NOCACHE)
+		// apple has no O_DIRECT; the nocache flag bypasses the unified buffer cache
+		m_isDirect = m_isDirect && (fcntl(fileDes, F_NOCACHE, 1) != -1);
+#	else
+		m_isDirect = false;
+#	endif
+	}
+
+	if (m_fileAccess == FileAccess::Read)
+	{
+		struct stat fileStat;
+
+		if (fstat(fileDes, &fileStat) != 0)
+		{
+			close(fileDes);
+			throw CryptoProcessingException("AsyncFileStream:CTor", "The file size could not be read!");
+		}
+
+		m_fileSize = static_cast<ulong>(fileStat.st_size);
+	}
+
+	m_fileHandle = static_cast<std::intptr_t>(fileDes);
+#else
+	throw CryptoProcessingException("AsyncFileStream:CTor", "The platform is not supported!");
+#endif
+}
+
+void AsyncFileStream::PoolCreate()
+{
+	m_isStopping = false;
+	m_workerThreads.reserve(m_ioSlots.size());
+
+	// one worker per buffer, so every request in the ring can be in flight at once
+	for (size_t i = 0; i < m_ioSlots.size(); ++i)
+	{
+		m_workerThreads.emplace_back(&AsyncFileStream::PoolWorker, this);
+	}
+}
+
+void AsyncFileStream::PoolDestroy()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_isStopping = true;
+	}
+
+	m_queueSignal.notify_all();
+
+	for (size_t i = 0; i < m_workerThreads.size(); ++i)
+	{
+		if (m_workerThreads[i].joinable())
+		{
+			m_workerThreads[i].join();
+		}
+	}
+
+	m_workerThreads.clear();
+}
+
+void AsyncFileStream::PoolWorker()
+{
+	while (true)
+	{
+		size_t idx;
+
+		{
+			std::unique_lock<std::mutex> lock(m_queueMutex);
+			m_queueSignal.wait(lock, [this]() { return m_isStopping || !m_queuedSlots.empty(); });
+
+			if (m_queuedSlots.empty())
+			{
+				break;
+			}
+
+			idx = m_queuedSlots.front();
+			m_queuedSlots.pop_front();
+		}
+
+		Transfer(m_ioSlots[idx]);
+
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			m_ioSlots[idx].IsPending = false;
+		}
+
+		m_completeSignal.notify_all();
+	}
+}
+
+void AsyncFileStream::Release()
+{
+	if (m_isUring)
+	{
+		UringDestroy();
+	}
+	else
+	{
+		PoolDestroy();
+	}
+
+	if (m_fileHandle != -1)
+	{
+#if defined(CEX_OS_WINDOWS)
+		CloseHandle(reinterpret_cast<HANDLE>(m_fileHandle));
+#elif defined(CEX_ASYNCFILE_POSIX)
+		close(static_cast<int>(m_fileHandle));
+#endif
+		m_fileHandle = -1;
+	}
+
+	if (m_bufferBase != nullptr)
+	{
+		// the buffers held plaintext or ciphertext in transit
+		Utility::MemUtils::SecureErase(m_bufferBase, 0, m_ioSlots.size() * m_blockSize);
+#if defined(CEX_OS_WINDOWS)
+		_aligned_free(m_bufferBase);
+#else
+		free(m_bufferBase);
+#endif
+		m_bufferBase = nullptr;
+	}
+
+	m_ioSlots.clear();
+	m_queuedSlots.clear();
+}
+
+void AsyncFileStream::StartRead(ulong Offset)
+{
+	// a direct read starts at the aligned block below the position, and the difference is skipped in the first buffer
+	const ulong BASE = m_isDirect ? Offset - (Offset % DIRECT_ALIGN) : Offset;
+
+	m_filePosition = Offset;
+	m_ioOffset = BASE;
+	m_slotIndex = 0;
+	m_slotPosition = static_cast<size_t>(Offset - BASE);
+
+	for (size_t i = 0; i < m_ioSlots.size(); ++i)
+	{
+		m_ioSlots[i].Length = 0;
+
+		if (m_ioOffset < m_fileSize)
+		{
+			m_ioSlots[i].FileOffset = m_ioOffset;
+			m_ioSlots[i].Length = m_blockSize;
+			m_ioOffset += m_blockSize;
+			Submit(i);
+		}
+	}
+
+	if (m_isUring)
+	{
+		UringSubmit(false);
+	}
+}
+
+void AsyncFileStream::Submit(size_t Index)
+{
+	IoSlot &slot = m_ioSlots[Index];
+
+	slot.Result = 0;
+	slot.Status = 0;
+
+	if (m_isUring)
+	{
+		slot.IsPending = true;
+		UringQueue(Index);
+	}
+	else
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			slot.IsPending = true;
+			m_queuedSlots.push_back(Index);
+		}
+
+		m_queueSignal.notify_one();
+	}
+}
+
+void AsyncFileStream::SubmitWrite(size_t Length)
+{
+	IoSlot &slot = m_ioSlots[m_slotIndex];
+
+	slot.FileOffset = m_ioOffset;
+	slot.Length = Length;
+	m_ioOffset += Length;
+	Submit(m_slotIndex);
+	m_slotIndex = (m_slotIndex + 1) % m_ioSlots.size();
+	m_slotPosition = 0;
+}
+
+void AsyncFileStream::Transfer(IoSlot &Slot)
+{
+	// runs on a pool thread; a short transfer is resumed until the request completes, or a read reaches the end of the file
+	const bool ISREAD = (m_fileAccess == FileAccess::Read);
+
+	while (Slot.Result < Slot.Length)
+	{
+		byte* bufPtr = Slot.Buffer + Slot.Result;
+		const ulong FLEOFF = Slot.FileOffset + Slot.Result;
+		const size_t PRCLEN = Slot.Length - Slot.Result;
+		size_t prcLen = 0;
+
+#if defined(CEX_OS_WINDOWS)
+		OVERLAPPED ovl;
+		std::memset(&ovl, 0, sizeof(ovl));
+		ovl.Offset = static_cast<DWORD>(FLEOFF);
+		ovl.OffsetHigh = static_cast<DWORD>(FLEOFF >> 32);
+		ovl.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+
+		if (ovl.hEvent == nullptr)
+		{
+			Slot.Status = static_cast<int>(GetLastError());
+			break;
+		}
+
+		HANDLE fileHandle = reinterpret_cast<HANDLE>(m_fileHandle);
+		DWORD trnLen = 0;
+		BOOL isDone = ISREAD ? ReadFile(fileHandle, bufPtr, static_cast<DWORD>(PRCLEN), nullptr, &ovl) : WriteFile(fileHandle, bufPtr, static_cast<DWORD>(PRCLEN), nullptr, &ovl);
+
+		// the transfer count is read from the overlapped result whether the request completed inline or is pending
+		if (isDone != 0 || GetLastError() == ERROR_IO_PENDING)
+		{
+			isDone = GetOverlappedResult(fileHandle, &ovl, &trnLen, TRUE);
+		}
+
+		const DWORD ERRCDE = (isDone == 0) ? GetLastError() : 0;
+		CloseHandle(ovl.hEvent);
+
+		if (isDone == 0)
+		{
+			if (ERRCDE != ERROR_HANDLE_EOF)
+			{
+				Slot.Status = static_cast<int>(ERRCDE);
+			}
+
+			break;
+		}
+
+		prcLen = static_cast<size_t>(trnLen);
+#elif defined(CEX_ASYNCFILE_POSIX)
+		const ssize_t RET = ISREAD ? pread(static_cast<int>(m_fileHandle), bufPtr, PRCLEN, static_cast<off_t>(FLEOFF)) :
+			pwrite(static_cast<int>(m_fileHandle), bufPtr, PRCLEN, static_cast<off_t>(FLEOFF));
+
+		if (RET < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			Slot.Status = errno;
+			break;
+		}
+
+		prcLen = static_cast<size_t>(RET);
+#endif
+
+		if (prcLen == 0)
+		{
+			// the end of the file for a read; a write that makes no progress is an error
+			if (!ISREAD)
+			{
+				Slot.Status = -1;
+			}
+
+			break;
+		}
+
+		const size_t PRVRES = Slot.Result;
+		Slot.Result += prcLen;
+
+		if (m_isDirect && Slot.Result < Slot.Length && (!ISREAD || Slot.FileOffset + Slot.Result < m_fileSize))
+		{
+			AlignResume(Slot, PRVRES);
+
+			if (Slot.Status != 0)
+			{
+				break;
+			}
+		}
+	}
+}
+
+void AsyncFileStream::TruncateFile(ulong Length)
+{
+#if defined(CEX_OS_WINDOWS)
+	FILE_END_OF_FILE_INFO info;
+	info.EndOfFile.QuadPart = static_cast<LONGLONG>(Length);
+
+	if (SetFileInformationByHandle(reinterpret_cast<HANDLE>(m_fileHandle), FileEndOfFileInfo, &info, sizeof(info)) == 0)
+	{
+		throw CryptoProcessingException("AsyncFileStream:SetLength", "The file length could not be set!");
+	}
+#elif defined(CEX_ASYNCFILE_POSIX)
+	if (ftruncate(static_cast<int>(m_fileHandle), static_cast<off_t>(Length)) != 0)
+	{
+		throw CryptoProcessingException("AsyncFileStream:SetLength", "The file length could not be set!");
+	}
+#else
+	static_cast<void>(Length);
+#endif
+}
+
+bool AsyncFileStream::UringCreate()
+{
+#if defined(CEX_ASYNCFILE_URING)
+	io_uring_params params;
+	std::memset(&params, 0, sizeof(params));
+
+	const int RNGHDL = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<unsigned>(m_ioSlots.size()), &params));
+
+	if (RNGHDL < 0)
+	{
+		return false;
+	}
+
+	RingState &ring = m_ringState;
+	ring.Handle = RNGHDL;
+
+	if ((params.features & IORING_FEAT_FAST_POLL) == 0)
+	{
+		// a kernel older than 5.7 may not support the read and write opcodes
+		UringDestroy();
+		return false;
+	}
+
+	ring.SqMapSize = params.sq_off.array + (params.sq_entries * sizeof(std::uint32_t));
+	ring.CqMapSize = params.cq_off.cqes + (params.cq_entries * sizeof(io_uring_cqe));
+	ring.SqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+	void* sqMap = mmap(nullptr, ring.SqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, RNGHDL, IORING_OFF_SQ_RING);
+	void* cqMap = mmap(nullptr, ring.CqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, RNGHDL, IORING_OFF_CQ_RING);
+	void* sqes = mmap(nullptr, ring.SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, RNGHDL, IORING_OFF_SQES);
+
+	ring.SqMap = (sqMap != MAP_FAILED) ? sqMap : nullptr;
+	ring.CqMap = (cqMap != MAP_FAILED) ? cqMap : nullptr;
+	ring.Sqes = (sqes != MAP_FAILED) ? sqes : nullptr;
+
+	if (ring.SqMap == nullptr || ring.CqMap == nullptr || ring.Sqes == nullptr)
+	{
+		UringDestroy();
+		return false;
+	}
+
+	byte* sqPtr = static_cast<byte*>(ring.SqMap);
+	byte* cqPtr = static_cast<byte*>(ring.CqMap);
+
+	ring.SqArray = reinterpret_cast<std::uint32_t*>(sqPtr + params.sq_off.array);
+	ring.SqMask = reinterpret_cast<std::uint32_t*>(sqPtr + params.sq_off.ring_mask);
+	ring.SqTail = reinterpret_cast<std::uint32_t*>(sqPtr + params.sq_off.tail);
+	ring.CqHead = reinterpret_cast<std::uint32_t*>(cqPtr + params.cq_off.head);
+	ring.CqMask = reinterpret_cast<std::uint32_t*>(cqPtr + params.cq_off.ring_mask);
+	ring.CqTail = reinterpret_cast<std::uint32_t*>(cqPtr + params.cq_off.tail);
+	ring.Cqes = cqPtr + params.cq_off.cqes;
+
+	// the buffers are registered once, rather than mapped by the kernel on every request;
+	// if the memlock limit is too small, the stream uses unregistered buffers
+	std::vector<iovec> bufVec(m_ioSlots.size());
+
+	for (size_t i = 0; i < bufVec.size(); ++i)
+	{
+		bufVec[i].iov_base = m_ioSlots[i].Buffer;
+		bufVec[i].iov_len = m_blockSize;
+	}
+
+	m_isFixed = (syscall(__NR_io_uring_register, RNGHDL, IORING_REGISTER_BUFFERS, bufVec.data(), static_cast<unsigned>(bufVec.size())) == 0);
+	m_isUring = true;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void AsyncFileStream::UringDestroy()
+{
+#if defined(CEX_ASYNCFILE_URING)
+	RingState &ring = m_ringState;
+
+	if (ring.Sqes != nullptr)
+	{
+		munmap(ring.Sqes, ring.SqesSize);
+	}
+	if (ring.CqMap != nullptr)
+	{
+		munmap(ring.CqMap, ring.CqMapSize);
+	}
+	if (ring.SqMap != nullptr)
+	{
+		munmap(ring.SqMap, ring.SqMapSize);
+	}
+	if (ring.Handle >= 0)
+	{
+		// closing the ring also releases the registered buffers
+		close(ring.Handle);
+	}
+#endif
+
+	m_ringState = RingState();
+	m_ringState.Handle = -1;
+	m_isFixed = false;
+	m_isUring = false;
+}
+
+void AsyncFileStream::UringQueue(size_t Index)
+{
+#if defined(CEX_ASYNCFILE_URING)
+	RingState &ring = m_ringState;
+	IoSlot &slot = m_ioSlots[Index];
+	const bool ISREAD = (m_fileAccess == FileAccess::Read);
+	// this thread is the only producer, so the tail can be read without ordering
+	const std::uint32_t TAIL = *ring.SqTail;
+	const std::uint32_t POS = TAIL & *ring.SqMask;
+	io_uring_sqe* sqe = static_cast<io_uring_sqe*>(ring.Sqes) + POS;
+
+	std::memset(sqe, 0, sizeof(io_uring_sqe));
+
+	if (m_isFixed)
+	{
+		sqe->opcode = ISREAD ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+		sqe->buf_index = static_cast<__u16>(Index);
+	}
+	else
+	{
+		sqe->opcode = ISREAD ? IORING_OP_READ : IORING_OP_WRITE;
+	}
+
+	sqe->fd = static_cast<int>(m_fileHandle);
+	sqe->addr = static_cast<__u64>(reinterpret_cast<std::uintptr_t>(slot.Buffer + slot.Result));
+	sqe->len = static_cast<__u32>(slot.Length - slot.Result);
+	sqe->off = slot.FileOffset + slot.Result;
+	sqe->user_data = Index;
+	ring.SqArray[POS] = POS;
+	// each slot has at most one entry in the ring, and the ring has at least one entry per slot, so it can not overflow
+	__atomic_store_n(ring.SqTail, TAIL + 1, __ATOMIC_RELEASE);
+	++ring.SqQueued;
+#else
+	static_cast<void>(Index);
+#endif
+}
+
+void AsyncFileStream::UringReap(bool Block)
+{
+#if defined(CEX_ASYNCFILE_URING)
+	RingState &ring = m_ringState;
+	std::uint32_t head = *ring.CqHead;
+	const bool ISWAIT = Block && head == __atomic_load_n(ring.CqTail, __ATOMIC_ACQUIRE);
+
+	if (ISWAIT || ring.SqQueued != 0)
+	{
+		// the queued requests are submitted by the same call that waits for a completion
+		UringSubmit(ISWAIT);
+	}
+
+	const std::uint32_t TAIL = __atomic_load_n(ring.CqTail, __ATOMIC_ACQUIRE);
+
+	while (head != TAIL)
+	{
+		const io_uring_cqe* cqe = static_cast<const io_uring_cqe*>(ring.Cqes) + (head & *ring.CqMask);
+		const size_t IDX = static_cast<size_t>(cqe->user_data);
+		const int RES = cqe->res;
+
+		++head;
+		__atomic_store_n(ring.CqHead, head, __ATOMIC_RELEASE);
+
+		IoSlot &slot = m_ioSlots[IDX];
+
+		if (RES < 0)
+		{
+			slot.Status = -RES;
+			slot.IsPending = false;
+		}
+		else
+		{
+			const size_t PRVRES = slot.Result;
+			slot.Result += static_cast<size_t>(RES);
+
+			// a short transfer is resumed, unless a read reached the end of the file
+			if (RES != 0 && slot.Result < slot.Length && (m_fileAccess == FileAccess::Write || slot.FileOffset + slot.Result < m_fileSize))
+			{
+				if (m_isDirect)
+				{
+					AlignResume(slot, PRVRES);
+				}
+
+				if (slot.Status == 0)
+				{
+					UringQueue(IDX);
+				}
+				else
+				{
+					slot.IsPending = false;
+				}
+			}
+			else
+			{
+				if (RES == 0 && slot.Result < slot.Length && m_fileAccess == FileAccess::Write)
+				{
+					slot.Status = -1;
+				}
+
+				slot.IsPending = false;
+			}
+		}
+	}
+
+	if (ring.SqQueued != 0)
+	{
+		// the resumed transfers are submitted together
+		UringSubmit(false);
+	}
+#else
+	static_cast<void>(Block);
+#endif
+}
+
+void AsyncFileStream::UringSubmit(bool Block)
+{
+#if defined(CEX_ASYNCFILE_URING)
+	RingState &ring = m_ringState;
+
+	if (!Block && ring.SqQueued == 0)
+	{
+		return;
+	}
+
+	long ret;
+
+	do
+	{
+		ret = syscall(__NR_io_uring_enter, ring.Handle, ring.SqQueued, Block ? 1 : 0, Block ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+	}
+	while (ret < 0 && errno == EINTR);
+
+	if (ret < 0)
+	{
+		// the entries stay in the ring, and are submitted again by the next wait
+		throw CryptoProcessingException("AsyncFileStream:Submit", "The requests could not be submitted!");
+	}
+
+	// the kernel returns the number of entries it consumed; a remainder is submitted by the next call
+	ring.SqQueued -= static_cast<std::uint32_t>(ret);
+#else
+	static_cast<void>(Block);
+#endif
+}
+
+void AsyncFileStream::Wait(size_t Index)
+{
+	IoSlot &slot = m_ioSlots[Index];
+
+	if (m_isUring)
+	{
+		while (slot.IsPending)
+		{
+			UringReap(true);
+		}
+	}
+	else
+	{
+		std::unique_lock<std::mutex> lock(m_queueMutex);
+		m_completeSignal.wait(lock, [&slot]() { return !slot.IsPending; });
+	}
+
+	if (slot.Status != 0)
+	{
+		const int ERRCDE = slot.Status;
+		slot.Status = 0;
+
+		throw CryptoProcessingException("AsyncFileStream:Wait", "The file operation failed!", std::to_string(ERRCDE));
+	}
+}
+
+NAMESPACE_IOEND
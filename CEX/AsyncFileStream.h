@@ -0,0 +1,360 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// An asynchronous file stream, using io_uring on Linux, and a positional I/O thread pool on other platforms.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_ASYNCFILESTREAM_H
+#define CEX_ASYNCFILESTREAM_H
+
+#include "IByteStream.h"
+#include "CryptoProcessingException.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+NAMESPACE_IO
+
+using Exception::CryptoProcessingException;
+
+/// <summary>
+/// An asynchronous file streaming container.
+/// <para>Keeps a queue of reads or writes in flight while the caller processes the stream, so that a single thread can keep a fast storage device busy.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Encrypt a file with a CipherStream:</description>
+/// <code>
+/// AsyncFileStream inpFile(InputPath, AsyncFileStream::FileAccess::Read);
+/// AsyncFileStream outFile(OutputPath, AsyncFileStream::FileAccess::Write);
+/// CipherStream cs(BlockCiphers::AHX, Digests::None, CipherModes::CTR);
+/// cs.Initialize(true, kp);
+/// cs.Write(&amp;inpFile, &amp;outFile);
+/// outFile.Close();
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Overview:</description>
+/// <para>The stream owns a ring of QueueDepth block buffers. In read mode, the ring is filled by read-ahead; every buffer holds a read of the next block in the file, and a buffer is re-submitted for the next unread block as soon as the caller has consumed it.
+/// In write mode, the caller fills the buffers in order, and each full buffer is submitted as a write while the next one is filled; a Write call only blocks when every buffer in the ring is in flight. \n
+/// The stream is sequential; a read stream can Seek, which waits for the reads in flight and restarts the read-ahead at the new position. A write stream only appends.</para>
+///
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>On Linux, requests are submitted through an io_uring instance owned by the stream; the ring buffers are registered with the kernel as fixed buffers, so the pages are pinned once rather than on each request.
+/// The requests made by a Read or Write call are queued in the submission ring, and passed to the kernel with a single system call.</description></item>
+/// <item><description>If io_uring is not available (an older kernel, or blocked by a seccomp policy), or on other platforms, requests are run by a pool of QueueDepth worker threads using positional reads and writes; IsUring() reports the backend in use. The Pooled option selects the worker pool on every platform.</description></item>
+/// <item><description>If the buffers can not be registered (ex. the RLIMIT_MEMLOCK limit is too small), the io_uring backend uses unregistered buffers.</description></item>
+/// <item><description>The Direct option bypasses the page cache (O_DIRECT, or FILE_FLAG_NO_BUFFERING on Windows); the buffers are page aligned, and the BlockSize must be a multiple of 4096.
+/// The final partial block of a direct write is padded to the alignment, and the file is truncated to its real length on Close. If the file system does not support direct I/O, the file is opened normally and IsDirect() returns false.
+/// A short direct transfer is resumed from the last aligned position; if less than one sector was transferred, the descriptor falls back to buffered I/O for the remainder.</description></item>
+/// <item><description>The file is opened with the write stream truncated; Close() must be called, or the stream destroyed, to write the final block.</description></item>
+/// </list>
+/// </remarks>
+class AsyncFileStream : public IByteStream
+{
+public:
+
+	//~~~Enums~~~//
+
+	/// <summary>
+	/// File access type flags
+	/// </summary>
+	enum class FileAccess : byte
+	{
+		/// <summary>
+		/// Open an existing file for reading
+		/// </summary>
+		Read = 1,
+		/// <summary>
+		/// Create or truncate a file for writing
+		/// </summary>
+		Write = 2
+	};
+
+private:
+
+	struct IoSlot
+	{
+		byte* Buffer;
+		ulong FileOffset;
+		bool IsPending;
+		size_t Length;
+		size_t Result;
+		int Status;
+	};
+
+	struct RingState
+	{
+		std::uint32_t* CqHead;
+		void* CqMap;
+		size_t CqMapSize;
+		std::uint32_t* CqMask;
+		std::uint32_t* CqTail;
+		void* Cqes;
+		int Handle;
+		std::uint32_t* SqArray;
+		void* SqMap;
+		size_t SqMapSize;
+		std::uint32_t* SqMask;
+		std::uint32_t SqQueued;
+		std::uint32_t* SqTail;
+		void* Sqes;
+		size_t SqesSize;
+	};
+
+	static const std::string CLASS_NAME;
+	static const size_t DEF_BLOCKSIZE = 256 * 1024;
+	static const size_t DEF_QUEUEDEPTH = 8;
+	static const size_t DIRECT_ALIGN = 4096;
+	static const size_t MAX_QUEUEDEPTH = 64;
+
+	size_t m_blockSize;
+	byte* m_bufferBase;
+	std::condition_variable m_completeSignal;
+	FileAccess m_fileAccess;
+	std::intptr_t m_fileHandle;
+	std::string m_fileName;
+	ulong m_filePosition;
+	ulong m_fileReserved;
+	ulong m_fileSize;
+	ulong m_ioOffset;
+	std::vector<IoSlot> m_ioSlots;
+	bool m_isDestroyed;
+	bool m_isDirect;
+	bool m_isFixed;
+	bool m_isStopping;
+	bool m_isUring;
+	std::mutex m_queueMutex;
+	std::condition_variable m_queueSignal;
+	std::deque<size_t> m_queuedSlots;
+	RingState m_ringState;
+	size_t m_slotIndex;
+	size_t m_slotPosition;
+	std::vector<std::thread> m_workerThreads;
+
+public:
+
+	AsyncFileStream() = delete;
+	AsyncFileStream(const AsyncFileStream&) = delete;
+	AsyncFileStream& operator=(const AsyncFileStream&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The file access mode
+	/// </summary>
+	const FileAccess Access();
+
+	/// <summary>
+	/// Get: The byte size of each buffer in the ring, and of each request
+	/// </summary>
+	const size_t BlockSize();
+
+	/// <summary>
+	/// Get: The stream can be read
+	/// </summary>
+	const bool CanRead() override;
+
+	/// <summary>
+	/// Get: The stream is seekable; read streams only
+	/// </summary>
+	const bool CanSeek() override;
+
+	/// <summary>
+	/// Get: The stream can be written to
+	/// </summary>
+	const bool CanWrite() override;
+
+	/// <summary>
+	/// Get: The stream container type
+	/// </summary>
+	const StreamModes Enumeral() override;
+
+	/// <summary>
+	/// Get: The file name and path
+	/// </summary>
+	std::string FileName();
+
+	/// <summary>
+	/// Get: The file was opened for direct (unbuffered) I/O
+	/// </summary>
+	const bool IsDirect();
+
+	/// <summary>
+	/// Get: Requests are submitted through io_uring; false if the thread pool is used
+	/// </summary>
+	const bool IsUring();
+
+	/// <summary>
+	/// Get: The stream length
+	/// </summary>
+	const ulong Length() override;
+
+	/// <summary>
+	/// Get: The streams class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Get: The streams current position
+	/// </summary>
+	const ulong Position() override;
+
+	/// <summary>
+	/// Get: The maximum number of requests in flight
+	/// </summary>
+	const size_t QueueDepth();
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Instantiate this class with a file name and options
+	/// </summary>
+	///
+	/// <param name="FileName">The full path and name of the file</param>
+	/// <param name="Access">The access mode; a read stream opens an existing file, a write stream creates or truncates the file</param>
+	/// <param name="BlockSize">The byte size of each request; must be a non-zero multiple of 4096</param>
+	/// <param name="QueueDepth">The number of requests kept in flight, between 1 and 64</param>
+	/// <param name="Direct">Bypass the operating system page cache</param>
+	/// <param name="Pooled">Run the requests on the worker thread pool, even if io_uring is available</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the file could not be opened, or a parameter is invalid</exception>
+	explicit AsyncFileStream(const std::string &FileName, FileAccess Access, size_t BlockSize = DEF_BLOCKSIZE, size_t QueueDepth = DEF_QUEUEDEPTH, bool Direct = false, bool Pooled = false);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~AsyncFileStream() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Write the final block, wait for the requests in flight, and close the file
+	/// </summary>
+	void Close() override;
+
+	/// <summary>
+	/// Copy the remainder of this stream to another stream
+	/// </summary>
+	///
+	/// <param name="Destination">The destination stream</param>
+	void CopyTo(IByteStream* Destination) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Wait for the writes in flight to complete.
+	/// <para>A partially filled buffer is written unless the stream uses direct I/O, where it is held until Close to keep the requests aligned.</para>
+	/// </summary>
+	void Flush();
+
+	/// <summary>
+	/// Copies a portion of the stream into an output buffer
+	/// </summary>
+	///
+	/// <param name="Output">The output array receiving the bytes</param>
+	/// <param name="Offset">Offset within the output array at which to begin</param>
+	/// <param name="Length">The number of bytes to read</param>
+	///
+	/// <returns>The number of bytes read</returns>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if a read request fails</exception>
+	size_t Read(std::vector<byte> &Output, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Read a single byte from the stream
+	/// </summary>
+	///
+	/// <returns>The read byte value</returns>
+	byte ReadByte() override;
+
+	/// <summary>
+	/// Return a read stream to the start of the file, or truncate a write stream to zero length
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Seek to a position within a read stream; the read-ahead restarts at the new position
+	/// </summary>
+	///
+	/// <param name="Offset">The offset position</param>
+	/// <param name="Origin">The starting point</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the stream is a write stream</exception>
+	void Seek(ulong Offset, SeekOrigin Origin) override;
+
+	/// <summary>
+	/// Reserve the length of a write stream.
+	/// <para>The file is extended to the length immediately, so the writes do not grow it; on Close, the file is set to the larger of the reserved length and the bytes written.</para>
+	/// </summary>
+	///
+	/// <param name="Length">The desired length</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the stream is a read stream, or the length is less than the bytes written</exception>
+	void SetLength(ulong Length) override;
+
+	/// <summary>
+	/// Writes an input buffer to the stream
+	/// </summary>
+	///
+	/// <param name="Input">The input array to write to the stream</param>
+	/// <param name="Offset">Offset within the input array at which to begin</param>
+	/// <param name="Length">The number of bytes to write</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if a write request fails</exception>
+	void Write(const std::vector<byte> &Input, size_t Offset, size_t Length) override;
+
+	/// <summary>
+	/// Write a single byte to the stream
+	/// </summary>
+	///
+	/// <param name="Value">The byte value to write</param>
+	void WriteByte(byte Value) override;
+
+private:
+	void AlignResume(IoSlot &Slot, size_t Previous);
+	void Drain(bool Report);
+	void OpenFile();
+	void PoolCreate();
+	void PoolDestroy();
+	void PoolWorker();
+	void Release();
+	void StartRead(ulong Offset);
+	void Submit(size_t Index);
+	void SubmitWrite(size_t Length);
+	void Transfer(IoSlot &Slot);
+	void TruncateFile(ulong Length);
+	bool UringCreate();
+	void UringDestroy();
+	void UringQueue(size_t Index);
+	void UringReap(bool Block);
+	void UringSubmit(bool Block);
+	void Wait(size_t Index);
+};
+
+NAMESPACE_IOEND
+#endif
@@ -115,7 +115,9 @@ BCG::BCG(BlockCiphers CipherType, Digests KdfEngineType, Providers ProviderType)
 	m_reseedRequests(0),
 	m_reseedThreshold(DEF_CYCTHRESH),
 	m_secStrength(0),
-	m_seedSize(0)
+	m_seedSize(0),
+	m_thdBuffer(0),
+	m_thdCounter(0)
 {
 }
 
@@ -142,7 +144,9 @@ BCG::BCG(IBlockCipher* Cipher, IDigest* KdfEngine, IProvider* Provider)
 	m_reseedRequests(0),
 	m_reseedThreshold(DEF_CYCTHRESH),
 	m_secStrength(0),
-	m_seedSize(0)
+	m_seedSize(0),
+	m_thdBuffer(0),
+	m_thdCounter(0)
 {
 }
 
@@ -186,6 +190,8 @@ void BCG::Destroy()
 		Utility::IntUtils::ClearVector(m_ctrVector);
 		Utility::IntUtils::ClearVector(m_kdfInfo);
 		Utility::IntUtils::ClearVector(m_legalKeySizes);
+		Utility::IntUtils::ClearVector(m_thdBuffer);
+		Utility::IntUtils::ClearVector(m_thdCounter);
 	}
 }
 
@@ -224,16 +230,18 @@ size_t BCG::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length)
 
 void BCG::Initialize(ISymmetricKey &GenParam)
 {
-	if (GenParam.Nonce().size() != 0)
+	SymmetricKeyView keyView(GenParam);
+
+	if (keyView.Nonce().size() != 0)
 	{
-		if (GenParam.Info().size() != 0)
-			Initialize(GenParam.Key(), GenParam.Nonce(), GenParam.Info());
+		if (keyView.Info().size() != 0)
+			Initialize(keyView.Key(), keyView.Nonce(), keyView.Info());
 		else
-			Initialize(GenParam.Key(), GenParam.Nonce());
+			Initialize(keyView.Key(), keyView.Nonce());
 	}
 	else
 	{
-		Initialize(GenParam.Key());
+		Initialize(keyView.Key());
 	}
 }
 
@@ -256,6 +264,7 @@ void BCG::Initialize(const std::vector<byte> &Seed)
 	std::vector<byte> key(keyLen);
 	Utility::MemUtils::Copy(Seed, BLOCK_SIZE, key, 0, keyLen);
 	m_blockCipher->Initialize(true, Key::Symmetric::SymmetricKey(key));
+	Reserve();
 	m_isInitialized = true;
 }
 
@@ -317,6 +326,7 @@ void BCG::ParallelMaxDegree(size_t Degree)
 		throw CryptoGeneratorException("BCG::ParallelMaxDegree", "Parallel degree can not exceed processor count!");
 
 	m_parallelProfile.SetMaxDegree(Degree);
+	Reserve();
 }
 
 void BCG::Update(const std::vector<byte> &Seed)
@@ -350,42 +360,51 @@ void BCG::GenerateBlock(std::vector<byte> &Output, size_t OutOffset, size_t Leng
 	if (!IsParallel() || Length < ParallelBlockSize())
 	{
 		// not parallel or too small; generate 1 p-rand block
-		Transform(Output, OutOffset, Length, m_ctrVector);
+		Transform(Output, OutOffset, Length, m_ctrVector, m_thdBuffer[0]);
 	}
 	else
 	{
 		const size_t OUTSZE = Length;
 		const size_t CNKSZE = ParallelBlockSize() / m_parallelProfile.ParallelMaxDegree();
 		const size_t CTRLEN = (CNKSZE / BLOCK_SIZE);
-		std::vector<byte> tmpCtr(m_ctrVector.size());
 
-		Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Output, OutOffset, &tmpCtr, CNKSZE, CTRLEN](size_t i)
+		// the degree may have been changed through the parallel profile
+		if (m_thdCounter.size() < m_parallelProfile.ParallelMaxDegree())
+			Reserve();
+
+		const byte* NUMPTR = m_parallelProfile.IsNumaAware() ? Output.data() + OutOffset : nullptr;
+
+		Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), NUMPTR, CNKSZE, [this, &Output, OutOffset, CNKSZE, CTRLEN](size_t i)
 		{
-			// thread level counter
-			std::vector<byte> thdCtr(m_ctrVector.size());
-			// offset counter by chunk size / block size  
-			Utility::IntUtils::BeIncrease8(m_ctrVector, thdCtr, CTRLEN * i);
+			// offset the thread counter by chunk size / block size
+			Utility::IntUtils::BeIncrease8(m_ctrVector, m_thdCounter[i], CTRLEN * i);
 			// generate random at output offset
-			this->Transform(Output, OutOffset + (i * CNKSZE), CNKSZE, thdCtr);
-			// store last counter
-			if (i == m_parallelProfile.ParallelMaxDegree() - 1)
-				Utility::MemUtils::Copy(thdCtr, 0, tmpCtr, 0, tmpCtr.size());
+			this->Transform(Output, OutOffset + (i * CNKSZE), CNKSZE, m_thdCounter[i], m_thdBuffer[i]);
 		});
 
 		// copy last counter to class variable
-		Utility::MemUtils::Copy(tmpCtr, 0, m_ctrVector, 0, m_ctrVector.size());
+		Utility::MemUtils::Copy(m_thdCounter[m_parallelProfile.ParallelMaxDegree() - 1], 0, m_ctrVector, 0, m_ctrVector.size());
 		// last block processing
 		const size_t ALNSZE = CNKSZE * m_parallelProfile.ParallelMaxDegree();
 
 		if (ALNSZE < OUTSZE)
 		{
 			const size_t FNLSZE = Length % ALNSZE;
-			Transform(Output, ALNSZE, FNLSZE, m_ctrVector);
+			Transform(Output, ALNSZE, FNLSZE, m_ctrVector, m_thdBuffer[0]);
 		}
 	}
 }
 
-void BCG::Transform(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter)
+void BCG::Reserve()
+{
+	// one counter and staging buffer per thread; sized here so the generator never allocates
+	const size_t THDCNT = Utility::IntUtils::Max(m_parallelProfile.ParallelMaxDegree(), static_cast<size_t>(1));
+
+	m_thdBuffer.resize(THDCNT, std::vector<byte>(STAGE_SIZE));
+	m_thdCounter.resize(THDCNT, std::vector<byte>(COUNTER_SIZE));
+}
+
+void BCG::Transform(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter, std::vector<byte> &Buffer)
 {
 	size_t blkCtr = 0;
 
@@ -394,44 +413,43 @@ void BCG::Transform(std::vector<byte> &Output, const size_t OutOffset, const siz
 	if (Length >= AVX512BLK)
 	{
 		const size_t PBKALN = Length - (Length % AVX512BLK);
-		std::vector<byte> ctrBlk(AVX512BLK);
 
 		// stagger counters and process 8 blocks with avx
 		while (blkCtr != PBKALN)
 		{
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 0);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 0);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 16);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 16);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 32);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 32);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 48);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 48);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 64);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 64);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 80);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 80);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 96);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 96);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 112);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 112);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 128);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 128);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 144);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 144);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 160);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 160);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 176);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 176);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 192);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 192);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 208);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 208);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 224);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 224);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 240);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 240);
 			Utility::IntUtils::BeIncrement8(Counter);
-			m_blockCipher->Transform2048(ctrBlk, 0, Output, OutOffset + blkCtr);
+			m_blockCipher->Transform2048(Buffer, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVX512BLK;
 		}
 	}
@@ -440,28 +458,27 @@ void BCG::Transform(std::vector<byte> &Output, const size_t OutOffset, const siz
 	if (Length >= AVX2BLK)
 	{
 		const size_t PBKALN = Length - (Length % AVX2BLK);
-		std::vector<byte> ctrBlk(AVX2BLK);
 
 		// stagger counters and process 8 blocks with avx
 		while (blkCtr != PBKALN)
 		{
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 0);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 0);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 16);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 16);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 32);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 32);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 48);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 48);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 64);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 64);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 80);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 80);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 96);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 96);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 112);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 112);
 			Utility::IntUtils::BeIncrement8(Counter);
-			m_blockCipher->Transform1024(ctrBlk, 0, Output, OutOffset + blkCtr);
+			m_blockCipher->Transform1024(Buffer, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVX2BLK;
 		}
 	}
@@ -470,20 +487,19 @@ void BCG::Transform(std::vector<byte> &Output, const size_t OutOffset, const siz
 	if (Length >= AVXBLK)
 	{
 		const size_t PBKALN = Length - (Length % AVXBLK);
-		std::vector<byte> ctrBlk(AVXBLK);
 
 		// 4 blocks with sse
 		while (blkCtr != PBKALN)
 		{
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 0);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 0);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 16);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 16);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 32);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 32);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 48);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 48);
 			Utility::IntUtils::BeIncrement8(Counter);
-			m_blockCipher->Transform512(ctrBlk, 0, Output, OutOffset + blkCtr);
+			m_blockCipher->Transform512(Buffer, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVXBLK;
 		}
 	}
@@ -499,10 +515,9 @@ void BCG::Transform(std::vector<byte> &Output, const size_t OutOffset, const siz
 
 	if (blkCtr != Length)
 	{
-		std::vector<byte> outputBlock(BLOCK_SIZE);
-		m_blockCipher->EncryptBlock(Counter, outputBlock);
+		m_blockCipher->EncryptBlock(Counter, 0, Buffer, 0);
 		const size_t FNLSZE = Length % BLOCK_SIZE;
-		Utility::MemUtils::Copy(outputBlock, 0, Output, OutOffset + (Length - FNLSZE), FNLSZE);
+		Utility::MemUtils::Copy(Buffer, 0, Output, OutOffset + (Length - FNLSZE), FNLSZE);
 		Utility::IntUtils::BeIncrement8(Counter);
 	}
 }
@@ -109,6 +109,7 @@ using Common::ParallelOptions;
 /// <item><description>The ParallelThreadsMax() property is the thread count in the parallel loop (pre-configured automatically); this must be either 1 (IsParallel=false), or an even number no greater than the number of processer cores on the system.</description></item>
 /// <item><description>ParallelBlockSize() is calculated automatically based on the processor(s) L1 data cache size, this property can be user defined, and must be evenly divisible by ParallelMinimumSize().</description></item>
 /// <item><description>The ParallelBlockSize() can be changed through the ParallelProfile() property</description></item>
+/// <item><description>The counter staging buffers are sized for each thread when the generator is initialized, the sequential generate function does not allocate memory.</description></item>
 /// <item><description>Parallel block calculation ex. <c>ParallelBlockSize = N - (N % .ParallelMinimumSize);</c></description></item>
 /// </list>
 /// 
@@ -133,6 +134,15 @@ private:
 	static const size_t MAX_REQUEST = 65536;
 	static const size_t MAX_RESEED = 536870912;
 	static const size_t PRC_DATACACHE = 1024 * 16;
+#if defined(__AVX512__)
+	static const size_t STAGE_SIZE = 16 * BLOCK_SIZE;
+#elif defined(__AVX2__)
+	static const size_t STAGE_SIZE = 8 * BLOCK_SIZE;
+#elif defined(__AVX__)
+	static const size_t STAGE_SIZE = 4 * BLOCK_SIZE;
+#else
+	static const size_t STAGE_SIZE = BLOCK_SIZE;
+#endif
 
 	IBlockCipher* m_blockCipher;
 	BlockCiphers m_cipherType;
@@ -156,6 +166,8 @@ private:
 	size_t m_reseedThreshold;
 	size_t m_secStrength;
 	size_t m_seedSize;
+	std::vector<std::vector<byte>> m_thdBuffer;
+	std::vector<std::vector<byte>> m_thdCounter;
 
 public:
 
@@ -385,7 +397,8 @@ private:
 
 	void Derive(std::vector<byte> &Seed);
 	void GenerateBlock(std::vector<byte> &Output, size_t OutOffset, size_t Length);
-	void Transform(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter);
+	void Reserve();
+	void Transform(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter, std::vector<byte> &Buffer);
 };
 
 NAMESPACE_DRBGEND
@@ -900,7 +900,7 @@ public:
 	template <typename T>
 	static void Compress128(const std::vector<byte> &Input, size_t InOffset, T &State, const std::vector<ulong> &IV)
 	{
-		std::vector<ulong> M(16);
+		std::array<ulong, 16> M;
 		Utility::IntUtils::LeBytesToULL1024(Input, InOffset, M, 0);
 
 		ulong R0 = State.H[0];
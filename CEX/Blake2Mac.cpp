@@ -0,0 +1,292 @@
+#include "Blake2Mac.h"
+#include "Blake256.h"
+#include "Blake512.h"
+#include "DigestFromName.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#include "SegmentUtils.h"
+#include "StreamWriter.h"
+
+NAMESPACE_MAC
+
+const std::string Blake2Mac::CLASS_NAME("Blake2Mac");
+
+//~~~Properties~~~//
+
+const size_t Blake2Mac::BlockSize()
+{
+	return m_msgDigest->BlockSize();
+}
+
+const Digests Blake2Mac::DigestType()
+{
+	return m_msgDigestType;
+}
+
+const Macs Blake2Mac::Enumeral()
+{
+	return Macs::Blake2Mac;
+}
+
+const size_t Blake2Mac::MacSize()
+{
+	return m_msgDigest->DigestSize();
+}
+
+const bool Blake2Mac::IsInitialized()
+{
+	return m_isInitialized;
+}
+
+std::vector<SymmetricKeySize> Blake2Mac::LegalKeySizes() const
+{
+	return m_legalKeySizes;
+}
+
+const bool Blake2Mac::IsParallel()
+{
+	return m_msgDigest->IsParallel();
+}
+
+const std::string Blake2Mac::Name()
+{
+	return CLASS_NAME + "-" + m_msgDigest->Name();
+}
+
+const size_t Blake2Mac::ParallelBlockSize()
+{
+	return m_msgDigest->ParallelBlockSize();
+}
+
+ParallelOptions &Blake2Mac::ParallelProfile()
+{
+	return m_msgDigest->ParallelProfile();
+}
+
+//~~~Constructor~~~//
+
+Blake2Mac::Blake2Mac(Digests DigestType, bool Parallel)
+	:
+	m_msgDigest(DigestType == Digests::Blake256 || DigestType == Digests::Blake512 ? Helper::DigestFromName::GetInstance(DigestType, Parallel) :
+		throw CryptoMacException("Blake2Mac:Ctor", "The digest must be a Blake256 or Blake512 instance!")),
+	m_destroyEngine(true),
+	m_isDestroyed(false),
+	m_isInitialized(false),
+	m_legalKeySizes(0),
+	m_macKey(0),
+	m_msgDigestType(DigestType),
+	m_segmentStage(0)
+{
+	Scope();
+}
+
+Blake2Mac::Blake2Mac(IDigest* Digest)
+	:
+	m_msgDigest(Digest != 0 ? Digest : throw CryptoMacException("Blake2Mac:Ctor", "The digest can not be null!")),
+	m_destroyEngine(false),
+	m_isDestroyed(false),
+	m_isInitialized(false),
+	m_legalKeySizes(0),
+	m_macKey(0),
+	m_msgDigestType(m_msgDigest->Enumeral()),
+	m_segmentStage(0)
+{
+	if (m_msgDigestType != Digests::Blake256 && m_msgDigestType != Digests::Blake512)
+		throw CryptoMacException("Blake2Mac:Ctor", "The digest must be a Blake256 or Blake512 instance!");
+
+	Scope();
+}
+
+Blake2Mac::~Blake2Mac()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void Blake2Mac::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	if (Output.size() != m_msgDigest->DigestSize())
+		Output.resize(m_msgDigest->DigestSize());
+
+	Update(Input, 0, Input.size());
+	Finalize(Output, 0);
+}
+
+void Blake2Mac::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_msgDigestType = Digests::None;
+		m_isInitialized = false;
+
+		if (m_macKey != 0)
+		{
+			m_macKey->Destroy();
+			delete m_macKey;
+			m_macKey = 0;
+		}
+
+		if (m_destroyEngine)
+		{
+			m_destroyEngine = false;
+
+			if (m_msgDigest != 0)
+				delete m_msgDigest;
+		}
+
+		Utility::IntUtils::ClearVector(m_legalKeySizes);
+		Utility::IntUtils::ClearVector(m_segmentStage);
+	}
+}
+
+size_t Blake2Mac::Finalize(std::vector<byte> &Output, size_t OutOffset)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("Blake2Mac:Finalize", "The Mac has not been initialized!");
+	if (Output.size() - OutOffset < m_msgDigest->DigestSize())
+		throw CryptoMacException("Blake2Mac:Finalize", "The Output buffer is too short!");
+
+	size_t msgLen = m_msgDigest->Finalize(Output, OutOffset);
+	// the digest reset drops the key block; reload it for the next message
+	LoadKey();
+
+	return msgLen;
+}
+
+void Blake2Mac::Initialize(ISymmetricKey &KeyParams)
+{
+	SymmetricKeyView keyView(KeyParams);
+
+	const size_t MINKEY = m_msgDigestType == Digests::Blake256 ? 16 : 32;
+	const size_t PRMLEN = m_msgDigestType == Digests::Blake256 ? 8 : 16;
+
+	if (keyView.Key().size() < MINKEY || keyView.Key().size() > MINKEY * 2)
+		throw CryptoMacException("Blake2Mac:Initialize", "The key size is invalid; check the LegalKeySizes property!");
+	if (keyView.Nonce().size() != 0 && keyView.Nonce().size() != PRMLEN)
+		throw CryptoMacException("Blake2Mac:Initialize", "The nonce size is invalid; the salt must be one half of the minimum key size!");
+	if (keyView.Info().size() != 0 && keyView.Info().size() != PRMLEN)
+		throw CryptoMacException("Blake2Mac:Initialize", "The info size is invalid; the personalization string must be one half of the minimum key size!");
+
+	if (m_macKey != 0)
+	{
+		m_macKey->Destroy();
+		delete m_macKey;
+	}
+
+	m_macKey = new SymmetricKey(keyView.Key(), keyView.Nonce(), keyView.Info());
+	m_msgDigest->Reset();
+	LoadKey();
+
+	m_isInitialized = true;
+}
+
+void Blake2Mac::LoadState(const std::vector<byte> &State)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("Blake2Mac:LoadState", "The Mac has not been initialized!");
+	if (State.size() < 2)
+		throw CryptoMacException("Blake2Mac:LoadState", "The state array is too short!");
+	if (State[0] != STATE_VERSION)
+		throw CryptoMacException("Blake2Mac:LoadState", "The state version is not supported!");
+	if (State[1] != static_cast<byte>(Macs::Blake2Mac))
+		throw CryptoMacException("Blake2Mac:LoadState", "The state was not created by this Mac!");
+
+	std::vector<byte> dgtState(State.size() - 2);
+	Utility::MemUtils::Copy(State, 2, dgtState, 0, dgtState.size());
+	m_msgDigest->LoadState(dgtState);
+}
+
+void Blake2Mac::ParallelMaxDegree(size_t Degree)
+{
+	try
+	{
+		m_msgDigest->ParallelMaxDegree(Degree);
+	}
+	catch (...)
+	{
+		throw CryptoMacException("Blake2Mac:ParallelMaxDegree", "The Degree value must be a non-zero even number less than the number of processor cores!");
+	}
+
+	if (m_isInitialized)
+		LoadKey();
+}
+
+void Blake2Mac::Reset()
+{
+	m_msgDigest->Reset();
+
+	if (m_macKey != 0)
+	{
+		m_macKey->Destroy();
+		delete m_macKey;
+		m_macKey = 0;
+	}
+
+	m_isInitialized = false;
+}
+
+std::vector<byte> Blake2Mac::SaveState()
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("Blake2Mac:SaveState", "The Mac has not been initialized!");
+
+	std::vector<byte> dgtState = m_msgDigest->SaveState();
+	IO::StreamWriter writer(2 + dgtState.size());
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Macs::Blake2Mac));
+	writer.Write(dgtState, 0, dgtState.size());
+
+	return writer.GetBytes();
+}
+
+void Blake2Mac::Update(byte Input)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("Blake2Mac:Update", "The Mac has not been initialized!");
+
+	m_msgDigest->Update(Input);
+}
+
+void Blake2Mac::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("Blake2Mac:Update", "The Mac has not been initialized!");
+	if (InOffset + Length > Input.size())
+		throw CryptoMacException("Blake2Mac:Update", "The Input buffer is too short!");
+
+	m_msgDigest->Update(Input, InOffset, Length);
+}
+
+void Blake2Mac::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input, m_segmentStage);
+}
+
+//~~~Private Functions~~~//
+
+void Blake2Mac::LoadKey()
+{
+	if (m_msgDigestType == Digests::Blake256)
+		static_cast<Digest::Blake256*>(m_msgDigest)->Initialize(*m_macKey);
+	else
+		static_cast<Digest::Blake512*>(m_msgDigest)->Initialize(*m_macKey);
+}
+
+void Blake2Mac::Scope()
+{
+	const size_t MINKEY = m_msgDigestType == Digests::Blake256 ? 16 : 32;
+	const size_t PRMLEN = m_msgDigestType == Digests::Blake256 ? 8 : 16;
+
+	m_legalKeySizes.resize(3);
+	// minimum key size
+	m_legalKeySizes[0] = SymmetricKeySize(MINKEY, 0, 0);
+	// recommended size; the digest output size
+	m_legalKeySizes[1] = SymmetricKeySize(MINKEY * 2, 0, 0);
+	// maximum key size with the optional salt and personalization strings
+	m_legalKeySizes[2] = SymmetricKeySize(MINKEY * 2, PRMLEN, PRMLEN);
+}
+
+NAMESPACE_MACEND
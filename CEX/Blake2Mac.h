@@ -0,0 +1,295 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// An implementation of the Blake2 digests native keyed mode as a Message Authentication Code generator.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_BLAKE2MAC_H
+#define CEX_BLAKE2MAC_H
+
+#include "Digests.h"
+#include "IDigest.h"
+#include "IMac.h"
+#include "SymmetricKey.h"
+
+NAMESPACE_MAC
+
+using Enumeration::Digests;
+using Digest::IDigest;
+using Common::ParallelOptions;
+using Key::Symmetric::SymmetricKey;
+
+/// <summary>
+/// An implementation of the keyed Blake2 Message Authentication Code generator
+/// </summary>
+///
+/// <example>
+/// <description>Generating a MAC code</description>
+/// <code>
+/// Blake2Mac mac(Enumeration::Digests::Blake512);
+/// SymmetricKey kp(Key);
+/// mac.Initialize(kp);
+/// mac.Update(Input, 0, Input.size());
+/// mac.Finalize(Output, Offset);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description><B>Overview:</B></description>
+/// <para>Blake2 has a native keyed mode; the key length is written to the parameter block, and the zero-padded key is processed as the first message block. \n
+/// The Mac is computed in a single pass over the message, rather than the two digest passes and the padded key blocks of an HMAC using the same digest.</para>
+///
+/// <description><B>Description:</B></description>
+/// <para><EM>Legend:</EM> \n
+/// <B>H</B>=Blake2 compression, <B>P</B>=parameter block, <B>K</B>=key, <B>m</B>=message, <B>||</B>=concatonate \n
+/// <EM>Generate</EM> \n
+/// Blake2Mac(K,m) = H(P(kl=|K|), (K || 0..0) || m)</para>
+///
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The digest engine is either the Blake256 (Blake2s) or Blake512 (Blake2b) digest, in sequential or parallel (Blake2sp/Blake2bp) mode.</description></item>
+/// <item><description>Blake256 keys are 16 to 32 bytes, Blake512 keys are 32 to 64 bytes.</description></item>
+/// <item><description>The optional Nonce and Info parameters of the key are loaded as the Blake2 salt and personalization strings; 8 bytes for Blake256, 16 bytes for Blake512.</description></item>
+/// <item><description>The Mac is re-keyed after each Finalize call, so successive Mac codes can be computed with the same key without calling Initialize again.</description></item>
+/// <item><description>The Compute(Input, Output) method wraps the Update(Input, Offset, Length) and Finalize(Output, Offset) methods and should only be used on small to medium sized data.</description>/></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>RFC <a href="https://tools.ietf.org/html/rfc7693">7693</a>: The BLAKE2 Cryptographic Hash and Message Authentication Code (MAC).</description></item>
+/// <item><description>BLAKE2: <a href="https://blake2.net/blake2.pdf">Simpler, Smaller, Fast as MD5</a>.</description></item>
+/// </list>
+/// </remarks>
+class Blake2Mac : public IMac
+{
+private:
+
+	static const std::string CLASS_NAME;
+	static const byte STATE_VERSION = 1;
+
+	IDigest* m_msgDigest;
+	bool m_destroyEngine;
+	bool m_isDestroyed;
+	bool m_isInitialized;
+	std::vector<SymmetricKeySize> m_legalKeySizes;
+	SymmetricKey* m_macKey;
+	Digests m_msgDigestType;
+	std::vector<byte> m_segmentStage;
+
+public:
+
+	Blake2Mac() = delete;
+	Blake2Mac(const Blake2Mac&) = delete;
+	Blake2Mac& operator=(const Blake2Mac&) = delete;
+	Blake2Mac& operator=(Blake2Mac&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The Digests internal blocksize in bytes
+	/// </summary>
+	const size_t BlockSize() override;
+
+	/// <summary>
+	/// Get: The message digest engine type
+	/// </summary>
+	const Digests DigestType();
+
+	/// <summary>
+	/// Get: Mac generators type name
+	/// </summary>
+	const Macs Enumeral() override;
+
+	/// <summary>
+	/// Get: Size of returned mac in bytes
+	/// </summary>
+	const size_t MacSize() override;
+
+	/// <summary>
+	/// Get: Mac is ready to digest data
+	/// </summary>
+	const bool IsInitialized() override;
+
+	/// <summary>
+	/// Get: Recommended Mac key sizes in a SymmetricKeySize array
+	/// </summary>
+	std::vector<SymmetricKeySize> LegalKeySizes() const override;
+
+	/// <summary>
+	/// Get: Processor parallelization availability.
+	/// <para>Indicates whether parallel processing is available on this system.
+	/// If parallel capable, input data array passed to the Update function must be ParallelBlockSize in bytes to trigger parallelization.</para>
+	/// </summary>
+	const bool IsParallel();
+
+	/// <summary>
+	/// Get: Mac generators class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Get: Parallel block size; the byte-size of the input data array passed to the Update function that triggers parallel processing.
+	/// <para>This value can be changed through the ParallelProfile class.<para>
+	/// </summary>
+	const size_t ParallelBlockSize();
+
+	/// <summary>
+	/// Get/Set: Contains parallel settings and SIMD capability flags in a ParallelOptions structure.
+	/// <para>The maximum number of threads allocated when using multi-threaded processing can be set with the ParallelMaxDegree(size_t) function.</para>
+	/// </summary>
+	ParallelOptions &ParallelProfile();
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Instantiate this class using the digest enumeration name
+	/// </summary>
+	///
+	/// <param name="DigestType">The Blake2 digest enumeration name; Blake256 or Blake512</param>
+	/// <param name="Parallel">Initialize the parallelized form of the message digest</param>
+	///
+	/// <exception cref="Exception::CryptoMacException">Thrown if the digest type is not a Blake2 digest</exception>
+	explicit Blake2Mac(Digests DigestType, bool Parallel = false);
+
+	/// <summary>
+	/// Initialize the class with a Blake2 digest instance
+	/// </summary>
+	///
+	/// <param name="Digest">The Blake256 or Blake512 digest instance</param>
+	///
+	/// <exception cref="Exception::CryptoMacException">Thrown if the digest is null, or is not a Blake2 digest</exception>
+	explicit Blake2Mac(IDigest* Digest);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~Blake2Mac() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Process an input array and return the Mac code in the output array.
+	/// </summary>
+	///
+	/// <param name="Input">The input data byte array</param>
+	/// <param name="Output">The output Mac code array</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized</exception>
+	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Process the data and return a Mac code.
+	/// <para>The digest is re-keyed after the code is written, and is ready to process a new message.</para>
+	/// </summary>
+	///
+	/// <param name="Output">The output Mac code array</param>
+	/// <param name="OutOffset">The offset in the output array</param>
+	///
+	/// <returns>The number of bytes processed</returns>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized, or the Output array is too small</exception>
+	size_t Finalize(std::vector<byte> &Output, size_t OutOffset) override;
+
+	/// <summary>
+	/// Initialize the MAC generator with a SymmetricKey key container.
+	/// <para>The key size must be one of the LegalKeySizes; the Nonce and Info parameters are optional,
+	/// and are loaded as the Blake2 salt and personalization strings.</para>
+	/// </summary>
+	///
+	/// <param name="KeyParams">A SymmetricKey key container class</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the key, nonce, or info sizes are invalid</exception>
+	void Initialize(ISymmetricKey &KeyParams) override;
+
+	/// <summary>
+	/// Restore the message state from a checkpoint created by the SaveState function.
+	/// <para>The Mac must be initialized with the same key and digest settings before the state is loaded.</para>
+	/// </summary>
+	///
+	/// <param name="State">The serialized Mac state</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized, or the state is malformed or was not created by this Mac</exception>
+	void LoadState(const std::vector<byte> &State) override;
+
+	/// <summary>
+	/// Set the number of threads allocated when using multi-threaded tree hashing processing.
+	/// <para>Thread count must be an even number, and not exceed the number of processor cores.
+	/// Changing this value will change the output Mac code; an initialized Mac is re-keyed.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	///
+	/// <exception cref="Exception::CryptoMacException">Thrown if an invalid degree setting is used</exception>
+	void ParallelMaxDegree(size_t Degree);
+
+	/// <summary>
+	/// Reset to the default state; Mac must be re-initialized after this call
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Serialize the message state; the serialized state of the keyed digest.
+	/// <para>Key material is not written to the state.</para>
+	/// </summary>
+	///
+	/// <returns>The serialized Mac state</returns>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized</exception>
+	std::vector<byte> SaveState() override;
+
+	/// <summary>
+	/// Update the Mac with a single byte
+	/// </summary>
+	///
+	/// <param name="Input">Input byte to process</param>
+	void Update(byte Input) override;
+
+	/// <summary>
+	/// Update the Mac with a block of bytes
+	/// </summary>
+	///
+	/// <param name="Input">The input data array to process</param>
+	/// <param name="InOffset">Starting position with the input array</param>
+	/// <param name="Length">The length of data to process in bytes</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized, or the Input array is too small</exception>
+	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
+
+	/// <summary>
+	/// Update the Mac with a message stored as a list of fragments
+	/// <para>The fragments are absorbed in list order as one contiguous message; a partial block is carried across each fragment boundary, so no fragment is copied.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of message fragments</param>
+	void UpdateSegments(const std::vector<MemorySegment> &Input) override;
+
+private:
+
+	void LoadKey();
+	void Scope();
+};
+
+NAMESPACE_MACEND
+#endif
@@ -62,10 +62,7 @@ public:
 		R1 = FF0 = _mm_loadu_si128((const __m128i*)&State.H[0]);
 		R2 = FF1 = _mm_loadu_si128((const __m128i*)&State.H[4]);
 		R3 = _mm_loadu_si128((const __m128i*)&IV[0]);
-		std::vector<byte> taf(16);
-		memcpy(&taf[0], &State.T[0], 8);
-		memcpy(&taf[8], &State.F[0], 8);
-		R4 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)&IV[4]), _mm_loadu_si128((const __m128i*)&taf[0]));
+		R4 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)&IV[4]), _mm_set_epi32(State.F[1], State.F[0], State.T[1], State.T[0]));
 
 		// round 0
 		// lm 0.1
@@ -603,7 +600,7 @@ public:
 	template <typename T>
 	static void Compress64(const std::vector<byte> &Input, size_t InOffset, T &State, const std::vector<uint> &IV)
 	{
-		std::vector<uint> M(16);
+		std::array<uint, 16> M;
 		Utility::IntUtils::LeBytesToUL512(Input, InOffset, M, 0);
 
 		uint R0 = State.H[0];
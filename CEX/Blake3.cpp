@@ -0,0 +1,604 @@
+#include "Blake3.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+#include "SegmentUtils.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
+#if defined(__AVX512__)
+#	include "UInt512.h"
+#elif defined(__AVX2__)
+#	include "UInt256.h"
+#endif
+
+NAMESPACE_DIGEST
+
+const std::string Blake3::CLASS_NAME("Blake3");
+
+const std::vector<uint> Blake3::IV =
+{
+	0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+	0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+};
+
+// the message word schedule; each round applies the BLAKE3 permutation to the previous row
+const byte Blake3::SIGMA[7][16] =
+{
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8 },
+	{ 3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1 },
+	{ 10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6 },
+	{ 12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4 },
+	{ 9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7 },
+	{ 11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13 }
+};
+
+//~~~Properties~~~//
+
+size_t Blake3::BlockSize()
+{
+	return BLOCK_SIZE;
+}
+
+size_t Blake3::DigestSize()
+{
+	return DIGEST_SIZE;
+}
+
+const Digests Blake3::Enumeral()
+{
+	return Digests::Blake3;
+}
+
+const bool Blake3::IsParallel()
+{
+	return m_parallelProfile.IsParallel();
+}
+
+const std::string Blake3::Name()
+{
+	if (m_parallelProfile.IsParallel())
+		return CLASS_NAME + "-P" + Utility::IntUtils::ToString(m_parallelProfile.ParallelMaxDegree());
+	else
+		return CLASS_NAME;
+}
+
+const size_t Blake3::ParallelBlockSize()
+{
+	return m_parallelProfile.ParallelBlockSize();
+}
+
+ParallelOptions &Blake3::ParallelProfile()
+{
+	return m_parallelProfile;
+}
+
+//~~~Constructor~~~//
+
+Blake3::Blake3(bool Parallel)
+	:
+	m_chunkCount(0),
+	m_cvStack(MAX_DEPTH * (DIGEST_SIZE / sizeof(uint)), 0),
+	m_cvStackLength(0),
+	m_dgtFlags(0),
+	m_isDestroyed(false),
+	m_keyWords(IV),
+	m_msgBuffer(CHUNK_SIZE * CHUNK_LANES),
+	m_msgLength(0),
+	m_nodeState(16, 0),
+	m_parallelProfile(CHUNK_SIZE * CHUNK_LANES, Parallel, 0, 0, false, 0, false),
+	m_segmentStage(0)
+{
+	if (m_parallelProfile.IsParallel())
+		m_parallelProfile.IsParallel() = Parallel;
+
+	// the parallel block size is a multiple of the chunk groups hashed by each thread
+	if (m_parallelProfile.ParallelBlockSize() == 0)
+		m_parallelProfile.ParallelBlockSize() = m_parallelProfile.ParallelMinimumSize();
+}
+
+Blake3::Blake3(const std::vector<byte> &Key, bool Parallel)
+	:
+	Blake3(Parallel)
+{
+	if (Key.size() != KEY_SIZE)
+		throw CryptoDigestException("Blake3:CTor", "The key must be 32 bytes!");
+
+	// the key words replace the IV as the chaining value of every chunk and parent node
+	for (size_t i = 0; i < m_keyWords.size(); ++i)
+		m_keyWords[i] = Utility::IntUtils::LeBytesTo32(Key, i * sizeof(uint));
+
+	m_dgtFlags = FLAG_KEYED_HASH;
+}
+
+Blake3::~Blake3()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void Blake3::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	Output.resize(DIGEST_SIZE);
+	Update(Input, 0, Input.size());
+	Finalize(Output, 0);
+}
+
+void Blake3::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_chunkCount = 0;
+		m_cvStackLength = 0;
+		m_dgtFlags = 0;
+		m_msgLength = 0;
+
+		Utility::IntUtils::ClearVector(m_cvStack);
+		Utility::IntUtils::ClearVector(m_keyWords);
+		Utility::IntUtils::ClearVector(m_msgBuffer);
+		Utility::IntUtils::ClearVector(m_segmentStage);
+		Utility::IntUtils::ClearVector(m_nodeState);
+	}
+}
+
+size_t Blake3::Finalize(std::vector<byte> &Output, const size_t OutOffset)
+{
+	CexAssert(Output.size() - OutOffset >= DIGEST_SIZE, "The Output buffer is too short!");
+
+	return Finalize(Output, OutOffset, DIGEST_SIZE);
+}
+
+size_t Blake3::Finalize(std::vector<byte> &Output, size_t OutOffset, size_t Length)
+{
+	if (Output.size() < OutOffset + Length)
+		throw CryptoDigestException("Blake3:Finalize", "The Output buffer is too short!");
+
+	// the full chunks ahead of the last chunk are added to the tree
+	if (m_msgLength > CHUNK_SIZE)
+	{
+		const size_t PRCLEN = ((m_msgLength - 1) / CHUNK_SIZE) * CHUNK_SIZE;
+		ProcessChunks(m_msgBuffer, 0, PRCLEN);
+		Utility::MemUtils::Copy(m_msgBuffer, PRCLEN, m_msgBuffer, 0, m_msgLength - PRCLEN);
+		m_msgLength -= PRCLEN;
+	}
+
+	// the last chunk, possibly empty; every block but the last is compressed to the chaining value
+	std::vector<uint> nodeCv(m_keyWords);
+	std::vector<uint> nodeMsg(16);
+	uint nodeFlags = m_dgtFlags | FLAG_CHUNK_START;
+	size_t blkOff = 0;
+
+	while (m_msgLength - blkOff > BLOCK_SIZE)
+	{
+		Utility::IntUtils::LeBytesToUL512(m_msgBuffer, blkOff, nodeMsg, 0);
+		Compress(m_nodeState, nodeCv, 0, nodeMsg, 0, m_chunkCount, static_cast<uint>(BLOCK_SIZE), nodeFlags);
+		Utility::MemUtils::Copy(m_nodeState, 0, nodeCv, 0, DIGEST_SIZE);
+		nodeFlags = m_dgtFlags;
+		blkOff += BLOCK_SIZE;
+	}
+
+	Utility::MemUtils::Clear(m_msgBuffer, m_msgLength, (blkOff + BLOCK_SIZE) - m_msgLength);
+	Utility::IntUtils::LeBytesToUL512(m_msgBuffer, blkOff, nodeMsg, 0);
+	ulong nodeCounter = m_chunkCount;
+	uint nodeLength = static_cast<uint>(m_msgLength - blkOff);
+	nodeFlags |= FLAG_CHUNK_END;
+
+	// fold the chaining value stack into the parent nodes on the right edge of the tree
+	while (m_cvStackLength != 0)
+	{
+		--m_cvStackLength;
+		Compress(m_nodeState, nodeCv, 0, nodeMsg, 0, nodeCounter, nodeLength, nodeFlags);
+		Utility::MemUtils::Copy(m_cvStack, m_cvStackLength * (DIGEST_SIZE / sizeof(uint)), nodeMsg, 0, DIGEST_SIZE);
+		Utility::MemUtils::Copy(m_nodeState, 0, nodeMsg, DIGEST_SIZE / sizeof(uint), DIGEST_SIZE);
+		Utility::MemUtils::Copy(m_keyWords, 0, nodeCv, 0, DIGEST_SIZE);
+		nodeCounter = 0;
+		nodeLength = static_cast<uint>(BLOCK_SIZE);
+		nodeFlags = m_dgtFlags | FLAG_PARENT;
+	}
+
+	// the root node output; each 64 byte block compresses the root with an incrementing output counter
+	std::vector<byte> blk(BLOCK_SIZE);
+	size_t outLen = Length;
+	ulong outCounter = 0;
+
+	while (outLen != 0)
+	{
+		const size_t BLKLEN = Utility::IntUtils::Min(BLOCK_SIZE, outLen);
+		Compress(m_nodeState, nodeCv, 0, nodeMsg, 0, outCounter, nodeLength, nodeFlags | FLAG_ROOT);
+
+		for (size_t i = 0; i < m_nodeState.size(); ++i)
+			Utility::IntUtils::Le32ToBytes(m_nodeState[i], blk, i * sizeof(uint));
+
+		Utility::MemUtils::Copy(blk, 0, Output, OutOffset, BLKLEN);
+		OutOffset += BLKLEN;
+		outLen -= BLKLEN;
+		++outCounter;
+	}
+
+	Utility::MemUtils::Clear(blk, 0, blk.size());
+	Utility::MemUtils::Clear(nodeMsg, 0, nodeMsg.size() * sizeof(uint));
+	Reset();
+
+	return Length;
+}
+
+void Blake3::LoadState(const std::vector<byte> &State)
+{
+	if (State.size() < 3 + sizeof(ulong) + 1 + sizeof(uint))
+		throw CryptoDigestException("Blake3:LoadState", "The state array is too short!");
+
+	IO::MemoryStream strm(State);
+	IO::StreamReader reader(strm);
+
+	if (reader.ReadByte() != STATE_VERSION)
+		throw CryptoDigestException("Blake3:LoadState", "The state version is not supported!");
+	if (reader.ReadByte() != static_cast<byte>(Digests::Blake3))
+		throw CryptoDigestException("Blake3:LoadState", "The state was not created by this digest!");
+	if (reader.ReadByte() != static_cast<byte>(m_dgtFlags))
+		throw CryptoDigestException("Blake3:LoadState", "The state was created with a different hashing mode!");
+
+	const ulong CHKCNT = reader.ReadInt<ulong>();
+	const size_t STKLEN = reader.ReadByte();
+
+	if (STKLEN > MAX_DEPTH || reader.Position() + (STKLEN * DIGEST_SIZE) + sizeof(uint) > State.size())
+		throw CryptoDigestException("Blake3:LoadState", "The state array is malformed!");
+
+	Utility::MemUtils::Clear(m_cvStack, 0, m_cvStack.size() * sizeof(uint));
+	reader.Read(m_cvStack, 0, STKLEN * (DIGEST_SIZE / sizeof(uint)));
+
+	const size_t MSGLEN = reader.ReadInt<uint>();
+
+	if (MSGLEN > m_msgBuffer.size() || reader.Position() + MSGLEN != State.size())
+		throw CryptoDigestException("Blake3:LoadState", "The state array is malformed!");
+
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	reader.Read(m_msgBuffer, 0, MSGLEN);
+
+	m_chunkCount = CHKCNT;
+	m_cvStackLength = STKLEN;
+	m_msgLength = MSGLEN;
+}
+
+void Blake3::ParallelMaxDegree(size_t Degree)
+{
+	if (Degree == 0)
+		throw CryptoDigestException("Blake3:ParallelMaxDegree", "Parallel degree can not be zero!");
+	if (Degree > 254)
+		throw CryptoDigestException("Blake3:ParallelMaxDegree", "Parallel degree can not exceed 254!");
+	if (Degree % 2 != 0)
+		throw CryptoDigestException("Blake3:ParallelMaxDegree", "Parallel degree must be an even number!");
+
+	m_parallelProfile.SetMaxDegree(Degree);
+	Reset();
+}
+
+void Blake3::Reset()
+{
+	Utility::MemUtils::Clear(m_cvStack, 0, m_cvStack.size() * sizeof(uint));
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	Utility::MemUtils::Clear(m_nodeState, 0, m_nodeState.size() * sizeof(uint));
+	m_chunkCount = 0;
+	m_cvStackLength = 0;
+	m_msgLength = 0;
+}
+
+std::vector<byte> Blake3::SaveState()
+{
+	IO::StreamWriter writer(3 + sizeof(ulong) + 1 + (m_cvStackLength * DIGEST_SIZE) + sizeof(uint) + m_msgLength);
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Digests::Blake3));
+	writer.Write(static_cast<byte>(m_dgtFlags));
+	writer.Write(m_chunkCount);
+	writer.Write(static_cast<byte>(m_cvStackLength));
+	writer.Write(m_cvStack, 0, m_cvStackLength * (DIGEST_SIZE / sizeof(uint)));
+	writer.Write(static_cast<uint>(m_msgLength));
+	writer.Write(m_msgBuffer, 0, m_msgLength);
+
+	return writer.GetBytes();
+}
+
+void Blake3::Update(byte Input)
+{
+	std::vector<byte> one(1, Input);
+	Update(one, 0, 1);
+}
+
+void Blake3::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	CexAssert(Input.size() - InOffset >= Length, "The Input buffer is too short!");
+
+	if (Length == 0)
+		return;
+
+	// the last chunk is compressed by Finalize, so input is only processed when more input follows it
+	if (m_msgLength != 0 && m_msgLength + Length > m_msgBuffer.size())
+	{
+		const size_t RMDLEN = m_msgBuffer.size() - m_msgLength;
+		Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgLength, RMDLEN);
+		ProcessChunks(m_msgBuffer, 0, m_msgBuffer.size());
+		m_msgLength = 0;
+		InOffset += RMDLEN;
+		Length -= RMDLEN;
+	}
+
+	if (m_msgLength == 0)
+	{
+		if (m_parallelProfile.IsParallel() && Length > m_parallelProfile.ParallelBlockSize())
+		{
+			// split the chunk groups between threads
+			const size_t PRCLEN = ((Length - 1) / m_parallelProfile.ParallelMinimumSize()) * m_parallelProfile.ParallelMinimumSize();
+			ProcessChunks(Input, InOffset, PRCLEN);
+			InOffset += PRCLEN;
+			Length -= PRCLEN;
+		}
+
+		if (Length > m_msgBuffer.size())
+		{
+			// chunk groups are hashed directly from the input
+			const size_t PRCLEN = ((Length - 1) / m_msgBuffer.size()) * m_msgBuffer.size();
+			ProcessChunks(Input, InOffset, PRCLEN);
+			InOffset += PRCLEN;
+			Length -= PRCLEN;
+		}
+	}
+
+	// store unaligned bytes
+	Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgLength, Length);
+	m_msgLength += Length;
+}
+
+void Blake3::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input, m_segmentStage);
+}
+
+//~~~Private Functions~~~//
+
+void Blake3::Compress(std::vector<uint> &Output, const std::vector<uint> &ChainValue, size_t CvOffset, const std::vector<uint> &Message, size_t MsgOffset, ulong Counter, uint BlockLength, uint Flags)
+{
+	std::array<uint, 16> state;
+
+	Utility::MemUtils::Copy(ChainValue, CvOffset, state, 0, DIGEST_SIZE);
+	Utility::MemUtils::Copy(IV, 0, state, 8, 4 * sizeof(uint));
+	state[12] = static_cast<uint>(Counter);
+	state[13] = static_cast<uint>(Counter >> 32);
+	state[14] = BlockLength;
+	state[15] = Flags;
+
+	for (size_t i = 0; i < 7; ++i)
+	{
+		// column step
+		Mix(state, 0, 4, 8, 12, Message[MsgOffset + SIGMA[i][0]], Message[MsgOffset + SIGMA[i][1]]);
+		Mix(state, 1, 5, 9, 13, Message[MsgOffset + SIGMA[i][2]], Message[MsgOffset + SIGMA[i][3]]);
+		Mix(state, 2, 6, 10, 14, Message[MsgOffset + SIGMA[i][4]], Message[MsgOffset + SIGMA[i][5]]);
+		Mix(state, 3, 7, 11, 15, Message[MsgOffset + SIGMA[i][6]], Message[MsgOffset + SIGMA[i][7]]);
+		// diagonal step
+		Mix(state, 0, 5, 10, 15, Message[MsgOffset + SIGMA[i][8]], Message[MsgOffset + SIGMA[i][9]]);
+		Mix(state, 1, 6, 11, 12, Message[MsgOffset + SIGMA[i][10]], Message[MsgOffset + SIGMA[i][11]]);
+		Mix(state, 2, 7, 8, 13, Message[MsgOffset + SIGMA[i][12]], Message[MsgOffset + SIGMA[i][13]]);
+		Mix(state, 3, 4, 9, 14, Message[MsgOffset + SIGMA[i][14]], Message[MsgOffset + SIGMA[i][15]]);
+	}
+
+	// the first half is the chaining value, the second half extends the root output
+	for (size_t i = 0; i < 8; ++i)
+	{
+		Output[i] = state[i] ^ state[i + 8];
+		Output[i + 8] = state[i + 8] ^ ChainValue[CvOffset + i];
+	}
+}
+
+void Blake3::ComputeChunks(const std::vector<byte> &Input, size_t InOffset, size_t Count, ulong Counter, std::vector<uint> &Output, size_t OutOffset)
+{
+	const size_t CVWORDS = DIGEST_SIZE / sizeof(uint);
+	size_t i = 0;
+
+#if defined(__AVX512__)
+	for (; i + CHUNK_LANES <= Count; i += CHUNK_LANES)
+		ComputeChunksW<Numeric::UInt512>(Input, InOffset + (i * CHUNK_SIZE), Counter + i, Output, OutOffset + (i * CVWORDS));
+#elif defined(__AVX2__)
+	for (; i + CHUNK_LANES <= Count; i += CHUNK_LANES)
+		ComputeChunksW<Numeric::UInt256>(Input, InOffset + (i * CHUNK_SIZE), Counter + i, Output, OutOffset + (i * CVWORDS));
+#endif
+
+	// the remaining chunks are compressed sequentially
+	if (i != Count)
+	{
+		std::vector<uint> cv(CVWORDS);
+		std::vector<uint> msg(16);
+		std::vector<uint> state(16);
+
+		for (; i < Count; ++i)
+		{
+			const size_t CHKOFF = InOffset + (i * CHUNK_SIZE);
+			Utility::MemUtils::Copy(m_keyWords, 0, cv, 0, DIGEST_SIZE);
+
+			for (size_t j = 0; j < CHUNK_SIZE / BLOCK_SIZE; ++j)
+			{
+				uint flags = m_dgtFlags;
+
+				if (j == 0)
+					flags |= FLAG_CHUNK_START;
+				if (j == (CHUNK_SIZE / BLOCK_SIZE) - 1)
+					flags |= FLAG_CHUNK_END;
+
+				Utility::IntUtils::LeBytesToUL512(Input, CHKOFF + (j * BLOCK_SIZE), msg, 0);
+				Compress(state, cv, 0, msg, 0, Counter + i, static_cast<uint>(BLOCK_SIZE), flags);
+				Utility::MemUtils::Copy(state, 0, cv, 0, DIGEST_SIZE);
+			}
+
+			Utility::MemUtils::Copy(cv, 0, Output, OutOffset + (i * CVWORDS), DIGEST_SIZE);
+		}
+	}
+}
+
+template <typename T>
+void Blake3::ComputeChunksW(const std::vector<byte> &Input, size_t InOffset, ulong Counter, std::vector<uint> &Output, size_t OutOffset)
+{
+	// one chunk per lane; the message words are transposed so that a register holds the same word from every chunk
+	const size_t LANES = CHUNK_LANES;
+	const size_t BLKCNT = CHUNK_SIZE / BLOCK_SIZE;
+	std::vector<uint> ctrHigh(LANES);
+	std::vector<uint> ctrLow(LANES);
+	std::vector<uint> msg(BLKCNT * 16 * LANES);
+	T H[8];
+	T M[16];
+	T S[16];
+
+	for (size_t n = 0; n < LANES; ++n)
+	{
+		ctrLow[n] = static_cast<uint>(Counter + n);
+		ctrHigh[n] = static_cast<uint>((Counter + n) >> 32);
+	}
+
+	for (size_t i = 0; i < 8; ++i)
+		H[i] = T(m_keyWords[i]);
+
+	const T CTRH(ctrHigh, 0);
+	const T CTRL(ctrLow, 0);
+	const T BLKLEN(static_cast<uint>(BLOCK_SIZE));
+
+	// the chunks are transposed in one pass, ahead of the vector loads
+	for (size_t j = 0; j < BLKCNT * 16; ++j)
+	{
+		for (size_t n = 0; n < LANES; ++n)
+			msg[(j * LANES) + n] = Utility::IntUtils::LeBytesTo32(Input, InOffset + (n * CHUNK_SIZE) + (j * sizeof(uint)));
+	}
+
+	for (size_t j = 0; j < BLKCNT; ++j)
+	{
+		uint flags = m_dgtFlags;
+
+		if (j == 0)
+			flags |= FLAG_CHUNK_START;
+		if (j == BLKCNT - 1)
+			flags |= FLAG_CHUNK_END;
+
+		for (size_t w = 0; w < 16; ++w)
+			M[w].Load(msg, ((j * 16) + w) * LANES);
+
+		for (size_t i = 0; i < 8; ++i)
+			S[i] = H[i];
+
+		S[8] = T(IV[0]);
+		S[9] = T(IV[1]);
+		S[10] = T(IV[2]);
+		S[11] = T(IV[3]);
+		S[12] = CTRL;
+		S[13] = CTRH;
+		S[14] = BLKLEN;
+		S[15] = T(flags);
+
+		for (size_t i = 0; i < 7; ++i)
+		{
+			MixW(S[0], S[4], S[8], S[12], M[SIGMA[i][0]], M[SIGMA[i][1]]);
+			MixW(S[1], S[5], S[9], S[13], M[SIGMA[i][2]], M[SIGMA[i][3]]);
+			MixW(S[2], S[6], S[10], S[14], M[SIGMA[i][4]], M[SIGMA[i][5]]);
+			MixW(S[3], S[7], S[11], S[15], M[SIGMA[i][6]], M[SIGMA[i][7]]);
+			MixW(S[0], S[5], S[10], S[15], M[SIGMA[i][8]], M[SIGMA[i][9]]);
+			MixW(S[1], S[6], S[11], S[12], M[SIGMA[i][10]], M[SIGMA[i][11]]);
+			MixW(S[2], S[7], S[8], S[13], M[SIGMA[i][12]], M[SIGMA[i][13]]);
+			MixW(S[3], S[4], S[9], S[14], M[SIGMA[i][14]], M[SIGMA[i][15]]);
+		}
+
+		for (size_t i = 0; i < 8; ++i)
+			H[i] = S[i] ^ S[i + 8];
+	}
+
+	// transpose the chaining values back to one contiguous 8 word value per chunk
+	for (size_t i = 0; i < 8; ++i)
+		H[i].Store(msg, i * LANES);
+
+	for (size_t n = 0; n < LANES; ++n)
+	{
+		for (size_t i = 0; i < 8; ++i)
+			Output[OutOffset + (n * 8) + i] = msg[(i * LANES) + n];
+	}
+
+	Utility::MemUtils::Clear(msg, 0, msg.size() * sizeof(uint));
+}
+
+void Blake3::Mix(std::array<uint, 16> &State, size_t A, size_t B, size_t C, size_t D, uint X, uint Y)
+{
+	State[A] += State[B] + X;
+	State[D] = Utility::IntUtils::RotR32(State[D] ^ State[A], 16);
+	State[C] += State[D];
+	State[B] = Utility::IntUtils::RotR32(State[B] ^ State[C], 12);
+	State[A] += State[B] + Y;
+	State[D] = Utility::IntUtils::RotR32(State[D] ^ State[A], 8);
+	State[C] += State[D];
+	State[B] = Utility::IntUtils::RotR32(State[B] ^ State[C], 7);
+}
+
+template <typename T>
+void Blake3::MixW(T &A, T &B, T &C, T &D, const T &X, const T &Y)
+{
+	A += B + X;
+	D = T::RotR32(D ^ A, 16);
+	C += D;
+	B = T::RotR32(B ^ C, 12);
+	A += B + Y;
+	D = T::RotR32(D ^ A, 8);
+	C += D;
+	B = T::RotR32(B ^ C, 7);
+}
+
+void Blake3::ProcessChunks(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	const size_t CVWORDS = DIGEST_SIZE / sizeof(uint);
+	const size_t CHKCNT = Length / CHUNK_SIZE;
+	const size_t THDCNT = m_parallelProfile.ParallelMaxDegree();
+
+	if (CHKCNT == 0)
+		return;
+
+	std::vector<uint> cvs(CHKCNT * CVWORDS);
+
+	if (m_parallelProfile.IsParallel() && THDCNT > 1 && Length >= m_parallelProfile.ParallelMinimumSize() && CHKCNT % THDCNT == 0)
+	{
+		// each thread hashes a contiguous range of chunks; the chaining values are added to the tree in order
+		const size_t THDCHK = CHKCNT / THDCNT;
+		const ulong CTR = m_chunkCount;
+		// a thread reads only its own range, so it can run on the node that holds it
+		const byte* NUMPTR = m_parallelProfile.IsNumaAware() ? Input.data() + InOffset : nullptr;
+
+		Utility::ParallelUtils::ParallelFor(0, THDCNT, NUMPTR, THDCHK * CHUNK_SIZE, [this, &Input, InOffset, &cvs, THDCHK, CTR, CVWORDS](size_t i)
+		{
+			ComputeChunks(Input, InOffset + (i * THDCHK * CHUNK_SIZE), THDCHK, CTR + (i * THDCHK), cvs, i * THDCHK * CVWORDS);
+		});
+	}
+	else
+	{
+		ComputeChunks(Input, InOffset, CHKCNT, m_chunkCount, cvs, 0);
+	}
+
+	for (size_t i = 0; i < CHKCNT; ++i)
+		PushChainValue(cvs, i * CVWORDS);
+
+	Utility::MemUtils::Clear(cvs, 0, cvs.size() * sizeof(uint));
+}
+
+void Blake3::PushChainValue(const std::vector<uint> &ChainValue, size_t CvOffset)
+{
+	const size_t CVWORDS = DIGEST_SIZE / sizeof(uint);
+
+	Utility::MemUtils::Copy(ChainValue, CvOffset, m_cvStack, m_cvStackLength * CVWORDS, DIGEST_SIZE);
+	++m_cvStackLength;
+	++m_chunkCount;
+
+	// a completed subtree for every trailing zero bit of the chunk count; the top two entries are merged into their parent
+	ulong total = m_chunkCount;
+
+	while ((total & 1) == 0)
+	{
+		const size_t PRNOFF = (m_cvStackLength - 2) * CVWORDS;
+		Compress(m_nodeState, m_keyWords, 0, m_cvStack, PRNOFF, 0, static_cast<uint>(BLOCK_SIZE), m_dgtFlags | FLAG_PARENT);
+		Utility::MemUtils::Copy(m_nodeState, 0, m_cvStack, PRNOFF, DIGEST_SIZE);
+		--m_cvStackLength;
+		total >>= 1;
+	}
+}
+
+NAMESPACE_DIGESTEND
@@ -0,0 +1,308 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Principal Algorithms:
+// An implementation of BLAKE3, designed by Jack O'Connor, Jean-Philippe Aumasson, Samuel Neves, and Zooko Wilcox-O'Hearn.
+// BLAKE3 specification <a href="https://github.com/BLAKE3-team/BLAKE3-specs/blob/master/blake3.pdf">BLAKE3: one function, fast everywhere</a>.
+//
+// Implementation Details:
+// An implementation of the BLAKE3 digest, keyed hash, and extendable output function.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_BLAKE3_H
+#define CEX_BLAKE3_H
+
+#include "IDigest.h"
+
+NAMESPACE_DIGEST
+
+/// <summary>
+/// An implementation of the BLAKE3 digest, with keyed hashing and an extendable output
+/// </summary>
+///
+/// <example>
+/// <description>Example using the Compute method:</description>
+/// <code>
+/// Blake3 dgt;
+/// std:vector&lt;byte&gt; hash(dgt.DigestSize(), 0);
+/// // compute a hash
+/// dgt.Compute(input, hash);
+/// </code>
+/// </example>
+///
+/// <example>
+/// <description>A keyed hash with an extended output length:</description>
+/// <code>
+/// // the key is 32 bytes
+/// Blake3 dgt(key);
+/// std:vector&lt;byte&gt; output(100, 0);
+/// dgt.Update(input, 0, input.size());
+/// dgt.Finalize(output, 0, output.size());
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Overview:</description>
+/// <para>BLAKE3 splits the message into 1024 byte chunks, each hashed with a reduced 7 round variant of the Blake2S compression function to a 32 byte chaining value.
+/// The chaining values are combined pairwise in a binary tree of unbounded size, and the root node is compressed with a block counter to produce any length of output. \n
+/// Because the chunks are independent, they are compressed in parallel SIMD lanes, and large inputs are split between threads, without changing the hash value.</para>
+///
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The default digest output size is 32 bytes (256 bits); the Finalize(Output, OutOffset, Length) overload produces an output of any length.</description></item>
+/// <item><description>The keyed mode is selected by constructing the digest with a 32 byte key.</description></item>
+/// <item><description>Chunks are compressed 8 at a time with AVX2, or 16 at a time with AVX512 when enabled in CexConfig; the remainder is compressed sequentially.</description></item>
+/// <item><description>When the Parallel flag is set on a multi-core system, inputs of ParallelBlockSize or more are split between threads; the hash value does not depend on the thread count.</description></item>
+/// <item><description>The <see cref="Compute(byte[])"/> method wraps the <see cref="Update(byte[], size_t, size_t)"/> and Finalize methods</description>/></item>
+/// <item><description>The <see cref="Finalize(byte[], size_t)"/> method resets the internal state.</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>BLAKE3 <a href="https://github.com/BLAKE3-team/BLAKE3-specs/blob/master/blake3.pdf">specification</a>.</description></item>
+/// <item><description>BLAKE3 on <a href="https://github.com/BLAKE3-team/BLAKE3">Github</a>.</description></item>
+/// <item><description>Blake2 whitepaper <a href="https://blake2.net/blake2.pdf">BLAKE2: simpler, smaller, fast as MD5</a>.</description></item>
+/// </list>
+/// </remarks>
+class Blake3 : public IDigest
+{
+private:
+
+	static const size_t BLOCK_SIZE = 64;
+	static const size_t CHUNK_SIZE = 1024;
+#if defined(__AVX512__)
+	static const size_t CHUNK_LANES = 16;
+#else
+	static const size_t CHUNK_LANES = 8;
+#endif
+	static const std::string CLASS_NAME;
+	static const size_t DIGEST_SIZE = 32;
+	static const uint FLAG_CHUNK_START = 1;
+	static const uint FLAG_CHUNK_END = 2;
+	static const uint FLAG_PARENT = 4;
+	static const uint FLAG_ROOT = 8;
+	static const uint FLAG_KEYED_HASH = 16;
+	static const std::vector<uint> IV;
+	static const size_t KEY_SIZE = 32;
+	// the chaining value stack depth; one entry for each bit of the 64 bit chunk counter
+	static const size_t MAX_DEPTH = 64;
+	static const byte SIGMA[7][16];
+	static const byte STATE_VERSION = 1;
+
+	ulong m_chunkCount;
+	std::vector<uint> m_cvStack;
+	size_t m_cvStackLength;
+	uint m_dgtFlags;
+	bool m_isDestroyed;
+	std::vector<uint> m_keyWords;
+	std::vector<byte> m_msgBuffer;
+	size_t m_msgLength;
+	std::vector<uint> m_nodeState;
+	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_segmentStage;
+
+public:
+
+	Blake3(const Blake3&) = delete;
+	Blake3& operator=(const Blake3&) = delete;
+	Blake3& operator=(Blake3&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The Digests internal blocksize in bytes
+	/// </summary>
+	size_t BlockSize() override;
+
+	/// <summary>
+	/// Get: Size of returned digest in bytes
+	/// </summary>
+	size_t DigestSize() override;
+
+	/// <summary>
+	/// Get: The digests type name
+	/// </summary>
+	const Digests Enumeral() override;
+
+	/// <summary>
+	/// Get: Processor parallelization availability.
+	/// <para>Indicates whether parallel processing is available on this system.
+	/// If parallel capable, input data array passed to the Update function must be ParallelBlockSize in bytes to trigger parallelization.</para>
+	/// </summary>
+	const bool IsParallel() override;
+
+	/// <summary>
+	/// Get: The digests class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Get: Parallel block size; the byte-size of the input data array passed to the Update function that triggers parallel processing.
+	/// <para>This value can be changed through the ParallelProfile class.<para>
+	/// </summary>
+	const size_t ParallelBlockSize() override;
+
+	/// <summary>
+	/// Get/Set: Contains parallel settings and SIMD capability flags in a ParallelOptions structure.
+	/// <para>The maximum number of threads allocated when using multi-threaded processing can be set with the ParallelMaxDegree(size_t) function.
+	/// Changing the thread count does not change the hash value.</para>
+	/// </summary>
+	ParallelOptions &ParallelProfile() override;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Initialize the digest in the default hashing mode
+	/// </summary>
+	///
+	/// <param name="Parallel">Setting the Parallel flag to true splits large inputs between threads; the hash value is unchanged</param>
+	explicit Blake3(bool Parallel = false);
+
+	/// <summary>
+	/// Initialize the digest in the keyed hashing mode
+	/// </summary>
+	///
+	/// <param name="Key">The 32 byte key</param>
+	/// <param name="Parallel">Setting the Parallel flag to true splits large inputs between threads; the hash value is unchanged</param>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the key is not 32 bytes</exception>
+	explicit Blake3(const std::vector<byte> &Key, bool Parallel = false);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~Blake3() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Get the Hash value
+	/// </summary>
+	///
+	/// <param name="Input">Input data</param>
+	/// <param name="Output">The hash output value array</param>
+	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Do final processing and get the 32 byte hash value
+	/// </summary>
+	///
+	/// <param name="Output">The Hash output value array</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	///
+	/// <returns>Size of Hash value</returns>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the output buffer is too short</exception>
+	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Do final processing and get an output of any length; the extendable output function.
+	/// <para>The first 32 bytes of the output are the hash value returned by the standard Finalize function.</para>
+	/// </summary>
+	///
+	/// <param name="Output">The output array</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	/// <param name="Length">The number of output bytes to generate</param>
+	///
+	/// <returns>The number of bytes generated</returns>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the output buffer is too short</exception>
+	size_t Finalize(std::vector<byte> &Output, size_t OutOffset, size_t Length);
+
+	/// <summary>
+	/// Restore the internal state from a checkpoint created by the SaveState function.
+	/// <para>The digest must be constructed with the same key as the instance that created the state;
+	/// hashing resumes from the checkpoint, and subsequent Update and Finalize calls produce the same hash as an uninterrupted digest.</para>
+	/// </summary>
+	///
+	/// <param name="State">The serialized digest state</param>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the state version, digest type, or hashing mode do not match this instance</exception>
+	void LoadState(const std::vector<byte> &State) override;
+
+	/// <summary>
+	/// Set the number of threads allocated when using multi-threaded processing.
+	/// <para>Thread count must be an even number, and not exceed the number of processor cores.
+	/// Changing this value does not change the hash value.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	///
+	/// <exception cref="Exception::CryptoDigestException">Thrown if an invalid degree setting is used</exception>
+	void ParallelMaxDegree(size_t Degree) override;
+
+	/// <summary>
+	/// Reset the internal state
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Serialize the internal state; the version, hashing mode, chunk counter, chaining value stack, and the pending message bytes.
+	/// <para>The key is not written to the state.</para>
+	/// </summary>
+	///
+	/// <returns>The serialized digest state</returns>
+	std::vector<byte> SaveState() override;
+
+	/// <summary>
+	/// Update the digest with a single byte
+	/// </summary>
+	///
+	/// <param name="Input">Input byte</param>
+	void Update(byte Input) override;
+
+	/// <summary>
+	/// Update the buffer
+	/// </summary>
+	///
+	/// <param name="Input">Input data</param>
+	/// <param name="InOffset">The starting offset within the Input array</param>
+	/// <param name="Length">Amount of data to process in bytes</param>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the input buffer is too short</exception>
+	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
+
+	/// <summary>
+	/// Update the buffer with a message stored as a list of fragments
+	/// <para>The fragments are absorbed in list order as one contiguous message; a partial block is carried across each fragment boundary, so no fragment is copied.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of message fragments</param>
+	void UpdateSegments(const std::vector<MemorySegment> &Input) override;
+
+private:
+
+	static void Compress(std::vector<uint> &Output, const std::vector<uint> &ChainValue, size_t CvOffset, const std::vector<uint> &Message, size_t MsgOffset, ulong Counter, uint BlockLength, uint Flags);
+	void ComputeChunks(const std::vector<byte> &Input, size_t InOffset, size_t Count, ulong Counter, std::vector<uint> &Output, size_t OutOffset);
+	template <typename T>
+	void ComputeChunksW(const std::vector<byte> &Input, size_t InOffset, ulong Counter, std::vector<uint> &Output, size_t OutOffset);
+	static void Mix(std::array<uint, 16> &State, size_t A, size_t B, size_t C, size_t D, uint X, uint Y);
+	template <typename T>
+	static void MixW(T &A, T &B, T &C, T &D, const T &X, const T &Y);
+	void ProcessChunks(const std::vector<byte> &Input, size_t InOffset, size_t Length);
+	void PushChainValue(const std::vector<uint> &ChainValue, size_t CvOffset);
+};
+
+NAMESPACE_DIGESTEND
+#endif
@@ -4,6 +4,9 @@
 #include "IntUtils.h"
 #include "MemUtils.h"
 #include "ParallelUtils.h"
+#include "SegmentUtils.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
 
 NAMESPACE_DIGEST
 
@@ -57,10 +60,13 @@ Blake512::Blake512(bool Parallel)
 	m_cIV(BCIV),
 	m_dgtState(Parallel ? DEF_PRLDEGREE : 1),
 	m_isDestroyed(false),
+	m_keyInfo(0),
+	m_keySalt(0),
 	m_leafSize(Parallel ? DEF_LEAFSIZE : BLOCK_SIZE),
 	m_msgBuffer(Parallel ? 2 * DEF_PRLDEGREE * BLOCK_SIZE : BLOCK_SIZE),
 	m_msgLength(0),
 	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, DEF_PRLDEGREE),
+	m_segmentStage(0),
 	m_treeConfig(8),
 	m_treeDestroy(true)
 {
@@ -87,10 +93,13 @@ Blake512::Blake512(BlakeParams &Params)
 	m_cIV(BCIV),
 	m_dgtState(Params.FanOut() > 0 ? Params.FanOut() : 1),
 	m_isDestroyed(false),
+	m_keyInfo(0),
+	m_keySalt(0),
 	m_leafSize(BLOCK_SIZE),
 	m_msgBuffer(Params.FanOut() > 0 ? 2 * Params.FanOut() * BLOCK_SIZE : BLOCK_SIZE),
 	m_msgLength(0),
 	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, Params.FanOut()),
+	m_segmentStage(0),
 	m_treeConfig(CHAIN_SIZE),
 	m_treeDestroy(false),
 	m_treeParams(Params)
@@ -140,6 +149,9 @@ void Blake512::Destroy()
 
 		Utility::IntUtils::ClearVector(m_cIV);
 		Utility::IntUtils::ClearVector(m_msgBuffer);
+		Utility::IntUtils::ClearVector(m_segmentStage);
+		Utility::IntUtils::ClearVector(m_keyInfo);
+		Utility::IntUtils::ClearVector(m_keySalt);
 		Utility::IntUtils::ClearVector(m_treeConfig);
 
 		for (size_t i = 0; i < m_dgtState.size(); ++i)
@@ -257,30 +269,36 @@ size_t Blake512::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 
 void Blake512::Initialize(Key::Symmetric::ISymmetricKey &MacKey)
 {
-	if (MacKey.Key().size() < 32 || MacKey.Key().size() > 64)
+	SymmetricKeyView keyView(MacKey);
+
+	if (keyView.Key().size() < 32 || keyView.Key().size() > 64)
 		throw Exception::CryptoDigestException("Blake512", "Mac Key has invalid length!");
 
-	if (MacKey.Nonce().size() != 0)
+	// the salt and info words replace config words 4-5 and 6-7 of every node; they are kept for Reset and the root node
+	m_keySalt.clear();
+	m_keyInfo.clear();
+
+	if (keyView.Nonce().size() != 0)
 	{
-		if (MacKey.Nonce().size() != 16)
+		if (keyView.Nonce().size() != 16)
 			throw Exception::CryptoDigestException("Blake512", "Salt has invalid length!");
 
-		m_treeConfig[4] = Utility::IntUtils::LeBytesTo64(MacKey.Nonce(), 0);
-		m_treeConfig[5] = Utility::IntUtils::LeBytesTo64(MacKey.Nonce(), 8);
+		m_keySalt.push_back(Utility::IntUtils::LeBytesTo64(keyView.Nonce(), 0));
+		m_keySalt.push_back(Utility::IntUtils::LeBytesTo64(keyView.Nonce(), 8));
 	}
 
-	if (MacKey.Info().size() != 0)
+	if (keyView.Info().size() != 0)
 	{
-		if (MacKey.Info().size() != 16)
+		if (keyView.Info().size() != 16)
 			throw Exception::CryptoDigestException("Blake512", "Info has invalid length!");
 
-		m_treeConfig[6] = Utility::IntUtils::LeBytesTo64(MacKey.Info(), 0);
-		m_treeConfig[7] = Utility::IntUtils::LeBytesTo64(MacKey.Info(), 8);
+		m_keyInfo.push_back(Utility::IntUtils::LeBytesTo64(keyView.Info(), 0));
+		m_keyInfo.push_back(Utility::IntUtils::LeBytesTo64(keyView.Info(), 8));
 	}
 
 	std::vector<byte> mkey(BLOCK_SIZE, 0);
-	Utility::MemUtils::Copy(MacKey.Key(), 0, mkey, 0, Utility::IntUtils::Min(MacKey.Key().size(), mkey.size()));
-	m_treeParams.KeyLength() = (byte)MacKey.Key().size();
+	Utility::MemUtils::Copy(keyView.Key(), 0, mkey, 0, Utility::IntUtils::Min(keyView.Key().size(), mkey.size()));
+	m_treeParams.KeyLength() = (byte)keyView.Key().size();
 
 	if (m_parallelProfile.IsParallel())
 	{
@@ -302,6 +320,77 @@ void Blake512::Initialize(Key::Symmetric::ISymmetricKey &MacKey)
 	}
 }
 
+void Blake512::LoadState(const std::vector<byte> &State)
+{
+	if (State.size() < 10 + sizeof(ushort))
+		throw CryptoDigestException("Blake512:LoadState", "The state array is too short!");
+
+	IO::MemoryStream strm(State);
+	IO::StreamReader reader(strm);
+
+	if (reader.ReadByte() != STATE_VERSION)
+		throw CryptoDigestException("Blake512:LoadState", "The state version is not supported!");
+	if (reader.ReadByte() != static_cast<byte>(Digests::Blake512))
+		throw CryptoDigestException("Blake512:LoadState", "The state was not created by this digest!");
+
+	const size_t LEAFCNT = reader.ReadInt<uint>();
+	if (LEAFCNT != m_dgtState.size())
+		throw CryptoDigestException("Blake512:LoadState", "The number of tree leaves does not match this digest instance!");
+
+	const size_t PRMLEN = reader.ReadInt<ushort>();
+	if (reader.Position() + PRMLEN + 3 + sizeof(uint) > State.size())
+		throw CryptoDigestException("Blake512:LoadState", "The state array is malformed!");
+
+	// the tree parameters are fixed by the instance settings and key; a state hashed under different parameters is rejected, not adopted
+	if (PRMLEN != m_treeParams.ToBytes().size())
+		throw CryptoDigestException("Blake512:LoadState", "The tree parameters do not match this digest instance!");
+
+	BlakeParams params(reader.ReadBytes(PRMLEN));
+	// the node depth and offset are rewritten as each node is loaded
+	params.NodeDepth() = m_treeParams.NodeDepth();
+	params.NodeOffset() = m_treeParams.NodeOffset();
+
+	if (params.ToBytes() != m_treeParams.ToBytes())
+		throw CryptoDigestException("Blake512:LoadState", "The tree parameters do not match this digest instance!");
+
+	const size_t SLTLEN = reader.ReadByte();
+	if ((SLTLEN != 0 && SLTLEN != 2) || reader.Position() + (SLTLEN * sizeof(ulong)) + 2 + sizeof(uint) > State.size())
+		throw CryptoDigestException("Blake512:LoadState", "The state array is malformed!");
+
+	std::vector<ulong> salt(SLTLEN);
+	reader.Read(salt, 0, SLTLEN);
+
+	const size_t INFLEN = reader.ReadByte();
+	if ((INFLEN != 0 && INFLEN != 2) || reader.Position() + (INFLEN * sizeof(ulong)) + 1 + sizeof(uint) > State.size())
+		throw CryptoDigestException("Blake512:LoadState", "The state array is malformed!");
+
+	std::vector<ulong> info(INFLEN);
+	reader.Read(info, 0, INFLEN);
+
+	// the key blocks are never serialized; they are taken from this instance, which must hold the same key
+	const bool KEYPND = (reader.ReadByte() != 0);
+	if (KEYPND && KeyPrefixSize() == 0)
+		throw CryptoDigestException("Blake512:LoadState", "The digest must be initialized with the same key before loading a keyed state!");
+
+	const size_t KEYLEN = KEYPND ? KeyPrefixSize() : 0;
+	const size_t MSGLEN = reader.ReadInt<uint>();
+
+	if (KEYLEN + MSGLEN > m_msgBuffer.size() || reader.Position() + MSGLEN + (LEAFCNT * ((CHAIN_SIZE + COUNTER_SIZE) * sizeof(ulong))) != State.size())
+		throw CryptoDigestException("Blake512:LoadState", "The state array is malformed!");
+
+	m_keySalt = salt;
+	m_keyInfo = info;
+	Utility::MemUtils::Clear(m_msgBuffer, KEYLEN, m_msgBuffer.size() - KEYLEN);
+	reader.Read(m_msgBuffer, KEYLEN, MSGLEN);
+	m_msgLength = KEYLEN + MSGLEN;
+
+	for (size_t i = 0; i < m_dgtState.size(); ++i)
+	{
+		reader.Read(m_dgtState[i].H, 0, m_dgtState[i].H.size());
+		reader.Read(m_dgtState[i].T, 0, m_dgtState[i].T.size());
+	}
+}
+
 void Blake512::ParallelMaxDegree(size_t Degree)
 {
 	if (Degree == 0)
@@ -347,6 +436,36 @@ void Blake512::Reset()
 	}
 }
 
+std::vector<byte> Blake512::SaveState()
+{
+	std::vector<byte> params = m_treeParams.ToBytes();
+	const size_t KEYLEN = KeyPrefixSize();
+	const size_t MSGLEN = m_msgLength - KEYLEN;
+	IO::StreamWriter writer(13 + sizeof(ushort) + params.size() + ((m_keySalt.size() + m_keyInfo.size()) * sizeof(ulong)) + MSGLEN + (m_dgtState.size() * ((CHAIN_SIZE + COUNTER_SIZE) * sizeof(ulong))));
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Digests::Blake512));
+	writer.Write(static_cast<uint>(m_dgtState.size()));
+	writer.Write(static_cast<ushort>(params.size()));
+	writer.Write(params, 0, params.size());
+	writer.Write(static_cast<byte>(m_keySalt.size()));
+	writer.Write(m_keySalt);
+	writer.Write(static_cast<byte>(m_keyInfo.size()));
+	writer.Write(m_keyInfo);
+	// a key block still waiting in the buffer is flagged, but not written
+	writer.Write(static_cast<byte>(KEYLEN != 0 ? 1 : 0));
+	writer.Write(static_cast<uint>(MSGLEN));
+	writer.Write(m_msgBuffer, KEYLEN, MSGLEN);
+
+	for (size_t i = 0; i < m_dgtState.size(); ++i)
+	{
+		writer.Write(m_dgtState[i].H);
+		writer.Write(m_dgtState[i].T);
+	}
+
+	return writer.GetBytes();
+}
+
 void Blake512::Update(byte Input)
 {
 	std::vector<byte> inp(1, Input);
@@ -458,6 +577,11 @@ void Blake512::Update(const std::vector<byte> &Input, size_t InOffset, size_t Le
 	}
 }
 
+void Blake512::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input, m_segmentStage);
+}
+
 //~~~Private Functions~~~//
 
 void Blake512::Compress(const std::vector<byte> &Input, size_t InOffset, Blake2bState &State, size_t Length)
@@ -466,12 +590,35 @@ void Blake512::Compress(const std::vector<byte> &Input, size_t InOffset, Blake2b
 	Blake2B::Compress128(Input, InOffset, State, m_cIV);
 }
 
+size_t Blake512::KeyPrefixSize()
+{
+	// the MAC key blocks lead the buffer until the first leaf compression
+	const size_t KEYLEN = m_parallelProfile.IsParallel() ? m_parallelProfile.ParallelMinimumSize() : BLOCK_SIZE;
+
+	if (m_treeParams.KeyLength() == 0 || m_dgtState[0].T[0] != 0 || m_dgtState[0].T[1] != 0 || m_msgLength < KEYLEN)
+		return 0;
+
+	return KEYLEN;
+}
+
 void Blake512::LoadState(Blake2bState &State)
 {
 	Utility::MemUtils::Clear(State.T, 0, COUNTER_SIZE * sizeof(ulong));
 	Utility::MemUtils::Clear(State.F, 0, FLAG_SIZE * sizeof(ulong));
 	Utility::MemUtils::Copy(m_cIV, 0, State.H, 0, CHAIN_SIZE * sizeof(ulong));
 	m_treeParams.GetConfig<ulong>(m_treeConfig);
+
+	if (m_keySalt.size() != 0)
+	{
+		m_treeConfig[4] = m_keySalt[0];
+		m_treeConfig[5] = m_keySalt[1];
+	}
+	if (m_keyInfo.size() != 0)
+	{
+		m_treeConfig[6] = m_keyInfo[0];
+		m_treeConfig[7] = m_keyInfo[1];
+	}
+
 	Utility::MemUtils::XOR512(m_treeConfig, 0, State.H, 0);
 }
 
@@ -42,6 +42,7 @@
 NAMESPACE_DIGEST
 
 using Key::Symmetric::ISymmetricKey;
+using Key::Symmetric::SymmetricKeyView;
 
 /// <summary>
 /// An implementation of the Blake2B and Blake2BP digests with a 512 bit digest output size
@@ -123,6 +124,7 @@ private:
 	static const size_t ROUND_COUNT = 12;
 	// size of reserved state buffer subtracted from parallel size calculations
 	static const size_t STATE_PRECACHED = 2048;
+	static const byte STATE_VERSION = 2;
 	static const ulong ULL_MAX = 18446744073709551615;
 
 	struct Blake2bState
@@ -162,6 +164,8 @@ private:
 	std::vector<ulong> m_cIV;
 	std::vector<Blake2bState> m_dgtState;
 	bool m_isDestroyed;
+	std::vector<ulong> m_keyInfo;
+	std::vector<ulong> m_keySalt;
 	uint m_leafSize;
 	std::vector<byte> m_msgBuffer;
 	size_t m_msgLength;
@@ -169,6 +173,7 @@ private:
 	bool m_treeDestroy;
 	BlakeParams m_treeParams;
 	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_segmentStage;
 
 public:
 
@@ -283,6 +288,18 @@ public:
 	/// The maximum combined size of Key, Salt, and Info, must be 64 bytes or less.</para></param>
 	void Initialize(ISymmetricKey &MacKey);
 
+	/// <summary>
+	/// Restore the internal state from a checkpoint created by the SaveState function.
+	/// <para>The digest must be constructed with the same parallel and tree settings as the instance that created the state;
+	/// hashing resumes from the checkpoint, and subsequent Update and Finalize calls produce the same hash as an uninterrupted digest.
+	/// A keyed state does not contain the key; the digest must first be initialized with the same key, and the salt and info words are restored from the state.</para>
+	/// </summary>
+	///
+	/// <param name="State">The serialized digest state</param>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the state version, digest type, tree parameters, or number of tree leaves do not match this instance, or a keyed state is loaded into an unkeyed digest</exception>
+	void LoadState(const std::vector<byte> &State) override;
+
 	/// <summary>
 	/// Set the number of threads allocated when using multi-threaded tree hashing processing.
 	/// <para>Thread count must be an even number, and not exceed the number of processor cores.
@@ -299,6 +316,15 @@ public:
 	/// </summary>
 	void Reset() override;
 
+	/// <summary>
+	/// Serialize the internal state; the version, tree parameters, salt and info words, pending message bytes, and the chaining value and counter of each leaf.
+	/// <para>Only the unprocessed bytes of the message buffer are written, and each leaf is stored as its raw chaining and counter words.
+	/// A MAC key block that has not yet been compressed is omitted from the pending bytes.</para>
+	/// </summary>
+	///
+	/// <returns>The serialized digest state</returns>
+	std::vector<byte> SaveState() override;
+
 	/// <summary>
 	/// Update the message digest with a single byte
 	/// </summary>
@@ -320,9 +346,18 @@ public:
 	/// <param name="Length">The amount of data to process in bytes</param>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the buffer with a message stored as a list of fragments
+	/// <para>The fragments are absorbed in list order as one contiguous message; a partial block is carried across each fragment boundary, so no fragment is copied.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of message fragments</param>
+	void UpdateSegments(const std::vector<MemorySegment> &Input) override;
+
 private:
 
 	void Compress(const std::vector<byte> &Input, size_t InOffset, Blake2bState &State, size_t Length);
+	size_t KeyPrefixSize();
 	void LoadState(Blake2bState &State);
 	void ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, Blake2bState &State, ulong Length);
 };
@@ -3,6 +3,7 @@
 #include "IntUtils.h"
 #include "MemUtils.h"
 #include "ParallelUtils.h"
+#include "SegmentUtils.h"
 
 NAMESPACE_MODE
 
@@ -70,6 +71,7 @@ ParallelOptions &CBC::ParallelProfile()
 CBC::CBC(BlockCiphers CipherType)
 	:
 	m_blockCipher(Helper::BlockCipherFromName::GetInstance(CipherType)),
+	m_cbcNext(BLOCK_SIZE),
 	m_cbcVector(BLOCK_SIZE),
 	m_cipherType(CipherType),
 	m_destroyEngine(true),
@@ -77,13 +79,17 @@ CBC::CBC(BlockCiphers CipherType)
 	m_isEncryption(false),
 	m_isInitialized(false),
 	m_isLoaded(false),
-	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
+	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0),
+	m_thdBuffer(0),
+	m_thdVector(0)
 {
 }
 
 CBC::CBC(IBlockCipher* Cipher)
 	:
 	m_blockCipher(Cipher != 0 ? Cipher : throw CryptoCipherModeException("CBC:CTor", "The Cipher can not be null!")),
+	m_cbcNext(BLOCK_SIZE),
 	m_cbcVector(BLOCK_SIZE),
 	m_cipherType(Cipher->Enumeral()),
 	m_destroyEngine(false),
@@ -91,7 +97,10 @@ CBC::CBC(IBlockCipher* Cipher)
 	m_isEncryption(false),
 	m_isInitialized(false),
 	m_isLoaded(false),
-	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
+	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0),
+	m_thdBuffer(0),
+	m_thdVector(0)
 {
 }
 
@@ -131,7 +140,11 @@ void CBC::Destroy()
 				delete m_blockCipher;
 		}
 
+		Utility::IntUtils::ClearVector(m_cbcNext);
 		Utility::IntUtils::ClearVector(m_cbcVector);
+		Utility::IntUtils::ClearVector(m_segmentStage);
+		Utility::IntUtils::ClearVector(m_thdBuffer);
+		Utility::IntUtils::ClearVector(m_thdVector);
 	}
 }
 
@@ -147,9 +160,11 @@ void CBC::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void CBC::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (KeyParams.Nonce().size() < 16)
+	SymmetricKeyView keyView(KeyParams);
+
+	if (keyView.Nonce().size() < 16)
 		throw CryptoSymmetricCipherException("CBC:Initialize", "Requires a minimum 16 bytes of Nonce!");
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), keyView.Key().size()))
 		throw CryptoSymmetricCipherException("CBC:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 	if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || m_parallelProfile.ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
 		throw CryptoSymmetricCipherException("CBC:Initialize", "The parallel block size is out of bounds!");
@@ -158,7 +173,7 @@ void CBC::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 
 	Scope();
 	m_blockCipher->Initialize(Encryption, KeyParams);
-	m_cbcVector = KeyParams.Nonce();
+	m_cbcVector = keyView.Nonce();
 	m_isEncryption = Encryption;
 	m_isInitialized = true;
 }
@@ -173,6 +188,7 @@ void CBC::ParallelMaxDegree(size_t Degree)
 		throw CryptoCipherModeException("CBC:ParallelMaxDegree", "Parallel degree can not exceed processor count!");
 
 	m_parallelProfile.SetMaxDegree(Degree);
+	Reserve();
 }
 
 void CBC::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
@@ -180,6 +196,11 @@ void CBC::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 	Process(Input, InOffset, Output, OutOffset, Length);
 }
 
+void CBC::TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output)
+{
+	Utility::SegmentUtils::Transform(this, Input, Output, m_segmentStage);
+}
+
 //~~~Private Functions~~~//
 
 void CBC::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
@@ -187,39 +208,37 @@ void CBC::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
 
-	std::vector<byte> nxtIv(BLOCK_SIZE);
-	Utility::MemUtils::COPY128(Input, InOffset, nxtIv, 0);
+	Utility::MemUtils::COPY128(Input, InOffset, m_cbcNext, 0);
 	m_blockCipher->DecryptBlock(Input, InOffset, Output, OutOffset);
 	Utility::MemUtils::XOR128(m_cbcVector, 0, Output, OutOffset);
-	Utility::MemUtils::COPY128(nxtIv, 0, m_cbcVector, 0);
+	Utility::MemUtils::COPY128(m_cbcNext, 0, m_cbcVector, 0);
 }
 
 void CBC::DecryptParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
 {
 	const size_t SEGSZE = m_parallelProfile.ParallelBlockSize() / m_parallelProfile.ParallelMaxDegree();
 	const size_t BLKCNT = (SEGSZE / BLOCK_SIZE);
-	std::vector<byte> tmpIv(BLOCK_SIZE);
 
-	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, &tmpIv, SEGSZE, BLKCNT](size_t i)
-	{
-		std::vector<byte> thdIv(BLOCK_SIZE);
+	if (m_thdVector.size() < m_parallelProfile.ParallelMaxDegree())
+		Reserve();
 
+	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, SEGSZE, BLKCNT](size_t i)
+	{
 		if (i != 0)
-			Utility::MemUtils::COPY128(Input, (InOffset + (i * SEGSZE)) - BLOCK_SIZE, thdIv, 0);
+			Utility::MemUtils::COPY128(Input, (InOffset + (i * SEGSZE)) - BLOCK_SIZE, m_thdVector[i], 0);
 		else
-			Utility::MemUtils::COPY128(m_cbcVector, 0, thdIv, 0);
-
-		this->DecryptSegment(Input, InOffset + i * SEGSZE, Output, OutOffset + i * SEGSZE, thdIv, BLKCNT);
+			Utility::MemUtils::COPY128(m_cbcVector, 0, m_thdVector[i], 0);
 
-		if (i == m_parallelProfile.ParallelMaxDegree() - 1)
-			Utility::MemUtils::COPY128(thdIv, 0, tmpIv, 0);
+		this->DecryptSegment(Input, InOffset + i * SEGSZE, Output, OutOffset + i * SEGSZE, m_thdVector[i], m_thdBuffer[i], BLKCNT);
 	});
 
-	Utility::MemUtils::COPY128(tmpIv, 0, m_cbcVector, 0);
+	// the last segment iv chains into the next call
+	Utility::MemUtils::COPY128(m_thdVector[m_parallelProfile.ParallelMaxDegree() - 1], 0, m_cbcVector, 0);
 }
 
-void CBC::DecryptSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t BlockCount)
+void CBC::DecryptSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, std::vector<byte> &Iv, std::vector<byte> &Buffer, const size_t BlockCount)
 {
+	// the staging buffer holds the wide iv in the first half, and the next wide iv in the second half
 	size_t blkCtr = BlockCount;
 
 #if defined(__AVX512__)
@@ -228,33 +247,31 @@ void CBC::DecryptSegment(const std::vector<byte> &Input, size_t InOffset, std::v
 		// 512bit avx
 		const size_t AVX512BLK = 256;
 		size_t rndCtr = (blkCtr / 16);
-		std::vector<byte> blkIv(AVX512BLK);
-		std::vector<byte> blkNxt(AVX512BLK);
 		const size_t BLKOFT = AVX512BLK - Iv.size();
 
 		// build wide iv
-		Utility::MemUtils::COPY128(Iv, 0, blkIv, 0);
-		Utility::MemUtils::Copy(Input, InOffset, blkIv, BLOCK_SIZE, BLKOFT);
+		Utility::MemUtils::COPY128(Iv, 0, Buffer, 0);
+		Utility::MemUtils::Copy(Input, InOffset, Buffer, BLOCK_SIZE, BLKOFT);
 
 		while (rndCtr != 0)
 		{
 			const size_t INPOFT = InOffset + BLKOFT;
 			// store next iv
-			Utility::MemUtils::Copy(Input, INPOFT, blkNxt, 0, (Input.size() - INPOFT >= AVX512BLK) ? AVX512BLK : Input.size() - INPOFT);
+			Utility::MemUtils::Copy(Input, INPOFT, Buffer, STAGE_SIZE, (Input.size() - INPOFT >= AVX512BLK) ? AVX512BLK : Input.size() - INPOFT);
 			// transform 8 blocks
 			m_blockCipher->Transform2048(Input, InOffset, Output, OutOffset);
 			// xor the set
-			Utility::MemUtils::XOR1024(blkIv, 0, Output, OutOffset);
-			Utility::MemUtils::XOR1024(blkIv + 128, 0, Output, OutOffset + 128);
+			Utility::MemUtils::XOR1024(Buffer, 0, Output, OutOffset);
+			Utility::MemUtils::XOR1024(Buffer, 128, Output, OutOffset + 128);
 			// swap iv
-			Utility::MemUtils::Copy(blkNxt, 0, blkIv, 0, AVX512BLK);
+			Utility::MemUtils::Copy(Buffer, STAGE_SIZE, Buffer, 0, AVX512BLK);
 			InOffset += AVX512BLK;
 			OutOffset += AVX512BLK;
 			blkCtr -= 16;
 			--rndCtr;
 		}
 
-		Utility::MemUtils::COPY128(blkNxt, 0, Iv, 0);
+		Utility::MemUtils::COPY128(Buffer, STAGE_SIZE, Iv, 0);
 	}
 #elif defined(__AVX2__)
 	if (blkCtr > 7)
@@ -262,32 +279,30 @@ void CBC::DecryptSegment(const std::vector<byte> &Input, size_t InOffset, std::v
 		// 256bit avx
 		const size_t AVX2BLK = 128;
 		size_t rndCtr = (blkCtr / 8);
-		std::vector<byte> blkIv(AVX2BLK);
-		std::vector<byte> blkNxt(AVX2BLK);
 		const size_t BLKOFT = AVX2BLK - Iv.size();
 
 		// build wide iv
-		Utility::MemUtils::COPY128(Iv, 0, blkIv, 0);
-		Utility::MemUtils::Copy(Input, InOffset, blkIv, BLOCK_SIZE, BLKOFT);
+		Utility::MemUtils::COPY128(Iv, 0, Buffer, 0);
+		Utility::MemUtils::Copy(Input, InOffset, Buffer, BLOCK_SIZE, BLKOFT);
 
 		while (rndCtr != 0)
 		{
 			const size_t INPOFT = InOffset + BLKOFT;
 			// store next iv
-			Utility::MemUtils::Copy(Input, INPOFT, blkNxt, 0, (Input.size() - INPOFT >= AVX2BLK) ? AVX2BLK: Input.size() - INPOFT);
+			Utility::MemUtils::Copy(Input, INPOFT, Buffer, STAGE_SIZE, (Input.size() - INPOFT >= AVX2BLK) ? AVX2BLK: Input.size() - INPOFT);
 			// transform 8 blocks
 			m_blockCipher->Transform1024(Input, InOffset, Output, OutOffset);
 			// xor the set
-			Utility::MemUtils::XOR1024(blkIv, 0, Output, OutOffset);
+			Utility::MemUtils::XOR1024(Buffer, 0, Output, OutOffset);
 			// swap iv
-			Utility::MemUtils::Copy(blkNxt, 0, blkIv, 0, AVX2BLK);
+			Utility::MemUtils::Copy(Buffer, STAGE_SIZE, Buffer, 0, AVX2BLK);
 			InOffset += AVX2BLK;
 			OutOffset += AVX2BLK;
 			blkCtr -= 8;
 			--rndCtr;
 		}
 
-		Utility::MemUtils::COPY128(blkNxt, 0, Iv, 0);
+		Utility::MemUtils::COPY128(Buffer, STAGE_SIZE, Iv, 0);
 	}
 #elif defined(__AVX__)
 	if (blkCtr > 3)
@@ -295,41 +310,37 @@ void CBC::DecryptSegment(const std::vector<byte> &Input, size_t InOffset, std::v
 		// 128bit sse3
 		const size_t AVXBLK = 64;
 		size_t rndCtr = (blkCtr / 4);
-		std::vector<byte> blkIv(AVXBLK);
-		std::vector<byte> blkNxt(AVXBLK);
 		const size_t BLKOFT = AVXBLK - Iv.size();
 
-		Utility::MemUtils::COPY128(Iv, 0, blkIv, 0);
-		Utility::MemUtils::Copy(Input, InOffset, blkIv, BLOCK_SIZE, BLKOFT);
+		Utility::MemUtils::COPY128(Iv, 0, Buffer, 0);
+		Utility::MemUtils::Copy(Input, InOffset, Buffer, BLOCK_SIZE, BLKOFT);
 
 		while (rndCtr != 0)
 		{
 			const size_t INPOFT = InOffset + BLKOFT;
-			Utility::MemUtils::Copy(Input, INPOFT, blkNxt, 0, (Input.size() - INPOFT >= AVXBLK) ? AVXBLK : Input.size() - INPOFT);
+			Utility::MemUtils::Copy(Input, INPOFT, Buffer, STAGE_SIZE, (Input.size() - INPOFT >= AVXBLK) ? AVXBLK : Input.size() - INPOFT);
 			m_blockCipher->Transform512(Input, InOffset, Output, OutOffset);
-			Utility::MemUtils::XOR512(blkIv, 0, Output, OutOffset);
-			Utility::MemUtils::Copy(blkNxt, 0, blkIv, 0, AVXBLK);
+			Utility::MemUtils::XOR512(Buffer, 0, Output, OutOffset);
+			Utility::MemUtils::Copy(Buffer, STAGE_SIZE, Buffer, 0, AVXBLK);
 			InOffset += AVXBLK;
 			OutOffset += AVXBLK;
 			blkCtr -= 4;
 			--rndCtr;
 		}
 
-		Utility::MemUtils::COPY128(blkNxt, 0, Iv, 0);
+		Utility::MemUtils::COPY128(Buffer, STAGE_SIZE, Iv, 0);
 	}
 #endif
 
 	if (blkCtr != 0)
 	{
 		// Note: if it's hitting this, your parallel block size is misaligned
-		std::vector<byte> nxtIv(BLOCK_SIZE);
-
 		while (blkCtr != 0)
 		{
-			Utility::MemUtils::COPY128(Input, InOffset, nxtIv, 0);
+			Utility::MemUtils::COPY128(Input, InOffset, Buffer, STAGE_SIZE);
 			m_blockCipher->DecryptBlock(Input, InOffset, Output, OutOffset);
 			Utility::MemUtils::XOR128(Iv, 0, Output, OutOffset);
-			Utility::MemUtils::COPY128(nxtIv, 0, Iv, 0);
+			Utility::MemUtils::COPY128(Buffer, STAGE_SIZE, Iv, 0);
 			InOffset += BLOCK_SIZE;
 			OutOffset += BLOCK_SIZE;
 			--blkCtr;
@@ -383,10 +394,21 @@ void CBC::Process(const std::vector<byte> &Input, const size_t InOffset, std::ve
 	}
 }
 
+void CBC::Reserve()
+{
+	// one iv and staging buffer per thread; sized here so the parallel decryption never allocates
+	const size_t THDCNT = Utility::IntUtils::Max(m_parallelProfile.ParallelMaxDegree(), static_cast<size_t>(1));
+
+	m_thdBuffer.resize(THDCNT, std::vector<byte>(2 * STAGE_SIZE));
+	m_thdVector.resize(THDCNT, std::vector<byte>(BLOCK_SIZE));
+}
+
 void CBC::Scope()
 {
 	if (!m_parallelProfile.IsDefault())
 		m_parallelProfile.Calculate();
+
+	Reserve();
 }
 
 NAMESPACE_MODEEND
\ No newline at end of file
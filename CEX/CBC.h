@@ -121,8 +121,18 @@ private:
 
 	static const size_t BLOCK_SIZE = 16;
 	static const std::string CLASS_NAME;
+#if defined(__AVX512__)
+	static const size_t STAGE_SIZE = 16 * BLOCK_SIZE;
+#elif defined(__AVX2__)
+	static const size_t STAGE_SIZE = 8 * BLOCK_SIZE;
+#elif defined(__AVX__)
+	static const size_t STAGE_SIZE = 4 * BLOCK_SIZE;
+#else
+	static const size_t STAGE_SIZE = BLOCK_SIZE;
+#endif
 
 	IBlockCipher* m_blockCipher;
+	std::vector<byte> m_cbcNext;
 	std::vector<byte> m_cbcVector;
 	BlockCiphers m_cipherType;
 	bool m_destroyEngine;
@@ -131,6 +141,9 @@ private:
 	bool m_isInitialized;
 	bool m_isLoaded;
 	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_segmentStage;
+	std::vector<std::vector<byte>> m_thdBuffer;
+	std::vector<std::vector<byte>> m_thdVector;
 
 public:
 
@@ -318,13 +331,27 @@ public:
 	/// <param name="Length">The number of bytes to transform</param>
 	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
 
+	/// <summary>
+	/// Transform a message stored as a list of fragments, writing the result to a second list of fragments.
+	/// <para>The two lists are processed as single contiguous messages, and may be fragmented differently.
+	/// Runs that are contiguous in both lists are passed to Transform directly; the short runs between fragment boundaries are gathered in a staging buffer owned by this instance, which is erased after each call.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of input fragments</param>
+	/// <param name="Output">The list of output fragments; the combined length must equal that of the input list</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the lists differ in length, or a segment exceeds its array</exception>
+	void TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output) override;
+
 private:
 
 	void Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void DecryptParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void DecryptSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t BlockCount);
+	void DecryptSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, std::vector<byte> &Iv, std::vector<byte> &Buffer, const size_t BlockCount);
 	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void Process(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
+	void Reserve();
 	void Scope();
 };
 
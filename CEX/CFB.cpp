@@ -3,6 +3,7 @@
 #include "IntUtils.h"
 #include "MemUtils.h"
 #include "ParallelUtils.h"
+#include "SegmentUtils.h"
 
 NAMESPACE_MODE
 
@@ -78,7 +79,9 @@ CFB::CFB(BlockCiphers CipherType, size_t RegisterSize)
 	m_isEncryption(false),
 	m_isInitialized(false),
 	m_isLoaded(false),
-	m_parallelProfile(m_blockCipher->BlockSize(), false, m_blockCipher->StateCacheSize(), true)
+	m_parallelProfile(m_blockCipher->BlockSize(), false, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0),
+	m_thdVector(0)
 {
 	if (m_blockSize == 0)
 		throw CryptoCipherModeException("CFB:CTor", "The register size can not be zero!");
@@ -97,7 +100,9 @@ CFB::CFB(IBlockCipher* Cipher, size_t RegisterSize)
 	m_isEncryption(false),
 	m_isInitialized(false),
 	m_isLoaded(false),
-	m_parallelProfile(m_blockCipher->BlockSize(), false, m_blockCipher->StateCacheSize(), true)
+	m_parallelProfile(m_blockCipher->BlockSize(), false, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0),
+	m_thdVector(0)
 {
 	if (m_blockSize == 0)
 		throw CryptoCipherModeException("CFB:CTor", "The register size can not be zero!");
@@ -143,6 +148,8 @@ void CFB::Destroy()
 		}
 
 		Utility::IntUtils::ClearVector(m_cfbVector);
+		Utility::IntUtils::ClearVector(m_segmentStage);
+		Utility::IntUtils::ClearVector(m_thdVector);
 	}
 }
 
@@ -158,9 +165,11 @@ void CFB::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void CFB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (KeyParams.Nonce().size() < 1)
+	SymmetricKeyView keyView(KeyParams);
+
+	if (keyView.Nonce().size() < 1)
 		throw CryptoSymmetricCipherException("CFB:Initialize", "Requires a minimum 1 byte of Nonce!");
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), keyView.Key().size()))
 		throw CryptoSymmetricCipherException("CBC:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 	if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || m_parallelProfile.ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
 		throw CryptoSymmetricCipherException("CFB:Initialize", "The parallel block size is out of bounds!");
@@ -168,7 +177,7 @@ void CFB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 		throw CryptoSymmetricCipherException("CFB:Initialize", "The parallel block size must be evenly aligned to the ParallelMinimumSize!");
 
 	Scope();
-	std::vector<byte> iv = KeyParams.Nonce();
+	std::vector<byte> iv = keyView.Nonce();
 	size_t diff = m_cfbVector.size() - iv.size();
 	Utility::MemUtils::Copy(iv, 0, m_cfbVector, diff, iv.size());
 	Utility::MemUtils::Clear(m_cfbVector, 0, diff);
@@ -187,6 +196,7 @@ void CFB::ParallelMaxDegree(size_t Degree)
 		throw CryptoCipherModeException("CFB:ParallelMaxDegree", "Parallel degree can not exceed processor count!");
 
 	m_parallelProfile.SetMaxDegree(Degree);
+	Reserve();
 }
 
 void CFB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
@@ -194,6 +204,11 @@ void CFB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 	Process(Input, InOffset, Output, OutOffset, Length);
 }
 
+void CFB::TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output)
+{
+	Utility::SegmentUtils::Transform(this, Input, Output, m_segmentStage);
+}
+
 //~~~Private Functions~~~//
 
 void CFB::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
@@ -219,24 +234,22 @@ void CFB::DecryptParallel(const std::vector<byte> &Input, const size_t InOffset,
 {
 	const size_t SEGSZE = m_parallelProfile.ParallelBlockSize() / m_parallelProfile.ParallelMaxDegree();
 	const size_t BLKCNT = (SEGSZE / m_blockSize);
-	std::vector<byte> tmpIv(m_blockSize);
 
-	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, &tmpIv, SEGSZE, BLKCNT](size_t i)
-	{
-		std::vector<byte> thdIv(m_blockSize);
+	if (m_thdVector.size() < m_parallelProfile.ParallelMaxDegree())
+		Reserve();
 
+	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, SEGSZE, BLKCNT](size_t i)
+	{
 		if (i != 0)
-			Utility::MemUtils::Copy(Input, (InOffset + (i * SEGSZE)) - m_blockSize, thdIv, 0, m_blockSize);
+			Utility::MemUtils::Copy(Input, (InOffset + (i * SEGSZE)) - m_blockSize, m_thdVector[i], 0, m_blockSize);
 		else
-			Utility::MemUtils::Copy(m_cfbVector, 0, thdIv, 0, m_blockSize);
+			Utility::MemUtils::Copy(m_cfbVector, 0, m_thdVector[i], 0, m_blockSize);
 
-		this->DecryptSegment(Input, InOffset + i * SEGSZE, Output, OutOffset + i * SEGSZE, thdIv, BLKCNT);
-
-		if (i == m_parallelProfile.ParallelMaxDegree() - 1)
-			Utility::MemUtils::Copy(thdIv, 0, tmpIv, 0, m_blockSize);
+		this->DecryptSegment(Input, InOffset + i * SEGSZE, Output, OutOffset + i * SEGSZE, m_thdVector[i], BLKCNT);
 	});
 
-	Utility::MemUtils::Copy(tmpIv, 0, m_cfbVector, 0, m_blockSize);
+	// the last segment register chains into the next call
+	Utility::MemUtils::Copy(m_thdVector[m_parallelProfile.ParallelMaxDegree() - 1], 0, m_cfbVector, 0, m_blockSize);
 }
 
 void CFB::DecryptSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, std::vector<byte> &Iv, const size_t BlockCount)
@@ -317,10 +330,20 @@ void CFB::Process(const std::vector<byte> &Input, const size_t InOffset, std::ve
 	}
 }
 
+void CFB::Reserve()
+{
+	// one register per thread; sized here so the parallel decryption never allocates
+	const size_t THDCNT = Utility::IntUtils::Max(m_parallelProfile.ParallelMaxDegree(), static_cast<size_t>(1));
+
+	m_thdVector.resize(THDCNT, std::vector<byte>(m_blockSize));
+}
+
 void CFB::Scope()
 {
 	if (!m_parallelProfile.IsDefault())
 		m_parallelProfile.Calculate();
+
+	Reserve();
 }
 
 NAMESPACE_MODEEND
\ No newline at end of file
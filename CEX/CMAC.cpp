@@ -3,7 +3,9 @@
 #include "IntUtils.h"
 #include "MemUtils.h"
 #include "ISO7816.h"
+#include "SegmentUtils.h"
 #include "SymmetricKey.h"
+#include "StreamWriter.h"
 
 NAMESPACE_MAC
 
@@ -56,6 +58,8 @@ CMAC::CMAC(BlockCiphers CipherType)
 	m_destroyEngine(true),
 	m_isDestroyed(false),
 	m_isInitialized(false),
+	m_K1(BLOCK_SIZE),
+	m_K2(BLOCK_SIZE),
 	m_legalKeySizes(0),
 	m_macSize(m_cipherMode->BlockSize()),
 	m_msgCode(m_macSize),
@@ -73,6 +77,8 @@ CMAC::CMAC(IBlockCipher* Cipher)
 	m_destroyEngine(false),
 	m_isDestroyed(false),
 	m_isInitialized(false),
+	m_K1(BLOCK_SIZE),
+	m_K2(BLOCK_SIZE),
 	m_legalKeySizes(0),
 	m_macSize(m_cipherMode->BlockSize()),
 	m_msgCode(m_macSize),
@@ -155,45 +161,68 @@ size_t CMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 
 void CMAC::Initialize(ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(m_cipherMode->LegalKeySizes(), KeyParams.Key().size(), 0, 0))
+	SymmetricKeyView keyView(KeyParams);
+
+	if (!SymmetricKeySize::Contains(m_cipherMode->LegalKeySizes(), keyView.Key().size(), 0, 0))
 		throw CryptoMacException("CMAC:Initialize", "Key size is too small; must be minimum key size!");
 
 	if (m_isInitialized)
 		Reset();
 
-	m_cipherKey = KeyParams.Key();
-	std::vector<byte> tmpIv(m_cipherMode->BlockSize());
-	Key::Symmetric::SymmetricKey kp(m_cipherKey, tmpIv);
+	m_cipherKey = keyView.Key();
+	// the cbc iv is zero; the cleared code buffer stands in for it
+	Key::Symmetric::SymmetricKey kp(m_cipherKey, m_msgCode);
 	m_cipherMode->Initialize(true, kp);
 
-	if (KeyParams.Info().size() != 0 &&
+	if (keyView.Info().size() != 0 &&
 		m_cipherType != BlockCiphers::Rijndael &&
 		m_cipherType != BlockCiphers::Serpent &&
 		m_cipherType != BlockCiphers::Twofish)
 	{
-		if (KeyParams.Info().size() <= m_cipherMode->Engine()->DistributionCodeMax())
+		if (keyView.Info().size() <= m_cipherMode->Engine()->DistributionCodeMax())
 		{
-			m_cipherMode->Engine()->DistributionCode() = KeyParams.Info();
+			m_cipherMode->Engine()->DistributionCode() = keyView.Info();
 		}
 		else
 		{
 			// info is too large; size to optimal max, ignore remainder
 			std::vector<byte> tmpInfo(m_cipherMode->Engine()->DistributionCodeMax());
-			Utility::MemUtils::Copy(KeyParams.Info(), 0, tmpInfo, 0, tmpInfo.size());
+			Utility::MemUtils::Copy(keyView.Info(), 0, tmpInfo, 0, tmpInfo.size());
 			m_cipherMode->Engine()->DistributionCode() = tmpInfo;
 		}
 	}
 
-	std::vector<byte> lu(m_cipherMode->BlockSize());
-	std::vector<byte> tmpz(m_cipherMode->BlockSize());
-	m_cipherMode->EncryptBlock(tmpz, 0, lu, 0);
-	m_K1 = GenerateSubkey(lu);
-	m_K2 = GenerateSubkey(m_K1);
+	// the subkeys are derived from the encrypted zero block, using the cleared work buffers
+	m_cipherMode->EncryptBlock(m_wrkBuffer, 0, m_msgCode, 0);
+	GenerateSubkey(m_msgCode, m_K1);
+	GenerateSubkey(m_K1, m_K2);
+	Utility::MemUtils::Clear(m_msgCode, 0, m_msgCode.size());
 	m_cipherMode->Initialize(true, kp);
 
 	m_isInitialized = true;
 }
 
+void CMAC::LoadState(const std::vector<byte> &State)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("CMAC:LoadState", "The Mac is not initialized!");
+	if (State.size() < 3 + BLOCK_SIZE)
+		throw CryptoMacException("CMAC:LoadState", "The state array is too short!");
+	if (State[0] != STATE_VERSION)
+		throw CryptoMacException("CMAC:LoadState", "The state version is not supported!");
+	if (State[1] != static_cast<byte>(Macs::CMAC))
+		throw CryptoMacException("CMAC:LoadState", "The state was not created by this Mac!");
+
+	const size_t WRKLEN = State[2];
+	if (WRKLEN > BLOCK_SIZE || State.size() != 3 + BLOCK_SIZE + WRKLEN)
+		throw CryptoMacException("CMAC:LoadState", "The state array is malformed!");
+
+	Reset();
+	Utility::MemUtils::Copy(State, 3, static_cast<Cipher::Symmetric::Block::Mode::CBC*>(m_cipherMode)->Nonce(), 0, BLOCK_SIZE);
+	Utility::MemUtils::Copy(State, 3 + BLOCK_SIZE, m_wrkBuffer, 0, WRKLEN);
+	m_wrkOffset = WRKLEN;
+}
+
 void CMAC::Reset()
 {
 	// reinitialize the cbc iv
@@ -203,6 +232,22 @@ void CMAC::Reset()
 	m_wrkOffset = 0;
 }
 
+std::vector<byte> CMAC::SaveState()
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("CMAC:SaveState", "The Mac is not initialized!");
+
+	IO::StreamWriter writer(3 + BLOCK_SIZE + m_wrkOffset);
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Macs::CMAC));
+	writer.Write(static_cast<byte>(m_wrkOffset));
+	writer.Write(static_cast<Cipher::Symmetric::Block::Mode::CBC*>(m_cipherMode)->Nonce(), 0, BLOCK_SIZE);
+	writer.Write(m_wrkBuffer, 0, m_wrkOffset);
+
+	return writer.GetBytes();
+}
+
 void CMAC::Update(byte Input)
 {
 	if (m_wrkOffset == m_wrkBuffer.size())
@@ -253,22 +298,24 @@ void CMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length
 	}
 }
 
+void CMAC::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input);
+}
+
 //~~~Private Functions~~~//
 
-std::vector<byte> CMAC::GenerateSubkey(std::vector<byte> &Input)
+void CMAC::GenerateSubkey(const std::vector<byte> &Input, std::vector<byte> &Output)
 {
 	int fbit = (Input[0] & 0xFF) >> 7;
-	std::vector<byte> tmpKey(Input.size());
 
 	for (size_t i = 0; i < Input.size() - 1; i++)
-		tmpKey[i] = (byte)((Input[i] << 1) + ((Input[i + 1] & 0xFF) >> 7));
+		Output[i] = (byte)((Input[i] << 1) + ((Input[i + 1] & 0xFF) >> 7));
 
-	tmpKey[Input.size() - 1] = (byte)(Input[Input.size() - 1] << 1);
+	Output[Input.size() - 1] = (byte)(Input[Input.size() - 1] << 1);
 
 	if (fbit == 1)
-		tmpKey[Input.size() - 1] ^= (Input.size() == m_cipherMode->BlockSize()) ? CT87 : CT1B;
-
-	return tmpKey;
+		Output[Input.size() - 1] ^= (Input.size() == m_cipherMode->BlockSize()) ? CT87 : CT1B;
 }
 
 void CMAC::Scope()
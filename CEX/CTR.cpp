@@ -3,6 +3,7 @@
 #include "IntUtils.h"
 #include "MemUtils.h"
 #include "ParallelUtils.h"
+#include "SegmentUtils.h"
 
 NAMESPACE_MODE
 
@@ -77,7 +78,10 @@ CTR::CTR(BlockCiphers CipherType)
 	m_isEncryption(false),
 	m_isInitialized(false),
 	m_isLoaded(false),
-	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
+	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0),
+	m_thdBuffer(0),
+	m_thdCounter(0)
 {
 }
 
@@ -91,7 +95,10 @@ CTR::CTR(IBlockCipher* Cipher)
 	m_isEncryption(false),
 	m_isInitialized(false),
 	m_isLoaded(false),
-	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
+	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0),
+	m_thdBuffer(0),
+	m_thdCounter(0)
 {
 }
 
@@ -132,6 +139,9 @@ void CTR::Destroy()
 		}
 
 		Utility::IntUtils::ClearVector(m_ctrVector);
+		Utility::IntUtils::ClearVector(m_segmentStage);
+		Utility::IntUtils::ClearVector(m_thdBuffer);
+		Utility::IntUtils::ClearVector(m_thdCounter);
 	}
 }
 
@@ -147,7 +157,9 @@ void CTR::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void CTR::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size(), KeyParams.Nonce().size()))
+	SymmetricKeyView keyView(KeyParams);
+
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), keyView.Key().size(), keyView.Nonce().size()))
 		throw CryptoSymmetricCipherException("CTR:Initialize", "Invalid key or nonce size! Key and nonce must be one of the LegalKeySizes() members in length.");
 	if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || m_parallelProfile.ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
 		throw CryptoSymmetricCipherException("CTR:Initialize", "The parallel block size is out of bounds!");
@@ -156,7 +168,7 @@ void CTR::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 
 	Scope();
 	m_blockCipher->Initialize(true, KeyParams);
-	m_ctrVector = KeyParams.Nonce();
+	m_ctrVector = keyView.Nonce();
 	m_isEncryption = Encryption;
 	m_isInitialized = true;
 }
@@ -171,6 +183,7 @@ void CTR::ParallelMaxDegree(size_t Degree)
 		throw CryptoCipherModeException("CTR:ParallelMaxDegree", "Parallel degree can not exceed processor count!");
 
 	m_parallelProfile.SetMaxDegree(Degree);
+	Reserve();
 }
 
 void CTR::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
@@ -184,6 +197,11 @@ void CTR::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 		ProcessSequential(Input, InOffset, Output, OutOffset, Length);
 }
 
+void CTR::TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output)
+{
+	Utility::SegmentUtils::Transform(this, Input, Output, m_segmentStage);
+}
+
 //~~~Private Functions~~~//
 
 void CTR::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
@@ -196,7 +214,7 @@ void CTR::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	Utility::MemUtils::XOR128(Input, InOffset, Output, OutOffset);
 }
 
-void CTR::Generate(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter)
+void CTR::Generate(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter, std::vector<byte> &Buffer)
 {
 	size_t blkCtr = 0;
 
@@ -205,44 +223,43 @@ void CTR::Generate(std::vector<byte> &Output, const size_t OutOffset, const size
 	if (Length >= AVX512BLK)
 	{
 		const size_t PBKALN = Length - (Length % AVX512BLK);
-		std::vector<byte> ctrBlk(AVX512BLK);
 
 		// stagger counters and process 8 blocks with avx
 		while (blkCtr != PBKALN)
 		{
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 0);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 0);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 16);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 16);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 32);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 32);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 48);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 48);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 64);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 64);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 80);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 80);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 96);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 96);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 112);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 112);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 128);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 128);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 144);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 144);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 160);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 160);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 176);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 176);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 192);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 192);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 208);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 208);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 224);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 224);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 240);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 240);
 			Utility::IntUtils::BeIncrement8(Counter);
-			m_blockCipher->Transform2048(ctrBlk, 0, Output, OutOffset + blkCtr);
+			m_blockCipher->Transform2048(Buffer, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVX512BLK;
 		}
 	}
@@ -251,28 +268,27 @@ void CTR::Generate(std::vector<byte> &Output, const size_t OutOffset, const size
 	if (Length >= AVX2BLK)
 	{
 		const size_t PBKALN = Length - (Length % AVX2BLK);
-		std::vector<byte> ctrBlk(AVX2BLK);
 		
 		// stagger counters and process 8 blocks with avx
 		while (blkCtr != PBKALN)
 		{
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 0);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 0);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 16);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 16);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 32);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 32);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 48);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 48);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 64);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 64);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 80);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 80);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 96);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 96);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 112);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 112);
 			Utility::IntUtils::BeIncrement8(Counter);
-			m_blockCipher->Transform1024(ctrBlk, 0, Output, OutOffset + blkCtr);
+			m_blockCipher->Transform1024(Buffer, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVX2BLK;
 		}
 	}
@@ -281,20 +297,19 @@ void CTR::Generate(std::vector<byte> &Output, const size_t OutOffset, const size
 	if (Length >= AVXBLK)
 	{
 		const size_t PBKALN = Length - (Length % AVXBLK);
-		std::vector<byte> ctrBlk(AVXBLK);
 
 		// 4 blocks with sse
 		while (blkCtr != PBKALN)
 		{
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 0);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 0);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 16);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 16);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 32);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 32);
 			Utility::IntUtils::BeIncrement8(Counter);
-			Utility::MemUtils::COPY128(Counter, 0, ctrBlk, 48);
+			Utility::MemUtils::COPY128(Counter, 0, Buffer, 48);
 			Utility::IntUtils::BeIncrement8(Counter);
-			m_blockCipher->Transform512(ctrBlk, 0, Output, OutOffset + blkCtr);
+			m_blockCipher->Transform512(Buffer, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVXBLK;
 		}
 	}
@@ -310,10 +325,9 @@ void CTR::Generate(std::vector<byte> &Output, const size_t OutOffset, const size
 
 	if (blkCtr != Length)
 	{
-		std::vector<byte> outputBlock(BLOCK_SIZE);
-		m_blockCipher->EncryptBlock(Counter, outputBlock);
+		m_blockCipher->EncryptBlock(Counter, 0, Buffer, 0);
 		const size_t FNLSZE = Length % BLOCK_SIZE;
-		Utility::MemUtils::Copy(outputBlock, 0, Output, OutOffset + (Length - FNLSZE), FNLSZE);
+		Utility::MemUtils::Copy(Buffer, 0, Output, OutOffset + (Length - FNLSZE), FNLSZE);
 		Utility::IntUtils::BeIncrement8(Counter);
 	}
 }
@@ -323,33 +337,33 @@ void CTR::ProcessParallel(const std::vector<byte> &Input, const size_t InOffset,
 	const size_t OUTSZE = Output.size() - OutOffset < Length ? Output.size() - OutOffset : Length;
 	const size_t CNKSZE = m_parallelProfile.ParallelBlockSize() / m_parallelProfile.ParallelMaxDegree();
 	const size_t CTRLEN = (CNKSZE / BLOCK_SIZE);
-	std::vector<byte> tmpCtr(m_ctrVector.size());
 
-	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, &tmpCtr, CNKSZE, CTRLEN](size_t i)
+	// the degree may have been changed through the parallel profile
+	if (m_thdCounter.size() < m_parallelProfile.ParallelMaxDegree())
+		Reserve();
+
+	// with NUMA placement, each chunk runs on the node that holds its output pages
+	const byte* NUMPTR = m_parallelProfile.IsNumaAware() ? Output.data() + OutOffset : nullptr;
+
+	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), NUMPTR, CNKSZE, [this, &Input, InOffset, &Output, OutOffset, CNKSZE, CTRLEN](size_t i)
 	{
-		// thread level counter
-		std::vector<byte> thdCtr(m_ctrVector.size());
-		// offset counter by chunk size / block size  
-		Utility::IntUtils::BeIncrease8(m_ctrVector, thdCtr, CTRLEN * i);
+		// offset the thread counter by chunk size / block size
+		Utility::IntUtils::BeIncrease8(m_ctrVector, m_thdCounter[i], CTRLEN * i);
 		// generate random at output offset
-		this->Generate(Output, OutOffset + (i * CNKSZE), CNKSZE, thdCtr);
+		this->Generate(Output, OutOffset + (i * CNKSZE), CNKSZE, m_thdCounter[i], m_thdBuffer[i]);
 		// xor with input at offsets
 		Utility::MemUtils::XorBlock(Input, InOffset + (i * CNKSZE), Output, OutOffset + (i * CNKSZE), CNKSZE);
-
-		// store last counter
-		if (i == m_parallelProfile.ParallelMaxDegree() - 1)
-			Utility::MemUtils::COPY128(thdCtr, 0, tmpCtr, 0);
 	});
 
 	// copy last counter to class variable
-	Utility::MemUtils::COPY128(tmpCtr, 0, m_ctrVector, 0);
+	Utility::MemUtils::COPY128(m_thdCounter[m_parallelProfile.ParallelMaxDegree() - 1], 0, m_ctrVector, 0);
 
 	// last block processing
 	const size_t ALNSZE = CNKSZE * m_parallelProfile.ParallelMaxDegree();
 	if (ALNSZE < OUTSZE)
 	{
 		size_t fnlSize = (Output.size() - OutOffset) % ALNSZE;
-		Generate(Output, ALNSZE, fnlSize, m_ctrVector);
+		Generate(Output, ALNSZE, fnlSize, m_ctrVector, m_thdBuffer[0]);
 
 		for (size_t i = ALNSZE; i < OUTSZE; i++)
 			Output[i] ^= Input[i];
@@ -359,7 +373,7 @@ void CTR::ProcessParallel(const std::vector<byte> &Input, const size_t InOffset,
 void CTR::ProcessSequential(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
 	// generate random
-	Generate(Output, OutOffset, Length, m_ctrVector);
+	Generate(Output, OutOffset, Length, m_ctrVector, m_thdBuffer[0]);
 	// get block aligned
 	size_t ALNSZE = Length - (Length % BLOCK_SIZE);
 
@@ -374,10 +388,21 @@ void CTR::ProcessSequential(const std::vector<byte> &Input, const size_t InOffse
 	}
 }
 
+void CTR::Reserve()
+{
+	// one counter and staging buffer per thread; sized here so the transform never allocates
+	const size_t THDCNT = Utility::IntUtils::Max(m_parallelProfile.ParallelMaxDegree(), static_cast<size_t>(1));
+
+	m_thdBuffer.resize(THDCNT, std::vector<byte>(STAGE_SIZE));
+	m_thdCounter.resize(THDCNT, std::vector<byte>(BLOCK_SIZE));
+}
+
 void CTR::Scope()
 {
 	if (!m_parallelProfile.IsDefault())
 		m_parallelProfile.Calculate();
+
+	Reserve();
 }
 
 NAMESPACE_MODEEND
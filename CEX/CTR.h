@@ -92,6 +92,7 @@ NAMESPACE_MODE
 /// <item><description>The ParallelThreadsMax() property is used as the thread count in the parallel loop; this must be an even number no greater than the number of processer cores on the system.</description></item>
 /// <item><description>ParallelBlockSize() is calculated automatically based on the processor(s) L1 data cache size, this property can be user defined, and must be evenly divisible by ParallelMinimumSize().</description></item>
 /// <item><description>The ParallelBlockSize() can be changed through the ParallelProfile() property</description></item>
+/// <item><description>The counter staging buffers are sized for each thread when the mode is initialized, the sequential transform does not allocate memory.</description></item>
 /// <item><description>Parallel block calculation ex. <c>ParallelBlockSize = N - (N % .ParallelMinimumSize);</c></description></item>
 /// </list>
 /// 
@@ -108,6 +109,15 @@ private:
 
 	static const size_t BLOCK_SIZE = 16;
 	static const std::string CLASS_NAME;
+#if defined(__AVX512__)
+	static const size_t STAGE_SIZE = 16 * BLOCK_SIZE;
+#elif defined(__AVX2__)
+	static const size_t STAGE_SIZE = 8 * BLOCK_SIZE;
+#elif defined(__AVX__)
+	static const size_t STAGE_SIZE = 4 * BLOCK_SIZE;
+#else
+	static const size_t STAGE_SIZE = BLOCK_SIZE;
+#endif
 
 	IBlockCipher* m_blockCipher;
 	BlockCiphers m_cipherType;
@@ -118,6 +128,9 @@ private:
 	bool m_isInitialized;
 	bool m_isLoaded;
 	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_segmentStage;
+	std::vector<std::vector<byte>> m_thdBuffer;
+	std::vector<std::vector<byte>> m_thdCounter;
 
 public:
 
@@ -304,10 +317,24 @@ public:
 	/// <param name="Length">The number of bytes to transform</param>
 	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
 
+	/// <summary>
+	/// Transform a message stored as a list of fragments, writing the result to a second list of fragments.
+	/// <para>The two lists are processed as single contiguous messages, and may be fragmented differently.
+	/// Runs that are contiguous in both lists are passed to Transform directly; the short runs between fragment boundaries are gathered in a staging buffer owned by this instance, which is erased after each call.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of input fragments</param>
+	/// <param name="Output">The list of output fragments; the combined length must equal that of the input list</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the lists differ in length, or a segment exceeds its array</exception>
+	void TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output) override;
+
 private:
 
 	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
-	void Generate(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter);
+	void Generate(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter, std::vector<byte> &Buffer);
+	void Reserve();
 	void Scope();
 	void ProcessParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
 	void ProcessSequential(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
@@ -0,0 +1,434 @@
+#include "CTRT.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+#if defined(__AVX__)
+#	include "AHX.h"
+#	include <tmmintrin.h>
+#endif
+#include "RHX.h"
+#include "SegmentUtils.h"
+#include "SHX.h"
+#include "THX.h"
+
+NAMESPACE_MODE
+
+template <class TCipher>
+const std::string CTRT<TCipher>::CLASS_NAME("CTR");
+
+//~~~Properties~~~//
+
+template <class TCipher>
+const size_t CTRT<TCipher>::BlockSize()
+{
+	return BLOCK_SIZE;
+}
+
+template <class TCipher>
+const BlockCiphers CTRT<TCipher>::CipherType()
+{
+	return m_cipherType;
+}
+
+template <class TCipher>
+IBlockCipher* CTRT<TCipher>::Engine()
+{
+	return m_blockCipher;
+}
+
+template <class TCipher>
+const CipherModes CTRT<TCipher>::Enumeral()
+{
+	return CipherModes::CTR;
+}
+
+template <class TCipher>
+const bool CTRT<TCipher>::IsEncryption()
+{
+	return m_isEncryption;
+}
+
+template <class TCipher>
+const bool CTRT<TCipher>::IsInitialized()
+{
+	return m_isInitialized;
+}
+
+template <class TCipher>
+const bool CTRT<TCipher>::IsParallel()
+{
+	return m_parallelProfile.IsParallel();
+}
+
+template <class TCipher>
+const std::vector<SymmetricKeySize> &CTRT<TCipher>::LegalKeySizes()
+{
+	return m_blockCipher->LegalKeySizes();
+}
+
+template <class TCipher>
+const std::string CTRT<TCipher>::Name()
+{
+	return CLASS_NAME + "-" + m_blockCipher->Name();
+}
+
+template <class TCipher>
+const size_t CTRT<TCipher>::ParallelBlockSize()
+{
+	return m_parallelProfile.ParallelBlockSize();
+}
+
+template <class TCipher>
+ParallelOptions &CTRT<TCipher>::ParallelProfile()
+{
+	return m_parallelProfile;
+}
+
+//~~~Constructor~~~//
+
+template <class TCipher>
+CTRT<TCipher>::CTRT(Digests KdfEngineType, size_t Rounds)
+	:
+	m_blockCipher(Rounds == 0 ? new TCipher(KdfEngineType) : new TCipher(KdfEngineType, Rounds)),
+	m_cipherType(m_blockCipher->Enumeral()),
+	m_ctrVector(BLOCK_SIZE),
+	m_destroyEngine(true),
+	m_isDestroyed(false),
+	m_isEncryption(false),
+	m_isInitialized(false),
+	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0),
+	m_thdBuffer(0),
+	m_thdCounter(0)
+{
+}
+
+template <class TCipher>
+CTRT<TCipher>::CTRT(TCipher* Cipher)
+	:
+	m_blockCipher(Cipher != 0 ? Cipher : throw CryptoCipherModeException("CTRT:CTor", "The Cipher can not be null!")),
+	m_cipherType(m_blockCipher->Enumeral()),
+	m_ctrVector(BLOCK_SIZE),
+	m_destroyEngine(false),
+	m_isDestroyed(false),
+	m_isEncryption(false),
+	m_isInitialized(false),
+	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0),
+	m_thdBuffer(0),
+	m_thdCounter(0)
+{
+}
+
+template <class TCipher>
+CTRT<TCipher>::~CTRT()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+template <class TCipher>
+void CTRT<TCipher>::DecryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	EncryptBlock(Input, 0, Output, 0);
+}
+
+template <class TCipher>
+void CTRT<TCipher>::DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+{
+	EncryptBlock(Input, InOffset, Output, OutOffset);
+}
+
+template <class TCipher>
+void CTRT<TCipher>::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_cipherType = BlockCiphers::None;
+		m_isEncryption = false;
+		m_isInitialized = false;
+		m_parallelProfile.Reset();
+
+		if (m_destroyEngine)
+		{
+			m_destroyEngine = false;
+
+			if (m_blockCipher != 0)
+				delete m_blockCipher;
+		}
+
+		Utility::IntUtils::ClearVector(m_ctrVector);
+		Utility::IntUtils::ClearVector(m_segmentStage);
+		Utility::IntUtils::ClearVector(m_thdBuffer);
+		Utility::IntUtils::ClearVector(m_thdCounter);
+	}
+}
+
+template <class TCipher>
+void CTRT<TCipher>::EncryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	EncryptBlock(Input, 0, Output, 0);
+}
+
+template <class TCipher>
+void CTRT<TCipher>::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
+
+	Generate(Input, InOffset, Output, OutOffset, BLOCK_SIZE, m_ctrVector, m_thdBuffer[0]);
+}
+
+template <class TCipher>
+void CTRT<TCipher>::Initialize(bool Encryption, ISymmetricKey &KeyParams)
+{
+	SymmetricKeyView keyView(KeyParams);
+
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), keyView.Key().size(), keyView.Nonce().size()))
+		throw CryptoSymmetricCipherException("CTRT:Initialize", "Invalid key or nonce size! Key and nonce must be one of the LegalKeySizes() members in length.");
+	if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || m_parallelProfile.ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
+		throw CryptoSymmetricCipherException("CTRT:Initialize", "The parallel block size is out of bounds!");
+	if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() % m_parallelProfile.ParallelMinimumSize() != 0)
+		throw CryptoSymmetricCipherException("CTRT:Initialize", "The parallel block size must be evenly aligned to the ParallelMinimumSize!");
+
+	Scope();
+	m_blockCipher->Initialize(true, KeyParams);
+	m_ctrVector = keyView.Nonce();
+	m_isEncryption = Encryption;
+	m_isInitialized = true;
+}
+
+template <class TCipher>
+void CTRT<TCipher>::ParallelMaxDegree(size_t Degree)
+{
+	if (Degree == 0)
+		throw CryptoCipherModeException("CTRT:ParallelMaxDegree", "Parallel degree can not be zero!");
+	if (Degree % 2 != 0)
+		throw CryptoCipherModeException("CTRT:ParallelMaxDegree", "Parallel degree must be an even number!");
+	if (Degree > m_parallelProfile.ProcessorCount())
+		throw CryptoCipherModeException("CTRT:ParallelMaxDegree", "Parallel degree can not exceed processor count!");
+
+	m_parallelProfile.SetMaxDegree(Degree);
+	Reserve();
+}
+
+template <class TCipher>
+void CTRT<TCipher>::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
+
+	if (m_parallelProfile.IsParallel() && Length >= m_parallelProfile.ParallelBlockSize())
+		ProcessParallel(Input, InOffset, Output, OutOffset, Length);
+	else
+		Generate(Input, InOffset, Output, OutOffset, Length, m_ctrVector, m_thdBuffer[0]);
+}
+
+template <class TCipher>
+void CTRT<TCipher>::TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output)
+{
+	Utility::SegmentUtils::Transform(this, Input, Output, m_segmentStage);
+}
+
+//~~~Private Functions~~~//
+
+template <class TCipher>
+void CTRT<TCipher>::Generate(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter, std::vector<byte> &Buffer)
+{
+	size_t blkCtr = 0;
+
+#if defined(__AVX__)
+	if (Length >= STAGE_SIZE)
+	{
+		const size_t PBKALN = Length - (Length % STAGE_SIZE);
+
+		// stagger the counters and process the widest block the cipher supports
+		while (blkCtr != PBKALN)
+		{
+			for (size_t i = 0; i < STAGE_SIZE; i += BLOCK_SIZE)
+			{
+				Utility::MemUtils::COPY128(Counter, 0, Buffer, i);
+				Utility::IntUtils::BeIncrement8(Counter);
+			}
+
+#	if defined(__AVX512__)
+			m_blockCipher->Transform2048(Buffer, 0, Output, OutOffset + blkCtr);
+#	elif defined(__AVX2__)
+			m_blockCipher->Transform1024(Buffer, 0, Output, OutOffset + blkCtr);
+#	else
+			m_blockCipher->Transform512(Buffer, 0, Output, OutOffset + blkCtr);
+#	endif
+			blkCtr += STAGE_SIZE;
+		}
+	}
+#endif
+
+	const size_t BLKALN = Length - (Length % BLOCK_SIZE);
+	while (blkCtr != BLKALN)
+	{
+		m_blockCipher->EncryptBlock(Counter, 0, Output, OutOffset + blkCtr);
+		Utility::IntUtils::BeIncrement8(Counter);
+		blkCtr += BLOCK_SIZE;
+	}
+
+	if (BLKALN != 0)
+		Utility::MemUtils::XorBlock(Input, InOffset, Output, OutOffset, BLKALN);
+
+	if (BLKALN != Length)
+	{
+		m_blockCipher->EncryptBlock(Counter, 0, Buffer, 0);
+		Utility::IntUtils::BeIncrement8(Counter);
+
+		for (size_t i = BLKALN; i < Length; ++i)
+			Output[OutOffset + i] = Input[InOffset + i] ^ Buffer[i - BLKALN];
+	}
+}
+
+#if defined(__AVX__)
+template <>
+void CTRT<Block::AHX>::Generate(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter, std::vector<byte> &)
+{
+	// the keystream is kept in registers, so the thread buffer is not used
+	const size_t AESBLK = 8 * BLOCK_SIZE;
+	const size_t PBKALN = Length - (Length % AESBLK);
+	const size_t BLKALN = Length - (Length % BLOCK_SIZE);
+	// the counter is kept as two 64 bit integers, and byte reversed into big endian order when loaded
+	const __m128i SWAP = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	const __m128i* RKEY = m_blockCipher->m_expKey.data();
+	const size_t LRD = m_blockCipher->m_expKey.size() - 1;
+	ulong ctrHigh = Utility::IntUtils::BeBytesTo64(Counter, 0);
+	ulong ctrLow = Utility::IntUtils::BeBytesTo64(Counter, 8);
+	size_t blkCtr = 0;
+
+	auto NextCounter = [&ctrHigh, &ctrLow, &SWAP, RKEY]()
+	{
+		__m128i X = _mm_xor_si128(_mm_shuffle_epi8(_mm_set_epi64x(ctrHigh, ctrLow), SWAP), RKEY[0]);
+		++ctrLow;
+		ctrHigh += (ctrLow == 0) ? 1 : 0;
+
+		return X;
+	};
+
+	// eight blocks are interleaved to cover the latency of the aesenc instruction
+	while (blkCtr != PBKALN)
+	{
+		__m128i X0 = NextCounter();
+		__m128i X1 = NextCounter();
+		__m128i X2 = NextCounter();
+		__m128i X3 = NextCounter();
+		__m128i X4 = NextCounter();
+		__m128i X5 = NextCounter();
+		__m128i X6 = NextCounter();
+		__m128i X7 = NextCounter();
+
+		for (size_t i = 1; i != LRD; ++i)
+		{
+			X0 = _mm_aesenc_si128(X0, RKEY[i]);
+			X1 = _mm_aesenc_si128(X1, RKEY[i]);
+			X2 = _mm_aesenc_si128(X2, RKEY[i]);
+			X3 = _mm_aesenc_si128(X3, RKEY[i]);
+			X4 = _mm_aesenc_si128(X4, RKEY[i]);
+			X5 = _mm_aesenc_si128(X5, RKEY[i]);
+			X6 = _mm_aesenc_si128(X6, RKEY[i]);
+			X7 = _mm_aesenc_si128(X7, RKEY[i]);
+		}
+
+		const __m128i* INP = reinterpret_cast<const __m128i*>(&Input[InOffset + blkCtr]);
+		__m128i* OUT = reinterpret_cast<__m128i*>(&Output[OutOffset + blkCtr]);
+		_mm_storeu_si128(OUT, _mm_xor_si128(_mm_aesenclast_si128(X0, RKEY[LRD]), _mm_loadu_si128(INP)));
+		_mm_storeu_si128(OUT + 1, _mm_xor_si128(_mm_aesenclast_si128(X1, RKEY[LRD]), _mm_loadu_si128(INP + 1)));
+		_mm_storeu_si128(OUT + 2, _mm_xor_si128(_mm_aesenclast_si128(X2, RKEY[LRD]), _mm_loadu_si128(INP + 2)));
+		_mm_storeu_si128(OUT + 3, _mm_xor_si128(_mm_aesenclast_si128(X3, RKEY[LRD]), _mm_loadu_si128(INP + 3)));
+		_mm_storeu_si128(OUT + 4, _mm_xor_si128(_mm_aesenclast_si128(X4, RKEY[LRD]), _mm_loadu_si128(INP + 4)));
+		_mm_storeu_si128(OUT + 5, _mm_xor_si128(_mm_aesenclast_si128(X5, RKEY[LRD]), _mm_loadu_si128(INP + 5)));
+		_mm_storeu_si128(OUT + 6, _mm_xor_si128(_mm_aesenclast_si128(X6, RKEY[LRD]), _mm_loadu_si128(INP + 6)));
+		_mm_storeu_si128(OUT + 7, _mm_xor_si128(_mm_aesenclast_si128(X7, RKEY[LRD]), _mm_loadu_si128(INP + 7)));
+		blkCtr += AESBLK;
+	}
+
+	while (blkCtr != Length)
+	{
+		__m128i X0 = NextCounter();
+
+		for (size_t i = 1; i != LRD; ++i)
+			X0 = _mm_aesenc_si128(X0, RKEY[i]);
+
+		X0 = _mm_aesenclast_si128(X0, RKEY[LRD]);
+
+		if (blkCtr != BLKALN)
+		{
+			X0 = _mm_xor_si128(X0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Input[InOffset + blkCtr])));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&Output[OutOffset + blkCtr]), X0);
+			blkCtr += BLOCK_SIZE;
+		}
+		else
+		{
+			// the final partial block
+			std::array<byte, BLOCK_SIZE> otpBlock;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(otpBlock.data()), X0);
+
+			for (size_t i = 0; blkCtr != Length; ++i, ++blkCtr)
+				Output[OutOffset + blkCtr] = Input[InOffset + blkCtr] ^ otpBlock[i];
+		}
+	}
+
+	Utility::IntUtils::Be64ToBytes(ctrHigh, Counter, 0);
+	Utility::IntUtils::Be64ToBytes(ctrLow, Counter, 8);
+}
+#endif
+
+template <class TCipher>
+void CTRT<TCipher>::ProcessParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+{
+	const size_t CNKSZE = m_parallelProfile.ParallelBlockSize() / m_parallelProfile.ParallelMaxDegree();
+	const size_t CTRLEN = (CNKSZE / BLOCK_SIZE);
+
+	// the degree may have been changed through the parallel profile
+	if (m_thdCounter.size() < m_parallelProfile.ParallelMaxDegree())
+		Reserve();
+
+	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, CNKSZE, CTRLEN](size_t i)
+	{
+		// offset the thread counter by the chunk size in blocks
+		Utility::IntUtils::BeIncrease8(m_ctrVector, m_thdCounter[i], CTRLEN * i);
+		this->Generate(Input, InOffset + (i * CNKSZE), Output, OutOffset + (i * CNKSZE), CNKSZE, m_thdCounter[i], m_thdBuffer[i]);
+	});
+
+	// the last thread holds the next counter
+	Utility::MemUtils::COPY128(m_thdCounter[m_parallelProfile.ParallelMaxDegree() - 1], 0, m_ctrVector, 0);
+
+	// process the remainder sequentially
+	const size_t ALNSZE = CNKSZE * m_parallelProfile.ParallelMaxDegree();
+	if (ALNSZE != Length)
+		Generate(Input, InOffset + ALNSZE, Output, OutOffset + ALNSZE, Length - ALNSZE, m_ctrVector, m_thdBuffer[0]);
+}
+
+template <class TCipher>
+void CTRT<TCipher>::Reserve()
+{
+	// one counter and staging buffer per thread; sized here so the transform never allocates
+	const size_t THDCNT = Utility::IntUtils::Max(m_parallelProfile.ParallelMaxDegree(), static_cast<size_t>(1));
+
+	m_thdBuffer.resize(THDCNT, std::vector<byte>(STAGE_SIZE));
+	m_thdCounter.resize(THDCNT, std::vector<byte>(BLOCK_SIZE));
+}
+
+template <class TCipher>
+void CTRT<TCipher>::Scope()
+{
+	if (!m_parallelProfile.IsDefault())
+		m_parallelProfile.Calculate();
+
+	Reserve();
+}
+
+#if defined(__AVX__)
+template class CTRT<Block::AHX>;
+#endif
+template class CTRT<Block::RHX>;
+template class CTRT<Block::SHX>;
+template class CTRT<Block::THX>;
+
+NAMESPACE_MODEEND
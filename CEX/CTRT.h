@@ -0,0 +1,307 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// A Big-Endian integer Counter Mode (CTR), specialized at compile time on the block cipher type.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_CTRT_H
+#define CEX_CTRT_H
+
+#include "ICipherMode.h"
+#include "Digests.h"
+
+NAMESPACE_MODE
+
+using Enumeration::Digests;
+
+/// <summary>
+/// A Big-Endian integer Counter Mode, specialized on the block cipher type
+/// </summary>
+///
+/// <example>
+/// <description>Encrypting with the AES-NI specialized counter mode:</description>
+/// <code>
+/// CTRT&lt;AHX&gt; cipher;
+/// // initialize for encryption
+/// cipher.Initialize(true, SymmetricKey(Key, Nonce));
+/// // encrypt a length of bytes
+/// cipher.Transform(Input, 0, Output, 0, Input.size());
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description><B>Overview:</B></description>
+/// <para>CTRT produces the same output as the <see cref="CTR"/> mode, but holds the block cipher by its concrete type rather than through the IBlockCipher interface. \n
+/// Calls into the cipher are resolved at compile time, and the counter generation and message xor are fused into a single pass over the buffer. \n
+/// The AHX specialization encrypts the counters directly with the AES-NI instructions; the round keys are loaded once per call,
+/// the counters are incremented in registers, and eight blocks are interleaved to hide the latency of the aesenc instruction.</para>
+///
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The class is instantiated for the AHX (when AVX is enabled), RHX, SHX, and THX ciphers.</description></item>
+/// <item><description>The mode is exposed through the ICipherMode interface; the Enumeral() property returns CipherModes::CTR.</description></item>
+/// <item><description>CipherModeFromName returns the AHX specialization for the CTR mode when the processor supports AES-NI.</description></item>
+/// <item><description>A cipher instance created by the mode is deleted when the class is destroyed; an instance passed to the constructor is not.</description></item>
+/// <item><description>If the system supports Parallel processing, IsParallel() is set to true; passing an input block of ParallelBlockSize() to the transform.</description></item>
+/// <item><description>The counter staging buffers are sized for each thread when the mode is initialized, the sequential transform does not allocate memory.</description></item>
+/// <item><description>The transformation methods can not be called until the Initialize(bool, ISymmetricKey) function has been called.</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>NIST <a href="http://csrc.nist.gov/publications/nistpubs/800-38a/sp800-38a.pdf">SP800-38A</a>.</description></item>
+/// <item><description>Intel <a href="https://www.intel.com/content/dam/doc/white-paper/advanced-encryption-standard-new-instructions-set-paper.pdf">Advanced Encryption Standard (AES) New Instructions Set</a>.</description></item>
+/// </list>
+/// </remarks>
+template <class TCipher>
+class CTRT final : public ICipherMode
+{
+private:
+
+	static const size_t BLOCK_SIZE = 16;
+	static const std::string CLASS_NAME;
+#if defined(__AVX512__)
+	static const size_t STAGE_SIZE = 16 * BLOCK_SIZE;
+#elif defined(__AVX2__)
+	static const size_t STAGE_SIZE = 8 * BLOCK_SIZE;
+#elif defined(__AVX__)
+	static const size_t STAGE_SIZE = 4 * BLOCK_SIZE;
+#else
+	static const size_t STAGE_SIZE = BLOCK_SIZE;
+#endif
+
+	TCipher* m_blockCipher;
+	BlockCiphers m_cipherType;
+	std::vector<byte> m_ctrVector;
+	bool m_destroyEngine;
+	bool m_isDestroyed;
+	bool m_isEncryption;
+	bool m_isInitialized;
+	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_segmentStage;
+	std::vector<std::vector<byte>> m_thdBuffer;
+	std::vector<std::vector<byte>> m_thdCounter;
+
+public:
+
+	CTRT(const CTRT&) = delete;
+	CTRT& operator=(const CTRT&) = delete;
+	CTRT& operator=(CTRT&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: Block size of internal cipher in bytes
+	/// </summary>
+	const size_t BlockSize() override;
+
+	/// <summary>
+	/// Get: The block ciphers formal type name
+	/// </summary>
+	const BlockCiphers CipherType() override;
+
+	/// <summary>
+	/// Get: The underlying Block Cipher instance
+	/// </summary>
+	IBlockCipher* Engine() override;
+
+	/// <summary>
+	/// Get: The cipher modes type name
+	/// </summary>
+	const CipherModes Enumeral() override;
+
+	/// <summary>
+	/// Get: True if initialized for encryption, False for decryption
+	/// </summary>
+	const bool IsEncryption() override;
+
+	/// <summary>
+	/// Get: The Block Cipher is ready to transform data
+	/// </summary>
+	const bool IsInitialized() override;
+
+	/// <summary>
+	/// Get: Processor parallelization availability.
+	/// <para>Indicates whether parallel processing is available with this mode.
+	/// If parallel capable, input/output data arrays passed to the transform must be ParallelBlockSize in bytes to trigger parallelization.</para>
+	/// </summary>
+	const bool IsParallel() override;
+
+	/// <summary>
+	/// Get: Array of allowed cipher input key byte-sizes
+	/// </summary>
+	const std::vector<SymmetricKeySize> &LegalKeySizes() override;
+
+	/// <summary>
+	/// Get: The cipher modes class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Get: The current counter value
+	/// </summary>
+	const std::vector<byte> &Nonce() { return m_ctrVector; }
+
+	/// <summary>
+	/// Get: Parallel block size; the byte-size of the input/output data arrays passed to a transform that trigger parallel processing.
+	/// <para>This value can be changed through the ParallelProfile class.<para>
+	/// </summary>
+	const size_t ParallelBlockSize() override;
+
+	/// <summary>
+	/// Get/Set: Parallel and SIMD capability flags and sizes
+	/// </summary>
+	ParallelOptions &ParallelProfile() override;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Initialize the Cipher Mode, creating a block cipher instance of the template type
+	/// </summary>
+	///
+	/// <param name="KdfEngineType">The ciphers HKDF key expansion digest; the default of None uses the standard key schedule</param>
+	/// <param name="Rounds">The number of cipher rounds; a value of zero uses the ciphers default</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher could not be created with these parameters</exception>
+	explicit CTRT(Digests KdfEngineType = Digests::None, size_t Rounds = 0);
+
+	/// <summary>
+	/// Initialize the Cipher Mode using a block cipher instance
+	/// </summary>
+	///
+	/// <param name="Cipher">The uninitialized block cipher instance; can not be null</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if a null block cipher is used</exception>
+	explicit CTRT(TCipher* Cipher);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~CTRT() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Decrypt a single block of bytes.
+	/// <para>Decrypts one block of bytes beginning at a zero index.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of encrypted bytes</param>
+	/// <param name="Output">The output array of decrypted bytes</param>
+	void DecryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Decrypt a block of bytes with offset parameters.
+	/// <para>Decrypts one block of bytes at the designated offsets.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of encrypted bytes</param>
+	/// <param name="InOffset">Starting offset within the Input array</param>
+	/// <param name="Output">The output array of decrypted bytes</param>
+	/// <param name="OutOffset">Starting offset within the Output array</param>
+	void DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Encrypt a single block of bytes.
+	/// <para>Encrypts one block of bytes beginning at a zero index.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of plain text bytes</param>
+	/// <param name="Output">The output array of encrypted bytes</param>
+	void EncryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Encrypt a block of bytes using offset parameters.
+	/// <para>Encrypts one block of bytes at the designated offsets.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of plain text bytes</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of encrypted bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	void EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Initialize the Cipher instance
+	/// </summary>
+	///
+	/// <param name="Encryption">True if cipher is used for encryption, False to decrypt</param>
+	/// <param name="KeyParams">SymmetricKey containing the encryption Key and Initialization Vector</param>
+	///
+	/// <exception cref="CryptoCipherModeException">Thrown if a null Key or Nonce is used</exception>
+	void Initialize(bool Encryption, ISymmetricKey &KeyParams) override;
+
+	/// <summary>
+	/// Set the maximum number of threads allocated when using multi-threaded processing.
+	/// <para>When set to zero, thread count is set automatically. If set to 1, sets IsParallel() to false and runs in sequential mode.
+	/// Thread count must be an even number, and not exceed the number of processor cores.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if an invalid degree setting is used</exception>
+	void ParallelMaxDegree(size_t Degree) override;
+
+	/// <summary>
+	/// Transform a length of bytes with offset parameters.
+	/// <para>This method processes a specified length of bytes, utilizing offsets incremented by the caller.
+	/// If IsParallel() is set to true, and the length is at least ParallelBlockSize(), the transform is run in parallel processing mode.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	///
+	/// <param name="Input">The input array of bytes to transform</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of transformed bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
+
+	/// <summary>
+	/// Transform a message stored as a list of fragments, writing the result to a second list of fragments.
+	/// <para>The two lists are processed as single contiguous messages, and may be fragmented differently.
+	/// Runs that are contiguous in both lists are passed to Transform directly; the short runs between fragment boundaries are gathered in a staging buffer owned by this instance, which is erased after each call.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of input fragments</param>
+	/// <param name="Output">The list of output fragments; the combined length must equal that of the input list</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the lists differ in length, or a segment exceeds its array</exception>
+	void TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output) override;
+
+private:
+
+	void Generate(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<byte> &Counter, std::vector<byte> &Buffer);
+	void ProcessParallel(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
+	void Reserve();
+	void Scope();
+};
+
+NAMESPACE_MODEEND
+#endif
@@ -13,6 +13,8 @@
 #define NAMESPACE_ASYMMETRICEND } } }
 #define NAMESPACE_MCELIECE namespace CEX { namespace Cipher { namespace Asymmetric { namespace McEliece {
 #define NAMESPACE_MCELIECEEND } } } }
+#define NAMESPACE_MODULELWE namespace CEX { namespace Cipher { namespace Asymmetric { namespace MLWE {
+#define NAMESPACE_MODULELWEEND } } } }
 #define NAMESPACE_RINGLWE namespace CEX { namespace Cipher { namespace Asymmetric { namespace RLWE {
 #define NAMESPACE_RINGLWEEND } } } }
 #define NAMESPACE_ASYMMETRICKEX namespace CEX { namespace Cipher { namespace Asymmetric { namespace KEX {
@@ -23,8 +25,12 @@
 #define NAMESPACE_TLSEND } } } } }
 #define NAMESPACE_ASYMMETRICSIGN namespace CEX { namespace Cipher { namespace Asymmetric { namespace Sign {
 #define NAMESPACE_ASYMMETRICSIGNEND } } } }
+#define NAMESPACE_DILITHIUM namespace CEX { namespace Cipher { namespace Asymmetric { namespace Sign { namespace DLM {
+#define NAMESPACE_DILITHIUMEND } } } } }
 #define NAMESPACE_GMSS namespace CEX { namespace Cipher { namespace Asymmetric { namespace Sign { namespace GMSS {
 #define NAMESPACE_GMSSEND } } } } }
+#define NAMESPACE_SPHINCS namespace CEX { namespace Cipher { namespace Asymmetric { namespace Sign { namespace SPHINCS {
+#define NAMESPACE_SPHINCSEND } } } } }
 
 #define NAMESPACE_SYMMETRIC namespace CEX { namespace Cipher { namespace Symmetric {
 #define NAMESPACE_SYMMETRICEND } } }
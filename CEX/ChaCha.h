@@ -21,6 +21,7 @@
 
 #include "CexDomain.h"
 #include "IntUtils.h"
+#include "SecureAllocator.h"
 
 NAMESPACE_STREAM
 
@@ -31,7 +32,7 @@ class ChaCha
 {
 public:
 
-	static void ChaChaTransform512(std::vector<byte> &Output, size_t OutOffset, std::vector<uint> &Counter, std::vector<uint> &State, size_t Rounds)
+	static void ChaChaTransform512(std::vector<byte> &Output, size_t OutOffset, std::vector<uint> &Counter, Utility::SecureVector<uint> &State, size_t Rounds)
 	{
 		size_t ctr = 0;
 		uint X0 = State[ctr];
@@ -140,7 +141,7 @@ public:
 	}
 
 	template<class T>
-	static void ChaChaTransformW(std::vector<byte> &Output, size_t OutOffset, std::vector<uint> &Counter, std::vector<uint> &State, size_t Rounds)
+	static void ChaChaTransformW(std::vector<byte> &Output, size_t OutOffset, std::vector<uint> &Counter, Utility::SecureVector<uint> &State, size_t Rounds)
 	{
 #if defined(__AVX__)
 
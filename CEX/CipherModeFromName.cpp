@@ -1,10 +1,16 @@
 #include "CipherModeFromName.h"
 #include "BlockCipherFromName.h"
 #include "CTR.h"
+#include "CTRT.h"
 #include "CBC.h"
 #include "CFB.h"
 #include "ICM.h"
+#include "ICMT.h"
 #include "OFB.h"
+#include "CpuDetect.h"
+#if defined(__AVX__)
+#	include "AHX.h"
+#endif
 
 NAMESPACE_HELPER
 
@@ -42,6 +48,25 @@ ICipherMode* CipherModeFromName::GetInstance(CipherModes CipherType, BlockCipher
 
 	try
 	{
+#if defined(__AVX__)
+		// the AES-NI counter modes are specialized on the cipher type; the rounds match those set by BlockCipherFromName
+		Common::CpuDetect detect;
+		if (CipherType == Enumeration::CipherModes::CTR && detect.AESNI())
+		{
+			if (EngineType == BlockCiphers::AHX)
+				return new CTRT<Cipher::Symmetric::Block::AHX>(Enumeration::Digests::SHA256, 22);
+			else if (EngineType == BlockCiphers::Rijndael)
+				return new CTRT<Cipher::Symmetric::Block::AHX>();
+		}
+		else if (CipherType == Enumeration::CipherModes::ICM && detect.AESNI())
+		{
+			if (EngineType == BlockCiphers::AHX)
+				return new ICMT<Cipher::Symmetric::Block::AHX>(Enumeration::Digests::SHA256, 22);
+			else if (EngineType == BlockCiphers::Rijndael)
+				return new ICMT<Cipher::Symmetric::Block::AHX>();
+		}
+#endif
+
 		IBlockCipher* cipher = BlockCipherFromName::GetInstance(EngineType);
 
 		switch (CipherType)
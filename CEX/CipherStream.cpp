@@ -1,6 +1,7 @@
 #include "CipherStream.h"
 #include "BlockCipherFromName.h"
 #include "CipherModeFromName.h"
+#include "IntUtils.h"
 #include "MemUtils.h"
 #include "PaddingFromName.h"
 #include "ParallelUtils.h"
@@ -66,6 +67,7 @@ CipherStream::CipherStream(BlockCiphers CipherType, Digests KdfEngine, int Round
 CipherStream::CipherStream(StreamCiphers CipherType, size_t RoundCount)
 	:
 	m_blockCipher(0),
+	m_cipherEngine(0),
 	m_cipherPadding(0),
 	m_destroyEngine(true),
 	m_isBufferedIO(false),
@@ -137,6 +139,7 @@ CipherStream::CipherStream(ICipherMode* Cipher, IPadding* Padding)
 CipherStream::CipherStream(IStreamCipher* Cipher)
 	:
 	m_blockCipher(0),
+	m_cipherEngine(0),
 	m_cipherPadding(0),
 	m_destroyEngine(false),
 	m_isBufferedIO(false),
@@ -189,7 +192,7 @@ void CipherStream::Destroy()
 
 void CipherStream::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.KeySizes().KeySize()))
 		throw CryptoProcessingException("CipherStream:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 
 	try
@@ -250,6 +253,70 @@ void CipherStream::Write(const std::vector<byte> &Input, size_t InOffset, std::v
 		StreamTransform(Input, InOffset, Output, OutOffset);
 }
 
+StreamJob<ulong> CipherStream::WriteAsync(IByteStream* InStream, IByteStream* OutStream, StreamExecutor &Executor)
+{
+	CexAssert(m_isInitialized, "the cipher has not been initialized");
+	CexAssert(InStream->Length() - InStream->Position() > 0, "the Input stream is too short");
+	CexAssert(InStream->CanRead(), "the Input stream is set to write only!");
+	CexAssert(OutStream->CanRead() || OutStream->CanWrite(), "the Output stream is to read only!");
+
+	const ulong INPSZE = InStream->Length() - InStream->Position();
+	const size_t BLKSZE = m_isStreamCipher ? m_streamCipher->BlockSize() : m_cipherEngine->BlockSize();
+	// a padded decryption holds back the last block, it is removed by FinalBlock
+	const ulong ALNSZE = (m_isStreamCipher || m_isCounterMode || m_isEncryption) ? (INPSZE / BLKSZE) * BLKSZE : (INPSZE < BLKSZE) ? 0 : ((INPSZE / BLKSZE) * BLKSZE) - BLKSZE;
+	// parallel engines are passed one parallel block at a time, as in the synchronous path
+	const size_t STPLEN = (m_isParallel && ParallelBlockSize() > ASYNC_STEPSIZE) ? ParallelBlockSize() : (ASYNC_STEPSIZE / BLKSZE) * BLKSZE;
+	const size_t BUFLEN = static_cast<size_t>(Utility::IntUtils::Max<ulong>(Utility::IntUtils::Min<ulong>(ALNSZE, STPLEN), BLKSZE));
+	std::shared_ptr<std::vector<byte>> inpBuffer = std::make_shared<std::vector<byte>>(BUFLEN);
+	std::shared_ptr<std::vector<byte>> outBuffer = std::make_shared<std::vector<byte>>(BUFLEN);
+	ulong prcLen = 0;
+
+	return Executor.Submit<ulong>([this, InStream, OutStream, INPSZE, ALNSZE, STPLEN, inpBuffer, outBuffer, prcLen](JobState &Job, ulong &Result) mutable -> bool
+	{
+		if (prcLen != ALNSZE)
+		{
+			const size_t PRCLEN = static_cast<size_t>(Utility::IntUtils::Min<ulong>(ALNSZE - prcLen, STPLEN));
+
+			if (InStream->Read(*inpBuffer, 0, PRCLEN) != PRCLEN)
+				throw CryptoProcessingException("CipherStream:WriteAsync", "The input stream ended before the expected length!");
+
+			if (m_isStreamCipher)
+				m_streamCipher->Transform(*inpBuffer, 0, *outBuffer, 0, PRCLEN);
+			else
+				m_cipherEngine->Transform(*inpBuffer, 0, *outBuffer, 0, PRCLEN);
+
+			OutStream->Write(*outBuffer, 0, PRCLEN);
+			prcLen += PRCLEN;
+			Job.Report(prcLen, INPSZE);
+
+			return true;
+		}
+
+		// partial
+		if (ALNSZE != INPSZE)
+		{
+			if (m_isStreamCipher)
+			{
+				const size_t FNLSZE = static_cast<size_t>(INPSZE - ALNSZE);
+				const size_t PRCRED = InStream->Read(*inpBuffer, 0, FNLSZE);
+				m_streamCipher->Transform(*inpBuffer, 0, *outBuffer, 0, PRCRED);
+				OutStream->Write(*outBuffer, 0, PRCRED);
+			}
+			else
+			{
+				FinalBlock(InStream, OutStream, static_cast<size_t>(INPSZE - ALNSZE));
+			}
+		}
+
+		if (OutStream->Position() != OutStream->Length())
+			OutStream->SetLength(OutStream->Position());
+
+		Result = OutStream->Position();
+
+		return false;
+	});
+}
+
 //~~~Private Functions~~~//
 
 void CipherStream::BlockTransform(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset)
@@ -381,38 +448,42 @@ void CipherStream::BlockTransform(IByteStream* InStream, IByteStream* OutStream)
 
 	// partial
 	if (ALNSZE != INPSZE)
-	{
-		if (m_isCounterMode)
-		{
-			const size_t FNLSZE = INPSZE - ALNSZE;
-			Utility::MemUtils::Clear(outBuffer, 0, outBuffer.size());
-			Utility::MemUtils::Clear(inpBuffer, 0, inpBuffer.size());
-			prcRead = InStream->Read(inpBuffer, 0, FNLSZE);
-			m_cipherEngine->Transform(inpBuffer, 0, outBuffer, 0, prcRead);
-			OutStream->Write(outBuffer, 0, prcRead);
-		}
-		else if (m_isEncryption)
-		{
-			const size_t FNLSZE = INPSZE - ALNSZE;
-			prcRead = InStream->Read(inpBuffer, 0, FNLSZE);
-			if (FNLSZE != BLKSZE)
-				m_cipherPadding->AddPadding(inpBuffer, prcRead);
-			m_cipherEngine->EncryptBlock(inpBuffer, 0, outBuffer, 0);
-			OutStream->Write(outBuffer, 0, BLKSZE);
-		}
-		else
-		{
-			InStream->Read(inpBuffer, 0, BLKSZE);
-			m_cipherEngine->DecryptBlock(inpBuffer, 0, outBuffer, 0);
-			const size_t PADLEN = m_cipherPadding->GetPaddingLength(outBuffer, 0);
-			const size_t FNLSZE = (PADLEN == 0) ? BLKSZE : BLKSZE - PADLEN;
-			OutStream->Write(outBuffer, 0, FNLSZE);
-		}
-	}
+		FinalBlock(InStream, OutStream, INPSZE - ALNSZE);
 
 	CalculateProgress(INPSZE, OutStream->Position());
 }
 
+void CipherStream::FinalBlock(IByteStream* InStream, IByteStream* OutStream, size_t Length)
+{
+	const size_t BLKSZE = m_cipherEngine->BlockSize();
+	std::vector<byte> inpBuffer(BLKSZE);
+	std::vector<byte> outBuffer(BLKSZE);
+	size_t prcRead = 0;
+
+	if (m_isCounterMode)
+	{
+		prcRead = InStream->Read(inpBuffer, 0, Length);
+		m_cipherEngine->Transform(inpBuffer, 0, outBuffer, 0, prcRead);
+		OutStream->Write(outBuffer, 0, prcRead);
+	}
+	else if (m_isEncryption)
+	{
+		prcRead = InStream->Read(inpBuffer, 0, Length);
+		if (Length != BLKSZE)
+			m_cipherPadding->AddPadding(inpBuffer, prcRead);
+		m_cipherEngine->EncryptBlock(inpBuffer, 0, outBuffer, 0);
+		OutStream->Write(outBuffer, 0, BLKSZE);
+	}
+	else
+	{
+		InStream->Read(inpBuffer, 0, BLKSZE);
+		m_cipherEngine->DecryptBlock(inpBuffer, 0, outBuffer, 0);
+		const size_t PADLEN = m_cipherPadding->GetPaddingLength(outBuffer, 0);
+		const size_t FNLSZE = (PADLEN == 0) ? BLKSZE : BLKSZE - PADLEN;
+		OutStream->Write(outBuffer, 0, FNLSZE);
+	}
+}
+
 void CipherStream::StreamTransform(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset)
 {
 	const size_t INPSZE = Input.size() - InOffset;
@@ -35,6 +35,7 @@
 #include "IPadding.h"
 #include "IStreamCipher.h"
 #include "ParallelOptions.h"
+#include "StreamExecutor.h"
 #include "SymmetricKeySize.h"
 #include "SymmetricEngines.h"
 
@@ -51,6 +52,7 @@ using Cipher::Symmetric::Block::Mode::ICipherMode;
 using Cipher::Symmetric::Block::Padding::IPadding;
 using Cipher::Symmetric::Stream::IStreamCipher;
 using Key::Symmetric::ISymmetricKey;
+using Key::Symmetric::SymmetricKeyView;
 using Enumeration::PaddingModes;
 using Common::ParallelOptions;
 using Enumeration::StreamCiphers;
@@ -150,6 +152,8 @@ class CipherStream
 {
 private:
 
+	static const size_t ASYNC_STEPSIZE = 64 * 1024;
+
 	IBlockCipher* m_blockCipher;
 	ICipherMode* m_cipherEngine;
 	IPadding* m_cipherPadding;
@@ -319,11 +323,28 @@ public:
 	/// <exception cref="Exception::CryptoProcessingException">Thrown if Write is called before Initialize, or if array sizes are misaligned</exception>
 	void Write(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset);
 
+	/// <summary>
+	/// Process using file or memory streams, as a job on a shared executor.
+	/// <para>The job transforms the stream in slices of up to 64KB (or ParallelBlockSize() with a parallel cipher), interleaved with the other jobs on the executor.
+	/// Progress is reported through the returned jobs WaitProgress() function; the ProgressPercent event is not raised.
+	/// This instance and both streams must not be used until the job is complete.</para>
+	/// </summary>
+	/// 
+	/// <param name="InStream">The input stream containing the data to transform</param>
+	/// <param name="OutStream">The output stream that receives the transformed bytes</param>
+	/// <param name="Executor">The executor that runs the job</param>
+	/// 
+	/// <returns>The job handle; the jobs result is the output streams final position</returns>
+	/// 
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if WriteAsync is called before Initialize, or the Input stream is empty</exception>
+	StreamJob<ulong> WriteAsync(IByteStream* InStream, IByteStream* OutStream, StreamExecutor &Executor);
+
 private:
 
 	void BlockTransform(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset);
 	void BlockTransform(IByteStream* InStream, IByteStream* OutStream);
 	void CalculateProgress(size_t Length, size_t Processed);
+	void FinalBlock(IByteStream* InStream, IByteStream* OutStream, size_t Length);
 	ICipherMode* GetCipherMode(CipherModes ModeType, BlockCiphers CipherType, int BlockSize, int RoundCount, Digests KdfEngine);
 	IPadding* GetPaddingMode(PaddingModes PaddingType);
 	IStreamCipher* GetStreamCipher(StreamCiphers CipherType, size_t RoundCount);
@@ -308,6 +308,10 @@ uint DCR::GetMinimumSeedSize(Digests RngEngine)
 			return CTRLEN + 32;
 		case Digests::Blake512:
 			return CTRLEN + 64;
+		case Digests::Blake3:
+			return CTRLEN + 64;
+		case Digests::K12:
+			return CTRLEN + 168;
 		case Digests::Keccak256:
 			return CTRLEN + 136;
 		case Digests::Keccak512:
@@ -0,0 +1,1625 @@
+#include "DLMCore.h"
+#include "CryptoAsymmetricException.h"
+#include "IntUtils.h"
+#include "Keccak.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+
+NAMESPACE_DILITHIUM
+
+using Exception::CryptoAsymmetricException;
+using Digest::Keccak;
+using Utility::IntUtils;
+using Utility::MemUtils;
+using Utility::ParallelUtils;
+
+const int DLMCore::Zetas[DLM_N] =
+{
+	0, 25847, -2608894, -518909, 237124, -777960, -876248, 466468,
+	1826347, 2353451, -359251, -2091905, 3119733, -2884855, 3111497, 2680103,
+	2725464, 1024112, -1079900, 3585928, -549488, -1119584, 2619752, -2108549,
+	-2118186, -3859737, -1399561, -3277672, 1757237, -19422, 4010497, 280005,
+	2706023, 95776, 3077325, 3530437, -1661693, -3592148, -2537516, 3915439,
+	-3861115, -3043716, 3574422, -2867647, 3539968, -300467, 2348700, -539299,
+	-1699267, -1643818, 3505694, -3821735, 3507263, -2140649, -1600420, 3699596,
+	811944, 531354, 954230, 3881043, 3900724, -2556880, 2071892, -2797779,
+	-3930395, -1528703, -3677745, -3041255, -1452451, 3475950, 2176455, -1585221,
+	-1257611, 1939314, -4083598, -1000202, -3190144, -3157330, -3632928, 126922,
+	3412210, -983419, 2147896, 2715295, -2967645, -3693493, -411027, -2477047,
+	-671102, -1228525, -22981, -1308169, -381987, 1349076, 1852771, -1430430,
+	-3343383, 264944, 508951, 3097992, 44288, -1100098, 904516, 3958618,
+	-3724342, -8578, 1653064, -3249728, 2389356, -210977, 759969, -1316856,
+	189548, -3553272, 3159746, -1851402, -2409325, -177440, 1315589, 1341330,
+	1285669, -1584928, -812732, -1439742, -3019102, -3881060, -3628969, 3839961,
+	2091667, 3407706, 2316500, 3817976, -3342478, 2244091, -2446433, -3562462,
+	266997, 2434439, -1235728, 3513181, -3520352, -3759364, -1197226, -3193378,
+	900702, 1859098, 909542, 819034, 495491, -1613174, -43260, -522500,
+	-655327, -3122442, 2031748, 3207046, -3556995, -525098, -768622, -3595838,
+	342297, 286988, -2437823, 4108315, 3437287, -3342277, 1735879, 203044,
+	2842341, 2691481, -2590150, 1265009, 4055324, 1247620, 2486353, 1595974,
+	-3767016, 1250494, 2635921, -3548272, -2994039, 1869119, 1903435, -1050970,
+	-1333058, 1237275, -3318210, -1430225, -451100, 1312455, 3306115, -1962642,
+	-1279661, 1917081, -2546312, -1374803, 1500165, 777191, 2235880, 3406031,
+	-542412, -2831860, -1671176, -1846953, -2584293, -3724270, 594136, -3776993,
+	-2013608, 2432395, 2454455, -164721, 1957272, 3369112, 185531, -1207385,
+	-3183426, 162844, 1616392, 3014001, 810149, 1652634, -3694233, -1799107,
+	-3038916, 3523897, 3866901, 269760, 2213111, -975884, 1717735, 472078,
+	-426683, 1723600, -1803090, 1910376, -1667432, -1104333, -260646, -3833893,
+	-2939036, -2235985, -420899, -2286327, 183443, -976891, 1612842, -3545687,
+	-554416, 3919660, -48306, -1362209, 3937738, 1400424, -846154, 1976782
+};
+
+#if defined(__AVX2__)
+// the packed lane indices of the set bits in each 8 bit rejection mask
+const ulong DLMCore::RejIndex[256] =
+{
+	0x0000000000000000, 0x0000000000000000, 0x0000000000000001, 0x0000000000000100,
+	0x0000000000000002, 0x0000000000000200, 0x0000000000000201, 0x0000000000020100,
+	0x0000000000000003, 0x0000000000000300, 0x0000000000000301, 0x0000000000030100,
+	0x0000000000000302, 0x0000000000030200, 0x0000000000030201, 0x0000000003020100,
+	0x0000000000000004, 0x0000000000000400, 0x0000000000000401, 0x0000000000040100,
+	0x0000000000000402, 0x0000000000040200, 0x0000000000040201, 0x0000000004020100,
+	0x0000000000000403, 0x0000000000040300, 0x0000000000040301, 0x0000000004030100,
+	0x0000000000040302, 0x0000000004030200, 0x0000000004030201, 0x0000000403020100,
+	0x0000000000000005, 0x0000000000000500, 0x0000000000000501, 0x0000000000050100,
+	0x0000000000000502, 0x0000000000050200, 0x0000000000050201, 0x0000000005020100,
+	0x0000000000000503, 0x0000000000050300, 0x0000000000050301, 0x0000000005030100,
+	0x0000000000050302, 0x0000000005030200, 0x0000000005030201, 0x0000000503020100,
+	0x0000000000000504, 0x0000000000050400, 0x0000000000050401, 0x0000000005040100,
+	0x0000000000050402, 0x0000000005040200, 0x0000000005040201, 0x0000000504020100,
+	0x0000000000050403, 0x0000000005040300, 0x0000000005040301, 0x0000000504030100,
+	0x0000000005040302, 0x0000000504030200, 0x0000000504030201, 0x0000050403020100,
+	0x0000000000000006, 0x0000000000000600, 0x0000000000000601, 0x0000000000060100,
+	0x0000000000000602, 0x0000000000060200, 0x0000000000060201, 0x0000000006020100,
+	0x0000000000000603, 0x0000000000060300, 0x0000000000060301, 0x0000000006030100,
+	0x0000000000060302, 0x0000000006030200, 0x0000000006030201, 0x0000000603020100,
+	0x0000000000000604, 0x0000000000060400, 0x0000000000060401, 0x0000000006040100,
+	0x0000000000060402, 0x0000000006040200, 0x0000000006040201, 0x0000000604020100,
+	0x0000000000060403, 0x0000000006040300, 0x0000000006040301, 0x0000000604030100,
+	0x0000000006040302, 0x0000000604030200, 0x0000000604030201, 0x0000060403020100,
+	0x0000000000000605, 0x0000000000060500, 0x0000000000060501, 0x0000000006050100,
+	0x0000000000060502, 0x0000000006050200, 0x0000000006050201, 0x0000000605020100,
+	0x0000000000060503, 0x0000000006050300, 0x0000000006050301, 0x0000000605030100,
+	0x0000000006050302, 0x0000000605030200, 0x0000000605030201, 0x0000060503020100,
+	0x0000000000060504, 0x0000000006050400, 0x0000000006050401, 0x0000000605040100,
+	0x0000000006050402, 0x0000000605040200, 0x0000000605040201, 0x0000060504020100,
+	0x0000000006050403, 0x0000000605040300, 0x0000000605040301, 0x0000060504030100,
+	0x0000000605040302, 0x0000060504030200, 0x0000060504030201, 0x0006050403020100,
+	0x0000000000000007, 0x0000000000000700, 0x0000000000000701, 0x0000000000070100,
+	0x0000000000000702, 0x0000000000070200, 0x0000000000070201, 0x0000000007020100,
+	0x0000000000000703, 0x0000000000070300, 0x0000000000070301, 0x0000000007030100,
+	0x0000000000070302, 0x0000000007030200, 0x0000000007030201, 0x0000000703020100,
+	0x0000000000000704, 0x0000000000070400, 0x0000000000070401, 0x0000000007040100,
+	0x0000000000070402, 0x0000000007040200, 0x0000000007040201, 0x0000000704020100,
+	0x0000000000070403, 0x0000000007040300, 0x0000000007040301, 0x0000000704030100,
+	0x0000000007040302, 0x0000000704030200, 0x0000000704030201, 0x0000070403020100,
+	0x0000000000000705, 0x0000000000070500, 0x0000000000070501, 0x0000000007050100,
+	0x0000000000070502, 0x0000000007050200, 0x0000000007050201, 0x0000000705020100,
+	0x0000000000070503, 0x0000000007050300, 0x0000000007050301, 0x0000000705030100,
+	0x0000000007050302, 0x0000000705030200, 0x0000000705030201, 0x0000070503020100,
+	0x0000000000070504, 0x0000000007050400, 0x0000000007050401, 0x0000000705040100,
+	0x0000000007050402, 0x0000000705040200, 0x0000000705040201, 0x0000070504020100,
+	0x0000000007050403, 0x0000000705040300, 0x0000000705040301, 0x0000070504030100,
+	0x0000000705040302, 0x0000070504030200, 0x0000070504030201, 0x0007050403020100,
+	0x0000000000000706, 0x0000000000070600, 0x0000000000070601, 0x0000000007060100,
+	0x0000000000070602, 0x0000000007060200, 0x0000000007060201, 0x0000000706020100,
+	0x0000000000070603, 0x0000000007060300, 0x0000000007060301, 0x0000000706030100,
+	0x0000000007060302, 0x0000000706030200, 0x0000000706030201, 0x0000070603020100,
+	0x0000000000070604, 0x0000000007060400, 0x0000000007060401, 0x0000000706040100,
+	0x0000000007060402, 0x0000000706040200, 0x0000000706040201, 0x0000070604020100,
+	0x0000000007060403, 0x0000000706040300, 0x0000000706040301, 0x0000070604030100,
+	0x0000000706040302, 0x0000070604030200, 0x0000070604030201, 0x0007060403020100,
+	0x0000000000070605, 0x0000000007060500, 0x0000000007060501, 0x0000000706050100,
+	0x0000000007060502, 0x0000000706050200, 0x0000000706050201, 0x0000070605020100,
+	0x0000000007060503, 0x0000000706050300, 0x0000000706050301, 0x0000070605030100,
+	0x0000000706050302, 0x0000070605030200, 0x0000070605030201, 0x0007060503020100,
+	0x0000000007060504, 0x0000000706050400, 0x0000000706050401, 0x0000070605040100,
+	0x0000000706050402, 0x0000070605040200, 0x0000070605040201, 0x0007060504020100,
+	0x0000000706050403, 0x0000070605040300, 0x0000070605040301, 0x0007060504030100,
+	0x0000070605040302, 0x0007060504030200, 0x0007060504030201, 0x0706050403020100
+};
+#endif
+
+//~~~Public Functions~~~//
+
+void DLMCore::GetParamSet(DLMParamSet &Params, DLMParams Parameters)
+{
+	if (Parameters == DLMParams::MLDSA44)
+	{
+		Params.Load(4, 4, 2, 39, 78, 1 << 17, (DLM_Q - 1) / 88, 80, 128, 1312, 2560, 2420, DLMParams::MLDSA44);
+	}
+	else if (Parameters == DLMParams::MLDSA65)
+	{
+		Params.Load(6, 5, 4, 49, 196, 1 << 19, (DLM_Q - 1) / 32, 55, 192, 1952, 4032, 3309, DLMParams::MLDSA65);
+	}
+	else if (Parameters == DLMParams::MLDSA87)
+	{
+		Params.Load(8, 7, 2, 60, 120, 1 << 19, (DLM_Q - 1) / 32, 75, 256, 2592, 4896, 4627, DLMParams::MLDSA87);
+	}
+	else
+	{
+		throw CryptoAsymmetricException("DLMCore:GetParamSet", "The parameter set is not recognized!");
+	}
+}
+
+void DLMCore::Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, std::unique_ptr<IPrng> &Random, const DLMParamSet &Params)
+{
+	std::vector<byte> xi(SEED_SIZE);
+
+	Random->GetBytes(xi);
+	Generate(PublicKey, PrivateKey, xi, Params);
+	IntUtils::ClearVector(xi);
+}
+
+void DLMCore::Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, const std::vector<byte> &Seed, const DLMParamSet &Params)
+{
+	CexAssert(Seed.size() == SEED_SIZE, "The seed size is invalid");
+
+	const size_t K = Params.K;
+	const size_t L = Params.L;
+	const uint ETABITS = EtaBits(Params.Eta);
+	const size_t ETAPLEN = (DLM_N * ETABITS) / 8;
+	const size_t T0PLEN = (DLM_N * DLM_D) / 8;
+	const size_t T1PLEN = (DLM_N * 10) / 8;
+	std::vector<byte> xi(Seed);
+	std::vector<byte> seeds((2 * SEED_SIZE) + CRH_SIZE);
+	std::vector<byte> rho(SEED_SIZE);
+	std::vector<byte> rhop(CRH_SIZE);
+	std::vector<byte> tr(CRH_SIZE);
+	std::vector<Poly> a;
+	std::vector<Poly> s1(L);
+	std::vector<Poly> s2(K);
+	std::vector<Poly> s1h(L);
+	Poly t;
+	Poly t0;
+	Poly t1;
+
+	// (rho, rho', K) = H(xi || k || l)
+	xi.push_back(static_cast<byte>(K));
+	xi.push_back(static_cast<byte>(L));
+	Shake(seeds, 0, seeds.size(), xi, SHAKE256_RATE);
+	MemUtils::Copy(seeds, 0, rho, 0, SEED_SIZE);
+	MemUtils::Copy(seeds, SEED_SIZE, rhop, 0, CRH_SIZE);
+
+	ExpandA(a, rho, Params);
+	ExpandS(s1, s2, rhop, Params);
+
+	for (size_t j = 0; j < L; ++j)
+	{
+		s1h[j] = s1[j];
+		Ntt(s1h[j]);
+	}
+
+	PublicKey.resize(SEED_SIZE + (K * T1PLEN));
+	PrivateKey.resize((2 * SEED_SIZE) + CRH_SIZE + ((L + K) * ETAPLEN) + (K * T0PLEN));
+	MemUtils::Copy(rho, 0, PublicKey, 0, SEED_SIZE);
+	MemUtils::Copy(rho, 0, PrivateKey, 0, SEED_SIZE);
+	MemUtils::Copy(seeds, SEED_SIZE + CRH_SIZE, PrivateKey, SEED_SIZE, SEED_SIZE);
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		// t = A * s1 + s2, split into the high bits (t1) and low bits (t0)
+		t.fill(0);
+
+		for (size_t j = 0; j < L; ++j)
+		{
+			MultiplyAcc(t, a[(i * L) + j], s1h[j]);
+		}
+
+		ReducePoly(t);
+		NttInv(t);
+
+		for (size_t n = 0; n < DLM_N; ++n)
+		{
+			t[n] += s2[i][n];
+		}
+
+		FreezePoly(t);
+
+		for (size_t n = 0; n < DLM_N; ++n)
+		{
+			t1[n] = (t[n] + (1 << (DLM_D - 1)) - 1) >> DLM_D;
+			t0[n] = t[n] - (t1[n] << DLM_D);
+		}
+
+		SimpleBitPack(PublicKey, SEED_SIZE + (i * T1PLEN), t1, 10);
+		BitPack(PrivateKey, (2 * SEED_SIZE) + CRH_SIZE + ((L + K) * ETAPLEN) + (i * T0PLEN), t0, 1 << (DLM_D - 1), DLM_D);
+	}
+
+	// tr = H(pk)
+	Shake(tr, 0, CRH_SIZE, PublicKey, SHAKE256_RATE);
+	MemUtils::Copy(tr, 0, PrivateKey, 2 * SEED_SIZE, CRH_SIZE);
+
+	for (size_t j = 0; j < L; ++j)
+	{
+		BitPack(PrivateKey, (2 * SEED_SIZE) + CRH_SIZE + (j * ETAPLEN), s1[j], static_cast<int>(Params.Eta), ETABITS);
+	}
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		BitPack(PrivateKey, (2 * SEED_SIZE) + CRH_SIZE + ((L + i) * ETAPLEN), s2[i], static_cast<int>(Params.Eta), ETABITS);
+	}
+
+	IntUtils::ClearVector(xi);
+	IntUtils::ClearVector(seeds);
+	IntUtils::ClearVector(rhop);
+
+	for (size_t j = 0; j < L; ++j)
+	{
+		s1[j].fill(0);
+		s1h[j].fill(0);
+	}
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		s2[i].fill(0);
+	}
+
+	t.fill(0);
+	t0.fill(0);
+}
+
+void DLMCore::Sign(std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const std::vector<byte> &PrivateKey, std::unique_ptr<IPrng> &Random, const DLMParamSet &Params)
+{
+	std::vector<byte> rnd(SEED_SIZE);
+
+	// the signature is hedged with the random bytes
+	Random->GetBytes(rnd);
+	Sign(Signature, Message, MsgOffset, MsgLength, PrivateKey, rnd, Params);
+	IntUtils::ClearVector(rnd);
+}
+
+void DLMCore::Sign(std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const std::vector<byte> &PrivateKey, const std::vector<byte> &Rnd, const DLMParamSet &Params)
+{
+	// pure signing with an empty context string: M' = 0 || 0 || M
+	std::vector<byte> msg(2 + MsgLength, 0);
+
+	if (MsgLength != 0)
+	{
+		MemUtils::Copy(Message, MsgOffset, msg, 2, MsgLength);
+	}
+
+	SignInternal(Signature, msg, PrivateKey, Rnd, Params);
+}
+
+void DLMCore::SignInternal(std::vector<byte> &Signature, const std::vector<byte> &Message, const std::vector<byte> &PrivateKey, const std::vector<byte> &Rnd, const DLMParamSet &Params)
+{
+	CexAssert(PrivateKey.size() >= Params.PrivateKeySize, "The private key is too small");
+	CexAssert(Rnd.size() == SEED_SIZE, "The randomizer size is invalid");
+
+	const size_t K = Params.K;
+	const size_t L = Params.L;
+	const size_t CTLEN = Params.Lambda / 4;
+	const uint ETABITS = EtaBits(Params.Eta);
+	const size_t ETAPLEN = (DLM_N * ETABITS) / 8;
+	const uint G1BITS = Gamma1Bits(Params.Gamma1);
+	const size_t T0PLEN = (DLM_N * DLM_D) / 8;
+	const uint W1BITS = W1Bits(Params.Gamma2);
+	const size_t W1PLEN = (DLM_N * W1BITS) / 8;
+	const size_t ZPLEN = (DLM_N * G1BITS) / 8;
+	const int BETA = static_cast<int>(Params.Beta);
+	const int G1 = static_cast<int>(Params.Gamma1);
+	const int G2 = static_cast<int>(Params.Gamma2);
+	std::vector<byte> rho(SEED_SIZE);
+	std::vector<byte> seed((2 * SEED_SIZE) + CRH_SIZE);
+	std::vector<byte> rhopp(CRH_SIZE);
+	std::vector<byte> msg(CRH_SIZE + Message.size());
+	std::vector<byte> cw(CRH_SIZE + (K * W1PLEN));
+	std::vector<byte> ctilde(CTLEN);
+	std::vector<Poly> a;
+	std::vector<Poly> s1(L);
+	std::vector<Poly> s2(K);
+	std::vector<Poly> t0(K);
+	std::vector<Poly> y(L);
+	std::vector<Poly> z(L);
+	std::vector<Poly> w(K);
+	std::vector<Poly> h(K);
+	Poly c;
+	Poly ct0;
+	Poly r0;
+	Poly tmp;
+	size_t pos;
+	uint kappa;
+	bool reject;
+
+	// unpack the private key and move the secret vectors into the NTT domain
+	MemUtils::Copy(PrivateKey, 0, rho, 0, SEED_SIZE);
+	pos = (2 * SEED_SIZE) + CRH_SIZE;
+
+	for (size_t j = 0; j < L; ++j)
+	{
+		BitUnpack(s1[j], PrivateKey, pos, static_cast<int>(Params.Eta), ETABITS);
+		Ntt(s1[j]);
+		pos += ETAPLEN;
+	}
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		BitUnpack(s2[i], PrivateKey, pos, static_cast<int>(Params.Eta), ETABITS);
+		Ntt(s2[i]);
+		pos += ETAPLEN;
+	}
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		BitUnpack(t0[i], PrivateKey, pos, 1 << (DLM_D - 1), DLM_D);
+		Ntt(t0[i]);
+		pos += T0PLEN;
+	}
+
+	ExpandA(a, rho, Params);
+
+	// mu = H(tr || M'), the message is the formatted M' of FIPS 204 ML-DSA.Sign_internal
+	MemUtils::Copy(PrivateKey, 2 * SEED_SIZE, msg, 0, CRH_SIZE);
+
+	if (Message.size() != 0)
+	{
+		MemUtils::Copy(Message, 0, msg, CRH_SIZE, Message.size());
+	}
+
+	Shake(cw, 0, CRH_SIZE, msg, SHAKE256_RATE);
+
+	// rho'' = H(K || rnd || mu)
+	MemUtils::Copy(PrivateKey, SEED_SIZE, seed, 0, SEED_SIZE);
+	MemUtils::Copy(Rnd, 0, seed, SEED_SIZE, SEED_SIZE);
+	MemUtils::Copy(cw, 0, seed, 2 * SEED_SIZE, CRH_SIZE);
+	Shake(rhopp, 0, CRH_SIZE, seed, SHAKE256_RATE);
+
+	kappa = 0;
+	reject = true;
+
+	while (reject)
+	{
+		ExpandMask(y, rhopp, kappa, Params);
+		kappa += static_cast<uint>(L);
+
+		for (size_t j = 0; j < L; ++j)
+		{
+			z[j] = y[j];
+			Ntt(z[j]);
+		}
+
+		// w = A * y, the commitment is the high bits of w
+		for (size_t i = 0; i < K; ++i)
+		{
+			w[i].fill(0);
+
+			for (size_t j = 0; j < L; ++j)
+			{
+				MultiplyAcc(w[i], a[(i * L) + j], z[j]);
+			}
+
+			ReducePoly(w[i]);
+			NttInv(w[i]);
+			FreezePoly(w[i]);
+
+			for (size_t n = 0; n < DLM_N; ++n)
+			{
+				tmp[n] = Decompose(r0[n], w[i][n], Params.Gamma2);
+			}
+
+			SimpleBitPack(cw, CRH_SIZE + (i * W1PLEN), tmp, W1BITS);
+		}
+
+		Shake(ctilde, 0, CTLEN, cw, SHAKE256_RATE);
+		SampleInBall(c, ctilde, Params.Tau);
+		Ntt(c);
+		reject = false;
+
+		// z = y + c * s1
+		for (size_t j = 0; j < L; ++j)
+		{
+			MultiplyMont(z[j], c, s1[j]);
+			NttInv(z[j]);
+
+			for (size_t n = 0; n < DLM_N; ++n)
+			{
+				z[j][n] += y[j][n];
+			}
+
+			CenterPoly(z[j]);
+			reject |= CheckNorm(z[j], G1 - BETA);
+		}
+
+		if (reject)
+		{
+			continue;
+		}
+
+		size_t ones = 0;
+
+		for (size_t i = 0; i < K; ++i)
+		{
+			// w - c * s2 must keep its high bits
+			MultiplyMont(tmp, c, s2[i]);
+			NttInv(tmp);
+
+			for (size_t n = 0; n < DLM_N; ++n)
+			{
+				tmp[n] = w[i][n] - tmp[n];
+			}
+
+			FreezePoly(tmp);
+
+			for (size_t n = 0; n < DLM_N; ++n)
+			{
+				Decompose(r0[n], tmp[n], Params.Gamma2);
+			}
+
+			reject |= CheckNorm(r0, G2 - BETA);
+
+			MultiplyMont(ct0, c, t0[i]);
+			NttInv(ct0);
+			CenterPoly(ct0);
+			reject |= CheckNorm(ct0, G2);
+
+			if (reject)
+			{
+				break;
+			}
+
+			// the hint marks the coefficients where adding c * t0 changes the high bits
+			for (size_t n = 0; n < DLM_N; ++n)
+			{
+				int v = Reduce32(tmp[n] + ct0[n]);
+				v += (v >> 31) & DLM_Q;
+				h[i][n] = (Decompose(r0[n], v, Params.Gamma2) != Decompose(r0[n], tmp[n], Params.Gamma2)) ? 1 : 0;
+				ones += h[i][n];
+			}
+		}
+
+		reject |= (ones > Params.Omega);
+	}
+
+	Signature.resize(Params.SignatureSize);
+	MemUtils::Copy(ctilde, 0, Signature, 0, CTLEN);
+
+	for (size_t j = 0; j < L; ++j)
+	{
+		BitPack(Signature, CTLEN + (j * ZPLEN), z[j], G1, G1BITS);
+	}
+
+	HintPack(Signature, CTLEN + (L * ZPLEN), h, Params.Omega);
+
+	IntUtils::ClearVector(seed);
+	IntUtils::ClearVector(rhopp);
+
+	for (size_t j = 0; j < L; ++j)
+	{
+		s1[j].fill(0);
+		y[j].fill(0);
+	}
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		s2[i].fill(0);
+		t0[i].fill(0);
+		w[i].fill(0);
+	}
+}
+
+bool DLMCore::Verify(const std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const std::vector<byte> &PublicKey, const DLMParamSet &Params)
+{
+	DLMPublicState state;
+
+	LoadPublic(state, PublicKey, Params);
+
+	return VerifyMessage(state, Signature, Message, MsgOffset, MsgLength, Params);
+}
+
+bool DLMCore::VerifyBatch(std::vector<byte> &Results, const std::vector<std::vector<byte>> &Signatures, const std::vector<std::vector<byte>> &Messages, const std::vector<byte> &PublicKey, const DLMParamSet &Params, bool Parallel)
+{
+	CexAssert(Signatures.size() == Messages.size(), "The signature and message counts must be equal");
+
+	const size_t CNT = Signatures.size();
+	DLMPublicState state;
+	size_t thdCount;
+	bool valid;
+
+	Results.resize(CNT);
+
+	if (CNT == 0)
+	{
+		return true;
+	}
+
+	// the matrix A, tr, and the NTT of t1 are computed once and shared by every signature
+	LoadPublic(state, PublicKey, Params);
+
+	thdCount = Parallel ? IntUtils::Min(ParallelUtils::ProcessorCount(), CNT) : 1;
+
+	if (thdCount > 1)
+	{
+		const size_t CNKCNT = (CNT + thdCount - 1) / thdCount;
+		thdCount = (CNT + CNKCNT - 1) / CNKCNT;
+
+		ParallelUtils::ParallelFor(0, thdCount, [&state, &Results, &Signatures, &Messages, &Params, CNT, CNKCNT](size_t i)
+		{
+			const size_t FIRST = i * CNKCNT;
+			const size_t LAST = IntUtils::Min(FIRST + CNKCNT, CNT);
+
+			for (size_t j = FIRST; j < LAST; ++j)
+			{
+				Results[j] = VerifyMessage(state, Signatures[j], Messages[j], 0, Messages[j].size(), Params) ? 1 : 0;
+			}
+		});
+	}
+	else
+	{
+		for (size_t j = 0; j < CNT; ++j)
+		{
+			Results[j] = VerifyMessage(state, Signatures[j], Messages[j], 0, Messages[j].size(), Params) ? 1 : 0;
+		}
+	}
+
+	valid = true;
+
+	for (size_t j = 0; j < CNT; ++j)
+	{
+		valid &= (Results[j] != 0);
+	}
+
+	return valid;
+}
+
+//~~~Verification~~~//
+
+void DLMCore::LoadPublic(DLMPublicState &State, const std::vector<byte> &PublicKey, const DLMParamSet &Params)
+{
+	CexAssert(PublicKey.size() >= Params.PublicKeySize, "The public key is too small");
+
+	const size_t K = Params.K;
+	const size_t T1PLEN = (DLM_N * 10) / 8;
+	std::vector<byte> rho(SEED_SIZE);
+
+	MemUtils::Copy(PublicKey, 0, rho, 0, SEED_SIZE);
+	ExpandA(State.A, rho, Params);
+	State.T1.resize(K);
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		SimpleBitUnpack(State.T1[i], PublicKey, SEED_SIZE + (i * T1PLEN), 10);
+
+		for (size_t n = 0; n < DLM_N; ++n)
+		{
+			State.T1[i][n] <<= DLM_D;
+		}
+
+		Ntt(State.T1[i]);
+	}
+
+	State.Tr.resize(CRH_SIZE);
+	Shake(State.Tr, 0, CRH_SIZE, PublicKey, SHAKE256_RATE);
+}
+
+bool DLMCore::VerifyMessage(const DLMPublicState &State, const std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const DLMParamSet &Params)
+{
+	const size_t K = Params.K;
+	const size_t L = Params.L;
+	const size_t CTLEN = Params.Lambda / 4;
+	const uint G1BITS = Gamma1Bits(Params.Gamma1);
+	const uint W1BITS = W1Bits(Params.Gamma2);
+	const size_t W1PLEN = (DLM_N * W1BITS) / 8;
+	const size_t ZPLEN = (DLM_N * G1BITS) / 8;
+	const int G1 = static_cast<int>(Params.Gamma1);
+
+	if (Signature.size() != Params.SignatureSize)
+	{
+		return false;
+	}
+
+	std::vector<byte> ctilde(CTLEN);
+	std::vector<byte> chash(CTLEN);
+	std::vector<byte> msg(CRH_SIZE + 2 + MsgLength);
+	std::vector<byte> cw(CRH_SIZE + (K * W1PLEN));
+	std::vector<Poly> z(L);
+	std::vector<Poly> h(K);
+	Poly c;
+	Poly tmp;
+	Poly w;
+
+	MemUtils::Copy(Signature, 0, ctilde, 0, CTLEN);
+
+	for (size_t j = 0; j < L; ++j)
+	{
+		BitUnpack(z[j], Signature, CTLEN + (j * ZPLEN), G1, G1BITS);
+
+		if (CheckNorm(z[j], G1 - static_cast<int>(Params.Beta)))
+		{
+			return false;
+		}
+
+		Ntt(z[j]);
+	}
+
+	if (!HintUnpack(h, Signature, CTLEN + (L * ZPLEN), Params.Omega))
+	{
+		return false;
+	}
+
+	// mu = H(tr || M')
+	MemUtils::Copy(State.Tr, 0, msg, 0, CRH_SIZE);
+
+	if (MsgLength != 0)
+	{
+		MemUtils::Copy(Message, MsgOffset, msg, CRH_SIZE + 2, MsgLength);
+	}
+
+	Shake(cw, 0, CRH_SIZE, msg, SHAKE256_RATE);
+	SampleInBall(c, ctilde, Params.Tau);
+	Ntt(c);
+
+	// w' = A * z - c * t1 * 2^d, the hint recovers the signers commitment
+	for (size_t i = 0; i < K; ++i)
+	{
+		w.fill(0);
+
+		for (size_t j = 0; j < L; ++j)
+		{
+			MultiplyAcc(w, State.A[(i * L) + j], z[j]);
+		}
+
+		MultiplyMont(tmp, c, State.T1[i]);
+
+		for (size_t n = 0; n < DLM_N; ++n)
+		{
+			w[n] -= tmp[n];
+		}
+
+		ReducePoly(w);
+		NttInv(w);
+		FreezePoly(w);
+
+		for (size_t n = 0; n < DLM_N; ++n)
+		{
+			tmp[n] = UseHint(w[n], static_cast<uint>(h[i][n]), Params.Gamma2);
+		}
+
+		SimpleBitPack(cw, CRH_SIZE + (i * W1PLEN), tmp, W1BITS);
+	}
+
+	Shake(chash, 0, CTLEN, cw, SHAKE256_RATE);
+
+	return IntUtils::Compare(ctilde, 0, chash, 0, CTLEN);
+}
+
+//~~~Sampling~~~//
+
+void DLMCore::ExpandA(std::vector<Poly> &A, const std::vector<byte> &Rho, const DLMParamSet &Params)
+{
+	const size_t LANES = Keccak::PARALLEL_LANES;
+	const size_t CNT = Params.K * Params.L;
+	const size_t SEEDLEN = SEED_SIZE + 2;
+	const size_t BUFLEN = UNIFORM_BLOCKS * SHAKE128_RATE;
+	std::vector<byte> seeds(LANES * SEEDLEN);
+	std::vector<byte> buf(LANES * BUFLEN);
+	std::vector<ulong> state(25 * LANES);
+	std::array<size_t, 4> ctr;
+
+	A.resize(CNT);
+
+	// each polynomial is an independent SHAKE128 stream; four are absorbed and squeezed together
+	for (size_t i = 0; i < CNT; i += LANES)
+	{
+		const size_t LNECNT = IntUtils::Min(LANES, CNT - i);
+
+		for (size_t j = 0; j < LANES; ++j)
+		{
+			// unused lanes repeat the last polynomial
+			const size_t IDX = i + IntUtils::Min(j, LNECNT - 1);
+
+			MemUtils::Copy(Rho, 0, seeds, j * SEEDLEN, SEED_SIZE);
+			seeds[(j * SEEDLEN) + SEED_SIZE] = static_cast<byte>(IDX % Params.L);
+			seeds[(j * SEEDLEN) + SEED_SIZE + 1] = static_cast<byte>(IDX / Params.L);
+		}
+
+		std::fill(state.begin(), state.end(), 0);
+		ShakeAbsorbX4(state, seeds, SEEDLEN, SHAKE128_RATE);
+		ShakeSqueezeX4(state, buf, UNIFORM_BLOCKS, SHAKE128_RATE);
+		bool done = true;
+
+		for (size_t j = 0; j < LNECNT; ++j)
+		{
+			ctr[j] = 0;
+			RejUniform(A[i + j], ctr[j], buf, j * BUFLEN, BUFLEN);
+			done &= (ctr[j] == DLM_N);
+		}
+
+		while (!done)
+		{
+			ShakeSqueezeX4(state, buf, 1, SHAKE128_RATE);
+			done = true;
+
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				RejUniform(A[i + j], ctr[j], buf, j * SHAKE128_RATE, SHAKE128_RATE);
+				done &= (ctr[j] == DLM_N);
+			}
+		}
+	}
+}
+
+void DLMCore::ExpandMask(std::vector<Poly> &Y, const std::vector<byte> &Seed, uint Kappa, const DLMParamSet &Params)
+{
+	const size_t LANES = Keccak::PARALLEL_LANES;
+	const size_t L = Params.L;
+	const uint G1BITS = Gamma1Bits(Params.Gamma1);
+	const size_t SEEDLEN = CRH_SIZE + 2;
+	const size_t BLKCNT = ((DLM_N * G1BITS / 8) + SHAKE256_RATE - 1) / SHAKE256_RATE;
+	const size_t BUFLEN = BLKCNT * SHAKE256_RATE;
+	std::vector<byte> seeds(LANES * SEEDLEN);
+	std::vector<byte> buf(LANES * BUFLEN);
+	std::vector<ulong> state(25 * LANES);
+
+	Y.resize(L);
+
+	for (size_t i = 0; i < L; i += LANES)
+	{
+		const size_t LNECNT = IntUtils::Min(LANES, L - i);
+
+		for (size_t j = 0; j < LANES; ++j)
+		{
+			const uint NONCE = Kappa + static_cast<uint>(i + IntUtils::Min(j, LNECNT - 1));
+
+			MemUtils::Copy(Seed, 0, seeds, j * SEEDLEN, CRH_SIZE);
+			seeds[(j * SEEDLEN) + CRH_SIZE] = static_cast<byte>(NONCE);
+			seeds[(j * SEEDLEN) + CRH_SIZE + 1] = static_cast<byte>(NONCE >> 8);
+		}
+
+		std::fill(state.begin(), state.end(), 0);
+		ShakeAbsorbX4(state, seeds, SEEDLEN, SHAKE256_RATE);
+		ShakeSqueezeX4(state, buf, BLKCNT, SHAKE256_RATE);
+
+		for (size_t j = 0; j < LNECNT; ++j)
+		{
+			BitUnpack(Y[i + j], buf, j * BUFLEN, static_cast<int>(Params.Gamma1), G1BITS);
+		}
+	}
+
+	IntUtils::ClearVector(seeds);
+	IntUtils::ClearVector(buf);
+	IntUtils::ClearVector(state);
+}
+
+void DLMCore::ExpandS(std::vector<Poly> &S1, std::vector<Poly> &S2, const std::vector<byte> &Seed, const DLMParamSet &Params)
+{
+	const size_t ETABLOCKS = 2;
+	const size_t LANES = Keccak::PARALLEL_LANES;
+	const size_t L = Params.L;
+	const size_t CNT = Params.K + Params.L;
+	const size_t SEEDLEN = CRH_SIZE + 2;
+	const size_t BUFLEN = ETABLOCKS * SHAKE256_RATE;
+	std::vector<byte> seeds(LANES * SEEDLEN);
+	std::vector<byte> buf(LANES * BUFLEN);
+	std::vector<ulong> state(25 * LANES);
+	std::array<Poly*, 4> poly;
+	std::array<size_t, 4> ctr;
+
+	S1.resize(Params.L);
+	S2.resize(Params.K);
+
+	// s1 uses the nonces 0 to l-1, s2 uses l to l+k-1
+	for (size_t i = 0; i < CNT; i += LANES)
+	{
+		const size_t LNECNT = IntUtils::Min(LANES, CNT - i);
+
+		for (size_t j = 0; j < LANES; ++j)
+		{
+			const size_t IDX = i + IntUtils::Min(j, LNECNT - 1);
+
+			MemUtils::Copy(Seed, 0, seeds, j * SEEDLEN, CRH_SIZE);
+			seeds[(j * SEEDLEN) + CRH_SIZE] = static_cast<byte>(IDX);
+			seeds[(j * SEEDLEN) + CRH_SIZE + 1] = static_cast<byte>(IDX >> 8);
+			poly[j] = (IDX < L) ? &S1[IDX] : &S2[IDX - L];
+		}
+
+		std::fill(state.begin(), state.end(), 0);
+		ShakeAbsorbX4(state, seeds, SEEDLEN, SHAKE256_RATE);
+		ShakeSqueezeX4(state, buf, ETABLOCKS, SHAKE256_RATE);
+		bool done = true;
+
+		for (size_t j = 0; j < LNECNT; ++j)
+		{
+			ctr[j] = 0;
+			RejEta(*poly[j], ctr[j], buf, j * BUFLEN, BUFLEN, Params.Eta);
+			done &= (ctr[j] == DLM_N);
+		}
+
+		while (!done)
+		{
+			ShakeSqueezeX4(state, buf, 1, SHAKE256_RATE);
+			done = true;
+
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				RejEta(*poly[j], ctr[j], buf, j * SHAKE256_RATE, SHAKE256_RATE, Params.Eta);
+				done &= (ctr[j] == DLM_N);
+			}
+		}
+	}
+
+	IntUtils::ClearVector(seeds);
+	IntUtils::ClearVector(buf);
+	IntUtils::ClearVector(state);
+}
+
+void DLMCore::RejEta(Poly &A, size_t &Count, const std::vector<byte> &Input, size_t InOffset, size_t Length, uint Eta)
+{
+	size_t pos = 0;
+
+	while (Count < DLM_N && pos < Length)
+	{
+		uint t0 = Input[InOffset + pos] & 0x0F;
+		uint t1 = Input[InOffset + pos] >> 4;
+		++pos;
+
+		if (Eta == 2)
+		{
+			if (t0 < 15)
+			{
+				// t mod 5 without a division
+				t0 = t0 - (((205 * t0) >> 10) * 5);
+				A[Count] = 2 - static_cast<int>(t0);
+				++Count;
+			}
+			if (t1 < 15 && Count < DLM_N)
+			{
+				t1 = t1 - (((205 * t1) >> 10) * 5);
+				A[Count] = 2 - static_cast<int>(t1);
+				++Count;
+			}
+		}
+		else
+		{
+			if (t0 < 9)
+			{
+				A[Count] = 4 - static_cast<int>(t0);
+				++Count;
+			}
+			if (t1 < 9 && Count < DLM_N)
+			{
+				A[Count] = 4 - static_cast<int>(t1);
+				++Count;
+			}
+		}
+	}
+}
+
+void DLMCore::RejUniform(Poly &A, size_t &Count, const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	size_t pos = 0;
+
+#if defined(__AVX2__)
+
+	// eight 23 bit candidates from every 24 input bytes; the accepted values are compacted with a lane permutation
+	const __m256i BOUND = _mm256_set1_epi32(DLM_Q);
+	const __m256i MASK = _mm256_set1_epi32(0x7FFFFF);
+	const __m256i SHUF = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1, 4, 5, 6, -1, 7, 8, 9, -1, 10, 11, 12, -1, 13, 14, 15, -1);
+
+	while (Count <= DLM_N - 8 && pos + 32 <= Length)
+	{
+		__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Input[InOffset + pos]));
+		d = _mm256_permute4x64_epi64(d, 0x94);
+		d = _mm256_shuffle_epi8(d, SHUF);
+		d = _mm256_and_si256(d, MASK);
+		pos += 24;
+
+		const __m256i GOOD = _mm256_cmpgt_epi32(BOUND, d);
+		uint msk = static_cast<uint>(_mm256_movemask_ps(_mm256_castsi256_ps(GOOD)));
+		const __m256i IDX = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&RejIndex[msk])));
+		d = _mm256_permutevar8x32_epi32(d, IDX);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[Count]), d);
+
+		msk = msk - ((msk >> 1) & 0x55);
+		msk = (msk & 0x33) + ((msk >> 2) & 0x33);
+		Count += (msk + (msk >> 4)) & 0x0F;
+	}
+
+#endif
+
+	while (Count < DLM_N && pos + 3 <= Length)
+	{
+		uint t = static_cast<uint>(Input[InOffset + pos]) |
+			(static_cast<uint>(Input[InOffset + pos + 1]) << 8) |
+			(static_cast<uint>(Input[InOffset + pos + 2] & 0x7F) << 16);
+		pos += 3;
+
+		if (t < static_cast<uint>(DLM_Q))
+		{
+			A[Count] = static_cast<int>(t);
+			++Count;
+		}
+	}
+}
+
+void DLMCore::SampleInBall(Poly &C, const std::vector<byte> &Seed, uint Tau)
+{
+	std::vector<ulong> state(25, 0);
+	std::vector<byte> buf(SHAKE256_RATE);
+	ulong signs;
+	size_t pos;
+
+	ShakeAbsorb(state, Seed, SHAKE256_RATE);
+	ShakeSqueeze(state, buf, 1, SHAKE256_RATE);
+	signs = IntUtils::LeBytesTo64(buf, 0);
+	pos = 8;
+	C.fill(0);
+
+	// a Fisher-Yates shuffle places Tau coefficients of +/-1
+	for (size_t i = DLM_N - Tau; i < DLM_N; ++i)
+	{
+		size_t b;
+
+		do
+		{
+			if (pos >= SHAKE256_RATE)
+			{
+				ShakeSqueeze(state, buf, 1, SHAKE256_RATE);
+				pos = 0;
+			}
+
+			b = buf[pos];
+			++pos;
+		}
+		while (b > i);
+
+		C[i] = C[b];
+		C[b] = 1 - (2 * static_cast<int>(signs & 1));
+		signs >>= 1;
+	}
+}
+
+//~~~Keccak~~~//
+
+void DLMCore::Shake(std::vector<byte> &Output, size_t OutOffset, size_t Length, const std::vector<byte> &Input, size_t Rate)
+{
+	const size_t BLKCNT = (Length + Rate - 1) / Rate;
+	std::vector<ulong> state(25, 0);
+	std::vector<byte> buf(BLKCNT * Rate);
+
+	ShakeAbsorb(state, Input, Rate);
+	ShakeSqueeze(state, buf, BLKCNT, Rate);
+	MemUtils::Copy(buf, 0, Output, OutOffset, Length);
+	IntUtils::ClearVector(state);
+	IntUtils::ClearVector(buf);
+}
+
+void DLMCore::ShakeAbsorb(std::vector<ulong> &State, const std::vector<byte> &Input, size_t Rate)
+{
+	std::vector<byte> blk(Rate, 0);
+	size_t pos = 0;
+
+	while (Input.size() - pos >= Rate)
+	{
+		for (size_t i = 0; i < Rate / sizeof(ulong); ++i)
+		{
+			State[i] ^= IntUtils::LeBytesTo64(Input, pos + (i * sizeof(ulong)));
+		}
+
+		Keccak::PermuteR(State, 24);
+		pos += Rate;
+	}
+
+	if (Input.size() - pos != 0)
+	{
+		MemUtils::Copy(Input, pos, blk, 0, Input.size() - pos);
+	}
+
+	blk[Input.size() - pos] ^= 0x1F;
+	blk[Rate - 1] ^= 0x80;
+
+	for (size_t i = 0; i < Rate / sizeof(ulong); ++i)
+	{
+		State[i] ^= IntUtils::LeBytesTo64(blk, i * sizeof(ulong));
+	}
+
+	IntUtils::ClearVector(blk);
+}
+
+void DLMCore::ShakeSqueeze(std::vector<ulong> &State, std::vector<byte> &Output, size_t Blocks, size_t Rate)
+{
+	for (size_t i = 0; i < Blocks; ++i)
+	{
+		Keccak::PermuteR(State, 24);
+
+		for (size_t j = 0; j < Rate / sizeof(ulong); ++j)
+		{
+			IntUtils::Le64ToBytes(State[j], Output, (i * Rate) + (j * sizeof(ulong)));
+		}
+	}
+}
+
+void DLMCore::ShakeAbsorbX4(std::vector<ulong> &State, const std::vector<byte> &Seeds, size_t SeedLength, size_t Rate)
+{
+	CexAssert(SeedLength < Rate, "The seed must fit in a single block");
+
+	const size_t LANES = Keccak::PARALLEL_LANES;
+	std::vector<byte> blk(Rate);
+
+	for (size_t i = 0; i < LANES; ++i)
+	{
+		MemUtils::Clear(blk, 0, Rate);
+		MemUtils::Copy(Seeds, i * SeedLength, blk, 0, SeedLength);
+		blk[SeedLength] ^= 0x1F;
+		blk[Rate - 1] ^= 0x80;
+
+		for (size_t j = 0; j < Rate / sizeof(ulong); ++j)
+		{
+			State[(j * LANES) + i] ^= IntUtils::LeBytesTo64(blk, j * sizeof(ulong));
+		}
+	}
+
+	IntUtils::ClearVector(blk);
+}
+
+void DLMCore::ShakeSqueezeX4(std::vector<ulong> &State, std::vector<byte> &Output, size_t Blocks, size_t Rate)
+{
+	const size_t LANES = Keccak::PARALLEL_LANES;
+
+	// lane i is written to Output[i * Blocks * Rate]
+	for (size_t i = 0; i < Blocks; ++i)
+	{
+		Keccak::PermuteP4x(State);
+
+		for (size_t j = 0; j < LANES; ++j)
+		{
+			for (size_t k = 0; k < Rate / sizeof(ulong); ++k)
+			{
+				IntUtils::Le64ToBytes(State[(k * LANES) + j], Output, (j * Blocks * Rate) + (i * Rate) + (k * sizeof(ulong)));
+			}
+		}
+	}
+}
+
+//~~~Arithmetic~~~//
+
+void DLMCore::CenterPoly(Poly &A)
+{
+	for (size_t i = 0; i < DLM_N; ++i)
+	{
+		int r = Reduce32(A[i]);
+		r += (r >> 31) & DLM_Q;
+		r -= (((DLM_Q - 1) / 2 - r) >> 31) & DLM_Q;
+		A[i] = r;
+	}
+}
+
+bool DLMCore::CheckNorm(const Poly &A, int Bound)
+{
+	int res = 0;
+
+	// the coefficients are centered; returns true if any absolute value reaches the bound
+	for (size_t i = 0; i < DLM_N; ++i)
+	{
+		int t = A[i] >> 31;
+		t = A[i] - (t & (2 * A[i]));
+		res |= (Bound - 1 - t) >> 31;
+	}
+
+	return (res != 0);
+}
+
+int DLMCore::Decompose(int &R0, int R, uint Gamma2)
+{
+	int r1 = (R + 127) >> 7;
+
+	if (Gamma2 == (DLM_Q - 1) / 32)
+	{
+		r1 = ((r1 * 1025) + (1 << 21)) >> 22;
+		r1 &= 15;
+	}
+	else
+	{
+		r1 = ((r1 * 11275) + (1 << 23)) >> 24;
+		r1 ^= ((43 - r1) >> 31) & r1;
+	}
+
+	R0 = R - (r1 * 2 * static_cast<int>(Gamma2));
+	R0 -= (((DLM_Q - 1) / 2 - R0) >> 31) & DLM_Q;
+
+	return r1;
+}
+
+void DLMCore::FreezePoly(Poly &A)
+{
+	for (size_t i = 0; i < DLM_N; ++i)
+	{
+		int r = Reduce32(A[i]);
+		A[i] = r + ((r >> 31) & DLM_Q);
+	}
+}
+
+int DLMCore::MontReduce(int64_t A)
+{
+	const int T = static_cast<int>(static_cast<uint>(static_cast<ulong>(A) * static_cast<ulong>(DLM_QINV)));
+
+	return static_cast<int>((A - (static_cast<int64_t>(T) * DLM_Q)) >> 32);
+}
+
+void DLMCore::MultiplyAcc(Poly &R, const Poly &A, const Poly &B)
+{
+#if defined(__AVX2__)
+
+	for (size_t i = 0; i < DLM_N; i += 8)
+	{
+		const __m256i X = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[i]));
+		const __m256i Y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&B[i]));
+		__m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&R[i]));
+		r = _mm256_add_epi32(r, MontMulX(X, Y));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&R[i]), r);
+	}
+
+#else
+
+	for (size_t i = 0; i < DLM_N; ++i)
+	{
+		R[i] += MontReduce(static_cast<int64_t>(A[i]) * B[i]);
+	}
+
+#endif
+}
+
+void DLMCore::MultiplyMont(Poly &R, const Poly &A, const Poly &B)
+{
+#if defined(__AVX2__)
+
+	for (size_t i = 0; i < DLM_N; i += 8)
+	{
+		const __m256i X = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[i]));
+		const __m256i Y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&B[i]));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&R[i]), MontMulX(X, Y));
+	}
+
+#else
+
+	for (size_t i = 0; i < DLM_N; ++i)
+	{
+		R[i] = MontReduce(static_cast<int64_t>(A[i]) * B[i]);
+	}
+
+#endif
+}
+
+void DLMCore::Ntt(Poly &A)
+{
+#if defined(__AVX2__)
+
+	size_t k = 0;
+
+	// the upper five layers butterfly whole vectors against a broadcast zeta
+	for (size_t len = 128; len >= 8; len >>= 1)
+	{
+		for (size_t start = 0; start < DLM_N; start += 2 * len)
+		{
+			++k;
+			const __m256i Z = _mm256_set1_epi32(Zetas[k]);
+
+			for (size_t j = start; j < start + len; j += 8)
+			{
+				__m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j]));
+				__m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j + len]));
+				const __m256i T = MontMulX(hi, Z);
+				hi = _mm256_sub_epi32(lo, T);
+				lo = _mm256_add_epi32(lo, T);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j]), lo);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j + len]), hi);
+			}
+		}
+	}
+
+	// the last three layers gather the butterfly pairs of two vectors with 128, 64 and 32 bit shuffles
+	for (size_t j = 0; j < DLM_N; j += 16)
+	{
+		__m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j]));
+		__m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j + 8]));
+		__m256i lo;
+		__m256i hi;
+		__m256i z;
+		__m256i t;
+
+		// len 4
+		const size_t K4 = 32 + (j / 8);
+		lo = _mm256_permute2x128_si256(v0, v1, 0x20);
+		hi = _mm256_permute2x128_si256(v0, v1, 0x31);
+		z = _mm256_setr_epi32(Zetas[K4], Zetas[K4], Zetas[K4], Zetas[K4], Zetas[K4 + 1], Zetas[K4 + 1], Zetas[K4 + 1], Zetas[K4 + 1]);
+		t = MontMulX(hi, z);
+		hi = _mm256_sub_epi32(lo, t);
+		lo = _mm256_add_epi32(lo, t);
+		v0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+		v1 = _mm256_permute2x128_si256(lo, hi, 0x31);
+
+		// len 2
+		const size_t K2 = 64 + (j / 4);
+		lo = _mm256_unpacklo_epi64(v0, v1);
+		hi = _mm256_unpackhi_epi64(v0, v1);
+		z = _mm256_setr_epi32(Zetas[K2], Zetas[K2], Zetas[K2 + 2], Zetas[K2 + 2], Zetas[K2 + 1], Zetas[K2 + 1], Zetas[K2 + 3], Zetas[K2 + 3]);
+		t = MontMulX(hi, z);
+		hi = _mm256_sub_epi32(lo, t);
+		lo = _mm256_add_epi32(lo, t);
+		v0 = _mm256_unpacklo_epi64(lo, hi);
+		v1 = _mm256_unpackhi_epi64(lo, hi);
+
+		// len 1
+		const size_t K1 = 128 + (j / 2);
+		lo = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(v0), _mm256_castsi256_ps(v1), 0x88));
+		hi = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(v0), _mm256_castsi256_ps(v1), 0xDD));
+		z = _mm256_setr_epi32(Zetas[K1], Zetas[K1 + 1], Zetas[K1 + 4], Zetas[K1 + 5], Zetas[K1 + 2], Zetas[K1 + 3], Zetas[K1 + 6], Zetas[K1 + 7]);
+		t = MontMulX(hi, z);
+		hi = _mm256_sub_epi32(lo, t);
+		lo = _mm256_add_epi32(lo, t);
+		v0 = _mm256_unpacklo_epi32(lo, hi);
+		v1 = _mm256_unpackhi_epi32(lo, hi);
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j]), v0);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j + 8]), v1);
+	}
+
+#else
+
+	NttScalar(A);
+
+#endif
+}
+
+void DLMCore::NttInv(Poly &A)
+{
+#if defined(__AVX2__)
+
+	const __m256i F = _mm256_set1_epi32(DLM_F);
+
+	// the first three layers reverse the shuffled butterflies of the forward transform
+	for (size_t j = 0; j < DLM_N; j += 16)
+	{
+		__m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j]));
+		__m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j + 8]));
+		__m256i lo;
+		__m256i hi;
+		__m256i z;
+		__m256i t;
+
+		// len 1
+		const size_t K1 = 255 - (j / 2);
+		lo = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(v0), _mm256_castsi256_ps(v1), 0x88));
+		hi = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(v0), _mm256_castsi256_ps(v1), 0xDD));
+		z = _mm256_setr_epi32(-Zetas[K1], -Zetas[K1 - 1], -Zetas[K1 - 4], -Zetas[K1 - 5], -Zetas[K1 - 2], -Zetas[K1 - 3], -Zetas[K1 - 6], -Zetas[K1 - 7]);
+		t = lo;
+		lo = _mm256_add_epi32(t, hi);
+		hi = MontMulX(_mm256_sub_epi32(t, hi), z);
+		v0 = _mm256_unpacklo_epi32(lo, hi);
+		v1 = _mm256_unpackhi_epi32(lo, hi);
+
+		// len 2
+		const size_t K2 = 127 - (j / 4);
+		lo = _mm256_unpacklo_epi64(v0, v1);
+		hi = _mm256_unpackhi_epi64(v0, v1);
+		z = _mm256_setr_epi32(-Zetas[K2], -Zetas[K2], -Zetas[K2 - 2], -Zetas[K2 - 2], -Zetas[K2 - 1], -Zetas[K2 - 1], -Zetas[K2 - 3], -Zetas[K2 - 3]);
+		t = lo;
+		lo = _mm256_add_epi32(t, hi);
+		hi = MontMulX(_mm256_sub_epi32(t, hi), z);
+		v0 = _mm256_unpacklo_epi64(lo, hi);
+		v1 = _mm256_unpackhi_epi64(lo, hi);
+
+		// len 4
+		const size_t K4 = 63 - (j / 8);
+		lo = _mm256_permute2x128_si256(v0, v1, 0x20);
+		hi = _mm256_permute2x128_si256(v0, v1, 0x31);
+		z = _mm256_setr_epi32(-Zetas[K4], -Zetas[K4], -Zetas[K4], -Zetas[K4], -Zetas[K4 - 1], -Zetas[K4 - 1], -Zetas[K4 - 1], -Zetas[K4 - 1]);
+		t = lo;
+		lo = _mm256_add_epi32(t, hi);
+		hi = MontMulX(_mm256_sub_epi32(t, hi), z);
+		v0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+		v1 = _mm256_permute2x128_si256(lo, hi, 0x31);
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j]), v0);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j + 8]), v1);
+	}
+
+	size_t k = 32;
+
+	for (size_t len = 8; len < DLM_N; len <<= 1)
+	{
+		for (size_t start = 0; start < DLM_N; start += 2 * len)
+		{
+			--k;
+			const __m256i Z = _mm256_set1_epi32(-Zetas[k]);
+
+			for (size_t j = start; j < start + len; j += 8)
+			{
+				const __m256i T = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j]));
+				__m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j + len]));
+				const __m256i LO = _mm256_add_epi32(T, hi);
+				hi = MontMulX(_mm256_sub_epi32(T, hi), Z);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j]), LO);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j + len]), hi);
+			}
+		}
+	}
+
+	// scale by 1/256 and return to the Montgomery domain
+	for (size_t j = 0; j < DLM_N; j += 8)
+	{
+		const __m256i X = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j]));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j]), MontMulX(X, F));
+	}
+
+#else
+
+	NttInvScalar(A);
+
+#endif
+}
+
+void DLMCore::NttInvScalar(Poly &A)
+{
+	size_t k = DLM_N;
+
+	for (size_t len = 1; len < DLM_N; len <<= 1)
+	{
+		for (size_t start = 0; start < DLM_N; start += 2 * len)
+		{
+			--k;
+			const int64_t Z = -Zetas[k];
+
+			for (size_t j = start; j < start + len; ++j)
+			{
+				const int T = A[j];
+				A[j] = T + A[j + len];
+				A[j + len] = MontReduce(Z * (T - A[j + len]));
+			}
+		}
+	}
+
+	for (size_t j = 0; j < DLM_N; ++j)
+	{
+		A[j] = MontReduce(static_cast<int64_t>(DLM_F) * A[j]);
+	}
+}
+
+void DLMCore::NttScalar(Poly &A)
+{
+	size_t k = 0;
+
+	for (size_t len = 128; len > 0; len >>= 1)
+	{
+		for (size_t start = 0; start < DLM_N; start += 2 * len)
+		{
+			++k;
+			const int64_t Z = Zetas[k];
+
+			for (size_t j = start; j < start + len; ++j)
+			{
+				const int T = MontReduce(Z * A[j + len]);
+				A[j + len] = A[j] - T;
+				A[j] = A[j] + T;
+			}
+		}
+	}
+}
+
+int DLMCore::Reduce32(int A)
+{
+	const int T = (A + (1 << 22)) >> 23;
+
+	return A - (T * DLM_Q);
+}
+
+void DLMCore::ReducePoly(Poly &A)
+{
+	for (size_t i = 0; i < DLM_N; ++i)
+	{
+		A[i] = Reduce32(A[i]);
+	}
+}
+
+int DLMCore::UseHint(int R, uint Hint, uint Gamma2)
+{
+	int r0;
+	int r1 = Decompose(r0, R, Gamma2);
+
+	if (Hint == 0)
+	{
+		return r1;
+	}
+
+	if (Gamma2 == (DLM_Q - 1) / 32)
+	{
+		return (r0 > 0) ? ((r1 + 1) & 15) : ((r1 - 1) & 15);
+	}
+	else
+	{
+		return (r0 > 0) ? ((r1 == 43) ? 0 : r1 + 1) : ((r1 == 0) ? 43 : r1 - 1);
+	}
+}
+
+#if defined(__AVX2__)
+__m256i DLMCore::MontMulX(const __m256i &A, const __m256i &B)
+{
+	// the even and odd lanes are multiplied as 64 bit products; the Montgomery quotient cancels the low halves
+	const __m256i Q = _mm256_set1_epi32(DLM_Q);
+	const __m256i BQ = _mm256_mullo_epi32(B, _mm256_set1_epi32(DLM_QINV));
+	const __m256i AO = _mm256_srli_epi64(A, 32);
+	__m256i pe = _mm256_mul_epi32(A, B);
+	__m256i po = _mm256_mul_epi32(AO, _mm256_srli_epi64(B, 32));
+	__m256i te = _mm256_mul_epi32(A, BQ);
+	__m256i to = _mm256_mul_epi32(AO, _mm256_srli_epi64(BQ, 32));
+
+	te = _mm256_mul_epi32(te, Q);
+	to = _mm256_mul_epi32(to, Q);
+	pe = _mm256_sub_epi32(pe, te);
+	po = _mm256_sub_epi32(po, to);
+	pe = _mm256_srli_epi64(pe, 32);
+
+	return _mm256_blend_epi32(pe, po, 0xAA);
+}
+#endif
+
+//~~~Packing~~~//
+
+void DLMCore::BitPack(std::vector<byte> &Output, size_t OutOffset, const Poly &A, int Bias, uint Bits)
+{
+	const ulong MASK = (1ULL << Bits) - 1;
+	ulong acc = 0;
+	uint cnt = 0;
+	size_t pos = OutOffset;
+
+	// each coefficient is stored as Bias - a, in little endian bit order
+	for (size_t i = 0; i < DLM_N; ++i)
+	{
+		acc |= (static_cast<ulong>(static_cast<uint>(Bias - A[i])) & MASK) << cnt;
+		cnt += Bits;
+
+		while (cnt >= 8)
+		{
+			Output[pos] = static_cast<byte>(acc);
+			++pos;
+			acc >>= 8;
+			cnt -= 8;
+		}
+	}
+}
+
+void DLMCore::BitUnpack(Poly &A, const std::vector<byte> &Input, size_t InOffset, int Bias, uint Bits)
+{
+	const ulong MASK = (1ULL << Bits) - 1;
+	ulong acc = 0;
+	uint cnt = 0;
+	size_t pos = InOffset;
+
+	for (size_t i = 0; i < DLM_N; ++i)
+	{
+		while (cnt < Bits)
+		{
+			acc |= static_cast<ulong>(Input[pos]) << cnt;
+			++pos;
+			cnt += 8;
+		}
+
+		A[i] = Bias - static_cast<int>(acc & MASK);
+		acc >>= Bits;
+		cnt -= Bits;
+	}
+}
+
+void DLMCore::HintPack(std::vector<byte> &Output, size_t OutOffset, const std::vector<Poly> &H, uint Omega)
+{
+	size_t idx = 0;
+
+	// the positions of the ones, followed by the running count after each polynomial
+	MemUtils::Clear(Output, OutOffset, Omega + H.size());
+
+	for (size_t i = 0; i < H.size(); ++i)
+	{
+		for (size_t n = 0; n < DLM_N; ++n)
+		{
+			if (H[i][n] != 0)
+			{
+				Output[OutOffset + idx] = static_cast<byte>(n);
+				++idx;
+			}
+		}
+
+		Output[OutOffset + Omega + i] = static_cast<byte>(idx);
+	}
+}
+
+bool DLMCore::HintUnpack(std::vector<Poly> &H, const std::vector<byte> &Input, size_t InOffset, uint Omega)
+{
+	size_t idx = 0;
+
+	for (size_t i = 0; i < H.size(); ++i)
+	{
+		const size_t END = Input[InOffset + Omega + i];
+		const size_t FIRST = idx;
+
+		H[i].fill(0);
+
+		if (END < idx || END > Omega)
+		{
+			return false;
+		}
+
+		while (idx < END)
+		{
+			// the positions must be strictly increasing to keep the encoding unique
+			if (idx > FIRST && Input[InOffset + idx - 1] >= Input[InOffset + idx])
+			{
+				return false;
+			}
+
+			H[i][Input[InOffset + idx]] = 1;
+			++idx;
+		}
+	}
+
+	for (; idx < Omega; ++idx)
+	{
+		if (Input[InOffset + idx] != 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void DLMCore::SimpleBitPack(std::vector<byte> &Output, size_t OutOffset, const Poly &A, uint Bits)
+{
+	ulong acc = 0;
+	uint cnt = 0;
+	size_t pos = OutOffset;
+
+	for (size_t i = 0; i < DLM_N; ++i)
+	{
+		acc |= static_cast<ulong>(static_cast<uint>(A[i])) << cnt;
+		cnt += Bits;
+
+		while (cnt >= 8)
+		{
+			Output[pos] = static_cast<byte>(acc);
+			++pos;
+			acc >>= 8;
+			cnt -= 8;
+		}
+	}
+}
+
+void DLMCore::SimpleBitUnpack(Poly &A, const std::vector<byte> &Input, size_t InOffset, uint Bits)
+{
+	const ulong MASK = (1ULL << Bits) - 1;
+	ulong acc = 0;
+	uint cnt = 0;
+	size_t pos = InOffset;
+
+	for (size_t i = 0; i < DLM_N; ++i)
+	{
+		while (cnt < Bits)
+		{
+			acc |= static_cast<ulong>(Input[pos]) << cnt;
+			++pos;
+			cnt += 8;
+		}
+
+		A[i] = static_cast<int>(acc & MASK);
+		acc >>= Bits;
+		cnt -= Bits;
+	}
+}
+
+//~~~Helpers~~~//
+
+uint DLMCore::EtaBits(uint Eta)
+{
+	return (Eta == 2) ? 3 : 4;
+}
+
+uint DLMCore::Gamma1Bits(uint Gamma1)
+{
+	return (Gamma1 == (1UL << 17)) ? 18 : 20;
+}
+
+uint DLMCore::W1Bits(uint Gamma2)
+{
+	return (Gamma2 == (DLM_Q - 1) / 88) ? 6 : 4;
+}
+
+NAMESPACE_DILITHIUMEND
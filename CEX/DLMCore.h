@@ -0,0 +1,189 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_DLMCORE_H
+#define CEX_DLMCORE_H
+
+#include "CexDomain.h"
+#include "DLMParamSet.h"
+#include "IPrng.h"
+#if defined(__AVX2__)
+#	include "Intrinsics.h"
+#endif
+
+NAMESPACE_DILITHIUM
+
+using Prng::IPrng;
+
+/**
+* \internal
+*/
+
+/// <summary>
+/// The Dilithium (ML-DSA) key generation, signing and verification functions.
+/// <para>Polynomials are held as 32-bit coefficients modulo 8380417; the NTT, the pointwise Montgomery products and the uniform rejection sampler run 8 coefficients at a time on AVX2.
+/// The matrix A and the secret and masking vectors are expanded 4 polynomials at a time with the interleaved Keccak permutation.</para>
+/// </summary>
+class DLMCore
+{
+private:
+
+	static const int DLM_D = 13;
+	static const int DLM_F = 41978;
+	static const uint DLM_N = 256;
+	static const int DLM_Q = 8380417;
+	static const int DLM_QINV = 58728449;
+	static const size_t CRH_SIZE = 64;
+	static const size_t SEED_SIZE = 32;
+	static const size_t SHAKE128_RATE = 168;
+	static const size_t SHAKE256_RATE = 136;
+	static const size_t UNIFORM_BLOCKS = 5;
+	static const int Zetas[DLM_N];
+#if defined(__AVX2__)
+	static const ulong RejIndex[256];
+#endif
+
+public:
+
+	typedef std::array<int, DLM_N> Poly;
+
+	DLMCore() = delete;
+	DLMCore(const DLMCore&) = delete;
+	DLMCore& operator=(const DLMCore&) = delete;
+	DLMCore& operator=(DLMCore&&) = delete;
+
+	static void GetParamSet(DLMParamSet &Params, DLMParams Parameters);
+
+	static void Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, std::unique_ptr<IPrng> &Random, const DLMParamSet &Params);
+
+	static void Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, const std::vector<byte> &Seed, const DLMParamSet &Params);
+
+	static void Sign(std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const std::vector<byte> &PrivateKey, std::unique_ptr<IPrng> &Random, const DLMParamSet &Params);
+
+	static void Sign(std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const std::vector<byte> &PrivateKey, const std::vector<byte> &Rnd, const DLMParamSet &Params);
+
+	static void SignInternal(std::vector<byte> &Signature, const std::vector<byte> &Message, const std::vector<byte> &PrivateKey, const std::vector<byte> &Rnd, const DLMParamSet &Params);
+
+	static bool Verify(const std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const std::vector<byte> &PublicKey, const DLMParamSet &Params);
+
+	static bool VerifyBatch(std::vector<byte> &Results, const std::vector<std::vector<byte>> &Signatures, const std::vector<std::vector<byte>> &Messages, const std::vector<byte> &PublicKey, const DLMParamSet &Params, bool Parallel);
+
+	//~~~Transforms~~~//
+
+	// the vectorized transforms when AVX2 is enabled, and the portable transforms they are tested against
+
+	static void Ntt(Poly &A);
+
+	static void NttInv(Poly &A);
+
+	static void NttInvScalar(Poly &A);
+
+	static void NttScalar(Poly &A);
+
+private:
+
+	struct DLMPublicState
+	{
+		std::vector<Poly> A;
+		std::vector<Poly> T1;
+		std::vector<byte> Tr;
+	};
+
+	//~~~Verification~~~//
+
+	static void LoadPublic(DLMPublicState &State, const std::vector<byte> &PublicKey, const DLMParamSet &Params);
+
+	static bool VerifyMessage(const DLMPublicState &State, const std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const DLMParamSet &Params);
+
+	//~~~Sampling~~~//
+
+	static void ExpandA(std::vector<Poly> &A, const std::vector<byte> &Rho, const DLMParamSet &Params);
+
+	static void ExpandMask(std::vector<Poly> &Y, const std::vector<byte> &Seed, uint Kappa, const DLMParamSet &Params);
+
+	static void ExpandS(std::vector<Poly> &S1, std::vector<Poly> &S2, const std::vector<byte> &Seed, const DLMParamSet &Params);
+
+	static void RejEta(Poly &A, size_t &Count, const std::vector<byte> &Input, size_t InOffset, size_t Length, uint Eta);
+
+	static void RejUniform(Poly &A, size_t &Count, const std::vector<byte> &Input, size_t InOffset, size_t Length);
+
+	static void SampleInBall(Poly &C, const std::vector<byte> &Seed, uint Tau);
+
+	//~~~Keccak~~~//
+
+	static void Shake(std::vector<byte> &Output, size_t OutOffset, size_t Length, const std::vector<byte> &Input, size_t Rate);
+
+	static void ShakeAbsorb(std::vector<ulong> &State, const std::vector<byte> &Input, size_t Rate);
+
+	static void ShakeSqueeze(std::vector<ulong> &State, std::vector<byte> &Output, size_t Blocks, size_t Rate);
+
+	static void ShakeAbsorbX4(std::vector<ulong> &State, const std::vector<byte> &Seeds, size_t SeedLength, size_t Rate);
+
+	static void ShakeSqueezeX4(std::vector<ulong> &State, std::vector<byte> &Output, size_t Blocks, size_t Rate);
+
+	//~~~Arithmetic~~~//
+
+	static void CenterPoly(Poly &A);
+
+	static bool CheckNorm(const Poly &A, int Bound);
+
+	static int Decompose(int &R0, int R, uint Gamma2);
+
+	static void FreezePoly(Poly &A);
+
+	static int MontReduce(int64_t A);
+
+	static void MultiplyAcc(Poly &R, const Poly &A, const Poly &B);
+
+	static void MultiplyMont(Poly &R, const Poly &A, const Poly &B);
+
+	static int Reduce32(int A);
+
+	static void ReducePoly(Poly &A);
+
+	static int UseHint(int R, uint Hint, uint Gamma2);
+
+#if defined(__AVX2__)
+	static __m256i MontMulX(const __m256i &A, const __m256i &B);
+#endif
+
+	//~~~Packing~~~//
+
+	static void BitPack(std::vector<byte> &Output, size_t OutOffset, const Poly &A, int Bias, uint Bits);
+
+	static void BitUnpack(Poly &A, const std::vector<byte> &Input, size_t InOffset, int Bias, uint Bits);
+
+	static void HintPack(std::vector<byte> &Output, size_t OutOffset, const std::vector<Poly> &H, uint Omega);
+
+	static bool HintUnpack(std::vector<Poly> &H, const std::vector<byte> &Input, size_t InOffset, uint Omega);
+
+	static void SimpleBitPack(std::vector<byte> &Output, size_t OutOffset, const Poly &A, uint Bits);
+
+	static void SimpleBitUnpack(Poly &A, const std::vector<byte> &Input, size_t InOffset, uint Bits);
+
+	//~~~Helpers~~~//
+
+	static uint EtaBits(uint Eta);
+
+	static uint Gamma1Bits(uint Gamma1);
+
+	static uint W1Bits(uint Gamma2);
+};
+
+NAMESPACE_DILITHIUMEND
+#endif
@@ -0,0 +1,53 @@
+#include "DLMKeyPair.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+//~~~Constructor~~~//
+
+DLMKeyPair::DLMKeyPair(DLMPrivateKey* PrivateKey, DLMPublicKey* PublicKey)
+	:
+	m_privateKey(PrivateKey),
+	m_publicKey(PublicKey),
+	m_Tag(0)
+{
+}
+
+DLMKeyPair::DLMKeyPair(DLMPrivateKey* PrivateKey, DLMPublicKey* PublicKey, std::vector<byte> &Tag)
+	:
+	m_privateKey(PrivateKey),
+	m_publicKey(PublicKey),
+	m_Tag(Tag)
+{
+}
+
+DLMKeyPair::~DLMKeyPair()
+{
+	Destroy();
+}
+
+//~~~Properties~~~//
+
+IAsymmetricKey* DLMKeyPair::PrivateKey()
+{
+	return m_privateKey;
+}
+
+IAsymmetricKey* DLMKeyPair::PublicKey()
+{
+	return m_publicKey;
+}
+
+const std::vector<byte> &DLMKeyPair::Tag()
+{
+	return m_Tag;
+}
+
+//~~~Private Functions~~~//
+
+void DLMKeyPair::Destroy()
+{
+	if (m_Tag.size() != 0)
+		m_Tag.clear();
+}
+
+NAMESPACE_ASYMMETRICKEYEND
\ No newline at end of file
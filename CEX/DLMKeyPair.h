@@ -0,0 +1,76 @@
+#ifndef CEX_DLMKEYPAIR_H
+#define CEX_DLMKEYPAIR_H
+
+#include "CexDomain.h"
+#include "IAsymmetricKeyPair.h"
+#include "DLMPrivateKey.h"
+#include "DLMPublicKey.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+/// <summary>
+/// A Dilithium public and private key container
+/// </summary>
+class DLMKeyPair final : public IAsymmetricKeyPair
+{
+private:
+
+	DLMPrivateKey* m_privateKey;
+	DLMPublicKey* m_publicKey;
+	std::vector<byte> m_Tag;
+
+public:
+
+	DLMKeyPair(const DLMKeyPair&) = delete;
+	DLMKeyPair& operator=(const DLMKeyPair&) = delete;
+	DLMKeyPair& operator=(DLMKeyPair&&) = delete;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Instantiate this class with the public/private keys
+	/// </summary>
+	/// 
+	/// <param name="PrivateKey">The private key</param>
+	/// <param name="PublicKey">The public key</param>
+	explicit DLMKeyPair(DLMPrivateKey* PrivateKey, DLMPublicKey* PublicKey);
+
+	/// <summary>
+	/// Instantiate this class with the public/private keys and an identification tag
+	/// </summary>
+	/// 
+	/// <param name="PrivateKey">The private key</param>
+	/// <param name="PublicKey">The public key</param>
+	/// <param name="Tag">The identification tag</param>
+	explicit DLMKeyPair(DLMPrivateKey* PrivateKey, DLMPublicKey* PublicKey, std::vector<byte> &Tag);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~DLMKeyPair() override;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// The Private Key
+	/// </summary>
+	IAsymmetricKey* PrivateKey() override;
+
+	/// <summary>
+	/// The Public key
+	/// </summary>
+	IAsymmetricKey* PublicKey() override;
+
+	/// <summary>
+	/// An optional identification tag
+	/// </summary>
+	const std::vector<byte> &Tag() override;
+
+private:
+
+	void Destroy();
+};
+
+NAMESPACE_ASYMMETRICKEYEND
+#endif
+
@@ -0,0 +1,125 @@
+#include "DLMParamSet.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
+
+NAMESPACE_DILITHIUM
+
+//~~~Constructor~~~//
+
+DLMParamSet::DLMParamSet()
+	:
+	Beta(0),
+	Eta(0),
+	Gamma1(0),
+	Gamma2(0),
+	K(0),
+	L(0),
+	Lambda(0),
+	Omega(0),
+	ParamName(DLMParams::None),
+	PrivateKeySize(0),
+	PublicKeySize(0),
+	SignatureSize(0),
+	Tau(0)
+{}
+
+DLMParamSet::DLMParamSet(uint Rows, uint Columns, uint SecretBound, uint Weight, uint RejectBound, uint MaskRange, uint RoundRange, uint HintCount, uint Strength, uint PubKeySize, uint PriKeySize, uint SigSize, DLMParams ParamSet)
+	:
+	Beta(RejectBound),
+	Eta(SecretBound),
+	Gamma1(MaskRange),
+	Gamma2(RoundRange),
+	K(Rows),
+	L(Columns),
+	Lambda(Strength),
+	Omega(HintCount),
+	ParamName(ParamSet),
+	PrivateKeySize(PriKeySize),
+	PublicKeySize(PubKeySize),
+	SignatureSize(SigSize),
+	Tau(Weight)
+{}
+
+DLMParamSet::DLMParamSet(const std::vector<byte> &ParamArray)
+{
+	IO::MemoryStream ms = IO::MemoryStream(ParamArray);
+	IO::StreamReader reader(ms);
+
+	Beta = reader.ReadInt<uint>();
+	Eta = reader.ReadInt<uint>();
+	Gamma1 = reader.ReadInt<uint>();
+	Gamma2 = reader.ReadInt<uint>();
+	K = reader.ReadInt<uint>();
+	L = reader.ReadInt<uint>();
+	Lambda = reader.ReadInt<uint>();
+	Omega = reader.ReadInt<uint>();
+	ParamName = (DLMParams)reader.ReadByte();
+	PrivateKeySize = reader.ReadInt<uint>();
+	PublicKeySize = reader.ReadInt<uint>();
+	SignatureSize = reader.ReadInt<uint>();
+	Tau = reader.ReadInt<uint>();
+}
+
+DLMParamSet::~DLMParamSet()
+{
+	Reset();
+}
+
+//~~~Public Functions~~~//
+
+void DLMParamSet::Load(uint Rows, uint Columns, uint SecretBound, uint Weight, uint RejectBound, uint MaskRange, uint RoundRange, uint HintCount, uint Strength, uint PubKeySize, uint PriKeySize, uint SigSize, DLMParams ParamSet)
+{
+	Beta = RejectBound;
+	Eta = SecretBound;
+	Gamma1 = MaskRange;
+	Gamma2 = RoundRange;
+	K = Rows;
+	L = Columns;
+	Lambda = Strength;
+	Omega = HintCount;
+	ParamName = ParamSet;
+	PrivateKeySize = PriKeySize;
+	PublicKeySize = PubKeySize;
+	SignatureSize = SigSize;
+	Tau = Weight;
+}
+
+void DLMParamSet::Reset()
+{
+	Beta = 0;
+	Eta = 0;
+	Gamma1 = 0;
+	Gamma2 = 0;
+	K = 0;
+	L = 0;
+	Lambda = 0;
+	Omega = 0;
+	ParamName = DLMParams::None;
+	PrivateKeySize = 0;
+	PublicKeySize = 0;
+	SignatureSize = 0;
+	Tau = 0;
+}
+
+std::vector<byte> DLMParamSet::ToBytes()
+{
+	IO::StreamWriter writer(49);
+
+	writer.Write<uint>(Beta);
+	writer.Write<uint>(Eta);
+	writer.Write<uint>(Gamma1);
+	writer.Write<uint>(Gamma2);
+	writer.Write<uint>(K);
+	writer.Write<uint>(L);
+	writer.Write<uint>(Lambda);
+	writer.Write<uint>(Omega);
+	writer.Write<byte>((byte)ParamName);
+	writer.Write<uint>(PrivateKeySize);
+	writer.Write<uint>(PublicKeySize);
+	writer.Write<uint>(SignatureSize);
+	writer.Write<uint>(Tau);
+
+	return writer.GetBytes();
+}
+
+NAMESPACE_DILITHIUMEND
@@ -0,0 +1,157 @@
+#ifndef CEX_DLMPARAMSET_H
+#define CEX_DLMPARAMSET_H
+
+#include "CexDomain.h"
+#include "DLMParams.h"
+
+NAMESPACE_DILITHIUM
+
+using Enumeration::DLMParams;
+
+struct DLMParamSet
+{
+	DLMParamSet(const DLMParamSet&) = delete;
+	DLMParamSet& operator=(const DLMParamSet&) = delete;
+	DLMParamSet& operator=(DLMParamSet&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// The rejection bound subtracted from the mask ranges; Tau times Eta
+	/// </summary>
+	uint Beta;
+
+	/// <summary>
+	/// The bound on the private key coefficients
+	/// </summary>
+	uint Eta;
+
+	/// <summary>
+	/// The range of the masking vector coefficients
+	/// </summary>
+	uint Gamma1;
+
+	/// <summary>
+	/// The low-order rounding range
+	/// </summary>
+	uint Gamma2;
+
+	/// <summary>
+	/// The number of rows in the matrix A
+	/// </summary>
+	uint K;
+
+	/// <summary>
+	/// The number of columns in the matrix A
+	/// </summary>
+	uint L;
+
+	/// <summary>
+	/// The collision strength of the commitment hash in bits
+	/// </summary>
+	uint Lambda;
+
+	/// <summary>
+	/// The maximum number of ones in the signature hint
+	/// </summary>
+	uint Omega;
+
+	/// <summary>
+	/// The parameter sets enumeration name
+	/// </summary>
+	DLMParams ParamName;
+
+	/// <summary>
+	/// The private keys byte size
+	/// </summary>
+	uint PrivateKeySize;
+
+	/// <summary>
+	/// The public keys byte size
+	/// </summary>
+	uint PublicKeySize;
+
+	/// <summary>
+	/// The signatures byte size
+	/// </summary>
+	uint SignatureSize;
+
+	/// <summary>
+	/// The number of non-zero coefficients in the challenge polynomial
+	/// </summary>
+	uint Tau;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// An empty Dilithium parameter structure
+	/// </summary>
+	DLMParamSet();
+
+	/// <summary>
+	/// Initialize the Dilithium parameter structure
+	/// </summary>
+	///
+	/// <param name="Rows">The number of rows in the matrix A</param>
+	/// <param name="Columns">The number of columns in the matrix A</param>
+	/// <param name="SecretBound">The bound on the private key coefficients</param>
+	/// <param name="Weight">The number of non-zero challenge coefficients</param>
+	/// <param name="RejectBound">The rejection bound</param>
+	/// <param name="MaskRange">The range of the masking vector coefficients</param>
+	/// <param name="RoundRange">The low-order rounding range</param>
+	/// <param name="HintCount">The maximum number of ones in the hint</param>
+	/// <param name="Strength">The collision strength of the commitment hash in bits</param>
+	/// <param name="PubKeySize">The public keys byte size</param>
+	/// <param name="PriKeySize">The private keys byte size</param>
+	/// <param name="SigSize">The signatures byte size</param>
+	/// <param name="ParamSet">The parameter sets enumeration name</param>
+	DLMParamSet(uint Rows, uint Columns, uint SecretBound, uint Weight, uint RejectBound, uint MaskRange, uint RoundRange, uint HintCount, uint Strength, uint PubKeySize, uint PriKeySize, uint SigSize, DLMParams ParamSet);
+
+	/// <summary>
+	/// Initialize the Dilithium parameter structure using a byte array
+	/// </summary>
+	///
+	/// <param name="ParamArray">The byte array containing the DLMParamSet</param>
+	explicit DLMParamSet(const std::vector<byte> &ParamArray);
+
+	/// <summary>
+	/// Finalize state
+	/// </summary>
+	~DLMParamSet();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Load the parameter values
+	/// </summary>
+	///
+	/// <param name="Rows">The number of rows in the matrix A</param>
+	/// <param name="Columns">The number of columns in the matrix A</param>
+	/// <param name="SecretBound">The bound on the private key coefficients</param>
+	/// <param name="Weight">The number of non-zero challenge coefficients</param>
+	/// <param name="RejectBound">The rejection bound</param>
+	/// <param name="MaskRange">The range of the masking vector coefficients</param>
+	/// <param name="RoundRange">The low-order rounding range</param>
+	/// <param name="HintCount">The maximum number of ones in the hint</param>
+	/// <param name="Strength">The collision strength of the commitment hash in bits</param>
+	/// <param name="PubKeySize">The public keys byte size</param>
+	/// <param name="PriKeySize">The private keys byte size</param>
+	/// <param name="SigSize">The signatures byte size</param>
+	/// <param name="ParamSet">The parameter sets enumeration name</param>
+	void Load(uint Rows, uint Columns, uint SecretBound, uint Weight, uint RejectBound, uint MaskRange, uint RoundRange, uint HintCount, uint Strength, uint PubKeySize, uint PriKeySize, uint SigSize, DLMParams ParamSet);
+
+	/// <summary>
+	/// Reset current parameters
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// Convert the DLMParamSet structure to a byte array
+	/// </summary>
+	///
+	/// <returns>The byte array containing the DLMParamSet</returns>
+	std::vector<byte> ToBytes();
+};
+
+NAMESPACE_DILITHIUMEND
+#endif
@@ -0,0 +1,32 @@
+#ifndef CEX_DLMPARAMS_H
+#define CEX_DLMPARAMS_H
+
+#include "CexDomain.h"
+
+NAMESPACE_ENUMERATION
+
+/// <summary>
+/// The Dilithium parameter sets enumeration
+/// </summary>
+enum class DLMParams : byte
+{
+	/// <summary>
+	/// No parameter set is specified
+	/// </summary>
+	None = 0,
+	/// <summary>
+	/// The ML-DSA-44 set; a 4x4 matrix over Q 8380417 with 256 coefficients, 128 bit security
+	/// </summary>
+	MLDSA44 = 1,
+	/// <summary>
+	/// The ML-DSA-65 set; a 6x5 matrix over Q 8380417 with 256 coefficients, 192 bit security
+	/// </summary>
+	MLDSA65 = 2,
+	/// <summary>
+	/// The ML-DSA-87 set; an 8x7 matrix over Q 8380417 with 256 coefficients, 256 bit security
+	/// </summary>
+	MLDSA87 = 3
+};
+
+NAMESPACE_ENUMERATIONEND
+#endif
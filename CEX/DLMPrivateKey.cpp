@@ -0,0 +1,92 @@
+#include "DLMPrivateKey.h"
+#include "CryptoAsymmetricException.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+using Exception::CryptoAsymmetricException;
+
+//~~~Properties~~~//
+
+const AsymmetricEngines DLMPrivateKey::CipherType()
+{
+	return Enumeration::AsymmetricEngines::Dilithium;
+}
+
+const DLMParams DLMPrivateKey::Parameters()
+{
+	return m_dlmParameters;
+}
+
+const std::vector<byte> &DLMPrivateKey::S()
+{
+	return m_sKey;
+}
+
+//~~~Constructor~~~//
+
+DLMPrivateKey::DLMPrivateKey(DLMParams Parameters, const std::vector<byte> &S)
+	:
+	m_isDestroyed(false),
+	m_sKey(S),
+	m_dlmParameters(Parameters)
+{
+}
+
+DLMPrivateKey::DLMPrivateKey(const std::vector<byte> &KeyStream)
+	:
+	m_isDestroyed(false),
+	m_sKey(0),
+	m_dlmParameters(DLMParams::None)
+{
+	if (KeyStream.size() < HDR_SIZE)
+	{
+		throw CryptoAsymmetricException("DLMPrivateKey:CTor", "The key stream is too small!");
+	}
+
+	m_dlmParameters = static_cast<DLMParams>(KeyStream[0]);
+	uint sLen = Utility::IntUtils::LeBytesTo32(KeyStream, 1);
+
+	if (KeyStream.size() - HDR_SIZE < sLen)
+	{
+		throw CryptoAsymmetricException("DLMPrivateKey:CTor", "The key stream is truncated!");
+	}
+
+	m_sKey.resize(sLen);
+	Utility::MemUtils::Copy(KeyStream, HDR_SIZE, m_sKey, 0, sLen);
+}
+
+DLMPrivateKey::~DLMPrivateKey()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void DLMPrivateKey::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_dlmParameters = DLMParams::None;
+
+		if (m_sKey.size() > 0)
+		{
+			Utility::IntUtils::ClearVector(m_sKey);
+		}
+	}
+}
+
+std::vector<byte> DLMPrivateKey::ToBytes()
+{
+	uint sLen = static_cast<uint>(m_sKey.size());
+	std::vector<byte> s(sLen + HDR_SIZE);
+	s[0] = static_cast<byte>(m_dlmParameters);
+	Utility::IntUtils::Le32ToBytes(sLen, s, 1);
+	Utility::MemUtils::Copy(m_sKey, 0, s, HDR_SIZE, sLen);
+
+	return s;
+}
+
+NAMESPACE_ASYMMETRICKEYEND
@@ -0,0 +1,92 @@
+#include "DLMPublicKey.h"
+#include "CryptoAsymmetricException.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+using Exception::CryptoAsymmetricException;
+
+//~~~Properties~~~//
+
+const AsymmetricEngines DLMPublicKey::CipherType()
+{
+	return Enumeration::AsymmetricEngines::Dilithium;
+}
+
+const DLMParams DLMPublicKey::Parameters()
+{
+	return m_dlmParameters;
+}
+
+const std::vector<byte> &DLMPublicKey::P()
+{
+	return m_pKey;
+}
+
+//~~~Constructor~~~//
+
+DLMPublicKey::DLMPublicKey(DLMParams Parameters, const std::vector<byte> &P)
+	:
+	m_isDestroyed(false),
+	m_pKey(P),
+	m_dlmParameters(Parameters)
+{
+}
+
+DLMPublicKey::DLMPublicKey(const std::vector<byte> &KeyStream)
+	:
+	m_isDestroyed(false),
+	m_pKey(0),
+	m_dlmParameters(DLMParams::None)
+{
+	if (KeyStream.size() < HDR_SIZE)
+	{
+		throw CryptoAsymmetricException("DLMPublicKey:CTor", "The key stream is too small!");
+	}
+
+	m_dlmParameters = static_cast<DLMParams>(KeyStream[0]);
+	uint pLen = Utility::IntUtils::LeBytesTo32(KeyStream, 1);
+
+	if (KeyStream.size() - HDR_SIZE < pLen)
+	{
+		throw CryptoAsymmetricException("DLMPublicKey:CTor", "The key stream is truncated!");
+	}
+
+	m_pKey.resize(pLen);
+	Utility::MemUtils::Copy(KeyStream, HDR_SIZE, m_pKey, 0, pLen);
+}
+
+DLMPublicKey::~DLMPublicKey()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void DLMPublicKey::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_dlmParameters = DLMParams::None;
+
+		if (m_pKey.size() > 0)
+		{
+			Utility::IntUtils::ClearVector(m_pKey);
+		}
+	}
+}
+
+std::vector<byte> DLMPublicKey::ToBytes()
+{
+	uint pLen = static_cast<uint>(m_pKey.size());
+	std::vector<byte> p(pLen + HDR_SIZE);
+	p[0] = static_cast<byte>(m_dlmParameters);
+	Utility::IntUtils::Le32ToBytes(pLen, p, 1);
+	Utility::MemUtils::Copy(m_pKey, 0, p, HDR_SIZE, pLen);
+
+	return p;
+}
+
+NAMESPACE_ASYMMETRICKEYEND
@@ -0,0 +1,105 @@
+// The GPL version 3 License (GPLv3)
+// 
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+// 
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_DLMPUBLICKEY_H
+#define CEX_DLMPUBLICKEY_H
+
+#include "CexDomain.h"
+#include "IAsymmetricKey.h"
+#include "DLMParams.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+using Enumeration::DLMParams;
+
+/// <summary>
+/// A Dilithium Public Key container
+/// </summary>
+class DLMPublicKey final : public IAsymmetricKey
+{
+private:
+
+	static const size_t HDR_SIZE = 5;
+
+	bool m_isDestroyed;
+	std::vector<byte> m_pKey;
+	DLMParams m_dlmParameters;
+
+public:
+
+	DLMPublicKey() = delete;
+	DLMPublicKey(const DLMPublicKey&) = delete;
+	DLMPublicKey& operator=(const DLMPublicKey&) = delete;
+	DLMPublicKey& operator=(DLMPublicKey&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The public keys cipher type name
+	/// </summary>
+	const AsymmetricEngines CipherType() override;
+
+	/// <summary>
+	/// Get: The signature scheme parameters enumeration name
+	/// </summary>
+	const DLMParams Parameters();
+
+	/// <summary>
+	/// Get: The public key; the matrix seed followed by the packed t1 vector
+	/// </summary>
+	const std::vector<byte> &P();
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Initialize this class with parameters
+	/// </summary>
+	/// 
+	/// <param name="Parameters">The signature scheme parameter enumeration name</param>
+	/// <param name="P">The encoded public key</param>
+	explicit DLMPublicKey(DLMParams Parameters, const std::vector<byte> &P);
+
+	/// <summary>
+	/// Initialize this class with a serialized public key
+	/// </summary>
+	/// 
+	/// <param name="KeyStream">The serialized public key</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the serialized key is truncated</exception>
+	explicit DLMPublicKey(const std::vector<byte> &KeyStream);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~DLMPublicKey() override;
+
+	//~~~Public Methods~~~//
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Serialize a public key to a byte array
+	/// </summary>
+	std::vector<byte> ToBytes() override;
+};
+
+NAMESPACE_ASYMMETRICKEYEND
+#endif
@@ -1,6 +1,8 @@
 #include "DigestFromName.h"
 #include "Blake512.h"
 #include "Blake256.h"
+#include "Blake3.h"
+#include "K12.h"
 #include "Keccak256.h"
 #include "Keccak512.h"
 #include "Keccak1024.h"
@@ -38,6 +40,10 @@ IDigest* DigestFromName::GetInstance(Digests DigestType, bool Parallel)
 			return new Digest::Skein512(Parallel);
 		case Digests::Skein1024:
 			return new Digest::Skein1024(Parallel);
+		case Digests::K12:
+			return new Digest::K12(Parallel);
+		case Digests::Blake3:
+			return new Digest::Blake3(Parallel);
 		default:
 			throw Exception::CryptoException("DigestFromName:GetInstance", "The digest is not recognized!");
 		}
@@ -69,6 +75,10 @@ size_t DigestFromName::GetBlockSize(Digests DigestType)
 		case Digests::Keccak512:
 		case Digests::Keccak1024:
 			return 72;
+		case Digests::K12:
+			return 168;
+		case Digests::Blake3:
+			return 64;
 
 		case Digests::None:
 			return 0;
@@ -89,6 +99,8 @@ size_t DigestFromName::GetDigestSize(Digests DigestType)
 		switch (DigestType)
 		{
 		case Digests::Blake256:
+		case Digests::Blake3:
+		case Digests::K12:
 		case Digests::Keccak256:
 		case Digests::SHA256:
 		case Digests::Skein256:
@@ -121,6 +133,8 @@ size_t DigestFromName::GetPaddingSize(Digests DigestType)
 		{
 		case Digests::Blake256:
 		case Digests::Blake512:
+		case Digests::Blake3:
+		case Digests::K12:
 		case Digests::Keccak256:
 		case Digests::Keccak512:
 		case Digests::Keccak1024:
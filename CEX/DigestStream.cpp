@@ -1,4 +1,5 @@
 #include "DigestStream.h"
+#include "IntUtils.h"
 
 NAMESPACE_PROCESSING
 
@@ -70,6 +71,40 @@ std::vector<byte> DigestStream::Compute(const std::vector<byte> &Input, size_t I
 	return Process(Input, InOffset, Length);
 }
 
+StreamJob<std::vector<byte>> DigestStream::ComputeAsync(IByteStream* InStream, StreamExecutor &Executor)
+{
+	CexAssert(InStream->Length() - InStream->Position() > 0, "the input stream is too short");
+	CexAssert(InStream->CanRead(), "the input stream is set to write only!");
+
+	const ulong DATLEN = InStream->Length() - InStream->Position();
+	const size_t STPLEN = (m_isParallel && m_digestEngine->ParallelBlockSize() > ASYNC_STEPSIZE) ? m_digestEngine->ParallelBlockSize() : ASYNC_STEPSIZE;
+	std::shared_ptr<std::vector<byte>> inpBuffer = std::make_shared<std::vector<byte>>(static_cast<size_t>(Utility::IntUtils::Min<ulong>(DATLEN, STPLEN)));
+	ulong prcLen = 0;
+
+	m_digestEngine->Reset();
+
+	return Executor.Submit<std::vector<byte>>([this, InStream, DATLEN, STPLEN, inpBuffer, prcLen](JobState &Job, std::vector<byte> &Result) mutable -> bool
+	{
+		const size_t PRCLEN = static_cast<size_t>(Utility::IntUtils::Min<ulong>(DATLEN - prcLen, STPLEN));
+		const size_t PRCRED = InStream->Read(*inpBuffer, 0, PRCLEN);
+
+		if (PRCRED == 0)
+			throw CryptoProcessingException("DigestStream:ComputeAsync", "The input stream ended before the expected length!");
+
+		m_digestEngine->Update(*inpBuffer, 0, PRCRED);
+		prcLen += PRCRED;
+		Job.Report(prcLen, DATLEN);
+
+		if (prcLen != DATLEN)
+			return true;
+
+		Result.resize(m_digestEngine->DigestSize());
+		m_digestEngine->Finalize(Result, 0);
+
+		return false;
+	});
+}
+
 //~~~Private Functions~~~//
 
 void DigestStream::CalculateInterval(size_t Length)
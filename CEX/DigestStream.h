@@ -30,6 +30,7 @@
 #include "Event.h"
 #include "IByteStream.h"
 #include "ParallelOptions.h"
+#include "StreamExecutor.h"
 
 NAMESPACE_PROCESSING
 
@@ -68,6 +69,8 @@ class DigestStream
 {
 private:
 
+	static const size_t ASYNC_STEPSIZE = 64 * 1024;
+
 	IDigest* m_digestEngine;
 	bool m_destroyEngine;
 	bool m_isDestroyed = false;
@@ -156,6 +159,19 @@ public:
 	/// <returns>The message hash output code</returns>
 	std::vector<byte> Compute(const std::vector<byte> &Input, size_t InOffset, size_t Length);
 
+	/// <summary>
+	/// Process the entire length of the source stream as a job on a shared executor.
+	/// <para>The job processes the stream in slices of up to 64KB (or ParallelBlockSize() with a parallel digest), interleaved with the other jobs on the executor.
+	/// Progress is reported through the returned jobs WaitProgress() function; the ProgressPercent event is not raised.
+	/// This instance and the source stream must not be used until the job is complete.</para>
+	/// </summary>
+	///
+	/// <param name="InStream">The source stream to process</param>
+	/// <param name="Executor">The executor that runs the job</param>
+	/// 
+	/// <returns>The job handle; the jobs result is the message hash output code</returns>
+	StreamJob<std::vector<byte>> ComputeAsync(IByteStream* InStream, StreamExecutor &Executor);
+
 private:
 
 	void CalculateInterval(size_t Length);
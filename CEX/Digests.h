@@ -53,7 +53,15 @@ enum class Digests : byte
 	/// <summary>
 	/// The Skein digest with a 1024 bit return size
 	/// </summary>
-	Skein1024 = 10
+	Skein1024 = 10,
+	/// <summary>
+	/// The KangarooTwelve tree hashing digest based on 12 round Keccak, with a 256 bit return size
+	/// </summary>
+	K12 = 11,
+	/// <summary>
+	/// The BLAKE3 digest with a 256 bit return size, and keyed and extendable output modes
+	/// </summary>
+	Blake3 = 12
 };
 
 NAMESPACE_ENUMERATIONEND
@@ -0,0 +1,315 @@
+#include "Dilithium.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#include "PrngFromName.h"
+#include "DLMCore.h"
+
+NAMESPACE_DILITHIUM
+
+const std::string Dilithium::CLASS_NAME = "Dilithium";
+
+//~~~Properties~~~//
+
+const AsymmetricEngines Dilithium::Enumeral()
+{
+	return AsymmetricEngines::Dilithium;
+}
+
+const bool Dilithium::IsInitialized()
+{
+	return m_isInitialized;
+}
+
+const bool Dilithium::IsSigner()
+{
+	return m_isSigner;
+}
+
+const std::string Dilithium::Name()
+{
+	std::string name = CLASS_NAME;
+
+	if (m_dlmParameters == DLMParams::MLDSA44)
+	{
+		name += "-MLDSA44";
+	}
+	else if (m_dlmParameters == DLMParams::MLDSA65)
+	{
+		name += "-MLDSA65";
+	}
+	else if (m_dlmParameters == DLMParams::MLDSA87)
+	{
+		name += "-MLDSA87";
+	}
+
+	return name;
+}
+
+const DLMParamSet &Dilithium::ParamSet()
+{
+	return m_paramSet;
+}
+
+const DLMParams Dilithium::Parameters()
+{
+	return m_dlmParameters;
+}
+
+const size_t Dilithium::SignatureSize()
+{
+	return m_paramSet.SignatureSize;
+}
+
+std::vector<byte> &Dilithium::Tag()
+{
+	return m_keyTag;
+}
+
+//~~~Constructor~~~//
+
+Dilithium::Dilithium(DLMParams Parameters, Prngs PrngType, bool Parallel)
+	:
+	m_destroyEngine(true),
+	m_isDestroyed(false),
+	m_isInitialized(false),
+	m_isParallel(Parallel),
+	m_isSigner(false),
+	m_keyTag(0),
+	m_paramSet(),
+	m_rndGenerator(Helper::PrngFromName::GetInstance(PrngType)),
+	m_dlmParameters(Parameters)
+{
+	if (m_dlmParameters == DLMParams::None)
+	{
+		throw CryptoAsymmetricException("Dilithium:CTor", "The parameter set is invalid!");
+	}
+
+	Scope();
+}
+
+Dilithium::Dilithium(DLMParams Parameters, IPrng* Prng, bool Parallel)
+	:
+	m_destroyEngine(false),
+	m_isDestroyed(false),
+	m_isInitialized(false),
+	m_isParallel(Parallel),
+	m_isSigner(false),
+	m_keyTag(0),
+	m_paramSet(),
+	m_rndGenerator(Prng),
+	m_dlmParameters(Parameters)
+{
+	if (m_dlmParameters == DLMParams::None)
+	{
+		throw CryptoAsymmetricException("Dilithium:CTor", "The parameter set is invalid!");
+	}
+	if (m_rndGenerator == nullptr)
+	{
+		throw CryptoAsymmetricException("Dilithium:CTor", "The prng can not be null!");
+	}
+
+	Scope();
+}
+
+Dilithium::~Dilithium()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void Dilithium::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_isInitialized = false;
+		m_isParallel = false;
+		m_isSigner = false;
+		m_paramSet.Reset();
+		m_dlmParameters = DLMParams::None;
+		Utility::IntUtils::ClearVector(m_keyTag);
+
+		// release keys
+		Reset();
+
+		if (m_destroyEngine)
+		{
+			// destroy internally generated objects
+			m_rndGenerator.reset(nullptr);
+			m_destroyEngine = false;
+		}
+		else
+		{
+			// release the external rng (received through ctor2) back to caller
+			m_rndGenerator.release();
+		}
+	}
+}
+
+IAsymmetricKeyPair* Dilithium::Generate()
+{
+	CexAssert(m_dlmParameters != DLMParams::None, "The parameter setting is invalid");
+
+	std::vector<byte> pk(m_paramSet.PublicKeySize);
+	std::vector<byte> sk(m_paramSet.PrivateKeySize);
+
+	DLMCore::Generate(pk, sk, m_rndGenerator, m_paramSet);
+
+	Key::Asymmetric::DLMPublicKey* pubK = new Key::Asymmetric::DLMPublicKey(m_dlmParameters, pk);
+	Key::Asymmetric::DLMPrivateKey* priK = new Key::Asymmetric::DLMPrivateKey(m_dlmParameters, sk);
+	Utility::IntUtils::ClearVector(sk);
+
+	return new Key::Asymmetric::DLMKeyPair(priK, pubK, m_keyTag);
+}
+
+const void Dilithium::Initialize(IAsymmetricKey &AsymmetricKey)
+{
+	if (AsymmetricKey.CipherType() != AsymmetricEngines::Dilithium)
+	{
+		throw CryptoAsymmetricException("Dilithium:Initialize", "The key is not a Dilithium key!");
+	}
+
+	Reset();
+
+	DLMPrivateKey* priK = dynamic_cast<DLMPrivateKey*>(&AsymmetricKey);
+
+	if (priK != nullptr)
+	{
+		if (priK->Parameters() != m_dlmParameters || priK->S().size() != m_paramSet.PrivateKeySize)
+		{
+			throw CryptoAsymmetricException("Dilithium:Initialize", "The private key does not match the parameter set!");
+		}
+
+		m_privateKey = std::unique_ptr<DLMPrivateKey>(priK);
+		m_isSigner = true;
+	}
+	else
+	{
+		DLMPublicKey* pubK = dynamic_cast<DLMPublicKey*>(&AsymmetricKey);
+
+		if (pubK == nullptr || pubK->Parameters() != m_dlmParameters || pubK->P().size() != m_paramSet.PublicKeySize)
+		{
+			throw CryptoAsymmetricException("Dilithium:Initialize", "The public key does not match the parameter set!");
+		}
+
+		m_publicKey = std::unique_ptr<DLMPublicKey>(pubK);
+		m_isSigner = false;
+	}
+
+	m_isInitialized = true;
+}
+
+void Dilithium::Reset()
+{
+	// the keys are owned by the caller
+	if (m_privateKey != nullptr)
+	{
+		m_privateKey.release();
+	}
+	if (m_publicKey != nullptr)
+	{
+		m_publicKey.release();
+	}
+
+	m_isInitialized = false;
+	m_isSigner = false;
+}
+
+void Dilithium::Sign(IByteStream &InputStream, size_t InOffset, size_t Length, std::vector<byte> &Output, size_t OutOffset)
+{
+	std::vector<byte> msg(Length);
+
+	InputStream.Seek(InOffset, IO::SeekOrigin::Begin);
+
+	if (InputStream.Read(msg, 0, Length) != Length)
+	{
+		throw CryptoAsymmetricException("Dilithium:Sign", "The input stream is too short!");
+	}
+
+	Sign(msg, 0, Length, Output, OutOffset);
+}
+
+void Dilithium::Sign(std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<byte> &Output, size_t OutOffset)
+{
+	if (!m_isInitialized || !m_isSigner)
+	{
+		throw CryptoAsymmetricException("Dilithium:Sign", "The signature scheme must be initialized with a private key!");
+	}
+
+	CexAssert(Input.size() - InOffset >= Length, "The input array is too small");
+
+	std::vector<byte> sig(m_paramSet.SignatureSize);
+	DLMCore::Sign(sig, Input, InOffset, Length, m_privateKey->S(), m_rndGenerator, m_paramSet);
+
+	if (Output.size() < OutOffset + sig.size())
+	{
+		Output.resize(OutOffset + sig.size());
+	}
+
+	Utility::MemUtils::Copy(sig, 0, Output, OutOffset, sig.size());
+}
+
+bool Dilithium::Verify(IByteStream &InputStream, size_t InOffset, size_t Length, std::vector<byte> &Code)
+{
+	std::vector<byte> msg(Length);
+
+	InputStream.Seek(InOffset, IO::SeekOrigin::Begin);
+
+	if (InputStream.Read(msg, 0, Length) != Length)
+	{
+		return false;
+	}
+
+	return Verify(msg, 0, Length, Code);
+}
+
+bool Dilithium::Verify(std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<byte> &Code)
+{
+	if (!m_isInitialized || m_isSigner)
+	{
+		throw CryptoAsymmetricException("Dilithium:Verify", "The signature scheme must be initialized with a public key!");
+	}
+
+	CexAssert(Input.size() - InOffset >= Length, "The input array is too small");
+
+	if (Code.size() != m_paramSet.SignatureSize)
+	{
+		return false;
+	}
+
+	return DLMCore::Verify(Code, Input, InOffset, Length, m_publicKey->P(), m_paramSet);
+}
+
+bool Dilithium::Verify(const std::vector<std::vector<byte>> &Messages, const std::vector<std::vector<byte>> &Codes, std::vector<bool> &Results)
+{
+	if (!m_isInitialized || m_isSigner)
+	{
+		throw CryptoAsymmetricException("Dilithium:Verify", "The signature scheme must be initialized with a public key!");
+	}
+	if (Messages.size() != Codes.size())
+	{
+		throw CryptoAsymmetricException("Dilithium:Verify", "The message and signature counts must be equal!");
+	}
+
+	std::vector<byte> valid(Codes.size());
+	bool ret = DLMCore::VerifyBatch(valid, Codes, Messages, m_publicKey->P(), m_paramSet, m_isParallel);
+
+	Results.resize(valid.size());
+
+	for (size_t i = 0; i < valid.size(); ++i)
+	{
+		Results[i] = (valid[i] != 0);
+	}
+
+	return ret;
+}
+
+//~~~Private Functions~~~//
+
+void Dilithium::Scope()
+{
+	DLMCore::GetParamSet(m_paramSet, m_dlmParameters);
+}
+
+NAMESPACE_DILITHIUMEND
@@ -0,0 +1,301 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_DILITHIUM_H
+#define CEX_DILITHIUM_H
+
+#include "CexDomain.h"
+#include "IAsymmetricSign.h"
+#include "IPrng.h"
+#include "Prngs.h"
+#include "DLMKeyPair.h"
+#include "DLMParams.h"
+#include "DLMParamSet.h"
+#include "DLMPrivateKey.h"
+#include "DLMPublicKey.h"
+
+NAMESPACE_DILITHIUM
+
+using Prng::IPrng;
+using Enumeration::Prngs;
+using Key::Asymmetric::DLMKeyPair;
+using Enumeration::DLMParams;
+using Key::Asymmetric::DLMPrivateKey;
+using Key::Asymmetric::DLMPublicKey;
+
+/// <summary>
+/// An implementation of the Dilithium (ML-DSA) module lattice based signature scheme
+/// </summary>
+///
+/// <example>
+/// <description>Key generation:</description>
+/// <code>
+/// Dilithium sgn(DLMParams::MLDSA44, [PrngType], [Parallel]);
+/// IAsymmetricKeyPair* kp = sgn.Generate();
+/// // serialize the public key
+/// DLMPublicKey* pubK = (DLMPublicKey*)kp->PublicKey();
+/// std:vector&lt;byte&gt; skey = pubK->ToBytes();
+/// </code>
+///
+/// <description>Signing:</description>
+/// <code>
+/// Dilithium sgn(DLMParams::MLDSA44);
+/// sgn.Initialize(*kp->PrivateKey());
+/// std:vector&lt;byte&gt; sig(0);
+/// sgn.Sign(msg, 0, msg.size(), sig, 0);
+/// </code>
+///
+/// <description>Verification:</description>
+/// <code>
+/// Dilithium sgn(DLMParams::MLDSA44);
+/// sgn.Initialize(*kp->PublicKey());
+/// bool valid = sgn.Verify(msg, 0, msg.size(), sig);
+/// </code>
+///
+/// <description>Batch verification:</description>
+/// <code>
+/// Dilithium sgn(DLMParams::MLDSA44, Prngs::BCR, true);
+/// sgn.Initialize(*kp->PublicKey());
+/// std::vector&lt;bool&gt; res;
+/// bool valid = sgn.Verify(msgs, sigs, res);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <para>Dilithium is a Fiat-Shamir with aborts signature over module lattices; the public key is a matrix A expanded from a seed and the high bits of t = A*s1 + s2,
+/// and a signature is a masked response z = y + c*s1 that is rejected and retried until it leaks nothing about the short secret vectors.</para>
+///
+/// <para>Polynomial arithmetic uses a 32-bit Montgomery NTT that runs 8 coefficients at a time on AVX2, with the last three layers shuffled within register pairs.
+/// The matrix A is expanded from SHAKE128 four polynomials at a time with the interleaved Keccak permutation, and the uniform rejection sampler compacts eight candidates per step with a lane permutation.
+/// The secret and masking vectors are expanded from SHAKE256 the same way. \n
+/// Verifiers that check many signatures under one public key can use the batch Verify, which expands A, the public key hash and the NTT of t1 once and shares them across the signatures;
+/// when the Parallel flag is set, the signatures in a batch are split across the processor cores.</para>
+///
+/// <list type="bullet">
+/// <item><description>The scheme follows FIPS 204 (ML-DSA) in pure mode with an empty context string; signatures are hedged with random bytes from the Prng</description></item>
+/// <item><description>The ML-DSA-44, ML-DSA-65 and ML-DSA-87 parameter sets are supported</description></item>
+/// <item><description>The Prng is set through the constructor, as either a prng type-name (default BCR-AES256), which instantiates the function internally, or a pointer to a perisitant external instance of a Prng</description></item>
+/// <item><description>The signature is written to the output array at the offset; the array is resized if it is too small</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>FIPS 204: <a href="https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.204.pdf">Module-Lattice-Based Digital Signature Standard</a>.</description></item>
+/// <item><description>The <a href="https://pq-crystals.org/dilithium/data/dilithium-specification-round3-20210208.pdf">CRYSTALS-Dilithium</a> submission to the NIST post-quantum project.</description></item>
+/// </list>
+/// </remarks>
+class Dilithium final : public IAsymmetricSign
+{
+private:
+
+	static const std::string CLASS_NAME;
+
+	bool m_destroyEngine;
+	bool m_isDestroyed;
+	bool m_isInitialized;
+	bool m_isParallel;
+	bool m_isSigner;
+	std::vector<byte> m_keyTag;
+	DLMParamSet m_paramSet;
+	std::unique_ptr<DLMPrivateKey> m_privateKey;
+	std::unique_ptr<DLMPublicKey> m_publicKey;
+	std::unique_ptr<IPrng> m_rndGenerator;
+	DLMParams m_dlmParameters;
+
+public:
+
+	Dilithium() = delete;
+	Dilithium(const Dilithium&) = delete;
+	Dilithium& operator=(const Dilithium&) = delete;
+	Dilithium& operator=(Dilithium&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The signature schemes type-name
+	/// </summary>
+	const AsymmetricEngines Enumeral() override;
+
+	/// <summary>
+	/// Get: The signature scheme has been initialized with a key
+	/// </summary>
+	const bool IsInitialized() override;
+
+	/// <summary>
+	/// Get: This class is initialized for Signing with the Private key
+	/// </summary>
+	const bool IsSigner() override;
+
+	/// <summary>
+	/// Get: The signature scheme and parameter-set formal names
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Get: The signature schemes initialization parameters
+	/// </summary>
+	const DLMParamSet &ParamSet();
+
+	/// <summary>
+	/// Get: The signature schemes parameters enumeration name
+	/// </summary>
+	const DLMParams Parameters();
+
+	/// <summary>
+	/// Get: The byte size of a signature
+	/// </summary>
+	const size_t SignatureSize();
+
+	/// <summary>
+	/// Get/Set: A new asymmetric key-pairs optional identification tag.
+	/// <para>Setting this value must be done before the Generate method is called.</para>
+	/// </summary>
+	std::vector<byte> &Tag();
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Instantiate the signature scheme with an auto-initialized prng
+	/// </summary>
+	///
+	/// <param name="Parameters">The parameter set enumeration name</param>
+	/// <param name="PrngType">The seed prng function type; the default is the BCR generator</param>
+	/// <param name="Parallel">Batch verification is multi-threaded</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if an invalid parameter set is specified</exception>
+	explicit Dilithium(DLMParams Parameters, Prngs PrngType = Prngs::BCR, bool Parallel = false);
+
+	/// <summary>
+	/// Instantiate this class using an external Prng instance
+	/// </summary>
+	///
+	/// <param name="Parameters">The parameter set enumeration name</param>
+	/// <param name="Prng">A pointer to the seed Prng function</param>
+	/// <param name="Parallel">Batch verification is multi-threaded</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if an invalid parameter set is specified, or the prng is null</exception>
+	Dilithium(DLMParams Parameters, IPrng* Prng, bool Parallel = false);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~Dilithium() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Release all resources associated with the object
+	/// </summary>
+	void Destroy();
+
+	/// <summary>
+	/// Generate a public/private key-pair
+	/// </summary>
+	///
+	/// <returns>A public/private key pair</returns>
+	IAsymmetricKeyPair* Generate();
+
+	/// <summary>
+	/// Initialize the signature scheme for signing (private key) or verifying (public key)
+	/// </summary>
+	///
+	/// <param name="AsymmetricKey">The DLMPrivateKey (signing) or DLMPublicKey (verifying)</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the key is not a Dilithium key, or was created with a different parameter set</exception>
+	const void Initialize(IAsymmetricKey &AsymmetricKey) override;
+
+	/// <summary>
+	/// Reset the underlying engine
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Generate a signature for an input stream
+	/// </summary>
+	///
+	/// <param name="InputStream">The stream containing the data to process</param>
+	/// <param name="InOffset">The starting position within the input strean</param>
+	/// <param name="Length">The number of bytes to process</param>
+	/// <param name="Output">The output array receiving the signature code</param>
+	/// <param name="OutOffset">The starting position within the output array</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the scheme is not initialized for signing</exception>
+	void Sign(IByteStream &InputStream, size_t InOffset, size_t Length, std::vector<byte> &Output, size_t OutOffset) override;
+
+	/// <summary>
+	/// Generate a signature for a message
+	/// </summary>
+	///
+	/// <param name="Input">The byte array containing the data to process</param>
+	/// <param name="InOffset">The starting position within the input array</param>
+	/// <param name="Length">The number of bytes to process</param>
+	/// <param name="Output">The output array receiving the signature code</param>
+	/// <param name="OutOffset">The starting position within the output array</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the scheme is not initialized for signing</exception>
+	void Sign(std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<byte> &Output, size_t OutOffset) override;
+
+	/// <summary>
+	/// Verify the signature of an input stream
+	/// </summary>
+	///
+	/// <param name="InputStream">The stream containing the data to test</param>
+	/// <param name="InOffset">The starting offset within the input stream</param>
+	/// <param name="Length">The number of bytes to process</param>
+	/// <param name="Code">The array containing the signature</param>
+	///
+	/// <returns>Returns true if the signature is valid</returns>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the scheme is not initialized for verification</exception>
+	bool Verify(IByteStream &InputStream, size_t InOffset, size_t Length, std::vector<byte> &Code) override;
+
+	/// <summary>
+	/// Verify the signature of a message
+	/// </summary>
+	///
+	/// <param name="Input">The byte array containing the data to test</param>
+	/// <param name="InOffset">The starting offset within the input array</param>
+	/// <param name="Length">The number of bytes to process</param>
+	/// <param name="Code">The array containing the signature</param>
+	///
+	/// <returns>Returns true if the signature is valid</returns>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the scheme is not initialized for verification</exception>
+	bool Verify(std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<byte> &Code) override;
+
+	/// <summary>
+	/// Verify a batch of signatures made with the same private key
+	/// </summary>
+	///
+	/// <param name="Messages">The messages, one per signature</param>
+	/// <param name="Codes">The signatures</param>
+	/// <param name="Results">Receives the result for each signature, in order</param>
+	///
+	/// <returns>Returns true if every signature is valid</returns>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the scheme is not initialized for verification, or the message and signature counts differ</exception>
+	bool Verify(const std::vector<std::vector<byte>> &Messages, const std::vector<std::vector<byte>> &Codes, std::vector<bool> &Results);
+
+private:
+
+	void Scope();
+};
+
+NAMESPACE_DILITHIUMEND
+#endif
@@ -77,6 +77,17 @@ NAMESPACE_ROOT
 			NAMESPACE_MCELIECEEND
 			/*! @} */
 
+			/*!
+			*  \addtogroup ModuleLWE
+			*  @{
+			*  @brief The ModuleLWE (Kyber, ML-KEM) Cipher Namespace
+			*/
+			NAMESPACE_MODULELWE
+				class ModuleLWE {};
+				struct MLWEParamSet {};
+			NAMESPACE_MODULELWEEND
+			/*! @} */
+
 			/*!
 			*  \addtogroup RingLWE
 			*  @{
@@ -88,6 +99,39 @@ NAMESPACE_ROOT
 			NAMESPACE_RINGLWEEND
 			/*! @} */
 
+			/*!
+			*  \addtogroup Sign
+			*  @{
+			*  @brief Asymmetric Signature Schemes Namespace
+			*/
+			NAMESPACE_ASYMMETRICSIGN
+				class IAsymmetricSign {};
+
+				/*!
+				*  \addtogroup Dilithium
+				*  @{
+				*  @brief The Dilithium (ML-DSA) Signature Scheme Namespace
+				*/
+				NAMESPACE_DILITHIUM
+					class Dilithium {};
+					struct DLMParamSet {};
+				NAMESPACE_DILITHIUMEND
+				/*! @} */
+
+				/*!
+				*  \addtogroup SPHINCS
+				*  @{
+				*  @brief The SPHINCS+ Signature Scheme Namespace
+				*/
+				NAMESPACE_SPHINCS
+					class SphincsPlus {};
+					struct SPXParamSet {};
+				NAMESPACE_SPHINCSEND
+				/*! @} */
+
+			NAMESPACE_ASYMMETRICSIGNEND
+			/*! @} */
+
 		NAMESPACE_ASYMMETRICEND
 		/*! @} */
 
@@ -116,15 +160,19 @@ NAMESPACE_ROOT
 			*  @brief Symmetric Block Cipher Mode Namespace
 			*/
 			NAMESPACE_MODE
+				class AeadPacket {};
 				class CBC {};
 				class CFB {};
 				class CTR {};
+				class CTRT {};
 				class EAX {};
 				class ECB {};
 				class GCM {};
+				class GCMT {};
 				class IAeadMode {};
 				class ICipherMode {};
 				class ICM {};
+				class ICMT {};
 				class OCB {};
 				class OFB {};
 			NAMESPACE_MODEEND
@@ -173,6 +221,8 @@ NAMESPACE_ROOT
 	NAMESPACE_COMMON
 		class CipherDescription {};
 		class CpuDetect {};
+		class MemorySegment {};
+		class MutableSegment {};
 		class ParallelOptions {};
 	NAMESPACE_COMMONEND
 	/*! @} */
@@ -186,7 +236,9 @@ NAMESPACE_ROOT
 		class Blake512 {};
 		class Blake256 {};
 		class Blake2Params {};
+		class Blake3 {};
 		class IDigest {};
+		class K12 {};
 		class Keccak256 {};
 		class Keccak512 {};
 		class Keccak1024 {};
@@ -227,11 +279,13 @@ NAMESPACE_ROOT
 		enum class BlockSizes {};
 		enum class CipherModes {};
 		enum class Digests {};
+		enum class DLMParams {};
 		enum class Drbgs {};
 		enum class IVSizes {};
 		enum class Kdfs {};
 		enum class KeySizes {};
 		enum class Macs {};
+		enum class MLWEParams {};
 		enum class MPKCParams {};
 		enum class PaddingModes {};
 		enum class Prngs {};
@@ -239,6 +293,7 @@ NAMESPACE_ROOT
 		enum class RLWEParams {};
 		enum class RoundCounts {};
 		enum class SimdProfiles {};
+		enum class SPXParams {};
 		enum class StreamCiphers {};
 		enum class StreamModes {};
 		enum class SymmetricEngines {};
@@ -291,9 +346,11 @@ NAMESPACE_ROOT
 	*  @brief IO Processors
 	*/
 	NAMESPACE_IO
+		class AsyncFileStream {};
 		class BitConverter {};
 		class FileStream {};
 		class IByteStream {};
+		class MappedFile {};
 		class MemoryStream {};
 		class SecureStream {};
 		enum class SeekOrigin {};
@@ -308,11 +365,13 @@ NAMESPACE_ROOT
 	*  @brief Key Derivation Functions
 	*/
 	NAMESPACE_KDF
+		class ARGON2 {};
 		class HKDF {};
 		class IKdf {};
 		class KDF2 {};
 		class PBKDF2 {};
 		class SCRYPT {};
+		class SHAKE {};
 	NAMESPACE_KDFEND
 	/*! @} */
 
@@ -330,12 +389,21 @@ NAMESPACE_ROOT
 		NAMESPACE_ASYMMETRICKEY
 			class IAsymmetricKey {};
 			class IAsymmetricKeyPair {};
+			class DLMKeyPair {};
+			class DLMPrivateKey {};
+			class DLMPublicKey {};
+			class MLWEKeyPair {};
+			class MLWEPrivateKey {};
+			class MLWEPublicKey {};
 			class MPKCKeyPair {};
 			class MPKCPrivateKey {};
 			class MPKCPublicKey {};
 			class RLWEKeyPair {};
 			class RLWEPrivateKey {};
 			class RLWEPublicKey {};
+			class SPXKeyPair {};
+			class SPXPrivateKey {};
+			class SPXPublicKey {};
 		NAMESPACE_ASYMMETRICKEYEND
 		/*! @} */
 
@@ -348,6 +416,7 @@ NAMESPACE_ROOT
 			class ISymmetricKey {};
 			class SymmetricKeyGenerator {};
 			class SymmetricKey {};
+			class SymmetricKeyView {};
 			class SymmetricKeySize {};
 			class SymmetricSecureKey {};
 		NAMESPACE_SYMMETRICKEYEND
@@ -362,10 +431,13 @@ NAMESPACE_ROOT
 	*  @brief Message Authentication Code Generators
 	*/
 	NAMESPACE_MAC
+		class Blake2Mac {};
 		class CMAC {};
 		class GMAC {};
 		class HMAC {};
 		class IMac {};
+		class KMAC {};
+		class SkeinMac {};
 	NAMESPACE_MACEND
 	/*! @} */
 
@@ -410,6 +482,8 @@ NAMESPACE_ROOT
 		class DigestStream {};
 		class MacDescription {};
 		class MacStream {};
+		class StreamExecutor {};
+		class StreamJob {};
 	NAMESPACE_PROCESSINGEND
 	/*! @} */
 
@@ -448,6 +522,9 @@ NAMESPACE_ROOT
 		class IntUtils {};
 		class MemUtils {};
 		class ParallelUtils {};
+		class SecureAllocator {};
+		class SecureArena {};
+		class SegmentUtils {};
 		class SysUtils {};
 	NAMESPACE_UTILITYEND
 	/*! @} */
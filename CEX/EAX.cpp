@@ -3,6 +3,7 @@
 #include "IntUtils.h"
 #include "MemUtils.h"
 #include "ParallelUtils.h"
+#include "SegmentUtils.h"
 #include "SymmetricKey.h"
 
 NAMESPACE_MODE
@@ -102,6 +103,12 @@ EAX::EAX(BlockCiphers CipherType)
 	m_aadData(m_cipherMode.BlockSize()),
 	m_aadLoaded(false),
 	m_aadPreserve(false),
+	m_autoIncrement(false),
+	m_batchCounter(BLOCK_SIZE),
+	m_batchLanes(BATCH_LANES * BLOCK_SIZE),
+	m_batchMac(0),
+	m_batchMap(BATCH_LANES * 2),
+	m_batchSubKey(2 * BLOCK_SIZE),
 	m_blockSize(m_cipherMode.BlockSize()),
 	m_cipherKey(0),
 	m_cipherType(CipherType),
@@ -118,7 +125,9 @@ EAX::EAX(BlockCiphers CipherType)
 	m_macSize(m_blockSize),
 	m_msgTag(m_blockSize),
 	m_parallelProfile(m_blockSize, m_cipherMode.ParallelProfile().IsParallel(), m_cipherMode.ParallelProfile().ParallelBlockSize(), 
-		m_cipherMode.ParallelProfile().ParallelMaxDegree(), true, m_cipherMode.Engine()->StateCacheSize(), true)
+		m_cipherMode.ParallelProfile().ParallelMaxDegree(), true, m_cipherMode.Engine()->StateCacheSize(), true),
+	m_segmentStage(0),
+	m_tagBuffer(m_blockSize)
 {
 	Scope();
 }
@@ -129,6 +138,12 @@ EAX::EAX(IBlockCipher* Cipher)
 	m_aadData(m_cipherMode.BlockSize()),
 	m_aadLoaded(false),
 	m_aadPreserve(false),
+	m_autoIncrement(false),
+	m_batchCounter(BLOCK_SIZE),
+	m_batchLanes(BATCH_LANES * BLOCK_SIZE),
+	m_batchMac(0),
+	m_batchMap(BATCH_LANES * 2),
+	m_batchSubKey(2 * BLOCK_SIZE),
 	m_blockSize(m_cipherMode.BlockSize()),
 	m_cipherKey(0),
 	m_cipherType(Cipher->Enumeral()),
@@ -145,7 +160,9 @@ EAX::EAX(IBlockCipher* Cipher)
 	m_macSize(m_blockSize),
 	m_msgTag(m_blockSize),
 	m_parallelProfile(m_blockSize, m_cipherMode.ParallelProfile().IsParallel(), m_cipherMode.ParallelProfile().ParallelBlockSize(),
-		m_cipherMode.ParallelProfile().ParallelMaxDegree(), true, m_cipherMode.Engine()->StateCacheSize(), true)
+		m_cipherMode.ParallelProfile().ParallelMaxDegree(), true, m_cipherMode.Engine()->StateCacheSize(), true),
+	m_segmentStage(0),
+	m_tagBuffer(m_blockSize)
 {
 	Scope();
 }
@@ -183,10 +200,17 @@ void EAX::Destroy()
 		m_parallelProfile.Reset();
 
 		Utility::IntUtils::ClearVector(m_aadData);
+		Utility::IntUtils::ClearVector(m_batchCounter);
+		Utility::IntUtils::ClearVector(m_batchLanes);
+		Utility::IntUtils::ClearVector(m_batchMac);
+		Utility::IntUtils::ClearVector(m_batchMap);
+		Utility::IntUtils::ClearVector(m_batchSubKey);
 		Utility::IntUtils::ClearVector(m_cipherKey);
 		Utility::IntUtils::ClearVector(m_eaxNonce);
 		Utility::IntUtils::ClearVector(m_eaxVector);
 		Utility::IntUtils::ClearVector(m_msgTag);
+		Utility::IntUtils::ClearVector(m_segmentStage);
+		Utility::IntUtils::ClearVector(m_tagBuffer);
 
 		if (m_destroyEngine)
 		{
@@ -223,25 +247,27 @@ void EAX::Finalize(std::vector<byte> &Output, const size_t Offset, const size_t
 
 void EAX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
+	SymmetricKeyView keyView(KeyParams);
+
 	// recheck params
 	Scope();
 
-	if (KeyParams.Key().size() == 0)
+	if (keyView.Key().size() == 0)
 	{
-		if (KeyParams.Nonce() == m_eaxVector)
+		if (keyView.Nonce() == m_eaxVector)
 			throw CryptoSymmetricCipherException("EAX:Initialize", "The nonce can not be zeroised or repeating!");
 		if (!m_cipherMode.IsInitialized())
 			throw CryptoSymmetricCipherException("EAX:Initialize", "First initialization requires a key and nonce!");
 	}
 	else
 	{
-		if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+		if (!SymmetricKeySize::Contains(LegalKeySizes(), keyView.Key().size()))
 			throw CryptoSymmetricCipherException("EAX:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 
-		m_cipherKey = KeyParams.Key();
+		m_cipherKey = keyView.Key();
 	}
 
-	if (KeyParams.Nonce().size() != m_cipherMode.BlockSize())
+	if (keyView.Nonce().size() != m_cipherMode.BlockSize())
 		throw CryptoSymmetricCipherException("EAX:Initialize", "Requires a nonce equal in size to the ciphers block size!");
 	if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || m_parallelProfile.ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
 		throw CryptoSymmetricCipherException("EAX:Initialize", "The parallel block size is out of bounds!");
@@ -249,7 +275,7 @@ void EAX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 		throw CryptoSymmetricCipherException("EAX:Initialize", "The parallel block size must be evenly aligned to the ParallelMinimumSize!");
 
 	m_isEncryption = Encryption;
-	m_eaxNonce = KeyParams.Nonce();
+	m_eaxNonce = keyView.Nonce();
 	Key::Symmetric::SymmetricKey kp(m_cipherKey);
 	m_macGenerator.Initialize(kp);
 	UpdateTag((byte)0, m_eaxNonce);
@@ -257,8 +283,8 @@ void EAX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 	m_macGenerator.Initialize(kp);
 
 	// hx extended ciphers
-	if (KeyParams.Info().size() != 0 && m_cipherMode.Engine()->KdfEngine() != Digests::None)
-		m_cipherMode.Initialize(Encryption, Key::Symmetric::SymmetricKey(m_cipherKey, m_eaxVector, KeyParams.Info()));
+	if (keyView.Info().size() != 0 && m_cipherMode.Engine()->KdfEngine() != Digests::None)
+		m_cipherMode.Initialize(Encryption, Key::Symmetric::SymmetricKey(m_cipherKey, m_eaxVector, keyView.Info()));
 	else
 		m_cipherMode.Initialize(Encryption, Key::Symmetric::SymmetricKey(m_cipherKey, m_eaxVector));
 
@@ -271,6 +297,42 @@ void EAX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 	m_isInitialized = true;
 }
 
+bool EAX::Open(std::vector<AeadPacket> &Packets, const size_t TagLength)
+{
+	if (m_isEncryption)
+		throw CryptoCipherModeException("EAX:Open", "The cipher mode has not been initialized for decryption!");
+
+	BatchScope(Packets, TagLength, "EAX:Open");
+	// the nonce, associated data, and cipher-text macs of every packet
+	BatchMac(Packets, 0, 2, false);
+
+	bool status = true;
+
+	// authenticate every packet before it is decrypted
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		AeadPacket &pkt = Packets[i];
+		const size_t MACOFF = i * 3 * BLOCK_SIZE;
+
+		Utility::MemUtils::XOR128(m_batchMac, MACOFF, m_batchMac, MACOFF + (2 * BLOCK_SIZE));
+		Utility::MemUtils::XOR128(m_batchMac, MACOFF + BLOCK_SIZE, m_batchMac, MACOFF + (2 * BLOCK_SIZE));
+		pkt.Verified = Utility::IntUtils::Compare(m_batchMac, MACOFF + (2 * BLOCK_SIZE), *pkt.Tag, pkt.TagOffset, TagLength);
+
+		if (!pkt.Verified)
+		{
+			// rejected packets are not decrypted, so in-place cipher-text is left intact
+			if (pkt.Length != 0 && !pkt.IsInPlace())
+				Utility::MemUtils::Clear(*pkt.Output, pkt.OutOffset, pkt.Length);
+
+			status = false;
+		}
+	}
+
+	BatchKeyStream(Packets, false);
+
+	return status;
+}
+
 void EAX::ParallelMaxDegree(size_t Degree)
 {
 	if (Degree == 0)
@@ -283,6 +345,28 @@ void EAX::ParallelMaxDegree(size_t Degree)
 	m_parallelProfile.SetMaxDegree(Degree);
 }
 
+void EAX::Seal(std::vector<AeadPacket> &Packets, const size_t TagLength)
+{
+	if (!m_isEncryption)
+		throw CryptoCipherModeException("EAX:Seal", "The cipher mode has not been initialized for encryption!");
+
+	BatchScope(Packets, TagLength, "EAX:Seal");
+	// the nonce macs are the initial counters
+	BatchMac(Packets, 0, 1, true);
+	BatchKeyStream(Packets, true);
+	BatchMac(Packets, 2, 2, true);
+
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		AeadPacket &pkt = Packets[i];
+		const size_t MACOFF = i * 3 * BLOCK_SIZE;
+
+		Utility::MemUtils::XOR128(m_batchMac, MACOFF, m_batchMac, MACOFF + (2 * BLOCK_SIZE));
+		Utility::MemUtils::XOR128(m_batchMac, MACOFF + BLOCK_SIZE, m_batchMac, MACOFF + (2 * BLOCK_SIZE));
+		Utility::MemUtils::Copy(m_batchMac, MACOFF + (2 * BLOCK_SIZE), *pkt.Tag, pkt.TagOffset, TagLength);
+	}
+}
+
 void EAX::SetAssociatedData(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
 {
 	if (!m_isInitialized)
@@ -297,6 +381,17 @@ void EAX::SetAssociatedData(const std::vector<byte> &Input, const size_t Offset,
 	m_aadLoaded = true;
 }
 
+void EAX::SetAssociatedSegments(const std::vector<MemorySegment> &Input)
+{
+	if (!Utility::SegmentUtils::IsValid(Input))
+		throw CryptoCipherModeException("EAX:SetAssociatedSegments", "A segment exceeds its array!");
+
+	// the modes absorb the associated data in one call; the fragments are joined in the staging buffer
+	const size_t AADLEN = Utility::SegmentUtils::Gather(Input, m_segmentStage);
+	SetAssociatedData(m_segmentStage, 0, AADLEN);
+	Utility::MemUtils::Clear(m_segmentStage, 0, AADLEN);
+}
+
 void EAX::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
@@ -314,6 +409,11 @@ void EAX::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 	}
 }
 
+void EAX::TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output)
+{
+	Utility::SegmentUtils::Transform(this, Input, Output, m_segmentStage);
+}
+
 bool EAX::Verify(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
 {
 	if (m_isEncryption)
@@ -331,6 +431,168 @@ bool EAX::Verify(const std::vector<byte> &Input, const size_t Offset, const size
 
 //~~~Private Functions~~~//
 
+void EAX::BatchKeyStream(std::vector<AeadPacket> &Packets, bool Encryption)
+{
+	const size_t PKTCNT = Packets.size();
+	size_t pktIdx = 0;
+	size_t pktPos = 0;
+
+	while (pktIdx != PKTCNT)
+	{
+		size_t lanes = 0;
+
+		// stage the counter blocks of consecutive packets
+		while (lanes != BATCH_LANES && pktIdx != PKTCNT)
+		{
+			const AeadPacket &pkt = Packets[pktIdx];
+
+			// a packet that failed authentication is not decrypted
+			if (pktPos == pkt.Length || (!Encryption && !pkt.Verified))
+			{
+				++pktIdx;
+				pktPos = 0;
+				continue;
+			}
+
+			// the counter begins at the nonce mac
+			if (pktPos == 0)
+				Utility::MemUtils::COPY128(m_batchMac, pktIdx * 3 * BLOCK_SIZE, m_batchCounter, 0);
+
+			Utility::MemUtils::COPY128(m_batchCounter, 0, m_batchLanes, lanes * BLOCK_SIZE);
+			Utility::IntUtils::BeIncrement8(m_batchCounter);
+			m_batchMap[lanes * 2] = pktIdx;
+			m_batchMap[(lanes * 2) + 1] = pktPos;
+			pktPos = Utility::IntUtils::Min(pktPos + BLOCK_SIZE, pkt.Length);
+			++lanes;
+		}
+
+		TransformLanes(m_cipherMode.Engine(), m_batchLanes, 0, m_batchLanes, 0, lanes);
+
+		// scatter the key stream to the packets
+		for (size_t i = 0; i < lanes; ++i)
+		{
+			AeadPacket &pkt = Packets[m_batchMap[i * 2]];
+			const size_t PKTPOS = m_batchMap[(i * 2) + 1];
+			const size_t BLKLEN = Utility::IntUtils::Min(BLOCK_SIZE, pkt.Length - PKTPOS);
+
+			Utility::MemUtils::XorBlock(*pkt.Input, pkt.InOffset + PKTPOS, m_batchLanes, i * BLOCK_SIZE, BLKLEN);
+			Utility::MemUtils::Copy(m_batchLanes, i * BLOCK_SIZE, *pkt.Output, pkt.OutOffset + PKTPOS, BLKLEN);
+		}
+	}
+}
+
+void EAX::BatchMac(std::vector<AeadPacket> &Packets, byte First, byte Last, bool Encryption)
+{
+	const size_t TAGCNT = static_cast<size_t>(Last - First) + 1;
+	const size_t CHNCNT = Packets.size() * TAGCNT;
+	const std::vector<byte>* chnInput = nullptr;
+	size_t chnIdx = 0;
+	size_t chnOffset = 0;
+	size_t lanes = 0;
+
+	// every lane runs one omac chain; a finished chain is replaced by the next
+	while (chnIdx != CHNCNT || lanes != 0)
+	{
+		while (lanes != BATCH_LANES && chnIdx != CHNCNT)
+		{
+			Utility::MemUtils::Clear(m_batchLanes, lanes * BLOCK_SIZE, BLOCK_SIZE);
+			m_batchMap[lanes * 2] = chnIdx;
+			m_batchMap[(lanes * 2) + 1] = 0;
+			++chnIdx;
+			++lanes;
+		}
+
+		// absorb the next block of each chain; the chain input is the tag block followed by the message
+		for (size_t i = 0; i < lanes; ++i)
+		{
+			const byte TAG = static_cast<byte>(First + (m_batchMap[i * 2] % TAGCNT));
+			const size_t CHNLEN = BLOCK_SIZE + MacInput(Packets[m_batchMap[i * 2] / TAGCNT], TAG, Encryption, chnInput, chnOffset);
+			const size_t CHNPOS = m_batchMap[(i * 2) + 1];
+			const size_t BLKLEN = Utility::IntUtils::Min(BLOCK_SIZE, CHNLEN - CHNPOS);
+			const size_t LANOFF = i * BLOCK_SIZE;
+
+			if (CHNPOS == 0)
+				m_batchLanes[LANOFF + BLOCK_SIZE - 1] ^= TAG;
+			else
+				Utility::MemUtils::XorBlock(*chnInput, chnOffset + CHNPOS - BLOCK_SIZE, m_batchLanes, LANOFF, BLKLEN);
+
+			// the final block is masked with one of the subkeys
+			if (CHNPOS + BLKLEN == CHNLEN)
+			{
+				if (BLKLEN == BLOCK_SIZE)
+				{
+					Utility::MemUtils::XOR128(m_batchSubKey, 0, m_batchLanes, LANOFF);
+				}
+				else
+				{
+					m_batchLanes[LANOFF + BLKLEN] ^= 0x80;
+					Utility::MemUtils::XOR128(m_batchSubKey, BLOCK_SIZE, m_batchLanes, LANOFF);
+				}
+			}
+
+			m_batchMap[(i * 2) + 1] = CHNPOS + BLKLEN;
+		}
+
+		TransformLanes(m_cipherMode.Engine(), m_batchLanes, 0, m_batchLanes, 0, lanes);
+
+		// retire the finished chains and compact the lanes
+		size_t laneIdx = 0;
+
+		while (laneIdx != lanes)
+		{
+			const size_t CHNIDX = m_batchMap[laneIdx * 2];
+			const byte TAG = static_cast<byte>(First + (CHNIDX % TAGCNT));
+			const size_t CHNLEN = BLOCK_SIZE + MacInput(Packets[CHNIDX / TAGCNT], TAG, Encryption, chnInput, chnOffset);
+
+			if (m_batchMap[(laneIdx * 2) + 1] != CHNLEN)
+			{
+				++laneIdx;
+				continue;
+			}
+
+			Utility::MemUtils::COPY128(m_batchLanes, laneIdx * BLOCK_SIZE, m_batchMac, (((CHNIDX / TAGCNT) * 3) + TAG) * BLOCK_SIZE);
+			--lanes;
+
+			if (laneIdx != lanes)
+			{
+				Utility::MemUtils::COPY128(m_batchLanes, lanes * BLOCK_SIZE, m_batchLanes, laneIdx * BLOCK_SIZE);
+				m_batchMap[laneIdx * 2] = m_batchMap[lanes * 2];
+				m_batchMap[(laneIdx * 2) + 1] = m_batchMap[(lanes * 2) + 1];
+			}
+		}
+	}
+}
+
+void EAX::BatchScope(const std::vector<AeadPacket> &Packets, const size_t TagLength, const std::string &Origin)
+{
+	if (!m_cipherMode.IsInitialized())
+		throw CryptoCipherModeException(Origin, "The cipher mode has not been keyed!");
+	if (TagLength < MIN_TAGSIZE || TagLength > m_macSize)
+		throw CryptoCipherModeException(Origin, "The length must be minimum of 12 and maximum of MAC code size!");
+
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		const AeadPacket &pkt = Packets[i];
+
+		if (pkt.Nonce == nullptr || pkt.Nonce->size() != BLOCK_SIZE)
+			throw CryptoCipherModeException(Origin, "Each packet requires a nonce equal in size to the ciphers block size!");
+		if (pkt.Tag == nullptr || pkt.Tag->size() < pkt.TagOffset + TagLength)
+			throw CryptoCipherModeException(Origin, "The packet tag array is too small!");
+		if (pkt.Length != 0 && (pkt.Input == nullptr || pkt.Output == nullptr || pkt.Input->size() < pkt.InOffset + pkt.Length || pkt.Output->size() < pkt.OutOffset + pkt.Length))
+			throw CryptoCipherModeException(Origin, "The packet arrays are smaller than the message length!");
+	}
+
+	if (m_batchMac.size() < Packets.size() * 3 * BLOCK_SIZE)
+		m_batchMac.resize(Packets.size() * 3 * BLOCK_SIZE);
+
+	// the omac subkeys K1 and K2
+	Utility::MemUtils::Clear(m_batchLanes, 0, BLOCK_SIZE);
+	m_cipherMode.Engine()->Transform(m_batchLanes, 0, m_batchLanes, 0);
+	DoubleBlock(m_batchLanes, 0, m_batchSubKey, 0);
+	DoubleBlock(m_batchSubKey, 0, m_batchSubKey, BLOCK_SIZE);
+	Utility::MemUtils::Clear(m_batchLanes, 0, BLOCK_SIZE);
+}
+
 void EAX::CalculateMac()
 {
 	m_macGenerator.Finalize(m_msgTag, 0);
@@ -361,6 +623,16 @@ void EAX::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	m_cipherMode.EncryptBlock(Input, InOffset, Output, OutOffset);
 }
 
+void EAX::DoubleBlock(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset)
+{
+	const byte CARRY = static_cast<byte>(0 - (Input[InOffset] >> 7));
+
+	for (size_t i = 0; i < BLOCK_SIZE - 1; ++i)
+		Output[OutOffset + i] = static_cast<byte>((Input[InOffset + i] << 1) | (Input[InOffset + i + 1] >> 7));
+
+	Output[OutOffset + BLOCK_SIZE - 1] = static_cast<byte>((Input[InOffset + BLOCK_SIZE - 1] << 1) ^ (CARRY & 0x87));
+}
+
 void EAX::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
@@ -370,6 +642,33 @@ void EAX::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	m_macGenerator.Update(Input, InOffset, m_blockSize);
 }
 
+size_t EAX::MacInput(const AeadPacket &Packet, byte Tag, bool Encryption, const std::vector<byte>* &Input, size_t &InOffset)
+{
+	size_t inpLen = 0;
+
+	InOffset = 0;
+
+	if (Tag == 0)
+	{
+		Input = Packet.Nonce;
+		inpLen = Packet.Nonce->size();
+	}
+	else if (Tag == 1)
+	{
+		Input = Packet.AssociatedData;
+		inpLen = (Input != nullptr) ? Input->size() : 0;
+	}
+	else
+	{
+		// the cipher-text is the output when sealing, and the input when opening
+		Input = Encryption ? Packet.Output : Packet.Input;
+		InOffset = Encryption ? Packet.OutOffset : Packet.InOffset;
+		inpLen = Packet.Length;
+	}
+
+	return inpLen;
+}
+
 void EAX::Reset()
 {
 	if (!m_aadPreserve)
@@ -399,11 +698,40 @@ void EAX::Scope()
 	}
 }
 
+void EAX::TransformLanes(IBlockCipher* Cipher, const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t BlockCount)
+{
+#if defined(__AVX__)
+	const size_t LANELEN = BATCH_LANES * BLOCK_SIZE;
+
+	while (BlockCount >= BATCH_LANES)
+	{
+#	if defined(__AVX512__)
+		Cipher->Transform2048(Input, InOffset, Output, OutOffset);
+#	elif defined(__AVX2__)
+		Cipher->Transform1024(Input, InOffset, Output, OutOffset);
+#	else
+		Cipher->Transform512(Input, InOffset, Output, OutOffset);
+#	endif
+		InOffset += LANELEN;
+		OutOffset += LANELEN;
+		BlockCount -= BATCH_LANES;
+	}
+#endif
+
+	while (BlockCount != 0)
+	{
+		Cipher->Transform(Input, InOffset, Output, OutOffset);
+		InOffset += BLOCK_SIZE;
+		OutOffset += BLOCK_SIZE;
+		--BlockCount;
+	}
+}
+
 void EAX::UpdateTag(byte Tag, const std::vector<byte> &Nonce)
 {
-	std::vector<byte> tmp(m_macSize);
-	tmp[tmp.size() - 1] = Tag;
-	m_macGenerator.Update(tmp, 0, tmp.size());
+	Utility::MemUtils::Clear(m_tagBuffer, 0, m_tagBuffer.size());
+	m_tagBuffer[m_tagBuffer.size() - 1] = Tag;
+	m_macGenerator.Update(m_tagBuffer, 0, m_tagBuffer.size());
 
 	if (Nonce.size() != 0)
 		m_macGenerator.Update(Nonce, 0, Nonce.size());
@@ -103,6 +103,7 @@ NAMESPACE_MODE
 /// <item><description>ParallelBlockSize() is calculated automatically based on the processor(s) L1 data cache size, this property can be user defined, and must be evenly divisible by ParallelMinimumSize().</description></item>
 /// <item><description>The ParallelBlockSize() can be changed through the ParallelProfile() property</description></item>
 /// <item><description>Parallel block calculation ex. <c>ParallelBlockSize = N - (N % .ParallelMinimumSize);</c></description></item>
+/// <item><description>Many small packets can be processed in one call with the Seal and Open functions; the OMAC chains of different packets run side by side in the ciphers SIMD lanes, and their counter blocks share the same pipeline.</description></item>
 /// </list>
 /// 
 /// <description>Guiding Publications:</description>
@@ -117,6 +118,13 @@ class EAX final : public IAeadMode
 private:
 
 	static const size_t BLOCK_SIZE = 16;
+#if defined(__AVX512__)
+	static const size_t BATCH_LANES = 16;
+#elif defined(__AVX2__)
+	static const size_t BATCH_LANES = 8;
+#else
+	static const size_t BATCH_LANES = 4;
+#endif
 	static const std::string CLASS_NAME;
 	static const size_t MAX_PRLALLOC = 100000000;
 	static const size_t MIN_TAGSIZE = 12;
@@ -126,6 +134,11 @@ private:
 	bool m_aadLoaded;
 	bool m_aadPreserve;
 	bool m_autoIncrement;
+	std::vector<byte> m_batchCounter;
+	std::vector<byte> m_batchLanes;
+	std::vector<byte> m_batchMac;
+	std::vector<size_t> m_batchMap;
+	std::vector<byte> m_batchSubKey;
 	size_t m_blockSize;
 	std::vector<byte> m_cipherKey;
 	BlockCiphers m_cipherType;
@@ -142,6 +155,8 @@ private:
 	size_t m_macSize;
 	std::vector<byte> m_msgTag;
 	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_segmentStage;
+	std::vector<byte> m_tagBuffer;
 
 public:
 
@@ -350,6 +365,22 @@ public:
 	/// <exception cref="CryptoCipherModeException">Thrown if a null or invalid Key/Nonce is used</exception>
 	void Initialize(bool Encryption, ISymmetricKey &KeyParams) override;
 
+	/// <summary>
+	/// Decrypt and authenticate a batch of packets.
+	/// <para>The nonce, associated data, and cipher-text OMAC chains of the packets are computed side by side, and each packets tag is verified before it is decrypted.
+	/// The Verified member of each packet is set to the result of the tag comparison, and the output of a packet that fails authentication is zeroed, unless it overlaps the input; an in-place packet keeps its cipher-text.
+	/// A null AssociatedData member is authenticated as an empty associated data string.
+	/// The cipher must be keyed and initialized for decryption; the nonce loaded by Initialize and any message in progress are not affected.</para>
+	/// </summary>
+	/// 
+	/// <param name="Packets">The packet descriptors; each nonce must be equal in size to the ciphers block size</param>
+	/// <param name="TagLength">The byte length of each packets authentication tag; between 12 and 16 bytes</param>
+	/// 
+	/// <returns>Returns false if any packet fails authentication</returns>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not keyed for decryption, or a packet descriptor is invalid</exception>
+	bool Open(std::vector<AeadPacket> &Packets, const size_t TagLength) override;
+
 	/// <summary>
 	/// Set the maximum number of threads allocated when using multi-threaded processing.
 	/// <para>When set to zero, thread count is set automatically. If set to 1, sets IsParallel() to false and runs in sequential mode. 
@@ -361,6 +392,19 @@ public:
 	/// <exception cref="Exception::CryptoCipherModeException">Thrown if an invalid degree setting is used</exception>
 	void ParallelMaxDegree(size_t Degree) override;
 
+	/// <summary>
+	/// Encrypt and authenticate a batch of packets.
+	/// <para>The OMAC chains of the packets are computed side by side, one chain per SIMD lane, and the counter blocks of consecutive packets are encrypted together.
+	/// The authentication tag of each packet is written to its Tag array. A null AssociatedData member is authenticated as an empty associated data string.
+	/// The cipher must be keyed and initialized for encryption; the nonce loaded by Initialize and any message in progress are not affected.</para>
+	/// </summary>
+	/// 
+	/// <param name="Packets">The packet descriptors; each nonce must be equal in size to the ciphers block size</param>
+	/// <param name="TagLength">The byte length of each packets authentication tag; between 12 and 16 bytes</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not keyed for encryption, or a packet descriptor is invalid</exception>
+	void Seal(std::vector<AeadPacket> &Packets, const size_t TagLength) override;
+
 	/// <summary>
 	/// Add additional data to the authentication generator.  
 	/// <para>Must be called after Initialize(bool, ISymmetricKey), and before any processing of plaintext or ciphertext input. 
@@ -374,6 +418,17 @@ public:
 	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not initialized</exception>
 	void SetAssociatedData(const std::vector<byte> &Input, const size_t Offset, const size_t Length) override;
 
+	/// <summary>
+	/// Add associated data stored as a list of fragments to the message authentication code generator.
+	/// <para>The fragments are joined in a staging buffer owned by this instance, passed to SetAssociatedData(Input, Offset, Length), and erased.
+	/// Must be called after Initialize(bool, ISymmetricKey), and before any processing of plaintext or ciphertext input.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of associated data fragments</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if state has been processed, or a segment exceeds its array</exception>
+	void SetAssociatedSegments(const std::vector<MemorySegment> &Input) override;
+
 	/// <summary>
 	/// Transform a length of bytes with offset parameters. 
 	/// <para>This method processes a specified length of bytes, utilizing offsets incremented by the caller.
@@ -389,6 +444,19 @@ public:
 	/// <param name="Length">The number of bytes to transform</param>
 	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
 
+	/// <summary>
+	/// Transform a message stored as a list of fragments, writing the result to a second list of fragments.
+	/// <para>The two lists are processed as single contiguous messages, and may be fragmented differently.
+	/// Runs that are contiguous in both lists are passed to Transform directly; the short runs between fragment boundaries are gathered in a staging buffer owned by this instance, which is erased after each call.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of input fragments</param>
+	/// <param name="Output">The list of output fragments; the combined length must equal that of the input list</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the lists differ in length, or a segment exceeds its array</exception>
+	void TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output) override;
+
 	/// <summary>
 	/// Generate the internal MAC code and compare it with the tag contained in the Input array.   
 	/// <para>This function finalizes the Decryption cycle and generates the MAC tag.
@@ -409,11 +477,17 @@ public:
 
 private:
 
+	void BatchKeyStream(std::vector<AeadPacket> &Packets, bool Encryption);
+	void BatchMac(std::vector<AeadPacket> &Packets, byte First, byte Last, bool Encryption);
+	void BatchScope(const std::vector<AeadPacket> &Packets, const size_t TagLength, const std::string &Origin);
 	void CalculateMac();
 	void Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
+	static void DoubleBlock(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset);
 	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
+	static size_t MacInput(const AeadPacket &Packet, byte Tag, bool Encryption, const std::vector<byte>* &Input, size_t &InOffset);
 	void Reset();
 	void Scope();
+	static void TransformLanes(IBlockCipher* Cipher, const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t BlockCount);
 	void UpdateTag(byte Tag, const std::vector<byte> &Nonce);
 };
 
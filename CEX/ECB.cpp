@@ -3,6 +3,7 @@
 #include "IntUtils.h"
 #include "MemUtils.h"
 #include "ParallelUtils.h"
+#include "SegmentUtils.h"
 
 NAMESPACE_MODE
 
@@ -76,7 +77,8 @@ ECB::ECB(BlockCiphers CipherType)
 	m_isEncryption(false),
 	m_isInitialized(false),
 	m_isLoaded(false),
-	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
+	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0)
 {
 }
 
@@ -89,7 +91,8 @@ ECB::ECB(IBlockCipher* Cipher)
 	m_isEncryption(false),
 	m_isInitialized(false),
 	m_isLoaded(false),
-	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
+	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0)
 {
 }
 
@@ -128,6 +131,8 @@ void ECB::Destroy()
 			if (m_blockCipher != 0)
 				delete m_blockCipher;
 		}
+
+		Utility::IntUtils::ClearVector(m_segmentStage);
 	}
 }
 
@@ -143,7 +148,7 @@ void ECB::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void ECB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.KeySizes().KeySize()))
 		throw CryptoSymmetricCipherException("ECB:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 	if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || m_parallelProfile.ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
 		throw CryptoSymmetricCipherException("ECB:Initialize", "The parallel block size is out of bounds!");
@@ -195,6 +200,11 @@ void ECB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 	}
 }
 
+void ECB::TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output)
+{
+	Utility::SegmentUtils::Transform(this, Input, Output, m_segmentStage);
+}
+
 //~~~Private Functions~~~//
 
 void ECB::Encrypt128(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset)
@@ -4,7 +4,11 @@
 #include "IntUtils.h"
 #include "McElieceUtils.h"
 #include "MemUtils.h"
+#include "ParallelUtils.h"
 #include "SymmetricKey.h"
+#if defined(__AVX2__)
+#	include "ULong256.h"
+#endif
 
 NAMESPACE_MCELIECE
 
@@ -12,6 +16,10 @@ using Cipher::Symmetric::Block::Mode::IAeadMode;
 using Digest::IDigest;
 using Utility::IntUtils;
 using Utility::MemUtils;
+using Utility::ParallelUtils;
+#if defined(__AVX2__)
+using Numeric::ULong256;
+#endif
 
 const ulong FFTM12T62::ButterflyConsts[63][12] =
 {
@@ -335,6 +343,13 @@ const ulong FFTM12T62::ButterflyConsts[63][12] =
 //~~~Public Functions~~~//
 
 bool FFTM12T62::Decrypt(std::vector<byte> &E, const std::vector<byte> &PrivateKey, const std::vector<byte> &S)
+{
+	CexAssert(PrivateKey.size() >= PRIKEY_SIZE, "The private key is too small");
+
+	return Decrypt(E, PrivateKey.data(), S);
+}
+
+bool FFTM12T62::Decrypt(std::vector<byte> &E, const byte* PrivateKey, const std::vector<byte> &S)
 {
 	size_t i;
 	ulong diff;
@@ -342,7 +357,11 @@ bool FFTM12T62::Decrypt(std::vector<byte> &E, const std::vector<byte> &PrivateKe
 
 	std::array<ulong, CND_SIZE / 8> cond;
 
-	IntUtils::BlockToLe(PrivateKey, IRR_SIZE, cond, 0, CND_SIZE);
+	for (i = 0; i < cond.size(); ++i)
+	{
+		cond[i] = LoadLe64(PrivateKey + IRR_SIZE + (i * sizeof(ulong)));
+	}
+
 	std::vector<ulong> recv(64);
 	PreProcess(recv, S);
 	McElieceUtils::BenesCompact(recv, cond, 1);
@@ -421,11 +440,35 @@ bool FFTM12T62::Decrypt(std::vector<byte> &E, const std::vector<byte> &PrivateKe
 }
 
 void FFTM12T62::Encrypt(std::vector<byte> &S, std::vector<byte> &E, const std::vector<byte> &PublicKey, std::unique_ptr<IPrng> &Random)
+{
+	CexAssert(PublicKey.size() >= PUBKEY_SIZE, "The public key is too small");
+
+	Encrypt(S, E, PublicKey.data(), Random);
+}
+
+void FFTM12T62::Encrypt(std::vector<byte> &S, std::vector<byte> &E, const byte* PublicKey, std::unique_ptr<IPrng> &Random)
 {
 	GenE(E, Random);
 	Syndrome(S, PublicKey, E);
 }
 
+void FFTM12T62::Encrypt(std::vector<std::vector<byte>> &S, std::vector<std::vector<byte>> &E, const byte* PublicKey, std::unique_ptr<IPrng> &Random, bool Parallel)
+{
+	CexAssert(S.size() == E.size(), "The syndrome and error vector counts are not equal");
+
+	size_t i;
+
+	for (i = 0; i < E.size(); ++i)
+	{
+		GenE(E[i], Random);
+	}
+
+	for (i = 0; i < E.size(); i += BATCH_SIZE)
+	{
+		SyndromeBatch(S, PublicKey, E, i, IntUtils::Min(BATCH_SIZE, E.size() - i), Parallel);
+	}
+}
+
 bool FFTM12T62::Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, std::unique_ptr<IPrng> &Random)
 {
 	size_t ctr;
@@ -581,15 +624,19 @@ void FFTM12T62::PreProcess(std::vector<ulong> &Received, const std::vector<byte>
 	Received[SECRET_SIZE / 8] |= S[((SECRET_SIZE / 8) * 8)];
 }
 
-void FFTM12T62::Scaling(std::array<std::array<ulong, M>, 64> &Output, std::array<std::array<ulong, M>, 64> &Inverse, const std::vector<byte> &PrivateKey, std::vector<ulong> &Received)
+void FFTM12T62::Scaling(std::array<std::array<ulong, M>, 64> &Output, std::array<std::array<ulong, M>, 64> &Inverse, const byte* PrivateKey, std::vector<ulong> &Received)
 {
 	int i;
 	std::array<ulong, M> skInt;
 	std::array<std::array<ulong, M>, 64> eval;
 	std::array<ulong, M> tmp;
 
+	for (i = 0; i < static_cast<int>(M); i++)
+	{
+		skInt[i] = LoadLe64(PrivateKey + (i * sizeof(ulong)));
+	}
+
 	// computing inverses
-	MemUtils::Copy(PrivateKey, 0, skInt, 0, M * sizeof(ulong));
 	AdditiveFFT::Transform(eval, skInt);
 	Square(eval[0], eval[0]);
 	McElieceUtils::Copy(eval[0], Inverse[0]);
@@ -734,49 +781,225 @@ void FFTM12T62::GenE(std::vector<byte> &E, std::unique_ptr<IPrng> &Random)
 	IntUtils::LeToBlock(eInt, 0, E, 0, eInt.size() * sizeof(ulong));
 }
 
-void FFTM12T62::Syndrome(std::vector<byte> &S, const std::vector<byte> &PublicKey, const std::vector<byte> &E)
+void FFTM12T62::Syndrome(std::vector<byte> &S, const byte* PublicKey, const std::vector<byte> &E)
 {
 	const size_t ARRSZE = ((PKN_COLS + 63) / 64); // TODO: intrinsics
 	const size_t COLSZE = PKN_COLS / 8;
+	const size_t TALSZE = COLSZE - ((ARRSZE - 1) * sizeof(ulong));
 
 	std::array<ulong, ARRSZE> eInt;
+	eInt[ARRSZE - 1] = 0;
 	MemUtils::Copy(E, SECRET_SIZE, eInt, 0, COLSZE);
-	std::array<ulong, ARRSZE> rowInt;
 	std::array<ulong, 8> tmp;
+	const byte* row;
+	ulong rowTail;
 	int t;
-	byte b;
 
 	for (size_t i = 0; i < PKN_ROWS; i += 8)
 	{
 		for (t = 0; t < 8; t++) 
 		{
-			rowInt[ARRSZE - 1] = 0;
-			MemUtils::Copy(PublicKey, ((i + t) * COLSZE), rowInt, 0, COLSZE);
+			// the rows are read in place, the key may be a read-only mapped view
+			row = PublicKey + ((i + t) * COLSZE);
 			tmp[t] = 0;
 
-			for (size_t j = 0; j < ARRSZE; j++)
+			for (size_t j = 0; j < ARRSZE - 1; j++)
+			{
+				tmp[t] ^= eInt[j] & LoadLe64(row + (j * sizeof(ulong)));
+			}
+
+			rowTail = 0;
+
+			for (size_t j = 0; j < TALSZE; j++)
 			{
-				tmp[t] ^= eInt[j] & rowInt[j];
+				rowTail |= static_cast<ulong>(row[((ARRSZE - 1) * sizeof(ulong)) + j]) << (j * 8);
 			}
+
+			tmp[t] ^= eInt[ARRSZE - 1] & rowTail;
 		}
 
-		b = 0;
+		S[i / 8] = E[i / 8] ^ Parity(tmp);
+	}
+}
+
+void FFTM12T62::SyndromeBatch(std::vector<std::vector<byte>> &S, const byte* PublicKey, const std::vector<std::vector<byte>> &E, size_t Offset, size_t Length, bool Parallel)
+{
+	const size_t ARRSZE = ((PKN_COLS + 63) / 64);
+	const size_t COLSZE = PKN_COLS / 8;
+	const size_t PLNSZE = BATCH_SIZE / 64;
+	const size_t ROWBLK = (PKN_ROWS + 63) / 64;
 
-		for (t = 7; t >= 0; t--)
+	// the batch is transposed to bit-planes; plane c holds bit c of every error vector, one message per bit lane,
+	// so the product with a key row is the xor of the planes selected by the row, and every lane is a separate syndrome bit
+	std::vector<ulong> ePln(ARRSZE * 64 * PLNSZE, 0);
+	std::array<ulong, 64> blk;
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t w;
+
+	for (w = 0; w * 64 < Length; ++w)
+	{
+		for (k = 0; k < ARRSZE; ++k)
 		{
-			tmp[t] ^= (tmp[t] >> 32);
-			tmp[t] ^= (tmp[t] >> 16);
-			tmp[t] ^= (tmp[t] >> 8);
-			tmp[t] ^= (tmp[t] >> 4);
+			const size_t WRDLEN = IntUtils::Min(sizeof(ulong), COLSZE - (k * sizeof(ulong)));
+
+			for (i = 0; i < 64; ++i)
+			{
+				blk[i] = 0;
+
+				if ((w * 64) + i < Length)
+				{
+					const byte* ePtr = E[Offset + (w * 64) + i].data() + SECRET_SIZE + (k * sizeof(ulong));
+
+					for (j = 0; j < WRDLEN; ++j)
+					{
+						blk[i] |= static_cast<ulong>(ePtr[j]) << (j * 8);
+					}
+				}
+			}
+
+			McElieceUtils::TransposeCompact64x64(blk);
+
+			for (j = 0; j < 64; ++j)
+			{
+				ePln[(((k * 64) + j) * PLNSZE) + w] = blk[j];
+			}
 		}
+	}
+
+	std::vector<ulong> sPln(PKN_ROWS * PLNSZE, 0);
+	size_t thdCount = Parallel ? IntUtils::Min(ParallelUtils::ProcessorCount(), ARRSZE) : 1;
+
+	if (thdCount > 1)
+	{
+		const size_t CNKCNT = (ARRSZE + thdCount - 1) / thdCount;
+		thdCount = (ARRSZE + CNKCNT - 1) / CNKCNT;
+		std::vector<std::vector<ulong>> thdPln(thdCount);
 
-		for (t = 7; t >= 0; t--)
+		// each thread multiplies a contiguous range of key columns into its own accumulator, and the partial products are added
+		ParallelUtils::ParallelFor(0, thdCount, [PublicKey, &ePln, &thdPln, CNKCNT, ARRSZE, PLNSZE](size_t i)
 		{
-			b <<= 1;
-			b |= (0x6996 >> (tmp[t] & 0xF)) & 1;
+			thdPln[i].resize(PKN_ROWS * PLNSZE, 0);
+			SyndromeBlock(thdPln[i], PublicKey, ePln, i * CNKCNT, IntUtils::Min((i + 1) * CNKCNT, ARRSZE));
+		});
+
+		for (i = 0; i < thdCount; ++i)
+		{
+			for (j = 0; j < sPln.size(); ++j)
+			{
+				sPln[j] ^= thdPln[i][j];
+			}
 		}
+	}
+	else
+	{
+		SyndromeBlock(sPln, PublicKey, ePln, 0, ARRSZE);
+	}
+
+	// the syndrome planes are transposed back, 64 rows at a time, and added to the identity part of each error vector
+	for (w = 0; w * 64 < Length; ++w)
+	{
+		for (k = 0; k < ROWBLK; ++k)
+		{
+			const size_t ROWCNT = IntUtils::Min(static_cast<size_t>(64), PKN_ROWS - (k * 64));
 
-		S[i / 8] = E[i / 8] ^ b;
+			for (i = 0; i < 64; ++i)
+			{
+				blk[i] = (i < ROWCNT) ? sPln[(((k * 64) + i) * PLNSZE) + w] : 0;
+			}
+
+			McElieceUtils::TransposeCompact64x64(blk);
+
+			for (i = 0; i < 64 && (w * 64) + i < Length; ++i)
+			{
+				const size_t MSGIDX = Offset + (w * 64) + i;
+
+				for (j = 0; j < ROWCNT / 8; ++j)
+				{
+					S[MSGIDX][(k * 8) + j] = E[MSGIDX][(k * 8) + j] ^ static_cast<byte>(blk[i] >> (j * 8));
+				}
+			}
+		}
+	}
+}
+
+void FFTM12T62::SyndromeBlock(std::vector<ulong> &Output, const byte* PublicKey, const std::vector<ulong> &EPlanes, size_t From, size_t To)
+{
+	const size_t COLSZE = PKN_COLS / 8;
+	const size_t PLNSZE = BATCH_SIZE / 64;
+	const size_t TBLSZE = 256 * PLNSZE;
+
+	// a table holds the 256 sums of the 8 planes under one byte column of the key; the 8 tables of a key word fit in the L2 cache,
+	// and the tables are indexed by the public key bytes, so the access pattern does not depend on the error vectors
+	std::vector<ulong> tbl(8 * TBLSZE);
+	const byte* row;
+	size_t b;
+	size_t g;
+	size_t i;
+	size_t k;
+	size_t r;
+	size_t w;
+
+	for (k = From; k < To; ++k)
+	{
+		const size_t GRPCNT = IntUtils::Min(sizeof(ulong), COLSZE - (k * sizeof(ulong)));
+
+		for (g = 0; g < GRPCNT; ++g)
+		{
+			const size_t TBLOFF = g * TBLSZE;
+			const size_t PLNOFF = ((k * 64) + (g * 8)) * PLNSZE;
+
+			for (w = 0; w < PLNSZE; ++w)
+			{
+				tbl[TBLOFF + w] = 0;
+			}
+
+			// the table is doubled by each plane, the upper half is the lower half plus the plane
+			for (b = 0; b < 8; ++b)
+			{
+				const size_t HLFLEN = static_cast<size_t>(1) << b;
+
+				for (i = 0; i < HLFLEN; ++i)
+				{
+					for (w = 0; w < PLNSZE; ++w)
+					{
+						tbl[TBLOFF + ((HLFLEN + i) * PLNSZE) + w] = tbl[TBLOFF + (i * PLNSZE) + w] ^ EPlanes[PLNOFF + (b * PLNSZE) + w];
+					}
+				}
+			}
+		}
+
+		for (r = 0; r < PKN_ROWS; ++r)
+		{
+			// the rows are read in place, the key may be a read-only mapped view
+			row = PublicKey + (r * COLSZE) + (k * sizeof(ulong));
+
+#if defined(__AVX2__)
+			ULong256 acc;
+			ULong256 tv;
+
+			acc.Load(Output, r * PLNSZE);
+
+			for (g = 0; g < GRPCNT; ++g)
+			{
+				tv.Load(tbl, (g * TBLSZE) + (row[g] * PLNSZE));
+				acc ^= tv;
+			}
+
+			acc.Store(Output, r * PLNSZE);
+#else
+			for (g = 0; g < GRPCNT; ++g)
+			{
+				const size_t TBLOFF = (g * TBLSZE) + (row[g] * PLNSZE);
+
+				for (w = 0; w < PLNSZE; ++w)
+				{
+					Output[(r * PLNSZE) + w] ^= tbl[TBLOFF + w];
+				}
+			}
+#endif
+		}
 	}
 }
 
@@ -1436,38 +1659,88 @@ void FFTM12T62::AdditiveFFT::Butterflies(std::array<std::array<ulong, M>, 64> &O
 	std::array<ulong, M> tmp;
 
 	// butterflies
-	for (i = 0; i <= 5; i++)
+	for (i = 0; i < SEQ_STAGES; i++)
 	{
 		s = (size_t)1 << i;
 
-		// butterflies
-		for (i = 0; i <= 5; i++)
+		for (j = 0; j < 64; j += 2 * s)
 		{
-			s = (size_t)1 << i;
-
-			for (j = 0; j < 64; j += 2 * s)
+			for (k = j; k < j + s; k++)
 			{
-				for (k = j; k < j + s; k++)
+				McElieceUtils::Multiply(tmp, Output[k + s], ButterflyConsts[constsPos + (k - j)]);
+				// memory tiling
+				for (b = 0; b < M; b++)
 				{
-					McElieceUtils::Multiply(tmp, Output[k + s], ButterflyConsts[constsPos + (k - j)]);
-					// memory tiling
-					for (b = 0; b < M; b++)
-					{
-						Output[k][b] ^= tmp[b];
-					}
-					for (b = 0; b < M; b++)
-					{
-						Output[k + s][b] ^= Output[k][b];
-					}
+					Output[k][b] ^= tmp[b];
+				}
+				for (b = 0; b < M; b++)
+				{
+					Output[k + s][b] ^= Output[k][b];
 				}
 			}
+		}
+
+		constsPos += s;
+	}
+
+#if defined(__AVX2__)
+	Butterflies256(Output, constsPos);
+#endif
+}
+
+#if defined(__AVX2__)
+void FFTM12T62::AdditiveFFT::Butterflies256(std::array<std::array<ulong, M>, 64> &Output, size_t ConstsPos)
+{
+	std::array<std::array<ulong, 64>, M> planes;
+	std::array<ULong256, M> cnst;
+	std::array<ULong256, M> hi;
+	std::array<ULong256, M> lo;
+	std::array<ULong256, M> tmp;
+	size_t b;
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t p;
+	size_t s;
+
+	// each vector holds one bit of 4 adjacent elements, so a multiply evaluates 256 field elements
+	ToPlanes(planes, Output);
+
+	for (i = SEQ_STAGES; i <= 5; i++)
+	{
+		s = (size_t)1 << i;
+
+		for (j = 0; j < 64; j += 2 * s)
+		{
+			for (k = j; k < j + s; k += 4)
+			{
+				p = ConstsPos + (k - j);
+
+				for (b = 0; b < M; b++)
+				{
+					cnst[b] = ULong256(ButterflyConsts[p + 3][b], ButterflyConsts[p + 2][b], ButterflyConsts[p + 1][b], ButterflyConsts[p][b]);
+					hi[b].Load(planes[b], k + s);
+					lo[b].Load(planes[b], k);
+				}
 
-			constsPos += ((size_t)1 << i);
+				McElieceUtils::Multiply(tmp, hi, cnst);
+
+				for (b = 0; b < M; b++)
+				{
+					lo[b] ^= tmp[b];
+					hi[b] ^= lo[b];
+					lo[b].Store(planes[b], k);
+					hi[b].Store(planes[b], k + s);
+				}
+			}
 		}
 
-		constsPos += ((size_t)1 << i);
+		ConstsPos += s;
 	}
+
+	FromPlanes(Output, planes);
 }
+#endif
 
 void FFTM12T62::AdditiveFFT::RadixConversions(std::array<ulong, M> &Output)
 {
@@ -1542,11 +1815,15 @@ void FFTM12T62::TransposedFFT::Butterflies(std::array<std::array<ulong, M>, 2> &
 	size_t j;
 	size_t k;
 	size_t s;
-	ulong constsPos = 63;
+	ulong constsPos = ((size_t)1 << SEQ_STAGES) - 1;
 	std::array<ulong, M> tmp;
 
+#if defined(__AVX2__)
+	Butterflies256(Input);
+#endif
+
 	// butterflies
-	i = 6;
+	i = SEQ_STAGES;
 	while (i-- != 0)
 	{
 		s = (size_t)1 << i;
@@ -1747,6 +2024,60 @@ void FFTM12T62::TransposedFFT::Butterflies(std::array<std::array<ulong, M>, 2> &
 	}
 }
 
+#if defined(__AVX2__)
+void FFTM12T62::TransposedFFT::Butterflies256(std::array<std::array<ulong, M>, 64> &Input)
+{
+	std::array<std::array<ulong, 64>, M> planes;
+	std::array<ULong256, M> cnst;
+	std::array<ULong256, M> hi;
+	std::array<ULong256, M> lo;
+	std::array<ULong256, M> tmp;
+	size_t b;
+	size_t i;
+	size_t j;
+	size_t k;
+	size_t p;
+	size_t s;
+	size_t constsPos = 63;
+
+	ToPlanes(planes, Input);
+
+	// the widest stages, in reverse order of the additive transform
+	for (i = 5; i >= SEQ_STAGES; i--)
+	{
+		s = (size_t)1 << i;
+		constsPos -= s;
+
+		for (j = 0; j < 64; j += 2 * s)
+		{
+			for (k = j; k < j + s; k += 4)
+			{
+				p = constsPos + (k - j);
+
+				for (b = 0; b < M; b++)
+				{
+					cnst[b] = ULong256(ButterflyConsts[p + 3][b], ButterflyConsts[p + 2][b], ButterflyConsts[p + 1][b], ButterflyConsts[p][b]);
+					hi[b].Load(planes[b], k + s);
+					lo[b].Load(planes[b], k);
+					lo[b] ^= hi[b];
+				}
+
+				McElieceUtils::Multiply(tmp, lo, cnst);
+
+				for (b = 0; b < M; b++)
+				{
+					hi[b] ^= tmp[b];
+					lo[b].Store(planes[b], k);
+					hi[b].Store(planes[b], k + s);
+				}
+			}
+		}
+	}
+
+	FromPlanes(Input, planes);
+}
+#endif
+
 void FFTM12T62::TransposedFFT::RadixConversions(std::array<std::array<ulong, M>, 2> &Output)
 {
 	size_t i;
@@ -1857,6 +2188,19 @@ void FFTM12T62::TransposedFFT::RadixConversions(std::array<std::array<ulong, M>,
 
 //~~~Utils~~~//
 
+#if defined(__AVX2__)
+void FFTM12T62::FromPlanes(std::array<std::array<ulong, M>, 64> &Output, const std::array<std::array<ulong, 64>, M> &Input)
+{
+	for (size_t i = 0; i < 64; i++)
+	{
+		for (size_t j = 0; j < M; j++)
+		{
+			Output[i][j] = Input[j][i];
+		}
+	}
+}
+#endif
+
 void FFTM12T62::Invert(std::array<ulong, M> &Output, const std::array<ulong, M> &Input)
 {
 	std::array<ulong, M> tmpA;
@@ -1881,6 +2225,26 @@ void FFTM12T62::Invert(std::array<ulong, M> &Output, const std::array<ulong, M>
 	Square(Output, Output);
 }
 
+ulong FFTM12T62::LoadLe64(const byte* Input)
+{
+#if defined(IS_LITTLE_ENDIAN)
+	ulong value;
+	std::memcpy(&value, Input, sizeof(ulong));
+
+	return value;
+#else
+	return
+		((ulong)Input[0]) |
+		((ulong)Input[1] << 8) |
+		((ulong)Input[2] << 16) |
+		((ulong)Input[3] << 24) |
+		((ulong)Input[4] << 32) |
+		((ulong)Input[5] << 40) |
+		((ulong)Input[6] << 48) |
+		((ulong)Input[7] << 56);
+#endif
+}
+
 void FFTM12T62::MatrixMultiply(std::array<ushort, T> &Output, std::array<ushort, T> &A, std::vector<ushort> &B)
 {
 	size_t i;
@@ -1909,6 +2273,30 @@ void FFTM12T62::MatrixMultiply(std::array<ushort, T> &Output, std::array<ushort,
 	}
 }
 
+byte FFTM12T62::Parity(std::array<ulong, 8> &Input)
+{
+	int t;
+	byte b;
+
+	b = 0;
+
+	for (t = 7; t >= 0; t--)
+	{
+		Input[t] ^= (Input[t] >> 32);
+		Input[t] ^= (Input[t] >> 16);
+		Input[t] ^= (Input[t] >> 8);
+		Input[t] ^= (Input[t] >> 4);
+	}
+
+	for (t = 7; t >= 0; t--)
+	{
+		b <<= 1;
+		b |= (0x6996 >> (Input[t] & 0xF)) & 1;
+	}
+
+	return b;
+}
+
 void FFTM12T62::Square(std::array<ulong, M> &Output, std::array<ulong, M> &Input)
 {
 	std::array<ulong, M> sum;
@@ -1929,4 +2317,17 @@ void FFTM12T62::Square(std::array<ulong, M> &Output, std::array<ulong, M> &Input
 	MemUtils::Copy(sum, 0, Output, 0, M * sizeof(ulong));
 }
 
+#if defined(__AVX2__)
+void FFTM12T62::ToPlanes(std::array<std::array<ulong, 64>, M> &Output, const std::array<std::array<ulong, M>, 64> &Input)
+{
+	for (size_t i = 0; i < 64; i++)
+	{
+		for (size_t j = 0; j < M; j++)
+		{
+			Output[j][i] = Input[i][j];
+		}
+	}
+}
+#endif
+
 NAMESPACE_MCELIECEEND
\ No newline at end of file
@@ -53,6 +53,14 @@ private:
 	static const size_t IRR_SIZE = (M * 8);
 	static const size_t CND_SIZE = ((PKN_ROWS - 8) * 8);
 	static const size_t GEN_MAXR = 10000;
+	// the number of error vectors multiplied against each pass over the public key, one per bit lane of a 256 bit plane
+	static const size_t BATCH_SIZE = 256;
+#if defined(__AVX2__)
+	// the butterfly stages that pair elements closer than a 4 lane vector are processed sequentially
+	static const size_t SEQ_STAGES = 2;
+#else
+	static const size_t SEQ_STAGES = 6;
+#endif
 
 public:
 
@@ -62,8 +70,14 @@ public:
 
 	static bool Decrypt(std::vector<byte> &E, const std::vector<byte> &PrivateKey, const std::vector<byte> &S);
 
+	static bool Decrypt(std::vector<byte> &E, const byte* PrivateKey, const std::vector<byte> &S);
+
 	static void Encrypt(std::vector<byte> &S, std::vector<byte> &E, const std::vector<byte> &PublicKey, std::unique_ptr<IPrng> &Random);
 
+	static void Encrypt(std::vector<byte> &S, std::vector<byte> &E, const byte* PublicKey, std::unique_ptr<IPrng> &Random);
+
+	static void Encrypt(std::vector<std::vector<byte>> &S, std::vector<std::vector<byte>> &E, const byte* PublicKey, std::unique_ptr<IPrng> &Random, bool Parallel);
+
 	static bool Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, std::unique_ptr<IPrng> &Random);
 
 private:
@@ -74,7 +88,7 @@ private:
 
 	static void PreProcess(std::vector<ulong> &Received, const std::vector<byte> &S);
 
-	static void Scaling(std::array<std::array<ulong, M>, 64> &Output, std::array<std::array<ulong, M>, 64> &Inverse, const std::vector<byte> &PrivateKey, std::vector<ulong> &Received);
+	static void Scaling(std::array<std::array<ulong, M>, 64> &Output, std::array<std::array<ulong, M>, 64> &Inverse, const byte* PrivateKey, std::vector<ulong> &Received);
 
 	static void ScalingInverse(std::array<std::array<ulong, M>, 64> &Output, std::array<std::array<ulong, M>, 64> &Inverse, std::array<ulong, 64> &Received);
 
@@ -84,7 +98,11 @@ private:
 
 	static void GenE(std::vector<byte> &E, std::unique_ptr<IPrng> &Random);
 
-	static void Syndrome(std::vector<byte> &S, const std::vector<byte> &PublicKey, const std::vector<byte> &E);
+	static void Syndrome(std::vector<byte> &S, const byte* PublicKey, const std::vector<byte> &E);
+
+	static void SyndromeBatch(std::vector<std::vector<byte>> &S, const byte* PublicKey, const std::vector<std::vector<byte>> &E, size_t Offset, size_t Length, bool Parallel);
+
+	static void SyndromeBlock(std::vector<ulong> &Output, const byte* PublicKey, const std::vector<ulong> &EPlanes, size_t From, size_t To);
 
 	//~~~KeyGen~~~//
 
@@ -96,10 +114,20 @@ private:
 
 	//~~~Utils~~~//
 
+#if defined(__AVX2__)
+	static void ToPlanes(std::array<std::array<ulong, 64>, M> &Output, const std::array<std::array<ulong, M>, 64> &Input);
+
+	static void FromPlanes(std::array<std::array<ulong, M>, 64> &Output, const std::array<std::array<ulong, 64>, M> &Input);
+#endif
+
 	static void Invert(std::array<ulong, M> &Output, const std::array<ulong, M> &Input);
 
+	static ulong LoadLe64(const byte* Input);
+
 	static void MatrixMultiply(std::array<ushort, T> &Output, std::array<ushort, T> &A, std::vector<ushort> &B);
 
+	static byte Parity(std::array<ulong, 8> &Input);
+
 	static void Square(std::array<ulong, M> &Output, std::array<ulong, M> &Input);
 
 	//~~~FFT~~~//
@@ -114,6 +142,10 @@ private:
 
 		static void Butterflies(std::array<std::array<ulong, M>, 64> &Output, std::array<ulong, M> &Input);
 
+#if defined(__AVX2__)
+		static void Butterflies256(std::array<std::array<ulong, M>, 64> &Output, size_t ConstsPos);
+#endif
+
 		static void RadixConversions(std::array<ulong, M> &Output);
 	};
 
@@ -127,6 +159,10 @@ private:
 
 		static void Butterflies(std::array<std::array<ulong, M>, 2> &Output, std::array<std::array<ulong, M>, 64> &Input);
 
+#if defined(__AVX2__)
+		static void Butterflies256(std::array<std::array<ulong, M>, 64> &Input);
+#endif
+
 		static void RadixConversions(std::array<std::array<ulong, M>, 2> &Output);
 	};
 };
@@ -1,6 +1,7 @@
 #include "GCM.h"
 #include "IntUtils.h"
 #include "MemUtils.h"
+#include "SegmentUtils.h"
 #include "SymmetricKey.h"
 
 NAMESPACE_MODE
@@ -101,6 +102,13 @@ GCM::GCM(BlockCiphers CipherType)
 	m_aadPreserve(false),
 	m_aadSize(0),
 	m_autoIncrement(false),
+	m_batchCounter(BLOCK_SIZE),
+	m_batchLanes(BATCH_LANES * BLOCK_SIZE),
+	m_batchMap(BATCH_LANES * 2),
+	m_batchMask(0),
+	m_batchNonce(0),
+	m_batchState(BLOCK_SIZE),
+	m_batchSum(BLOCK_SIZE),
 	m_checkSum(BLOCK_SIZE),
 	m_cipherMode(CipherType),
 	m_cipherType(CipherType),
@@ -116,7 +124,8 @@ GCM::GCM(BlockCiphers CipherType)
 	m_msgSize(0),
 	m_msgTag(BLOCK_SIZE),
 	m_parallelProfile(BLOCK_SIZE, m_cipherMode.ParallelProfile().IsParallel(), m_cipherMode.ParallelProfile().ParallelBlockSize(),
-		m_cipherMode.ParallelProfile().ParallelMaxDegree(), true, m_cipherMode.Engine()->StateCacheSize(), true)
+		m_cipherMode.ParallelProfile().ParallelMaxDegree(), true, m_cipherMode.Engine()->StateCacheSize(), true),
+	m_segmentStage(0)
 {
 	Scope();
 }
@@ -128,6 +137,13 @@ GCM::GCM(IBlockCipher* Cipher)
 	m_aadPreserve(false),
 	m_aadSize(0),
 	m_autoIncrement(false),
+	m_batchCounter(BLOCK_SIZE),
+	m_batchLanes(BATCH_LANES * BLOCK_SIZE),
+	m_batchMap(BATCH_LANES * 2),
+	m_batchMask(0),
+	m_batchNonce(0),
+	m_batchState(BLOCK_SIZE),
+	m_batchSum(BLOCK_SIZE),
 	m_checkSum(BLOCK_SIZE),
 	m_cipherMode(Cipher != 0 ? Cipher : throw CryptoCipherModeException("GCM:CTor", "The Cipher can not be null!")),
 	m_cipherType(Cipher->Enumeral()),
@@ -143,7 +159,8 @@ GCM::GCM(IBlockCipher* Cipher)
 	m_msgSize(0),
 	m_msgTag(BLOCK_SIZE),
 	m_parallelProfile(BLOCK_SIZE, m_cipherMode.ParallelProfile().IsParallel(), m_cipherMode.ParallelProfile().ParallelBlockSize(),
-		m_cipherMode.ParallelProfile().ParallelMaxDegree(), true, m_cipherMode.Engine()->StateCacheSize(), true)
+		m_cipherMode.ParallelProfile().ParallelMaxDegree(), true, m_cipherMode.Engine()->StateCacheSize(), true),
+	m_segmentStage(0)
 {
 	Scope();
 }
@@ -185,11 +202,19 @@ void GCM::Destroy()
 			m_gcmHash->Reset();
 
 		Utility::IntUtils::ClearVector(m_aadData);
+		Utility::IntUtils::ClearVector(m_batchCounter);
+		Utility::IntUtils::ClearVector(m_batchLanes);
+		Utility::IntUtils::ClearVector(m_batchMap);
+		Utility::IntUtils::ClearVector(m_batchMask);
+		Utility::IntUtils::ClearVector(m_batchNonce);
+		Utility::IntUtils::ClearVector(m_batchState);
+		Utility::IntUtils::ClearVector(m_batchSum);
 		Utility::IntUtils::ClearVector(m_gcmNonce);
 		Utility::IntUtils::ClearVector(m_gcmVector);
 		Utility::IntUtils::ClearVector(m_legalKeySizes);
 		Utility::IntUtils::ClearVector(m_msgTag);
 		Utility::IntUtils::ClearVector(m_checkSum);
+		Utility::IntUtils::ClearVector(m_segmentStage);
 
 		if (m_destroyEngine)
 		{
@@ -224,45 +249,46 @@ void GCM::Finalize(std::vector<byte> &Output, const size_t Offset, const size_t
 
 void GCM::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
+	SymmetricKeyView keyView(KeyParams);
+
 	Scope();
 
-	if (KeyParams.Nonce().size() < 8)
+	if (keyView.Nonce().size() < 8)
 		throw CryptoSymmetricCipherException("GCM:Initialize", "Requires a nonce of minimum 10 bytes in length!");
 	if (IsParallel() && ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
 		throw CryptoSymmetricCipherException("GCM:Initialize", "The parallel block size is out of bounds!");
 	if (IsParallel() && ParallelBlockSize() % m_parallelProfile.ParallelMinimumSize() != 0)
 		throw CryptoSymmetricCipherException("GCM:Initialize", "The parallel block size must be evenly aligned to the ParallelMinimumSize!");
 
-	if (KeyParams.Key().size() == 0)
+	if (keyView.Key().size() == 0)
 	{
-		if (KeyParams.Nonce() == m_gcmNonce)
+		if (keyView.Nonce() == m_gcmNonce)
 			throw CryptoSymmetricCipherException("GCM:Initialize", "The nonce can not be zeroised or repeating!");
 		if (!m_cipherMode.IsInitialized())
 			throw CryptoSymmetricCipherException("GCM:Initialize", "First initialization requires a key and nonce!");
 	}
 	else
 	{
-		if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+		if (!SymmetricKeySize::Contains(LegalKeySizes(), keyView.Key().size()))
 			throw CryptoSymmetricCipherException("GCM:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 
 		// key the cipher and generate the hash key
 		m_cipherMode.Engine()->Initialize(true, KeyParams);
-		std::vector<byte> tmpH(BLOCK_SIZE);
-		const std::vector<byte> ZEROES(BLOCK_SIZE);
-		m_cipherMode.Engine()->Transform(ZEROES, 0, tmpH, 0);
+		Utility::MemUtils::Clear(m_batchSum, 0, BLOCK_SIZE);
+		m_cipherMode.Engine()->Transform(m_batchSum, 0, m_batchSum, 0);
 
 		std::vector<ulong> gKey = 
 		{
-			Utility::IntUtils::BeBytesTo64(tmpH, 0),
-			Utility::IntUtils::BeBytesTo64(tmpH, 8)
+			Utility::IntUtils::BeBytesTo64(m_batchSum, 0),
+			Utility::IntUtils::BeBytesTo64(m_batchSum, 8)
 		};
 
 		m_gcmHash = new Mac::GHASH(gKey);
-		m_gcmKey = KeyParams.Key();
+		m_gcmKey = keyView.Key();
 	}
 
 	m_isEncryption = Encryption;
-	m_gcmNonce = KeyParams.Nonce();
+	m_gcmNonce = keyView.Nonce();
 	m_gcmVector = m_gcmNonce;
 
 	if (m_gcmVector.size() == 12)
@@ -272,15 +298,18 @@ void GCM::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 	}
 	else
 	{
-		std::vector<byte> tmpN(BLOCK_SIZE);
-		m_gcmHash->ProcessSegment(m_gcmVector, 0, tmpN, m_gcmVector.size());
-		m_gcmHash->FinalizeBlock(tmpN, 0, m_gcmVector.size());
-		m_gcmVector = tmpN;
+		// the pre-counter block is hashed in the batch scratch block
+		const size_t NONLEN = m_gcmVector.size();
+		Utility::MemUtils::Clear(m_batchSum, 0, BLOCK_SIZE);
+		m_gcmHash->ProcessSegment(m_gcmVector, 0, m_batchSum, NONLEN);
+		m_gcmHash->FinalizeBlock(m_batchSum, 0, NONLEN);
+		m_gcmVector.resize(BLOCK_SIZE);
+		Utility::MemUtils::COPY128(m_batchSum, 0, m_gcmVector, 0);
 	}
 
 	m_cipherMode.Initialize(true, Key::Symmetric::SymmetricKey(m_gcmKey, m_gcmVector));
-	std::vector<byte> tmpN(BLOCK_SIZE);
-	m_cipherMode.Transform(tmpN, 0, m_gcmVector, 0, BLOCK_SIZE);
+	Utility::MemUtils::Clear(m_batchSum, 0, BLOCK_SIZE);
+	m_cipherMode.Transform(m_batchSum, 0, m_gcmVector, 0, BLOCK_SIZE);
 
 	if (m_isFinalized)
 	{
@@ -291,6 +320,44 @@ void GCM::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 	m_isInitialized = true;
 }
 
+bool GCM::Open(std::vector<AeadPacket> &Packets, const size_t TagLength)
+{
+	if (m_isEncryption)
+		throw CryptoCipherModeException("GCM:Open", "The cipher mode has not been initialized for decryption!");
+
+	BatchScope(Packets, TagLength, "GCM:Open");
+
+	// the pending bytes of a message in progress
+	const size_t PNDLEN = m_gcmHash->SaveState(m_batchState);
+	bool status = true;
+
+	BatchCounters(Packets);
+
+	// authenticate every packet before it is decrypted
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		AeadPacket &pkt = Packets[i];
+
+		BatchHash(pkt, false, i * BLOCK_SIZE);
+		pkt.Verified = Utility::IntUtils::Compare(m_batchSum, 0, *pkt.Tag, pkt.TagOffset, TagLength);
+
+		if (!pkt.Verified)
+		{
+			// rejected packets are not decrypted, so in-place cipher-text is left intact
+			if (pkt.Length != 0 && !pkt.IsInPlace())
+				Utility::MemUtils::Clear(*pkt.Output, pkt.OutOffset, pkt.Length);
+
+			status = false;
+		}
+	}
+
+	m_gcmHash->Reset();
+	m_gcmHash->LoadState(m_batchState, PNDLEN);
+	BatchKeyStream(Packets, false);
+
+	return status;
+}
+
 void GCM::ParallelMaxDegree(size_t Degree)
 {
 	if (Degree == 0)
@@ -303,6 +370,31 @@ void GCM::ParallelMaxDegree(size_t Degree)
 	m_parallelProfile.SetMaxDegree(Degree);
 }
 
+void GCM::Seal(std::vector<AeadPacket> &Packets, const size_t TagLength)
+{
+	if (!m_isEncryption)
+		throw CryptoCipherModeException("GCM:Seal", "The cipher mode has not been initialized for encryption!");
+
+	BatchScope(Packets, TagLength, "GCM:Seal");
+
+	// the pending bytes of a message in progress
+	const size_t PNDLEN = m_gcmHash->SaveState(m_batchState);
+
+	BatchCounters(Packets);
+	BatchKeyStream(Packets, true);
+
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		AeadPacket &pkt = Packets[i];
+
+		BatchHash(pkt, true, i * BLOCK_SIZE);
+		Utility::MemUtils::Copy(m_batchSum, 0, *pkt.Tag, pkt.TagOffset, TagLength);
+	}
+
+	m_gcmHash->Reset();
+	m_gcmHash->LoadState(m_batchState, PNDLEN);
+}
+
 void GCM::SetAssociatedData(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
 {
 	if (!m_isInitialized)
@@ -317,6 +409,17 @@ void GCM::SetAssociatedData(const std::vector<byte> &Input, const size_t Offset,
 	m_aadLoaded = true;
 }
 
+void GCM::SetAssociatedSegments(const std::vector<MemorySegment> &Input)
+{
+	if (!Utility::SegmentUtils::IsValid(Input))
+		throw CryptoCipherModeException("GCM:SetAssociatedSegments", "A segment exceeds its array!");
+
+	// the modes absorb the associated data in one call; the fragments are joined in the staging buffer
+	const size_t AADLEN = Utility::SegmentUtils::Gather(Input, m_segmentStage);
+	SetAssociatedData(m_segmentStage, 0, AADLEN);
+	Utility::MemUtils::Clear(m_segmentStage, 0, AADLEN);
+}
+
 void GCM::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
@@ -336,6 +439,11 @@ void GCM::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 	m_msgSize += Length;
 }
 
+void GCM::TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output)
+{
+	Utility::SegmentUtils::Transform(this, Input, Output, m_segmentStage);
+}
+
 bool GCM::Verify(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
 {
 	if (m_isEncryption)
@@ -353,6 +461,132 @@ bool GCM::Verify(const std::vector<byte> &Input, const size_t Offset, const size
 
 //~~~Private Functions~~~//
 
+void GCM::BatchCounters(std::vector<AeadPacket> &Packets)
+{
+	const size_t PKTCNT = Packets.size();
+
+	for (size_t i = 0; i < PKTCNT; ++i)
+	{
+		const std::vector<byte> &nonce = *Packets[i].Nonce;
+		const size_t CTROFF = i * BLOCK_SIZE;
+
+		if (nonce.size() == 12)
+		{
+			Utility::MemUtils::Copy(nonce, 0, m_batchNonce, CTROFF, nonce.size());
+			Utility::MemUtils::Clear(m_batchNonce, CTROFF + nonce.size(), BLOCK_SIZE - nonce.size());
+			m_batchNonce[CTROFF + BLOCK_SIZE - 1] = 1;
+		}
+		else
+		{
+			Utility::MemUtils::Clear(m_batchSum, 0, BLOCK_SIZE);
+			m_gcmHash->Reset();
+			m_gcmHash->ProcessSegment(nonce, 0, m_batchSum, nonce.size());
+			m_gcmHash->FinalizeBlock(m_batchSum, 0, nonce.size());
+			Utility::MemUtils::COPY128(m_batchSum, 0, m_batchNonce, CTROFF);
+		}
+	}
+
+	// the encrypted pre-counter blocks mask the tags
+	TransformLanes(m_cipherMode.Engine(), m_batchNonce, 0, m_batchMask, 0, PKTCNT);
+}
+
+void GCM::BatchHash(const AeadPacket &Packet, bool Encryption, size_t MaskOffset)
+{
+	const size_t AADLEN = (Packet.AssociatedData != nullptr) ? Packet.AssociatedData->size() : 0;
+
+	Utility::MemUtils::Clear(m_batchSum, 0, BLOCK_SIZE);
+	m_gcmHash->Reset();
+
+	if (AADLEN != 0)
+		m_gcmHash->ProcessSegment(*Packet.AssociatedData, 0, m_batchSum, AADLEN);
+
+	if (Packet.Length != 0)
+	{
+		if (Encryption)
+			m_gcmHash->Update(*Packet.Output, Packet.OutOffset, m_batchSum, Packet.Length);
+		else
+			m_gcmHash->Update(*Packet.Input, Packet.InOffset, m_batchSum, Packet.Length);
+	}
+
+	m_gcmHash->FinalizeBlock(m_batchSum, AADLEN, Packet.Length);
+	Utility::MemUtils::XOR128(m_batchMask, MaskOffset, m_batchSum, 0);
+}
+
+void GCM::BatchKeyStream(std::vector<AeadPacket> &Packets, bool Encryption)
+{
+	const size_t PKTCNT = Packets.size();
+	size_t pktIdx = 0;
+	size_t pktPos = 0;
+
+	while (pktIdx != PKTCNT)
+	{
+		size_t lanes = 0;
+
+		// stage the counter blocks of consecutive packets
+		while (lanes != BATCH_LANES && pktIdx != PKTCNT)
+		{
+			const AeadPacket &pkt = Packets[pktIdx];
+
+			// a packet that failed authentication is not decrypted
+			if (pktPos == pkt.Length || (!Encryption && !pkt.Verified))
+			{
+				++pktIdx;
+				pktPos = 0;
+				continue;
+			}
+
+			if (pktPos == 0)
+				Utility::MemUtils::COPY128(m_batchNonce, pktIdx * BLOCK_SIZE, m_batchCounter, 0);
+
+			Utility::IntUtils::BeIncrement8(m_batchCounter);
+			Utility::MemUtils::COPY128(m_batchCounter, 0, m_batchLanes, lanes * BLOCK_SIZE);
+			m_batchMap[lanes * 2] = pktIdx;
+			m_batchMap[(lanes * 2) + 1] = pktPos;
+			pktPos = Utility::IntUtils::Min(pktPos + BLOCK_SIZE, pkt.Length);
+			++lanes;
+		}
+
+		TransformLanes(m_cipherMode.Engine(), m_batchLanes, 0, m_batchLanes, 0, lanes);
+
+		// scatter the key stream to the packets
+		for (size_t i = 0; i < lanes; ++i)
+		{
+			AeadPacket &pkt = Packets[m_batchMap[i * 2]];
+			const size_t PKTPOS = m_batchMap[(i * 2) + 1];
+			const size_t BLKLEN = Utility::IntUtils::Min(BLOCK_SIZE, pkt.Length - PKTPOS);
+
+			Utility::MemUtils::XorBlock(*pkt.Input, pkt.InOffset + PKTPOS, m_batchLanes, i * BLOCK_SIZE, BLKLEN);
+			Utility::MemUtils::Copy(m_batchLanes, i * BLOCK_SIZE, *pkt.Output, pkt.OutOffset + PKTPOS, BLKLEN);
+		}
+	}
+}
+
+void GCM::BatchScope(const std::vector<AeadPacket> &Packets, const size_t TagLength, const std::string &Origin)
+{
+	if (m_gcmHash == 0)
+		throw CryptoCipherModeException(Origin, "The cipher mode has not been keyed!");
+	if (TagLength < MIN_TAGSIZE || TagLength > BLOCK_SIZE)
+		throw CryptoCipherModeException(Origin, "The length must be minimum of 12 and maximum of MAC code size!");
+
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		const AeadPacket &pkt = Packets[i];
+
+		if (pkt.Nonce == nullptr || pkt.Nonce->size() < MIN_NONCESIZE)
+			throw CryptoCipherModeException(Origin, "Each packet requires a nonce of minimum 8 bytes in length!");
+		if (pkt.Tag == nullptr || pkt.Tag->size() < pkt.TagOffset + TagLength)
+			throw CryptoCipherModeException(Origin, "The packet tag array is too small!");
+		if (pkt.Length != 0 && (pkt.Input == nullptr || pkt.Output == nullptr || pkt.Input->size() < pkt.InOffset + pkt.Length || pkt.Output->size() < pkt.OutOffset + pkt.Length))
+			throw CryptoCipherModeException(Origin, "The packet arrays are smaller than the message length!");
+	}
+
+	if (m_batchMask.size() < Packets.size() * BLOCK_SIZE)
+	{
+		m_batchMask.resize(Packets.size() * BLOCK_SIZE);
+		m_batchNonce.resize(Packets.size() * BLOCK_SIZE);
+	}
+}
+
 void GCM::CalculateMac()
 {
 	m_gcmHash->FinalizeBlock(m_checkSum, m_aadSize, m_msgSize);
@@ -428,4 +662,33 @@ void GCM::Scope()
 	}
 }
 
+void GCM::TransformLanes(IBlockCipher* Cipher, const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t BlockCount)
+{
+#if defined(__AVX__)
+	const size_t LANELEN = BATCH_LANES * BLOCK_SIZE;
+
+	while (BlockCount >= BATCH_LANES)
+	{
+#	if defined(__AVX512__)
+		Cipher->Transform2048(Input, InOffset, Output, OutOffset);
+#	elif defined(__AVX2__)
+		Cipher->Transform1024(Input, InOffset, Output, OutOffset);
+#	else
+		Cipher->Transform512(Input, InOffset, Output, OutOffset);
+#	endif
+		InOffset += LANELEN;
+		OutOffset += LANELEN;
+		BlockCount -= BATCH_LANES;
+	}
+#endif
+
+	while (BlockCount != 0)
+	{
+		Cipher->Transform(Input, InOffset, Output, OutOffset);
+		InOffset += BLOCK_SIZE;
+		OutOffset += BLOCK_SIZE;
+		--BlockCount;
+	}
+}
+
 NAMESPACE_MODEEND
\ No newline at end of file
@@ -0,0 +1,766 @@
+#include "GCMT.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#if defined(__AVX__)
+#	include "AHX.h"
+#endif
+#include "RHX.h"
+#include "SegmentUtils.h"
+#include "SHX.h"
+#include "SymmetricKey.h"
+#include "THX.h"
+
+NAMESPACE_MODE
+
+template <class TCipher>
+const std::string GCMT<TCipher>::CLASS_NAME("GCM");
+
+//~~~Properties~~~//
+
+template <class TCipher>
+bool &GCMT<TCipher>::AutoIncrement()
+{
+	return m_autoIncrement;
+}
+
+template <class TCipher>
+const size_t GCMT<TCipher>::BlockSize()
+{
+	return BLOCK_SIZE;
+}
+
+template <class TCipher>
+const BlockCiphers GCMT<TCipher>::CipherType()
+{
+	return m_cipherType;
+}
+
+template <class TCipher>
+IBlockCipher* GCMT<TCipher>::Engine()
+{
+	return m_blockCipher;
+}
+
+template <class TCipher>
+const CipherModes GCMT<TCipher>::Enumeral()
+{
+	return CipherModes::GCM;
+}
+
+template <class TCipher>
+const bool GCMT<TCipher>::IsEncryption()
+{
+	return m_isEncryption;
+}
+
+template <class TCipher>
+const bool GCMT<TCipher>::IsInitialized()
+{
+	return m_isInitialized;
+}
+
+template <class TCipher>
+const bool GCMT<TCipher>::IsParallel()
+{
+	return m_parallelProfile.IsParallel();
+}
+
+template <class TCipher>
+const std::vector<SymmetricKeySize> &GCMT<TCipher>::LegalKeySizes()
+{
+	return m_legalKeySizes;
+}
+
+template <class TCipher>
+const size_t GCMT<TCipher>::MaxTagSize()
+{
+	return BLOCK_SIZE;
+}
+
+template <class TCipher>
+const size_t GCMT<TCipher>::MinTagSize()
+{
+	return MIN_TAGSIZE;
+}
+
+template <class TCipher>
+const std::string GCMT<TCipher>::Name()
+{
+	return CLASS_NAME + "-" + m_blockCipher->Name();
+}
+
+template <class TCipher>
+const size_t GCMT<TCipher>::ParallelBlockSize()
+{
+	return m_parallelProfile.ParallelBlockSize();
+}
+
+template <class TCipher>
+ParallelOptions &GCMT<TCipher>::ParallelProfile()
+{
+	return m_cipherMode.ParallelProfile();
+}
+
+template <class TCipher>
+bool &GCMT<TCipher>::PreserveAD()
+{
+	return m_aadPreserve;
+}
+
+template <class TCipher>
+const std::vector<byte> GCMT<TCipher>::Tag()
+{
+	if (!m_isFinalized)
+		throw CryptoCipherModeException("GCMT:Tag", "The cipher mode has not been finalized!");
+
+	return m_msgTag;
+}
+
+//~~~Constructor~~~//
+
+template <class TCipher>
+GCMT<TCipher>::GCMT(Digests KdfEngineType, size_t Rounds)
+	:
+	m_aadData(0),
+	m_aadLoaded(false),
+	m_aadPreserve(false),
+	m_aadSize(0),
+	m_autoIncrement(false),
+	m_batchCounter(BLOCK_SIZE),
+	m_batchLanes(BATCH_LANES * BLOCK_SIZE),
+	m_batchMap(BATCH_LANES * 2),
+	m_batchMask(0),
+	m_batchNonce(0),
+	m_batchState(BLOCK_SIZE),
+	m_batchSum(BLOCK_SIZE),
+	m_blockCipher(Rounds == 0 ? new TCipher(KdfEngineType) : new TCipher(KdfEngineType, Rounds)),
+	m_checkSum(BLOCK_SIZE),
+	m_cipherMode(m_blockCipher),
+	m_cipherType(m_blockCipher->Enumeral()),
+	m_destroyEngine(true),
+	m_gcmHash(0),
+	m_gcmKey(0),
+	m_gcmNonce(0),
+	m_gcmVector(0),
+	m_isDestroyed(false),
+	m_isEncryption(false),
+	m_isFinalized(false),
+	m_isInitialized(false),
+	m_legalKeySizes(0),
+	m_msgSize(0),
+	m_msgTag(BLOCK_SIZE),
+	m_parallelProfile(BLOCK_SIZE, m_cipherMode.ParallelProfile().IsParallel(), m_cipherMode.ParallelProfile().ParallelBlockSize(),
+		m_cipherMode.ParallelProfile().ParallelMaxDegree(), true, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0)
+{
+	Scope();
+}
+
+template <class TCipher>
+GCMT<TCipher>::GCMT(TCipher* Cipher)
+	:
+	m_aadData(0),
+	m_aadLoaded(false),
+	m_aadPreserve(false),
+	m_aadSize(0),
+	m_autoIncrement(false),
+	m_batchCounter(BLOCK_SIZE),
+	m_batchLanes(BATCH_LANES * BLOCK_SIZE),
+	m_batchMap(BATCH_LANES * 2),
+	m_batchMask(0),
+	m_batchNonce(0),
+	m_batchState(BLOCK_SIZE),
+	m_batchSum(BLOCK_SIZE),
+	m_blockCipher(Cipher != 0 ? Cipher : throw CryptoCipherModeException("GCMT:CTor", "The Cipher can not be null!")),
+	m_checkSum(BLOCK_SIZE),
+	m_cipherMode(m_blockCipher),
+	m_cipherType(m_blockCipher->Enumeral()),
+	m_destroyEngine(false),
+	m_gcmHash(0),
+	m_gcmKey(0),
+	m_gcmNonce(0),
+	m_gcmVector(0),
+	m_isDestroyed(false),
+	m_isEncryption(false),
+	m_isFinalized(false),
+	m_isInitialized(false),
+	m_legalKeySizes(0),
+	m_msgSize(0),
+	m_msgTag(BLOCK_SIZE),
+	m_parallelProfile(BLOCK_SIZE, m_cipherMode.ParallelProfile().IsParallel(), m_cipherMode.ParallelProfile().ParallelBlockSize(),
+		m_cipherMode.ParallelProfile().ParallelMaxDegree(), true, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0)
+{
+	Scope();
+}
+
+template <class TCipher>
+GCMT<TCipher>::~GCMT()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+template <class TCipher>
+void GCMT<TCipher>::DecryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	Decrypt128(Input, 0, Output, 0);
+}
+
+template <class TCipher>
+void GCMT<TCipher>::DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+{
+	Decrypt128(Input, InOffset, Output, OutOffset);
+}
+
+template <class TCipher>
+void GCMT<TCipher>::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_aadLoaded = false;
+		m_aadPreserve = false;
+		m_aadSize = 0;
+		m_autoIncrement = false;
+		m_cipherType = BlockCiphers::None;
+		m_isEncryption = false;
+		m_isFinalized = false;
+		m_isInitialized = false;
+		m_msgSize = 0;
+		m_parallelProfile.Reset();
+
+		if (m_gcmHash != 0)
+		{
+			delete m_gcmHash;
+			m_gcmHash = 0;
+		}
+
+		Utility::IntUtils::ClearVector(m_aadData);
+		Utility::IntUtils::ClearVector(m_batchCounter);
+		Utility::IntUtils::ClearVector(m_batchLanes);
+		Utility::IntUtils::ClearVector(m_batchMap);
+		Utility::IntUtils::ClearVector(m_batchMask);
+		Utility::IntUtils::ClearVector(m_batchNonce);
+		Utility::IntUtils::ClearVector(m_batchState);
+		Utility::IntUtils::ClearVector(m_batchSum);
+		Utility::IntUtils::ClearVector(m_gcmKey);
+		Utility::IntUtils::ClearVector(m_gcmNonce);
+		Utility::IntUtils::ClearVector(m_gcmVector);
+		Utility::IntUtils::ClearVector(m_legalKeySizes);
+		Utility::IntUtils::ClearVector(m_msgTag);
+		Utility::IntUtils::ClearVector(m_checkSum);
+		Utility::IntUtils::ClearVector(m_segmentStage);
+
+		// the counter mode does not own the cipher
+		m_cipherMode.Destroy();
+
+		if (m_destroyEngine)
+		{
+			m_destroyEngine = false;
+
+			if (m_blockCipher != 0)
+				delete m_blockCipher;
+		}
+	}
+}
+
+template <class TCipher>
+void GCMT<TCipher>::EncryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	Encrypt128(Input, 0, Output, 0);
+}
+
+template <class TCipher>
+void GCMT<TCipher>::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+{
+	Encrypt128(Input, InOffset, Output, OutOffset);
+}
+
+template <class TCipher>
+void GCMT<TCipher>::Finalize(std::vector<byte> &Output, const size_t Offset, const size_t Length)
+{
+	if (!m_isInitialized)
+		throw CryptoCipherModeException("GCMT:Finalize", "The cipher mode has not been initialized!");
+	if (Length < MIN_TAGSIZE || Length > BLOCK_SIZE)
+		throw CryptoCipherModeException("GCMT:Finalize", "The length must be minimum of 12 and maximum of MAC code size!");
+
+	CalculateMac();
+	Utility::MemUtils::Copy(m_msgTag, 0, Output, Offset, Length);
+}
+
+template <class TCipher>
+void GCMT<TCipher>::Initialize(bool Encryption, ISymmetricKey &KeyParams)
+{
+	SymmetricKeyView keyView(KeyParams);
+
+	Scope();
+
+	if (keyView.Nonce().size() < 8)
+		throw CryptoSymmetricCipherException("GCMT:Initialize", "Requires a nonce of minimum 10 bytes in length!");
+	if (IsParallel() && ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
+		throw CryptoSymmetricCipherException("GCMT:Initialize", "The parallel block size is out of bounds!");
+	if (IsParallel() && ParallelBlockSize() % m_parallelProfile.ParallelMinimumSize() != 0)
+		throw CryptoSymmetricCipherException("GCMT:Initialize", "The parallel block size must be evenly aligned to the ParallelMinimumSize!");
+
+	if (keyView.Key().size() == 0)
+	{
+		if (keyView.Nonce() == m_gcmNonce)
+			throw CryptoSymmetricCipherException("GCMT:Initialize", "The nonce can not be zeroised or repeating!");
+		if (!m_cipherMode.IsInitialized())
+			throw CryptoSymmetricCipherException("GCMT:Initialize", "First initialization requires a key and nonce!");
+	}
+	else
+	{
+		if (!SymmetricKeySize::Contains(LegalKeySizes(), keyView.Key().size()))
+			throw CryptoSymmetricCipherException("GCMT:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
+
+		// key the cipher and generate the hash key
+		m_blockCipher->Initialize(true, KeyParams);
+		Utility::MemUtils::Clear(m_batchSum, 0, BLOCK_SIZE);
+		m_blockCipher->Transform(m_batchSum, 0, m_batchSum, 0);
+
+		std::vector<ulong> gKey = 
+		{
+			Utility::IntUtils::BeBytesTo64(m_batchSum, 0),
+			Utility::IntUtils::BeBytesTo64(m_batchSum, 8)
+		};
+
+		if (m_gcmHash != 0)
+			delete m_gcmHash;
+
+		m_gcmHash = new Mac::GHASH(gKey);
+		m_gcmKey = keyView.Key();
+	}
+
+	m_isEncryption = Encryption;
+	m_gcmNonce = keyView.Nonce();
+	m_gcmVector = m_gcmNonce;
+
+	if (m_gcmVector.size() == 12)
+	{
+		m_gcmVector.resize(16);
+		m_gcmVector[15] = 1;
+	}
+	else
+	{
+		// the pre-counter block is hashed in the batch scratch block
+		const size_t NONLEN = m_gcmVector.size();
+		Utility::MemUtils::Clear(m_batchSum, 0, BLOCK_SIZE);
+		m_gcmHash->ProcessSegment(m_gcmVector, 0, m_batchSum, NONLEN);
+		m_gcmHash->FinalizeBlock(m_batchSum, 0, NONLEN);
+		m_gcmVector.resize(BLOCK_SIZE);
+		Utility::MemUtils::COPY128(m_batchSum, 0, m_gcmVector, 0);
+	}
+
+	m_cipherMode.Initialize(true, Key::Symmetric::SymmetricKey(m_gcmKey, m_gcmVector));
+	Utility::MemUtils::Clear(m_batchSum, 0, BLOCK_SIZE);
+	m_cipherMode.Transform(m_batchSum, 0, m_gcmVector, 0, BLOCK_SIZE);
+
+	if (m_isFinalized)
+	{
+		Utility::MemUtils::Clear(m_msgTag, 0, m_msgTag.size());
+		m_isFinalized = false;
+	}
+
+	m_isInitialized = true;
+}
+
+template <class TCipher>
+bool GCMT<TCipher>::Open(std::vector<AeadPacket> &Packets, const size_t TagLength)
+{
+	if (m_isEncryption)
+		throw CryptoCipherModeException("GCMT:Open", "The cipher mode has not been initialized for decryption!");
+
+	BatchScope(Packets, TagLength, "GCMT:Open");
+
+	// the pending bytes of a message in progress
+	const size_t PNDLEN = m_gcmHash->SaveState(m_batchState);
+	bool status = true;
+
+	BatchCounters(Packets);
+
+	// authenticate every packet before it is decrypted
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		AeadPacket &pkt = Packets[i];
+
+		BatchHash(pkt, false, i * BLOCK_SIZE);
+		pkt.Verified = Utility::IntUtils::Compare(m_batchSum, 0, *pkt.Tag, pkt.TagOffset, TagLength);
+
+		if (!pkt.Verified)
+		{
+			// rejected packets are not decrypted, so in-place cipher-text is left intact
+			if (pkt.Length != 0 && !pkt.IsInPlace())
+				Utility::MemUtils::Clear(*pkt.Output, pkt.OutOffset, pkt.Length);
+
+			status = false;
+		}
+	}
+
+	m_gcmHash->Reset();
+	m_gcmHash->LoadState(m_batchState, PNDLEN);
+	BatchKeyStream(Packets, false);
+
+	return status;
+}
+
+template <class TCipher>
+void GCMT<TCipher>::ParallelMaxDegree(size_t Degree)
+{
+	if (Degree == 0)
+		throw CryptoCipherModeException("GCMT:ParallelMaxDegree", "Parallel degree can not be zero!");
+	if (Degree % 2 != 0)
+		throw CryptoCipherModeException("GCMT:ParallelMaxDegree", "Parallel degree must be an even number!");
+	if (Degree > m_parallelProfile.ProcessorCount())
+		throw CryptoCipherModeException("GCMT:ParallelMaxDegree", "Parallel degree can not exceed processor count!");
+
+	m_parallelProfile.SetMaxDegree(Degree);
+}
+
+template <class TCipher>
+void GCMT<TCipher>::Seal(std::vector<AeadPacket> &Packets, const size_t TagLength)
+{
+	if (!m_isEncryption)
+		throw CryptoCipherModeException("GCMT:Seal", "The cipher mode has not been initialized for encryption!");
+
+	BatchScope(Packets, TagLength, "GCMT:Seal");
+
+	// the pending bytes of a message in progress
+	const size_t PNDLEN = m_gcmHash->SaveState(m_batchState);
+
+	BatchCounters(Packets);
+	BatchKeyStream(Packets, true);
+
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		AeadPacket &pkt = Packets[i];
+
+		BatchHash(pkt, true, i * BLOCK_SIZE);
+		Utility::MemUtils::Copy(m_batchSum, 0, *pkt.Tag, pkt.TagOffset, TagLength);
+	}
+
+	m_gcmHash->Reset();
+	m_gcmHash->LoadState(m_batchState, PNDLEN);
+}
+
+template <class TCipher>
+void GCMT<TCipher>::SetAssociatedData(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
+{
+	if (!m_isInitialized)
+		throw CryptoSymmetricCipherException("GCMT:SetAssociatedData", "The cipher has not been initialized!");
+	if (m_aadLoaded)
+		throw CryptoSymmetricCipherException("GCMT:SetAssociatedData", "The associated data has already been set!");
+
+	m_aadData.resize(Length);
+	Utility::MemUtils::Copy(Input, Offset, m_aadData, 0, Length);
+	m_gcmHash->ProcessSegment(Input, Offset, m_checkSum, Length);
+	m_aadSize = Length;
+	m_aadLoaded = true;
+}
+
+template <class TCipher>
+void GCMT<TCipher>::SetAssociatedSegments(const std::vector<MemorySegment> &Input)
+{
+	if (!Utility::SegmentUtils::IsValid(Input))
+		throw CryptoCipherModeException("GCMT:SetAssociatedSegments", "A segment exceeds its array!");
+
+	// the modes absorb the associated data in one call; the fragments are joined in the staging buffer
+	const size_t AADLEN = Utility::SegmentUtils::Gather(Input, m_segmentStage);
+	SetAssociatedData(m_segmentStage, 0, AADLEN);
+	Utility::MemUtils::Clear(m_segmentStage, 0, AADLEN);
+}
+
+template <class TCipher>
+void GCMT<TCipher>::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= Length, "The data arrays are smaller than the the block-size!");
+
+	if (m_isEncryption)
+	{
+		m_cipherMode.Transform(Input, InOffset, Output, OutOffset, Length);
+		m_gcmHash->Update(Output, OutOffset, m_checkSum, Length);
+	}
+	else
+	{
+		m_gcmHash->Update(Input, InOffset, m_checkSum, Length);
+		m_cipherMode.Transform(Input, InOffset, Output, OutOffset, Length);
+	}
+
+	m_msgSize += Length;
+}
+
+template <class TCipher>
+void GCMT<TCipher>::TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output)
+{
+	Utility::SegmentUtils::Transform(this, Input, Output, m_segmentStage);
+}
+
+template <class TCipher>
+bool GCMT<TCipher>::Verify(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
+{
+	if (m_isEncryption)
+		throw CryptoCipherModeException("GCMT:Verify", "The cipher mode has not been initialized for decryption!");
+	if (!m_isInitialized && !m_isFinalized)
+		throw CryptoCipherModeException("GCMT:Verify", "The cipher mode has not been initialized!");
+	if (Length < MIN_TAGSIZE || Length > BLOCK_SIZE)
+		throw CryptoCipherModeException("GCMT:Verify", "The length must be minimum of 12 and maximum of MAC code size!");
+
+	if (!m_isFinalized)
+		CalculateMac();
+
+	return Utility::IntUtils::Compare(m_msgTag, 0, Input, Offset, Length);
+}
+
+//~~~Private Functions~~~//
+
+template <class TCipher>
+void GCMT<TCipher>::BatchCounters(std::vector<AeadPacket> &Packets)
+{
+	const size_t PKTCNT = Packets.size();
+
+	for (size_t i = 0; i < PKTCNT; ++i)
+	{
+		const std::vector<byte> &nonce = *Packets[i].Nonce;
+		const size_t CTROFF = i * BLOCK_SIZE;
+
+		if (nonce.size() == 12)
+		{
+			Utility::MemUtils::Copy(nonce, 0, m_batchNonce, CTROFF, nonce.size());
+			Utility::MemUtils::Clear(m_batchNonce, CTROFF + nonce.size(), BLOCK_SIZE - nonce.size());
+			m_batchNonce[CTROFF + BLOCK_SIZE - 1] = 1;
+		}
+		else
+		{
+			Utility::MemUtils::Clear(m_batchSum, 0, BLOCK_SIZE);
+			m_gcmHash->Reset();
+			m_gcmHash->ProcessSegment(nonce, 0, m_batchSum, nonce.size());
+			m_gcmHash->FinalizeBlock(m_batchSum, 0, nonce.size());
+			Utility::MemUtils::COPY128(m_batchSum, 0, m_batchNonce, CTROFF);
+		}
+	}
+
+	// the encrypted pre-counter blocks mask the tags
+	TransformLanes(m_blockCipher, m_batchNonce, 0, m_batchMask, 0, PKTCNT);
+}
+
+template <class TCipher>
+void GCMT<TCipher>::BatchHash(const AeadPacket &Packet, bool Encryption, size_t MaskOffset)
+{
+	const size_t AADLEN = (Packet.AssociatedData != nullptr) ? Packet.AssociatedData->size() : 0;
+
+	Utility::MemUtils::Clear(m_batchSum, 0, BLOCK_SIZE);
+	m_gcmHash->Reset();
+
+	if (AADLEN != 0)
+		m_gcmHash->ProcessSegment(*Packet.AssociatedData, 0, m_batchSum, AADLEN);
+
+	if (Packet.Length != 0)
+	{
+		if (Encryption)
+			m_gcmHash->Update(*Packet.Output, Packet.OutOffset, m_batchSum, Packet.Length);
+		else
+			m_gcmHash->Update(*Packet.Input, Packet.InOffset, m_batchSum, Packet.Length);
+	}
+
+	m_gcmHash->FinalizeBlock(m_batchSum, AADLEN, Packet.Length);
+	Utility::MemUtils::XOR128(m_batchMask, MaskOffset, m_batchSum, 0);
+}
+
+template <class TCipher>
+void GCMT<TCipher>::BatchKeyStream(std::vector<AeadPacket> &Packets, bool Encryption)
+{
+	const size_t PKTCNT = Packets.size();
+	size_t pktIdx = 0;
+	size_t pktPos = 0;
+
+	while (pktIdx != PKTCNT)
+	{
+		size_t lanes = 0;
+
+		// stage the counter blocks of consecutive packets
+		while (lanes != BATCH_LANES && pktIdx != PKTCNT)
+		{
+			const AeadPacket &pkt = Packets[pktIdx];
+
+			// a packet that failed authentication is not decrypted
+			if (pktPos == pkt.Length || (!Encryption && !pkt.Verified))
+			{
+				++pktIdx;
+				pktPos = 0;
+				continue;
+			}
+
+			if (pktPos == 0)
+				Utility::MemUtils::COPY128(m_batchNonce, pktIdx * BLOCK_SIZE, m_batchCounter, 0);
+
+			Utility::IntUtils::BeIncrement8(m_batchCounter);
+			Utility::MemUtils::COPY128(m_batchCounter, 0, m_batchLanes, lanes * BLOCK_SIZE);
+			m_batchMap[lanes * 2] = pktIdx;
+			m_batchMap[(lanes * 2) + 1] = pktPos;
+			pktPos = Utility::IntUtils::Min(pktPos + BLOCK_SIZE, pkt.Length);
+			++lanes;
+		}
+
+		TransformLanes(m_blockCipher, m_batchLanes, 0, m_batchLanes, 0, lanes);
+
+		// scatter the key stream to the packets
+		for (size_t i = 0; i < lanes; ++i)
+		{
+			AeadPacket &pkt = Packets[m_batchMap[i * 2]];
+			const size_t PKTPOS = m_batchMap[(i * 2) + 1];
+			const size_t BLKLEN = Utility::IntUtils::Min(BLOCK_SIZE, pkt.Length - PKTPOS);
+
+			Utility::MemUtils::XorBlock(*pkt.Input, pkt.InOffset + PKTPOS, m_batchLanes, i * BLOCK_SIZE, BLKLEN);
+			Utility::MemUtils::Copy(m_batchLanes, i * BLOCK_SIZE, *pkt.Output, pkt.OutOffset + PKTPOS, BLKLEN);
+		}
+	}
+}
+
+template <class TCipher>
+void GCMT<TCipher>::BatchScope(const std::vector<AeadPacket> &Packets, const size_t TagLength, const std::string &Origin)
+{
+	if (m_gcmHash == 0)
+		throw CryptoCipherModeException(Origin, "The cipher mode has not been keyed!");
+	if (TagLength < MIN_TAGSIZE || TagLength > BLOCK_SIZE)
+		throw CryptoCipherModeException(Origin, "The length must be minimum of 12 and maximum of MAC code size!");
+
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		const AeadPacket &pkt = Packets[i];
+
+		if (pkt.Nonce == nullptr || pkt.Nonce->size() < MIN_NONCESIZE)
+			throw CryptoCipherModeException(Origin, "Each packet requires a nonce of minimum 8 bytes in length!");
+		if (pkt.Tag == nullptr || pkt.Tag->size() < pkt.TagOffset + TagLength)
+			throw CryptoCipherModeException(Origin, "The packet tag array is too small!");
+		if (pkt.Length != 0 && (pkt.Input == nullptr || pkt.Output == nullptr || pkt.Input->size() < pkt.InOffset + pkt.Length || pkt.Output->size() < pkt.OutOffset + pkt.Length))
+			throw CryptoCipherModeException(Origin, "The packet arrays are smaller than the message length!");
+	}
+
+	if (m_batchMask.size() < Packets.size() * BLOCK_SIZE)
+	{
+		m_batchMask.resize(Packets.size() * BLOCK_SIZE);
+		m_batchNonce.resize(Packets.size() * BLOCK_SIZE);
+	}
+}
+
+template <class TCipher>
+void GCMT<TCipher>::CalculateMac()
+{
+	m_gcmHash->FinalizeBlock(m_checkSum, m_aadSize, m_msgSize);
+	Utility::MemUtils::XorBlock(m_gcmVector, 0, m_checkSum, 0, BLOCK_SIZE);
+	Utility::MemUtils::COPY128(m_checkSum, 0, m_msgTag, 0);
+	Reset();
+
+	if (m_autoIncrement)
+	{
+		std::vector<byte> tmpN = m_gcmNonce;
+		Utility::IntUtils::BeIncrement8(tmpN);
+		std::vector<byte> zero(0);
+		Initialize(m_isEncryption, Key::Symmetric::SymmetricKey(zero, tmpN));
+
+		if (m_aadPreserve)
+			m_gcmHash->ProcessSegment(m_aadData, 0, m_checkSum, m_aadData.size());
+	}
+
+	m_isFinalized = true;
+}
+
+template <class TCipher>
+void GCMT<TCipher>::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
+
+	m_gcmHash->Update(Input, InOffset, m_checkSum, BLOCK_SIZE);
+	m_cipherMode.EncryptBlock(Input, InOffset, Output, OutOffset);
+	m_msgSize += BLOCK_SIZE;
+}
+
+template <class TCipher>
+void GCMT<TCipher>::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
+{
+	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
+	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
+
+	m_cipherMode.EncryptBlock(Input, InOffset, Output, OutOffset);
+	m_gcmHash->Update(Input, InOffset, m_checkSum, BLOCK_SIZE);
+	m_msgSize += BLOCK_SIZE;
+}
+
+template <class TCipher>
+void GCMT<TCipher>::Reset()
+{
+	if (!m_aadPreserve)
+	{
+		if (m_aadSize != 0)
+			Utility::MemUtils::Clear(m_aadData, 0, m_aadData.size());
+
+		m_aadLoaded = false;
+		m_aadSize = 0;
+	}
+
+	m_gcmHash->Reset();
+	m_isInitialized = false;
+	Utility::MemUtils::Clear(m_gcmVector, 0, m_gcmVector.size());
+	Utility::MemUtils::Clear(m_checkSum, 0, m_checkSum.size());
+	m_msgSize = 0;
+}
+
+template <class TCipher>
+void GCMT<TCipher>::Scope()
+{
+	std::vector<SymmetricKeySize> keySizes = m_cipherMode.LegalKeySizes();
+	m_legalKeySizes.resize(keySizes.size());
+
+	for (size_t i = 0; i < m_legalKeySizes.size(); i++)
+	{	
+		m_legalKeySizes[i] = SymmetricKeySize(keySizes[i].KeySize(), keySizes[i].NonceSize(), keySizes[i].NonceSize());
+	}
+
+	if (!m_cipherMode.ParallelProfile().IsDefault())
+	{
+		m_cipherMode.ParallelProfile().Calculate(m_parallelProfile.IsParallel(), m_cipherMode.ParallelProfile().ParallelBlockSize(), m_cipherMode.ParallelProfile().ParallelMaxDegree());
+	}
+}
+
+template <class TCipher>
+void GCMT<TCipher>::TransformLanes(TCipher* Cipher, const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t BlockCount)
+{
+#if defined(__AVX__)
+	const size_t LANELEN = BATCH_LANES * BLOCK_SIZE;
+
+	while (BlockCount >= BATCH_LANES)
+	{
+#	if defined(__AVX512__)
+		Cipher->Transform2048(Input, InOffset, Output, OutOffset);
+#	elif defined(__AVX2__)
+		Cipher->Transform1024(Input, InOffset, Output, OutOffset);
+#	else
+		Cipher->Transform512(Input, InOffset, Output, OutOffset);
+#	endif
+		InOffset += LANELEN;
+		OutOffset += LANELEN;
+		BlockCount -= BATCH_LANES;
+	}
+#endif
+
+	while (BlockCount != 0)
+	{
+		Cipher->Transform(Input, InOffset, Output, OutOffset);
+		InOffset += BLOCK_SIZE;
+		OutOffset += BLOCK_SIZE;
+		--BlockCount;
+	}
+}
+
+#if defined(__AVX__)
+template class GCMT<Block::AHX>;
+#endif
+template class GCMT<Block::RHX>;
+template class GCMT<Block::SHX>;
+template class GCMT<Block::THX>;
+
+NAMESPACE_MODEEND
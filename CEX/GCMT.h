@@ -0,0 +1,454 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// A Galois/Counter authenticated Mode (GCM), specialized at compile time on the block cipher type.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_GCMT_H
+#define CEX_GCMT_H
+
+#include "IAeadMode.h"
+#include "CTRT.h"
+#include "GHASH.h"
+
+NAMESPACE_MODE
+
+/// <summary>
+/// A Galois/Counter Authenticated Block Cipher Mode, specialized on the block cipher type
+/// </summary>
+///
+/// <example>
+/// <description>Encrypting with the AES-NI specialized authenticated mode:</description>
+/// <code>
+/// GCMT&lt;AHX&gt; cipher;
+/// // initialize for encryption
+/// cipher.Initialize(true, SymmetricKey(Key, Nonce, [Info]));
+/// // encrypt a length of bytes
+/// cipher.Transform(Input, 0, Output, 0, Input.size());
+/// // append the mac code to the output
+/// cipher.Finalize(Output, Input.size(), 16);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description><B>Overview:</B></description>
+/// <para>GCMT produces the same output as the <see cref="GCM"/> mode, but holds the block cipher by its concrete type rather than through the IBlockCipher interface. \n
+/// The message is encrypted by the <see cref="CTRT"/> counter mode specialized on the same cipher, so the AHX instantiation uses the fused AES-NI counter loop,
+/// and the pre-counter blocks of the Seal and Open batches are encrypted without a virtual call per block.</para>
+///
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The class is instantiated for the AHX (when AVX is enabled), RHX, SHX, and THX ciphers.</description></item>
+/// <item><description>The mode is exposed through the IAeadMode interface; the Enumeral() property returns CipherModes::GCM.</description></item>
+/// <item><description>A cipher instance created by the mode is deleted when the class is destroyed; an instance passed to the constructor is not.</description></item>
+/// <item><description>Additional data can be added using the SetAssociatedData(Input, Offset, Length) call.</description></item>
+/// <item><description>Calling the Finalize(Output, Offset, Length) function writes the MAC code to the output array in either encryption or decryption operation mode.</description></item>
+/// <item><description>The Verify(Input, Offset, Length) function can be used to compare the MAC code embedded with the cipher-text to the internal MAC code generated after a Decryption cycle.</description></item>
+/// <item><description>If the system supports Parallel processing, IsParallel() is set to true; passing an input block of ParallelBlockSize() to the transform.</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>The <a href="http://csrc.nist.gov/groups/ST/toolkit/BCM/documents/proposedmodes/gcm/gcm-spec.pdf">Galois/Counter Mode</a> of Operation (GCM).</description></item>
+/// <item><description>NIST <a href="http://csrc.nist.gov/publications/nistpubs/800-38D/SP-800-38D.pdf">SP800-38D</a>.</description></item>
+/// <item><description>Intel <a href="https://www.intel.com/content/dam/doc/white-paper/advanced-encryption-standard-new-instructions-set-paper.pdf">Advanced Encryption Standard (AES) New Instructions Set</a>.</description></item>
+/// </list>
+/// </remarks>
+template <class TCipher>
+class GCMT final : public IAeadMode
+{
+private:
+
+	static const size_t BLOCK_SIZE = 16;
+#if defined(__AVX512__)
+	static const size_t BATCH_LANES = 16;
+#elif defined(__AVX2__)
+	static const size_t BATCH_LANES = 8;
+#else
+	static const size_t BATCH_LANES = 4;
+#endif
+	static const std::string CLASS_NAME;
+	static const size_t MAX_PRLALLOC = 100000000;
+	static const size_t MIN_NONCESIZE = 8;
+	static const size_t MIN_TAGSIZE = 12;
+
+	std::vector<byte> m_aadData;
+	bool m_aadLoaded;
+	bool m_aadPreserve;
+	size_t m_aadSize;
+	bool m_autoIncrement;
+	std::vector<byte> m_batchCounter;
+	std::vector<byte> m_batchLanes;
+	std::vector<size_t> m_batchMap;
+	std::vector<byte> m_batchMask;
+	std::vector<byte> m_batchNonce;
+	std::vector<byte> m_batchState;
+	std::vector<byte> m_batchSum;
+	TCipher* m_blockCipher;
+	std::vector<byte> m_checkSum;
+	CTRT<TCipher> m_cipherMode;
+	BlockCiphers m_cipherType;
+	bool m_destroyEngine;
+	Mac::GHASH* m_gcmHash;
+	std::vector<byte> m_gcmKey;
+	std::vector<byte> m_gcmNonce;
+	std::vector<byte> m_gcmVector;
+	bool m_isDestroyed;
+	bool m_isEncryption;
+	bool m_isFinalized;
+	bool m_isInitialized;
+	std::vector<SymmetricKeySize> m_legalKeySizes;
+	size_t m_msgSize;
+	std::vector<byte> m_msgTag;
+	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_segmentStage;
+
+public:
+
+	GCMT(const GCMT&) = delete;
+	GCMT& operator=(const GCMT&) = delete;
+	GCMT& operator=(GCMT&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get/Set: Enable auto-incrementing of the input nonce, each time the Finalize method is called.
+	/// <para>Treats the Nonce value loaded during Initialize as a monotonic counter; 
+	/// incrementing the value by 1 and re-calculating the working set each time the cipher is finalized. 
+	/// If set to false, requires a re-key after each finalizer cycle.<para>
+	/// </summary>
+	bool &AutoIncrement() override;
+
+	/// <summary>
+	/// Get: Block size of internal cipher in bytes
+	/// </summary>
+	const size_t BlockSize() override;
+
+	/// <summary>
+	/// Get: The block ciphers formal type name
+	/// </summary>
+	const BlockCiphers CipherType() override;
+
+	/// <summary>
+	/// Get: The underlying Block Cipher instance
+	/// </summary>
+	IBlockCipher* Engine() override;
+
+	/// <summary>
+	/// Get: The Cipher Modes enumeration type name
+	/// </summary>
+	const CipherModes Enumeral() override;
+
+	/// <summary>
+	/// Get: True if initialized for encryption, False for decryption
+	/// </summary>
+	const bool IsEncryption() override;
+
+	/// <summary>
+	/// Get: The Block Cipher is ready to transform data
+	/// </summary>
+	const bool IsInitialized() override;
+
+	/// <summary>
+	/// Get: Processor parallelization availability.
+	/// <para>Indicates whether parallel processing is available with this mode.
+	/// If parallel capable, input/output data arrays passed to the transform must be ParallelBlockSize in bytes to trigger parallelization.</para>
+	/// </summary>
+	const bool IsParallel() override;
+
+	/// <summary>
+	/// Get: Array of allowed cipher input key byte-sizes
+	/// </summary>
+	const  std::vector<SymmetricKeySize> &LegalKeySizes() override;
+
+	/// <summary>
+	/// Get: The maximum legal tag length in bytes
+	/// </summary>
+	const size_t MaxTagSize() override;
+
+	/// <summary>
+	/// Get: The minimum legal tag length in bytes
+	/// </summary>
+	const size_t MinTagSize() override;
+
+	/// <summary>
+	/// Get: The cipher mode name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Get: Parallel block size; the byte-size of the input/output data arrays passed to a transform that trigger parallel processing.
+	/// <para>This value can be changed through the ParallelProfile class.<para>
+	/// </summary>
+	const size_t ParallelBlockSize() override;
+
+	/// <summary>
+	/// Get/Set: Parallel and SIMD capability flags and sizes 
+	/// <para>The maximum number of threads allocated when using multi-threaded processing can be set with the ParallelMaxDegree() property.
+	/// The ParallelBlockSize() property is auto-calculated, but can be changed; the value must be evenly divisible by ParallelMinimumSize().
+	/// Changes to these values must be made before the <see cref="Initialize(SymmetricKey)"/> function is called.</para>
+	/// </summary>
+	ParallelOptions &ParallelProfile() override;
+
+	/// <summary>
+	/// Get/Set: Persist a one-time associated data for the entire session.
+	/// <para>Allows the use of a single SetAssociatedData() call to apply the MAC data to all segments.
+	/// Finalize and Verify can be called multiple times, applying the initial associated data to each finalize cycle.<para>
+	/// </summary>
+	bool &PreserveAD() override;
+
+	/// <summary>
+	/// Get: Returns the full finalized MAC code value array
+	/// </summary>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher has not been finalized</exception>
+	const std::vector<byte> Tag() override;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Initialize the Cipher Mode, creating a block cipher instance of the template type
+	/// </summary>
+	///
+	/// <param name="KdfEngineType">The ciphers HKDF key expansion digest; the default of None uses the standard key schedule</param>
+	/// <param name="Rounds">The number of cipher rounds; a value of zero uses the ciphers default</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher could not be created with these parameters</exception>
+	explicit GCMT(Digests KdfEngineType = Digests::None, size_t Rounds = 0);
+
+	/// <summary>
+	/// Initialize the Cipher Mode using a block cipher instance of the template type
+	/// </summary>
+	///
+	/// <param name="Cipher">An uninitialized Block Cipher instance; can not be null</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if a null block cipher is used</exception>
+	explicit GCMT(TCipher* Cipher);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~GCMT() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Decrypt a single block of bytes.
+	/// <para>Decrypts one block of bytes beginning at a zero index.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The input array of encrypted bytes</param>
+	/// <param name="Output">The output array of decrypted bytes</param>
+	void DecryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Decrypt a block of bytes with offset parameters.
+	/// <para>Decrypts one block of bytes using the designated offsets.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The input array of encrypted bytes</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of decrypted bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	void DecryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if state could not be destroyed</exception>
+	void Destroy() override;
+
+	/// <summary>
+	/// Encrypt a single block of bytes. 
+	/// <para>Encrypts one block of bytes beginning at a zero index.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The input array of plain text bytes</param>
+	/// <param name="Output">The output array of encrypted bytes</param>
+	void EncryptBlock(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Encrypt a block of bytes using offset parameters. 
+	/// <para>Encrypts one block of bytes using the designated offsets.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The input array of plain text bytes</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of encrypted bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	void EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Calculate the MAC code (Tag) and copy it to the Output array.   
+	/// <para>The output array must be of sufficient length to receive the MAC code.
+	/// This function finalizes the Encryption/Decryption cycle, all data must be processed before this function is called.
+	/// Initialize(bool, ISymmetricKey) must be called before the cipher can be re-used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Output">The output array that receives the authentication code</param>
+	/// <param name="Offset">Starting offset within the output array</param>
+	/// <param name="Length">The number of MAC code bytes to write to the output array.
+	/// <para>Must be no greater then the MAC functions output size, and no less than the minimum Tag size of 12 bytes.</para></param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not initialized, or output array is too small</exception>
+	void Finalize(std::vector<byte> &Output, const size_t Offset, const size_t Length) override;
+
+	/// <summary>
+	/// Initialize the Cipher instance.
+	/// <para>The legal symmetric key and nonce sizes are contained in the LegalKeySizes() property.
+	/// The Info parameter of the SymmetricKey can be used as the initial associated data.</para>
+	/// </summary>
+	/// 
+	/// <param name="Encryption">True if cipher is used for encryption, false to decrypt</param>
+	/// <param name="KeyParams">SymmetricKey containing the encryption Key and Nonce</param>
+	/// 
+	/// <exception cref="CryptoCipherModeException">Thrown if a null or invalid Key/Nonce is used</exception>
+	void Initialize(bool Encryption, ISymmetricKey &KeyParams) override;
+
+	/// <summary>
+	/// Decrypt and authenticate a batch of packets.
+	/// <para>The pre-counter blocks of every packet are encrypted together, and each packets tag is verified before it is decrypted.
+	/// The Verified member of each packet is set to the result of the tag comparison, and the output of a packet that fails authentication is zeroed, unless it overlaps the input; an in-place packet keeps its cipher-text.
+	/// The cipher must be keyed and initialized for decryption; the nonce loaded by Initialize and any message in progress are not affected.</para>
+	/// </summary>
+	/// 
+	/// <param name="Packets">The packet descriptors; each nonce must be at least 8 bytes in length</param>
+	/// <param name="TagLength">The byte length of each packets authentication tag; between 12 and 16 bytes</param>
+	/// 
+	/// <returns>Returns false if any packet fails authentication</returns>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not keyed for decryption, or a packet descriptor is invalid</exception>
+	bool Open(std::vector<AeadPacket> &Packets, const size_t TagLength) override;
+
+	/// <summary>
+	/// Set the maximum number of threads allocated when using multi-threaded processing.
+	/// <para>When set to zero, thread count is set automatically. If set to 1, sets IsParallel() to false and runs in sequential mode. 
+	/// Thread count must be an even number, and not exceed the number of processor cores.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if an invalid degree setting is used</exception>
+	void ParallelMaxDegree(size_t Degree) override;
+
+	/// <summary>
+	/// Encrypt and authenticate a batch of packets.
+	/// <para>The counter blocks of consecutive packets are staged together and encrypted with the widest SIMD transform the cipher supports,
+	/// and the authentication tag of each packet is written to its Tag array.
+	/// The cipher must be keyed and initialized for encryption; the nonce loaded by Initialize and any message in progress are not affected.</para>
+	/// </summary>
+	/// 
+	/// <param name="Packets">The packet descriptors; each nonce must be at least 8 bytes in length</param>
+	/// <param name="TagLength">The byte length of each packets authentication tag; between 12 and 16 bytes</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not keyed for encryption, or a packet descriptor is invalid</exception>
+	void Seal(std::vector<AeadPacket> &Packets, const size_t TagLength) override;
+
+	/// <summary>
+	/// Add additional data to the authentication generator.  
+	/// <para>Must be called after Initialize(bool, ISymmetricKey), and before any processing of plaintext or ciphertext input. 
+	/// This function can only be called once per each initialization/finalization cycle.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The input array of bytes to process</param>
+	/// <param name="Offset">Starting offset within the input array</param>
+	/// <param name="Length">The number of bytes to process</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not initialized</exception>
+	void SetAssociatedData(const std::vector<byte> &Input, const size_t Offset, const size_t Length) override;
+
+	/// <summary>
+	/// Add associated data stored as a list of fragments to the message authentication code generator.
+	/// <para>The fragments are joined in a staging buffer owned by this instance, passed to SetAssociatedData(Input, Offset, Length), and erased.
+	/// Must be called after Initialize(bool, ISymmetricKey), and before any processing of plaintext or ciphertext input.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of associated data fragments</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if state has been processed, or a segment exceeds its array</exception>
+	void SetAssociatedSegments(const std::vector<MemorySegment> &Input) override;
+
+	/// <summary>
+	/// Transform a length of bytes with offset parameters. 
+	/// <para>This method processes a specified length of bytes, utilizing offsets incremented by the caller.
+	/// If IsParallel() is set to true, and the length is at least ParallelBlockSize(), the transform is run in parallel processing mode.
+	/// To disable parallel processing, set the ParallelOptions().IsParallel() property to false.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The input array of bytes to transform</param>
+	/// <param name="InOffset">Starting offset within the input array</param>
+	/// <param name="Output">The output array of transformed bytes</param>
+	/// <param name="OutOffset">Starting offset within the output array</param>
+	/// <param name="Length">The number of bytes to transform</param>
+	void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) override;
+
+	/// <summary>
+	/// Transform a message stored as a list of fragments, writing the result to a second list of fragments.
+	/// <para>The two lists are processed as single contiguous messages, and may be fragmented differently.
+	/// Runs that are contiguous in both lists are passed to Transform directly; the short runs between fragment boundaries are gathered in a staging buffer owned by this instance, which is erased after each call.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of input fragments</param>
+	/// <param name="Output">The list of output fragments; the combined length must equal that of the input list</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the lists differ in length, or a segment exceeds its array</exception>
+	void TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output) override;
+
+	/// <summary>
+	/// Generate the internal MAC code and compare it with the tag contained in the Input array.   
+	/// <para>This function finalizes the Decryption cycle and generates the MAC tag.
+	/// The cipher must be set for Decryption and the cipher-text bytes fully processed before calling this function.
+	/// Verify can be called in place of a Finalize(Output, Offset, Length) call, or after finalization.
+	/// Initialize(bool, ISymmetricKey) must be called before the cipher can be re-used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The input array containing the expected authentication code</param>
+	/// <param name="Offset">Starting offset within the input array</param>
+	/// <param name="Length">The number of bytes to compare.
+	/// <para>Must be no greater then the MAC functions output size, and no less than the MinTagSize() size.</para></param>
+	/// 
+	/// <returns>Returns false if the MAC code does not match</returns>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not initialized for decryption</exception>
+	bool Verify(const std::vector<byte> &Input, const size_t Offset, const size_t Length) override;
+
+private:
+
+	void BatchCounters(std::vector<AeadPacket> &Packets);
+	void BatchHash(const AeadPacket &Packet, bool Encryption, size_t MaskOffset);
+	void BatchKeyStream(std::vector<AeadPacket> &Packets, bool Encryption);
+	void BatchScope(const std::vector<AeadPacket> &Packets, const size_t TagLength, const std::string &Origin);
+	void CalculateMac();
+	void Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
+	void Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
+	void Reset();
+	void Scope();
+	static void TransformLanes(TCipher* Cipher, const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t BlockCount);
+};
+
+NAMESPACE_MODEEND
+#endif
@@ -41,11 +41,27 @@ void GHASH::FinalizeBlock(std::vector<byte> &Output, size_t AdSize, size_t TextS
 		ProcessSegment(m_msgBuffer, 0, Output, m_msgOffset);
 	}
 
-	std::vector<byte> fnlBlock(BLOCK_SIZE);
-	Utility::IntUtils::Be64ToBytes(8 * AdSize, fnlBlock, 0);
-	Utility::IntUtils::Be64ToBytes(8 * TextSize, fnlBlock, 8);
-	Utility::MemUtils::XOR128(fnlBlock, 0, Output, 0);
+	// the message buffer has been consumed; it holds the length block
+	Utility::IntUtils::Be64ToBytes(8 * AdSize, m_msgBuffer, 0);
+	Utility::IntUtils::Be64ToBytes(8 * TextSize, m_msgBuffer, 8);
+	Utility::MemUtils::XOR128(m_msgBuffer, 0, Output, 0);
 	GcmMultiply(Output);
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	m_msgOffset = 0;
+}
+
+void GHASH::LoadState(const std::vector<byte> &State)
+{
+	LoadState(State, State.size());
+}
+
+void GHASH::LoadState(const std::vector<byte> &State, size_t Length)
+{
+	CexAssert(Length <= BLOCK_SIZE, "The state is larger than the block size");
+
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	Utility::MemUtils::Copy(State, 0, m_msgBuffer, 0, Length);
+	m_msgOffset = Length;
 }
 
 void GHASH::Reset(bool Erase)
@@ -82,6 +98,23 @@ void GHASH::ProcessSegment(const std::vector<byte> &Input, size_t InOffset, std:
 	}
 }
 
+std::vector<byte> GHASH::SaveState()
+{
+	std::vector<byte> state(m_msgOffset);
+	Utility::MemUtils::Copy(m_msgBuffer, 0, state, 0, m_msgOffset);
+
+	return state;
+}
+
+size_t GHASH::SaveState(std::vector<byte> &Output)
+{
+	CexAssert(Output.size() >= BLOCK_SIZE, "The output array is smaller than the block size");
+
+	Utility::MemUtils::Copy(m_msgBuffer, 0, Output, 0, m_msgOffset);
+
+	return m_msgOffset;
+}
+
 void GHASH::Update(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t Length)
 {
 	if (Length == 0)
@@ -58,6 +58,21 @@ public:
 	/// <param name="Erase">Erase the state</param>
 	void Reset(bool Erase = false);
 
+	/// <summary>
+	/// Restore the pending message bytes saved with the SaveState function
+	/// </summary>
+	///
+	/// <param name="State">The pending message bytes; must not exceed the block size</param>
+	void LoadState(const std::vector<byte> &State);
+
+	/// <summary>
+	/// Restore the pending message bytes copied with the SaveState(Output) function
+	/// </summary>
+	///
+	/// <param name="State">The array containing the pending message bytes</param>
+	/// <param name="Length">The number of pending bytes; must not exceed the block size</param>
+	void LoadState(const std::vector<byte> &State, size_t Length);
+
 	/// <summary>
 	/// Process a block of plaintext
 	/// </summary>
@@ -77,6 +92,22 @@ public:
 	/// <param name="Length">The number of bytes to process</param>
 	void ProcessSegment(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t Length);
 
+	/// <summary>
+	/// Get a copy of the pending (unprocessed) message bytes
+	/// </summary>
+	///
+	/// <returns>The pending message bytes</returns>
+	std::vector<byte> SaveState();
+
+	/// <summary>
+	/// Copy the pending (unprocessed) message bytes to an existing array
+	/// </summary>
+	///
+	/// <param name="Output">The destination array; must be at least the block size</param>
+	///
+	/// <returns>The number of pending bytes copied</returns>
+	size_t SaveState(std::vector<byte> &Output);
+
 	/// <summary>
 	/// Update the hash function
 	/// </summary>
@@ -2,7 +2,10 @@
 #include "BlockCipherFromName.h"
 #include "IntUtils.h"
 #include "MemUtils.h"
+#include "SegmentUtils.h"
 #include "SymmetricKey.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
 
 NAMESPACE_MAC
 
@@ -148,33 +151,34 @@ size_t GMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 
 void GMAC::Initialize(ISymmetricKey &KeyParams)
 {
-	if (KeyParams.Nonce().size() < TAG_MINLEN)
+	SymmetricKeyView keyView(KeyParams);
+
+	if (keyView.Nonce().size() < TAG_MINLEN)
 		throw CryptoMacException("GMAC:Initialize", "The length must be minimum of 12 and maximum of MAC code size!");
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), keyView.Key().size()))
 		throw CryptoMacException("GMAC:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 
 	if (m_isInitialized)
 		Reset();
 
-	if (KeyParams.Key().size() != 0)
+	if (keyView.Key().size() != 0)
 	{
-		// key the cipher and generate H
+		// key the cipher and generate H; the cleared message buffer is the zero block
 		m_blockCipher->Initialize(true, KeyParams);
-		std::vector<byte> tmpH(BLOCK_SIZE);
-		const std::vector<byte> ZEROES(BLOCK_SIZE);
-		m_blockCipher->Transform(ZEROES, 0, tmpH, 0);
+		m_blockCipher->Transform(m_msgBuffer, 0, m_msgBuffer, 0);
 
 		m_gmacKey =
 		{
-			Utility::IntUtils::BeBytesTo64(tmpH, 0),
-			Utility::IntUtils::BeBytesTo64(tmpH, 8)
+			Utility::IntUtils::BeBytesTo64(m_msgBuffer, 0),
+			Utility::IntUtils::BeBytesTo64(m_msgBuffer, 8)
 		};
 
+		Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
 		m_gmacHash = new GHASH(m_gmacKey);
 	}
 
 	// initialize the nonce
-	m_gmacNonce = KeyParams.Nonce();
+	m_gmacNonce = keyView.Nonce();
 
 	if (m_gmacNonce.size() == 12)
 	{
@@ -183,16 +187,44 @@ void GMAC::Initialize(ISymmetricKey &KeyParams)
 	}
 	else
 	{
-		std::vector<byte> y0(BLOCK_SIZE);
-		m_gmacHash->ProcessSegment(m_gmacNonce, 0, y0, m_gmacNonce.size());
-		m_gmacHash->FinalizeBlock(y0, 0, m_gmacNonce.size());
-		m_gmacNonce = y0;
+		// y0 is hashed in the message buffer
+		m_gmacHash->ProcessSegment(m_gmacNonce, 0, m_msgBuffer, m_gmacNonce.size());
+		m_gmacHash->FinalizeBlock(m_msgBuffer, 0, m_gmacNonce.size());
+		m_gmacNonce = m_msgBuffer;
+		Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
 	}
 
 	m_blockCipher->Transform(m_gmacNonce, m_gmacNonce);
 	m_isInitialized = true;
 }
 
+void GMAC::LoadState(const std::vector<byte> &State)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("GMAC:LoadState", "The Mac is not initialized!");
+	if (State.size() < 3 + sizeof(ulong) + BLOCK_SIZE)
+		throw CryptoMacException("GMAC:LoadState", "The state array is too short!");
+
+	IO::MemoryStream strm(State);
+	IO::StreamReader reader(strm);
+
+	if (reader.ReadByte() != STATE_VERSION)
+		throw CryptoMacException("GMAC:LoadState", "The state version is not supported!");
+	if (reader.ReadByte() != static_cast<byte>(Macs::GMAC))
+		throw CryptoMacException("GMAC:LoadState", "The state was not created by this Mac!");
+
+	const size_t MSGCTR = static_cast<size_t>(reader.ReadInt<ulong>());
+	std::vector<byte> code = reader.ReadBytes(BLOCK_SIZE);
+	const size_t PNDLEN = reader.ReadByte();
+
+	if (PNDLEN > BLOCK_SIZE || reader.Position() + PNDLEN != State.size())
+		throw CryptoMacException("GMAC:LoadState", "The state array is malformed!");
+
+	m_gmacHash->LoadState(reader.ReadBytes(PNDLEN));
+	Utility::MemUtils::Copy(code, 0, m_msgCode, 0, BLOCK_SIZE);
+	m_msgCounter = MSGCTR;
+}
+
 void GMAC::Reset()
 {
 	Utility::MemUtils::Clear(m_gmacNonce, 0, m_gmacNonce.size());
@@ -202,6 +234,24 @@ void GMAC::Reset()
 	m_msgOffset = 0;
 }
 
+std::vector<byte> GMAC::SaveState()
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("GMAC:SaveState", "The Mac is not initialized!");
+
+	std::vector<byte> pending = m_gmacHash->SaveState();
+	IO::StreamWriter writer(3 + sizeof(ulong) + BLOCK_SIZE + pending.size());
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Macs::GMAC));
+	writer.Write(static_cast<ulong>(m_msgCounter));
+	writer.Write(m_msgCode, 0, BLOCK_SIZE);
+	writer.Write(static_cast<byte>(pending.size()));
+	writer.Write(pending, 0, pending.size());
+
+	return writer.GetBytes();
+}
+
 void GMAC::Update(byte Input)
 {
 	m_gmacHash->Update(std::vector<byte> { Input }, 0, m_msgCode, 1);
@@ -220,6 +270,11 @@ void GMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length
 	m_msgCounter += Length;
 }
 
+void GMAC::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input);
+}
+
 void GMAC::Scope()
 {
 	m_legalKeySizes.resize(m_blockCipher->LegalKeySizes().size());
@@ -90,6 +90,7 @@ private:
 
 	static const std::string CLASS_NAME;
 	static const size_t BLOCK_SIZE = 16;
+	static const byte STATE_VERSION = 1;
 	static const size_t TAG_MINLEN = 8;
 
 	IBlockCipher* m_blockCipher;
@@ -216,11 +217,31 @@ public:
 	/// <param name="KeyParams">A SymmetricKey key container class</param>
 	void Initialize(ISymmetricKey &KeyParams) override;
 
+	/// <summary>
+	/// Restore the message state from a checkpoint created by the SaveState function.
+	/// <para>The Mac must be initialized with the same cipher, key and nonce before the state is loaded.</para>
+	/// </summary>
+	///
+	/// <param name="State">The serialized Mac state</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized, or the state is malformed or was not created by this Mac</exception>
+	void LoadState(const std::vector<byte> &State) override;
+
 	/// <summary>
 	/// Reset to the default state; Mac code and buffer are zeroised, but key is still loaded
 	/// </summary>
 	void Reset() override;
 
+	/// <summary>
+	/// Serialize the message state; the GHASH accumulator, message counter and pending input bytes.
+	/// <para>Key material is not written to the state.</para>
+	/// </summary>
+	///
+	/// <returns>The serialized Mac state</returns>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized</exception>
+	std::vector<byte> SaveState() override;
+
 	/// <summary>
 	/// Update the Mac with a single byte
 	/// </summary>
@@ -237,6 +258,14 @@ public:
 	/// <param name="Length">The length of data to process in bytes</param>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the Mac with a message stored as a list of fragments
+	/// <para>The fragments are absorbed in list order as one contiguous message; a partial block is carried across each fragment boundary, so no fragment is copied.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of message fragments</param>
+	void UpdateSegments(const std::vector<MemorySegment> &Input) override;
+
 private:
 
 	void Scope();
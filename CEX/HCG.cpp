@@ -192,16 +192,18 @@ size_t HCG::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length)
 
 void HCG::Initialize(ISymmetricKey &GenParam)
 {
-	if (GenParam.Nonce().size() != 0)
+	SymmetricKeyView keyView(GenParam);
+
+	if (keyView.Nonce().size() != 0)
 	{
-		if (GenParam.Info().size() != 0)
-			Initialize(GenParam.Key(), GenParam.Nonce(), GenParam.Info());
+		if (keyView.Info().size() != 0)
+			Initialize(keyView.Key(), keyView.Nonce(), keyView.Info());
 		else
-			Initialize(GenParam.Key(), GenParam.Nonce());
+			Initialize(keyView.Key(), keyView.Nonce());
 	}
 	else
 	{
-		Initialize(GenParam.Key());
+		Initialize(keyView.Key());
 	}
 }
 
@@ -306,6 +306,10 @@ uint HCR::GetMinimumSeedSize(Digests RngEngine)
 		return 64;
 	case Digests::Blake512:
 		return 128;
+	case Digests::Blake3:
+		return 64;
+	case Digests::K12:
+		return 168;
 	case Digests::Keccak256:
 		return 136;
 	case Digests::Keccak512:
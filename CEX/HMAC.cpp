@@ -1,6 +1,8 @@
 #include "HMAC.h"
 #include "DigestFromName.h"
 #include "IntUtils.h"
+#include "SegmentUtils.h"
+#include "StreamWriter.h"
 
 NAMESPACE_MAC
 
@@ -68,8 +70,10 @@ HMAC::HMAC(Digests DigestType, bool Parallel)
 	m_isDestroyed(false),
 	m_isInitialized(false),
 	m_legalKeySizes(0),
+	m_msgCode(m_msgDigest->DigestSize()),
 	m_msgDigestType(DigestType),
-	m_outputPad(m_msgDigest->BlockSize())
+	m_outputPad(m_msgDigest->BlockSize()),
+	m_segmentStage(0)
 {
 	Scope();
 }
@@ -82,8 +86,10 @@ HMAC::HMAC(IDigest* Digest)
 	m_isDestroyed(false),
 	m_isInitialized(false),
 	m_legalKeySizes(0),
+	m_msgCode(m_msgDigest->DigestSize()),
 	m_msgDigestType(m_msgDigest->Enumeral()),
-	m_outputPad(m_msgDigest->BlockSize())
+	m_outputPad(m_msgDigest->BlockSize()),
+	m_segmentStage(0)
 {
 	Scope();
 }
@@ -122,7 +128,9 @@ void HMAC::Destroy()
 
 		Utility::IntUtils::ClearVector(m_inputPad);
 		Utility::IntUtils::ClearVector(m_legalKeySizes);
+		Utility::IntUtils::ClearVector(m_msgCode);
 		Utility::IntUtils::ClearVector(m_outputPad);
+		Utility::IntUtils::ClearVector(m_segmentStage);
 	}
 }
 
@@ -133,10 +141,10 @@ size_t HMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 	if (Output.size() - OutOffset < m_msgDigest->DigestSize())
 		throw CryptoMacException("HMAC:Finalize", "The Output buffer is too short!");
 
-	std::vector<byte> tmpV(m_msgDigest->DigestSize(), 0);
-	m_msgDigest->Finalize(tmpV, 0);
+	m_msgDigest->Finalize(m_msgCode, 0);
 	m_msgDigest->Update(m_outputPad, 0, m_outputPad.size());
-	m_msgDigest->Update(tmpV, 0, tmpV.size());
+	m_msgDigest->Update(m_msgCode, 0, m_msgCode.size());
+	Utility::MemUtils::Clear(m_msgCode, 0, m_msgCode.size());
 
 	size_t msgLen = m_msgDigest->Finalize(Output, OutOffset);
 	m_msgDigest->Reset(); // TODO: still necessary?
@@ -147,11 +155,13 @@ size_t HMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
 
 void HMAC::Initialize(ISymmetricKey &KeyParams)
 {
+	SymmetricKeyView keyView(KeyParams);
+
 	// TODO: to enforce good security, this should be at least digest output size, keccak and hmac tests are causing it to throw.. find a solution
-	if (KeyParams.Key().size() == 0)
+	if (keyView.Key().size() == 0)
 		throw CryptoMacException("HMAC:Initialize", "Key size is too small; should be a minimum of digest output size!");
 
-	size_t keyLen = KeyParams.Key().size();
+	size_t keyLen = keyView.Key().size();
 
 	if (!m_isInitialized)
 		m_msgDigest->Reset();
@@ -160,13 +170,13 @@ void HMAC::Initialize(ISymmetricKey &KeyParams)
 
 	if (keyLen > m_msgDigest->BlockSize())
 	{
-		m_msgDigest->Update(KeyParams.Key(), 0, KeyParams.Key().size());
+		m_msgDigest->Update(keyView.Key(), 0, keyView.Key().size());
 		m_msgDigest->Finalize(m_inputPad, 0);
 		keyLen = m_msgDigest->DigestSize();
 	}
 	else
 	{
-		Utility::MemUtils::Copy(KeyParams.Key(), 0, m_inputPad, 0, keyLen);
+		Utility::MemUtils::Copy(keyView.Key(), 0, m_inputPad, 0, keyLen);
 	}
 
 	if ((int)m_msgDigest->BlockSize() - (int)keyLen > 0)
@@ -180,6 +190,22 @@ void HMAC::Initialize(ISymmetricKey &KeyParams)
 	m_isInitialized = true;
 }
 
+void HMAC::LoadState(const std::vector<byte> &State)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("HMAC:LoadState", "The Mac has not been initialized!");
+	if (State.size() < 2)
+		throw CryptoMacException("HMAC:LoadState", "The state array is too short!");
+	if (State[0] != STATE_VERSION)
+		throw CryptoMacException("HMAC:LoadState", "The state version is not supported!");
+	if (State[1] != static_cast<byte>(Macs::HMAC))
+		throw CryptoMacException("HMAC:LoadState", "The state was not created by this Mac!");
+
+	std::vector<byte> dgtState(State.size() - 2);
+	Utility::MemUtils::Copy(State, 2, dgtState, 0, dgtState.size());
+	m_msgDigest->LoadState(dgtState);
+}
+
 void HMAC::ParallelMaxDegree(size_t Degree)
 {
 	try
@@ -202,6 +228,21 @@ void HMAC::Reset()
 	m_isInitialized = false;
 }
 
+std::vector<byte> HMAC::SaveState()
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("HMAC:SaveState", "The Mac has not been initialized!");
+
+	std::vector<byte> dgtState = m_msgDigest->SaveState();
+	IO::StreamWriter writer(2 + dgtState.size());
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Macs::HMAC));
+	writer.Write(dgtState, 0, dgtState.size());
+
+	return writer.GetBytes();
+}
+
 void HMAC::Update(byte Input)
 {
 	m_msgDigest->Update(Input);
@@ -217,6 +258,11 @@ void HMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length
 	m_msgDigest->Update(Input, InOffset, Length);
 }
 
+void HMAC::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input, m_segmentStage);
+}
+
 //~~~Private Functions~~~//
 
 void HMAC::Scope()
@@ -91,6 +91,7 @@ private:
 	static const std::string CLASS_NAME;
 	static const byte IPAD = 0x36;
 	static const byte OPAD = 0x5C;
+	static const byte STATE_VERSION = 1;
 
 	IDigest* m_msgDigest;
 	bool m_destroyEngine;
@@ -98,8 +99,10 @@ private:
 	bool m_isInitialized;
 	std::vector<byte> m_inputPad;
 	std::vector<SymmetricKeySize> m_legalKeySizes;
+	std::vector<byte> m_msgCode;
 	Digests m_msgDigestType;
 	std::vector<byte> m_outputPad;
+	std::vector<byte> m_segmentStage;
 
 public:
 
@@ -231,6 +234,16 @@ public:
 	/// <param name="KeyParams">A SymmetricKey key container class</param>
 	void Initialize(ISymmetricKey &KeyParams) override;
 
+	/// <summary>
+	/// Restore the message state from a checkpoint created by the SaveState function.
+	/// <para>The Mac must be initialized with the same key and digest settings before the state is loaded.</para>
+	/// </summary>
+	///
+	/// <param name="State">The serialized Mac state</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized, or the state is malformed or was not created by this Mac</exception>
+	void LoadState(const std::vector<byte> &State) override;
+
 	/// <summary>
 	/// Set the number of threads allocated when using multi-threaded tree hashing processing.
 	/// <para>Thread count must be an even number, and not exceed the number of processor cores.
@@ -247,6 +260,16 @@ public:
 	/// </summary>
 	void Reset() override;
 
+	/// <summary>
+	/// Serialize the message state; the serialized state of the keyed inner digest.
+	/// <para>Key material is not written to the state.</para>
+	/// </summary>
+	///
+	/// <returns>The serialized Mac state</returns>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized</exception>
+	std::vector<byte> SaveState() override;
+
 	/// <summary>
 	/// Update the Mac with a single byte
 	/// </summary>
@@ -263,6 +286,14 @@ public:
 	/// <param name="Length">The length of data to process in bytes</param>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the Mac with a message stored as a list of fragments
+	/// <para>The fragments are absorbed in list order as one contiguous message; a partial block is carried across each fragment boundary, so no fragment is copied.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of message fragments</param>
+	void UpdateSegments(const std::vector<MemorySegment> &Input) override;
+
 private:
 
 	void Scope();
@@ -21,6 +21,7 @@
 
 #include "CexDomain.h"
 #include "AeadModes.h"
+#include "AeadPacket.h"
 #include "ICipherMode.h"
 
 NAMESPACE_MODE
@@ -101,6 +102,33 @@ public:
 	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not initialized, or output array is too small</exception>
 	virtual void Finalize(std::vector<byte> &Output, const size_t Offset, const size_t Length) = 0;
 
+	/// <summary>
+	/// Decrypt and authenticate a batch of packets.
+	/// <para>Each packet is processed with its own nonce and associated data, and its Verified member is set to the result of the tag comparison.
+	/// The output of a packet that fails authentication is zeroed, unless it overlaps the input; an in-place packet keeps its cipher-text.
+	/// The cipher must be keyed and initialized for decryption; the nonce loaded by Initialize and any message in progress are not affected.</para>
+	/// </summary>
+	/// 
+	/// <param name="Packets">The packet descriptors</param>
+	/// <param name="TagLength">The byte length of each packets authentication tag</param>
+	/// 
+	/// <returns>Returns false if any packet fails authentication</returns>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not keyed for decryption, or a packet descriptor is invalid</exception>
+	virtual bool Open(std::vector<AeadPacket> &Packets, const size_t TagLength) = 0;
+
+	/// <summary>
+	/// Encrypt and authenticate a batch of packets.
+	/// <para>Each packet is processed with its own nonce and associated data, and the authentication tag is written to the packets Tag array.
+	/// The cipher must be keyed and initialized for encryption; the nonce loaded by Initialize and any message in progress are not affected.</para>
+	/// </summary>
+	/// 
+	/// <param name="Packets">The packet descriptors</param>
+	/// <param name="TagLength">The byte length of each packets authentication tag</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the cipher is not keyed for encryption, or a packet descriptor is invalid</exception>
+	virtual void Seal(std::vector<AeadPacket> &Packets, const size_t TagLength) = 0;
+
 	/// <summary>
 	/// Add additional data to the authentication generator.  
 	/// <para>Must be called after Initialize(bool, ISymmetricKey), and before any processing of plaintext or ciphertext input. 
@@ -114,6 +142,18 @@ public:
 	/// <exception cref="Exception::CryptoCipherModeException">Thrown if state has been processed</exception>
 	virtual void SetAssociatedData(const std::vector<byte> &Input, const size_t Offset, const size_t Length) = 0;
 
+	/// <summary>
+	/// Add associated data stored as a list of fragments to the message authentication code generator.
+	/// <para>The associated data is processed as a single contiguous array, and may only be added once, before the message is processed.
+	/// The modes absorb the associated data in a single call, so the fragments are joined in a staging array owned by the mode instance before they are passed to SetAssociatedData(Input, Offset, Length).
+	/// The staging array is erased once the data has been absorbed.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of associated data fragments</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if state has been processed</exception>
+	virtual void SetAssociatedSegments(const std::vector<MemorySegment> &Input) = 0;
+
 	/// <summary>
 	/// Generate the internal MAC code and compare it with the tag contained in the Input array.   
 	/// <para>This function finalizes the Decryption cycle and generates the MAC tag.
@@ -33,6 +33,7 @@ using Exception::CryptoSymmetricCipherException;
 using Enumeration::Digests;
 using Digest::IDigest;
 using Key::Symmetric::ISymmetricKey;
+using Key::Symmetric::SymmetricKeyView;
 using Key::Symmetric::SymmetricKeySize;
 
 /// <summary>
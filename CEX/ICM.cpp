@@ -3,6 +3,7 @@
 #include "IntUtils.h"
 #include "ParallelUtils.h"
 #include "MemUtils.h"
+#include "SegmentUtils.h"
 
 NAMESPACE_MODE
 
@@ -77,7 +78,10 @@ ICM::ICM(BlockCiphers CipherType)
 	m_isEncryption(false),
 	m_isInitialized(false),
 	m_isLoaded(false),
-	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
+	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0),
+	m_thdBuffer(0),
+	m_thdCounter(0)
 {
 }
 
@@ -91,7 +95,10 @@ ICM::ICM(IBlockCipher* Cipher)
 	m_isEncryption(false),
 	m_isInitialized(false),
 	m_isLoaded(false),
-	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true)
+	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0),
+	m_thdBuffer(0),
+	m_thdCounter(0)
 {
 	if (m_blockCipher->BlockSize() != 16)
 		throw CryptoCipherModeException("ICM:CTor", "This mode only supports a 16 byte block size!");
@@ -134,6 +141,9 @@ void ICM::Destroy()
 		}
 
 		Utility::IntUtils::ClearVector(m_ctrVector);
+		Utility::IntUtils::ClearVector(m_segmentStage);
+		Utility::IntUtils::ClearVector(m_thdBuffer);
+		Utility::IntUtils::ClearVector(m_thdCounter);
 	}
 }
 
@@ -149,7 +159,9 @@ void ICM::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void ICM::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size(), KeyParams.Nonce().size()))
+	SymmetricKeyView keyView(KeyParams);
+
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), keyView.Key().size(), keyView.Nonce().size()))
 		throw CryptoSymmetricCipherException("ICM:Initialize", "Invalid key or nonce size! Key and nonce must be one of the LegalKeySizes() members in length.");
 	if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || m_parallelProfile.ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
 		throw CryptoSymmetricCipherException("ICM:Initialize", "The parallel block size is out of bounds!");
@@ -158,7 +170,7 @@ void ICM::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 
 	Scope();
 	m_blockCipher->Initialize(true, KeyParams);
-	Utility::MemUtils::COPY128(KeyParams.Nonce(), 0, m_ctrVector, 0);
+	Utility::MemUtils::COPY128(keyView.Nonce(), 0, m_ctrVector, 0);
 	m_isEncryption = Encryption;
 	m_isInitialized = true;
 }
@@ -173,6 +185,7 @@ void ICM::ParallelMaxDegree(size_t Degree)
 		throw CryptoCipherModeException("ICM:ParallelMaxDegree", "Parallel degree can not exceed processor count!");
 
 	m_parallelProfile.SetMaxDegree(Degree);
+	Reserve();
 }
 
 void ICM::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
@@ -186,6 +199,11 @@ void ICM::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 		ProcessSequential(Input, InOffset, Output, OutOffset, Length);
 }
 
+void ICM::TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output)
+{
+	Utility::SegmentUtils::Transform(this, Input, Output, m_segmentStage);
+}
+
 //~~~Private Functions~~~//
 
 void ICM::Convert(const std::vector<ulong> &Input, std::vector<byte> &Output, size_t OutOffset)
@@ -198,14 +216,13 @@ void ICM::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
 
-	std::vector<byte> tmpCtr(BLOCK_SIZE);
-	Convert(m_ctrVector, tmpCtr, 0);
-	m_blockCipher->EncryptBlock(tmpCtr, 0, Output, OutOffset);
+	Convert(m_ctrVector, m_thdBuffer[0], 0);
+	m_blockCipher->EncryptBlock(m_thdBuffer[0], 0, Output, OutOffset);
 	Utility::IntUtils::LeIncrementW(m_ctrVector);
 	Utility::MemUtils::XOR128(Input, InOffset, Output, OutOffset);
 }
 
-void ICM::Generate(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<ulong> &Counter)
+void ICM::Generate(std::vector<byte> &Output, const size_t OutOffset, const size_t Length, std::vector<ulong> &Counter, std::vector<byte> &Buffer)
 {
 	size_t blkCtr = 0;
 
@@ -214,44 +231,43 @@ void ICM::Generate(std::vector<byte> &Output, const size_t OutOffset, const size
 	if (Length >= AVX512BLK)
 	{
 		const size_t PBKALN = Length - (Length % AVX512BLK);
-		std::vector<byte> ctrBlk(AVX512BLK);
 
 		// stagger counters and process 8 blocks with avx
 		while (blkCtr != PBKALN)
 		{
-			Convert(Counter, ctrBlk, 0);
+			Convert(Counter, Buffer, 0);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 16);
+			Convert(Counter, Buffer, 16);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 32);
+			Convert(Counter, Buffer, 32);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 48);
+			Convert(Counter, Buffer, 48);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 64);
+			Convert(Counter, Buffer, 64);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 80);
+			Convert(Counter, Buffer, 80);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 96);
+			Convert(Counter, Buffer, 96);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 112);
+			Convert(Counter, Buffer, 112);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 128);
+			Convert(Counter, Buffer, 128);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 144);
+			Convert(Counter, Buffer, 144);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 160);
+			Convert(Counter, Buffer, 160);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 176);
+			Convert(Counter, Buffer, 176);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 192);
+			Convert(Counter, Buffer, 192);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 208);
+			Convert(Counter, Buffer, 208);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 224);
+			Convert(Counter, Buffer, 224);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 240);
+			Convert(Counter, Buffer, 240);
 			Utility::IntUtils::LeIncrementW(Counter);
-			m_blockCipher->Transform2048(ctrBlk, 0, Output, OutOffset + blkCtr);
+			m_blockCipher->Transform2048(Buffer, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVX512BLK;
 		}
 	}
@@ -260,28 +276,27 @@ void ICM::Generate(std::vector<byte> &Output, const size_t OutOffset, const size
 	if (Length >= AVX2BLK)
 	{
 		const size_t PBKALN = Length - (Length % AVX2BLK);
-		std::vector<byte> ctrBlk(AVX2BLK);
 
 		// stagger counters and process 8 blocks with avx
 		while (blkCtr != PBKALN)
 		{
-			Convert(Counter, ctrBlk, 0);
+			Convert(Counter, Buffer, 0);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 16);
+			Convert(Counter, Buffer, 16);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 32);
+			Convert(Counter, Buffer, 32);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 48);
+			Convert(Counter, Buffer, 48);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 64);
+			Convert(Counter, Buffer, 64);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 80);
+			Convert(Counter, Buffer, 80);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 96);
+			Convert(Counter, Buffer, 96);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 112);
+			Convert(Counter, Buffer, 112);
 			Utility::IntUtils::LeIncrementW(Counter);
-			m_blockCipher->Transform1024(ctrBlk, 0, Output, OutOffset + blkCtr);
+			m_blockCipher->Transform1024(Buffer, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVX2BLK;
 		}
 	}
@@ -290,43 +305,41 @@ void ICM::Generate(std::vector<byte> &Output, const size_t OutOffset, const size
 	if (Length >= AVXBLK)
 	{
 		const size_t PBKALN = Length - (Length % AVXBLK);
-		std::vector<byte> ctrBlk(AVXBLK);
 
 		// 4 blocks with sse
 		while (blkCtr != PBKALN)
 		{
-			Convert(Counter, ctrBlk, 0);
+			Convert(Counter, Buffer, 0);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 16);
+			Convert(Counter, Buffer, 16);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 32);
+			Convert(Counter, Buffer, 32);
 			Utility::IntUtils::LeIncrementW(Counter);
-			Convert(Counter, ctrBlk, 48);
+			Convert(Counter, Buffer, 48);
 			Utility::IntUtils::LeIncrementW(Counter);
-			m_blockCipher->Transform512(ctrBlk, 0, Output, OutOffset + blkCtr);
+			m_blockCipher->Transform512(Buffer, 0, Output, OutOffset + blkCtr);
 			blkCtr += AVXBLK;
 		}
 	}
 #endif
 
 	const size_t ALNBLK = Length - (Length % BLOCK_SIZE);
-	std::vector<byte> tmpCtr(BLOCK_SIZE);
 
 	while (blkCtr != ALNBLK)
 	{
-		Convert(Counter, tmpCtr, 0);
-		m_blockCipher->EncryptBlock(tmpCtr, 0, Output, OutOffset + blkCtr);
+		Convert(Counter, Buffer, 0);
+		m_blockCipher->EncryptBlock(Buffer, 0, Output, OutOffset + blkCtr);
 		Utility::IntUtils::LeIncrementW(Counter);
 		blkCtr += BLOCK_SIZE;
 	}
 
 	if (blkCtr != Length)
 	{
-		std::vector<byte> tmp(BLOCK_SIZE);
-		Convert(Counter, tmpCtr, 0);
-		m_blockCipher->EncryptBlock(tmpCtr, 0, tmp, 0);
+		// the counter block is encrypted in place
+		Convert(Counter, Buffer, 0);
+		m_blockCipher->EncryptBlock(Buffer, 0, Buffer, 0);
 		const size_t FNLSZE = Length % BLOCK_SIZE;
-		Utility::MemUtils::Copy(tmp, 0, Output, OutOffset + (Length - FNLSZE), FNLSZE);
+		Utility::MemUtils::Copy(Buffer, 0, Output, OutOffset + (Length - FNLSZE), FNLSZE);
 		Utility::IntUtils::LeIncrementW(Counter);
 	}
 }
@@ -336,33 +349,33 @@ void ICM::ProcessParallel(const std::vector<byte> &Input, const size_t InOffset,
 	const size_t OUTSZE = Output.size() - OutOffset < Length ? Output.size() - OutOffset : Length;
 	const size_t CNKSZE = m_parallelProfile.ParallelBlockSize() / m_parallelProfile.ParallelMaxDegree();
 	const size_t CTRLEN = (CNKSZE / BLOCK_SIZE);
-	std::vector<ulong> tmpCtr(m_ctrVector.size());
 
-	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, &tmpCtr, CNKSZE, CTRLEN](size_t i)
+	// the degree may have been changed through the parallel profile
+	if (m_thdCounter.size() < m_parallelProfile.ParallelMaxDegree())
+		Reserve();
+
+	// with NUMA placement, each chunk runs on the node that holds its output pages
+	const byte* NUMPTR = m_parallelProfile.IsNumaAware() ? Output.data() + OutOffset : nullptr;
+
+	Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), NUMPTR, CNKSZE, [this, &Input, InOffset, &Output, OutOffset, CNKSZE, CTRLEN](size_t i)
 	{
-		// thread level counter
-		std::vector<ulong> thdCtr(2, 0);
-		// offset counter by chunk size / block size  
-		Utility::IntUtils::LeIncreaseW(m_ctrVector, thdCtr, CTRLEN * i);
+		// offset the thread counter by chunk size / block size
+		Utility::IntUtils::LeIncreaseW(m_ctrVector, m_thdCounter[i], CTRLEN * i);
 		// generate random at output array offset
-		this->Generate(Output, OutOffset + (i * CNKSZE), CNKSZE, thdCtr);
+		this->Generate(Output, OutOffset + (i * CNKSZE), CNKSZE, m_thdCounter[i], m_thdBuffer[i]);
 		// xor with input at offsets
 		Utility::MemUtils::XorBlock(Input, InOffset + (i * CNKSZE), Output, OutOffset + (i * CNKSZE), CNKSZE);
-
-		// store last counter
-		if (i == m_parallelProfile.ParallelMaxDegree() - 1)
-			Utility::MemUtils::COPY128(thdCtr, 0, tmpCtr, 0);
 	});
 
 	// copy last counter to class variable
-	Utility::MemUtils::COPY128(tmpCtr, 0, m_ctrVector, 0);
+	Utility::MemUtils::COPY128(m_thdCounter[m_parallelProfile.ParallelMaxDegree() - 1], 0, m_ctrVector, 0);
 
 	// last block processing
 	const size_t ALNSZE = CNKSZE * m_parallelProfile.ParallelMaxDegree();
 	if (ALNSZE < OUTSZE)
 	{
 		size_t fnlSize = (Output.size() - OutOffset) % ALNSZE;
-		Generate(Output, ALNSZE, fnlSize, m_ctrVector);
+		Generate(Output, ALNSZE, fnlSize, m_ctrVector, m_thdBuffer[0]);
 
 		for (size_t i = ALNSZE; i < OUTSZE; i++)
 			Output[i] ^= Input[i];
@@ -372,7 +385,7 @@ void ICM::ProcessParallel(const std::vector<byte> &Input, const size_t InOffset,
 void ICM::ProcessSequential(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
 	// generate random
-	Generate(Output, OutOffset, Length, m_ctrVector);
+	Generate(Output, OutOffset, Length, m_ctrVector, m_thdBuffer[0]);
 	// get block aligned
 	size_t ALNSZE = Length - (Length % m_blockCipher->BlockSize());
 
@@ -387,10 +400,21 @@ void ICM::ProcessSequential(const std::vector<byte> &Input, const size_t InOffse
 	}
 }
 
+void ICM::Reserve()
+{
+	// one counter and staging buffer per thread; sized here so the transform never allocates
+	const size_t THDCNT = Utility::IntUtils::Max(m_parallelProfile.ParallelMaxDegree(), static_cast<size_t>(1));
+
+	m_thdBuffer.resize(THDCNT, std::vector<byte>(STAGE_SIZE));
+	m_thdCounter.resize(THDCNT, std::vector<ulong>(2));
+}
+
 void ICM::Scope()
 {
 	if (!m_parallelProfile.IsDefault())
 		m_parallelProfile.Calculate();
+
+	Reserve();
 }
 
 NAMESPACE_MODEEND
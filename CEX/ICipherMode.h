@@ -24,6 +24,8 @@
 #include "CipherModes.h"
 #include "CryptoCipherModeException.h"
 #include "IBlockCipher.h"
+#include "MemorySegment.h"
+#include "MutableSegment.h"
 #include "ParallelOptions.h"
 #include "SymmetricKeySize.h"
 
@@ -34,6 +36,9 @@ using Enumeration::CipherModes;
 using Exception::CryptoCipherModeException;
 using Block::IBlockCipher;
 using Key::Symmetric::ISymmetricKey;
+using Key::Symmetric::SymmetricKeyView;
+using Common::MemorySegment;
+using Common::MutableSegment;
 using Common::ParallelOptions;
 using Key::Symmetric::SymmetricKeySize;
 
@@ -207,6 +212,21 @@ public:
 	/// <param name="OutOffset">Starting offset within the output array</param>
 	/// <param name="Length">The number of bytes to transform</param>
 	virtual void Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length) = 0;
+
+	/// <summary>
+	/// Transform a message stored as a list of fragments, writing the result to a second list of fragments.
+	/// <para>The input and output lists are processed as single contiguous messages, and may be fragmented differently.
+	/// Runs that are contiguous in both lists are transformed directly in parallel block sized steps, so that the wide and parallel paths of Transform are used without copying.
+	/// The short runs between fragment boundaries are gathered into one parallel block sized transform, so the mode state carries across each boundary;
+	/// the staging buffer for these runs is owned by the mode instance, and is erased after each call.
+	/// Initialize(bool, ISymmetricKey) must be called before this method can be used.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of input fragments</param>
+	/// <param name="Output">The list of output fragments; the combined length must equal that of the input list</param>
+	///
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if the lists differ in length, or a segment exceeds its array</exception>
+	virtual void TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output) = 0;
 };
 
 NAMESPACE_MODEEND
@@ -4,12 +4,14 @@
 #include "CexDomain.h"
 #include "CryptoDigestException.h"
 #include "Digests.h"
+#include "MemorySegment.h"
 #include "ParallelOptions.h"
 
 NAMESPACE_DIGEST
 
 using Exception::CryptoDigestException;
 using Enumeration::Digests;
+using Common::MemorySegment;
 using Common::ParallelOptions;
 
 /// <summary>
@@ -102,6 +104,17 @@ public:
 	/// <returns>Size of Hash value</returns>
 	virtual size_t Finalize(std::vector<byte> &Output, const size_t OutOffset) = 0;
 
+	/// <summary>
+	/// Restore the internal state from a checkpoint created by the SaveState function.
+	/// <para>The digest must be constructed with the same parameters (and tree configuration) as the instance that created the state.
+	/// Hashing resumes from the checkpoint; subsequent Update and Finalize calls produce the same output as an uninterrupted digest.</para>
+	/// </summary>
+	///
+	/// <param name="State">The serialized digest state</param>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the state version, digest type, or tree configuration do not match this instance</exception>
+	virtual void LoadState(const std::vector<byte> &State) = 0;
+
 	/// <summary>
 	/// Set the number of threads allocated when using multi-threaded tree hashing processing.
 	/// <para>Thread count must be an even number, and not exceed the number of processor cores.
@@ -116,6 +129,15 @@ public:
 	/// </summary>
 	virtual void Reset() = 0;
 
+	/// <summary>
+	/// Serialize the internal state; the pending message buffer, byte counters, and the chaining values of every tree leaf.
+	/// <para>The state is versioned, and can be restored with the LoadState function to resume hashing after a checkpoint.
+	/// The state contains the partial message, and should be treated as sensitive data.</para>
+	/// </summary>
+	///
+	/// <returns>The serialized digest state</returns>
+	virtual std::vector<byte> SaveState() = 0;
+
 	/// <summary>
 	/// Update the message digest with a single byte
 	/// </summary>
@@ -131,6 +153,16 @@ public:
 	/// <param name="InOffset">The starting offset within the Input array</param>
 	/// <param name="Length">Amount of data to process in bytes</param>
 	virtual void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) = 0;
+
+	/// <summary>
+	/// Update the buffer with a message stored as a list of fragments
+	/// <para>The fragments are absorbed in list order as one contiguous message.
+	/// The digest carries a partial block across each fragment boundary in its own buffer, so no fragment is copied to join it with the next.
+	/// Update(Input, InOffset, Length) is called once for each fragment.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of message fragments</param>
+	virtual void UpdateSegments(const std::vector<MemorySegment> &Input) = 0;
 };
 
 NAMESPACE_DIGESTEND
@@ -15,6 +15,7 @@ using Exception::CryptoGeneratorException;
 using Enumeration::Drbgs;
 using Provider::IProvider;
 using Key::Symmetric::ISymmetricKey;
+using Key::Symmetric::SymmetricKeyView;
 using Enumeration::Providers;
 using Key::Symmetric::SymmetricKeySize;
 
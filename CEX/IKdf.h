@@ -11,6 +11,7 @@ NAMESPACE_KDF
 
 using Enumeration::Kdfs;
 using Key::Symmetric::ISymmetricKey;
+using Key::Symmetric::SymmetricKeyView;
 using Exception::CryptoKdfException;
 using Key::Symmetric::SymmetricKeySize;
 
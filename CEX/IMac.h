@@ -5,13 +5,16 @@
 #include "CryptoMacException.h"
 #include "ISymmetricKey.h"
 #include "Macs.h"
+#include "MemorySegment.h"
 #include "SymmetricKeySize.h"
 
 NAMESPACE_MAC
 
 using Exception::CryptoMacException;
 using Key::Symmetric::ISymmetricKey;
+using Key::Symmetric::SymmetricKeyView;
 using Enumeration::Macs;
+using Common::MemorySegment;
 using Key::Symmetric::SymmetricKeySize;
 
 /// <summary>
@@ -97,11 +100,33 @@ public:
 	/// <param name="KeyParams">A SymmetricKey key container class</param>
 	virtual void Initialize(ISymmetricKey &KeyParams) = 0;
 
+	/// <summary>
+	/// Restore the internal state from a checkpoint created by the SaveState function.
+	/// <para>The Mac must be initialized with the same key parameters as the instance that created the state before the state is loaded;
+	/// processing resumes from the checkpoint, and subsequent Update and Finalize calls produce the same code as an uninterrupted Mac.</para>
+	/// </summary>
+	///
+	/// <param name="State">The serialized Mac state</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized, or the state version or Mac type do not match this instance</exception>
+	virtual void LoadState(const std::vector<byte> &State) = 0;
+
 	/// <summary>
 	/// Reset to the default state; Mac code and buffer are zeroised, but key is still loaded
 	/// </summary>
 	virtual void Reset() = 0;
 
+	/// <summary>
+	/// Serialize the internal message state; the pending input bytes, counters and chaining values.
+	/// <para>Key material is not written to the state; the Mac must be initialized with the same key before the state is restored with LoadState.
+	/// The state is derived from the key and message, and should be treated as sensitive data.</para>
+	/// </summary>
+	///
+	/// <returns>The serialized Mac state</returns>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized</exception>
+	virtual std::vector<byte> SaveState() = 0;
+
 	/// <summary>
 	/// Update the Mac with a single byte
 	/// </summary>
@@ -117,6 +142,16 @@ public:
 	/// <param name="InOffset">Starting position with the input array</param>
 	/// <param name="Length">The length of data to process in bytes</param>
 	virtual void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) = 0;
+
+	/// <summary>
+	/// Update the Mac with a message stored as a list of fragments
+	/// <para>The fragments are absorbed in list order as one contiguous message;
+	/// a partial block is carried across each fragment boundary by the Mac, so no fragment is copied to join it with the next.
+	/// Update(Input, InOffset, Length) is called once for each fragment.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of message fragments</param>
+	virtual void UpdateSegments(const std::vector<MemorySegment> &Input) = 0;
 };
 
 NAMESPACE_MACEND
@@ -15,6 +15,7 @@ NAMESPACE_STREAM
 using Exception::CryptoSymmetricCipherException;
 using Utility::IntUtils;
 using Key::Symmetric::ISymmetricKey;
+using Key::Symmetric::SymmetricKeyView;
 using Common::ParallelOptions;
 using Enumeration::StreamCiphers;
 using Key::Symmetric::SymmetricKeySize;
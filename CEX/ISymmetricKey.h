@@ -11,12 +11,17 @@ NAMESPACE_SYMMETRICKEY
 using Exception::CryptoProcessingException;
 using IO::MemoryStream;
 
+class SymmetricKeyView;
+
 /// <summary>
 /// Symmetric Key virtual interface class.
-/// <para>Provides virtual interfaces for the symmetric key classes.</para>
+/// <para>Provides virtual interfaces for the symmetric key classes.
+/// The Key(), Nonce() and Info() properties return copies; engines read the key material without a copy through a SymmetricKeyView.</para>
 /// </summary>
 class ISymmetricKey
 {
+	friend class SymmetricKeyView;
+
 public:
 
 	//~~~Constructor~~~//
@@ -68,6 +73,113 @@ public:
 	/// 
 	/// <returns>Returns true if equal</returns>
 	virtual bool Equals(ISymmetricKey &Input) = 0;
+
+protected:
+
+	/// <summary>
+	/// Get: A reference to the personalization string; only valid while the key is unlocked
+	/// </summary>
+	virtual const std::vector<byte> &BorrowInfo() = 0;
+
+	/// <summary>
+	/// Get: A reference to the primary key; only valid while the key is unlocked
+	/// </summary>
+	virtual const std::vector<byte> &BorrowKey() = 0;
+
+	/// <summary>
+	/// Get: A reference to the nonce; only valid while the key is unlocked
+	/// </summary>
+	virtual const std::vector<byte> &BorrowNonce() = 0;
+
+	/// <summary>
+	/// Release one unlock of the key material; the last release clears any plaintext copy
+	/// </summary>
+	virtual void Lock() = 0;
+
+	/// <summary>
+	/// Make the key material readable through the Borrow functions; calls are counted, and must be paired with Lock()
+	/// </summary>
+	virtual void Unlock() = 0;
+};
+
+/// <summary>
+/// A scoped, read-only view of the key material in an ISymmetricKey.
+/// <para>The view borrows the keys internal arrays instead of copying them; a SymmetricSecureKey is decrypted once when the view is created, and the plaintext is erased when the last view on the key goes out of scope.
+/// A view must not outlive the key it was created from, and the references it returns must not be kept beyond the lifetime of the view.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Read the key in an Initialize function:</description>
+/// <code>
+/// SymmetricKeyView kv(KeyParams);
+/// if (kv.Key().size() != 32)
+///		throw CryptoSymmetricCipherException("Cipher:Initialize", "Invalid key size!");
+/// ExpandKey(kv.Key());
+/// </code>
+/// </example>
+class SymmetricKeyView
+{
+private:
+
+	ISymmetricKey* m_keyParams;
+
+public:
+
+	SymmetricKeyView() = delete;
+	SymmetricKeyView(const SymmetricKeyView&) = delete;
+	SymmetricKeyView& operator=(const SymmetricKeyView&) = delete;
+
+	/// <summary>
+	/// Unlock a key and create the view
+	/// </summary>
+	///
+	/// <param name="KeyParams">The symmetric key; must remain valid for the lifetime of the view</param>
+	explicit SymmetricKeyView(ISymmetricKey &KeyParams)
+		:
+		m_keyParams(&KeyParams)
+	{
+		m_keyParams->Unlock();
+	}
+
+	/// <summary>
+	/// Release the view, and lock the key
+	/// </summary>
+	~SymmetricKeyView()
+	{
+		m_keyParams->Lock();
+	}
+
+	/// <summary>
+	/// Get: A read-only reference to the personalization string
+	/// </summary>
+	const std::vector<byte> &Info()
+	{
+		return m_keyParams->BorrowInfo();
+	}
+
+	/// <summary>
+	/// Get: A read-only reference to the primary key
+	/// </summary>
+	const std::vector<byte> &Key()
+	{
+		return m_keyParams->BorrowKey();
+	}
+
+	/// <summary>
+	/// Get: The SymmetricKeySize containing the byte sizes of the key, nonce, and info state members
+	/// </summary>
+	const SymmetricKeySize KeySizes()
+	{
+		return m_keyParams->KeySizes();
+	}
+
+	/// <summary>
+	/// Get: A read-only reference to the nonce
+	/// </summary>
+	const std::vector<byte> &Nonce()
+	{
+		return m_keyParams->BorrowNonce();
+	}
 };
 
 NAMESPACE_SYMMETRICKEYEND
@@ -122,8 +122,8 @@ public:
 	/*! \cond PRIVATE */
 	CEX_OPTIMIZE_IGNORE
 	/*! \endcond */
-	template <typename T>
-	inline static void ClearVector(std::vector<T> &Input)
+	template <typename T, typename Allocator>
+	inline static void ClearVector(std::vector<T, Allocator> &Input)
 	{
 		if (Input.capacity() == 0)
 		{
@@ -132,7 +132,7 @@ public:
 
 		if (Input.size() != 0)
 		{
-			std::memset(Input.data(), 0, Input.size() * sizeof(T));
+			MemUtils::SecureErase(Input, 0, Input.size() * sizeof(T));
 		}
 
 		Input.clear();
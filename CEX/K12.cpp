@@ -0,0 +1,498 @@
+#include "K12.h"
+#include "IntUtils.h"
+#include "Keccak.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+#include "SegmentUtils.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
+
+NAMESPACE_DIGEST
+
+const std::string K12::CLASS_NAME("K12");
+
+//~~~Properties~~~//
+
+size_t K12::BlockSize()
+{
+	return BLOCK_SIZE;
+}
+
+size_t K12::DigestSize()
+{
+	return DIGEST_SIZE;
+}
+
+const Digests K12::Enumeral()
+{
+	return Digests::K12;
+}
+
+const bool K12::IsParallel()
+{
+	return m_parallelProfile.IsParallel();
+}
+
+const std::string K12::Name()
+{
+	if (m_parallelProfile.IsParallel())
+		return CLASS_NAME + "-P" + Utility::IntUtils::ToString(m_parallelProfile.ParallelMaxDegree());
+	else
+		return CLASS_NAME;
+}
+
+const size_t K12::ParallelBlockSize()
+{
+	return m_parallelProfile.ParallelBlockSize();
+}
+
+ParallelOptions &K12::ParallelProfile()
+{
+	return m_parallelProfile;
+}
+
+//~~~Constructor~~~//
+
+K12::K12(bool Parallel)
+	:
+	K12(std::vector<byte>(0), Parallel)
+{
+}
+
+K12::K12(const std::vector<byte> &Customization, bool Parallel)
+	:
+	m_customization(Customization),
+	m_dgtState(STATE_SIZE, 0),
+	m_isDestroyed(false),
+	m_isTreeMode(false),
+	m_leafBuffer(CHUNK_SIZE * Keccak::PARALLEL_LANES),
+	m_leafCount(0),
+	m_leafLength(0),
+	m_msgBuffer(BLOCK_SIZE),
+	m_msgLength(0),
+	m_nodeLength(0),
+	m_parallelProfile(CHUNK_SIZE * Keccak::PARALLEL_LANES, Parallel, 0, 0, false, 0, false),
+	m_segmentStage(0)
+{
+	if (m_parallelProfile.IsParallel())
+		m_parallelProfile.IsParallel() = Parallel;
+
+	// the parallel block size is a multiple of the chunk groups hashed by each thread
+	if (m_parallelProfile.ParallelBlockSize() == 0)
+		m_parallelProfile.ParallelBlockSize() = m_parallelProfile.ParallelMinimumSize();
+}
+
+K12::~K12()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void K12::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	Output.resize(DIGEST_SIZE);
+	Update(Input, 0, Input.size());
+	Finalize(Output, 0);
+}
+
+void K12::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_isTreeMode = false;
+		m_leafCount = 0;
+		m_leafLength = 0;
+		m_msgLength = 0;
+		m_nodeLength = 0;
+
+		Utility::IntUtils::ClearVector(m_customization);
+		Utility::IntUtils::ClearVector(m_dgtState);
+		Utility::IntUtils::ClearVector(m_leafBuffer);
+		Utility::IntUtils::ClearVector(m_msgBuffer);
+		Utility::IntUtils::ClearVector(m_segmentStage);
+	}
+}
+
+size_t K12::Finalize(std::vector<byte> &Output, size_t OutOffset)
+{
+	CexAssert(Output.size() - OutOffset >= DIGEST_SIZE, "The Output buffer is too short!");
+
+	// S = M || C || length_encode(|C|)
+	std::vector<byte> enc = LengthEncode(static_cast<ulong>(m_customization.size()));
+	Process(m_customization, 0, m_customization.size());
+	Process(enc, 0, enc.size());
+
+	byte domain = DOMAIN_SINGLE;
+
+	if (m_isTreeMode)
+	{
+		// hash the remaining chunks, the last chunk may be partial
+		std::vector<byte> cv(DIGEST_SIZE);
+		size_t leafOff = 0;
+
+		while (leafOff != m_leafLength)
+		{
+			const size_t LEAFLEN = Utility::IntUtils::Min(m_leafLength - leafOff, CHUNK_SIZE);
+			ComputeLeaf(m_leafBuffer, leafOff, LEAFLEN, cv, 0);
+			AbsorbNode(cv, 0, cv.size());
+			leafOff += LEAFLEN;
+			++m_leafCount;
+		}
+
+		// the final node ends with the encoded chaining value count and the FFFF terminator
+		const std::vector<byte> TERMINATOR = { 0xFF, 0xFF };
+		enc = LengthEncode(m_leafCount);
+		AbsorbNode(enc, 0, enc.size());
+		AbsorbNode(TERMINATOR, 0, TERMINATOR.size());
+		domain = DOMAIN_NODE;
+	}
+
+	Utility::MemUtils::Clear(m_msgBuffer, m_msgLength, BLOCK_SIZE - m_msgLength);
+	m_msgBuffer[m_msgLength] = domain;
+	m_msgBuffer[BLOCK_SIZE - 1] |= 0x80;
+	AbsorbBlock(m_msgBuffer, 0, m_dgtState);
+
+	for (size_t i = 0; i < DIGEST_SIZE / sizeof(ulong); ++i)
+		Utility::IntUtils::Le64ToBytes(m_dgtState[i], Output, OutOffset + (i * sizeof(ulong)));
+
+	Reset();
+
+	return DIGEST_SIZE;
+}
+
+void K12::LoadState(const std::vector<byte> &State)
+{
+	if (State.size() < 2 + sizeof(ushort))
+		throw CryptoDigestException("K12:LoadState", "The state array is too short!");
+
+	IO::MemoryStream strm(State);
+	IO::StreamReader reader(strm);
+
+	if (reader.ReadByte() != STATE_VERSION)
+		throw CryptoDigestException("K12:LoadState", "The state version is not supported!");
+	if (reader.ReadByte() != static_cast<byte>(Digests::K12))
+		throw CryptoDigestException("K12:LoadState", "The state was not created by this digest!");
+
+	const size_t CSTLEN = reader.ReadInt<ushort>();
+	if (reader.Position() + CSTLEN + 1 + sizeof(uint) + sizeof(ulong) + sizeof(uint) > State.size())
+		throw CryptoDigestException("K12:LoadState", "The state array is malformed!");
+	if (reader.ReadBytes(CSTLEN) != m_customization)
+		throw CryptoDigestException("K12:LoadState", "The state was created with a different customization string!");
+
+	const bool TREEMODE = (reader.ReadByte() != 0);
+	const size_t NODELEN = reader.ReadInt<uint>();
+	const ulong LEAFCNT = reader.ReadInt<ulong>();
+	const size_t MSGLEN = reader.ReadInt<uint>();
+
+	if (NODELEN > CHUNK_SIZE || MSGLEN >= BLOCK_SIZE || reader.Position() + MSGLEN + sizeof(uint) > State.size())
+		throw CryptoDigestException("K12:LoadState", "The state array is malformed!");
+
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	reader.Read(m_msgBuffer, 0, MSGLEN);
+
+	const size_t LEAFLEN = reader.ReadInt<uint>();
+
+	if (LEAFLEN >= m_leafBuffer.size() || reader.Position() + LEAFLEN + (STATE_SIZE * sizeof(ulong)) != State.size())
+		throw CryptoDigestException("K12:LoadState", "The state array is malformed!");
+
+	Utility::MemUtils::Clear(m_leafBuffer, 0, m_leafBuffer.size());
+	reader.Read(m_leafBuffer, 0, LEAFLEN);
+	reader.Read(m_dgtState, 0, m_dgtState.size());
+
+	m_isTreeMode = TREEMODE;
+	m_leafCount = LEAFCNT;
+	m_leafLength = LEAFLEN;
+	m_msgLength = MSGLEN;
+	m_nodeLength = NODELEN;
+}
+
+void K12::ParallelMaxDegree(size_t Degree)
+{
+	if (Degree == 0)
+		throw CryptoDigestException("K12:ParallelMaxDegree", "Parallel degree can not be zero!");
+	if (Degree > 254)
+		throw CryptoDigestException("K12:ParallelMaxDegree", "Parallel degree can not exceed 254!");
+	if (Degree % 2 != 0)
+		throw CryptoDigestException("K12:ParallelMaxDegree", "Parallel degree must be an even number!");
+
+	m_parallelProfile.SetMaxDegree(Degree);
+	Reset();
+}
+
+void K12::Reset()
+{
+	Utility::MemUtils::Clear(m_dgtState, 0, m_dgtState.size() * sizeof(ulong));
+	Utility::MemUtils::Clear(m_leafBuffer, 0, m_leafBuffer.size());
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	m_isTreeMode = false;
+	m_leafCount = 0;
+	m_leafLength = 0;
+	m_msgLength = 0;
+	m_nodeLength = 0;
+}
+
+std::vector<byte> K12::SaveState()
+{
+	IO::StreamWriter writer(2 + sizeof(ushort) + m_customization.size() + 1 + sizeof(uint) + sizeof(ulong) + sizeof(uint) + m_msgLength + sizeof(uint) + m_leafLength + (STATE_SIZE * sizeof(ulong)));
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Digests::K12));
+	writer.Write(static_cast<ushort>(m_customization.size()));
+	writer.Write(m_customization, 0, m_customization.size());
+	writer.Write(static_cast<byte>(m_isTreeMode ? 1 : 0));
+	writer.Write(static_cast<uint>(m_nodeLength));
+	writer.Write(m_leafCount);
+	writer.Write(static_cast<uint>(m_msgLength));
+	writer.Write(m_msgBuffer, 0, m_msgLength);
+	writer.Write(static_cast<uint>(m_leafLength));
+	writer.Write(m_leafBuffer, 0, m_leafLength);
+	writer.Write(m_dgtState);
+
+	return writer.GetBytes();
+}
+
+void K12::Update(byte Input)
+{
+	std::vector<byte> one(1, Input);
+	Update(one, 0, 1);
+}
+
+void K12::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	CexAssert(Input.size() - InOffset >= Length, "The Input buffer is too short!");
+
+	Process(Input, InOffset, Length);
+}
+
+void K12::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input, m_segmentStage);
+}
+
+//~~~Private Functions~~~//
+
+void K12::AbsorbBlock(const std::vector<byte> &Input, size_t InOffset, std::vector<ulong> &State)
+{
+	for (size_t i = 0; i < BLOCK_SIZE / sizeof(ulong); ++i)
+		State[i] ^= Utility::IntUtils::LeBytesTo64(Input, InOffset + (i * sizeof(ulong)));
+
+	Keccak::PermuteR(State, ROUND_COUNT);
+}
+
+void K12::AbsorbNode(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	if (Length == 0)
+		return;
+
+	if (m_msgLength != 0 && (m_msgLength + Length >= BLOCK_SIZE))
+	{
+		const size_t RMDLEN = BLOCK_SIZE - m_msgLength;
+		Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgLength, RMDLEN);
+		AbsorbBlock(m_msgBuffer, 0, m_dgtState);
+		m_msgLength = 0;
+		InOffset += RMDLEN;
+		Length -= RMDLEN;
+	}
+
+	// full blocks are absorbed directly from the input
+	while (Length >= BLOCK_SIZE)
+	{
+		AbsorbBlock(Input, InOffset, m_dgtState);
+		InOffset += BLOCK_SIZE;
+		Length -= BLOCK_SIZE;
+	}
+
+	// store unaligned bytes
+	if (Length != 0)
+	{
+		Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgLength, Length);
+		m_msgLength += Length;
+	}
+}
+
+void K12::ComputeLeaf(const std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<byte> &Output, size_t OutOffset)
+{
+	std::vector<ulong> state(STATE_SIZE, 0);
+	std::vector<byte> blk(BLOCK_SIZE, 0);
+
+	while (Length >= BLOCK_SIZE)
+	{
+		AbsorbBlock(Input, InOffset, state);
+		InOffset += BLOCK_SIZE;
+		Length -= BLOCK_SIZE;
+	}
+
+	// the chunk tail with the leaf domain bits and the pad10*1
+	Utility::MemUtils::Copy(Input, InOffset, blk, 0, Length);
+	blk[Length] = DOMAIN_LEAF;
+	blk[BLOCK_SIZE - 1] |= 0x80;
+	AbsorbBlock(blk, 0, state);
+
+	for (size_t i = 0; i < DIGEST_SIZE / sizeof(ulong); ++i)
+		Utility::IntUtils::Le64ToBytes(state[i], Output, OutOffset + (i * sizeof(ulong)));
+}
+
+void K12::ComputeLeafP4x(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset)
+{
+	const size_t LANES = Keccak::PARALLEL_LANES;
+	const size_t BLKCNT = CHUNK_SIZE / BLOCK_SIZE;
+	const size_t RMDLEN = CHUNK_SIZE - (BLKCNT * BLOCK_SIZE);
+	std::vector<ulong> state(STATE_SIZE * LANES, 0);
+
+	// four consecutive chunks, each absorbed into its own interleaved state
+	for (size_t i = 0; i < BLKCNT; ++i)
+	{
+		const size_t BLKOFF = InOffset + (i * BLOCK_SIZE);
+
+		for (size_t j = 0; j < BLOCK_SIZE / sizeof(ulong); ++j)
+		{
+			for (size_t n = 0; n < LANES; ++n)
+				state[(j * LANES) + n] ^= Utility::IntUtils::LeBytesTo64(Input, BLKOFF + (n * CHUNK_SIZE) + (j * sizeof(ulong)));
+		}
+
+		Keccak::PermuteP4x(state, ROUND_COUNT);
+	}
+
+	// the chunk tails with the leaf domain bits and the pad10*1
+	const size_t TLOFF = InOffset + (BLKCNT * BLOCK_SIZE);
+
+	for (size_t j = 0; j < RMDLEN / sizeof(ulong); ++j)
+	{
+		for (size_t n = 0; n < LANES; ++n)
+			state[(j * LANES) + n] ^= Utility::IntUtils::LeBytesTo64(Input, TLOFF + (n * CHUNK_SIZE) + (j * sizeof(ulong)));
+	}
+
+	for (size_t n = 0; n < LANES; ++n)
+	{
+		state[((RMDLEN / sizeof(ulong)) * LANES) + n] ^= DOMAIN_LEAF;
+		state[(((BLOCK_SIZE / sizeof(ulong)) - 1) * LANES) + n] ^= 0x8000000000000000ULL;
+	}
+
+	Keccak::PermuteP4x(state, ROUND_COUNT);
+
+	for (size_t n = 0; n < LANES; ++n)
+	{
+		for (size_t j = 0; j < DIGEST_SIZE / sizeof(ulong); ++j)
+			Utility::IntUtils::Le64ToBytes(state[(j * LANES) + n], Output, OutOffset + (n * DIGEST_SIZE) + (j * sizeof(ulong)));
+	}
+}
+
+std::vector<byte> K12::LengthEncode(ulong Value)
+{
+	// big endian with no leading zeros, followed by the byte count; zero encodes as a single zero byte
+	std::vector<byte> enc(0);
+
+	while (Value != 0)
+	{
+		enc.insert(enc.begin(), static_cast<byte>(Value));
+		Value >>= 8;
+	}
+
+	enc.push_back(static_cast<byte>(enc.size()));
+
+	return enc;
+}
+
+void K12::Process(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	if (Length == 0)
+		return;
+
+	if (!m_isTreeMode)
+	{
+		// the first chunk is absorbed by the final node
+		const size_t NODLEN = Utility::IntUtils::Min(CHUNK_SIZE - m_nodeLength, Length);
+		AbsorbNode(Input, InOffset, NODLEN);
+		m_nodeLength += NODLEN;
+		InOffset += NODLEN;
+		Length -= NODLEN;
+
+		if (Length == 0)
+			return;
+
+		// the input exceeds one chunk; the first chunk is followed by the tree hashing marker
+		const std::vector<byte> MARKER = { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+		AbsorbNode(MARKER, 0, MARKER.size());
+		m_isTreeMode = true;
+	}
+
+	if (m_leafLength != 0)
+	{
+		const size_t RMDLEN = Utility::IntUtils::Min(m_leafBuffer.size() - m_leafLength, Length);
+		Utility::MemUtils::Copy(Input, InOffset, m_leafBuffer, m_leafLength, RMDLEN);
+		m_leafLength += RMDLEN;
+		InOffset += RMDLEN;
+		Length -= RMDLEN;
+
+		if (m_leafLength != m_leafBuffer.size())
+			return;
+
+		// full chunks do not depend on the input that follows, and are hashed as soon as they are available
+		ProcessLeaves(m_leafBuffer, 0, m_leafBuffer.size());
+		m_leafLength = 0;
+	}
+
+	if (m_parallelProfile.IsParallel() && Length >= m_parallelProfile.ParallelBlockSize())
+	{
+		// split the chunk groups between threads
+		const size_t PRCLEN = Length - (Length % m_parallelProfile.ParallelMinimumSize());
+		ProcessLeaves(Input, InOffset, PRCLEN);
+		InOffset += PRCLEN;
+		Length -= PRCLEN;
+	}
+
+	if (Length >= m_leafBuffer.size())
+	{
+		// groups of 4 chunks are hashed directly from the input
+		const size_t PRCLEN = Length - (Length % m_leafBuffer.size());
+		ProcessLeaves(Input, InOffset, PRCLEN);
+		InOffset += PRCLEN;
+		Length -= PRCLEN;
+	}
+
+	// store unaligned bytes
+	if (Length != 0)
+	{
+		Utility::MemUtils::Copy(Input, InOffset, m_leafBuffer, 0, Length);
+		m_leafLength = Length;
+	}
+}
+
+void K12::ProcessLeaves(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	const size_t CVSLEN = Keccak::PARALLEL_LANES * DIGEST_SIZE;
+	const size_t GRPLEN = Keccak::PARALLEL_LANES * CHUNK_SIZE;
+	const size_t GRPCNT = Length / GRPLEN;
+	const size_t THDCNT = m_parallelProfile.ParallelMaxDegree();
+
+	if (GRPCNT == 0)
+		return;
+
+	std::vector<byte> cvs(GRPCNT * CVSLEN);
+
+	if (m_parallelProfile.IsParallel() && THDCNT > 1 && GRPCNT % THDCNT == 0)
+	{
+		// each thread hashes a contiguous range of chunk groups; the chaining values are absorbed in order
+		const size_t THDGRP = GRPCNT / THDCNT;
+		const byte* NUMPTR = m_parallelProfile.IsNumaAware() ? Input.data() + InOffset : nullptr;
+
+		Utility::ParallelUtils::ParallelFor(0, THDCNT, NUMPTR, THDGRP * GRPLEN, [&Input, InOffset, &cvs, THDGRP, GRPLEN, CVSLEN](size_t i)
+		{
+			for (size_t j = i * THDGRP; j < (i + 1) * THDGRP; ++j)
+				ComputeLeafP4x(Input, InOffset + (j * GRPLEN), cvs, j * CVSLEN);
+		});
+	}
+	else
+	{
+		for (size_t j = 0; j < GRPCNT; ++j)
+			ComputeLeafP4x(Input, InOffset + (j * GRPLEN), cvs, j * CVSLEN);
+	}
+
+	AbsorbNode(cvs, 0, cvs.size());
+	m_leafCount += GRPCNT * Keccak::PARALLEL_LANES;
+	Utility::MemUtils::Clear(cvs, 0, cvs.size());
+}
+
+NAMESPACE_DIGESTEND
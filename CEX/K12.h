@@ -0,0 +1,271 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Principal Algorithms:
+// KangarooTwelve, designed by Guido Bertoni, Joan Daemen, Michael Peeters, Gilles Van Assche, and Ronny Van Keer.
+// <a href="https://keccak.team/files/KangarooTwelve.pdf">KangarooTwelve: fast hashing based on Keccak-p</a>.
+//
+// Implementation Details:
+// An implementation of the KangarooTwelve digest with a 256 bit return size.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_K12_H
+#define CEX_K12_H
+
+#include "IDigest.h"
+
+NAMESPACE_DIGEST
+
+/// <summary>
+/// An implementation of the KangarooTwelve tree hashing digest
+/// </summary>
+///
+/// <example>
+/// <description>Example using the Compute method:</description>
+/// <code>
+/// K12 digest;
+/// std:vector&lt;byte&gt; hash(digest.DigestSize(), 0);
+/// // compute a hash
+/// digest.Compute(Input, hash);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Overview:</description>
+/// <para>KangarooTwelve is a Keccak sponge using the 12 round Keccak-p[1600] permutation with a 168 byte rate, and a built-in tree mode. \n
+/// The message is followed by the customization string and its length encoding; if this input fits in a single 8KB chunk it is hashed with a single sponge. \n
+/// Longer inputs are split into 8KB chunks, each chunk after the first is hashed independently to a 32 byte chaining value,
+/// and the final node absorbs the first chunk followed by the chaining values.
+/// Because the chunks are independent, they are hashed 4 at a time with interleaved SIMD states, and fanned out across threads for large inputs,
+/// without changing the hash value.</para>
+///
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The hash size is 32 bytes (256 bits), and the sponge rate is 168 bytes.</description></item>
+/// <item><description>The output is the standard KangarooTwelve output, and does not depend on the parallel settings or the number of threads.</description></item>
+/// <item><description>Chunks are processed 4 at a time using the AVX2 4-way permutation when available; larger inputs are split between threads when the Parallel flag is set and the system is multi-core.</description></item>
+/// <item><description>The optional customization string is set through the constructor, and is appended to every message hashed by the instance.</description></item>
+/// <item><description>The <see cref="Compute(byte[])"/> method wraps the <see cref="Update(byte[], int, int)"/> and Finalize methods.</description>/></item>
+/// <item><description>The <see cref="Finalize(byte[], int)"/> method resets the internal state.</description></item>
+/// </list>
+///
+/// <list type="number">
+/// <item><description>KangarooTwelve: <a href="https://keccak.team/files/KangarooTwelve.pdf">fast hashing based on Keccak-p</a>.</description></item>
+/// <item><description>IETF <a href="https://datatracker.ietf.org/doc/draft-irtf-cfrg-kangarootwelve/">KangarooTwelve draft</a>.</description></item>
+/// <item><description>Keccak <a href="https://keccak.team/files/Keccak-reference-3.0.pdf">Reference</a> Guide.</description></item>
+/// </list>
+/// </remarks>
+class K12 : public IDigest
+{
+private:
+
+	static const size_t BLOCK_SIZE = 168;
+	static const size_t CHUNK_SIZE = 8192;
+	static const std::string CLASS_NAME;
+	static const size_t DIGEST_SIZE = 32;
+	static const byte DOMAIN_LEAF = 0x0B;
+	static const byte DOMAIN_NODE = 0x06;
+	static const byte DOMAIN_SINGLE = 0x07;
+	static const size_t ROUND_COUNT = 12;
+	static const size_t STATE_SIZE = 25;
+	static const byte STATE_VERSION = 1;
+
+	std::vector<byte> m_customization;
+	std::vector<ulong> m_dgtState;
+	bool m_isDestroyed;
+	bool m_isTreeMode;
+	std::vector<byte> m_leafBuffer;
+	ulong m_leafCount;
+	size_t m_leafLength;
+	std::vector<byte> m_msgBuffer;
+	size_t m_msgLength;
+	size_t m_nodeLength;
+	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_segmentStage;
+
+public:
+
+	K12(const K12&) = delete;
+	K12& operator=(const K12&) = delete;
+	K12& operator=(K12&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The Digests internal blocksize in bytes; the sponge rate
+	/// </summary>
+	size_t BlockSize() override;
+
+	/// <summary>
+	/// Get: Size of returned digest in bytes
+	/// </summary>
+	size_t DigestSize() override;
+
+	/// <summary>
+	/// Get: The digests type name
+	/// </summary>
+	const Digests Enumeral() override;
+
+	/// <summary>
+	/// Get: Processor parallelization availability.
+	/// <para>Indicates whether parallel processing is available on this system.
+	/// If parallel capable, input data array passed to the Update function must be ParallelBlockSize in bytes to trigger parallelization.</para>
+	/// </summary>
+	const bool IsParallel() override;
+
+	/// <summary>
+	/// Get: The digests class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Get: Parallel block size; the byte-size of the input data array passed to the Update function that triggers parallel processing.
+	/// <para>This value can be changed through the ParallelProfile class.<para>
+	/// </summary>
+	const size_t ParallelBlockSize() override;
+
+	/// <summary>
+	/// Get/Set: Contains parallel settings and SIMD capability flags in a ParallelOptions structure.
+	/// <para>The maximum number of threads allocated when using multi-threaded processing can be set with the ParallelMaxDegree(size_t) function.
+	/// Changing the thread count does not change the hash value.</para>
+	/// </summary>
+	ParallelOptions &ParallelProfile() override;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Initialize the digest without a customization string
+	/// </summary>
+	///
+	/// <param name="Parallel">Setting the Parallel flag to true splits large inputs between threads; the hash value is unchanged</param>
+	explicit K12(bool Parallel = false);
+
+	/// <summary>
+	/// Initialize the digest with a customization string
+	/// </summary>
+	///
+	/// <param name="Customization">The customization string appended to every message hashed by this instance</param>
+	/// <param name="Parallel">Setting the Parallel flag to true splits large inputs between threads; the hash value is unchanged</param>
+	explicit K12(const std::vector<byte> &Customization, bool Parallel = false);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~K12() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Get the Hash value
+	/// </summary>
+	///
+	/// <param name="Input">Input data</param>
+	/// <param name="Output">The hash output value array</param>
+	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Do final processing and get the hash value
+	/// </summary>
+	///
+	/// <param name="Output">The Hash output value array</param>
+	/// <param name="OutOffset">The starting offset within the Output array</param>
+	///
+	/// <returns>Size of Hash value</returns>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the output buffer is too short</exception>
+	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset) override;
+
+	/// <summary>
+	/// Restore the internal state from a checkpoint created by the SaveState function.
+	/// <para>The digest must be constructed with the same customization string as the instance that created the state;
+	/// hashing resumes from the checkpoint, and subsequent Update and Finalize calls produce the same hash as an uninterrupted digest.</para>
+	/// </summary>
+	///
+	/// <param name="State">The serialized digest state</param>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the state version, digest type, or customization string do not match this instance</exception>
+	void LoadState(const std::vector<byte> &State) override;
+
+	/// <summary>
+	/// Set the number of threads allocated when using multi-threaded tree hashing processing.
+	/// <para>Thread count must be an even number, and not exceed the number of processor cores.
+	/// Changing this value does not change the hash value.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	///
+	/// <exception cref="Exception::CryptoDigestException">Thrown if an invalid degree setting is used</exception>
+	void ParallelMaxDegree(size_t Degree) override;
+
+	/// <summary>
+	/// Reset the internal state
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Serialize the internal state; the version, customization string, tree position, pending node and chunk bytes, and the final node sponge
+	/// </summary>
+	///
+	/// <returns>The serialized digest state</returns>
+	std::vector<byte> SaveState() override;
+
+	/// <summary>
+	/// Update the digest with a single byte
+	/// </summary>
+	///
+	/// <param name="Input">Input byte</param>
+	void Update(byte Input) override;
+
+	/// <summary>
+	/// Update the buffer
+	/// </summary>
+	///
+	/// <param name="Input">Input data</param>
+	/// <param name="InOffset">The starting offset within the Input array</param>
+	/// <param name="Length">Amount of data to process in bytes</param>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the input buffer is too short</exception>
+	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
+
+	/// <summary>
+	/// Update the buffer with a message stored as a list of fragments
+	/// <para>The fragments are absorbed in list order as one contiguous message; a partial block is carried across each fragment boundary, so no fragment is copied.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of message fragments</param>
+	void UpdateSegments(const std::vector<MemorySegment> &Input) override;
+
+private:
+
+	static void AbsorbBlock(const std::vector<byte> &Input, size_t InOffset, std::vector<ulong> &State);
+	void AbsorbNode(const std::vector<byte> &Input, size_t InOffset, size_t Length);
+	static void ComputeLeaf(const std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<byte> &Output, size_t OutOffset);
+	static void ComputeLeafP4x(const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset);
+	static std::vector<byte> LengthEncode(ulong Value);
+	void Process(const std::vector<byte> &Input, size_t InOffset, size_t Length);
+	void ProcessLeaves(const std::vector<byte> &Input, size_t InOffset, size_t Length);
+};
+
+NAMESPACE_DIGESTEND
+#endif
@@ -0,0 +1,345 @@
+#include "KMAC.h"
+#include "IntUtils.h"
+#include "Keccak.h"
+#include "MemUtils.h"
+#include "MemoryStream.h"
+#include "SegmentUtils.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
+
+NAMESPACE_MAC
+
+const std::string KMAC::CLASS_NAME("KMAC");
+
+//~~~Properties~~~//
+
+const size_t KMAC::BlockSize()
+{
+	return m_blockSize;
+}
+
+const Digests KMAC::DigestType()
+{
+	return m_msgDigestType;
+}
+
+const Macs KMAC::Enumeral()
+{
+	return Macs::KMAC;
+}
+
+const size_t KMAC::MacSize()
+{
+	return m_macSize;
+}
+
+const bool KMAC::IsInitialized()
+{
+	return m_isInitialized;
+}
+
+std::vector<SymmetricKeySize> KMAC::LegalKeySizes() const
+{
+	return m_legalKeySizes;
+}
+
+const std::string KMAC::Name()
+{
+	return CLASS_NAME + (m_msgDigestType == Digests::Keccak256 ? "128" : "256");
+}
+
+//~~~Constructor~~~//
+
+KMAC::KMAC(Digests DigestType, size_t MacSize)
+	:
+	m_blockSize(DigestType == Digests::Keccak256 ? 168 : DigestType == Digests::Keccak512 ? 136 :
+		throw CryptoMacException("KMAC:Ctor", "The digest type must be Keccak256 or Keccak512!")),
+	m_keyState(STATE_SIZE, 0),
+	m_isDestroyed(false),
+	m_isInitialized(false),
+	m_legalKeySizes(0),
+	m_macState(STATE_SIZE, 0),
+	m_macSize(MacSize != 0 ? MacSize : 200 - m_blockSize),
+	m_msgBuffer(m_blockSize),
+	m_msgLength(0),
+	m_msgDigestType(DigestType)
+{
+	Scope();
+}
+
+KMAC::~KMAC()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void KMAC::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	if (Output.size() != m_macSize)
+		Output.resize(m_macSize);
+
+	Update(Input, 0, Input.size());
+	Finalize(Output, 0);
+}
+
+void KMAC::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_blockSize = 0;
+		m_isInitialized = false;
+		m_macSize = 0;
+		m_msgDigestType = Digests::None;
+		m_msgLength = 0;
+
+		Utility::IntUtils::ClearVector(m_keyState);
+		Utility::IntUtils::ClearVector(m_legalKeySizes);
+		Utility::IntUtils::ClearVector(m_macState);
+		Utility::IntUtils::ClearVector(m_msgBuffer);
+	}
+}
+
+size_t KMAC::Finalize(std::vector<byte> &Output, size_t OutOffset)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("KMAC:Finalize", "The Mac has not been initialized!");
+	if (Output.size() - OutOffset < m_macSize)
+		throw CryptoMacException("KMAC:Finalize", "The Output buffer is too short!");
+
+	// bind the output length to the code
+	std::vector<byte> enc = Digest::Keccak::RightEncode(static_cast<ulong>(m_macSize) * 8);
+	Absorb(enc, 0, enc.size());
+
+	// cSHAKE domain bits and the final bit of the pad10*1
+	Utility::MemUtils::Clear(m_msgBuffer, m_msgLength, m_blockSize - m_msgLength);
+	m_msgBuffer[m_msgLength] = KMAC_DOMAIN;
+	m_msgBuffer[m_blockSize - 1] |= 0x80;
+	Digest::Keccak::Permute(m_msgBuffer, 0, m_blockSize, m_macState);
+
+	size_t outLen = m_macSize;
+
+	while (outLen != 0)
+	{
+		// the permutation runs on a lane complemented state
+		m_macState[1] = ~m_macState[1];
+		m_macState[2] = ~m_macState[2];
+		m_macState[8] = ~m_macState[8];
+		m_macState[12] = ~m_macState[12];
+		m_macState[17] = ~m_macState[17];
+		m_macState[20] = ~m_macState[20];
+
+		for (size_t i = 0; i < m_blockSize / sizeof(ulong); ++i)
+			Utility::IntUtils::Le64ToBytes(m_macState[i], m_msgBuffer, i * sizeof(ulong));
+
+		const size_t RMDLEN = Utility::IntUtils::Min(outLen, m_blockSize);
+		Utility::MemUtils::Copy(m_msgBuffer, 0, Output, OutOffset, RMDLEN);
+		OutOffset += RMDLEN;
+		outLen -= RMDLEN;
+
+		if (outLen != 0)
+		{
+			m_macState[1] = ~m_macState[1];
+			m_macState[2] = ~m_macState[2];
+			m_macState[8] = ~m_macState[8];
+			m_macState[12] = ~m_macState[12];
+			m_macState[17] = ~m_macState[17];
+			m_macState[20] = ~m_macState[20];
+			Digest::Keccak::Permute(m_msgBuffer, 0, 0, m_macState);
+		}
+	}
+
+	// restore the keyed sponge
+	Utility::MemUtils::Copy(m_keyState, 0, m_macState, 0, STATE_SIZE * sizeof(ulong));
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	m_msgLength = 0;
+
+	return m_macSize;
+}
+
+void KMAC::Initialize(ISymmetricKey &KeyParams)
+{
+	SymmetricKeyView keyView(KeyParams);
+
+	if (keyView.Key().size() == 0)
+		throw CryptoMacException("KMAC:Initialize", "The key can not be zero length!");
+
+	const std::vector<byte> NAME = { 0x4B, 0x4D, 0x41, 0x43 };
+	std::vector<byte> key = keyView.Key();
+	std::vector<byte> enc = Digest::Keccak::LeftEncode(m_blockSize);
+
+	StateReset(m_macState);
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	m_msgLength = 0;
+
+	// cSHAKE prefix: bytepad(encode_string("KMAC") || encode_string(S), rate)
+	Absorb(enc, 0, enc.size());
+	AbsorbString(NAME);
+	AbsorbString(keyView.Info());
+	AbsorbPad();
+
+	// bytepad(encode_string(K), rate)
+	Absorb(enc, 0, enc.size());
+	AbsorbString(key);
+	AbsorbPad();
+	Utility::MemUtils::Clear(key, 0, key.size());
+
+	// cache the keyed sponge for reset
+	Utility::MemUtils::Copy(m_macState, 0, m_keyState, 0, STATE_SIZE * sizeof(ulong));
+	m_isInitialized = true;
+}
+
+void KMAC::LoadState(const std::vector<byte> &State)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("KMAC:LoadState", "The Mac has not been initialized!");
+	if (State.size() < 3 + (2 * sizeof(uint)) + (STATE_SIZE * sizeof(ulong)))
+		throw CryptoMacException("KMAC:LoadState", "The state array is too short!");
+
+	IO::MemoryStream strm(State);
+	IO::StreamReader reader(strm);
+
+	if (reader.ReadByte() != STATE_VERSION)
+		throw CryptoMacException("KMAC:LoadState", "The state version is not supported!");
+	if (reader.ReadByte() != static_cast<byte>(Macs::KMAC))
+		throw CryptoMacException("KMAC:LoadState", "The state was not created by this Mac!");
+	if (reader.ReadByte() != static_cast<byte>(m_msgDigestType) || reader.ReadInt<uint>() != m_macSize)
+		throw CryptoMacException("KMAC:LoadState", "The state was created with different Mac settings!");
+
+	const size_t MSGLEN = reader.ReadInt<uint>();
+
+	if (MSGLEN >= m_blockSize || reader.Position() + MSGLEN + (STATE_SIZE * sizeof(ulong)) != State.size())
+		throw CryptoMacException("KMAC:LoadState", "The state array is malformed!");
+
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	reader.Read(m_msgBuffer, 0, MSGLEN);
+	m_msgLength = MSGLEN;
+	reader.Read(m_macState, 0, m_macState.size());
+}
+
+void KMAC::Reset()
+{
+	Utility::MemUtils::Clear(m_keyState, 0, m_keyState.size() * sizeof(ulong));
+	Utility::MemUtils::Clear(m_macState, 0, m_macState.size() * sizeof(ulong));
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	m_msgLength = 0;
+	m_isInitialized = false;
+}
+
+std::vector<byte> KMAC::SaveState()
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("KMAC:SaveState", "The Mac has not been initialized!");
+
+	IO::StreamWriter writer(3 + (2 * sizeof(uint)) + m_msgLength + (STATE_SIZE * sizeof(ulong)));
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Macs::KMAC));
+	writer.Write(static_cast<byte>(m_msgDigestType));
+	writer.Write(static_cast<uint>(m_macSize));
+	writer.Write(static_cast<uint>(m_msgLength));
+	writer.Write(m_msgBuffer, 0, m_msgLength);
+	writer.Write(m_macState);
+
+	return writer.GetBytes();
+}
+
+void KMAC::Update(byte Input)
+{
+	std::vector<byte> one(1, Input);
+	Update(one, 0, 1);
+}
+
+void KMAC::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("KMAC:Update", "The Mac has not been initialized!");
+	if (InOffset + Length > Input.size())
+		throw CryptoMacException("KMAC:Update", "The Input buffer is too short!");
+
+	Absorb(Input, InOffset, Length);
+}
+
+void KMAC::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input);
+}
+
+//~~~Private Functions~~~//
+
+void KMAC::Absorb(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	if (Length == 0)
+		return;
+
+	if (m_msgLength != 0 && (m_msgLength + Length >= m_blockSize))
+	{
+		const size_t RMDLEN = m_blockSize - m_msgLength;
+		Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgLength, RMDLEN);
+		Digest::Keccak::Permute(m_msgBuffer, 0, m_blockSize, m_macState);
+		m_msgLength = 0;
+		InOffset += RMDLEN;
+		Length -= RMDLEN;
+	}
+
+	// full blocks are absorbed directly from the input
+	while (Length >= m_blockSize)
+	{
+		Digest::Keccak::Permute(Input, InOffset, m_blockSize, m_macState);
+		InOffset += m_blockSize;
+		Length -= m_blockSize;
+	}
+
+	// store unaligned bytes
+	if (Length != 0)
+	{
+		Utility::MemUtils::Copy(Input, InOffset, m_msgBuffer, m_msgLength, Length);
+		m_msgLength += Length;
+	}
+}
+
+void KMAC::AbsorbPad()
+{
+	// zero-fill to the rate boundary
+	if (m_msgLength != 0)
+	{
+		Utility::MemUtils::Clear(m_msgBuffer, m_msgLength, m_blockSize - m_msgLength);
+		Digest::Keccak::Permute(m_msgBuffer, 0, m_blockSize, m_macState);
+		m_msgLength = 0;
+	}
+}
+
+void KMAC::AbsorbString(const std::vector<byte> &Input)
+{
+	// encode_string(S) = left_encode(len(S)) || S
+	std::vector<byte> enc = Digest::Keccak::LeftEncode(static_cast<ulong>(Input.size()) * 8);
+	Absorb(enc, 0, enc.size());
+	Absorb(Input, 0, Input.size());
+}
+
+void KMAC::Scope()
+{
+	const size_t SECLEN = (200 - m_blockSize) / 2;
+
+	m_legalKeySizes.resize(3);
+	// minimum key size; the security strength
+	m_legalKeySizes[0] = SymmetricKeySize(SECLEN, 0, 0);
+	// recommended size
+	m_legalKeySizes[1] = SymmetricKeySize(SECLEN * 2, 0, 0);
+	// a rate sized key, with an optional customization string
+	m_legalKeySizes[2] = SymmetricKeySize(m_blockSize, 0, SECLEN);
+}
+
+void KMAC::StateReset(std::vector<ulong> &State)
+{
+	Utility::MemUtils::Clear(State, 0, State.size() * sizeof(ulong));
+	State[1] = ~0ULL;
+	State[2] = ~0ULL;
+	State[8] = ~0ULL;
+	State[12] = ~0ULL;
+	State[17] = ~0ULL;
+	State[20] = ~0ULL;
+}
+
+NAMESPACE_MACEND
@@ -0,0 +1,262 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Principal Algorithms:
+// NIST SP 800-185: SHA-3 Derived Functions: cSHAKE, KMAC, TupleHash and ParallelHash.
+// Implementation Details:
+// An implementation of the Keccak based Message Authentication Code generator (KMAC128 and KMAC256).
+// Contact: develop@vtdev.com
+
+#ifndef CEX_KMAC_H
+#define CEX_KMAC_H
+
+#include "Digests.h"
+#include "IMac.h"
+
+NAMESPACE_MAC
+
+using Enumeration::Digests;
+
+/// <summary>
+/// An implementation of the Keccak based Message Authentication Code generator; KMAC128 and KMAC256
+/// </summary>
+///
+/// <example>
+/// <description>Generating a MAC code</description>
+/// <code>
+/// KMAC mac(Enumeration::Digests::Keccak512);
+/// // the optional Info parameter is the customization string
+/// SymmetricKey kp(Key, Nonce, Info);
+/// mac.Initialize(kp);
+/// mac.Update(Input, 0, Input.size());
+/// mac.Finalize(Output, Offset);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description><B>Overview:</B></description>
+/// <para>KMAC is the keyed function defined in NIST SP 800-185; the key is absorbed into a cSHAKE sponge as a padded block, directly ahead of the message. \n
+/// The Mac is computed in a single pass over the message, and the keyed sponge state is cached, so computing successive Mac codes with the same key does not re-absorb the key.</para>
+///
+/// <description><B>Description:</B></description>
+/// <para><EM>Legend:</EM> \n
+/// <B>K</B>=key, <B>X</B>=message, <B>L</B>=output length in bits, <B>S</B>=customization string, <B>||</B>=concatonate \n
+/// <EM>Generate</EM> \n
+/// newX = bytepad(encode_string(K), rate) || X || right_encode(L) \n
+/// KMAC(K, X, L, S) = cSHAKE(newX, L, "KMAC", S)</para>
+///
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The Keccak256 digest type selects KMAC128 (a 168 byte rate), the Keccak512 digest type selects KMAC256 (a 136 byte rate).</description></item>
+/// <item><description>The default Mac size is 32 bytes for KMAC128, and 64 bytes for KMAC256; the output length is bound to the Mac code by the right_encode(L) suffix.</description></item>
+/// <item><description>The key can be any non-zero length; the optional Info parameter of the key container is loaded as the customization string S, the Nonce parameter is not used.</description></item>
+/// <item><description>The Mac is restored to the keyed state after each Finalize call, so successive Mac codes can be computed without calling Initialize again.</description></item>
+/// <item><description>The Compute(Input, Output) method wraps the Update(Input, Offset, Length) and Finalize(Output, Offset) methods and should only be used on small to medium sized data.</description>/></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>NIST <a href="http://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-185.pdf">SP 800-185</a>: SHA-3 Derived Functions: cSHAKE, KMAC, TupleHash and ParallelHash.</description></item>
+/// <item><description>Fips <a href="http://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf">202</a>: SHA-3 Standard: Permutation-Based Hash and Extendable-Output Functions.</description></item>
+/// </list>
+/// </remarks>
+class KMAC : public IMac
+{
+private:
+
+	static const std::string CLASS_NAME;
+	static const byte KMAC_DOMAIN = 0x04;
+	static const size_t STATE_SIZE = 25;
+	static const byte STATE_VERSION = 1;
+
+	size_t m_blockSize;
+	std::vector<ulong> m_keyState;
+	bool m_isDestroyed;
+	bool m_isInitialized;
+	std::vector<SymmetricKeySize> m_legalKeySizes;
+	std::vector<ulong> m_macState;
+	size_t m_macSize;
+	std::vector<byte> m_msgBuffer;
+	size_t m_msgLength;
+	Digests m_msgDigestType;
+
+public:
+
+	KMAC() = delete;
+	KMAC(const KMAC&) = delete;
+	KMAC& operator=(const KMAC&) = delete;
+	KMAC& operator=(KMAC&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The sponge rate; the internal blocksize in bytes
+	/// </summary>
+	const size_t BlockSize() override;
+
+	/// <summary>
+	/// Get: The Keccak strength selector; Keccak256 for KMAC128, or Keccak512 for KMAC256
+	/// </summary>
+	const Digests DigestType();
+
+	/// <summary>
+	/// Get: Mac generators type name
+	/// </summary>
+	const Macs Enumeral() override;
+
+	/// <summary>
+	/// Get: Size of returned mac in bytes
+	/// </summary>
+	const size_t MacSize() override;
+
+	/// <summary>
+	/// Get: Mac is ready to digest data
+	/// </summary>
+	const bool IsInitialized() override;
+
+	/// <summary>
+	/// Get: Recommended Mac key sizes in a SymmetricKeySize array
+	/// </summary>
+	std::vector<SymmetricKeySize> LegalKeySizes() const override;
+
+	/// <summary>
+	/// Get: Mac generators class name
+	/// </summary>
+	const std::string Name() override;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Instantiate this class using the Keccak digest enumeration name as the strength selector
+	/// </summary>
+	///
+	/// <param name="DigestType">The Keccak digest enumeration name; Keccak256 for KMAC128, or Keccak512 for KMAC256</param>
+	/// <param name="MacSize">The output Mac code size in bytes; the default (0) is 32 bytes for KMAC128 and 64 bytes for KMAC256</param>
+	///
+	/// <exception cref="Exception::CryptoMacException">Thrown if the digest type is not Keccak256 or Keccak512</exception>
+	explicit KMAC(Digests DigestType, size_t MacSize = 0);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~KMAC() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Process an input array and return the Mac code in the output array.
+	/// </summary>
+	///
+	/// <param name="Input">The input data byte array</param>
+	/// <param name="Output">The output Mac code array</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized</exception>
+	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Process the data and return a Mac code.
+	/// <para>The sponge is restored to the keyed state after the code is written, and is ready to process a new message.</para>
+	/// </summary>
+	///
+	/// <param name="Output">The output Mac code array</param>
+	/// <param name="OutOffset">The offset in the output array</param>
+	///
+	/// <returns>The number of bytes processed</returns>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized, or the Output array is too small</exception>
+	size_t Finalize(std::vector<byte> &Output, size_t OutOffset) override;
+
+	/// <summary>
+	/// Initialize the MAC generator with a SymmetricKey key container.
+	/// <para>The key can be any non-zero length, one of the LegalKeySizes is recommended.
+	/// The optional Info parameter is the customization string, the Nonce parameter is not used.</para>
+	/// </summary>
+	///
+	/// <param name="KeyParams">A SymmetricKey key container class</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the key is empty</exception>
+	void Initialize(ISymmetricKey &KeyParams) override;
+
+	/// <summary>
+	/// Restore the message state from a checkpoint created by the SaveState function.
+	/// <para>The Mac must be initialized with the same key and customization string before the state is loaded.</para>
+	/// </summary>
+	///
+	/// <param name="State">The serialized Mac state</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized, or the state is malformed or was not created by this Mac</exception>
+	void LoadState(const std::vector<byte> &State) override;
+
+	/// <summary>
+	/// Reset to the default state; Mac must be re-initialized after this call
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Serialize the message state; the sponge state and the pending message bytes.
+	/// <para>Key material is not written to the state.</para>
+	/// </summary>
+	///
+	/// <returns>The serialized Mac state</returns>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized</exception>
+	std::vector<byte> SaveState() override;
+
+	/// <summary>
+	/// Update the Mac with a single byte
+	/// </summary>
+	///
+	/// <param name="Input">Input byte to process</param>
+	void Update(byte Input) override;
+
+	/// <summary>
+	/// Update the Mac with a block of bytes
+	/// </summary>
+	///
+	/// <param name="Input">The input data array to process</param>
+	/// <param name="InOffset">Starting position with the input array</param>
+	/// <param name="Length">The length of data to process in bytes</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized, or the Input array is too small</exception>
+	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
+
+	/// <summary>
+	/// Update the Mac with a message stored as a list of fragments
+	/// <para>The fragments are absorbed in list order as one contiguous message; a partial block is carried across each fragment boundary, so no fragment is copied.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of message fragments</param>
+	void UpdateSegments(const std::vector<MemorySegment> &Input) override;
+
+private:
+
+	void Absorb(const std::vector<byte> &Input, size_t InOffset, size_t Length);
+	void AbsorbPad();
+	void AbsorbString(const std::vector<byte> &Input);
+	void Scope();
+	void StateReset(std::vector<ulong> &State);
+};
+
+NAMESPACE_MACEND
+#endif
@@ -2,6 +2,7 @@
 #include "HKDF.h"
 #include "KDF2.h"
 #include "PBKDF2.h"
+#include "SHAKE.h"
 
 NAMESPACE_HELPER
 
@@ -23,6 +24,9 @@ IKdf* KdfFromName::GetInstance(Kdfs KdfType, Digests DigestType)
 		case Kdfs::PBKDF2:
 			return new Kdf::PBKDF2(DigestType);
 			break;
+		case Kdfs::SHAKE:
+			return new Kdf::SHAKE(DigestType);
+			break;
 		default:
 			throw Exception::CryptoException("KdfFromName:GetInstance", "The kdf type is not recognized!");
 		}
@@ -29,7 +29,15 @@ enum class Kdfs : byte
 	/// <summary>
 	/// An implementation of the SCRYPT KDF
 	/// </summary>
-	SCRYPT = 4
+	SCRYPT = 4,
+	/// <summary>
+	/// An implementation of the Argon2id memory-hard KDF
+	/// </summary>
+	ARGON2 = 5,
+	/// <summary>
+	/// The SHAKE and cSHAKE extendable output functions; SHAKE128 or SHAKE256 selected by the Keccak digest type
+	/// </summary>
+	SHAKE = 6
 };
 
 NAMESPACE_ENUMERATIONEND
@@ -1,10 +1,36 @@
 #include "Keccak.h"
 #include "IntUtils.h"
+#if defined(__AVX2__)
+#	include "ULong256.h"
+#endif
 
 NAMESPACE_DIGEST
 
 using Utility::IntUtils;
 
+const ulong Keccak::RC[24] =
+{
+	0x0000000000000001, 0x0000000000008082, 0x800000000000808A, 0x8000000080008000,
+	0x000000000000808B, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+	0x000000000000008A, 0x0000000000000088, 0x0000000080008009, 0x000000008000000A,
+	0x000000008000808B, 0x800000000000008B, 0x8000000000008089, 0x8000000000008003,
+	0x8000000000008002, 0x8000000000000080, 0x000000000000800A, 0x800000008000000A,
+	0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008
+};
+
+std::vector<byte> Keccak::LeftEncode(ulong Value)
+{
+	std::vector<byte> enc = RightEncode(Value);
+
+	// move the byte count from the end to the front
+	const byte CTR = enc[enc.size() - 1];
+	for (size_t i = enc.size() - 1; i > 0; --i)
+		enc[i] = enc[i - 1];
+	enc[0] = CTR;
+
+	return enc;
+}
+
 void Keccak::Permute(const std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<ulong> &State)
 {
 	for (size_t i = 0; i < Length / sizeof(ulong); ++i)
@@ -2655,4 +2681,328 @@ void Keccak::Permute(const std::vector<byte> &Input, size_t InOffset, size_t Len
 	State[24] = Asu;
 }
 
+void Keccak::PermuteP4x(std::vector<ulong> &State, size_t Rounds)
+{
+	CexAssert(State.size() >= 25 * PARALLEL_LANES, "The state array is too small");
+	CexAssert(Rounds != 0 && Rounds <= 24, "The number of rounds must be between 1 and 24");
+
+#if defined(__AVX2__)
+
+	using Numeric::ULong256;
+
+	ULong256 Aba, Abe, Abi, Abo, Abu;
+	ULong256 Aga, Age, Agi, Ago, Agu;
+	ULong256 Aka, Ake, Aki, Ako, Aku;
+	ULong256 Ama, Ame, Ami, Amo, Amu;
+	ULong256 Asa, Ase, Asi, Aso, Asu;
+	ULong256 Bba, Bbe, Bbi, Bbo, Bbu;
+	ULong256 Bga, Bge, Bgi, Bgo, Bgu;
+	ULong256 Bka, Bke, Bki, Bko, Bku;
+	ULong256 Bma, Bme, Bmi, Bmo, Bmu;
+	ULong256 Bsa, Bse, Bsi, Bso, Bsu;
+	ULong256 Ca, Ce, Ci, Co, Cu;
+	ULong256 Da, De, Di, Do, Du;
+
+	Aba.Load(State, 0);
+	Abe.Load(State, 4);
+	Abi.Load(State, 8);
+	Abo.Load(State, 12);
+	Abu.Load(State, 16);
+	Aga.Load(State, 20);
+	Age.Load(State, 24);
+	Agi.Load(State, 28);
+	Ago.Load(State, 32);
+	Agu.Load(State, 36);
+	Aka.Load(State, 40);
+	Ake.Load(State, 44);
+	Aki.Load(State, 48);
+	Ako.Load(State, 52);
+	Aku.Load(State, 56);
+	Ama.Load(State, 60);
+	Ame.Load(State, 64);
+	Ami.Load(State, 68);
+	Amo.Load(State, 72);
+	Amu.Load(State, 76);
+	Asa.Load(State, 80);
+	Ase.Load(State, 84);
+	Asi.Load(State, 88);
+	Aso.Load(State, 92);
+	Asu.Load(State, 96);
+
+	for (size_t i = 24 - Rounds; i < 24; ++i)
+	{
+		// theta
+		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+		Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+		Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+		Da = Cu ^ ULong256::RotL64(Ce, 1);
+		De = Ca ^ ULong256::RotL64(Ci, 1);
+		Di = Ce ^ ULong256::RotL64(Co, 1);
+		Do = Ci ^ ULong256::RotL64(Cu, 1);
+		Du = Co ^ ULong256::RotL64(Ca, 1);
+
+		// rho and pi
+		Bba = Aba ^ Da;
+		Bka = ULong256::RotL64(Abe ^ De, 1);
+		Bsa = ULong256::RotL64(Abi ^ Di, 62);
+		Bga = ULong256::RotL64(Abo ^ Do, 28);
+		Bma = ULong256::RotL64(Abu ^ Du, 27);
+		Bme = ULong256::RotL64(Aga ^ Da, 36);
+		Bbe = ULong256::RotL64(Age ^ De, 44);
+		Bke = ULong256::RotL64(Agi ^ Di, 6);
+		Bse = ULong256::RotL64(Ago ^ Do, 55);
+		Bge = ULong256::RotL64(Agu ^ Du, 20);
+		Bgi = ULong256::RotL64(Aka ^ Da, 3);
+		Bmi = ULong256::RotL64(Ake ^ De, 10);
+		Bbi = ULong256::RotL64(Aki ^ Di, 43);
+		Bki = ULong256::RotL64(Ako ^ Do, 25);
+		Bsi = ULong256::RotL64(Aku ^ Du, 39);
+		Bso = ULong256::RotL64(Ama ^ Da, 41);
+		Bgo = ULong256::RotL64(Ame ^ De, 45);
+		Bmo = ULong256::RotL64(Ami ^ Di, 15);
+		Bbo = ULong256::RotL64(Amo ^ Do, 21);
+		Bko = ULong256::RotL64(Amu ^ Du, 8);
+		Bku = ULong256::RotL64(Asa ^ Da, 18);
+		Bsu = ULong256::RotL64(Ase ^ De, 2);
+		Bgu = ULong256::RotL64(Asi ^ Di, 61);
+		Bmu = ULong256::RotL64(Aso ^ Do, 56);
+		Bbu = ULong256::RotL64(Asu ^ Du, 14);
+
+		// chi
+		Aba = Bba ^ Bbe.AndNot(Bbi);
+		Abe = Bbe ^ Bbi.AndNot(Bbo);
+		Abi = Bbi ^ Bbo.AndNot(Bbu);
+		Abo = Bbo ^ Bbu.AndNot(Bba);
+		Abu = Bbu ^ Bba.AndNot(Bbe);
+		Aga = Bga ^ Bge.AndNot(Bgi);
+		Age = Bge ^ Bgi.AndNot(Bgo);
+		Agi = Bgi ^ Bgo.AndNot(Bgu);
+		Ago = Bgo ^ Bgu.AndNot(Bga);
+		Agu = Bgu ^ Bga.AndNot(Bge);
+		Aka = Bka ^ Bke.AndNot(Bki);
+		Ake = Bke ^ Bki.AndNot(Bko);
+		Aki = Bki ^ Bko.AndNot(Bku);
+		Ako = Bko ^ Bku.AndNot(Bka);
+		Aku = Bku ^ Bka.AndNot(Bke);
+		Ama = Bma ^ Bme.AndNot(Bmi);
+		Ame = Bme ^ Bmi.AndNot(Bmo);
+		Ami = Bmi ^ Bmo.AndNot(Bmu);
+		Amo = Bmo ^ Bmu.AndNot(Bma);
+		Amu = Bmu ^ Bma.AndNot(Bme);
+		Asa = Bsa ^ Bse.AndNot(Bsi);
+		Ase = Bse ^ Bsi.AndNot(Bso);
+		Asi = Bsi ^ Bso.AndNot(Bsu);
+		Aso = Bso ^ Bsu.AndNot(Bsa);
+		Asu = Bsu ^ Bsa.AndNot(Bse);
+
+		// iota
+		Aba ^= ULong256(RC[i]);
+	}
+
+	Aba.Store(State, 0);
+	Abe.Store(State, 4);
+	Abi.Store(State, 8);
+	Abo.Store(State, 12);
+	Abu.Store(State, 16);
+	Aga.Store(State, 20);
+	Age.Store(State, 24);
+	Agi.Store(State, 28);
+	Ago.Store(State, 32);
+	Agu.Store(State, 36);
+	Aka.Store(State, 40);
+	Ake.Store(State, 44);
+	Aki.Store(State, 48);
+	Ako.Store(State, 52);
+	Aku.Store(State, 56);
+	Ama.Store(State, 60);
+	Ame.Store(State, 64);
+	Ami.Store(State, 68);
+	Amo.Store(State, 72);
+	Amu.Store(State, 76);
+	Asa.Store(State, 80);
+	Ase.Store(State, 84);
+	Asi.Store(State, 88);
+	Aso.Store(State, 92);
+	Asu.Store(State, 96);
+
+#else
+
+	std::vector<ulong> tmp(25);
+
+	for (size_t n = 0; n < PARALLEL_LANES; ++n)
+	{
+		for (size_t i = 0; i < 25; ++i)
+			tmp[i] = State[(i * PARALLEL_LANES) + n];
+
+		PermuteR(tmp, Rounds);
+
+		for (size_t i = 0; i < 25; ++i)
+			State[(i * PARALLEL_LANES) + n] = tmp[i];
+	}
+
+#endif
+}
+
+void Keccak::PermuteR(std::vector<ulong> &State, size_t Rounds)
+{
+	CexAssert(State.size() >= 25, "The state array is too small");
+	CexAssert(Rounds != 0 && Rounds <= 24, "The number of rounds must be between 1 and 24");
+
+	ulong Aba, Abe, Abi, Abo, Abu;
+	ulong Aga, Age, Agi, Ago, Agu;
+	ulong Aka, Ake, Aki, Ako, Aku;
+	ulong Ama, Ame, Ami, Amo, Amu;
+	ulong Asa, Ase, Asi, Aso, Asu;
+	ulong Bba, Bbe, Bbi, Bbo, Bbu;
+	ulong Bga, Bge, Bgi, Bgo, Bgu;
+	ulong Bka, Bke, Bki, Bko, Bku;
+	ulong Bma, Bme, Bmi, Bmo, Bmu;
+	ulong Bsa, Bse, Bsi, Bso, Bsu;
+	ulong Ca, Ce, Ci, Co, Cu;
+	ulong Da, De, Di, Do, Du;
+
+	Aba = State[0];
+	Abe = State[1];
+	Abi = State[2];
+	Abo = State[3];
+	Abu = State[4];
+	Aga = State[5];
+	Age = State[6];
+	Agi = State[7];
+	Ago = State[8];
+	Agu = State[9];
+	Aka = State[10];
+	Ake = State[11];
+	Aki = State[12];
+	Ako = State[13];
+	Aku = State[14];
+	Ama = State[15];
+	Ame = State[16];
+	Ami = State[17];
+	Amo = State[18];
+	Amu = State[19];
+	Asa = State[20];
+	Ase = State[21];
+	Asi = State[22];
+	Aso = State[23];
+	Asu = State[24];
+
+	for (size_t i = 24 - Rounds; i < 24; ++i)
+	{
+		// theta
+		Ca = Aba ^ Aga ^ Aka ^ Ama ^ Asa;
+		Ce = Abe ^ Age ^ Ake ^ Ame ^ Ase;
+		Ci = Abi ^ Agi ^ Aki ^ Ami ^ Asi;
+		Co = Abo ^ Ago ^ Ako ^ Amo ^ Aso;
+		Cu = Abu ^ Agu ^ Aku ^ Amu ^ Asu;
+		Da = Cu ^ IntUtils::RotL64(Ce, 1);
+		De = Ca ^ IntUtils::RotL64(Ci, 1);
+		Di = Ce ^ IntUtils::RotL64(Co, 1);
+		Do = Ci ^ IntUtils::RotL64(Cu, 1);
+		Du = Co ^ IntUtils::RotL64(Ca, 1);
+
+		// rho and pi
+		Bba = Aba ^ Da;
+		Bka = IntUtils::RotL64(Abe ^ De, 1);
+		Bsa = IntUtils::RotL64(Abi ^ Di, 62);
+		Bga = IntUtils::RotL64(Abo ^ Do, 28);
+		Bma = IntUtils::RotL64(Abu ^ Du, 27);
+		Bme = IntUtils::RotL64(Aga ^ Da, 36);
+		Bbe = IntUtils::RotL64(Age ^ De, 44);
+		Bke = IntUtils::RotL64(Agi ^ Di, 6);
+		Bse = IntUtils::RotL64(Ago ^ Do, 55);
+		Bge = IntUtils::RotL64(Agu ^ Du, 20);
+		Bgi = IntUtils::RotL64(Aka ^ Da, 3);
+		Bmi = IntUtils::RotL64(Ake ^ De, 10);
+		Bbi = IntUtils::RotL64(Aki ^ Di, 43);
+		Bki = IntUtils::RotL64(Ako ^ Do, 25);
+		Bsi = IntUtils::RotL64(Aku ^ Du, 39);
+		Bso = IntUtils::RotL64(Ama ^ Da, 41);
+		Bgo = IntUtils::RotL64(Ame ^ De, 45);
+		Bmo = IntUtils::RotL64(Ami ^ Di, 15);
+		Bbo = IntUtils::RotL64(Amo ^ Do, 21);
+		Bko = IntUtils::RotL64(Amu ^ Du, 8);
+		Bku = IntUtils::RotL64(Asa ^ Da, 18);
+		Bsu = IntUtils::RotL64(Ase ^ De, 2);
+		Bgu = IntUtils::RotL64(Asi ^ Di, 61);
+		Bmu = IntUtils::RotL64(Aso ^ Do, 56);
+		Bbu = IntUtils::RotL64(Asu ^ Du, 14);
+
+		// chi
+		Aba = Bba ^ (~Bbe & Bbi);
+		Abe = Bbe ^ (~Bbi & Bbo);
+		Abi = Bbi ^ (~Bbo & Bbu);
+		Abo = Bbo ^ (~Bbu & Bba);
+		Abu = Bbu ^ (~Bba & Bbe);
+		Aga = Bga ^ (~Bge & Bgi);
+		Age = Bge ^ (~Bgi & Bgo);
+		Agi = Bgi ^ (~Bgo & Bgu);
+		Ago = Bgo ^ (~Bgu & Bga);
+		Agu = Bgu ^ (~Bga & Bge);
+		Aka = Bka ^ (~Bke & Bki);
+		Ake = Bke ^ (~Bki & Bko);
+		Aki = Bki ^ (~Bko & Bku);
+		Ako = Bko ^ (~Bku & Bka);
+		Aku = Bku ^ (~Bka & Bke);
+		Ama = Bma ^ (~Bme & Bmi);
+		Ame = Bme ^ (~Bmi & Bmo);
+		Ami = Bmi ^ (~Bmo & Bmu);
+		Amo = Bmo ^ (~Bmu & Bma);
+		Amu = Bmu ^ (~Bma & Bme);
+		Asa = Bsa ^ (~Bse & Bsi);
+		Ase = Bse ^ (~Bsi & Bso);
+		Asi = Bsi ^ (~Bso & Bsu);
+		Aso = Bso ^ (~Bsu & Bsa);
+		Asu = Bsu ^ (~Bsa & Bse);
+
+		// iota
+		Aba ^= RC[i];
+	}
+
+	State[0] = Aba;
+	State[1] = Abe;
+	State[2] = Abi;
+	State[3] = Abo;
+	State[4] = Abu;
+	State[5] = Aga;
+	State[6] = Age;
+	State[7] = Agi;
+	State[8] = Ago;
+	State[9] = Agu;
+	State[10] = Aka;
+	State[11] = Ake;
+	State[12] = Aki;
+	State[13] = Ako;
+	State[14] = Aku;
+	State[15] = Ama;
+	State[16] = Ame;
+	State[17] = Ami;
+	State[18] = Amo;
+	State[19] = Amu;
+	State[20] = Asa;
+	State[21] = Ase;
+	State[22] = Asi;
+	State[23] = Aso;
+	State[24] = Asu;
+}
+
+std::vector<byte> Keccak::RightEncode(ulong Value)
+{
+	size_t ctr = 1;
+
+	while (ctr < sizeof(ulong) && (Value >> (8 * ctr)) != 0)
+		++ctr;
+
+	std::vector<byte> enc(ctr + 1);
+
+	for (size_t i = 0; i < ctr; ++i)
+		enc[i] = static_cast<byte>(Value >> (8 * (ctr - i - 1)));
+
+	enc[ctr] = static_cast<byte>(ctr);
+
+	return enc;
+}
+
 NAMESPACE_DIGESTEND
\ No newline at end of file
@@ -31,7 +31,42 @@ class Keccak
 
 public:
 
+	/// <summary>
+	/// The number of states processed by the parallel permutation
+	/// </summary>
+	static const size_t PARALLEL_LANES = 4;
+
+	/// <summary>
+	/// The NIST SP 800-185 left_encode function; the byte count is prepended to the big endian integer
+	/// </summary>
+	static std::vector<byte> LeftEncode(ulong Value);
+
+	/// <summary>
+	/// Absorb a block into a lane complemented state, and run the Keccak-f[1600] permutation
+	/// </summary>
 	static void Permute(const std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<ulong> &State);
+
+	/// <summary>
+	/// Run the Keccak-p[1600] permutation on 4 independent states.
+	/// <para>The states are interleaved by lane, State[(i * 4) + n] is lane i of state n, and are not lane complemented.
+	/// Uses AVX2 when available, otherwise each state is permuted in sequence.
+	/// A reduced round count runs the last Rounds rounds of Keccak-f[1600], as specified by Keccak-p.</para>
+	/// </summary>
+	static void PermuteP4x(std::vector<ulong> &State, size_t Rounds = 24);
+
+	/// <summary>
+	/// Run the last Rounds rounds of the Keccak-f[1600] permutation (Keccak-p[1600, Rounds]) on a state that is not lane complemented
+	/// </summary>
+	static void PermuteR(std::vector<ulong> &State, size_t Rounds);
+
+	/// <summary>
+	/// The NIST SP 800-185 right_encode function; the byte count is appended to the big endian integer
+	/// </summary>
+	static std::vector<byte> RightEncode(ulong Value);
+
+private:
+
+	static const ulong RC[24];
 };
 
 NAMESPACE_DIGESTEND
@@ -3,6 +3,9 @@
 #include "IntUtils.h"
 #include "MemUtils.h"
 #include "ParallelUtils.h"
+#include "SegmentUtils.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
 
 NAMESPACE_DIGEST
 
@@ -57,7 +60,8 @@ Keccak1024::Keccak1024(bool Parallel)
 	m_isDestroyed(false),
 	m_msgBuffer(Parallel ? DEF_PRLDEGREE * BLOCK_SIZE : BLOCK_SIZE),
 	m_msgLength(0),
-	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, DEF_PRLDEGREE)
+	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, DEF_PRLDEGREE),
+	m_segmentStage(0)
 {
 	if (m_parallelProfile.IsParallel())
 		m_parallelProfile.IsParallel() = Parallel;
@@ -72,7 +76,8 @@ Keccak1024::Keccak1024(KeccakParams &Params)
 	m_isDestroyed(false),
 	m_msgBuffer(BLOCK_SIZE),
 	m_msgLength(0),
-	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, m_treeParams.FanOut())
+	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, m_treeParams.FanOut()),
+	m_segmentStage(0)
 {
 	if (m_treeParams.FanOut() > 1)
 	{
@@ -113,6 +118,7 @@ void Keccak1024::Destroy()
 
 		Utility::IntUtils::ClearVector(m_dgtState);
 		Utility::IntUtils::ClearVector(m_msgBuffer);
+		Utility::IntUtils::ClearVector(m_segmentStage);
 	}
 }
 
@@ -201,6 +207,54 @@ size_t Keccak1024::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 	return (OUTLEN >= DIGEST_SIZE) ? DIGEST_SIZE : OUTLEN;
 }
 
+void Keccak1024::LoadState(const std::vector<byte> &State)
+{
+	if (State.size() < 10 + sizeof(ushort))
+		throw CryptoDigestException("Keccak1024:LoadState", "The state array is too short!");
+
+	IO::MemoryStream strm(State);
+	IO::StreamReader reader(strm);
+
+	if (reader.ReadByte() != STATE_VERSION)
+		throw CryptoDigestException("Keccak1024:LoadState", "The state version is not supported!");
+	if (reader.ReadByte() != static_cast<byte>(Digests::Keccak1024))
+		throw CryptoDigestException("Keccak1024:LoadState", "The state was not created by this digest!");
+
+	const size_t LEAFCNT = reader.ReadInt<uint>();
+	if (LEAFCNT != m_dgtState.size())
+		throw CryptoDigestException("Keccak1024:LoadState", "The number of tree leaves does not match this digest instance!");
+
+	const size_t PRMLEN = reader.ReadInt<ushort>();
+	if (reader.Position() + PRMLEN + sizeof(uint) > State.size())
+		throw CryptoDigestException("Keccak1024:LoadState", "The state array is malformed!");
+
+	// the tree parameters are fixed by the instance settings; a state hashed under different parameters is rejected, not adopted
+	if (PRMLEN != m_treeParams.ToBytes().size())
+		throw CryptoDigestException("Keccak1024:LoadState", "The tree parameters do not match this digest instance!");
+
+	KeccakParams params(reader.ReadBytes(PRMLEN));
+	// the node offset is rewritten as each leaf is reset
+	params.NodeOffset() = m_treeParams.NodeOffset();
+
+	if (params.ToBytes() != m_treeParams.ToBytes())
+		throw CryptoDigestException("Keccak1024:LoadState", "The tree parameters do not match this digest instance!");
+
+	const size_t MSGLEN = reader.ReadInt<uint>();
+
+	if (MSGLEN > m_msgBuffer.size() || reader.Position() + MSGLEN + (LEAFCNT * ((STATE_SIZE + 1) * sizeof(ulong))) != State.size())
+		throw CryptoDigestException("Keccak1024:LoadState", "The state array is malformed!");
+
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	reader.Read(m_msgBuffer, 0, MSGLEN);
+	m_msgLength = MSGLEN;
+
+	for (size_t i = 0; i < m_dgtState.size(); ++i)
+	{
+		reader.Read(m_dgtState[i].H, 0, m_dgtState[i].H.size());
+		m_dgtState[i].T = reader.ReadInt<ulong>();
+	}
+}
+
 void Keccak1024::ParallelMaxDegree(size_t Degree)
 {
 	if (Degree == 0)
@@ -230,6 +284,28 @@ void Keccak1024::Reset()
 		}
 	}
 }
+
+std::vector<byte> Keccak1024::SaveState()
+{
+	std::vector<byte> params = m_treeParams.ToBytes();
+	IO::StreamWriter writer(10 + sizeof(ushort) + params.size() + m_msgLength + (m_dgtState.size() * ((STATE_SIZE + 1) * sizeof(ulong))));
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Digests::Keccak1024));
+	writer.Write(static_cast<uint>(m_dgtState.size()));
+	writer.Write(static_cast<ushort>(params.size()));
+	writer.Write(params, 0, params.size());
+	writer.Write(static_cast<uint>(m_msgLength));
+	writer.Write(m_msgBuffer, 0, m_msgLength);
+
+	for (size_t i = 0; i < m_dgtState.size(); ++i)
+	{
+		writer.Write(m_dgtState[i].H);
+		writer.Write(m_dgtState[i].T);
+	}
+
+	return writer.GetBytes();
+}
 //0: 0x0000000000000001
 //1: 8082
 //2: 800000000000808a
@@ -373,6 +449,11 @@ void Keccak1024::Update(const std::vector<byte> &Input, size_t InOffset, size_t
 	}
 }
 
+void Keccak1024::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input, m_segmentStage);
+}
+
 //~~~Private Functions~~~//
 
 void Keccak1024::HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, Keccak1024State &State)
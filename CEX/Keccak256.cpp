@@ -3,6 +3,9 @@
 #include "IntUtils.h"
 #include "MemUtils.h"
 #include "ParallelUtils.h"
+#include "SegmentUtils.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
 
 NAMESPACE_DIGEST
 
@@ -57,6 +60,7 @@ Keccak256::Keccak256(bool Parallel)
 	m_msgBuffer(Parallel ? DEF_PRLDEGREE * BLOCK_SIZE : BLOCK_SIZE),
 	m_msgLength(0),
 	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, DEF_PRLDEGREE),
+	m_segmentStage(0),
 	m_dgtState(Parallel ? DEF_PRLDEGREE : 1)
 {
 	if (m_parallelProfile.IsParallel())
@@ -72,7 +76,8 @@ Keccak256::Keccak256(KeccakParams &Params)
 	m_isDestroyed(false),
 	m_msgBuffer(BLOCK_SIZE),
 	m_msgLength(0),
-	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, m_treeParams.FanOut())
+	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, m_treeParams.FanOut()),
+	m_segmentStage(0)
 {
 	if (m_treeParams.FanOut() > 1)
 	{
@@ -113,6 +118,7 @@ void Keccak256::Destroy()
 
 		Utility::IntUtils::ClearVector(m_dgtState);
 		Utility::IntUtils::ClearVector(m_msgBuffer);
+		Utility::IntUtils::ClearVector(m_segmentStage);
 	}
 }
 
@@ -181,6 +187,54 @@ size_t Keccak256::Finalize(std::vector<byte> &Output, size_t OutOffset)
 	return DIGEST_SIZE;
 }
 
+void Keccak256::LoadState(const std::vector<byte> &State)
+{
+	if (State.size() < 10 + sizeof(ushort))
+		throw CryptoDigestException("Keccak256:LoadState", "The state array is too short!");
+
+	IO::MemoryStream strm(State);
+	IO::StreamReader reader(strm);
+
+	if (reader.ReadByte() != STATE_VERSION)
+		throw CryptoDigestException("Keccak256:LoadState", "The state version is not supported!");
+	if (reader.ReadByte() != static_cast<byte>(Digests::Keccak256))
+		throw CryptoDigestException("Keccak256:LoadState", "The state was not created by this digest!");
+
+	const size_t LEAFCNT = reader.ReadInt<uint>();
+	if (LEAFCNT != m_dgtState.size())
+		throw CryptoDigestException("Keccak256:LoadState", "The number of tree leaves does not match this digest instance!");
+
+	const size_t PRMLEN = reader.ReadInt<ushort>();
+	if (reader.Position() + PRMLEN + sizeof(uint) > State.size())
+		throw CryptoDigestException("Keccak256:LoadState", "The state array is malformed!");
+
+	// the tree parameters are fixed by the instance settings; a state hashed under different parameters is rejected, not adopted
+	if (PRMLEN != m_treeParams.ToBytes().size())
+		throw CryptoDigestException("Keccak256:LoadState", "The tree parameters do not match this digest instance!");
+
+	KeccakParams params(reader.ReadBytes(PRMLEN));
+	// the node offset is rewritten as each leaf is reset
+	params.NodeOffset() = m_treeParams.NodeOffset();
+
+	if (params.ToBytes() != m_treeParams.ToBytes())
+		throw CryptoDigestException("Keccak256:LoadState", "The tree parameters do not match this digest instance!");
+
+	const size_t MSGLEN = reader.ReadInt<uint>();
+
+	if (MSGLEN > m_msgBuffer.size() || reader.Position() + MSGLEN + (LEAFCNT * ((STATE_SIZE + 1) * sizeof(ulong))) != State.size())
+		throw CryptoDigestException("Keccak256:LoadState", "The state array is malformed!");
+
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	reader.Read(m_msgBuffer, 0, MSGLEN);
+	m_msgLength = MSGLEN;
+
+	for (size_t i = 0; i < m_dgtState.size(); ++i)
+	{
+		reader.Read(m_dgtState[i].H, 0, m_dgtState[i].H.size());
+		m_dgtState[i].T = reader.ReadInt<ulong>();
+	}
+}
+
 void Keccak256::ParallelMaxDegree(size_t Degree)
 {
 	if (Degree == 0)
@@ -211,6 +265,28 @@ void Keccak256::Reset()
 	}
 }
 
+std::vector<byte> Keccak256::SaveState()
+{
+	std::vector<byte> params = m_treeParams.ToBytes();
+	IO::StreamWriter writer(10 + sizeof(ushort) + params.size() + m_msgLength + (m_dgtState.size() * ((STATE_SIZE + 1) * sizeof(ulong))));
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Digests::Keccak256));
+	writer.Write(static_cast<uint>(m_dgtState.size()));
+	writer.Write(static_cast<ushort>(params.size()));
+	writer.Write(params, 0, params.size());
+	writer.Write(static_cast<uint>(m_msgLength));
+	writer.Write(m_msgBuffer, 0, m_msgLength);
+
+	for (size_t i = 0; i < m_dgtState.size(); ++i)
+	{
+		writer.Write(m_dgtState[i].H);
+		writer.Write(m_dgtState[i].T);
+	}
+
+	return writer.GetBytes();
+}
+
 void Keccak256::Update(byte Input)
 {
 	std::vector<byte> one(1, Input);
@@ -303,6 +379,11 @@ void Keccak256::Update(const std::vector<byte> &Input, size_t InOffset, size_t L
 	}
 }
 
+void Keccak256::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input, m_segmentStage);
+}
+
 //~~~Private Functions~~~//
 
 void Keccak256::HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, Keccak256State &State)
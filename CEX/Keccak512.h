@@ -115,6 +115,7 @@ private:
 	// size of reserved state buffer subtracted from parallel size calculations
 	static const size_t STATE_PRECACHED = 2048;
 	static const size_t STATE_SIZE = 25;
+	static const byte STATE_VERSION = 1;
 
 	KeccakParams m_treeParams;
 	std::vector<Keccak512State> m_dgtState;
@@ -122,6 +123,7 @@ private:
 	std::vector<byte> m_msgBuffer;
 	size_t m_msgLength;
 	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_segmentStage;
 
 public:
 
@@ -228,6 +230,17 @@ public:
 	/// <exception cref="CryptoDigestException">Thrown if the output buffer is too short</exception>
 	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset) override;
 
+	/// <summary>
+	/// Restore the internal state from a checkpoint created by the SaveState function.
+	/// <para>The digest must be constructed with the same parallel and tree settings as the instance that created the state;
+	/// hashing resumes from the checkpoint, and subsequent Update and Finalize calls produce the same hash as an uninterrupted digest.</para>
+	/// </summary>
+	///
+	/// <param name="State">The serialized digest state</param>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the state version, digest type, or number of tree leaves do not match this instance</exception>
+	void LoadState(const std::vector<byte> &State) override;
+
 	/// <summary>
 	/// Set the number of threads allocated when using multi-threaded tree hashing processing.
 	/// <para>Thread count must be an even number, and not exceed the number of processor cores.
@@ -244,6 +257,14 @@ public:
 	/// </summary>
 	void Reset() override;
 
+	/// <summary>
+	/// Serialize the internal state; the version, tree parameters, pending message bytes, and the chaining value and counter of each leaf.
+	/// <para>Only the unprocessed bytes of the message buffer are written, and each leaf is stored as its raw chaining and counter words.</para>
+	/// </summary>
+	///
+	/// <returns>The serialized digest state</returns>
+	std::vector<byte> SaveState() override;
+
 	/// <summary>
 	/// Update the digest with a single byte
 	/// </summary>
@@ -262,6 +283,14 @@ public:
 	/// <exception cref="CryptoDigestException">Thrown if the input buffer is too short</exception>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the buffer with a message stored as a list of fragments
+	/// <para>The fragments are absorbed in list order as one contiguous message; a partial block is carried across each fragment boundary, so no fragment is copied.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of message fragments</param>
+	void UpdateSegments(const std::vector<MemorySegment> &Input) override;
+
 private:
 
 	void HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, Keccak512State &State);
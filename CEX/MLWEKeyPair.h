@@ -0,0 +1,76 @@
+#ifndef CEX_MLWEKEYPAIR_H
+#define CEX_MLWEKEYPAIR_H
+
+#include "CexDomain.h"
+#include "IAsymmetricKeyPair.h"
+#include "MLWEPrivateKey.h"
+#include "MLWEPublicKey.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+/// <summary>
+/// A ModuleLWE public and private key container
+/// </summary>
+class MLWEKeyPair final : public IAsymmetricKeyPair
+{
+private:
+
+	MLWEPrivateKey* m_privateKey;
+	MLWEPublicKey* m_publicKey;
+	std::vector<byte> m_Tag;
+
+public:
+
+	MLWEKeyPair(const MLWEKeyPair&) = delete;
+	MLWEKeyPair& operator=(const MLWEKeyPair&) = delete;
+	MLWEKeyPair& operator=(MLWEKeyPair&&) = delete;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Instantiate this class with the public/private keys
+	/// </summary>
+	/// 
+	/// <param name="PrivateKey">The private key</param>
+	/// <param name="PublicKey">The public key</param>
+	explicit MLWEKeyPair(MLWEPrivateKey* PrivateKey, MLWEPublicKey* PublicKey);
+
+	/// <summary>
+	/// Instantiate this class with the public/private keys and an identification tag
+	/// </summary>
+	/// 
+	/// <param name="PrivateKey">The private key</param>
+	/// <param name="PublicKey">The public key</param>
+	/// <param name="Tag">The identification tag</param>
+	explicit MLWEKeyPair(MLWEPrivateKey* PrivateKey, MLWEPublicKey* PublicKey, std::vector<byte> &Tag);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~MLWEKeyPair() override;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// The Private Key
+	/// </summary>
+	IAsymmetricKey* PrivateKey() override;
+
+	/// <summary>
+	/// The Public key
+	/// </summary>
+	IAsymmetricKey* PublicKey() override;
+
+	/// <summary>
+	/// An optional identification tag
+	/// </summary>
+	const std::vector<byte> &Tag() override;
+
+private:
+
+	void Destroy();
+};
+
+NAMESPACE_ASYMMETRICKEYEND
+#endif
+
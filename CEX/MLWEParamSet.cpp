@@ -0,0 +1,119 @@
+#include "MLWEParamSet.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
+
+NAMESPACE_MODULELWE
+
+//~~~Constructor~~~//
+
+MLWEParamSet::MLWEParamSet()
+	:
+	CipherTextSize(0),
+	DU(0),
+	DV(0),
+	Eta1(0),
+	Eta2(0),
+	K(0),
+	N(0),
+	ParamName(MLWEParams::None),
+	PrivateKeySize(0),
+	PublicKeySize(0),
+	Q(0),
+	SecretSize(0)
+{}
+
+MLWEParamSet::MLWEParamSet(uint Coefficients, int Modulus, uint Rank, uint SecretNoise, uint ErrorNoise, uint CompressU, uint CompressV, uint PubKeySize, uint PriKeySize, uint CptSize, uint SecretByteSize, MLWEParams ParamSet)
+	:
+	CipherTextSize(CptSize),
+	DU(CompressU),
+	DV(CompressV),
+	Eta1(SecretNoise),
+	Eta2(ErrorNoise),
+	K(Rank),
+	N(Coefficients),
+	ParamName(ParamSet),
+	PrivateKeySize(PriKeySize),
+	PublicKeySize(PubKeySize),
+	Q(Modulus),
+	SecretSize(SecretByteSize)
+{}
+
+MLWEParamSet::MLWEParamSet(const std::vector<byte> &ParamArray)
+{
+	IO::MemoryStream ms = IO::MemoryStream(ParamArray);
+	IO::StreamReader reader(ms);
+
+	CipherTextSize = reader.ReadInt<uint>();
+	DU = reader.ReadInt<uint>();
+	DV = reader.ReadInt<uint>();
+	Eta1 = reader.ReadInt<uint>();
+	Eta2 = reader.ReadInt<uint>();
+	K = reader.ReadInt<uint>();
+	N = reader.ReadInt<uint>();
+	ParamName = (MLWEParams)reader.ReadByte();
+	PrivateKeySize = reader.ReadInt<uint>();
+	PublicKeySize = reader.ReadInt<uint>();
+	Q = reader.ReadInt<int>();
+	SecretSize = reader.ReadInt<uint>();
+}
+
+MLWEParamSet::~MLWEParamSet()
+{
+	Reset();
+}
+
+//~~~Public Functions~~~//
+
+void MLWEParamSet::Load(uint Coefficients, int Modulus, uint Rank, uint SecretNoise, uint ErrorNoise, uint CompressU, uint CompressV, uint PubKeySize, uint PriKeySize, uint CptSize, uint SecretByteSize, MLWEParams ParamSet)
+{
+	CipherTextSize = CptSize;
+	DU = CompressU;
+	DV = CompressV;
+	Eta1 = SecretNoise;
+	Eta2 = ErrorNoise;
+	K = Rank;
+	N = Coefficients;
+	ParamName = ParamSet;
+	PrivateKeySize = PriKeySize;
+	PublicKeySize = PubKeySize;
+	Q = Modulus;
+	SecretSize = SecretByteSize;
+}
+
+void MLWEParamSet::Reset()
+{
+	CipherTextSize = 0;
+	DU = 0;
+	DV = 0;
+	Eta1 = 0;
+	Eta2 = 0;
+	K = 0;
+	N = 0;
+	ParamName = MLWEParams::None;
+	PrivateKeySize = 0;
+	PublicKeySize = 0;
+	Q = 0;
+	SecretSize = 0;
+}
+
+std::vector<byte> MLWEParamSet::ToBytes()
+{
+	IO::StreamWriter writer(45);
+
+	writer.Write<uint>(CipherTextSize);
+	writer.Write<uint>(DU);
+	writer.Write<uint>(DV);
+	writer.Write<uint>(Eta1);
+	writer.Write<uint>(Eta2);
+	writer.Write<uint>(K);
+	writer.Write<uint>(N);
+	writer.Write<byte>((byte)ParamName);
+	writer.Write<uint>(PrivateKeySize);
+	writer.Write<uint>(PublicKeySize);
+	writer.Write<int>(Q);
+	writer.Write<uint>(SecretSize);
+
+	return writer.GetBytes();
+}
+
+NAMESPACE_MODULELWEEND
@@ -0,0 +1,171 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_MLWEPARAMSET_H
+#define CEX_MLWEPARAMSET_H
+
+#include "CexDomain.h"
+#include "MLWEParams.h"
+
+NAMESPACE_MODULELWE
+
+using Enumeration::MLWEParams;
+
+/// <summary>
+/// ModuleLWE parameter settings
+/// </summary>
+struct MLWEParamSet
+{
+	MLWEParamSet(const MLWEParamSet&) = delete;
+	MLWEParamSet& operator=(const MLWEParamSet&) = delete;
+	MLWEParamSet& operator=(MLWEParamSet&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// The cipher-texts byte size
+	/// </summary>
+	uint CipherTextSize;
+
+	/// <summary>
+	/// The number of bits each coefficient of u is compressed to
+	/// </summary>
+	uint DU;
+
+	/// <summary>
+	/// The number of bits each coefficient of v is compressed to
+	/// </summary>
+	uint DV;
+
+	/// <summary>
+	/// The binomial noise bound of the secret vector and the encryption mask
+	/// </summary>
+	uint Eta1;
+
+	/// <summary>
+	/// The binomial noise bound of the encryption error terms
+	/// </summary>
+	uint Eta2;
+
+	/// <summary>
+	/// The module rank; the number of polynomials in each vector
+	/// </summary>
+	uint K;
+
+	/// <summary>
+	/// The number of coefficients
+	/// </summary>
+	uint N;
+
+	/// <summary>
+	/// The parameter sets enumeration name
+	/// </summary>
+	MLWEParams ParamName;
+
+	/// <summary>
+	/// The private keys byte size
+	/// </summary>
+	uint PrivateKeySize;
+
+	/// <summary>
+	/// The public keys byte size
+	/// </summary>
+	uint PublicKeySize;
+
+	/// <summary>
+	/// The Q modulus
+	/// </summary>
+	int Q;
+
+	/// <summary>
+	/// The byte size of the shared secret
+	/// </summary>
+	uint SecretSize;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Initialize an empty ModuleLWE parameter structure
+	/// </summary>
+	MLWEParamSet();
+
+	/// <summary>
+	/// Initialize the ModuleLWE parameter structure
+	/// </summary>
+	///
+	/// <param name="Coefficients">The number of coefficients</param>
+	/// <param name="Modulus">The Q modulus</param>
+	/// <param name="Rank">The module rank</param>
+	/// <param name="SecretNoise">The binomial noise bound of the secret vector and the encryption mask</param>
+	/// <param name="ErrorNoise">The binomial noise bound of the encryption error terms</param>
+	/// <param name="CompressU">The number of bits each coefficient of u is compressed to</param>
+	/// <param name="CompressV">The number of bits each coefficient of v is compressed to</param>
+	/// <param name="PubKeySize">The public keys byte size</param>
+	/// <param name="PriKeySize">The private keys byte size</param>
+	/// <param name="CptSize">The cipher-texts byte size</param>
+	/// <param name="SecretByteSize">The byte size of the shared secret</param>
+	/// <param name="ParamSet">The parameter sets enumeration name</param>
+	MLWEParamSet(uint Coefficients, int Modulus, uint Rank, uint SecretNoise, uint ErrorNoise, uint CompressU, uint CompressV, uint PubKeySize, uint PriKeySize, uint CptSize, uint SecretByteSize, MLWEParams ParamSet);
+
+	/// <summary>
+	/// Initialize the ModuleLWE parameter structure using a byte array
+	/// </summary>
+	///
+	/// <param name="ParamArray">The byte array containing the MLWEParamSet</param>
+	explicit MLWEParamSet(const std::vector<byte> &ParamArray);
+
+	/// <summary>
+	/// Finalize state
+	/// </summary>
+	~MLWEParamSet();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Load the parameter values
+	/// </summary>
+	///
+	/// <param name="Coefficients">The number of coefficients</param>
+	/// <param name="Modulus">The Q modulus</param>
+	/// <param name="Rank">The module rank</param>
+	/// <param name="SecretNoise">The binomial noise bound of the secret vector and the encryption mask</param>
+	/// <param name="ErrorNoise">The binomial noise bound of the encryption error terms</param>
+	/// <param name="CompressU">The number of bits each coefficient of u is compressed to</param>
+	/// <param name="CompressV">The number of bits each coefficient of v is compressed to</param>
+	/// <param name="PubKeySize">The public keys byte size</param>
+	/// <param name="PriKeySize">The private keys byte size</param>
+	/// <param name="CptSize">The cipher-texts byte size</param>
+	/// <param name="SecretByteSize">The byte size of the shared secret</param>
+	/// <param name="ParamSet">The parameter sets enumeration name</param>
+	void Load(uint Coefficients, int Modulus, uint Rank, uint SecretNoise, uint ErrorNoise, uint CompressU, uint CompressV, uint PubKeySize, uint PriKeySize, uint CptSize, uint SecretByteSize, MLWEParams ParamSet);
+
+	/// <summary>
+	/// Reset current parameters
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// Convert the MLWEParamSet structure to a byte array
+	/// </summary>
+	///
+	/// <returns>The byte array containing the MLWEParamSet</returns>
+	std::vector<byte> ToBytes();
+};
+
+NAMESPACE_MODULELWEEND
+#endif
@@ -0,0 +1,32 @@
+#ifndef CEX_MLWEPARAMS_H
+#define CEX_MLWEPARAMS_H
+
+#include "CexDomain.h"
+
+NAMESPACE_ENUMERATION
+
+/// <summary>
+/// The ModuleLWE (Kyber) parameter sets enumeration
+/// </summary>
+enum class MLWEParams : byte
+{
+	/// <summary>
+	/// No parameter set is specified
+	/// </summary>
+	None = 0,
+	/// <summary>
+	/// The Kyber-512 (ML-KEM-512) set; a module of rank 2 over Q 3329 with 256 coefficients, 128 bit security
+	/// </summary>
+	Q3329N256K2 = 1,
+	/// <summary>
+	/// The Kyber-768 (ML-KEM-768) set; a module of rank 3 over Q 3329 with 256 coefficients, 192 bit security
+	/// </summary>
+	Q3329N256K3 = 2,
+	/// <summary>
+	/// The Kyber-1024 (ML-KEM-1024) set; a module of rank 4 over Q 3329 with 256 coefficients, 256 bit security
+	/// </summary>
+	Q3329N256K4 = 3
+};
+
+NAMESPACE_ENUMERATIONEND
+#endif
@@ -0,0 +1,92 @@
+#include "MLWEPrivateKey.h"
+#include "CryptoAsymmetricException.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+using Exception::CryptoAsymmetricException;
+
+//~~~Properties~~~//
+
+const AsymmetricEngines MLWEPrivateKey::CipherType()
+{
+	return Enumeration::AsymmetricEngines::ModuleLWE;
+}
+
+const MLWEParams MLWEPrivateKey::Parameters()
+{
+	return m_mlweParameters;
+}
+
+const std::vector<byte> &MLWEPrivateKey::S()
+{
+	return m_sKey;
+}
+
+//~~~Constructor~~~//
+
+MLWEPrivateKey::MLWEPrivateKey(MLWEParams Parameters, const std::vector<byte> &S)
+	:
+	m_isDestroyed(false),
+	m_sKey(S),
+	m_mlweParameters(Parameters)
+{
+}
+
+MLWEPrivateKey::MLWEPrivateKey(const std::vector<byte> &KeyStream)
+	:
+	m_isDestroyed(false),
+	m_sKey(0),
+	m_mlweParameters(MLWEParams::None)
+{
+	if (KeyStream.size() < HDR_SIZE)
+	{
+		throw CryptoAsymmetricException("MLWEPrivateKey:CTor", "The key stream is too small!");
+	}
+
+	m_mlweParameters = static_cast<MLWEParams>(KeyStream[0]);
+	uint sLen = Utility::IntUtils::LeBytesTo32(KeyStream, 1);
+
+	if (KeyStream.size() - HDR_SIZE < sLen)
+	{
+		throw CryptoAsymmetricException("MLWEPrivateKey:CTor", "The key stream is truncated!");
+	}
+
+	m_sKey.resize(sLen);
+	Utility::MemUtils::Copy(KeyStream, HDR_SIZE, m_sKey, 0, sLen);
+}
+
+MLWEPrivateKey::~MLWEPrivateKey()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void MLWEPrivateKey::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_mlweParameters = MLWEParams::None;
+
+		if (m_sKey.size() > 0)
+		{
+			Utility::IntUtils::ClearVector(m_sKey);
+		}
+	}
+}
+
+std::vector<byte> MLWEPrivateKey::ToBytes()
+{
+	uint sLen = static_cast<uint>(m_sKey.size());
+	std::vector<byte> s(sLen + HDR_SIZE);
+	s[0] = static_cast<byte>(m_mlweParameters);
+	Utility::IntUtils::Le32ToBytes(sLen, s, 1);
+	Utility::MemUtils::Copy(m_sKey, 0, s, HDR_SIZE, sLen);
+
+	return s;
+}
+
+NAMESPACE_ASYMMETRICKEYEND
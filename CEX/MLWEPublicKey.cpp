@@ -0,0 +1,92 @@
+#include "MLWEPublicKey.h"
+#include "CryptoAsymmetricException.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+using Exception::CryptoAsymmetricException;
+
+//~~~Properties~~~//
+
+const AsymmetricEngines MLWEPublicKey::CipherType()
+{
+	return Enumeration::AsymmetricEngines::ModuleLWE;
+}
+
+const MLWEParams MLWEPublicKey::Parameters()
+{
+	return m_mlweParameters;
+}
+
+const std::vector<byte> &MLWEPublicKey::P()
+{
+	return m_pKey;
+}
+
+//~~~Constructor~~~//
+
+MLWEPublicKey::MLWEPublicKey(MLWEParams Parameters, const std::vector<byte> &P)
+	:
+	m_isDestroyed(false),
+	m_pKey(P),
+	m_mlweParameters(Parameters)
+{
+}
+
+MLWEPublicKey::MLWEPublicKey(const std::vector<byte> &KeyStream)
+	:
+	m_isDestroyed(false),
+	m_pKey(0),
+	m_mlweParameters(MLWEParams::None)
+{
+	if (KeyStream.size() < HDR_SIZE)
+	{
+		throw CryptoAsymmetricException("MLWEPublicKey:CTor", "The key stream is too small!");
+	}
+
+	m_mlweParameters = static_cast<MLWEParams>(KeyStream[0]);
+	uint pLen = Utility::IntUtils::LeBytesTo32(KeyStream, 1);
+
+	if (KeyStream.size() - HDR_SIZE < pLen)
+	{
+		throw CryptoAsymmetricException("MLWEPublicKey:CTor", "The key stream is truncated!");
+	}
+
+	m_pKey.resize(pLen);
+	Utility::MemUtils::Copy(KeyStream, HDR_SIZE, m_pKey, 0, pLen);
+}
+
+MLWEPublicKey::~MLWEPublicKey()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void MLWEPublicKey::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_mlweParameters = MLWEParams::None;
+
+		if (m_pKey.size() > 0)
+		{
+			Utility::IntUtils::ClearVector(m_pKey);
+		}
+	}
+}
+
+std::vector<byte> MLWEPublicKey::ToBytes()
+{
+	uint pLen = static_cast<uint>(m_pKey.size());
+	std::vector<byte> p(pLen + HDR_SIZE);
+	p[0] = static_cast<byte>(m_mlweParameters);
+	Utility::IntUtils::Le32ToBytes(pLen, p, 1);
+	Utility::MemUtils::Copy(m_pKey, 0, p, HDR_SIZE, pLen);
+
+	return p;
+}
+
+NAMESPACE_ASYMMETRICKEYEND
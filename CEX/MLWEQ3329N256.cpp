@@ -0,0 +1,1217 @@
+#include "MLWEQ3329N256.h"
+#include "CryptoAsymmetricException.h"
+#include "IntUtils.h"
+#include "Keccak.h"
+#include "MemUtils.h"
+
+NAMESPACE_MODULELWE
+
+using Exception::CryptoAsymmetricException;
+using Digest::Keccak;
+using Utility::IntUtils;
+using Utility::MemUtils;
+
+// the powers of the 256th root of unity 17 in bit-reversed order, in Montgomery form
+const short MLWEQ3329N256::Zetas[128] =
+{
+	-1044, -758, -359, -1517, 1493, 1422, 287, 202, -171, 622, 1577, 182, 962, -1202, -1474, 1468,
+	573, -1325, 264, 383, -829, 1458, -1602, -130, -681, 1017, 732, 608, -1542, 411, -205, -1571,
+	1223, 652, -552, 1015, -1293, 1491, -282, -1544, 516, -8, -320, -666, -1618, -1162, 126, 1469,
+	-853, -90, -271, 830, 107, -1421, -247, -951, -398, 961, -1508, -725, 448, -1065, 677, -1275,
+	-1103, 430, 555, 843, -1251, 871, 1550, 105, 422, 587, 177, -235, -291, -460, 1574, 1653,
+	-246, 778, 1159, -147, -777, 1483, -602, 1119, -1590, 644, -872, 349, 418, 329, -156, -75,
+	817, 1097, 603, 610, 1322, -1285, -1465, 384, -1215, -136, 1218, -1335, -874, 220, -1187, -1659,
+	-1185, -1530, -1278, 794, -1510, -854, -870, 478, -108, -308, 996, 991, 958, -1460, 1522, 1628
+};
+
+#if defined(__AVX2__)
+// the packed lane indices of the set bits in each 8 bit rejection mask
+const ulong MLWEQ3329N256::RejIndex[256] =
+{
+	0x0000000000000000, 0x0000000000000000, 0x0000000000000001, 0x0000000000000100,
+	0x0000000000000002, 0x0000000000000200, 0x0000000000000201, 0x0000000000020100,
+	0x0000000000000003, 0x0000000000000300, 0x0000000000000301, 0x0000000000030100,
+	0x0000000000000302, 0x0000000000030200, 0x0000000000030201, 0x0000000003020100,
+	0x0000000000000004, 0x0000000000000400, 0x0000000000000401, 0x0000000000040100,
+	0x0000000000000402, 0x0000000000040200, 0x0000000000040201, 0x0000000004020100,
+	0x0000000000000403, 0x0000000000040300, 0x0000000000040301, 0x0000000004030100,
+	0x0000000000040302, 0x0000000004030200, 0x0000000004030201, 0x0000000403020100,
+	0x0000000000000005, 0x0000000000000500, 0x0000000000000501, 0x0000000000050100,
+	0x0000000000000502, 0x0000000000050200, 0x0000000000050201, 0x0000000005020100,
+	0x0000000000000503, 0x0000000000050300, 0x0000000000050301, 0x0000000005030100,
+	0x0000000000050302, 0x0000000005030200, 0x0000000005030201, 0x0000000503020100,
+	0x0000000000000504, 0x0000000000050400, 0x0000000000050401, 0x0000000005040100,
+	0x0000000000050402, 0x0000000005040200, 0x0000000005040201, 0x0000000504020100,
+	0x0000000000050403, 0x0000000005040300, 0x0000000005040301, 0x0000000504030100,
+	0x0000000005040302, 0x0000000504030200, 0x0000000504030201, 0x0000050403020100,
+	0x0000000000000006, 0x0000000000000600, 0x0000000000000601, 0x0000000000060100,
+	0x0000000000000602, 0x0000000000060200, 0x0000000000060201, 0x0000000006020100,
+	0x0000000000000603, 0x0000000000060300, 0x0000000000060301, 0x0000000006030100,
+	0x0000000000060302, 0x0000000006030200, 0x0000000006030201, 0x0000000603020100,
+	0x0000000000000604, 0x0000000000060400, 0x0000000000060401, 0x0000000006040100,
+	0x0000000000060402, 0x0000000006040200, 0x0000000006040201, 0x0000000604020100,
+	0x0000000000060403, 0x0000000006040300, 0x0000000006040301, 0x0000000604030100,
+	0x0000000006040302, 0x0000000604030200, 0x0000000604030201, 0x0000060403020100,
+	0x0000000000000605, 0x0000000000060500, 0x0000000000060501, 0x0000000006050100,
+	0x0000000000060502, 0x0000000006050200, 0x0000000006050201, 0x0000000605020100,
+	0x0000000000060503, 0x0000000006050300, 0x0000000006050301, 0x0000000605030100,
+	0x0000000006050302, 0x0000000605030200, 0x0000000605030201, 0x0000060503020100,
+	0x0000000000060504, 0x0000000006050400, 0x0000000006050401, 0x0000000605040100,
+	0x0000000006050402, 0x0000000605040200, 0x0000000605040201, 0x0000060504020100,
+	0x0000000006050403, 0x0000000605040300, 0x0000000605040301, 0x0000060504030100,
+	0x0000000605040302, 0x0000060504030200, 0x0000060504030201, 0x0006050403020100,
+	0x0000000000000007, 0x0000000000000700, 0x0000000000000701, 0x0000000000070100,
+	0x0000000000000702, 0x0000000000070200, 0x0000000000070201, 0x0000000007020100,
+	0x0000000000000703, 0x0000000000070300, 0x0000000000070301, 0x0000000007030100,
+	0x0000000000070302, 0x0000000007030200, 0x0000000007030201, 0x0000000703020100,
+	0x0000000000000704, 0x0000000000070400, 0x0000000000070401, 0x0000000007040100,
+	0x0000000000070402, 0x0000000007040200, 0x0000000007040201, 0x0000000704020100,
+	0x0000000000070403, 0x0000000007040300, 0x0000000007040301, 0x0000000704030100,
+	0x0000000007040302, 0x0000000704030200, 0x0000000704030201, 0x0000070403020100,
+	0x0000000000000705, 0x0000000000070500, 0x0000000000070501, 0x0000000007050100,
+	0x0000000000070502, 0x0000000007050200, 0x0000000007050201, 0x0000000705020100,
+	0x0000000000070503, 0x0000000007050300, 0x0000000007050301, 0x0000000705030100,
+	0x0000000007050302, 0x0000000705030200, 0x0000000705030201, 0x0000070503020100,
+	0x0000000000070504, 0x0000000007050400, 0x0000000007050401, 0x0000000705040100,
+	0x0000000007050402, 0x0000000705040200, 0x0000000705040201, 0x0000070504020100,
+	0x0000000007050403, 0x0000000705040300, 0x0000000705040301, 0x0000070504030100,
+	0x0000000705040302, 0x0000070504030200, 0x0000070504030201, 0x0007050403020100,
+	0x0000000000000706, 0x0000000000070600, 0x0000000000070601, 0x0000000007060100,
+	0x0000000000070602, 0x0000000007060200, 0x0000000007060201, 0x0000000706020100,
+	0x0000000000070603, 0x0000000007060300, 0x0000000007060301, 0x0000000706030100,
+	0x0000000007060302, 0x0000000706030200, 0x0000000706030201, 0x0000070603020100,
+	0x0000000000070604, 0x0000000007060400, 0x0000000007060401, 0x0000000706040100,
+	0x0000000007060402, 0x0000000706040200, 0x0000000706040201, 0x0000070604020100,
+	0x0000000007060403, 0x0000000706040300, 0x0000000706040301, 0x0000070604030100,
+	0x0000000706040302, 0x0000070604030200, 0x0000070604030201, 0x0007060403020100,
+	0x0000000000070605, 0x0000000007060500, 0x0000000007060501, 0x0000000706050100,
+	0x0000000007060502, 0x0000000706050200, 0x0000000706050201, 0x0000070605020100,
+	0x0000000007060503, 0x0000000706050300, 0x0000000706050301, 0x0000070605030100,
+	0x0000000706050302, 0x0000070605030200, 0x0000070605030201, 0x0007060503020100,
+	0x0000000007060504, 0x0000000706050400, 0x0000000706050401, 0x0000070605040100,
+	0x0000000706050402, 0x0000070605040200, 0x0000070605040201, 0x0007060504020100,
+	0x0000000706050403, 0x0000070605040300, 0x0000070605040301, 0x0007060504030100,
+	0x0000070605040302, 0x0007060504030200, 0x0007060504030201, 0x0706050403020100
+};
+#endif
+
+//~~~Public Functions~~~//
+
+void MLWEQ3329N256::GetParamSet(MLWEParamSet &Params, MLWEParams Parameters)
+{
+	if (Parameters == MLWEParams::Q3329N256K2)
+	{
+		Params.Load(MLWE_N, MLWE_Q, 2, 3, 2, 10, 4, 800, 1632, 768, 32, MLWEParams::Q3329N256K2);
+	}
+	else if (Parameters == MLWEParams::Q3329N256K3)
+	{
+		Params.Load(MLWE_N, MLWE_Q, 3, 2, 2, 10, 4, 1184, 2400, 1088, 32, MLWEParams::Q3329N256K3);
+	}
+	else if (Parameters == MLWEParams::Q3329N256K4)
+	{
+		Params.Load(MLWE_N, MLWE_Q, 4, 2, 2, 11, 5, 1568, 3168, 1568, 32, MLWEParams::Q3329N256K4);
+	}
+	else
+	{
+		throw CryptoAsymmetricException("MLWEQ3329N256:GetParamSet", "The parameter set is not recognized!");
+	}
+}
+
+void MLWEQ3329N256::Decrypt(std::vector<byte> &Secret, const std::vector<byte> &CipherText, const std::vector<byte> &PrivateKey, const MLWEParamSet &Params)
+{
+	const size_t PKOFT = Params.K * POLY_BYTES;
+	const size_t HOFT = PKOFT + Params.PublicKeySize;
+	const size_t ZOFT = HOFT + SEED_SIZE;
+
+	if (CipherText.size() != Params.CipherTextSize)
+	{
+		throw CryptoAsymmetricException("MLWEQ3329N256:Decrypt", "The cipher-text size is invalid!");
+	}
+	if (PrivateKey.size() != Params.PrivateKeySize)
+	{
+		throw CryptoAsymmetricException("MLWEQ3329N256:Decrypt", "The private key size is invalid!");
+	}
+
+	std::vector<byte> buf(2 * SEED_SIZE);
+	std::vector<byte> cmp(Params.CipherTextSize);
+	std::vector<byte> coins(SEED_SIZE);
+	std::vector<byte> kbar(SEED_SIZE);
+	std::vector<byte> kr(2 * SEED_SIZE);
+	std::vector<byte> msg(SEED_SIZE);
+	std::vector<byte> pk(Params.PublicKeySize);
+	std::vector<byte> zc(SEED_SIZE + Params.CipherTextSize);
+
+	// the stored public key hash must match the embedded public key
+	MemUtils::Copy(PrivateKey, PKOFT, pk, 0, pk.size());
+	Sponge(buf, 0, SEED_SIZE, pk, SHA3_256_RATE, 0x06);
+
+	if (!IntUtils::Compare(buf, 0, PrivateKey, HOFT, SEED_SIZE))
+	{
+		throw CryptoAsymmetricException("MLWEQ3329N256:Decrypt", "The private key is invalid!");
+	}
+
+	CpaDecrypt(msg, CipherText, PrivateKey, Params);
+
+	// (K', r') = G(m' || h)
+	MemUtils::Copy(msg, 0, buf, 0, SEED_SIZE);
+	MemUtils::Copy(PrivateKey, HOFT, buf, SEED_SIZE, SEED_SIZE);
+	Sponge(kr, 0, kr.size(), buf, SHA3_512_RATE, 0x06);
+	MemUtils::Copy(kr, SEED_SIZE, coins, 0, SEED_SIZE);
+	CpaEncrypt(cmp, msg, PrivateKey, PKOFT, coins, Params);
+
+	// the implicit rejection key J(z || c)
+	MemUtils::Copy(PrivateKey, ZOFT, zc, 0, SEED_SIZE);
+	MemUtils::Copy(CipherText, 0, zc, SEED_SIZE, CipherText.size());
+	Sponge(kbar, 0, SEED_SIZE, zc, SHAKE256_RATE, 0x1F);
+
+	// select K' when the re-encryption matches, J(z || c) otherwise, in constant time
+	uint diff = 0;
+
+	for (size_t i = 0; i < CipherText.size(); ++i)
+	{
+		diff |= static_cast<uint>(CipherText[i] ^ cmp[i]);
+	}
+
+	const byte MASK = static_cast<byte>(0 - ((0 - diff) >> 31));
+	Secret.resize(Params.SecretSize);
+
+	for (size_t i = 0; i < Params.SecretSize; ++i)
+	{
+		Secret[i] = kr[i] ^ (MASK & (kr[i] ^ kbar[i]));
+	}
+
+	IntUtils::ClearVector(buf);
+	IntUtils::ClearVector(coins);
+	IntUtils::ClearVector(kbar);
+	IntUtils::ClearVector(kr);
+	IntUtils::ClearVector(msg);
+	IntUtils::ClearVector(zc);
+}
+
+void MLWEQ3329N256::Encrypt(std::vector<byte> &Secret, std::vector<byte> &CipherText, const std::vector<byte> &PublicKey, std::unique_ptr<IPrng> &Random, const MLWEParamSet &Params)
+{
+	std::vector<byte> msg(SEED_SIZE);
+
+	Random->GetBytes(msg);
+	Encrypt(Secret, CipherText, PublicKey, msg, Params);
+	IntUtils::ClearVector(msg);
+}
+
+void MLWEQ3329N256::Encrypt(std::vector<byte> &Secret, std::vector<byte> &CipherText, const std::vector<byte> &PublicKey, const std::vector<byte> &Message, const MLWEParamSet &Params)
+{
+	CexAssert(Message.size() == SEED_SIZE, "The message size is invalid");
+
+	if (PublicKey.size() != Params.PublicKeySize)
+	{
+		throw CryptoAsymmetricException("MLWEQ3329N256:Encrypt", "The public key size is invalid!");
+	}
+
+	Poly t;
+
+	// every packed coefficient of the public key must already be reduced
+	for (size_t i = 0; i < Params.K; ++i)
+	{
+		if (!FromBytes(t, PublicKey, i * POLY_BYTES))
+		{
+			throw CryptoAsymmetricException("MLWEQ3329N256:Encrypt", "The public key is invalid!");
+		}
+	}
+
+	std::vector<byte> buf(2 * SEED_SIZE);
+	std::vector<byte> coins(SEED_SIZE);
+	std::vector<byte> kr(2 * SEED_SIZE);
+
+	// (K, r) = G(m || H(ek))
+	MemUtils::Copy(Message, 0, buf, 0, SEED_SIZE);
+	Sponge(buf, SEED_SIZE, SEED_SIZE, PublicKey, SHA3_256_RATE, 0x06);
+	Sponge(kr, 0, kr.size(), buf, SHA3_512_RATE, 0x06);
+	MemUtils::Copy(kr, SEED_SIZE, coins, 0, SEED_SIZE);
+
+	CipherText.resize(Params.CipherTextSize);
+	CpaEncrypt(CipherText, Message, PublicKey, 0, coins, Params);
+	Secret.resize(Params.SecretSize);
+	MemUtils::Copy(kr, 0, Secret, 0, Params.SecretSize);
+
+	IntUtils::ClearVector(buf);
+	IntUtils::ClearVector(coins);
+	IntUtils::ClearVector(kr);
+}
+
+void MLWEQ3329N256::Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, std::unique_ptr<IPrng> &Random, const MLWEParamSet &Params)
+{
+	std::vector<byte> dz(2 * SEED_SIZE);
+
+	Random->GetBytes(dz);
+	Generate(PublicKey, PrivateKey, dz, Params);
+	IntUtils::ClearVector(dz);
+}
+
+void MLWEQ3329N256::Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, const std::vector<byte> &Seed, const MLWEParamSet &Params)
+{
+	CexAssert(Seed.size() == 2 * SEED_SIZE, "The seed size is invalid");
+
+	const size_t K = Params.K;
+	const size_t PKOFT = K * POLY_BYTES;
+	std::vector<byte> coins(2 * SEED_SIZE);
+	std::vector<byte> rho(SEED_SIZE);
+	std::vector<byte> sigma(SEED_SIZE);
+	std::vector<byte> seed(SEED_SIZE + 1);
+	std::vector<Poly> a;
+	std::vector<Poly> se(2 * K);
+	Poly t;
+
+	// d is the key generation seed, z the implicit rejection seed; (rho, sigma) = G(d || k)
+	MemUtils::Copy(Seed, 0, seed, 0, SEED_SIZE);
+	seed[SEED_SIZE] = static_cast<byte>(K);
+	Sponge(coins, 0, coins.size(), seed, SHA3_512_RATE, 0x06);
+	MemUtils::Copy(coins, 0, rho, 0, SEED_SIZE);
+	MemUtils::Copy(coins, SEED_SIZE, sigma, 0, SEED_SIZE);
+
+	ExpandA(a, rho, false, Params);
+	// the secret s uses the nonces 0 to k-1, the error e uses k to 2k-1
+	ExpandNoise(se, sigma, 0, Params.Eta1);
+
+	for (size_t i = 0; i < se.size(); ++i)
+	{
+		Ntt(se[i]);
+	}
+
+	std::vector<Poly> s(se.begin(), se.begin() + K);
+	PublicKey.resize(Params.PublicKeySize);
+	PrivateKey.resize(Params.PrivateKeySize);
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		// t = A * s + e
+		MultiplyAcc(t, a, i * K, s);
+		ToMont(t);
+
+		for (size_t n = 0; n < MLWE_N; ++n)
+		{
+			t[n] += se[K + i][n];
+		}
+
+		ReducePoly(t);
+		ToBytes(PublicKey, i * POLY_BYTES, t);
+		ToBytes(PrivateKey, i * POLY_BYTES, s[i]);
+	}
+
+	// dk = s || ek || H(ek) || z
+	MemUtils::Copy(rho, 0, PublicKey, PKOFT, SEED_SIZE);
+	MemUtils::Copy(PublicKey, 0, PrivateKey, PKOFT, PublicKey.size());
+	Sponge(PrivateKey, PKOFT + PublicKey.size(), SEED_SIZE, PublicKey, SHA3_256_RATE, 0x06);
+	MemUtils::Copy(Seed, SEED_SIZE, PrivateKey, PKOFT + PublicKey.size() + SEED_SIZE, SEED_SIZE);
+
+	IntUtils::ClearVector(coins);
+	IntUtils::ClearVector(seed);
+	IntUtils::ClearVector(sigma);
+
+	for (size_t i = 0; i < se.size(); ++i)
+	{
+		se[i].fill(0);
+	}
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		s[i].fill(0);
+	}
+}
+
+//~~~CPA Encryption~~~//
+
+void MLWEQ3329N256::CpaDecrypt(std::vector<byte> &Message, const std::vector<byte> &CipherText, const std::vector<byte> &PrivateKey, const MLWEParamSet &Params)
+{
+	const size_t K = Params.K;
+	const size_t UPLEN = (MLWE_N * Params.DU) / 8;
+	std::vector<Poly> s(K);
+	std::vector<Poly> u(K);
+	Poly v;
+	Poly w;
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		Decompress(u[i], CipherText, i * UPLEN, Params.DU);
+		Ntt(u[i]);
+		FromBytes(s[i], PrivateKey, i * POLY_BYTES);
+	}
+
+	Decompress(v, CipherText, K * UPLEN, Params.DV);
+
+	// m = Compress1(v - NTT^-1(s * NTT(u)))
+	MultiplyAcc(w, s, 0, u);
+	NttInv(w);
+
+	for (size_t n = 0; n < MLWE_N; ++n)
+	{
+		w[n] = v[n] - w[n];
+	}
+
+	ReducePoly(w);
+	Compress(Message, 0, w, 1);
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		s[i].fill(0);
+	}
+
+	w.fill(0);
+}
+
+void MLWEQ3329N256::CpaEncrypt(std::vector<byte> &CipherText, const std::vector<byte> &Message, const std::vector<byte> &PublicKey, size_t PubOffset, const std::vector<byte> &Coins, const MLWEParamSet &Params)
+{
+	const size_t K = Params.K;
+	const size_t UPLEN = (MLWE_N * Params.DU) / 8;
+	std::vector<byte> rho(SEED_SIZE);
+	std::vector<Poly> at;
+	std::vector<Poly> e(K + 1);
+	std::vector<Poly> t(K);
+	std::vector<Poly> y(K);
+	Poly m;
+	Poly u;
+	Poly v;
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		FromBytes(t[i], PublicKey, PubOffset + (i * POLY_BYTES));
+	}
+
+	MemUtils::Copy(PublicKey, PubOffset + (K * POLY_BYTES), rho, 0, SEED_SIZE);
+	ExpandA(at, rho, true, Params);
+	// the mask y uses the nonces 0 to k-1, the errors e1 and e2 use k to 2k
+	ExpandNoise(y, Coins, 0, Params.Eta1);
+	ExpandNoise(e, Coins, static_cast<byte>(K), Params.Eta2);
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		Ntt(y[i]);
+	}
+
+	// u = NTT^-1(A^T * y) + e1
+	for (size_t i = 0; i < K; ++i)
+	{
+		MultiplyAcc(u, at, i * K, y);
+		NttInv(u);
+
+		for (size_t n = 0; n < MLWE_N; ++n)
+		{
+			u[n] += e[i][n];
+		}
+
+		ReducePoly(u);
+		Compress(CipherText, i * UPLEN, u, Params.DU);
+	}
+
+	// v = NTT^-1(t * y) + e2 + Decompress1(m)
+	MultiplyAcc(v, t, 0, y);
+	NttInv(v);
+	Decompress(m, Message, 0, 1);
+
+	for (size_t n = 0; n < MLWE_N; ++n)
+	{
+		v[n] += e[K][n] + m[n];
+	}
+
+	ReducePoly(v);
+	Compress(CipherText, K * UPLEN, v, Params.DV);
+
+	for (size_t i = 0; i < K; ++i)
+	{
+		e[i].fill(0);
+		y[i].fill(0);
+	}
+
+	e[K].fill(0);
+	m.fill(0);
+}
+
+//~~~Sampling~~~//
+
+void MLWEQ3329N256::Cbd(Poly &R, const std::vector<byte> &Input, size_t InOffset, uint Eta)
+{
+#if defined(__AVX2__)
+
+	if (Eta == 2)
+	{
+		// each 32 byte block yields 64 coefficients; the two bit sums are differenced per nibble, then widened to 16 bits
+		const __m256i M55 = _mm256_set1_epi32(0x55555555);
+		const __m256i M0F = _mm256_set1_epi32(0x0F0F0F0F);
+		const __m256i M03 = _mm256_set1_epi32(0x03030303);
+
+		for (size_t i = 0; i < MLWE_N / 64; ++i)
+		{
+			__m256i f0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Input[InOffset + (i * 32)]));
+			__m256i f1 = _mm256_and_si256(_mm256_srli_epi16(f0, 1), M55);
+			f0 = _mm256_add_epi32(_mm256_and_si256(f0, M55), f1);
+
+			f1 = _mm256_and_si256(_mm256_srli_epi16(f0, 4), M0F);
+			f0 = _mm256_and_si256(f0, M0F);
+			f0 = _mm256_sub_epi8(_mm256_and_si256(f0, M03), _mm256_and_si256(_mm256_srli_epi16(f0, 2), M03));
+			f1 = _mm256_sub_epi8(_mm256_and_si256(f1, M03), _mm256_and_si256(_mm256_srli_epi16(f1, 2), M03));
+
+			const __m256i U0 = _mm256_unpacklo_epi8(f0, f1);
+			const __m256i U1 = _mm256_unpackhi_epi8(f0, f1);
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(&R[i * 64]), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(U0)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(&R[(i * 64) + 16]), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(U1)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(&R[(i * 64) + 32]), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(U0, 1)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(&R[(i * 64) + 48]), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(U1, 1)));
+		}
+	}
+	else
+	{
+		CbdScalar(R, Input, InOffset, Eta);
+	}
+
+#else
+
+	CbdScalar(R, Input, InOffset, Eta);
+
+#endif
+}
+
+void MLWEQ3329N256::CbdScalar(Poly &R, const std::vector<byte> &Input, size_t InOffset, uint Eta)
+{
+	if (Eta == 2)
+	{
+		for (size_t i = 0; i < MLWE_N / 8; ++i)
+		{
+			const uint T = IntUtils::LeBytesTo32(Input, InOffset + (i * 4));
+			uint d = T & 0x55555555UL;
+			d += (T >> 1) & 0x55555555UL;
+
+			for (size_t j = 0; j < 8; ++j)
+			{
+				const int A = static_cast<int>((d >> (4 * j)) & 0x03);
+				const int B = static_cast<int>((d >> ((4 * j) + 2)) & 0x03);
+				R[(8 * i) + j] = static_cast<short>(A - B);
+			}
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < MLWE_N / 4; ++i)
+		{
+			const uint T = static_cast<uint>(Input[InOffset + (3 * i)]) |
+				(static_cast<uint>(Input[InOffset + (3 * i) + 1]) << 8) |
+				(static_cast<uint>(Input[InOffset + (3 * i) + 2]) << 16);
+			uint d = T & 0x00249249UL;
+			d += (T >> 1) & 0x00249249UL;
+			d += (T >> 2) & 0x00249249UL;
+
+			for (size_t j = 0; j < 4; ++j)
+			{
+				const int A = static_cast<int>((d >> (6 * j)) & 0x07);
+				const int B = static_cast<int>((d >> ((6 * j) + 3)) & 0x07);
+				R[(4 * i) + j] = static_cast<short>(A - B);
+			}
+		}
+	}
+}
+
+void MLWEQ3329N256::ExpandA(std::vector<Poly> &A, const std::vector<byte> &Rho, bool Transposed, const MLWEParamSet &Params)
+{
+	const size_t LANES = Keccak::PARALLEL_LANES;
+	const size_t K = Params.K;
+	const size_t CNT = K * K;
+	const size_t SEEDLEN = SEED_SIZE + 2;
+	const size_t BUFLEN = UNIFORM_BLOCKS * SHAKE128_RATE;
+	std::vector<byte> seeds(LANES * SEEDLEN);
+	std::vector<byte> buf(LANES * BUFLEN);
+	std::vector<ulong> state(25 * LANES);
+	std::array<size_t, 4> ctr;
+
+	A.resize(CNT);
+
+	// each polynomial is an independent SHAKE128 stream; four are absorbed and squeezed together
+	for (size_t i = 0; i < CNT; i += LANES)
+	{
+		const size_t LNECNT = IntUtils::Min(LANES, CNT - i);
+
+		for (size_t j = 0; j < LANES; ++j)
+		{
+			// unused lanes repeat the last polynomial
+			const size_t IDX = i + IntUtils::Min(j, LNECNT - 1);
+			const byte ROW = static_cast<byte>(IDX / K);
+			const byte COL = static_cast<byte>(IDX % K);
+
+			MemUtils::Copy(Rho, 0, seeds, j * SEEDLEN, SEED_SIZE);
+			seeds[(j * SEEDLEN) + SEED_SIZE] = Transposed ? ROW : COL;
+			seeds[(j * SEEDLEN) + SEED_SIZE + 1] = Transposed ? COL : ROW;
+		}
+
+		std::fill(state.begin(), state.end(), 0);
+		SpongeAbsorbX4(state, seeds, SEEDLEN, SHAKE128_RATE);
+		SpongeSqueezeX4(state, buf, UNIFORM_BLOCKS, SHAKE128_RATE);
+		bool done = true;
+
+		for (size_t j = 0; j < LNECNT; ++j)
+		{
+			ctr[j] = 0;
+			RejUniform(A[i + j], ctr[j], buf, j * BUFLEN, BUFLEN);
+			done &= (ctr[j] == MLWE_N);
+		}
+
+		while (!done)
+		{
+			SpongeSqueezeX4(state, buf, 1, SHAKE128_RATE);
+			done = true;
+
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				RejUniform(A[i + j], ctr[j], buf, j * SHAKE128_RATE, SHAKE128_RATE);
+				done &= (ctr[j] == MLWE_N);
+			}
+		}
+	}
+}
+
+void MLWEQ3329N256::ExpandNoise(std::vector<Poly> &R, const std::vector<byte> &Seed, byte Nonce, uint Eta)
+{
+	const size_t LANES = Keccak::PARALLEL_LANES;
+	const size_t CNT = R.size();
+	const size_t SEEDLEN = SEED_SIZE + 1;
+	const size_t BLKCNT = ((64 * Eta) + SHAKE256_RATE - 1) / SHAKE256_RATE;
+	const size_t BUFLEN = BLKCNT * SHAKE256_RATE;
+	std::vector<byte> seeds(LANES * SEEDLEN);
+	std::vector<byte> buf(LANES * BUFLEN);
+	std::vector<ulong> state(25 * LANES);
+
+	// the pseudo-random function SHAKE256(seed || nonce), four nonces at a time
+	for (size_t i = 0; i < CNT; i += LANES)
+	{
+		const size_t LNECNT = IntUtils::Min(LANES, CNT - i);
+
+		for (size_t j = 0; j < LANES; ++j)
+		{
+			MemUtils::Copy(Seed, 0, seeds, j * SEEDLEN, SEED_SIZE);
+			seeds[(j * SEEDLEN) + SEED_SIZE] = static_cast<byte>(Nonce + i + IntUtils::Min(j, LNECNT - 1));
+		}
+
+		std::fill(state.begin(), state.end(), 0);
+		SpongeAbsorbX4(state, seeds, SEEDLEN, SHAKE256_RATE);
+		SpongeSqueezeX4(state, buf, BLKCNT, SHAKE256_RATE);
+
+		for (size_t j = 0; j < LNECNT; ++j)
+		{
+			Cbd(R[i + j], buf, j * BUFLEN, Eta);
+		}
+	}
+
+	IntUtils::ClearVector(seeds);
+	IntUtils::ClearVector(buf);
+	IntUtils::ClearVector(state);
+}
+
+void MLWEQ3329N256::RejUniform(Poly &A, size_t &Count, const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	size_t pos = 0;
+
+#if defined(__AVX2__)
+
+	// sixteen 12 bit candidates from every 24 input bytes; each 128 bit half is compacted with a byte shuffle
+	const __m256i BOUND = _mm256_set1_epi16(MLWE_Q);
+	const __m256i MASK = _mm256_set1_epi16(0x0FFF);
+	const __m128i PAIR = _mm_set1_epi16(0x0100);
+	const __m256i SHUF = _mm256_setr_epi8(0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11, 4, 5, 5, 6, 7, 8, 8, 9, 10, 11, 11, 12, 13, 14, 14, 15);
+
+	while (Count <= MLWE_N - 16 && pos + 32 <= Length)
+	{
+		__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&Input[InOffset + pos]));
+		d = _mm256_permute4x64_epi64(d, 0x94);
+		d = _mm256_shuffle_epi8(d, SHUF);
+		d = _mm256_blend_epi16(_mm256_and_si256(d, MASK), _mm256_srli_epi16(d, 4), 0xAA);
+		pos += 24;
+
+		const __m256i GOOD = _mm256_packs_epi16(_mm256_cmpgt_epi16(BOUND, d), _mm256_setzero_si256());
+		const uint MSK = static_cast<uint>(_mm256_movemask_epi8(GOOD));
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			uint m = (MSK >> (16 * i)) & 0xFF;
+			__m128i idx = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&RejIndex[m]));
+			idx = _mm_unpacklo_epi8(idx, idx);
+			idx = _mm_add_epi8(_mm_add_epi8(idx, idx), PAIR);
+			const __m128i V = (i == 0) ? _mm256_castsi256_si128(d) : _mm256_extracti128_si256(d, 1);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&A[Count]), _mm_shuffle_epi8(V, idx));
+
+			m = m - ((m >> 1) & 0x55);
+			m = (m & 0x33) + ((m >> 2) & 0x33);
+			Count += (m + (m >> 4)) & 0x0F;
+		}
+	}
+
+#endif
+
+	RejUniformScalar(A, Count, Input, InOffset + pos, Length - pos);
+}
+
+void MLWEQ3329N256::RejUniformScalar(Poly &A, size_t &Count, const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	size_t pos = 0;
+
+	while (Count < MLWE_N && pos + 3 <= Length)
+	{
+		const uint B0 = Input[InOffset + pos];
+		const uint B1 = Input[InOffset + pos + 1];
+		const uint B2 = Input[InOffset + pos + 2];
+		const uint V0 = (B0 | (B1 << 8)) & 0x0FFF;
+		const uint V1 = ((B1 >> 4) | (B2 << 4)) & 0x0FFF;
+		pos += 3;
+
+		if (V0 < static_cast<uint>(MLWE_Q))
+		{
+			A[Count] = static_cast<short>(V0);
+			++Count;
+		}
+
+		if (Count < MLWE_N && V1 < static_cast<uint>(MLWE_Q))
+		{
+			A[Count] = static_cast<short>(V1);
+			++Count;
+		}
+	}
+}
+
+//~~~Keccak~~~//
+
+void MLWEQ3329N256::Sponge(std::vector<byte> &Output, size_t OutOffset, size_t Length, const std::vector<byte> &Input, size_t Rate, byte Domain)
+{
+	std::vector<ulong> state(25, 0);
+	std::vector<byte> blk(Rate, 0);
+	size_t pos = 0;
+
+	while (Input.size() - pos >= Rate)
+	{
+		for (size_t i = 0; i < Rate / sizeof(ulong); ++i)
+		{
+			state[i] ^= IntUtils::LeBytesTo64(Input, pos + (i * sizeof(ulong)));
+		}
+
+		Keccak::PermuteR(state, 24);
+		pos += Rate;
+	}
+
+	if (Input.size() - pos != 0)
+	{
+		MemUtils::Copy(Input, pos, blk, 0, Input.size() - pos);
+	}
+
+	blk[Input.size() - pos] ^= Domain;
+	blk[Rate - 1] ^= 0x80;
+
+	for (size_t i = 0; i < Rate / sizeof(ulong); ++i)
+	{
+		state[i] ^= IntUtils::LeBytesTo64(blk, i * sizeof(ulong));
+	}
+
+	while (Length != 0)
+	{
+		const size_t RMDLEN = IntUtils::Min(Length, Rate);
+		Keccak::PermuteR(state, 24);
+
+		for (size_t i = 0; i < Rate / sizeof(ulong); ++i)
+		{
+			IntUtils::Le64ToBytes(state[i], blk, i * sizeof(ulong));
+		}
+
+		MemUtils::Copy(blk, 0, Output, OutOffset, RMDLEN);
+		OutOffset += RMDLEN;
+		Length -= RMDLEN;
+	}
+
+	IntUtils::ClearVector(state);
+	IntUtils::ClearVector(blk);
+}
+
+void MLWEQ3329N256::SpongeAbsorbX4(std::vector<ulong> &State, const std::vector<byte> &Seeds, size_t SeedLength, size_t Rate)
+{
+	CexAssert(SeedLength < Rate, "The seed must fit in a single block");
+
+	const size_t LANES = Keccak::PARALLEL_LANES;
+	std::vector<byte> blk(Rate);
+
+	for (size_t i = 0; i < LANES; ++i)
+	{
+		MemUtils::Clear(blk, 0, Rate);
+		MemUtils::Copy(Seeds, i * SeedLength, blk, 0, SeedLength);
+		blk[SeedLength] ^= 0x1F;
+		blk[Rate - 1] ^= 0x80;
+
+		for (size_t j = 0; j < Rate / sizeof(ulong); ++j)
+		{
+			State[(j * LANES) + i] ^= IntUtils::LeBytesTo64(blk, j * sizeof(ulong));
+		}
+	}
+
+	IntUtils::ClearVector(blk);
+}
+
+void MLWEQ3329N256::SpongeSqueezeX4(std::vector<ulong> &State, std::vector<byte> &Output, size_t Blocks, size_t Rate)
+{
+	const size_t LANES = Keccak::PARALLEL_LANES;
+
+	// lane i is written to Output[i * Blocks * Rate]
+	for (size_t i = 0; i < Blocks; ++i)
+	{
+		Keccak::PermuteP4x(State);
+
+		for (size_t j = 0; j < LANES; ++j)
+		{
+			for (size_t k = 0; k < Rate / sizeof(ulong); ++k)
+			{
+				IntUtils::Le64ToBytes(State[(k * LANES) + j], Output, (j * Blocks * Rate) + (i * Rate) + (k * sizeof(ulong)));
+			}
+		}
+	}
+}
+
+//~~~Arithmetic~~~//
+
+short MLWEQ3329N256::BarrettReduce(short A)
+{
+	const int T = ((MLWE_BARRETT * static_cast<int>(A)) + (1 << 25)) >> 26;
+
+	return static_cast<short>(A - (T * MLWE_Q));
+}
+
+short MLWEQ3329N256::MontReduce(int A)
+{
+	const short T = static_cast<short>(static_cast<short>(A) * MLWE_QINV);
+
+	return static_cast<short>((A - (static_cast<int>(T) * MLWE_Q)) >> 16);
+}
+
+void MLWEQ3329N256::MultiplyAcc(Poly &R, const std::vector<Poly> &A, size_t AOffset, const std::vector<Poly> &B)
+{
+#if defined(__AVX2__)
+
+	for (size_t i = 0; i < MLWE_N; i += 16)
+	{
+		// the four degree-one products in this vector use +-zeta for each coefficient pair
+		const size_t ZI = 64 + (i / 4);
+		const __m256i Z = _mm256_setr_epi16(Zetas[ZI], Zetas[ZI], -Zetas[ZI], -Zetas[ZI], Zetas[ZI + 1], Zetas[ZI + 1], -Zetas[ZI + 1], -Zetas[ZI + 1],
+			Zetas[ZI + 2], Zetas[ZI + 2], -Zetas[ZI + 2], -Zetas[ZI + 2], Zetas[ZI + 3], Zetas[ZI + 3], -Zetas[ZI + 3], -Zetas[ZI + 3]);
+		__m256i r = _mm256_setzero_si256();
+
+		for (size_t j = 0; j < B.size(); ++j)
+		{
+			const __m256i X = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[AOffset + j][i]));
+			const __m256i Y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&B[j][i]));
+			r = _mm256_add_epi16(r, BaseMulX(X, Y, Z));
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&R[i]), BarrettX(r));
+	}
+
+#else
+
+	R.fill(0);
+
+	for (size_t j = 0; j < B.size(); ++j)
+	{
+		const Poly &X = A[AOffset + j];
+		const Poly &Y = B[j];
+
+		for (size_t i = 0; i < MLWE_N; i += 2)
+		{
+			// multiplication in Zq[X]/(X^2 - zeta), the sign alternates between the pairs of each group of four
+			const int Z = ((i & 2) == 0) ? Zetas[64 + (i / 4)] : -Zetas[64 + (i / 4)];
+			const int R0 = MontReduce(MontReduce(static_cast<int>(X[i + 1]) * Y[i + 1]) * Z) + MontReduce(static_cast<int>(X[i]) * Y[i]);
+			const int R1 = MontReduce(static_cast<int>(X[i]) * Y[i + 1]) + MontReduce(static_cast<int>(X[i + 1]) * Y[i]);
+
+			R[i] = static_cast<short>(R[i] + R0);
+			R[i + 1] = static_cast<short>(R[i + 1] + R1);
+		}
+	}
+
+	ReducePoly(R);
+
+#endif
+}
+
+void MLWEQ3329N256::Ntt(Poly &A)
+{
+#if defined(__AVX2__)
+
+	size_t k = 0;
+
+	// the upper four layers butterfly whole vectors against a broadcast zeta
+	for (size_t len = 128; len >= 16; len >>= 1)
+	{
+		for (size_t start = 0; start < MLWE_N; start += 2 * len)
+		{
+			++k;
+			const __m256i Z = _mm256_set1_epi16(Zetas[k]);
+
+			for (size_t j = start; j < start + len; j += 16)
+			{
+				__m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j]));
+				__m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j + len]));
+				const __m256i T = MontMulX(hi, Z);
+				hi = _mm256_sub_epi16(lo, T);
+				lo = _mm256_add_epi16(lo, T);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j]), lo);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j + len]), hi);
+			}
+		}
+	}
+
+	// the last three layers gather the butterfly pairs of two vectors with 128 and 64 bit shuffles, then reduce
+	for (size_t j = 0; j < MLWE_N; j += 32)
+	{
+		__m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j]));
+		__m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j + 16]));
+		__m256i lo;
+		__m256i hi;
+		__m256i z;
+		__m256i t;
+
+		// len 8
+		const size_t K8 = 16 + (j / 16);
+		lo = _mm256_permute2x128_si256(v0, v1, 0x20);
+		hi = _mm256_permute2x128_si256(v0, v1, 0x31);
+		z = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_set1_epi16(Zetas[K8])), _mm_set1_epi16(Zetas[K8 + 1]), 1);
+		t = MontMulX(hi, z);
+		hi = _mm256_sub_epi16(lo, t);
+		lo = _mm256_add_epi16(lo, t);
+		v0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+		v1 = _mm256_permute2x128_si256(lo, hi, 0x31);
+
+		// len 4
+		const size_t K4 = 32 + (j / 8);
+		lo = _mm256_unpacklo_epi64(v0, v1);
+		hi = _mm256_unpackhi_epi64(v0, v1);
+		z = _mm256_setr_epi16(Zetas[K4], Zetas[K4], Zetas[K4], Zetas[K4], Zetas[K4 + 2], Zetas[K4 + 2], Zetas[K4 + 2], Zetas[K4 + 2],
+			Zetas[K4 + 1], Zetas[K4 + 1], Zetas[K4 + 1], Zetas[K4 + 1], Zetas[K4 + 3], Zetas[K4 + 3], Zetas[K4 + 3], Zetas[K4 + 3]);
+		t = MontMulX(hi, z);
+		hi = _mm256_sub_epi16(lo, t);
+		lo = _mm256_add_epi16(lo, t);
+		v0 = _mm256_unpacklo_epi64(lo, hi);
+		v1 = _mm256_unpackhi_epi64(lo, hi);
+
+		// len 2
+		const size_t K2 = 64 + (j / 4);
+		v0 = _mm256_shuffle_epi32(v0, 0xD8);
+		v1 = _mm256_shuffle_epi32(v1, 0xD8);
+		lo = _mm256_unpacklo_epi64(v0, v1);
+		hi = _mm256_unpackhi_epi64(v0, v1);
+		z = _mm256_setr_epi16(Zetas[K2], Zetas[K2], Zetas[K2 + 1], Zetas[K2 + 1], Zetas[K2 + 4], Zetas[K2 + 4], Zetas[K2 + 5], Zetas[K2 + 5],
+			Zetas[K2 + 2], Zetas[K2 + 2], Zetas[K2 + 3], Zetas[K2 + 3], Zetas[K2 + 6], Zetas[K2 + 6], Zetas[K2 + 7], Zetas[K2 + 7]);
+		t = MontMulX(hi, z);
+		hi = _mm256_sub_epi16(lo, t);
+		lo = _mm256_add_epi16(lo, t);
+		v0 = _mm256_shuffle_epi32(_mm256_unpacklo_epi64(lo, hi), 0xD8);
+		v1 = _mm256_shuffle_epi32(_mm256_unpackhi_epi64(lo, hi), 0xD8);
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j]), BarrettX(v0));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j + 16]), BarrettX(v1));
+	}
+
+#else
+
+	NttScalar(A);
+
+#endif
+}
+
+void MLWEQ3329N256::NttInv(Poly &A)
+{
+#if defined(__AVX2__)
+
+	const __m256i F = _mm256_set1_epi16(MLWE_F);
+	size_t k = 16;
+
+	// the first three layers work on two vectors at a time, mirroring the forward shuffles
+	for (size_t j = 0; j < MLWE_N; j += 32)
+	{
+		__m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j]));
+		__m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j + 16]));
+		__m256i lo;
+		__m256i hi;
+		__m256i z;
+		__m256i t;
+
+		// len 2
+		const size_t K2 = 127 - (j / 4);
+		v0 = _mm256_shuffle_epi32(v0, 0xD8);
+		v1 = _mm256_shuffle_epi32(v1, 0xD8);
+		lo = _mm256_unpacklo_epi64(v0, v1);
+		hi = _mm256_unpackhi_epi64(v0, v1);
+		z = _mm256_setr_epi16(Zetas[K2], Zetas[K2], Zetas[K2 - 1], Zetas[K2 - 1], Zetas[K2 - 4], Zetas[K2 - 4], Zetas[K2 - 5], Zetas[K2 - 5],
+			Zetas[K2 - 2], Zetas[K2 - 2], Zetas[K2 - 3], Zetas[K2 - 3], Zetas[K2 - 6], Zetas[K2 - 6], Zetas[K2 - 7], Zetas[K2 - 7]);
+		t = lo;
+		lo = BarrettX(_mm256_add_epi16(t, hi));
+		hi = MontMulX(_mm256_sub_epi16(hi, t), z);
+		v0 = _mm256_shuffle_epi32(_mm256_unpacklo_epi64(lo, hi), 0xD8);
+		v1 = _mm256_shuffle_epi32(_mm256_unpackhi_epi64(lo, hi), 0xD8);
+
+		// len 4
+		const size_t K4 = 63 - (j / 8);
+		lo = _mm256_unpacklo_epi64(v0, v1);
+		hi = _mm256_unpackhi_epi64(v0, v1);
+		z = _mm256_setr_epi16(Zetas[K4], Zetas[K4], Zetas[K4], Zetas[K4], Zetas[K4 - 2], Zetas[K4 - 2], Zetas[K4 - 2], Zetas[K4 - 2],
+			Zetas[K4 - 1], Zetas[K4 - 1], Zetas[K4 - 1], Zetas[K4 - 1], Zetas[K4 - 3], Zetas[K4 - 3], Zetas[K4 - 3], Zetas[K4 - 3]);
+		t = lo;
+		lo = BarrettX(_mm256_add_epi16(t, hi));
+		hi = MontMulX(_mm256_sub_epi16(hi, t), z);
+		v0 = _mm256_unpacklo_epi64(lo, hi);
+		v1 = _mm256_unpackhi_epi64(lo, hi);
+
+		// len 8
+		const size_t K8 = 31 - (j / 16);
+		lo = _mm256_permute2x128_si256(v0, v1, 0x20);
+		hi = _mm256_permute2x128_si256(v0, v1, 0x31);
+		z = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_set1_epi16(Zetas[K8])), _mm_set1_epi16(Zetas[K8 - 1]), 1);
+		t = lo;
+		lo = BarrettX(_mm256_add_epi16(t, hi));
+		hi = MontMulX(_mm256_sub_epi16(hi, t), z);
+		v0 = _mm256_permute2x128_si256(lo, hi, 0x20);
+		v1 = _mm256_permute2x128_si256(lo, hi, 0x31);
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j]), v0);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j + 16]), v1);
+	}
+
+	for (size_t len = 16; len <= 128; len <<= 1)
+	{
+		for (size_t start = 0; start < MLWE_N; start += 2 * len)
+		{
+			--k;
+			const __m256i Z = _mm256_set1_epi16(Zetas[k]);
+
+			for (size_t j = start; j < start + len; j += 16)
+			{
+				const __m256i T = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j]));
+				const __m256i U = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j + len]));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j]), BarrettX(_mm256_add_epi16(T, U)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j + len]), MontMulX(_mm256_sub_epi16(U, T), Z));
+			}
+		}
+	}
+
+	// scale by mont^2/128, leaving the result in the normal domain
+	for (size_t j = 0; j < MLWE_N; j += 16)
+	{
+		const __m256i T = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[j]));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[j]), MontMulX(T, F));
+	}
+
+#else
+
+	NttInvScalar(A);
+
+#endif
+}
+
+void MLWEQ3329N256::NttInvScalar(Poly &A)
+{
+	size_t k = 128;
+
+	for (size_t len = 2; len <= 128; len <<= 1)
+	{
+		for (size_t start = 0; start < MLWE_N; start += 2 * len)
+		{
+			--k;
+			const int Z = Zetas[k];
+
+			for (size_t j = start; j < start + len; ++j)
+			{
+				const short T = A[j];
+				A[j] = BarrettReduce(static_cast<short>(T + A[j + len]));
+				A[j + len] = MontReduce(Z * static_cast<short>(A[j + len] - T));
+			}
+		}
+	}
+
+	// scale by mont^2/128, leaving the result in the normal domain
+	for (size_t j = 0; j < MLWE_N; ++j)
+	{
+		A[j] = MontReduce(static_cast<int>(A[j]) * MLWE_F);
+	}
+}
+
+void MLWEQ3329N256::NttScalar(Poly &A)
+{
+	size_t k = 0;
+
+	for (size_t len = 128; len >= 2; len >>= 1)
+	{
+		for (size_t start = 0; start < MLWE_N; start += 2 * len)
+		{
+			++k;
+			const int Z = Zetas[k];
+
+			for (size_t j = start; j < start + len; ++j)
+			{
+				const short T = MontReduce(Z * A[j + len]);
+				A[j + len] = A[j] - T;
+				A[j] = A[j] + T;
+			}
+		}
+	}
+
+	ReducePoly(A);
+}
+
+void MLWEQ3329N256::ReducePoly(Poly &A)
+{
+#if defined(__AVX2__)
+
+	for (size_t i = 0; i < MLWE_N; i += 16)
+	{
+		const __m256i T = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[i]));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[i]), BarrettX(T));
+	}
+
+#else
+
+	for (size_t i = 0; i < MLWE_N; ++i)
+	{
+		A[i] = BarrettReduce(A[i]);
+	}
+
+#endif
+}
+
+void MLWEQ3329N256::ToMont(Poly &A)
+{
+#if defined(__AVX2__)
+
+	const __m256i F = _mm256_set1_epi16(MLWE_MONT2);
+
+	for (size_t i = 0; i < MLWE_N; i += 16)
+	{
+		const __m256i T = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&A[i]));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&A[i]), MontMulX(T, F));
+	}
+
+#else
+
+	for (size_t i = 0; i < MLWE_N; ++i)
+	{
+		A[i] = MontReduce(static_cast<int>(A[i]) * MLWE_MONT2);
+	}
+
+#endif
+}
+
+#if defined(__AVX2__)
+
+__m256i MLWEQ3329N256::BarrettX(const __m256i &A)
+{
+	// t = round(a * v / 2^26), the high product word gives the first 16 bits of the shift
+	const __m256i T = _mm256_srai_epi16(_mm256_add_epi16(_mm256_mulhi_epi16(A, _mm256_set1_epi16(MLWE_BARRETT)), _mm256_set1_epi16(512)), 10);
+
+	return _mm256_sub_epi16(A, _mm256_mullo_epi16(T, _mm256_set1_epi16(MLWE_Q)));
+}
+
+__m256i MLWEQ3329N256::BaseMulX(const __m256i &A, const __m256i &B, const __m256i &Zeta)
+{
+	// even lanes hold a0*b0 + a1*b1*zeta, odd lanes a0*b1 + a1*b0
+	const __m256i P = MontMulX(A, B);
+	const __m256i PZ = MontMulX(P, Zeta);
+	const __m256i BS = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(B, 0xB1), 0xB1);
+	const __m256i C = MontMulX(A, BS);
+	const __m256i R0 = _mm256_add_epi16(P, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(PZ, 0xB1), 0xB1));
+	const __m256i R1 = _mm256_add_epi16(C, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(C, 0xB1), 0xB1));
+
+	return _mm256_blend_epi16(R0, R1, 0xAA);
+}
+
+__m256i MLWEQ3329N256::MontMulX(const __m256i &A, const __m256i &B)
+{
+	// the low product words cancel exactly, so the reduction is the difference of the high words
+	const __m256i LO = _mm256_mullo_epi16(A, B);
+	const __m256i HI = _mm256_mulhi_epi16(A, B);
+	const __m256i T = _mm256_mullo_epi16(LO, _mm256_set1_epi16(static_cast<short>(MLWE_QINV)));
+
+	return _mm256_sub_epi16(HI, _mm256_mulhi_epi16(T, _mm256_set1_epi16(MLWE_Q)));
+}
+
+#endif
+
+//~~~Packing~~~//
+
+void MLWEQ3329N256::Compress(std::vector<byte> &Output, size_t OutOffset, const Poly &A, uint Bits)
+{
+	const uint MASK = (1U << Bits) - 1;
+	ulong acc = 0;
+	uint cnt = 0;
+
+	for (size_t i = 0; i < MLWE_N; ++i)
+	{
+		// round(2^d * x / q) of the canonical coefficient
+		const uint X = static_cast<uint>(A[i] + ((A[i] >> 15) & MLWE_Q));
+		const uint T = (((X << Bits) + (MLWE_Q / 2)) / MLWE_Q) & MASK;
+
+		acc |= static_cast<ulong>(T) << cnt;
+		cnt += Bits;
+
+		while (cnt >= 8)
+		{
+			Output[OutOffset] = static_cast<byte>(acc);
+			++OutOffset;
+			acc >>= 8;
+			cnt -= 8;
+		}
+	}
+}
+
+void MLWEQ3329N256::Decompress(Poly &A, const std::vector<byte> &Input, size_t InOffset, uint Bits)
+{
+	const uint MASK = (1U << Bits) - 1;
+	ulong acc = 0;
+	uint cnt = 0;
+
+	for (size_t i = 0; i < MLWE_N; ++i)
+	{
+		while (cnt < Bits)
+		{
+			acc |= static_cast<ulong>(Input[InOffset]) << cnt;
+			++InOffset;
+			cnt += 8;
+		}
+
+		// round(q * y / 2^d)
+		const uint Y = static_cast<uint>(acc) & MASK;
+		A[i] = static_cast<short>(((Y * MLWE_Q) + (1U << (Bits - 1))) >> Bits);
+		acc >>= Bits;
+		cnt -= Bits;
+	}
+}
+
+bool MLWEQ3329N256::FromBytes(Poly &A, const std::vector<byte> &Input, size_t InOffset)
+{
+	uint err = 0;
+
+	for (size_t i = 0; i < MLWE_N / 2; ++i)
+	{
+		const uint B0 = Input[InOffset + (3 * i)];
+		const uint B1 = Input[InOffset + (3 * i) + 1];
+		const uint B2 = Input[InOffset + (3 * i) + 2];
+		const uint T0 = (B0 | (B1 << 8)) & 0x0FFF;
+		const uint T1 = ((B1 >> 4) | (B2 << 4)) & 0x0FFF;
+
+		// the encoding is valid only if every coefficient is less than q
+		err |= (static_cast<uint>(MLWE_Q - 1) - T0) | (static_cast<uint>(MLWE_Q - 1) - T1);
+		A[2 * i] = static_cast<short>(T0);
+		A[(2 * i) + 1] = static_cast<short>(T1);
+	}
+
+	return (err >> 31) == 0;
+}
+
+void MLWEQ3329N256::ToBytes(std::vector<byte> &Output, size_t OutOffset, const Poly &A)
+{
+	for (size_t i = 0; i < MLWE_N / 2; ++i)
+	{
+		const uint T0 = static_cast<uint>(A[2 * i] + ((A[2 * i] >> 15) & MLWE_Q));
+		const uint T1 = static_cast<uint>(A[(2 * i) + 1] + ((A[(2 * i) + 1] >> 15) & MLWE_Q));
+
+		Output[OutOffset + (3 * i)] = static_cast<byte>(T0);
+		Output[OutOffset + (3 * i) + 1] = static_cast<byte>((T0 >> 8) | (T1 << 4));
+		Output[OutOffset + (3 * i) + 2] = static_cast<byte>(T1 >> 4);
+	}
+}
+
+NAMESPACE_MODULELWEEND
@@ -0,0 +1,159 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_MLWEQ3329N256_H
+#define CEX_MLWEQ3329N256_H
+
+#include "CexDomain.h"
+#include "IPrng.h"
+#include "MLWEParamSet.h"
+#if defined(__AVX2__)
+#	include "Intrinsics.h"
+#endif
+
+NAMESPACE_MODULELWE
+
+using Prng::IPrng;
+
+/**
+* \internal
+*/
+
+/// <summary>
+/// The ModuleLWE (Kyber) key encapsulation functions using a modulus of 3329 with 256 coefficients
+/// <para>Polynomials are held as 16-bit coefficients; the NTT, the base multiplications, the binomial noise sampler and the uniform rejection sampler run 16 coefficients at a time on AVX2.
+/// The matrix A and the noise vectors are expanded 4 polynomials at a time with the interleaved Keccak permutation.</para>
+/// </summary>
+class MLWEQ3329N256
+{
+private:
+
+	static const int MLWE_BARRETT = 20159;
+	static const int MLWE_F = 1441;
+	static const int MLWE_MONT2 = 1353;
+	static const uint MLWE_N = 256;
+	static const int MLWE_Q = 3329;
+	static const int MLWE_QINV = -3327;
+	static const size_t POLY_BYTES = 384;
+	static const size_t SEED_SIZE = 32;
+	static const size_t SHA3_256_RATE = 136;
+	static const size_t SHA3_512_RATE = 72;
+	static const size_t SHAKE128_RATE = 168;
+	static const size_t SHAKE256_RATE = 136;
+	static const size_t UNIFORM_BLOCKS = 3;
+	static const short Zetas[128];
+#if defined(__AVX2__)
+	static const ulong RejIndex[256];
+#endif
+
+public:
+
+	typedef std::array<short, MLWE_N> Poly;
+
+	MLWEQ3329N256() = delete;
+	MLWEQ3329N256(const MLWEQ3329N256&) = delete;
+	MLWEQ3329N256& operator=(const MLWEQ3329N256&) = delete;
+	MLWEQ3329N256& operator=(MLWEQ3329N256&&) = delete;
+
+	static void GetParamSet(MLWEParamSet &Params, MLWEParams Parameters);
+
+	static void Decrypt(std::vector<byte> &Secret, const std::vector<byte> &CipherText, const std::vector<byte> &PrivateKey, const MLWEParamSet &Params);
+
+	static void Encrypt(std::vector<byte> &Secret, std::vector<byte> &CipherText, const std::vector<byte> &PublicKey, std::unique_ptr<IPrng> &Random, const MLWEParamSet &Params);
+
+	static void Encrypt(std::vector<byte> &Secret, std::vector<byte> &CipherText, const std::vector<byte> &PublicKey, const std::vector<byte> &Message, const MLWEParamSet &Params);
+
+	static void Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, std::unique_ptr<IPrng> &Random, const MLWEParamSet &Params);
+
+	static void Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, const std::vector<byte> &Seed, const MLWEParamSet &Params);
+
+	//~~~Vectorized Kernels~~~//
+
+	// the AVX2 kernels when AVX2 is enabled, and the portable kernels they are tested against
+
+	static void Cbd(Poly &R, const std::vector<byte> &Input, size_t InOffset, uint Eta);
+
+	static void CbdScalar(Poly &R, const std::vector<byte> &Input, size_t InOffset, uint Eta);
+
+	static void Ntt(Poly &A);
+
+	static void NttInv(Poly &A);
+
+	static void NttInvScalar(Poly &A);
+
+	static void NttScalar(Poly &A);
+
+	static void RejUniform(Poly &A, size_t &Count, const std::vector<byte> &Input, size_t InOffset, size_t Length);
+
+	static void RejUniformScalar(Poly &A, size_t &Count, const std::vector<byte> &Input, size_t InOffset, size_t Length);
+
+private:
+
+	//~~~CPA Encryption~~~//
+
+	static void CpaDecrypt(std::vector<byte> &Message, const std::vector<byte> &CipherText, const std::vector<byte> &PrivateKey, const MLWEParamSet &Params);
+
+	static void CpaEncrypt(std::vector<byte> &CipherText, const std::vector<byte> &Message, const std::vector<byte> &PublicKey, size_t PubOffset, const std::vector<byte> &Coins, const MLWEParamSet &Params);
+
+	//~~~Sampling~~~//
+
+	static void ExpandA(std::vector<Poly> &A, const std::vector<byte> &Rho, bool Transposed, const MLWEParamSet &Params);
+
+	static void ExpandNoise(std::vector<Poly> &R, const std::vector<byte> &Seed, byte Nonce, uint Eta);
+
+	//~~~Keccak~~~//
+
+	static void Sponge(std::vector<byte> &Output, size_t OutOffset, size_t Length, const std::vector<byte> &Input, size_t Rate, byte Domain);
+
+	static void SpongeAbsorbX4(std::vector<ulong> &State, const std::vector<byte> &Seeds, size_t SeedLength, size_t Rate);
+
+	static void SpongeSqueezeX4(std::vector<ulong> &State, std::vector<byte> &Output, size_t Blocks, size_t Rate);
+
+	//~~~Arithmetic~~~//
+
+	static short BarrettReduce(short A);
+
+	static short MontReduce(int A);
+
+	static void MultiplyAcc(Poly &R, const std::vector<Poly> &A, size_t AOffset, const std::vector<Poly> &B);
+
+	static void ReducePoly(Poly &A);
+
+	static void ToMont(Poly &A);
+
+#if defined(__AVX2__)
+	static __m256i BarrettX(const __m256i &A);
+
+	static __m256i BaseMulX(const __m256i &A, const __m256i &B, const __m256i &Zeta);
+
+	static __m256i MontMulX(const __m256i &A, const __m256i &B);
+#endif
+
+	//~~~Packing~~~//
+
+	static void Compress(std::vector<byte> &Output, size_t OutOffset, const Poly &A, uint Bits);
+
+	static void Decompress(Poly &A, const std::vector<byte> &Input, size_t InOffset, uint Bits);
+
+	static bool FromBytes(Poly &A, const std::vector<byte> &Input, size_t InOffset);
+
+	static void ToBytes(std::vector<byte> &Output, size_t OutOffset, const Poly &A);
+};
+
+NAMESPACE_MODULELWEEND
+#endif
@@ -1,8 +1,11 @@
 #include "MPKCPrivateKey.h"
+#include "CryptoAsymmetricException.h"
 #include "IntUtils.h"
 
 NAMESPACE_ASYMMETRICKEY
 
+using Exception::CryptoAsymmetricException;
+
 //~~~Properties~~~//
 
 const AsymmetricEngines MPKCPrivateKey::CipherType()
@@ -10,30 +13,88 @@ const AsymmetricEngines MPKCPrivateKey::CipherType()
 	return AsymmetricEngines::McEliece;
 }
 
+const bool MPKCPrivateKey::IsMapped()
+{
+	return (m_keyMap != nullptr);
+}
+
 const MPKCParams MPKCPrivateKey::Parameters()
 {
 	return m_mpkcParameters;
 }
 
+const std::vector<byte> MPKCPrivateKey::S()
+{
+	// copied from the owned array or the mapped view; the key is never modified
+	return (m_priSize != 0) ? std::vector<byte>(m_priBase, m_priBase + m_priSize) : std::vector<byte>(0);
+}
+
+const byte* MPKCPrivateKey::SData()
+{
+	return m_priBase;
+}
+
+const size_t MPKCPrivateKey::SSize()
+{
+	return m_priSize;
+}
 
 //~~~Constructor~~~//
 
 MPKCPrivateKey::MPKCPrivateKey(MPKCParams Params, std::vector<byte> &S)
 	:
 	m_isDestroyed(false),
+	m_keyMap(nullptr),
 	m_mpkcParameters(Params),
+	m_priBase(nullptr),
+	m_priSize(S.size()),
 	m_sCoeffs(S)
 {
+	m_priBase = m_sCoeffs.data();
 }
 
 MPKCPrivateKey::MPKCPrivateKey(const std::vector<byte> &KeyStream)
 	:
-	m_isDestroyed(false)
+	m_isDestroyed(false),
+	m_keyMap(nullptr),
+	m_mpkcParameters(MPKCParams::None),
+	m_priBase(nullptr),
+	m_priSize(0),
+	m_sCoeffs(0)
 {
 	m_mpkcParameters = static_cast<MPKCParams>(KeyStream[0]);
 	uint sLen = Utility::IntUtils::LeBytesTo32(KeyStream, 1);
 	m_sCoeffs.resize(sLen);
-	Utility::MemUtils::Copy(KeyStream, 5, m_sCoeffs, 0, sLen);
+	Utility::MemUtils::Copy(KeyStream, HDR_SIZE, m_sCoeffs, 0, sLen);
+	m_priBase = m_sCoeffs.data();
+	m_priSize = m_sCoeffs.size();
+}
+
+MPKCPrivateKey::MPKCPrivateKey(const std::shared_ptr<MappedFile> &KeyMap)
+	:
+	m_isDestroyed(false),
+	m_keyMap(KeyMap),
+	m_mpkcParameters(MPKCParams::None),
+	m_priBase(nullptr),
+	m_priSize(0),
+	m_sCoeffs(0)
+{
+	if (m_keyMap == nullptr || m_keyMap->Length() <= HDR_SIZE)
+	{
+		throw CryptoAsymmetricException("MPKCPrivateKey:CTor", "The mapped key file is invalid!");
+	}
+
+	const byte* keyBase = m_keyMap->Data();
+	const size_t SLEN = static_cast<size_t>(keyBase[1]) | (static_cast<size_t>(keyBase[2]) << 8) | (static_cast<size_t>(keyBase[3]) << 16) | (static_cast<size_t>(keyBase[4]) << 24);
+
+	if (SLEN == 0 || SLEN > m_keyMap->Length() - HDR_SIZE)
+	{
+		throw CryptoAsymmetricException("MPKCPrivateKey:CTor", "The mapped key file is invalid!");
+	}
+
+	m_mpkcParameters = static_cast<MPKCParams>(keyBase[0]);
+	m_priBase = keyBase + HDR_SIZE;
+	m_priSize = SLEN;
 }
 
 MPKCPrivateKey::~MPKCPrivateKey()
@@ -49,19 +110,28 @@ void MPKCPrivateKey::Destroy()
 	{
 		m_isDestroyed = true;
 		m_mpkcParameters = MPKCParams::None;
+		m_priBase = nullptr;
+		m_priSize = 0;
 
 		if (m_sCoeffs.size() > 0)
 			Utility::IntUtils::ClearVector(m_sCoeffs);
+
+		// the view is released with the last key that references it
+		m_keyMap.reset();
 	}
 }
 
 std::vector<byte> MPKCPrivateKey::ToBytes()
 {
-	uint sLen = static_cast<uint>(m_sCoeffs.size());
-	std::vector<byte> s(sLen + 5);
+	uint sLen = static_cast<uint>(m_priSize);
+	std::vector<byte> s(sLen + HDR_SIZE);
 	s[0] = static_cast<byte>(m_mpkcParameters);
 	Utility::IntUtils::Le32ToBytes(sLen, s, 1);
-	Utility::MemUtils::Copy(s, 5, m_sCoeffs, 0, sLen);
+
+	if (sLen != 0)
+	{
+		std::memcpy(&s[HDR_SIZE], m_priBase, sLen);
+	}
 
 	return s;
 }
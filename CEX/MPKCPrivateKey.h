@@ -3,21 +3,35 @@
 
 #include "CexDomain.h"
 #include "IAsymmetricKey.h"
+#include "MappedFile.h"
 #include "MPKCParams.h"
 
 NAMESPACE_ASYMMETRICKEY
 
+using IO::MappedFile;
 using Enumeration::MPKCParams;
 
 /// <summary>
 /// A McEliece Private Key container
 /// </summary>
+///
+/// <remarks>
+/// <para>The key can be constructed from a <see cref="IO::MappedFile"/> containing a serialized private key (the output of ToBytes()); 
+/// the file should be mapped with the Lock parameter set, so that the key is read from page locked memory and not copied to the heap.</para>
+/// <para>The key is not modified after construction, so the accessors and ToBytes() can be called concurrently from any number of threads; 
+/// Destroy() must not be called while another thread is using the key.</para>
+/// </remarks>
 class MPKCPrivateKey final : public IAsymmetricKey
 {
 private:
 
+	static const size_t HDR_SIZE = 5;
+
 	bool m_isDestroyed;
+	std::shared_ptr<MappedFile> m_keyMap;
 	MPKCParams m_mpkcParameters;
+	const byte* m_priBase;
+	size_t m_priSize;
 	std::vector<byte> m_sCoeffs;
 
 public:
@@ -34,6 +48,11 @@ public:
 	/// </summary>
 	const AsymmetricEngines CipherType() override;
 
+	/// <summary>
+	/// Get: The private key is read from a mapped key file
+	/// </summary>
+	const bool IsMapped();
+
 	/// <summary>
 	/// Get: The cipher parameters enumeration name
 	/// </summary>
@@ -41,8 +60,20 @@ public:
 
 	/// <summary>
 	/// Get: The private key polynomial
+	/// <para>Returns a copy of the key, read from the owned array or the mapped view; use SData() to read the key in place.
+	/// The copy is not erased by the key; the caller should clear it after use.</para>
+	/// </summary>
+	const std::vector<byte> S();
+
+	/// <summary>
+	/// Get: A pointer to the first byte of the private key; points into the mapped view if the key is mapped
 	/// </summary>
-	const std::vector<byte> &S() { return m_sCoeffs; }
+	const byte* SData();
+
+	/// <summary>
+	/// Get: The byte size of the private key
+	/// </summary>
+	const size_t SSize();
 
 	//~~~Constructor~~~//
 
@@ -61,6 +92,15 @@ public:
 	/// <param name="KeyStream">The serialized private key</param>
 	explicit MPKCPrivateKey(const std::vector<byte> &KeyStream);
 
+	/// <summary>
+	/// Initialize this class with a mapped private key file
+	/// </summary>
+	/// 
+	/// <param name="KeyMap">The mapped key file containing a serialized private key; the mapping is shared with the key</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the mapped file is not a valid private key</exception>
+	explicit MPKCPrivateKey(const std::shared_ptr<MappedFile> &KeyMap);
+
 	/// <summary>
 	/// Finalize objects
 	/// </summary>
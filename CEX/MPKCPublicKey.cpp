@@ -1,8 +1,11 @@
 #include "MPKCPublicKey.h"
+#include "CryptoAsymmetricException.h"
 #include "IntUtils.h"
 
 NAMESPACE_ASYMMETRICKEY
 
+using Exception::CryptoAsymmetricException;
+
 //~~~Properties~~~//
 
 const AsymmetricEngines MPKCPublicKey::CipherType()
@@ -10,36 +13,88 @@ const AsymmetricEngines MPKCPublicKey::CipherType()
 	return Enumeration::AsymmetricEngines::McEliece;
 }
 
+const bool MPKCPublicKey::IsMapped()
+{
+	return (m_keyMap != nullptr);
+}
+
 const MPKCParams MPKCPublicKey::Parameters()
 {
 	return m_mpkcParameters;
 }
 
-const std::vector<byte> &MPKCPublicKey::P()
+const std::vector<byte> MPKCPublicKey::P()
 {
-	return m_pubMat;
+	// copied from the owned array or the mapped view; the key is never modified
+	return (m_pubSize != 0) ? std::vector<byte>(m_pubBase, m_pubBase + m_pubSize) : std::vector<byte>(0);
+}
+
+const byte* MPKCPublicKey::PData()
+{
+	return m_pubBase;
+}
+
+const size_t MPKCPublicKey::PSize()
+{
+	return m_pubSize;
 }
 
 //~~~Constructor~~~//
 
 MPKCPublicKey::MPKCPublicKey(MPKCParams Params, const std::vector<byte> &P)
 	:
-	m_mpkcParameters(Params),
 	m_isDestroyed(false),
-	m_pubMat(P)
+	m_keyMap(nullptr),
+	m_mpkcParameters(Params),
+	m_pubBase(nullptr),
+	m_pubMat(P),
+	m_pubSize(P.size())
 {
+	m_pubBase = m_pubMat.data();
 }
 
 MPKCPublicKey::MPKCPublicKey(const std::vector<byte> &KeyStream)
 	:
 	m_isDestroyed(false),
+	m_keyMap(nullptr),
 	m_mpkcParameters(MPKCParams::None),
-	m_pubMat(0)
+	m_pubBase(nullptr),
+	m_pubMat(0),
+	m_pubSize(0)
 {
 	m_mpkcParameters = static_cast<MPKCParams>(KeyStream[0]);
 	uint pLen = Utility::IntUtils::LeBytesTo32(KeyStream, 1);
 	m_pubMat.resize(pLen);
-	Utility::MemUtils::Copy(KeyStream, 5, m_pubMat, 0, pLen);
+	Utility::MemUtils::Copy(KeyStream, HDR_SIZE, m_pubMat, 0, pLen);
+	m_pubBase = m_pubMat.data();
+	m_pubSize = m_pubMat.size();
+}
+
+MPKCPublicKey::MPKCPublicKey(const std::shared_ptr<MappedFile> &KeyMap)
+	:
+	m_isDestroyed(false),
+	m_keyMap(KeyMap),
+	m_mpkcParameters(MPKCParams::None),
+	m_pubBase(nullptr),
+	m_pubMat(0),
+	m_pubSize(0)
+{
+	if (m_keyMap == nullptr || m_keyMap->Length() <= HDR_SIZE)
+	{
+		throw CryptoAsymmetricException("MPKCPublicKey:CTor", "The mapped key file is invalid!");
+	}
+
+	const byte* keyBase = m_keyMap->Data();
+	const size_t PLEN = static_cast<size_t>(keyBase[1]) | (static_cast<size_t>(keyBase[2]) << 8) | (static_cast<size_t>(keyBase[3]) << 16) | (static_cast<size_t>(keyBase[4]) << 24);
+
+	if (PLEN == 0 || PLEN > m_keyMap->Length() - HDR_SIZE)
+	{
+		throw CryptoAsymmetricException("MPKCPublicKey:CTor", "The mapped key file is invalid!");
+	}
+
+	m_mpkcParameters = static_cast<MPKCParams>(keyBase[0]);
+	m_pubBase = keyBase + HDR_SIZE;
+	m_pubSize = PLEN;
 }
 
 MPKCPublicKey::~MPKCPublicKey()
@@ -55,19 +110,28 @@ void MPKCPublicKey::Destroy()
 	{
 		m_isDestroyed = true;
 		m_mpkcParameters = MPKCParams::None;
+		m_pubBase = nullptr;
+		m_pubSize = 0;
 
 		if (m_pubMat.size() > 0)
 			Utility::IntUtils::ClearVector(m_pubMat);
+
+		// the view is released with the last key that references it
+		m_keyMap.reset();
 	}
 }
 
 std::vector<byte> MPKCPublicKey::ToBytes()
 {
-	uint pLen = static_cast<uint>(m_pubMat.size());
-	std::vector<byte> p(pLen + 5);
+	uint pLen = static_cast<uint>(m_pubSize);
+	std::vector<byte> p(pLen + HDR_SIZE);
 	p[0] = static_cast<byte>(m_mpkcParameters);
 	Utility::IntUtils::Le32ToBytes(pLen, p, 1);
-	Utility::MemUtils::Copy(m_pubMat, 0, p, 5, pLen);
+
+	if (pLen != 0)
+	{
+		std::memcpy(&p[HDR_SIZE], m_pubBase, pLen);
+	}
 
 	return p;
 }
@@ -3,22 +3,36 @@
 
 #include "CexDomain.h"
 #include "IAsymmetricKey.h"
+#include "MappedFile.h"
 #include "MPKCParams.h"
 
 NAMESPACE_ASYMMETRICKEY
 
+using IO::MappedFile;
 using Enumeration::MPKCParams;
 
 /// <summary>
-/// A McEliece Private Key container
+/// A McEliece Public Key container
 /// </summary>
+///
+/// <remarks>
+/// <para>The key can be constructed from a <see cref="IO::MappedFile"/> containing a serialized public key (the output of ToBytes()); 
+/// the public matrix is then read by the cipher directly from the mapped view, and is never copied to the heap.</para>
+/// <para>The key is not modified after construction, so the accessors and ToBytes() can be called concurrently from any number of threads; 
+/// Destroy() must not be called while another thread is using the key.</para>
+/// </remarks>
 class MPKCPublicKey final : public IAsymmetricKey
 {
 private:
 
+	static const size_t HDR_SIZE = 5;
+
 	bool m_isDestroyed;
-	std::vector<byte> m_pubMat;
+	std::shared_ptr<MappedFile> m_keyMap;
 	MPKCParams m_mpkcParameters;
+	const byte* m_pubBase;
+	std::vector<byte> m_pubMat;
+	size_t m_pubSize;
 
 public:
 
@@ -34,6 +48,11 @@ public:
 	/// </summary>
 	const AsymmetricEngines CipherType() override;
 
+	/// <summary>
+	/// Get: The public matrix is read from a mapped key file
+	/// </summary>
+	const bool IsMapped();
+
 	/// <summary>
 	/// Get: The cipher parameters enumeration name
 	/// </summary>
@@ -41,8 +60,19 @@ public:
 
 	/// <summary>
 	/// Get: The public keys polynomial
+	/// <para>Returns a copy of the matrix, read from the owned array or the mapped view; use PData() to read the matrix in place.</para>
+	/// </summary>
+	const std::vector<byte> P();
+
+	/// <summary>
+	/// Get: A pointer to the first byte of the public matrix; points into the mapped view if the key is mapped
+	/// </summary>
+	const byte* PData();
+
+	/// <summary>
+	/// Get: The byte size of the public matrix
 	/// </summary>
-	const std::vector<byte> &P();
+	const size_t PSize();
 
 	//~~~Constructor~~~//
 
@@ -61,6 +91,15 @@ public:
 	/// <param name="KeyStream">The serialized public key</param>
 	explicit MPKCPublicKey(const std::vector<byte> &KeyStream);
 
+	/// <summary>
+	/// Initialize this class with a mapped public key file
+	/// </summary>
+	/// 
+	/// <param name="KeyMap">The mapped key file containing a serialized public key; the mapping is shared with the key</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the mapped file is not a valid public key</exception>
+	explicit MPKCPublicKey(const std::shared_ptr<MappedFile> &KeyMap);
+
 	/// <summary>
 	/// Finalize objects
 	/// </summary>
@@ -112,10 +112,10 @@ public:
 	/// Initialize the structure with parameters for any supported type of Mac generator
 	/// </summary>
 	/// 
-	/// <param name="MacType">The type of Mac generator; Cmac, Hmac, or Vmac</param>
+	/// <param name="MacType">The type of Mac generator; Cmac, Hmac, Blake2Mac, SkeinMac, or KMAC</param>
 	/// <param name="KeySize">The mac/cipher key size in bytes</param>
 	/// <param name="IvSize">Size of the Mac Initialization Vector</param>
-	/// <param name="HmacEngine">The Digest engine used in the Hmac</param>
+	/// <param name="HmacEngine">The Digest engine used in the Hmac, or the keyed digest used by the Blake2Mac, SkeinMac, and KMAC generators</param>
 	/// <param name="EngineType">The symmetric block cipher Engine type</param>
 	/// <param name="BlockSize">The cipher Block Size</param>
 	/// <param name="RoundCount">The number of transformation Rounds</param>
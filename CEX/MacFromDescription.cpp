@@ -1,7 +1,10 @@
 #include "MacFromDescription.h"
+#include "Blake2Mac.h"
 #include "CMAC.h"
 #include "HMAC.h"
+#include "KMAC.h"
 #include "Macs.h"
+#include "SkeinMac.h"
 #include "CryptoException.h"
 
 NAMESPACE_HELPER
@@ -16,6 +19,12 @@ IMac* MacFromDescription::GetInstance(MacDescription &Description)
 			return new Mac::CMAC(Description.EngineType());
 		case Enumeration::Macs::HMAC:
 			return new Mac::HMAC(Description.HmacEngine());
+		case Enumeration::Macs::Blake2Mac:
+			return new Mac::Blake2Mac(Description.HmacEngine());
+		case Enumeration::Macs::SkeinMac:
+			return new Mac::SkeinMac(Description.HmacEngine());
+		case Enumeration::Macs::KMAC:
+			return new Mac::KMAC(Description.HmacEngine());
 		default:
 			throw Exception::CryptoException("MacFromDescription:GetInstance", "The mac type is not recognized!");
 		}
@@ -1,4 +1,5 @@
 #include "MacStream.h"
+#include "IntUtils.h"
 #include "MacFromDescription.h"
 
 NAMESPACE_PROCESSING
@@ -70,9 +71,41 @@ std::vector<byte> MacStream::Compute(const std::vector<byte> &Input, size_t InOf
 	return Process(Input, InOffset, Length);
 }
 
+StreamJob<std::vector<byte>> MacStream::ComputeAsync(IByteStream* InStream, StreamExecutor &Executor)
+{
+	CexAssert(m_isInitialized, "the mac has not been initialized");
+	CexAssert(InStream->Length() - InStream->Position() > 0, "the input stream is too short");
+	CexAssert(InStream->CanRead(), "the input stream is set to write only!");
+
+	const ulong DATLEN = InStream->Length() - InStream->Position();
+	std::shared_ptr<std::vector<byte>> inpBuffer = std::make_shared<std::vector<byte>>(static_cast<size_t>(Utility::IntUtils::Min<ulong>(DATLEN, ASYNC_STEPSIZE)));
+	ulong prcLen = 0;
+
+	return Executor.Submit<std::vector<byte>>([this, InStream, DATLEN, inpBuffer, prcLen](JobState &Job, std::vector<byte> &Result) mutable -> bool
+	{
+		const size_t PRCLEN = static_cast<size_t>(Utility::IntUtils::Min<ulong>(DATLEN - prcLen, ASYNC_STEPSIZE));
+		const size_t PRCRED = InStream->Read(*inpBuffer, 0, PRCLEN);
+
+		if (PRCRED == 0)
+			throw CryptoProcessingException("MacStream:ComputeAsync", "The input stream ended before the expected length!");
+
+		m_macEngine->Update(*inpBuffer, 0, PRCRED);
+		prcLen += PRCRED;
+		Job.Report(prcLen, DATLEN);
+
+		if (prcLen != DATLEN)
+			return true;
+
+		Result.resize(m_macEngine->MacSize());
+		m_macEngine->Finalize(Result, 0);
+
+		return false;
+	});
+}
+
 void MacStream::Initialize(ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.KeySizes().KeySize()))
 		throw CryptoProcessingException("CipherStream:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 
 	try
@@ -31,6 +31,7 @@
 #include "IMac.h"
 #include "ISymmetricKey.h"
 #include "MacDescription.h"
+#include "StreamExecutor.h"
 #include "SymmetricKeySize.h"
 
 NAMESPACE_PROCESSING
@@ -38,6 +39,7 @@ NAMESPACE_PROCESSING
 using Exception::CryptoProcessingException;
 using Routing::Event;
 using Key::Symmetric::ISymmetricKey;
+using Key::Symmetric::SymmetricKeyView;
 using IO::IByteStream;
 using Mac::IMac;
 using Key::Symmetric::SymmetricKeySize;
@@ -74,6 +76,8 @@ class MacStream
 {
 private:
 
+	static const size_t ASYNC_STEPSIZE = 64 * 1024;
+
 	IMac* m_macEngine;
 	bool m_destroyEngine;
 	bool m_isDestroyed;
@@ -142,6 +146,19 @@ public:
 	/// <returns>The Mac output code</returns>
 	std::vector<byte> Compute(const std::vector<byte> &Input, size_t InOffset, size_t Length);
 
+	/// <summary>
+	/// Process the entire length of the source stream as a job on a shared executor.
+	/// <para>The job processes the stream in slices of up to 64KB, interleaved with the other jobs on the executor.
+	/// Progress is reported through the returned jobs WaitProgress() function; the ProgressPercent event is not raised.
+	/// This instance and the source stream must not be used until the job is complete.</para>
+	/// </summary>
+	///
+	/// <param name="InStream">The source stream to process</param>
+	/// <param name="Executor">The executor that runs the job</param>
+	/// 
+	/// <returns>The job handle; the jobs result is the MAC code</returns>
+	StreamJob<std::vector<byte>> ComputeAsync(IByteStream* InStream, StreamExecutor &Executor);
+
 	/// <summary>
 	/// Initialize the MAC generator with a SymmetricKey key container.
 	/// <para>Uses a key array to initialize the MAC.
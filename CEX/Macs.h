@@ -25,7 +25,19 @@ enum class Macs : byte
 	/// <summary>
 	/// A Cipher based Message Authentication Code wrapper (GMAC)
 	/// </summary>
-	GMAC = 3
+	GMAC = 3,
+	/// <summary>
+	/// The Blake2 digest in its native keyed mode (Blake2Mac)
+	/// </summary>
+	Blake2Mac = 4,
+	/// <summary>
+	/// The Skein digest keyed through the UBI key block (SkeinMac)
+	/// </summary>
+	SkeinMac = 5,
+	/// <summary>
+	/// The Keccak based Message Authentication Code (KMAC)
+	/// </summary>
+	KMAC = 6
 };
 
 NAMESPACE_ENUMERATIONEND
@@ -0,0 +1,193 @@
+#include "MappedFile.h"
+#include "IntUtils.h"
+#include <fstream>
+
+#if defined(CEX_OS_WINDOWS)
+#	include <Windows.h>
+#elif defined(CEX_OS_LINUX) || defined(CEX_OS_UNIX) || defined(CEX_OS_POSIX) || defined(CEX_OS_ANDROID) || defined(CEX_OS_APPLE)
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#	define CEX_MAPPEDFILE_MMAP
+#endif
+
+NAMESPACE_IO
+
+//~~~Properties~~~//
+
+const byte* MappedFile::Data()
+{
+	return m_mapBase;
+}
+
+const bool MappedFile::IsLocked()
+{
+	return m_isLocked;
+}
+
+const size_t MappedFile::Length()
+{
+	return m_mapSize;
+}
+
+//~~~Constructor~~~//
+
+MappedFile::MappedFile(const std::string &FilePath, bool Lock)
+	:
+	m_fileBuffer(0),
+	m_fileHandle(nullptr),
+	m_isDestroyed(false),
+	m_isLocked(false),
+	m_mapBase(nullptr),
+	m_mapHandle(nullptr),
+	m_mapSize(0)
+{
+#if defined(CEX_OS_WINDOWS)
+	HANDLE fileHandle = CreateFileA(FilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		throw CryptoProcessingException("MappedFile:CTor", "The file could not be opened!");
+	}
+
+	LARGE_INTEGER fileSize;
+
+	if (GetFileSizeEx(fileHandle, &fileSize) == 0 || fileSize.QuadPart == 0)
+	{
+		CloseHandle(fileHandle);
+		throw CryptoProcessingException("MappedFile:CTor", "The file is empty!");
+	}
+
+	HANDLE mapHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (mapHandle == nullptr)
+	{
+		CloseHandle(fileHandle);
+		throw CryptoProcessingException("MappedFile:CTor", "The file could not be mapped!");
+	}
+
+	void* view = MapViewOfFile(mapHandle, FILE_MAP_READ, 0, 0, 0);
+
+	if (view == nullptr)
+	{
+		CloseHandle(mapHandle);
+		CloseHandle(fileHandle);
+		throw CryptoProcessingException("MappedFile:CTor", "The file could not be mapped!");
+	}
+
+	m_fileHandle = fileHandle;
+	m_mapHandle = mapHandle;
+	m_mapBase = static_cast<const byte*>(view);
+	m_mapSize = static_cast<size_t>(fileSize.QuadPart);
+
+	if (Lock)
+	{
+		m_isLocked = (VirtualLock(view, m_mapSize) != 0);
+	}
+#elif defined(CEX_MAPPEDFILE_MMAP)
+	const int FILDES = open(FilePath.c_str(), O_RDONLY);
+
+	if (FILDES == -1)
+	{
+		throw CryptoProcessingException("MappedFile:CTor", "The file could not be opened!");
+	}
+
+	struct stat fileStat;
+
+	if (fstat(FILDES, &fileStat) != 0 || fileStat.st_size <= 0)
+	{
+		close(FILDES);
+		throw CryptoProcessingException("MappedFile:CTor", "The file is empty!");
+	}
+
+	m_mapSize = static_cast<size_t>(fileStat.st_size);
+	void* view = mmap(nullptr, m_mapSize, PROT_READ, MAP_SHARED, FILDES, 0);
+	// the mapping holds its own reference to the file
+	close(FILDES);
+
+	if (view == MAP_FAILED)
+	{
+		m_mapSize = 0;
+		throw CryptoProcessingException("MappedFile:CTor", "The file could not be mapped!");
+	}
+
+	m_mapBase = static_cast<const byte*>(view);
+
+	if (Lock)
+	{
+		m_isLocked = (mlock(view, m_mapSize) == 0);
+#	if defined(MADV_DONTDUMP)
+		// keep the secrets out of core dumps
+		madvise(view, m_mapSize, MADV_DONTDUMP);
+#	endif
+	}
+#else
+	// no mapping interface available; the file is read into the heap
+	std::ifstream inpStream(FilePath, std::ios::in | std::ios::binary | std::ios::ate);
+
+	if (!inpStream.is_open())
+	{
+		throw CryptoProcessingException("MappedFile:CTor", "The file could not be opened!");
+	}
+
+	const std::streamoff FLELEN = inpStream.tellg();
+
+	if (FLELEN <= 0)
+	{
+		throw CryptoProcessingException("MappedFile:CTor", "The file is empty!");
+	}
+
+	m_fileBuffer.resize(static_cast<size_t>(FLELEN));
+	inpStream.seekg(0, std::ios::beg);
+	inpStream.read(reinterpret_cast<char*>(m_fileBuffer.data()), FLELEN);
+	m_mapBase = m_fileBuffer.data();
+	m_mapSize = m_fileBuffer.size();
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void MappedFile::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+
+		if (m_mapBase != nullptr)
+		{
+#if defined(CEX_OS_WINDOWS)
+			if (m_isLocked)
+			{
+				VirtualUnlock(const_cast<byte*>(m_mapBase), m_mapSize);
+			}
+
+			UnmapViewOfFile(m_mapBase);
+			CloseHandle(static_cast<HANDLE>(m_mapHandle));
+			CloseHandle(static_cast<HANDLE>(m_fileHandle));
+#elif defined(CEX_MAPPEDFILE_MMAP)
+			if (m_isLocked)
+			{
+				munlock(m_mapBase, m_mapSize);
+			}
+
+			munmap(const_cast<byte*>(m_mapBase), m_mapSize);
+#else
+			Utility::IntUtils::ClearVector(m_fileBuffer);
+#endif
+		}
+
+		m_fileHandle = nullptr;
+		m_isLocked = false;
+		m_mapBase = nullptr;
+		m_mapHandle = nullptr;
+		m_mapSize = 0;
+	}
+}
+
+NAMESPACE_IOEND
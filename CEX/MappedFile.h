@@ -0,0 +1,122 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// A read-only memory mapped file, used to load large serialized keys without copying them to the heap.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_MAPPEDFILE_H
+#define CEX_MAPPEDFILE_H
+
+#include "CexDomain.h"
+#include "CryptoProcessingException.h"
+
+NAMESPACE_IO
+
+using Exception::CryptoProcessingException;
+
+/// <summary>
+/// A read-only memory mapped file
+/// </summary>
+///
+/// <example>
+/// <description>Load a McEliece public key from a key file:</description>
+/// <code>
+/// std::shared_ptr&lt;MappedFile&gt; map = std::make_shared&lt;MappedFile&gt;(KeyPath);
+/// MPKCPublicKey pk(map);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Overview:</description>
+/// <para>The file is mapped into the address space of the process as a shared, read-only view; the operating system reads pages from the file on first access, and processes that map the same file share the same physical pages.
+/// Keys constructed from a mapping read their data directly from the view, so a large public key (ex. the 300KB McEliece public matrix) is never copied to the heap. \n
+/// The mapping is normally held by a std::shared_ptr, so that several key instances can read from one view, and the view is released with the last reference.</para>
+///
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>If the Lock parameter is set, the view is locked in physical memory (mlock or VirtualLock), and on Linux is excluded from core dumps; this should be used when mapping a private key.</description></item>
+/// <item><description>If the operating system refuses to lock the view (ex. the RLIMIT_MEMLOCK limit is too small), the view remains usable, and IsLocked() returns false.</description></item>
+/// <item><description>The view is read-only and is not zeroed when released; a private key file should be stored on an encrypted or memory backed file system.</description></item>
+/// <item><description>On platforms without a mapping interface, the file is read into a heap buffer.</description></item>
+/// </list>
+/// </remarks>
+class MappedFile
+{
+private:
+
+	std::vector<byte> m_fileBuffer;
+	void* m_fileHandle;
+	bool m_isDestroyed;
+	bool m_isLocked;
+	const byte* m_mapBase;
+	void* m_mapHandle;
+	size_t m_mapSize;
+
+public:
+
+	MappedFile() = delete;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile& operator=(MappedFile&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: A pointer to the first byte of the mapped view
+	/// </summary>
+	const byte* Data();
+
+	/// <summary>
+	/// Get: The view is locked in physical memory
+	/// </summary>
+	const bool IsLocked();
+
+	/// <summary>
+	/// Get: The byte size of the mapped view
+	/// </summary>
+	const size_t Length();
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Map a file into memory as a read-only view
+	/// </summary>
+	///
+	/// <param name="FilePath">The full path to the file</param>
+	/// <param name="Lock">Lock the view in physical memory; used when mapping private keys</param>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the file does not exist, is empty, or can not be mapped</exception>
+	explicit MappedFile(const std::string &FilePath, bool Lock = false);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~MappedFile();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Unlock and release the view; optional, called by the finalizer
+	/// </summary>
+	void Destroy();
+};
+
+NAMESPACE_IOEND
+#endif
@@ -5,6 +5,7 @@
 #include "Keccak512.h"
 #include "Keccak1024.h"
 #include "MemUtils.h"
+#include "ParallelUtils.h"
 #include "PrngFromName.h"
 #include "SymmetricKey.h"
 
@@ -183,6 +184,16 @@ std::vector<byte> McEliece::Encrypt(const std::vector<byte> &Message)
 	return cpt;
 }
 
+std::vector<std::vector<byte>> McEliece::Encrypt(const std::vector<std::vector<byte>> &Messages)
+{
+	CexAssert(m_isInitialized, "The cipher has not been initialized");
+
+	std::vector<std::vector<byte>> cpt(0);
+	MPKCEncrypt(Messages, cpt);
+
+	return cpt;
+}
+
 IAsymmetricKeyPair* McEliece::Generate()
 {
 	CexAssert(m_mpkcParameters != MPKCParams::None, "The parameter setting is invalid");
@@ -254,8 +265,13 @@ bool McEliece::MPKCDecrypt(const std::vector<byte> &CipherText, std::vector<byte
 	// decrypt with McEliece, more fft configurations to be added
 	if (m_mpkcParameters == MPKCParams::M12T62)
 	{
+		if (m_privateKey->SSize() < FFTM12T62::PRIKEY_SIZE)
+		{
+			throw CryptoAsymmetricException("McEliece:Decrypt", "The private key is invalid!");
+		}
+
 		Message.resize(CipherText.size() - (FFTM12T62::SECRET_SIZE + keySizes.InfoSize()));
-		if (!FFTM12T62::Decrypt(e, m_privateKey->S(), CipherText))
+		if (!FFTM12T62::Decrypt(e, m_privateKey->SData(), CipherText))
 		{
 			return false;
 		}
@@ -292,49 +308,99 @@ bool McEliece::MPKCDecrypt(const std::vector<byte> &CipherText, std::vector<byte
 
 void McEliece::MPKCEncrypt(const std::vector<byte> &Message, std::vector<byte> &CipherText)
 {
-	Key::Symmetric::SymmetricKeySize keySizes;
+	Key::Symmetric::SymmetricKeySize keySizes = MPKCKeySize();
+	std::vector<byte> e((ulong)1 << (m_paramSet.GF - 3));
 
-	if (static_cast<byte>(m_cprMode->Engine()->Enumeral()) < static_cast<byte>(BlockCiphers::AHX))
+	// encrypt with McEliece
+	if (m_mpkcParameters == MPKCParams::M12T62)
 	{
-		// standard ciphers use keccak512 compression and a 256bit key
-		keySizes = m_cprMode->LegalKeySizes()[2];
+		if (m_publicKey->PSize() < FFTM12T62::PUBKEY_SIZE)
+		{
+			throw CryptoAsymmetricException("McEliece:Encrypt", "The public key is invalid!");
+		}
+
+		CipherText.resize(FFTM12T62::SECRET_SIZE + Message.size() + keySizes.InfoSize());
+		FFTM12T62::Encrypt(CipherText, e, m_publicKey->PData(), m_rndGenerator);
 	}
 	else
 	{
-		// HX ciphers use keccak1024 and a 512bit key
-		keySizes = m_cprMode->LegalKeySizes()[1];
+		throw CryptoAsymmetricException("McEliece:Encrypt", "The parameter type is invalid!");
 	}
 
-	std::vector<byte> e((ulong)1 << (m_paramSet.GF - 3));
+	MPKCSeal(Message, e, CipherText, keySizes);
+}
 
-	// encrypt with McEliece
+void McEliece::MPKCEncrypt(const std::vector<std::vector<byte>> &Messages, std::vector<std::vector<byte>> &CipherTexts)
+{
+	Key::Symmetric::SymmetricKeySize keySizes = MPKCKeySize();
+	std::vector<std::vector<byte>> e(Messages.size(), std::vector<byte>((ulong)1 << (m_paramSet.GF - 3)));
+	size_t i;
+
+	// encrypt with McEliece; the syndromes of the batch are computed in shared passes over the public key
 	if (m_mpkcParameters == MPKCParams::M12T62)
 	{
-		CipherText.resize(FFTM12T62::SECRET_SIZE + Message.size() + keySizes.InfoSize());
-		FFTM12T62::Encrypt(CipherText, e, m_publicKey->P(), m_rndGenerator);
+		if (m_publicKey->PSize() < FFTM12T62::PUBKEY_SIZE)
+		{
+			throw CryptoAsymmetricException("McEliece:Encrypt", "The public key is invalid!");
+		}
+
+		CipherTexts.resize(Messages.size());
+
+		for (i = 0; i < Messages.size(); ++i)
+		{
+			CipherTexts[i].resize(FFTM12T62::SECRET_SIZE + Messages[i].size() + keySizes.InfoSize());
+		}
+
+		FFTM12T62::Encrypt(CipherTexts, e, m_publicKey->PData(), m_rndGenerator, Utility::ParallelUtils::ProcessorCount() > 1);
 	}
 	else
 	{
 		throw CryptoAsymmetricException("McEliece:Encrypt", "The parameter type is invalid!");
 	}
 
+	for (i = 0; i < Messages.size(); ++i)
+	{
+		MPKCSeal(Messages[i], e[i], CipherTexts[i], keySizes);
+	}
+}
+
+Key::Symmetric::SymmetricKeySize McEliece::MPKCKeySize()
+{
+	Key::Symmetric::SymmetricKeySize keySizes;
+
+	if (static_cast<byte>(m_cprMode->Engine()->Enumeral()) < static_cast<byte>(BlockCiphers::AHX))
+	{
+		// standard ciphers use keccak512 compression and a 256bit key
+		keySizes = m_cprMode->LegalKeySizes()[2];
+	}
+	else
+	{
+		// HX ciphers use keccak1024 and a 512bit key
+		keySizes = m_cprMode->LegalKeySizes()[1];
+	}
+
+	return keySizes;
+}
+
+void McEliece::MPKCSeal(const std::vector<byte> &Message, const std::vector<byte> &E, std::vector<byte> &CipherText, Key::Symmetric::SymmetricKeySize &KeySizes)
+{
 	// hash e
 	std::vector<byte> rnd(m_msgDigest->DigestSize());
-	m_msgDigest->Compute(e, rnd);
+	m_msgDigest->Compute(E, rnd);
 
 	// create the intermediate key from the output hash
-	std::vector<byte> key(keySizes.KeySize());
+	std::vector<byte> key(KeySizes.KeySize());
 	std::memcpy(&key[0], &rnd[0], key.size());
-	std::vector<byte> nonce(keySizes.NonceSize());
-	std::memcpy(&nonce[0], &rnd[key.size()], keySizes.NonceSize());
-	std::vector<byte> tag(keySizes.InfoSize());
-	std::memcpy(&tag[0], &rnd[key.size() + keySizes.NonceSize()], keySizes.InfoSize());
+	std::vector<byte> nonce(KeySizes.NonceSize());
+	std::memcpy(&nonce[0], &rnd[key.size()], KeySizes.NonceSize());
+	std::vector<byte> tag(KeySizes.InfoSize());
+	std::memcpy(&tag[0], &rnd[key.size() + KeySizes.NonceSize()], KeySizes.InfoSize());
 
 	// encrypt the message, add it to the ciphertext with the auth-code
 	Key::Symmetric::SymmetricKey kp(key, nonce, tag);
 	m_cprMode->Initialize(true, kp);
-	m_cprMode->Transform(Message, 0, CipherText, CipherText.size() - (Message.size() + keySizes.InfoSize()), Message.size());
-	m_cprMode->Finalize(CipherText, CipherText.size() - keySizes.InfoSize(), keySizes.InfoSize());
+	m_cprMode->Transform(Message, 0, CipherText, CipherText.size() - (Message.size() + KeySizes.InfoSize()), Message.size());
+	m_cprMode->Finalize(CipherText, CipherText.size() - KeySizes.InfoSize(), KeySizes.InfoSize());
 }
 
 void McEliece::Scope()
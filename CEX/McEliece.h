@@ -225,6 +225,17 @@ public:
 	/// <returns>The encrypted message</returns>
 	std::vector<byte> Encrypt(const std::vector<byte> &Message) override;
 
+	/// <summary>
+	/// Encrypt a set of shared secrets to the initialized public key, and return the encrypted messages.
+	/// <para>The syndromes are computed as a single GF(2) matrix product, streaming the public key once for every 256 messages,
+	/// rather than once per message; each output decrypts the same as one produced by Encrypt(Message).</para>
+	/// </summary>
+	/// 
+	/// <param name="Messages">The shared secret arrays</param>
+	/// 
+	/// <returns>The encrypted messages, in the order of the input</returns>
+	std::vector<std::vector<byte>> Encrypt(const std::vector<std::vector<byte>> &Messages);
+
 	/// <summary>
 	/// Generate a public/private key-pair
 	/// </summary>
@@ -244,6 +255,9 @@ private:
 
 	bool MPKCDecrypt(const std::vector<byte> &CipherText, std::vector<byte> &Message);
 	void MPKCEncrypt(const std::vector<byte> &Message, std::vector<byte> &CipherText);
+	void MPKCEncrypt(const std::vector<std::vector<byte>> &Messages, std::vector<std::vector<byte>> &CipherTexts);
+	Key::Symmetric::SymmetricKeySize MPKCKeySize();
+	void MPKCSeal(const std::vector<byte> &Message, const std::vector<byte> &E, std::vector<byte> &CipherText, Key::Symmetric::SymmetricKeySize &KeySizes);
 	void Scope();
 };
 
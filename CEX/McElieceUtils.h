@@ -277,217 +277,220 @@ public:
 	template<typename ArrayA, typename ArrayB>
 	static void Multiply(ArrayA &Output, ArrayA &A, const ArrayB &B)
 	{
-		ulong t1 = A[11] & B[11];
-		ulong t2 = A[11] & B[9];
-		ulong t3 = A[11] & B[10];
-		ulong t4 = A[9] & B[11];
-		ulong t5 = A[10] & B[11];
-		ulong t6 = A[10] & B[10];
-		ulong t7 = A[10] & B[9];
-		ulong t8 = A[9] & B[10];
-		ulong t9 = A[9] & B[9];
-		ulong t10 = t8 ^ t7;
-		ulong t11 = t6 ^ t4;
-		ulong t12 = t11 ^ t2;
-		ulong t13 = t5 ^ t3;
-		ulong t14 = A[8] & B[8];
-		ulong t15 = A[8] & B[6];
-		ulong t16 = A[8] & B[7];
-		ulong t17 = A[6] & B[8];
-		ulong t18 = A[7] & B[8];
-		ulong t19 = A[7] & B[7];
-		ulong t20 = A[7] & B[6];
-		ulong t21 = A[6] & B[7];
-		ulong t22 = A[6] & B[6];
-		ulong t23 = t21 ^ t20;
-		ulong t24 = t19 ^ t17;
-		ulong t25 = t24 ^ t15;
-		ulong t26 = t18 ^ t16;
-		ulong t27 = A[5] & B[5];
-		ulong t28 = A[5] & B[3];
-		ulong t29 = A[5] & B[4];
-		ulong t30 = A[3] & B[5];
-		ulong t31 = A[4] & B[5];
-		ulong t32 = A[4] & B[4];
-		ulong t33 = A[4] & B[3];
-		ulong t34 = A[3] & B[4];
-		ulong t35 = A[3] & B[3];
-		ulong t36 = t34 ^ t33;
-		ulong t37 = t32 ^ t30;
-		ulong t38 = t37 ^ t28;
-		ulong t39 = t31 ^ t29;
-		ulong t40 = A[2] & B[2];
-		ulong t41 = A[2] & B[0];
-		ulong t42 = A[2] & B[1];
-		ulong t43 = A[0] & B[2];
-		ulong t44 = A[1] & B[2];
-		ulong t45 = A[1] & B[1];
-		ulong t46 = A[1] & B[0];
-		ulong t47 = A[0] & B[1];
-		ulong t48 = A[0] & B[0];
-		ulong t49 = t47 ^ t46;
-		ulong t50 = t45 ^ t43;
-		ulong t51 = t50 ^ t41;
-		ulong t52 = t44 ^ t42;
-		ulong t53 = t52 ^ t35;
-		ulong t54 = t40 ^ t36;
-		ulong t55 = t39 ^ t22;
-		ulong t56 = t27 ^ t23;
-		ulong t57 = t26 ^ t9;
-		ulong t58 = t14 ^ t10;
-		ulong t59 = B[6] ^ B[9];
-		ulong t60 = B[7] ^ B[10];
-		ulong t61 = B[8] ^ B[11];
-		ulong t62 = A[6] ^ A[9];
-		ulong t63 = A[7] ^ A[10];
-		ulong t64 = A[8] ^ A[11];
-		ulong t65 = t64 & t61;
-		ulong t66 = t64 & t59;
-		ulong t67 = t64 & t60;
-		ulong t68 = t62 & t61;
-		ulong t69 = t63 & t61;
-		ulong t70 = t63 & t60;
-		ulong t71 = t63 & t59;
-		ulong t72 = t62 & t60;
-		ulong t73 = t62 & t59;
-		ulong t74 = t72 ^ t71;
-		ulong t75 = t70 ^ t68;
-		ulong t76 = t75 ^ t66;
-		ulong t77 = t69 ^ t67;
-		ulong t78 = B[0] ^ B[3];
-		ulong t79 = B[1] ^ B[4];
-		ulong t80 = B[2] ^ B[5];
-		ulong t81 = A[0] ^ A[3];
-		ulong t82 = A[1] ^ A[4];
-		ulong t83 = A[2] ^ A[5];
-		ulong t84 = t83 & t80;
-		ulong t85 = t83 & t78;
-		ulong t86 = t83 & t79;
-		ulong t87 = t81 & t80;
-		ulong t88 = t82 & t80;
-		ulong t89 = t82 & t79;
-		ulong t90 = t82 & t78;
-		ulong t91 = t81 & t79;
-		ulong t92 = t81 & t78;
-		ulong t93 = t91 ^ t90;
-		ulong t94 = t89 ^ t87;
-		ulong t95 = t94 ^ t85;
-		ulong t96 = t88 ^ t86;
-		ulong t97 = t53 ^ t48;
-		ulong t98 = t54 ^ t49;
-		ulong t99 = t38 ^ t51;
-		ulong t100 = t55 ^ t53;
-		ulong t101 = t56 ^ t54;
-		ulong t102 = t25 ^ t38;
-		ulong t103 = t57 ^ t55;
-		ulong t104 = t58 ^ t56;
-		ulong t105 = t12 ^ t25;
-		ulong t106 = t13 ^ t57;
-		ulong t107 = t1 ^ t58;
-		ulong t108 = t97 ^ t92;
-		ulong t109 = t98 ^ t93;
-		ulong t110 = t99 ^ t95;
-		ulong t111 = t100 ^ t96;
-		ulong t112 = t101 ^ t84;
-		ulong t113 = t103 ^ t73;
-		ulong t114 = t104 ^ t74;
-		ulong t115 = t105 ^ t76;
-		ulong t116 = t106 ^ t77;
-		ulong t117 = t107 ^ t65;
-		ulong t118 = B[3] ^ B[9];
-		ulong t119 = B[4] ^ B[10];
-		ulong t120 = B[5] ^ B[11];
-		ulong t121 = B[0] ^ B[6];
-		ulong t122 = B[1] ^ B[7];
-		ulong t123 = B[2] ^ B[8];
-		ulong t124 = A[3] ^ A[9];
-		ulong t125 = A[4] ^ A[10];
-		ulong t126 = A[5] ^ A[11];
-		ulong t127 = A[0] ^ A[6];
-		ulong t128 = A[1] ^ A[7];
-		ulong t129 = A[2] ^ A[8];
-		ulong t130 = t129 & t123;
-		ulong t131 = t129 & t121;
-		ulong t132 = t129 & t122;
-		ulong t133 = t127 & t123;
-		ulong t134 = t128 & t123;
-		ulong t135 = t128 & t122;
-		ulong t136 = t128 & t121;
-		ulong t137 = t127 & t122;
-		ulong t138 = t127 & t121;
-		ulong t139 = t137 ^ t136;
-		ulong t140 = t135 ^ t133;
-		ulong t141 = t140 ^ t131;
-		ulong t142 = t134 ^ t132;
-		ulong t143 = t126 & t120;
-		ulong t144 = t126 & t118;
-		ulong t145 = t126 & t119;
-		ulong t146 = t124 & t120;
-		ulong t147 = t125 & t120;
-		ulong t148 = t125 & t119;
-		ulong t149 = t125 & t118;
-		ulong t150 = t124 & t119;
-		ulong t151 = t124 & t118;
-		ulong t152 = t150 ^ t149;
-		ulong t153 = t148 ^ t146;
-		ulong t154 = t153 ^ t144;
-		ulong t155 = t147 ^ t145;
-		ulong t156 = t121 ^ t118;
-		ulong t157 = t122 ^ t119;
-		ulong t158 = t123 ^ t120;
-		ulong t159 = t127 ^ t124;
-		ulong t160 = t128 ^ t125;
-		ulong t161 = t129 ^ t126;
-		ulong t162 = t161 & t158;
-		ulong t163 = t161 & t156;
-		ulong t164 = t161 & t157;
-		ulong t165 = t159 & t158;
-		ulong t166 = t160 & t158;
-		ulong t167 = t160 & t157;
-		ulong t168 = t160 & t156;
-		ulong t169 = t159 & t157;
-		ulong t170 = t159 & t156;
-		ulong t171 = t169 ^ t168;
-		ulong t172 = t167 ^ t165;
-		ulong t173 = t172 ^ t163;
-		ulong t174 = t166 ^ t164;
-		ulong t175 = t142 ^ t151;
-		ulong t176 = t130 ^ t152;
-		ulong t177 = t170 ^ t175;
-		ulong t178 = t171 ^ t176;
-		ulong t179 = t173 ^ t154;
-		ulong t180 = t174 ^ t155;
-		ulong t181 = t162 ^ t143;
-		ulong t182 = t177 ^ t138;
-		ulong t183 = t178 ^ t139;
-		ulong t184 = t179 ^ t141;
-		ulong t185 = t180 ^ t175;
-		ulong t186 = t181 ^ t176;
-		ulong t187 = t111 ^ t48;
-		ulong t188 = t112 ^ t49;
-		ulong t189 = t102 ^ t51;
-		ulong t190 = t113 ^ t108;
-		ulong t191 = t114 ^ t109;
-		ulong t192 = t115 ^ t110;
-		ulong t193 = t116 ^ t111;
-		ulong t194 = t117 ^ t112;
-		ulong t195 = t12 ^ t102;
-		ulong t196 = t13 ^ t113;
-		ulong t197 = t1 ^ t114;
-		ulong t198 = t187 ^ t138;
-		ulong t199 = t188 ^ t139;
-		ulong t200 = t189 ^ t141;
-		ulong t201 = t190 ^ t182;
-		ulong t202 = t191 ^ t183;
-		ulong t203 = t192 ^ t184;
-		ulong t204 = t193 ^ t185;
-		ulong t205 = t194 ^ t186;
-		ulong t206 = t195 ^ t154;
-		ulong t207 = t196 ^ t155;
-		ulong t208 = t197 ^ t143;
-
-		const size_t OUTSZE = Output.size();
-		std::vector<ulong> sum(2 * OUTSZE - 1);
+		// the bitsliced word; ulong, or a SIMD wrapper that multiplies 64 field elements per 64bit lane
+		typedef typename ArrayA::value_type Word;
+
+		Word t1 = A[11] & B[11];
+		Word t2 = A[11] & B[9];
+		Word t3 = A[11] & B[10];
+		Word t4 = A[9] & B[11];
+		Word t5 = A[10] & B[11];
+		Word t6 = A[10] & B[10];
+		Word t7 = A[10] & B[9];
+		Word t8 = A[9] & B[10];
+		Word t9 = A[9] & B[9];
+		Word t10 = t8 ^ t7;
+		Word t11 = t6 ^ t4;
+		Word t12 = t11 ^ t2;
+		Word t13 = t5 ^ t3;
+		Word t14 = A[8] & B[8];
+		Word t15 = A[8] & B[6];
+		Word t16 = A[8] & B[7];
+		Word t17 = A[6] & B[8];
+		Word t18 = A[7] & B[8];
+		Word t19 = A[7] & B[7];
+		Word t20 = A[7] & B[6];
+		Word t21 = A[6] & B[7];
+		Word t22 = A[6] & B[6];
+		Word t23 = t21 ^ t20;
+		Word t24 = t19 ^ t17;
+		Word t25 = t24 ^ t15;
+		Word t26 = t18 ^ t16;
+		Word t27 = A[5] & B[5];
+		Word t28 = A[5] & B[3];
+		Word t29 = A[5] & B[4];
+		Word t30 = A[3] & B[5];
+		Word t31 = A[4] & B[5];
+		Word t32 = A[4] & B[4];
+		Word t33 = A[4] & B[3];
+		Word t34 = A[3] & B[4];
+		Word t35 = A[3] & B[3];
+		Word t36 = t34 ^ t33;
+		Word t37 = t32 ^ t30;
+		Word t38 = t37 ^ t28;
+		Word t39 = t31 ^ t29;
+		Word t40 = A[2] & B[2];
+		Word t41 = A[2] & B[0];
+		Word t42 = A[2] & B[1];
+		Word t43 = A[0] & B[2];
+		Word t44 = A[1] & B[2];
+		Word t45 = A[1] & B[1];
+		Word t46 = A[1] & B[0];
+		Word t47 = A[0] & B[1];
+		Word t48 = A[0] & B[0];
+		Word t49 = t47 ^ t46;
+		Word t50 = t45 ^ t43;
+		Word t51 = t50 ^ t41;
+		Word t52 = t44 ^ t42;
+		Word t53 = t52 ^ t35;
+		Word t54 = t40 ^ t36;
+		Word t55 = t39 ^ t22;
+		Word t56 = t27 ^ t23;
+		Word t57 = t26 ^ t9;
+		Word t58 = t14 ^ t10;
+		Word t59 = B[6] ^ B[9];
+		Word t60 = B[7] ^ B[10];
+		Word t61 = B[8] ^ B[11];
+		Word t62 = A[6] ^ A[9];
+		Word t63 = A[7] ^ A[10];
+		Word t64 = A[8] ^ A[11];
+		Word t65 = t64 & t61;
+		Word t66 = t64 & t59;
+		Word t67 = t64 & t60;
+		Word t68 = t62 & t61;
+		Word t69 = t63 & t61;
+		Word t70 = t63 & t60;
+		Word t71 = t63 & t59;
+		Word t72 = t62 & t60;
+		Word t73 = t62 & t59;
+		Word t74 = t72 ^ t71;
+		Word t75 = t70 ^ t68;
+		Word t76 = t75 ^ t66;
+		Word t77 = t69 ^ t67;
+		Word t78 = B[0] ^ B[3];
+		Word t79 = B[1] ^ B[4];
+		Word t80 = B[2] ^ B[5];
+		Word t81 = A[0] ^ A[3];
+		Word t82 = A[1] ^ A[4];
+		Word t83 = A[2] ^ A[5];
+		Word t84 = t83 & t80;
+		Word t85 = t83 & t78;
+		Word t86 = t83 & t79;
+		Word t87 = t81 & t80;
+		Word t88 = t82 & t80;
+		Word t89 = t82 & t79;
+		Word t90 = t82 & t78;
+		Word t91 = t81 & t79;
+		Word t92 = t81 & t78;
+		Word t93 = t91 ^ t90;
+		Word t94 = t89 ^ t87;
+		Word t95 = t94 ^ t85;
+		Word t96 = t88 ^ t86;
+		Word t97 = t53 ^ t48;
+		Word t98 = t54 ^ t49;
+		Word t99 = t38 ^ t51;
+		Word t100 = t55 ^ t53;
+		Word t101 = t56 ^ t54;
+		Word t102 = t25 ^ t38;
+		Word t103 = t57 ^ t55;
+		Word t104 = t58 ^ t56;
+		Word t105 = t12 ^ t25;
+		Word t106 = t13 ^ t57;
+		Word t107 = t1 ^ t58;
+		Word t108 = t97 ^ t92;
+		Word t109 = t98 ^ t93;
+		Word t110 = t99 ^ t95;
+		Word t111 = t100 ^ t96;
+		Word t112 = t101 ^ t84;
+		Word t113 = t103 ^ t73;
+		Word t114 = t104 ^ t74;
+		Word t115 = t105 ^ t76;
+		Word t116 = t106 ^ t77;
+		Word t117 = t107 ^ t65;
+		Word t118 = B[3] ^ B[9];
+		Word t119 = B[4] ^ B[10];
+		Word t120 = B[5] ^ B[11];
+		Word t121 = B[0] ^ B[6];
+		Word t122 = B[1] ^ B[7];
+		Word t123 = B[2] ^ B[8];
+		Word t124 = A[3] ^ A[9];
+		Word t125 = A[4] ^ A[10];
+		Word t126 = A[5] ^ A[11];
+		Word t127 = A[0] ^ A[6];
+		Word t128 = A[1] ^ A[7];
+		Word t129 = A[2] ^ A[8];
+		Word t130 = t129 & t123;
+		Word t131 = t129 & t121;
+		Word t132 = t129 & t122;
+		Word t133 = t127 & t123;
+		Word t134 = t128 & t123;
+		Word t135 = t128 & t122;
+		Word t136 = t128 & t121;
+		Word t137 = t127 & t122;
+		Word t138 = t127 & t121;
+		Word t139 = t137 ^ t136;
+		Word t140 = t135 ^ t133;
+		Word t141 = t140 ^ t131;
+		Word t142 = t134 ^ t132;
+		Word t143 = t126 & t120;
+		Word t144 = t126 & t118;
+		Word t145 = t126 & t119;
+		Word t146 = t124 & t120;
+		Word t147 = t125 & t120;
+		Word t148 = t125 & t119;
+		Word t149 = t125 & t118;
+		Word t150 = t124 & t119;
+		Word t151 = t124 & t118;
+		Word t152 = t150 ^ t149;
+		Word t153 = t148 ^ t146;
+		Word t154 = t153 ^ t144;
+		Word t155 = t147 ^ t145;
+		Word t156 = t121 ^ t118;
+		Word t157 = t122 ^ t119;
+		Word t158 = t123 ^ t120;
+		Word t159 = t127 ^ t124;
+		Word t160 = t128 ^ t125;
+		Word t161 = t129 ^ t126;
+		Word t162 = t161 & t158;
+		Word t163 = t161 & t156;
+		Word t164 = t161 & t157;
+		Word t165 = t159 & t158;
+		Word t166 = t160 & t158;
+		Word t167 = t160 & t157;
+		Word t168 = t160 & t156;
+		Word t169 = t159 & t157;
+		Word t170 = t159 & t156;
+		Word t171 = t169 ^ t168;
+		Word t172 = t167 ^ t165;
+		Word t173 = t172 ^ t163;
+		Word t174 = t166 ^ t164;
+		Word t175 = t142 ^ t151;
+		Word t176 = t130 ^ t152;
+		Word t177 = t170 ^ t175;
+		Word t178 = t171 ^ t176;
+		Word t179 = t173 ^ t154;
+		Word t180 = t174 ^ t155;
+		Word t181 = t162 ^ t143;
+		Word t182 = t177 ^ t138;
+		Word t183 = t178 ^ t139;
+		Word t184 = t179 ^ t141;
+		Word t185 = t180 ^ t175;
+		Word t186 = t181 ^ t176;
+		Word t187 = t111 ^ t48;
+		Word t188 = t112 ^ t49;
+		Word t189 = t102 ^ t51;
+		Word t190 = t113 ^ t108;
+		Word t191 = t114 ^ t109;
+		Word t192 = t115 ^ t110;
+		Word t193 = t116 ^ t111;
+		Word t194 = t117 ^ t112;
+		Word t195 = t12 ^ t102;
+		Word t196 = t13 ^ t113;
+		Word t197 = t1 ^ t114;
+		Word t198 = t187 ^ t138;
+		Word t199 = t188 ^ t139;
+		Word t200 = t189 ^ t141;
+		Word t201 = t190 ^ t182;
+		Word t202 = t191 ^ t183;
+		Word t203 = t192 ^ t184;
+		Word t204 = t193 ^ t185;
+		Word t205 = t194 ^ t186;
+		Word t206 = t195 ^ t154;
+		Word t207 = t196 ^ t155;
+		Word t208 = t197 ^ t143;
+
+		const size_t OUTSZE = 12;
+		std::array<Word, (2 * OUTSZE) - 1> sum;
 		sum[0] = t48;
 		sum[1] = t49;
 		sum[2] = t51;
@@ -518,7 +521,10 @@ public:
 			sum[i - OUTSZE] ^= sum[i];
 		}
 
-		std::memcpy(&Output[0], &sum[0], OUTSZE * sizeof(ulong));
+		for (size_t i = 0; i < OUTSZE; i++)
+		{
+			Output[i] = sum[i];
+		}
 	}
 
 	template<typename Array>
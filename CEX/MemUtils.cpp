@@ -0,0 +1,304 @@
+#include "MemUtils.h"
+#include "CpuDetect.h"
+
+#if defined(CEX_ARCH_X86_X64)
+#	if defined(CEX_COMPILER_MSC)
+#		include <intrin.h>
+#	endif
+#	include <immintrin.h>
+#	define CEX_MEMUTILS_STREAM
+#endif
+
+// msvc emits any intrinsic regardless of the target architecture; gcc and clang need the instruction set enabled per function
+#if defined(CEX_MEMUTILS_STREAM) && (defined(CEX_COMPILER_GCC) || defined(CEX_COMPILER_CLANG))
+#	define CEX_TARGET_AVX2 __attribute__((target("avx2")))
+#	define CEX_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#	define CEX_TARGET_AVX2
+#	define CEX_TARGET_SSE2
+#endif
+
+NAMESPACE_UTILITY
+
+namespace
+{
+	/*! \cond PRIVATE */
+	// the streaming kernels process one 64 byte cache line per iteration
+	const size_t STREAM_BLOCK = 64;
+	// the input is prefetched this many bytes ahead of the store position
+	const size_t STREAM_PREFETCH = 512;
+
+	enum class StreamKernels : byte
+	{
+		None = 0,
+		SSE2 = 1,
+		AVX2 = 2
+	};
+
+	struct StreamProfile
+	{
+		StreamKernels Kernel;
+		size_t Threshold;
+	};
+
+	StreamProfile Detect()
+	{
+		StreamProfile profile = { StreamKernels::None, 256 * 1024 };
+
+#if defined(CEX_MEMUTILS_STREAM)
+		Common::CpuDetect detect;
+
+		if (detect.AVX2())
+		{
+			profile.Kernel = StreamKernels::AVX2;
+		}
+		else if (detect.SSE2())
+		{
+			profile.Kernel = StreamKernels::SSE2;
+		}
+
+		// a buffer larger than the cores L2 cache would evict the working set of the caller
+		if (detect.L2CacheSize() > profile.Threshold)
+		{
+			profile.Threshold = detect.L2CacheSize();
+		}
+#endif
+
+		return profile;
+	}
+
+	const StreamProfile &Profile()
+	{
+		static const StreamProfile PROFILE = Detect();
+
+		return PROFILE;
+	}
+
+	size_t HeadLength(const void* Output, size_t Length)
+	{
+		// bytes until the destination reaches a 32 byte boundary
+		const size_t HDRLEN = (32 - (reinterpret_cast<size_t>(Output) & 31)) & 31;
+
+		return (HDRLEN < Length) ? HDRLEN : Length;
+	}
+
+#if defined(CEX_MEMUTILS_STREAM)
+	CEX_TARGET_AVX2 void CopyAvx2(const byte* Input, byte* Output, size_t Length)
+	{
+		for (size_t i = 0; i != Length; i += STREAM_BLOCK)
+		{
+			_mm_prefetch(reinterpret_cast<const char*>(Input + i + STREAM_PREFETCH), _MM_HINT_NTA);
+			const __m256i X0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Input + i));
+			const __m256i X1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Input + i + 32));
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(Output + i), X0);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(Output + i + 32), X1);
+		}
+	}
+
+	CEX_TARGET_SSE2 void CopySse2(const byte* Input, byte* Output, size_t Length)
+	{
+		for (size_t i = 0; i != Length; i += STREAM_BLOCK)
+		{
+			_mm_prefetch(reinterpret_cast<const char*>(Input + i + STREAM_PREFETCH), _MM_HINT_NTA);
+
+			for (size_t j = 0; j != STREAM_BLOCK; j += 16)
+			{
+				_mm_stream_si128(reinterpret_cast<__m128i*>(Output + i + j), _mm_loadu_si128(reinterpret_cast<const __m128i*>(Input + i + j)));
+			}
+		}
+	}
+
+	CEX_TARGET_AVX2 void SetAvx2(byte* Output, size_t Length, byte Value)
+	{
+		const __m256i X = _mm256_set1_epi8(static_cast<char>(Value));
+
+		for (size_t i = 0; i != Length; i += STREAM_BLOCK)
+		{
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(Output + i), X);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(Output + i + 32), X);
+		}
+	}
+
+	CEX_TARGET_SSE2 void SetSse2(byte* Output, size_t Length, byte Value)
+	{
+		const __m128i X = _mm_set1_epi8(static_cast<char>(Value));
+
+		for (size_t i = 0; i != Length; i += 16)
+		{
+			_mm_stream_si128(reinterpret_cast<__m128i*>(Output + i), X);
+		}
+	}
+
+	CEX_TARGET_AVX2 void XorAvx2(const byte* Input, byte* Output, size_t Length)
+	{
+		for (size_t i = 0; i != Length; i += STREAM_BLOCK)
+		{
+			_mm_prefetch(reinterpret_cast<const char*>(Input + i + STREAM_PREFETCH), _MM_HINT_NTA);
+			_mm_prefetch(reinterpret_cast<const char*>(Output + i + STREAM_PREFETCH), _MM_HINT_NTA);
+			const __m256i X0 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Input + i)), _mm256_load_si256(reinterpret_cast<const __m256i*>(Output + i)));
+			const __m256i X1 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(Input + i + 32)), _mm256_load_si256(reinterpret_cast<const __m256i*>(Output + i + 32)));
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(Output + i), X0);
+			_mm256_stream_si256(reinterpret_cast<__m256i*>(Output + i + 32), X1);
+		}
+	}
+
+	CEX_TARGET_SSE2 void XorSse2(const byte* Input, byte* Output, size_t Length)
+	{
+		for (size_t i = 0; i != Length; i += STREAM_BLOCK)
+		{
+			_mm_prefetch(reinterpret_cast<const char*>(Input + i + STREAM_PREFETCH), _MM_HINT_NTA);
+			_mm_prefetch(reinterpret_cast<const char*>(Output + i + STREAM_PREFETCH), _MM_HINT_NTA);
+
+			for (size_t j = 0; j != STREAM_BLOCK; j += 16)
+			{
+				const __m128i X = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Input + i + j)), _mm_load_si128(reinterpret_cast<const __m128i*>(Output + i + j)));
+				_mm_stream_si128(reinterpret_cast<__m128i*>(Output + i + j), X);
+			}
+		}
+	}
+#endif
+	/*! \endcond */
+}
+
+//~~~Public Functions~~~//
+
+void MemUtils::CompilerBarrier(const void* Output)
+{
+	// the compiler must assume the cleared memory is read here, so the preceding stores can not be elided
+#if defined(CEX_COMPILER_MSC)
+	_ReadWriteBarrier();
+	static_cast<void>(Output);
+#elif defined(CEX_COMPILER_GCC) || defined(CEX_COMPILER_CLANG) || defined(CEX_COMPILER_MINGW)
+	__asm__ __volatile__("" : : "r"(Output) : "memory");
+#else
+	static volatile const void* barrier;
+	barrier = Output;
+#endif
+}
+
+void MemUtils::StreamCopy(const void* Input, void* Output, size_t Length)
+{
+	const byte* inpPtr = static_cast<const byte*>(Input);
+	byte* outPtr = static_cast<byte*>(Output);
+	const size_t HDRLEN = HeadLength(outPtr, Length);
+
+	std::memcpy(outPtr, inpPtr, HDRLEN);
+	inpPtr += HDRLEN;
+	outPtr += HDRLEN;
+	Length -= HDRLEN;
+
+	const size_t BLKLEN = Length - (Length % STREAM_BLOCK);
+
+	switch (Profile().Kernel)
+	{
+#if defined(CEX_MEMUTILS_STREAM)
+		case StreamKernels::AVX2:
+		{
+			CopyAvx2(inpPtr, outPtr, BLKLEN);
+			_mm_sfence();
+			break;
+		}
+		case StreamKernels::SSE2:
+		{
+			CopySse2(inpPtr, outPtr, BLKLEN);
+			_mm_sfence();
+			break;
+		}
+#endif
+		default:
+		{
+			std::memcpy(outPtr, inpPtr, BLKLEN);
+		}
+	}
+
+	std::memcpy(outPtr + BLKLEN, inpPtr + BLKLEN, Length - BLKLEN);
+}
+
+void MemUtils::StreamSet(void* Output, size_t Length, byte Value)
+{
+	byte* outPtr = static_cast<byte*>(Output);
+	const size_t HDRLEN = HeadLength(outPtr, Length);
+
+	std::memset(outPtr, Value, HDRLEN);
+	outPtr += HDRLEN;
+	Length -= HDRLEN;
+
+	const size_t BLKLEN = Length - (Length % STREAM_BLOCK);
+
+	switch (Profile().Kernel)
+	{
+#if defined(CEX_MEMUTILS_STREAM)
+		case StreamKernels::AVX2:
+		{
+			SetAvx2(outPtr, BLKLEN, Value);
+			_mm_sfence();
+			break;
+		}
+		case StreamKernels::SSE2:
+		{
+			SetSse2(outPtr, BLKLEN, Value);
+			_mm_sfence();
+			break;
+		}
+#endif
+		default:
+		{
+			std::memset(outPtr, Value, BLKLEN);
+		}
+	}
+
+	std::memset(outPtr + BLKLEN, Value, Length - BLKLEN);
+}
+
+const size_t MemUtils::StreamThreshold()
+{
+	return Profile().Threshold;
+}
+
+void MemUtils::StreamXor(const void* Input, void* Output, size_t Length)
+{
+	const byte* inpPtr = static_cast<const byte*>(Input);
+	byte* outPtr = static_cast<byte*>(Output);
+	const size_t HDRLEN = HeadLength(outPtr, Length);
+	size_t i;
+
+	for (i = 0; i != HDRLEN; ++i)
+	{
+		outPtr[i] ^= inpPtr[i];
+	}
+
+	inpPtr += HDRLEN;
+	outPtr += HDRLEN;
+	Length -= HDRLEN;
+
+	size_t blkLen = Length - (Length % STREAM_BLOCK);
+
+	switch (Profile().Kernel)
+	{
+#if defined(CEX_MEMUTILS_STREAM)
+		case StreamKernels::AVX2:
+		{
+			XorAvx2(inpPtr, outPtr, blkLen);
+			_mm_sfence();
+			break;
+		}
+		case StreamKernels::SSE2:
+		{
+			XorSse2(inpPtr, outPtr, blkLen);
+			_mm_sfence();
+			break;
+		}
+#endif
+		default:
+		{
+			blkLen = 0;
+		}
+	}
+
+	for (i = blkLen; i != Length; ++i)
+	{
+		outPtr[i] ^= inpPtr[i];
+	}
+}
+
+NAMESPACE_UTILITYEND
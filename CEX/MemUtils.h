@@ -40,10 +40,16 @@ NAMESPACE_UTILITY
 /// The standard functions Copy, Clear, SetValue, and XorBlock, use intrinsics calls when the input/output size to that function is at least the size of the minimum available SIMD instruction set.
 /// For example, XorBlock will loop through an array, and process with the largest available instruction set first. 
 /// If the input/output size is a multiple of 32 bytes, the blocks will be processed by AVX2 until the remainder is less than a complete block, 
-/// then it will fall back to AVX or sequential processing.</para>
+/// then it will fall back to AVX or sequential processing. \n
+/// Buffers larger than StreamThreshold() (the larger of 256KiB and the L2 cache size of a core) are processed by the Stream functions instead;
+/// these select an SSE2 or AVX2 kernel at runtime, prefetch the input, and write the output with non-temporal stores, so that a bulk copy, clear or XOR does not evict the round keys and tables of the caller from the cache.</para>
 /// </remarks>
 class MemUtils
 {
+private:
+
+	static const size_t STREAM_MINSIZE = 256 * 1024;
+
 public:
 
 #if defined(__AVX__)
@@ -98,6 +104,12 @@ public:
 		CexAssert((Output.size() - Offset) * ELMSZE >= Length, "Length is larger than output capacity");
 		CexAssert(ELMSZE <= Length, "Integer type is larger than length");
 
+		if (Length >= STREAM_MINSIZE && Length >= StreamThreshold())
+		{
+			StreamSet(&Output[Offset], Length, 0);
+			return;
+		}
+
 		size_t prcCtr = 0;
 
 #if defined(__AVX__)
@@ -186,6 +198,14 @@ public:
 #endif
 	}
 
+	/// <summary>
+	/// Prevent the compiler from removing the stores to a block of memory that is not read again.
+	/// <para>The compiler must assume the memory pointed to by Output is read by this function.</para>
+	/// </summary>
+	/// 
+	/// <param name="Output">A pointer to the cleared memory</param>
+	static void CompilerBarrier(const void* Output);
+
 	/// <summary>
 	/// Compare two arrays for equality.
 	/// <para>This is a constant time (not vectorized) function.</para>
@@ -199,8 +219,8 @@ public:
 	template<typename Array>
 	inline static bool Compare(const Array &A, size_t AOffset, const Array &B, size_t BOffset, size_t Elements)
 	{
-		CexAssert((A.size() - AOffset) >= Length, "Length is larger than A size");
-		CexAssert((B.size() - BOffset) >= Length, "Length is larger than B size");
+		CexAssert((A.size() - AOffset) >= Elements, "Length is larger than A size");
+		CexAssert((B.size() - BOffset) >= Elements, "Length is larger than B size");
 
 		size_t diff = 0;
 
@@ -275,6 +295,12 @@ public:
 		CexAssert((Input.size() - InOffset) * ELMSZE >= Length, "Length is larger than input capacity");
 		CexAssert((Output.size() - OutOffset) * ELMSZE >= Length, "Length is larger than output capacity");
 
+		if (Length >= STREAM_MINSIZE && Length >= StreamThreshold())
+		{
+			StreamCopy(&Input[InOffset], &Output[OutOffset], Length);
+			return;
+		}
+
 		size_t prcCtr = 0;
 
 #if defined(__AVX__)
@@ -337,6 +363,12 @@ public:
 		CexAssert((Output.size() - OutOffset) * OUTSZE >= Length, "Length is larger than output capacity");
 		CexAssert(INPSZE <= 16 && OUTSZE <= 16, "Integer type is larger than 128 bits");
 
+		if (Length >= STREAM_MINSIZE && Length >= StreamThreshold())
+		{
+			StreamCopy(&Input[InOffset], &Output[OutOffset], Length);
+			return;
+		}
+
 #if defined(__AVX512__)
 		const size_t SMDBLK = 64;
 #elif defined(__AVX2__)
@@ -456,6 +488,35 @@ public:
 		std::memmove(&Output[OutOffset], &Input[InOffset], Length);
 	}
 
+	/// <summary>
+	/// Securely erase bytes from an integer array.
+	/// <para>The Length is the number of *bytes* (8 bit integers) to erase.
+	/// The memory is zeroed (with non-temporal stores if the length is at least StreamThreshold() bytes), followed by a compiler barrier, so that the erasure can not be removed as a dead store.</para>
+	/// </summary>
+	/// 
+	/// <param name="Output">The destination integer array to erase</param>
+	/// <param name="Offset">The offset within the destination array</param>
+	/// <param name="Length">The number of bytes to erase</param>
+	template <typename Array>
+	inline static void SecureErase(Array &Output, size_t Offset, size_t Length)
+	{
+		if (Length == 0)
+		{
+			return;
+		}
+
+		if (Length >= STREAM_MINSIZE && Length >= StreamThreshold())
+		{
+			StreamSet(&Output[Offset], Length, 0);
+		}
+		else
+		{
+			std::memset(&Output[Offset], 0, Length);
+		}
+
+		CompilerBarrier(&Output[Offset]);
+	}
+
 	/// <summary>
 	/// Set memory to a fixed value.
 	/// <para>The Length is the number of *bytes* (8 bit integers) to Set.
@@ -480,6 +541,12 @@ public:
 		CexAssert((Output.size() - Offset) * ELMSZE >= Length, "Length is larger than output capacity");
 		CexAssert(ELMSZE <= Length, "Integer type is larger than length");
 
+		if (Length >= STREAM_MINSIZE && Length >= StreamThreshold())
+		{
+			StreamSet(&Output[Offset], Length, Value);
+			return;
+		}
+
 		size_t prcCtr = 0;
 
 #if defined(__AVX__)
@@ -577,6 +644,46 @@ public:
 #endif
 	}
 
+	/// <summary>
+	/// Copy a large block of memory with non-temporal stores.
+	/// <para>The input is prefetched ahead of the copy, and the output is written around the cache; the kernel (SSE2 or AVX2) is selected at runtime.
+	/// Called by Copy() when the length is at least StreamThreshold() bytes.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the source memory</param>
+	/// <param name="Output">A pointer to the destination memory; must not overlap the source</param>
+	/// <param name="Length">The number of bytes to copy</param>
+	static void StreamCopy(const void* Input, void* Output, size_t Length);
+
+	/// <summary>
+	/// Set a large block of memory to a fixed value with non-temporal stores.
+	/// <para>The kernel (SSE2 or AVX2) is selected at runtime. Called by Clear() and SetValue() when the length is at least StreamThreshold() bytes.</para>
+	/// </summary>
+	/// 
+	/// <param name="Output">A pointer to the destination memory</param>
+	/// <param name="Length">The number of bytes to set</param>
+	/// <param name="Value">The 8 bit byte value to set</param>
+	static void StreamSet(void* Output, size_t Length, byte Value);
+
+	/// <summary>
+	/// The byte length at which the Copy, Clear, SetValue and XorBlock functions switch to the non-temporal Stream functions.
+	/// <para>The larger of 256KiB and the L2 cache size of a processor core; detected once at runtime.</para>
+	/// </summary>
+	/// 
+	/// <returns>The threshold length in bytes</returns>
+	static const size_t StreamThreshold();
+
+	/// <summary>
+	/// XOR a large block of memory with non-temporal stores.
+	/// <para>Both arrays are prefetched ahead of the operation, and the output is written around the cache; the kernel (SSE2 or AVX2) is selected at runtime.
+	/// Called by XorBlock() when the length is at least StreamThreshold() bytes.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">A pointer to the source memory</param>
+	/// <param name="Output">A pointer to the destination memory</param>
+	/// <param name="Length">The number of bytes to process</param>
+	static void StreamXor(const void* Input, void* Output, size_t Length);
+
 	/// <summary>
 	/// Block XOR a specified number of 8 bit bytes to process.
 	/// <para>The Length is the number of *bytes* (8 bit integers) to XOR.
@@ -599,6 +706,12 @@ public:
 		CexAssert(Length > 0, "Length can not be zero");
 		CexAssert(ELMSZE <= Length, "Integer type is larger than length");
 
+		if (Length >= STREAM_MINSIZE && Length >= StreamThreshold())
+		{
+			StreamXor(&Input[InOffset], &Output[OutOffset], Length);
+			return;
+		}
+
 		size_t prcCtr = 0;
 
 #if defined(__AVX__)
@@ -0,0 +1,80 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_MEMORYSEGMENT_H
+#define CEX_MEMORYSEGMENT_H
+
+#include "CexDomain.h"
+
+NAMESPACE_COMMON
+
+/// <summary>
+/// A read-only fragment of a message; one element of a scatter-gather list.
+/// <para>The segment does not own its array, which must remain valid for the duration of the call that consumes it.
+/// A list of segments is processed as a single contiguous message, in list order.</para>
+/// </summary>
+struct MemorySegment
+{
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// The array containing the fragment
+	/// </summary>
+	const std::vector<byte>* Data;
+
+	/// <summary>
+	/// The number of bytes in the fragment
+	/// </summary>
+	size_t Length;
+
+	/// <summary>
+	/// The starting offset of the fragment within the array
+	/// </summary>
+	size_t Offset;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// An empty segment
+	/// </summary>
+	MemorySegment()
+		:
+		Data(nullptr),
+		Length(0),
+		Offset(0)
+	{
+	}
+
+	/// <summary>
+	/// Initialize the segment
+	/// </summary>
+	///
+	/// <param name="Data">The array containing the fragment</param>
+	/// <param name="Offset">The starting offset of the fragment within the array</param>
+	/// <param name="Length">The number of bytes in the fragment</param>
+	MemorySegment(const std::vector<byte> &Data, size_t Offset, size_t Length)
+		:
+		Data(&Data),
+		Length(Length),
+		Offset(Offset)
+	{
+	}
+};
+
+NAMESPACE_COMMONEND
+#endif
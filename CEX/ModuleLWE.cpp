@@ -0,0 +1,367 @@
+#include "ModuleLWE.h"
+#include "GCM.h"
+#include "IntUtils.h"
+#include "Keccak512.h"
+#include "Keccak1024.h"
+#include "MemUtils.h"
+#include "MLWEQ3329N256.h"
+#include "PrngFromName.h"
+#include "SymmetricKey.h"
+
+NAMESPACE_MODULELWE
+
+const std::string ModuleLWE::CLASS_NAME = "ModuleLWE";
+
+//~~~Properties~~~//
+
+const AsymmetricEngines ModuleLWE::Enumeral()
+{
+	return AsymmetricEngines::ModuleLWE;
+}
+
+const bool ModuleLWE::IsEncryption()
+{
+	return m_isEncryption;
+}
+
+const bool ModuleLWE::IsInitialized()
+{
+	return m_isInitialized;
+}
+
+const std::string ModuleLWE::Name()
+{
+	return CLASS_NAME + "-Q" + Utility::IntUtils::ToString(m_paramSet.Q) + "N" + Utility::IntUtils::ToString(m_paramSet.N) + "K" + Utility::IntUtils::ToString(m_paramSet.K);
+}
+
+const MLWEParamSet &ModuleLWE::ParamSet()
+{
+	return m_paramSet;
+}
+
+const MLWEParams ModuleLWE::Parameters()
+{
+	return m_mlweParameters;
+}
+
+std::vector<byte> &ModuleLWE::Tag()
+{
+	return m_keyTag;
+}
+
+//~~~Constructor~~~//
+
+ModuleLWE::ModuleLWE(MLWEParams Parameters, Prngs PrngType, BlockCiphers CipherType, bool Parallel)
+	:
+	m_cprMode(new Symmetric::Block::Mode::GCM(CipherType)),
+	m_destroyEngine(true),
+	m_isDestroyed(false),
+	m_isEncryption(false),
+	m_isInitialized(false),
+	m_isParallel(Parallel),
+	m_keyTag(0),
+	m_mlweParameters(Parameters),
+	m_msgDigest(static_cast<byte>(CipherType) > static_cast<byte>(BlockCiphers::Twofish) ? (IDigest*)new Digest::Keccak1024() : (IDigest*)new Digest::Keccak512()),
+	m_paramSet(),
+	m_rndGenerator(Helper::PrngFromName::GetInstance(PrngType))
+{
+	if (m_mlweParameters == MLWEParams::None)
+	{
+		throw CryptoAsymmetricException("ModuleLWE:CTor", "The parameter set is invalid!");
+	}
+
+	Scope();
+}
+
+ModuleLWE::ModuleLWE(MLWEParams Parameters, IPrng* Prng, IBlockCipher* Cipher, bool Parallel)
+	:
+	m_cprMode(new Symmetric::Block::Mode::GCM(Cipher)),
+	m_destroyEngine(false),
+	m_isDestroyed(false),
+	m_isEncryption(false),
+	m_isInitialized(false),
+	m_isParallel(Parallel),
+	m_keyTag(0),
+	m_mlweParameters(Parameters),
+	m_msgDigest(static_cast<byte>(Cipher->Enumeral()) > static_cast<byte>(BlockCiphers::Twofish) ? (IDigest*)new Digest::Keccak1024() : (IDigest*)new Digest::Keccak512()),
+	m_paramSet(),
+	m_rndGenerator(Prng)
+{
+	if (m_mlweParameters == MLWEParams::None)
+	{
+		throw CryptoAsymmetricException("ModuleLWE:CTor", "The parameter set is invalid!");
+	}
+	if (Cipher->KdfEngine() == Digests::Keccak256 || Cipher->KdfEngine() == Digests::Keccak1024 || Cipher->KdfEngine() == Digests::Skein1024)
+	{
+		throw CryptoAsymmetricException("ModuleLWE:CTor", "Keccak256, Keccak1024, and Skein1024 are not supported HX cipher kdf engines!");
+	}
+	if (m_cprMode == nullptr)
+	{
+		throw CryptoAsymmetricException("ModuleLWE:CTor", "The block cipher can not be null!");
+	}
+	if (m_rndGenerator == nullptr)
+	{
+		throw CryptoAsymmetricException("ModuleLWE:CTor", "The prng can not be null!");
+	}
+
+	Scope();
+}
+
+ModuleLWE::~ModuleLWE()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+std::vector<byte> ModuleLWE::Decrypt(const std::vector<byte> &CipherText)
+{
+	if (!m_isInitialized || m_isEncryption)
+	{
+		throw CryptoAsymmetricException("ModuleLWE:Decrypt", "The cipher has not been initialized for decryption!");
+	}
+	if (CipherText.size() < m_paramSet.CipherTextSize)
+	{
+		throw CryptoAsymmetricException("ModuleLWE:Decrypt", "The input message is too small!");
+	}
+
+	std::vector<byte> cpt(m_paramSet.CipherTextSize);
+	std::vector<byte> secret(m_paramSet.SecretSize);
+	std::vector<byte> msg(0);
+
+	// decapsulate the shared secret used to key GCM; a tampered cipher-text yields an unrelated secret
+	Utility::MemUtils::Copy(CipherText, 0, cpt, 0, cpt.size());
+	MLWEQ3329N256::Decrypt(secret, cpt, m_privateKey->S(), m_paramSet);
+
+	if (!MLWEDecrypt(CipherText, msg, secret))
+	{
+		throw CryptoAuthenticationFailure("ModuleLWE:Decrypt", "Decryption authentication failure!");
+	}
+
+	return msg;
+}
+
+void ModuleLWE::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_isEncryption = false;
+		m_isInitialized = false;
+		m_isParallel = false;
+		m_mlweParameters = MLWEParams::None;
+		m_paramSet.Reset();
+		Utility::IntUtils::ClearVector(m_keyTag);
+
+		// release keys
+		if (m_privateKey != nullptr)
+		{
+			m_privateKey.release();
+		}
+		if (m_publicKey != nullptr)
+		{
+			m_publicKey.release();
+		}
+		// destroy the persistant hash function
+		if (m_msgDigest != nullptr)
+		{
+			m_msgDigest.reset(nullptr);
+		}
+		// destroy the mode
+		if (m_cprMode != nullptr)
+		{
+			m_cprMode.reset(nullptr);
+		}
+
+		if (m_destroyEngine)
+		{
+			// destroy internally generated objects
+			m_rndGenerator.reset(nullptr);
+			m_destroyEngine = false;
+		}
+		else
+		{
+			// release the generator (received through ctor2) back to caller
+			m_rndGenerator.release();
+		}
+	}
+}
+
+std::vector<byte> ModuleLWE::Encrypt(const std::vector<byte> &Message)
+{
+	if (!m_isInitialized || !m_isEncryption)
+	{
+		throw CryptoAsymmetricException("ModuleLWE:Encrypt", "The cipher has not been initialized for encryption!");
+	}
+
+	std::vector<byte> cpt(0);
+	std::vector<byte> secret(0);
+
+	// encapsulate a new shared secret, then use it to key GCM and encrypt the message
+	MLWEQ3329N256::Encrypt(secret, cpt, m_publicKey->P(), m_rndGenerator, m_paramSet);
+	MLWEEncrypt(Message, cpt, secret);
+
+	return cpt;
+}
+
+IAsymmetricKeyPair* ModuleLWE::Generate()
+{
+	CexAssert(m_mlweParameters != MLWEParams::None, "The parameter setting is invalid");
+
+	std::vector<byte> pk(0);
+	std::vector<byte> sk(0);
+
+	MLWEQ3329N256::Generate(pk, sk, m_rndGenerator, m_paramSet);
+
+	Key::Asymmetric::MLWEPublicKey* pubK = new Key::Asymmetric::MLWEPublicKey(m_mlweParameters, pk);
+	Key::Asymmetric::MLWEPrivateKey* priK = new Key::Asymmetric::MLWEPrivateKey(m_mlweParameters, sk);
+	Utility::IntUtils::ClearVector(sk);
+
+	return new Key::Asymmetric::MLWEKeyPair(priK, pubK, m_keyTag);
+}
+
+void ModuleLWE::Initialize(bool Encryption, IAsymmetricKeyPair* KeyPair)
+{
+	if (Encryption == false && KeyPair->PrivateKey() == nullptr)
+	{
+		throw CryptoAsymmetricException("ModuleLWE:Initialize", "Decryption requires a valid private key");
+	}
+	if (Encryption == true && KeyPair->PublicKey() == nullptr)
+	{
+		throw CryptoAsymmetricException("ModuleLWE:Initialize", "Encryption requires a valid public key!");
+	}
+
+	m_keyTag = KeyPair->Tag();
+
+	// the keys are owned by the caller
+	if (m_privateKey != nullptr)
+	{
+		m_privateKey.release();
+	}
+	if (m_publicKey != nullptr)
+	{
+		m_publicKey.release();
+	}
+
+	if (Encryption)
+	{
+		MLWEPublicKey* pubK = (MLWEPublicKey*)KeyPair->PublicKey();
+
+		if (pubK->Parameters() != m_mlweParameters || pubK->P().size() != m_paramSet.PublicKeySize)
+		{
+			throw CryptoAsymmetricException("ModuleLWE:Initialize", "The public key does not match the parameter set!");
+		}
+
+		m_publicKey = std::unique_ptr<MLWEPublicKey>(pubK);
+	}
+	else
+	{
+		MLWEPrivateKey* priK = (MLWEPrivateKey*)KeyPair->PrivateKey();
+
+		if (priK->Parameters() != m_mlweParameters || priK->S().size() != m_paramSet.PrivateKeySize)
+		{
+			throw CryptoAsymmetricException("ModuleLWE:Initialize", "The private key does not match the parameter set!");
+		}
+
+		m_privateKey = std::unique_ptr<MLWEPrivateKey>(priK);
+	}
+
+	m_isEncryption = Encryption;
+	m_isInitialized = true;
+}
+
+//~~~Private Functions~~~//
+
+bool ModuleLWE::MLWEDecrypt(const std::vector<byte> &CipherText, std::vector<byte> &Message, std::vector<byte> &Secret)
+{
+	Key::Symmetric::SymmetricKeySize keySizes;
+
+	if (static_cast<byte>(m_cprMode->Engine()->Enumeral()) < static_cast<byte>(BlockCiphers::AHX))
+	{
+		keySizes = m_cprMode->LegalKeySizes()[2];
+	}
+	else
+	{
+		keySizes = m_cprMode->LegalKeySizes()[1];
+	}
+
+	if (CipherText.size() < m_paramSet.CipherTextSize + keySizes.InfoSize())
+	{
+		return false;
+	}
+
+	// hash the encapsulated secret to create the intermediate key
+	m_msgDigest->Update(Secret, 0, Secret.size());
+	Secret.resize(m_msgDigest->DigestSize());
+	m_msgDigest->Finalize(Secret, 0);
+
+	// HX ciphers get keccak1024 and 512 bits of key, standard 256 bit key
+	Message.resize(CipherText.size() - (m_paramSet.CipherTextSize + keySizes.InfoSize()));
+	std::vector<byte> key(keySizes.KeySize());
+	std::memcpy(&key[0], &Secret[0], key.size());
+	std::vector<byte> nonce(keySizes.NonceSize());
+	std::memcpy(&nonce[0], &Secret[key.size()], keySizes.NonceSize());
+	std::vector<byte> tag(keySizes.InfoSize());
+	std::memcpy(&tag[0], &Secret[key.size() + keySizes.NonceSize()], keySizes.InfoSize());
+	Utility::IntUtils::ClearVector(Secret);
+
+	// decrypt the message and authenticate
+	Key::Symmetric::SymmetricKey kp(key, nonce, tag);
+	m_cprMode->Initialize(false, kp);
+	m_cprMode->Transform(CipherText, m_paramSet.CipherTextSize, Message, 0, Message.size());
+	Utility::IntUtils::ClearVector(key);
+
+	if (m_cprMode->Verify(CipherText, CipherText.size() - keySizes.InfoSize(), keySizes.InfoSize()))
+	{
+		return true;
+	}
+
+	Utility::IntUtils::ClearVector(Message);
+
+	return false;
+}
+
+void ModuleLWE::MLWEEncrypt(const std::vector<byte> &Message, std::vector<byte> &CipherText, std::vector<byte> &Secret)
+{
+	Key::Symmetric::SymmetricKeySize keySizes;
+
+	if (static_cast<byte>(m_cprMode->Engine()->Enumeral()) < static_cast<byte>(BlockCiphers::AHX))
+	{
+		// standard ciphers use keccak512 key compression and a 256bit key
+		keySizes = m_cprMode->LegalKeySizes()[2];
+	}
+	else
+	{
+		// HX ciphers use keccak1024 and a 512bit key
+		keySizes = m_cprMode->LegalKeySizes()[1];
+	}
+
+	// hash the encapsulated secret to create the intermediate key
+	m_msgDigest->Update(Secret, 0, Secret.size());
+	Secret.resize(m_msgDigest->DigestSize());
+	m_msgDigest->Finalize(Secret, 0);
+
+	// load the key
+	std::vector<byte> key(keySizes.KeySize());
+	std::memcpy(&key[0], &Secret[0], key.size());
+	std::vector<byte> nonce(keySizes.NonceSize());
+	std::memcpy(&nonce[0], &Secret[key.size()], keySizes.NonceSize());
+	std::vector<byte> tag(keySizes.InfoSize());
+	std::memcpy(&tag[0], &Secret[key.size() + keySizes.NonceSize()], keySizes.InfoSize());
+	Utility::IntUtils::ClearVector(Secret);
+
+	// append the encrypted message and the auth-code to the ML-KEM cipher-text
+	CipherText.resize(m_paramSet.CipherTextSize + Message.size() + keySizes.InfoSize());
+	Key::Symmetric::SymmetricKey kp(key, nonce, tag);
+	m_cprMode->Initialize(true, kp);
+	m_cprMode->Transform(Message, 0, CipherText, m_paramSet.CipherTextSize, Message.size());
+	m_cprMode->Finalize(CipherText, CipherText.size() - keySizes.InfoSize(), keySizes.InfoSize());
+	Utility::IntUtils::ClearVector(key);
+}
+
+void ModuleLWE::Scope()
+{
+	MLWEQ3329N256::GetParamSet(m_paramSet, m_mlweParameters);
+}
+
+NAMESPACE_MODULELWEEND
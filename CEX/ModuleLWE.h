@@ -0,0 +1,239 @@
+// The GPL version 3 License (GPLv3)
+// 
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+// 
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_MODULELWE_H
+#define CEX_MODULELWE_H
+
+#include "CexDomain.h"
+#include "BlockCiphers.h"
+#include "IAeadMode.h"
+#include "IAsymmetricCipher.h"
+#include "IBlockCipher.h"
+#include "MLWEKeyPair.h"
+#include "MLWEParams.h"
+#include "MLWEParamSet.h"
+#include "MLWEPrivateKey.h"
+#include "MLWEPublicKey.h"
+
+NAMESPACE_MODULELWE
+
+using Cipher::Symmetric::Block::Mode::IAeadMode;
+using Cipher::Symmetric::Block::IBlockCipher;
+using Key::Asymmetric::MLWEKeyPair;
+using Enumeration::MLWEParams;
+using Key::Asymmetric::MLWEPrivateKey;
+using Key::Asymmetric::MLWEPublicKey;
+using Enumeration::BlockCiphers;
+
+/// <summary>
+/// An implementation of the Module Learning With Errors asymmetric cipher (ModuleLWE), based on the Kyber (ML-KEM) key encapsulation mechanism
+/// </summary> 
+/// 
+/// <example>
+/// <description>Key generation:</description>
+/// <code>
+/// ModuleLWE cpr(MLWEParams::Q3329N256K3);
+/// IAsymmetricKeyPair* kp = cpr.Generate();
+/// // serialize the public key
+/// MLWEPublicKey* pubK1 = (MLWEPublicKey*)kp->PublicKey();
+/// std:vector&lt;byte&gt; skey = pubK1->ToBytes();
+/// </code>
+///
+/// <description>Encryption:</description>
+/// <code>
+/// ModuleLWE cpr(Enumeration::MLWEParams::Q3329N256K3);
+/// cpr.Initialize(true, kp);
+/// // the encapsulated secret keys the authenticated cipher that encrypts the message
+/// std:vector&lt;byte&gt; enc = cpr.Encrypt(msg);
+/// </code>
+///
+/// <description>Decryption:</description>
+/// <code>
+/// ModuleLWE cpr(Enumeration::MLWEParams::Q3329N256K3);
+/// cpr.Initialize(false, kp);
+/// std:vector&lt;byte&gt; dec = cpr.Decrypt(enc);
+/// </code>
+/// </example>
+/// 
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <para>Module learning with errors (MLWE) replaces the single large ring polynomial of RingLWE with a small vector of polynomials over the ring Zq[X]/(X^256 + 1).
+/// The security level is chosen by the rank of the module, while the ring arithmetic, and the 256 coefficient NTT, are the same for every parameter set. \n
+/// This implementation follows the FIPS 203 ML-KEM key encapsulation mechanism; the Fujisaki-Okamoto transform re-encrypts the recovered message during decryption, 
+/// and an invalid cipher-text returns a pseudo-random secret (implicit rejection), which then fails the message authentication.</para>
+///
+/// <para>The encapsulated shared secret is hashed with Keccak512 (Keccak1024 for HX ciphers), and keys a GCM mode that encrypts the message, 
+/// in the same way as the RingLWE cipher. The cipher-text is the ML-KEM cipher-text, followed by the encrypted message and the authentication code.</para>
+/// 
+/// <list type="bullet">
+/// <item><description>Three parameter sets; Q3329N256K2 (Kyber-512), Q3329N256K3 (Kyber-768, recommended), and Q3329N256K4 (Kyber-1024)</description></item>
+/// <item><description>The public keys are 800, 1184 and 1568 bytes, the cipher-texts 768, 1088 and 1568 bytes, about half the size of the RingLWE forward and return messages</description></item>
+/// <item><description>Keys serialize in the packed 12 bit FIPS 203 encoding; the private key holds the secret vector, the public key, its hash, and the implicit rejection seed</description></item>
+/// <item><description>On AVX2 the NTT, the base multiplications and the samplers process 16 coefficients at a time, and the matrix and noise are expanded 4 polynomials at a time with the interleaved Keccak permutation</description></item>
+/// <item><description>The primary Prng is set through the constructor, as either an prng type-name (default BCR-AES256), which instantiates the function internally, or a pointer to a perisitant external instance of a Prng</description></item>
+/// </list>
+/// 
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>FIPS 203: <a href="https://csrc.nist.gov/pubs/fips/203/final">Module-Lattice-Based Key-Encapsulation Mechanism Standard</a>.</description></item>
+/// <item><description>CRYSTALS-Kyber: <a href="https://eprint.iacr.org/2017/634">a CCA-secure module-lattice-based KEM</a>.</description></item>
+/// </list>
+/// </remarks>
+class ModuleLWE final : public IAsymmetricCipher
+{
+private:
+
+	static const std::string CLASS_NAME;
+
+	std::unique_ptr<IAeadMode> m_cprMode;
+	bool m_destroyEngine;
+	bool m_isDestroyed;
+	bool m_isEncryption;
+	bool m_isInitialized;
+	bool m_isParallel;
+	std::vector<byte> m_keyTag;
+	MLWEParams m_mlweParameters;
+	std::unique_ptr<IDigest> m_msgDigest;
+	MLWEParamSet m_paramSet;
+	std::unique_ptr<MLWEPrivateKey> m_privateKey;
+	std::unique_ptr<MLWEPublicKey> m_publicKey;
+	std::unique_ptr<IPrng> m_rndGenerator;
+
+public:
+
+	ModuleLWE() = delete;
+	ModuleLWE(const ModuleLWE&) = delete;
+	ModuleLWE& operator=(const ModuleLWE&) = delete;
+	ModuleLWE& operator=(ModuleLWE&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The cipher type-name
+	/// </summary>
+	const AsymmetricEngines Enumeral() override;
+
+	/// <summary>
+	/// Get: The cipher is initialized for encryption
+	/// </summary>
+	const bool IsEncryption() override;
+
+	/// <summary>
+	/// Get: The cipher has been initialized with a key
+	/// </summary>
+	const bool IsInitialized() override;
+
+	/// <summary>
+	/// Get: The cipher and parameter-set formal names
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Get: The ciphers initialization parameters
+	/// </summary>
+	const MLWEParamSet &ParamSet();
+
+	/// <summary>
+	/// Get: The ciphers parameters enumeration name
+	/// </summary>
+	const MLWEParams Parameters();
+
+	/// <summary>
+	/// Get/Set: A new asymmetric key-pairs optional identification tag.
+	/// <para>Setting this value must be done before the Generate method is called.</para>
+	/// </summary>
+	std::vector<byte> &Tag() override;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Instantiate the cipher with auto-initialized prng and digest functions
+	/// </summary>
+	///
+	/// <param name="Parameters">The parameter set enumeration name</param>
+	/// <param name="PrngType">The seed prng function type; the default is the BCR generator</param>
+	/// <param name="CipherType">The authentication block ciphers type; the default is AES256</param>
+	/// <param name="Parallel">Reserved for interface parity with RingLWE; the polynomial arithmetic is vectorized and runs on the calling thread</param>
+	explicit ModuleLWE(MLWEParams Parameters, Prngs PrngType = Prngs::BCR, BlockCiphers CipherType = BlockCiphers::Rijndael, bool Parallel = false);
+
+	/// <summary>
+	/// Instantiate this class using external Prng and Digest instances
+	/// </summary>
+	///
+	/// <param name="Parameters">The parameter set enumeration name</param>
+	/// <param name="Prng">A pointer to the seed Prng function</param>
+	/// <param name="Cipher">A pointer to the authentication block cipher</param>
+	/// <param name="Parallel">Reserved for interface parity with RingLWE; the polynomial arithmetic is vectorized and runs on the calling thread</param>
+	ModuleLWE(MLWEParams Parameters, IPrng* Prng, IBlockCipher* Cipher, bool Parallel = false);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~ModuleLWE() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Decrypt an encrypted cipher-text and return the shared secret
+	/// </summary>
+	/// 
+	/// <param name="CipherText">The input cipher-text</param>
+	/// 
+	/// <returns>The decrypted message</returns>
+	/// 
+	/// <exception cref="Exception::CryptoAuthenticationFailure">Thrown if the cipher-text fails authentication</exception>
+	std::vector<byte> Decrypt(const std::vector<byte> &CipherText) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Encrypt a secret and return the encrypted message
+	/// </summary>
+	/// 
+	/// <param name="Message">The shared secret array</param>
+	/// 
+	/// <returns>The encrypted message</returns>
+	std::vector<byte> Encrypt(const std::vector<byte> &Message) override;
+
+	/// <summary>
+	/// Generate a public/private key-pair
+	/// </summary>
+	/// 
+	/// <returns>A public/private key pair</returns>
+	IAsymmetricKeyPair* Generate() override;
+
+	/// <summary>
+	/// Initialize the cipher for encryption or decryption
+	/// </summary>
+	/// 
+	/// <param name="Encryption">Initialize the cipher for encryption or decryption</param>
+	/// <param name="KeyPair">The <see cref="IAsymmetricKeyPair"/> containing the Public (encrypt) and/or Private (decryption) key</param>
+	void Initialize(bool Encryption, IAsymmetricKeyPair* KeyPair) override;
+
+private:
+
+	bool MLWEDecrypt(const std::vector<byte> &CipherText, std::vector<byte> &Message, std::vector<byte> &Secret);
+	void MLWEEncrypt(const std::vector<byte> &Message, std::vector<byte> &CipherText, std::vector<byte> &Secret);
+	void Scope();
+};
+
+NAMESPACE_MODULELWEEND
+#endif
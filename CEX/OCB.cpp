@@ -4,6 +4,7 @@
 #include "IntUtils.h"
 #include "MemUtils.h"
 #include "ParallelUtils.h"
+#include "SegmentUtils.h"
 #include "SymmetricKey.h"
 
 NAMESPACE_MODE
@@ -101,14 +102,24 @@ OCB::OCB(BlockCiphers CipherType)
 	:
 	m_aadData(BLOCK_SIZE),
 	m_aadLoaded(false),
+	m_aadOffset(BLOCK_SIZE),
 	m_aadPreserve(false),
 	m_autoIncrement(false),
+	m_batchHash(0),
+	m_batchLanes(BATCH_LANES * BLOCK_SIZE),
+	m_batchMap(BATCH_LANES * 2),
+	m_batchMask(BATCH_LANES * BLOCK_SIZE),
+	m_batchOffset(0),
+	m_batchSum(0),
+	m_batchTable(0),
 	m_blockCipher(Helper::BlockCipherFromName::GetInstance(CipherType)),
 	m_checkSum(BLOCK_SIZE),
 	m_cipherType(CipherType),
 	m_destroyEngine(true),
+	m_hashBlock(BLOCK_SIZE),
 	m_hashCipher(Helper::BlockCipherFromName::GetInstance(CipherType)),
-	m_hashList(0),
+	m_hashCount(0),
+	m_hashTable(0),
 	m_isEncryption(false),
 	m_isFinalized(false),
 	m_legalKeySizes(0),
@@ -119,7 +130,10 @@ OCB::OCB(BlockCiphers CipherType)
 	m_mainOffset0(BLOCK_SIZE),
 	m_mainStretch(BLOCK_SIZE + (BLOCK_SIZE / 2)),
 	m_msgTag(BLOCK_SIZE),
+	m_offsetChain(0),
+	m_padBlock(BLOCK_SIZE),
 	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize() + PREFETCH_HASH, true),
+	m_segmentStage(0),
 	m_topInput(0)
 {
 	Scope();
@@ -129,14 +143,24 @@ OCB::OCB(IBlockCipher* Cipher)
 	:
 	m_aadData(BLOCK_SIZE),
 	m_aadLoaded(false),
+	m_aadOffset(BLOCK_SIZE),
 	m_aadPreserve(false),
 	m_autoIncrement(false),
+	m_batchHash(0),
+	m_batchLanes(BATCH_LANES * BLOCK_SIZE),
+	m_batchMap(BATCH_LANES * 2),
+	m_batchMask(BATCH_LANES * BLOCK_SIZE),
+	m_batchOffset(0),
+	m_batchSum(0),
+	m_batchTable(0),
 	m_blockCipher(Cipher != 0 ? Cipher : throw CryptoCipherModeException("OCB:CTor", "The Cipher can not be null!")),
 	m_checkSum(BLOCK_SIZE),
 	m_cipherType(m_blockCipher->Enumeral()),
 	m_destroyEngine(false),
+	m_hashBlock(BLOCK_SIZE),
 	m_hashCipher(Helper::BlockCipherFromName::GetInstance(m_cipherType)),
-	m_hashList(0),
+	m_hashCount(0),
+	m_hashTable(0),
 	m_isEncryption(false),
 	m_isFinalized(false),
 	m_legalKeySizes(0),
@@ -147,7 +171,10 @@ OCB::OCB(IBlockCipher* Cipher)
 	m_mainOffset0(BLOCK_SIZE),
 	m_mainStretch(2 * BLOCK_SIZE),
 	m_msgTag(BLOCK_SIZE),
+	m_offsetChain(0),
+	m_padBlock(BLOCK_SIZE),
 	m_parallelProfile(BLOCK_SIZE, true, m_blockCipher->StateCacheSize() + PREFETCH_HASH, true),
+	m_segmentStage(0),
 	m_topInput(BLOCK_SIZE + (BLOCK_SIZE / 2))
 {
 	if (m_blockCipher->BlockSize() != BLOCK_SIZE)
@@ -181,6 +208,7 @@ void OCB::Destroy()
 		m_aadLoaded = false;
 		m_aadPreserve = false;
 		m_cipherType = BlockCiphers::None;
+		m_hashCount = 0;
 		m_isFinalized = false;
 		m_isEncryption = false;
 		m_isInitialized = false;
@@ -188,8 +216,17 @@ void OCB::Destroy()
 		m_parallelProfile.Reset();
 
 		Utility::IntUtils::ClearVector(m_aadData);
+		Utility::IntUtils::ClearVector(m_aadOffset);
+		Utility::IntUtils::ClearVector(m_batchHash);
+		Utility::IntUtils::ClearVector(m_batchLanes);
+		Utility::IntUtils::ClearVector(m_batchMap);
+		Utility::IntUtils::ClearVector(m_batchMask);
+		Utility::IntUtils::ClearVector(m_batchOffset);
+		Utility::IntUtils::ClearVector(m_batchSum);
+		Utility::IntUtils::ClearVector(m_batchTable);
 		Utility::IntUtils::ClearVector(m_checkSum);
-		Utility::IntUtils::ClearVector(m_hashList);
+		Utility::IntUtils::ClearVector(m_hashBlock);
+		Utility::IntUtils::ClearVector(m_hashTable);
 		Utility::IntUtils::ClearVector(m_legalKeySizes);
 		Utility::IntUtils::ClearVector(m_listAsterisk);
 		Utility::IntUtils::ClearVector(m_listDollar);
@@ -199,6 +236,9 @@ void OCB::Destroy()
 		Utility::IntUtils::ClearVector(m_msgTag);
 		Utility::IntUtils::ClearVector(m_ocbNonce);
 		Utility::IntUtils::ClearVector(m_ocbVector);
+		Utility::IntUtils::ClearVector(m_offsetChain);
+		Utility::IntUtils::ClearVector(m_padBlock);
+		Utility::IntUtils::ClearVector(m_segmentStage);
 		Utility::IntUtils::ClearVector(m_topInput);
 
 		if (m_destroyEngine)
@@ -234,25 +274,27 @@ void OCB::Finalize(std::vector<byte> &Output, const size_t Offset, const size_t
 
 void OCB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
+	SymmetricKeyView keyView(KeyParams);
+
 	Scope();
 
-	if (KeyParams.Key().size() == 0)
+	if (keyView.Key().size() == 0)
 	{
-		if (KeyParams.Nonce() == m_ocbVector)
+		if (keyView.Nonce() == m_ocbVector)
 			throw CryptoSymmetricCipherException("OCB:Initialize", "The nonce can not be zeroised or reused!");
 		if (!m_blockCipher->IsInitialized())
 			throw CryptoSymmetricCipherException("OCB:Initialize", "First initialization requires a key and nonce!");
 	}
 	else
 	{
-		if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+		if (!SymmetricKeySize::Contains(LegalKeySizes(), keyView.Key().size()))
 			throw CryptoSymmetricCipherException("OCB:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
 
 		m_hashCipher->Initialize(true, KeyParams);
 		m_blockCipher->Initialize(Encryption, KeyParams);
 	}
 
-	if (KeyParams.Nonce().size() > MAX_NONCESIZE || KeyParams.Nonce().size() < MIN_NONCESIZE)
+	if (keyView.Nonce().size() > MAX_NONCESIZE || keyView.Nonce().size() < MIN_NONCESIZE)
 		throw CryptoSymmetricCipherException("OCB:Initialize", "Requires a nonce of at least 12, and no longer than 15 bytes!");
 	if (m_parallelProfile.IsParallel() && m_parallelProfile.ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || m_parallelProfile.ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
 		throw CryptoSymmetricCipherException("OCB:Initialize", "The parallel block size is out of bounds!");
@@ -260,13 +302,14 @@ void OCB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 		throw CryptoSymmetricCipherException("OCB:Initialize", "The parallel block size must be evenly aligned to the ParallelMinimumSize!");
 
 	m_isEncryption = Encryption;
-	m_ocbNonce = KeyParams.Nonce();
+	m_ocbNonce = keyView.Nonce();
 	m_ocbVector = m_ocbNonce;
 	m_hashCipher->Transform(m_listAsterisk, 0, m_listAsterisk, 0);
 	DoubleBlock(m_listAsterisk, m_listDollar);
-	std::vector<byte> hash(BLOCK_SIZE);
-	DoubleBlock(m_listDollar, hash);
-	m_hashList.push_back(hash);
+	// L_0 starts the table; GetLSub extends it in place
+	DoubleBlock(m_listDollar, m_hashBlock);
+	Utility::MemUtils::COPY128(m_hashBlock, 0, m_hashTable, 0);
+	m_hashCount = 1;
 	GenerateOffsets(m_ocbVector);
 
 	if (m_isFinalized)
@@ -278,6 +321,55 @@ void OCB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 	m_isInitialized = true;
 }
 
+bool OCB::Open(std::vector<AeadPacket> &Packets, const size_t TagLength)
+{
+	if (m_isEncryption)
+		throw CryptoCipherModeException("OCB:Open", "The cipher mode has not been initialized for decryption!");
+
+	BatchScope(Packets, TagLength, "OCB:Open");
+
+	// in-place packets are only checksummed on the first pass; their plain-text is written once the tag is authentic
+	for (size_t i = 0; i < Packets.size(); ++i)
+		Packets[i].Verified = false;
+
+	BatchOffsets(Packets);
+	BatchHash(Packets);
+	BatchCrypt(Packets, false, false);
+	BatchPartial(Packets, false, false);
+	BatchTags(Packets.size());
+
+	bool deferred = false;
+	bool status = true;
+
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		AeadPacket &pkt = Packets[i];
+
+		pkt.Verified = Utility::IntUtils::Compare(m_batchSum, i * BLOCK_SIZE, *pkt.Tag, pkt.TagOffset, TagLength);
+
+		if (!pkt.Verified)
+		{
+			if (pkt.Length != 0 && !pkt.IsInPlace())
+				Utility::MemUtils::Clear(*pkt.Output, pkt.OutOffset, pkt.Length);
+
+			status = false;
+		}
+		else if (pkt.Length != 0 && pkt.IsInPlace())
+		{
+			deferred = true;
+		}
+	}
+
+	if (deferred)
+	{
+		BatchOffsets(Packets);
+		BatchCrypt(Packets, false, true);
+		BatchPartial(Packets, false, true);
+	}
+
+	return status;
+}
+
 void OCB::ParallelMaxDegree(size_t Degree)
 {
 	if (Degree == 0)
@@ -290,6 +382,25 @@ void OCB::ParallelMaxDegree(size_t Degree)
 	m_parallelProfile.SetMaxDegree(Degree);
 }
 
+void OCB::Seal(std::vector<AeadPacket> &Packets, const size_t TagLength)
+{
+	if (!m_isEncryption)
+		throw CryptoCipherModeException("OCB:Seal", "The cipher mode has not been initialized for encryption!");
+
+	BatchScope(Packets, TagLength, "OCB:Seal");
+	BatchOffsets(Packets);
+	BatchHash(Packets);
+	BatchCrypt(Packets, true, false);
+	BatchPartial(Packets, true, false);
+	BatchTags(Packets.size());
+
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		AeadPacket &pkt = Packets[i];
+		Utility::MemUtils::Copy(m_batchSum, i * BLOCK_SIZE, *pkt.Tag, pkt.TagOffset, TagLength);
+	}
+}
+
 void OCB::SetAssociatedData(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
 {
 	if (!m_isInitialized)
@@ -300,36 +411,45 @@ void OCB::SetAssociatedData(const std::vector<byte> &Input, const size_t Offset,
 	size_t blkCnt = 0;
 	size_t blkLen = Length;
 	size_t blkOff = Offset;
-	std::vector<byte> offsetHash(BLOCK_SIZE);
+
+	Utility::MemUtils::Clear(m_aadOffset, 0, BLOCK_SIZE);
 
 	while (blkLen >= BLOCK_SIZE)
 	{
-		std::vector<byte> offset(BLOCK_SIZE);
-		GetLSub(Ntz(++blkCnt), offset);
-		std::vector<byte> tmp(BLOCK_SIZE);
-		Utility::MemUtils::COPY128(Input, blkOff, tmp, 0);
-		Utility::MemUtils::XorBlock(offset, 0, offsetHash, 0, BLOCK_SIZE);
-		Utility::MemUtils::XorBlock(offsetHash, 0, tmp, 0, BLOCK_SIZE);
-		m_hashCipher->Transform(tmp, 0, tmp, 0);
-		Utility::MemUtils::XorBlock(tmp, 0, m_aadData, 0, BLOCK_SIZE);
+		GetLSub(Ntz(++blkCnt), m_hashBlock);
+		Utility::MemUtils::COPY128(Input, blkOff, m_padBlock, 0);
+		Utility::MemUtils::XorBlock(m_hashBlock, 0, m_aadOffset, 0, BLOCK_SIZE);
+		Utility::MemUtils::XorBlock(m_aadOffset, 0, m_padBlock, 0, BLOCK_SIZE);
+		m_hashCipher->Transform(m_padBlock, 0, m_padBlock, 0);
+		Utility::MemUtils::XorBlock(m_padBlock, 0, m_aadData, 0, BLOCK_SIZE);
 		blkOff += BLOCK_SIZE;
 		blkLen -= BLOCK_SIZE;
 	}
 
 	if (blkLen != 0)
 	{
-		std::vector<byte> tmp(BLOCK_SIZE);
-		Utility::MemUtils::Copy(Input, blkOff, tmp, 0, blkLen);
-		ExtendBlock(tmp, blkLen);
-		Utility::MemUtils::XorBlock(m_listAsterisk, 0, offsetHash, 0, BLOCK_SIZE);
-		Utility::MemUtils::XorBlock(offsetHash, 0, tmp, 0, BLOCK_SIZE);
-		m_hashCipher->Transform(tmp, 0, tmp, 0);
-		Utility::MemUtils::XorBlock(tmp, 0, m_aadData, 0, BLOCK_SIZE);
+		Utility::MemUtils::Copy(Input, blkOff, m_padBlock, 0, blkLen);
+		ExtendBlock(m_padBlock, blkLen);
+		Utility::MemUtils::XorBlock(m_listAsterisk, 0, m_aadOffset, 0, BLOCK_SIZE);
+		Utility::MemUtils::XorBlock(m_aadOffset, 0, m_padBlock, 0, BLOCK_SIZE);
+		m_hashCipher->Transform(m_padBlock, 0, m_padBlock, 0);
+		Utility::MemUtils::XorBlock(m_padBlock, 0, m_aadData, 0, BLOCK_SIZE);
 	}
 
 	m_aadLoaded = true;
 }
 
+void OCB::SetAssociatedSegments(const std::vector<MemorySegment> &Input)
+{
+	if (!Utility::SegmentUtils::IsValid(Input))
+		throw CryptoCipherModeException("OCB:SetAssociatedSegments", "A segment exceeds its array!");
+
+	// the modes absorb the associated data in one call; the fragments are joined in the staging buffer
+	const size_t AADLEN = Utility::SegmentUtils::Gather(Input, m_segmentStage);
+	SetAssociatedData(m_segmentStage, 0, AADLEN);
+	Utility::MemUtils::Clear(m_segmentStage, 0, AADLEN);
+}
+
 void OCB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
@@ -364,6 +484,11 @@ void OCB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 	}
 }
 
+void OCB::TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output)
+{
+	Utility::SegmentUtils::Transform(this, Input, Output, m_segmentStage);
+}
+
 bool OCB::Verify(const std::vector<byte> &Input, const size_t Offset, const size_t Length)
 {
 	if (m_isEncryption)
@@ -381,6 +506,292 @@ bool OCB::Verify(const std::vector<byte> &Input, const size_t Offset, const size
 
 //~~~Private Functions~~~//
 
+void OCB::BatchCrypt(std::vector<AeadPacket> &Packets, bool Encryption, bool Deferred)
+{
+	const size_t PKTCNT = Packets.size();
+	size_t pktIdx = 0;
+	size_t pktPos = 0;
+
+	Utility::MemUtils::Clear(m_batchSum, 0, PKTCNT * BLOCK_SIZE);
+
+	while (pktIdx != PKTCNT)
+	{
+		size_t lanes = 0;
+
+		// stage the full blocks of consecutive packets
+		while (lanes != BATCH_LANES && pktIdx != PKTCNT)
+		{
+			const AeadPacket &pkt = Packets[pktIdx];
+			const size_t PKTOFF = pktIdx * BLOCK_SIZE;
+			const size_t LANOFF = lanes * BLOCK_SIZE;
+
+			// a trailing partial block is processed by BatchPartial; the deferred pass only decrypts authentic in-place packets
+			if (pkt.Length - pktPos < BLOCK_SIZE || (Deferred && !(pkt.Verified && pkt.IsInPlace())))
+			{
+				++pktIdx;
+				pktPos = 0;
+				continue;
+			}
+
+			Utility::MemUtils::XOR128(m_batchTable, (2 + Ntz((pktPos / BLOCK_SIZE) + 1)) * BLOCK_SIZE, m_batchOffset, PKTOFF);
+			Utility::MemUtils::COPY128(m_batchOffset, PKTOFF, m_batchMask, LANOFF);
+			Utility::MemUtils::COPY128(*pkt.Input, pkt.InOffset + pktPos, m_batchLanes, LANOFF);
+
+			if (Encryption)
+				Utility::MemUtils::XOR128(m_batchLanes, LANOFF, m_batchSum, PKTOFF);
+
+			Utility::MemUtils::XOR128(m_batchMask, LANOFF, m_batchLanes, LANOFF);
+			m_batchMap[lanes * 2] = pktIdx;
+			m_batchMap[(lanes * 2) + 1] = pktPos;
+			pktPos += BLOCK_SIZE;
+			++lanes;
+		}
+
+		TransformLanes(m_blockCipher, m_batchLanes, 0, m_batchLanes, 0, lanes);
+
+		for (size_t i = 0; i < lanes; ++i)
+		{
+			AeadPacket &pkt = Packets[m_batchMap[i * 2]];
+			const size_t LANOFF = i * BLOCK_SIZE;
+
+			Utility::MemUtils::XOR128(m_batchMask, LANOFF, m_batchLanes, LANOFF);
+
+			if (Encryption || pkt.Verified || !pkt.IsInPlace())
+				Utility::MemUtils::COPY128(m_batchLanes, LANOFF, *pkt.Output, pkt.OutOffset + m_batchMap[(i * 2) + 1]);
+
+			if (!Encryption)
+				Utility::MemUtils::XOR128(m_batchLanes, LANOFF, m_batchSum, m_batchMap[i * 2] * BLOCK_SIZE);
+		}
+	}
+}
+
+void OCB::BatchHash(std::vector<AeadPacket> &Packets)
+{
+	const size_t PKTCNT = Packets.size();
+	size_t pktIdx = 0;
+	size_t pktPos = 0;
+
+	Utility::MemUtils::Clear(m_batchHash, 0, PKTCNT * BLOCK_SIZE);
+
+	while (pktIdx != PKTCNT)
+	{
+		size_t lanes = 0;
+
+		// stage the associated data blocks of consecutive packets
+		while (lanes != BATCH_LANES && pktIdx != PKTCNT)
+		{
+			const std::vector<byte>* aad = Packets[pktIdx].AssociatedData;
+			const size_t AADLEN = (aad != nullptr) ? aad->size() : 0;
+			const size_t LANOFF = lanes * BLOCK_SIZE;
+
+			if (pktPos == AADLEN)
+			{
+				++pktIdx;
+				pktPos = 0;
+				continue;
+			}
+
+			if (pktPos == 0)
+				Utility::MemUtils::Clear(m_aadOffset, 0, BLOCK_SIZE);
+
+			if (AADLEN - pktPos >= BLOCK_SIZE)
+			{
+				Utility::MemUtils::XOR128(m_batchTable, (2 + Ntz((pktPos / BLOCK_SIZE) + 1)) * BLOCK_SIZE, m_aadOffset, 0);
+				Utility::MemUtils::COPY128(*aad, pktPos, m_batchLanes, LANOFF);
+				pktPos += BLOCK_SIZE;
+			}
+			else
+			{
+				Utility::MemUtils::XOR128(m_batchTable, 0, m_aadOffset, 0);
+				Utility::MemUtils::Clear(m_batchLanes, LANOFF, BLOCK_SIZE);
+				Utility::MemUtils::Copy(*aad, pktPos, m_batchLanes, LANOFF, AADLEN - pktPos);
+				m_batchLanes[LANOFF + AADLEN - pktPos] = 0x80;
+				pktPos = AADLEN;
+			}
+
+			Utility::MemUtils::XOR128(m_aadOffset, 0, m_batchLanes, LANOFF);
+			m_batchMap[lanes] = pktIdx;
+			++lanes;
+		}
+
+		TransformLanes(m_hashCipher, m_batchLanes, 0, m_batchLanes, 0, lanes);
+
+		for (size_t i = 0; i < lanes; ++i)
+			Utility::MemUtils::XOR128(m_batchLanes, i * BLOCK_SIZE, m_batchHash, m_batchMap[i] * BLOCK_SIZE);
+	}
+}
+
+void OCB::BatchOffsets(std::vector<AeadPacket> &Packets)
+{
+	const size_t PKTCNT = Packets.size();
+
+	// the nonce top blocks; the low 6 bits of the nonce are cleared, and select the stretch position
+	for (size_t i = 0; i < PKTCNT; ++i)
+	{
+		const std::vector<byte> &nonce = *Packets[i].Nonce;
+		const size_t PKTOFF = i * BLOCK_SIZE;
+
+		Utility::MemUtils::Clear(m_batchOffset, PKTOFF, BLOCK_SIZE);
+		Utility::MemUtils::Copy(nonce, 0, m_batchOffset, PKTOFF + BLOCK_SIZE - nonce.size(), nonce.size());
+		m_batchOffset[PKTOFF] = static_cast<byte>(BLOCK_SIZE << 4);
+		m_batchOffset[PKTOFF + MAX_NONCESIZE - nonce.size()] |= 1;
+		m_batchOffset[PKTOFF + MAX_NONCESIZE] &= 0xC0;
+	}
+
+	TransformLanes(m_hashCipher, m_batchOffset, 0, m_batchOffset, 0, PKTCNT);
+
+	for (size_t i = 0; i < PKTCNT; ++i)
+	{
+		const std::vector<byte> &nonce = *Packets[i].Nonce;
+		const size_t PKTOFF = i * BLOCK_SIZE;
+		const size_t BTMBIT = nonce[nonce.size() - 1] & 0x3F;
+		const size_t BTMSZE = BTMBIT % 8;
+		size_t btmLen = BTMBIT / 8;
+
+		// the stretch is built in the lanes buffer
+		Utility::MemUtils::COPY128(m_batchOffset, PKTOFF, m_batchLanes, 0);
+
+		for (size_t j = 0; j < 8; ++j)
+			m_batchLanes[BLOCK_SIZE + j] = static_cast<byte>(m_batchLanes[j] ^ m_batchLanes[j + 1]);
+
+		if (BTMSZE == 0)
+		{
+			Utility::MemUtils::COPY128(m_batchLanes, btmLen, m_batchOffset, PKTOFF);
+		}
+		else
+		{
+			for (size_t j = 0; j < BLOCK_SIZE; ++j)
+			{
+				ulong b1 = m_batchLanes[btmLen];
+				ulong b2 = m_batchLanes[++btmLen];
+
+				m_batchOffset[PKTOFF + j] = static_cast<byte>((b1 << BTMSZE) | (b2 >> (8 - BTMSZE)));
+			}
+		}
+	}
+}
+
+void OCB::BatchPartial(std::vector<AeadPacket> &Packets, bool Encryption, bool Deferred)
+{
+	const size_t PKTCNT = Packets.size();
+	size_t pktIdx = 0;
+
+	while (pktIdx != PKTCNT)
+	{
+		size_t lanes = 0;
+
+		// the pads of the packets that end with a partial block
+		while (lanes != BATCH_LANES && pktIdx != PKTCNT)
+		{
+			const AeadPacket &pkt = Packets[pktIdx];
+
+			if (pkt.Length % BLOCK_SIZE != 0 && (!Deferred || (pkt.Verified && pkt.IsInPlace())))
+			{
+				Utility::MemUtils::XOR128(m_batchTable, 0, m_batchOffset, pktIdx * BLOCK_SIZE);
+				Utility::MemUtils::COPY128(m_batchOffset, pktIdx * BLOCK_SIZE, m_batchLanes, lanes * BLOCK_SIZE);
+				m_batchMap[lanes] = pktIdx;
+				++lanes;
+			}
+
+			++pktIdx;
+		}
+
+		TransformLanes(m_hashCipher, m_batchLanes, 0, m_batchLanes, 0, lanes);
+
+		for (size_t i = 0; i < lanes; ++i)
+		{
+			AeadPacket &pkt = Packets[m_batchMap[i]];
+			const size_t BLKOFF = pkt.Length - (pkt.Length % BLOCK_SIZE);
+			const size_t BLKLEN = pkt.Length - BLKOFF;
+			const size_t LANOFF = i * BLOCK_SIZE;
+			const size_t SUMOFF = m_batchMap[i] * BLOCK_SIZE;
+
+			if (Encryption)
+				Utility::MemUtils::XorBlock(*pkt.Input, pkt.InOffset + BLKOFF, m_batchSum, SUMOFF, BLKLEN);
+
+			Utility::MemUtils::XorBlock(*pkt.Input, pkt.InOffset + BLKOFF, m_batchLanes, LANOFF, BLKLEN);
+
+			if (Encryption || pkt.Verified || !pkt.IsInPlace())
+				Utility::MemUtils::Copy(m_batchLanes, LANOFF, *pkt.Output, pkt.OutOffset + BLKOFF, BLKLEN);
+
+			if (!Encryption)
+				Utility::MemUtils::XorBlock(m_batchLanes, LANOFF, m_batchSum, SUMOFF, BLKLEN);
+
+			// the checksum block is padded with a single set bit
+			m_batchSum[SUMOFF + BLKLEN] ^= 0x80;
+		}
+	}
+}
+
+void OCB::BatchScope(const std::vector<AeadPacket> &Packets, const size_t TagLength, const std::string &Origin)
+{
+	if (!m_hashCipher->IsInitialized())
+		throw CryptoCipherModeException(Origin, "The cipher mode has not been keyed!");
+	if (TagLength < MIN_TAGSIZE || TagLength > BLOCK_SIZE)
+		throw CryptoCipherModeException(Origin, "The output length must be between 12 and 16 bytes!");
+
+	size_t maxBlk = 1;
+
+	for (size_t i = 0; i < Packets.size(); ++i)
+	{
+		const AeadPacket &pkt = Packets[i];
+
+		if (pkt.Nonce == nullptr || pkt.Nonce->size() > MAX_NONCESIZE || pkt.Nonce->size() < MIN_NONCESIZE)
+			throw CryptoCipherModeException(Origin, "Each packet requires a nonce of at least 12, and no longer than 15 bytes!");
+		if (pkt.Tag == nullptr || pkt.Tag->size() < pkt.TagOffset + TagLength)
+			throw CryptoCipherModeException(Origin, "The packet tag array is too small!");
+		if (pkt.Length != 0 && (pkt.Input == nullptr || pkt.Output == nullptr || pkt.Input->size() < pkt.InOffset + pkt.Length || pkt.Output->size() < pkt.OutOffset + pkt.Length))
+			throw CryptoCipherModeException(Origin, "The packet arrays are smaller than the message length!");
+
+		maxBlk = Utility::IntUtils::Max(maxBlk, pkt.Length / BLOCK_SIZE);
+
+		if (pkt.AssociatedData != nullptr)
+			maxBlk = Utility::IntUtils::Max(maxBlk, pkt.AssociatedData->size() / BLOCK_SIZE);
+	}
+
+	if (m_batchOffset.size() < Packets.size() * BLOCK_SIZE)
+	{
+		m_batchHash.resize(Packets.size() * BLOCK_SIZE);
+		m_batchOffset.resize(Packets.size() * BLOCK_SIZE);
+		m_batchSum.resize(Packets.size() * BLOCK_SIZE);
+	}
+
+	// L_*, L_$, and L_0 through the largest L_ntz(i) used by the batch
+	size_t tblCnt = 1;
+
+	while ((static_cast<size_t>(1) << tblCnt) <= maxBlk)
+		++tblCnt;
+
+	if (m_batchTable.size() < (2 + tblCnt) * BLOCK_SIZE)
+		m_batchTable.resize((2 + tblCnt) * BLOCK_SIZE);
+
+	Utility::MemUtils::Clear(m_padBlock, 0, BLOCK_SIZE);
+	m_hashCipher->Transform(m_padBlock, 0, m_padBlock, 0);
+
+	for (size_t i = 0; i < 2 + tblCnt; ++i)
+	{
+		Utility::MemUtils::COPY128(m_padBlock, 0, m_batchTable, i * BLOCK_SIZE);
+		DoubleBlock(m_padBlock, m_padBlock);
+	}
+
+	Utility::MemUtils::Clear(m_padBlock, 0, BLOCK_SIZE);
+}
+
+void OCB::BatchTags(size_t PacketCount)
+{
+	// the checksums are masked with the final offsets and L_$, and encrypted together
+	for (size_t i = 0; i < PacketCount; ++i)
+	{
+		Utility::MemUtils::XOR128(m_batchOffset, i * BLOCK_SIZE, m_batchSum, i * BLOCK_SIZE);
+		Utility::MemUtils::XOR128(m_batchTable, BLOCK_SIZE, m_batchSum, i * BLOCK_SIZE);
+	}
+
+	TransformLanes(m_hashCipher, m_batchSum, 0, m_batchSum, 0, PacketCount);
+
+	for (size_t i = 0; i < PacketCount; ++i)
+		Utility::MemUtils::XOR128(m_batchHash, i * BLOCK_SIZE, m_batchSum, i * BLOCK_SIZE);
+}
+
 void OCB::CalculateMac()
 {
 	Utility::MemUtils::XOR128(m_mainOffset, 0, m_checkSum, 0);
@@ -406,9 +817,8 @@ void OCB::Decrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 	CexAssert(Utility::IntUtils::Min(Input.size() - InOffset, Output.size() - OutOffset) >= BLOCK_SIZE, "The data arrays are smaller than the the block-size!");
 
 	Utility::MemUtils::COPY128(Input, InOffset, Output, OutOffset);
-	std::vector<byte> hash(BLOCK_SIZE);
-	GetLSub(Ntz(++m_mainBlockCount), hash);
-	Utility::MemUtils::XorBlock(hash, 0, m_mainOffset, 0, BLOCK_SIZE);
+	GetLSub(Ntz(++m_mainBlockCount), m_hashBlock);
+	Utility::MemUtils::XorBlock(m_hashBlock, 0, m_mainOffset, 0, BLOCK_SIZE);
 	Utility::MemUtils::XorBlock(m_mainOffset, 0, Output, OutOffset, BLOCK_SIZE);
 	m_blockCipher->Transform(Output, OutOffset, Output, OutOffset);
 	Utility::MemUtils::XorBlock(m_mainOffset, 0, Output, OutOffset, BLOCK_SIZE);
@@ -422,9 +832,8 @@ void OCB::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std:
 
 	Utility::MemUtils::COPY128(Input, InOffset, Output, OutOffset);
 	Utility::MemUtils::XorBlock(Output, OutOffset, m_checkSum, 0, BLOCK_SIZE);
-	std::vector<byte> hash(BLOCK_SIZE);
-	GetLSub(Ntz(++m_mainBlockCount), hash);
-	Utility::MemUtils::XorBlock(hash, 0, m_mainOffset, 0, BLOCK_SIZE);
+	GetLSub(Ntz(++m_mainBlockCount), m_hashBlock);
+	Utility::MemUtils::XorBlock(m_hashBlock, 0, m_mainOffset, 0, BLOCK_SIZE);
 	Utility::MemUtils::XorBlock(m_mainOffset, 0, Output, OutOffset, BLOCK_SIZE);
 	m_blockCipher->Transform(Output, OutOffset, Output, OutOffset);
 	Utility::MemUtils::XorBlock(m_mainOffset, 0, Output, OutOffset, BLOCK_SIZE);
@@ -449,23 +858,23 @@ void OCB::ExtendBlock(std::vector<byte> &Output, size_t Position)
 
 void OCB::GenerateOffsets(const std::vector<byte> &Nonce)
 {
-	std::vector<byte> tmpNonce(BLOCK_SIZE);
-	Utility::MemUtils::Copy(Nonce, 0, tmpNonce, BLOCK_SIZE - Nonce.size(), Nonce.size());
-	tmpNonce[0] = (byte)(BLOCK_SIZE << 4);
-	tmpNonce[MAX_NONCESIZE - Nonce.size()] |= 1;
-	uint bottom = tmpNonce[MAX_NONCESIZE] & 0x3F;
-	tmpNonce[MAX_NONCESIZE] &= 0xC0;
+	// the nonce block is built in the pad block, and ktop in the hash block
+	Utility::MemUtils::Clear(m_padBlock, 0, BLOCK_SIZE);
+	Utility::MemUtils::Copy(Nonce, 0, m_padBlock, BLOCK_SIZE - Nonce.size(), Nonce.size());
+	m_padBlock[0] = (byte)(BLOCK_SIZE << 4);
+	m_padBlock[MAX_NONCESIZE - Nonce.size()] |= 1;
+	uint bottom = m_padBlock[MAX_NONCESIZE] & 0x3F;
+	m_padBlock[MAX_NONCESIZE] &= 0xC0;
 
 	// when used with incrementing nonces, the cipher is only applied once every 64 inits
-	if (tmpNonce != m_topInput)
+	if (m_padBlock != m_topInput)
 	{
-		std::vector<byte> kTop(BLOCK_SIZE);
-		m_topInput = tmpNonce;
-		m_hashCipher->Transform(m_topInput, 0, kTop, 0);
-		Utility::MemUtils::COPY128(kTop, 0, m_mainStretch, 0);
+		m_topInput = m_padBlock;
+		m_hashCipher->Transform(m_topInput, 0, m_hashBlock, 0);
+		Utility::MemUtils::COPY128(m_hashBlock, 0, m_mainStretch, 0);
 
 		for (size_t i = 0; i < 8; ++i)
-			m_mainStretch[BLOCK_SIZE + i] = (byte)(kTop[i] ^ kTop[i + 1]);
+			m_mainStretch[BLOCK_SIZE + i] = (byte)(m_hashBlock[i] ^ m_hashBlock[i + 1]);
 	}
 
 	const size_t BTMSZE = bottom % 8;
@@ -491,15 +900,19 @@ void OCB::GenerateOffsets(const std::vector<byte> &Nonce)
 
 void OCB::GetLSub(size_t N, std::vector<byte> &LSub)
 {
-	size_t hashCtr = m_hashList.size();
-	while (N >= hashCtr)
+	while (N >= m_hashCount)
 	{
-		DoubleBlock(m_hashList[m_hashList.size() - 1], LSub);
-		m_hashList.push_back(LSub);
-		++hashCtr;
+		// the table keeps its capacity across messages; it only grows for a longer message
+		if (m_hashTable.size() < (m_hashCount + 1) * BLOCK_SIZE)
+			m_hashTable.resize((m_hashCount + 1) * BLOCK_SIZE);
+
+		Utility::MemUtils::COPY128(m_hashTable, (m_hashCount - 1) * BLOCK_SIZE, LSub, 0);
+		DoubleBlock(LSub, LSub);
+		Utility::MemUtils::COPY128(LSub, 0, m_hashTable, m_hashCount * BLOCK_SIZE);
+		++m_hashCount;
 	}
 
-	Utility::MemUtils::COPY128(m_hashList[N], 0, LSub, 0);
+	Utility::MemUtils::COPY128(m_hashTable, N * BLOCK_SIZE, LSub, 0);
 }
 
 uint OCB::Ntz(ulong X)
@@ -571,15 +984,15 @@ void OCB::ParallelDecrypt(const std::vector<byte> &Input, size_t InOffset, std::
 	// copy data into working output
 	Utility::MemUtils::Copy(Input, InOffset, Output, OutOffset, ALNLEN);
 	// create the offset chain
-	std::vector<byte> offsetChain(ALNLEN);
-	std::vector<byte> hash(BLOCK_SIZE);
+	if (m_offsetChain.size() < ALNLEN)
+		m_offsetChain.resize(ALNLEN);
 
 	// TODO: parallelize this with smaller chains?
 	for (size_t i = 0; i < BLKCNT; ++i)
 	{
-		GetLSub(Ntz(++m_mainBlockCount), hash);
-		Utility::MemUtils::XorBlock(hash, 0, m_mainOffset, 0, BLOCK_SIZE);
-		Utility::MemUtils::COPY128(m_mainOffset, 0, offsetChain, i * BLOCK_SIZE);
+		GetLSub(Ntz(++m_mainBlockCount), m_hashBlock);
+		Utility::MemUtils::XorBlock(m_hashBlock, 0, m_mainOffset, 0, BLOCK_SIZE);
+		Utility::MemUtils::COPY128(m_mainOffset, 0, m_offsetChain, i * BLOCK_SIZE);
 	}
 
 	// parallel offsets
@@ -589,9 +1002,9 @@ void OCB::ParallelDecrypt(const std::vector<byte> &Input, size_t InOffset, std::
 
 	while (Length >= PRLSZE)
 	{
-		Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Output, OutOffset, &offsetChain, chainPos, CNKSZE](size_t i)
+		Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Output, OutOffset, chainPos, CNKSZE](size_t i)
 		{
-			this->ProcessSegment(offsetChain, chainPos + (i * CNKSZE), Output, OutOffset + (i * CNKSZE), CNKSZE);
+			this->ProcessSegment(m_offsetChain, chainPos + (i * CNKSZE), Output, OutOffset + (i * CNKSZE), CNKSZE);
 		});
 
 		Length -= PRLSZE;
@@ -603,9 +1016,9 @@ void OCB::ParallelDecrypt(const std::vector<byte> &Input, size_t InOffset, std::
 	{
 		while (Length >= BLOCK_SIZE)
 		{
-			Utility::MemUtils::XorBlock(offsetChain, chainPos, Output, OutOffset, BLOCK_SIZE);
+			Utility::MemUtils::XorBlock(m_offsetChain, chainPos, Output, OutOffset, BLOCK_SIZE);
 			m_blockCipher->Transform(Output, OutOffset, Output, OutOffset);
-			Utility::MemUtils::XorBlock(offsetChain, chainPos, Output, OutOffset, BLOCK_SIZE);
+			Utility::MemUtils::XorBlock(m_offsetChain, chainPos, Output, OutOffset, BLOCK_SIZE);
 
 			Length -= BLOCK_SIZE;
 			OutOffset += BLOCK_SIZE;
@@ -634,15 +1047,15 @@ void OCB::ParallelEncrypt(const std::vector<byte> &Input, size_t InOffset, std::
 		Utility::MemUtils::XOR128(Output, OutOffset + (i * BLOCK_SIZE), m_checkSum, 0);
 
 	// create the offset chain
-	std::vector<byte> offsetChain(ALNLEN);
-	std::vector<byte> hash(BLOCK_SIZE);
+	if (m_offsetChain.size() < ALNLEN)
+		m_offsetChain.resize(ALNLEN);
 
 	// TODO: parallelize this with smaller chains?
 	for (size_t i = 0; i < BLKCNT; ++i)
 	{
-		GetLSub(Ntz(++m_mainBlockCount), hash);
-		Utility::MemUtils::XOR128(hash, 0, m_mainOffset, 0);
-		Utility::MemUtils::COPY128(m_mainOffset, 0, offsetChain, i * BLOCK_SIZE);
+		GetLSub(Ntz(++m_mainBlockCount), m_hashBlock);
+		Utility::MemUtils::XOR128(m_hashBlock, 0, m_mainOffset, 0);
+		Utility::MemUtils::COPY128(m_mainOffset, 0, m_offsetChain, i * BLOCK_SIZE);
 	}
 
 	// parallel offsets
@@ -652,9 +1065,9 @@ void OCB::ParallelEncrypt(const std::vector<byte> &Input, size_t InOffset, std::
 
 	while (Length >= PRLSZE)
 	{
-		Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Output, OutOffset, &offsetChain, chainPos, CNKSZE](size_t i)
+		Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Output, OutOffset, chainPos, CNKSZE](size_t i)
 		{
-			this->ProcessSegment(offsetChain, chainPos + (i * CNKSZE), Output, OutOffset + (i * CNKSZE), CNKSZE);
+			this->ProcessSegment(m_offsetChain, chainPos + (i * CNKSZE), Output, OutOffset + (i * CNKSZE), CNKSZE);
 		});
 
 		Length -= PRLSZE;
@@ -666,9 +1079,9 @@ void OCB::ParallelEncrypt(const std::vector<byte> &Input, size_t InOffset, std::
 	{
 		while (Length >= BLOCK_SIZE)
 		{
-			Utility::MemUtils::XOR128(offsetChain, chainPos, Output, OutOffset);
+			Utility::MemUtils::XOR128(m_offsetChain, chainPos, Output, OutOffset);
 			m_blockCipher->Transform(Output, OutOffset, Output, OutOffset);
-			Utility::MemUtils::XOR128(offsetChain, chainPos, Output, OutOffset);
+			Utility::MemUtils::XOR128(m_offsetChain, chainPos, Output, OutOffset);
 
 			Length -= BLOCK_SIZE;
 			OutOffset += BLOCK_SIZE;
@@ -690,23 +1103,21 @@ void OCB::ProcessPartial(const std::vector<byte> &Input, const size_t InOffset,
 		Utility::MemUtils::XorBlock(Output, OutOffset, m_checkSum, 0, Length + 1);
 		Utility::MemUtils::XOR128(m_listAsterisk, 0, m_mainOffset, 0);
 
-		std::vector<byte> pad(BLOCK_SIZE);
-		m_hashCipher->Transform(m_mainOffset, 0, pad, 0);
-		Utility::MemUtils::XOR128(pad, 0, Output, OutOffset);
+		m_hashCipher->Transform(m_mainOffset, 0, m_padBlock, 0);
+		Utility::MemUtils::XOR128(m_padBlock, 0, Output, OutOffset);
 	}
 	else
 	{
 		Utility::MemUtils::Copy(Input, InOffset, Output, OutOffset, Length);
 		Utility::MemUtils::XOR128(m_listAsterisk, 0, m_mainOffset, 0);
 
-		std::vector<byte> pad(BLOCK_SIZE);
-		m_hashCipher->Transform(m_mainOffset, 0, pad, 0);
-		Utility::MemUtils::XorBlock(pad, 0, Output, OutOffset, Length);
+		m_hashCipher->Transform(m_mainOffset, 0, m_padBlock, 0);
+		Utility::MemUtils::XorBlock(m_padBlock, 0, Output, OutOffset, Length);
 
-		std::vector<byte> tmp(BLOCK_SIZE);
-		Utility::MemUtils::Copy(Output, OutOffset, tmp, 0, Length);
-		ExtendBlock(tmp, Length);
-		Utility::MemUtils::XOR128(tmp, 0, m_checkSum, 0);
+		// the pad block is reused to extend the plaintext for the checksum
+		Utility::MemUtils::Copy(Output, OutOffset, m_padBlock, 0, Length);
+		ExtendBlock(m_padBlock, Length);
+		Utility::MemUtils::XOR128(m_padBlock, 0, m_checkSum, 0);
 	}
 }
 
@@ -727,7 +1138,8 @@ void OCB::Reset()
 	Utility::MemUtils::Clear(m_mainStretch, 0, m_mainStretch.size());
 	Utility::MemUtils::Clear(m_ocbVector, 0, m_ocbVector.size());
 	Utility::MemUtils::Clear(m_topInput, 0, m_topInput.size());
-	m_hashList.clear();
+	Utility::MemUtils::Clear(m_hashTable, 0, m_hashTable.size());
+	m_hashCount = 0;
 	m_isInitialized = false;
 }
 
@@ -741,8 +1153,11 @@ void OCB::Scope()
 		m_legalKeySizes[i] = SymmetricKeySize(keySizes[i].KeySize(), MAX_NONCESIZE, keySizes[i].NonceSize());
 	}
 
-	m_hashList.clear();
-	m_hashList.reserve(PREFETCH_HASH);
+	// L_0 through L_31; enough for a 2^32 block message, so the table does not grow in practice
+	if (m_hashTable.size() < PREFETCH_HASH)
+		m_hashTable.resize(PREFETCH_HASH);
+
+	m_hashCount = 0;
 
 	if (!m_parallelProfile.IsDefault())
 	{
@@ -750,4 +1165,33 @@ void OCB::Scope()
 	}
 }
 
+void OCB::TransformLanes(IBlockCipher* Cipher, const std::vector<byte> &Input, size_t InOffset, std::vector<byte> &Output, size_t OutOffset, size_t BlockCount)
+{
+#if defined(__AVX__)
+	const size_t LANELEN = BATCH_LANES * BLOCK_SIZE;
+
+	while (BlockCount >= BATCH_LANES)
+	{
+#	if defined(__AVX512__)
+		Cipher->Transform2048(Input, InOffset, Output, OutOffset);
+#	elif defined(__AVX2__)
+		Cipher->Transform1024(Input, InOffset, Output, OutOffset);
+#	else
+		Cipher->Transform512(Input, InOffset, Output, OutOffset);
+#	endif
+		InOffset += LANELEN;
+		OutOffset += LANELEN;
+		BlockCount -= BATCH_LANES;
+	}
+#endif
+
+	while (BlockCount != 0)
+	{
+		Cipher->Transform(Input, InOffset, Output, OutOffset);
+		InOffset += BLOCK_SIZE;
+		OutOffset += BLOCK_SIZE;
+		--BlockCount;
+	}
+}
+
 NAMESPACE_MODEEND
@@ -2,6 +2,7 @@
 #include "BlockCipherFromName.h"
 #include "IntUtils.h"
 #include "MemUtils.h"
+#include "SegmentUtils.h"
 
 NAMESPACE_MODE
 
@@ -82,7 +83,8 @@ OFB::OFB(BlockCiphers CipherType, size_t RegisterSize)
 	m_isInitialized(false),
 	m_ofbBuffer(m_blockCipher->BlockSize()),
 	m_ofbVector(m_blockCipher->BlockSize()),
-	m_parallelProfile(m_blockCipher->BlockSize(), false, m_blockCipher->StateCacheSize(), true)
+	m_parallelProfile(m_blockCipher->BlockSize(), false, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0)
 {
 	if (RegisterSize == 0)
 		throw CryptoCipherModeException("OFB:CTor", "The RegisterSize can not be zero!");
@@ -101,7 +103,8 @@ OFB::OFB(IBlockCipher* Cipher, size_t RegisterSize)
 	m_isInitialized(false),
 	m_ofbBuffer(m_blockCipher->BlockSize()),
 	m_ofbVector(m_blockCipher->BlockSize()),
-	m_parallelProfile(m_blockCipher->BlockSize(), false, m_blockCipher->StateCacheSize(), true)
+	m_parallelProfile(m_blockCipher->BlockSize(), false, m_blockCipher->StateCacheSize(), true),
+	m_segmentStage(0)
 {
 	if (m_blockSize < 1)
 		throw CryptoCipherModeException("OFB:CTor", "Invalid block size! Block must be in bits and a multiple of 8.");
@@ -148,6 +151,7 @@ void OFB::Destroy()
 
 		Utility::IntUtils::ClearVector(m_ofbVector);
 		Utility::IntUtils::ClearVector(m_ofbBuffer);
+		Utility::IntUtils::ClearVector(m_segmentStage);
 	}
 }
 
@@ -163,14 +167,16 @@ void OFB::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void OFB::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (KeyParams.Nonce().size() < 1)
+	SymmetricKeyView keyView(KeyParams);
+
+	if (keyView.Nonce().size() < 1)
 		throw CryptoSymmetricCipherException("OFB:Initialize", "Requires a minimum 1 bytes of Nonce!");
-	if (KeyParams.Nonce().size() > m_blockCipher->BlockSize())
+	if (keyView.Nonce().size() > m_blockCipher->BlockSize())
 		throw CryptoSymmetricCipherException("OFB:Initialize", "Nonce can not be larger than the cipher block size!");
-	if (!SymmetricKeySize::Contains(LegalKeySizes(), KeyParams.Key().size()))
+	if (!SymmetricKeySize::Contains(LegalKeySizes(), keyView.Key().size()))
 		throw CryptoSymmetricCipherException("ICM:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() members in length.");
 
-	std::vector<byte> tmpIv = KeyParams.Nonce();
+	std::vector<byte> tmpIv = keyView.Nonce();
 	m_blockCipher->Initialize(true, KeyParams);
 
 	if (tmpIv.size() < m_ofbVector.size())
@@ -207,6 +213,11 @@ void OFB::Transform(const std::vector<byte> &Input, const size_t InOffset, std::
 		EncryptBlock(Input, (i * BLKSZE) + InOffset, Output, (i * BLKSZE) + OutOffset);
 }
 
+void OFB::TransformSegments(const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output)
+{
+	Utility::SegmentUtils::Transform(this, Input, Output, m_segmentStage);
+}
+
 void OFB::Encrypt128(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset)
 {
 	CexAssert(m_isInitialized, "The cipher mode has not been initialized!");
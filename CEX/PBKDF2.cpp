@@ -142,19 +142,21 @@ size_t PBKDF2::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Leng
 
 void PBKDF2::Initialize(ISymmetricKey &GenParam)
 {
-	if (GenParam.Key().size() < MIN_PASSLEN)
+	SymmetricKeyView keyView(GenParam);
+
+	if (keyView.Key().size() < MIN_PASSLEN)
 		throw CryptoKdfException("PBKDF2:Initialize", "Key size is too small; must be a minumum of 4 bytes!");
 
-	if (GenParam.Nonce().size() != 0)
+	if (keyView.Nonce().size() != 0)
 	{
-		if (GenParam.Info().size() != 0)
-			Initialize(GenParam.Key(), GenParam.Nonce(), GenParam.Info());
+		if (keyView.Info().size() != 0)
+			Initialize(keyView.Key(), keyView.Nonce(), keyView.Info());
 		else
-			Initialize(GenParam.Key(), GenParam.Nonce());
+			Initialize(keyView.Key(), keyView.Nonce());
 	}
 	else
 	{
-		Initialize(GenParam.Key());
+		Initialize(keyView.Key());
 	}
 }
 
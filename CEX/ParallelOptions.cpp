@@ -1,6 +1,7 @@
 #include "ParallelOptions.h"
 #include "CpuDetect.h"
 #include "CryptoProcessingException.h"
+#include "ParallelUtils.h"
 
 NAMESPACE_COMMON
 
@@ -53,6 +54,16 @@ bool &ParallelOptions::IsParallel()
 	return m_isParallel;
 }
 
+bool &ParallelOptions::IsNumaAware()
+{
+	return m_numaAware;
+}
+
+const size_t ParallelOptions::NumaNodes()
+{
+	return m_numaNodes;
+}
+
 size_t &ParallelOptions::ParallelBlockSize() 
 {
 	return m_parallelBlockSize;
@@ -112,6 +123,8 @@ ParallelOptions::ParallelOptions(size_t BlockSize, bool SimdMultiply, size_t Res
 	m_isParallel(false),
 	m_l1DataCacheReserved(ReservedCache),
 	m_l1DataCacheTotal(0),
+	m_numaAware(false),
+	m_numaNodes(1),
 	m_overrideMaxDegree(false),
 	m_parallelBlockSize(0),
 	m_parallelMaxDegree(ParallelMaxDegree),
@@ -144,6 +157,8 @@ ParallelOptions::ParallelOptions(size_t BlockSize, bool Parallel, size_t Paralle
 	m_isParallel(Parallel),
 	m_l1DataCacheReserved(ReservedCache),
 	m_l1DataCacheTotal(0),
+	m_numaAware(false),
+	m_numaNodes(1),
 	m_overrideMaxDegree(false),
 	m_parallelBlockSize(ParallelBlockSize),
 	m_parallelMaxDegree(MaxDegree),
@@ -258,6 +273,8 @@ void ParallelOptions::Detect()
 
 	m_isParallel = (m_processorCount > 1);
 	m_l1DataCacheTotal = detect.L1DataCacheTotal();
+	m_numaNodes = Utility::ParallelUtils::NumaNodeCount();
+	m_numaAware = (m_numaNodes > 1);
 }
 
 void ParallelOptions::Reset()
@@ -271,6 +288,8 @@ void ParallelOptions::Reset()
 	m_l1DataCacheReserved = 0;
 	m_l1DataCacheTotal = 0;
 	m_isParallel = false;
+	m_numaAware = false;
+	m_numaNodes = 0;
 	m_parallelBlockSize = 0;
 	m_parallelMaxDegree = 0;
 	m_parallelMinimumSize = 0;
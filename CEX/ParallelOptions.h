@@ -50,6 +50,8 @@ private:
 	bool m_isParallel;
 	size_t m_l1DataCacheReserved;
 	size_t m_l1DataCacheTotal;
+	bool m_numaAware;
+	size_t m_numaNodes;
 	bool m_overrideMaxDegree;
 	size_t m_parallelBlockSize;
 	size_t m_parallelMaxDegree;
@@ -114,6 +116,17 @@ public:
 	/// </summary>
 	bool &IsParallel();
 
+	/// <summary>
+	/// Get/Set: Bind each parallel chunk to the NUMA node that holds its memory.
+	/// <para>Enabled by default on systems with more than one NUMA node. Buffers can be distributed across the nodes before processing with ParallelUtils::FirstTouch.</para>
+	/// </summary>
+	bool &IsNumaAware();
+
+	/// <summary>
+	/// Get: The number of NUMA nodes with processors; 1 on a uniform memory system
+	/// </summary>
+	const size_t NumaNodes();
+
 	/// <summary>
 	/// Get/Set: Parallel block size; must be a multiple of <see cref="ParallelMinimumSize"/>.</para>
 	/// </summary>
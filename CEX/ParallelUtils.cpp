@@ -6,8 +6,336 @@
 #	include <future>
 #endif
 
+#if defined(CEX_OS_WINDOWS)
+#	include <Windows.h>
+#	include <psapi.h>
+#	include <cstring>
+#	define CEX_PARALLEL_NUMA
+#elif defined(CEX_OS_LINUX)
+#	include <fstream>
+#	include <sched.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#	define CEX_PARALLEL_NUMA
+#endif
+
 NAMESPACE_UTILITY
 
+namespace
+{
+	/*! \cond PRIVATE */
+#if defined(CEX_PARALLEL_NUMA)
+#	if defined(CEX_OS_WINDOWS)
+	typedef GROUP_AFFINITY NodeMask;
+#	else
+	typedef cpu_set_t NodeMask;
+	// move_pages flag: migrate pages mapped only by this process
+	const int NUMA_MOVE = 2;
+	// the maximum number of pages passed to a single migration call
+	const size_t NUMA_PAGEBATCH = 1024;
+#	endif
+
+	struct NumaTopology
+	{
+		// the processors of each node, indexed by node ordinal
+		std::vector<NodeMask> Masks;
+		// the operating system node number of each ordinal
+		std::vector<int> Nodes;
+		size_t PageSize;
+	};
+
+#	if defined(CEX_OS_LINUX)
+	bool ReadList(const std::string &Path, std::vector<int> &Output)
+	{
+		// parses a sysfs list, ex. "0-3,8-11"
+		std::ifstream inpStream(Path);
+		std::string line;
+
+		if (!inpStream.is_open() || !std::getline(inpStream, line))
+		{
+			return false;
+		}
+
+		size_t pos = 0;
+
+		while (pos < line.size())
+		{
+			size_t len;
+			const int FIRST = std::stoi(line.substr(pos), &len);
+			int last = FIRST;
+			pos += len;
+
+			if (pos < line.size() && line[pos] == '-')
+			{
+				++pos;
+				last = std::stoi(line.substr(pos), &len);
+				pos += len;
+			}
+
+			for (int i = FIRST; i <= last; ++i)
+			{
+				Output.push_back(i);
+			}
+
+			if (pos < line.size() && line[pos] != ',')
+			{
+				break;
+			}
+
+			++pos;
+		}
+
+		return !Output.empty();
+	}
+#	endif
+
+	NumaTopology Detect()
+	{
+		NumaTopology topology;
+		topology.PageSize = 4096;
+
+#	if defined(CEX_OS_WINDOWS)
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		topology.PageSize = static_cast<size_t>(info.dwPageSize);
+		ULONG highNode = 0;
+
+		if (GetNumaHighestNodeNumber(&highNode) != 0)
+		{
+			for (ULONG i = 0; i <= highNode; ++i)
+			{
+				GROUP_AFFINITY mask;
+				std::memset(&mask, 0, sizeof(mask));
+
+				if (GetNumaNodeProcessorMaskEx(static_cast<USHORT>(i), &mask) != 0 && mask.Mask != 0)
+				{
+					topology.Masks.push_back(mask);
+					topology.Nodes.push_back(static_cast<int>(i));
+				}
+			}
+		}
+#	else
+		const long PAGLEN = sysconf(_SC_PAGESIZE);
+
+		if (PAGLEN > 0)
+		{
+			topology.PageSize = static_cast<size_t>(PAGLEN);
+		}
+
+		std::vector<int> nodes;
+
+		try
+		{
+			if (ReadList("/sys/devices/system/node/online", nodes))
+			{
+				for (size_t i = 0; i < nodes.size(); ++i)
+				{
+					std::vector<int> cpus;
+
+					// memory only nodes have an empty processor list
+					if (ReadList("/sys/devices/system/node/node" + std::to_string(nodes[i]) + "/cpulist", cpus))
+					{
+						cpu_set_t mask;
+						CPU_ZERO(&mask);
+
+						for (size_t j = 0; j < cpus.size(); ++j)
+						{
+							if (cpus[j] < CPU_SETSIZE)
+							{
+								CPU_SET(cpus[j], &mask);
+							}
+						}
+
+						topology.Masks.push_back(mask);
+						topology.Nodes.push_back(nodes[i]);
+					}
+				}
+			}
+		}
+		catch (std::exception&)
+		{
+			// a malformed list; treat the system as uniform
+			topology.Masks.clear();
+			topology.Nodes.clear();
+		}
+#	endif
+
+		return topology;
+	}
+
+	const NumaTopology &Topology()
+	{
+		static const NumaTopology TOPOLOGY = Detect();
+
+		return TOPOLOGY;
+	}
+
+	size_t DefaultNode(size_t Index, size_t Count)
+	{
+		// chunks are spread over the nodes in contiguous runs
+		return (Index * Topology().Nodes.size()) / Count;
+	}
+
+	size_t PageNode(const void* Address, size_t Default)
+	{
+		// the ordinal of the node that holds the page, or the default if the page is not resident
+		const NumaTopology &TPG = Topology();
+		int node = -1;
+
+#	if defined(CEX_OS_WINDOWS)
+		PSAPI_WORKING_SET_EX_INFORMATION info;
+		info.VirtualAddress = const_cast<void*>(Address);
+
+		if (QueryWorkingSetEx(GetCurrentProcess(), &info, sizeof(info)) != 0 && info.VirtualAttributes.Valid != 0)
+		{
+			node = static_cast<int>(info.VirtualAttributes.Node);
+		}
+#	elif defined(SYS_move_pages)
+		void* page = const_cast<void*>(Address);
+		int status = -1;
+
+		// with no target nodes, move_pages only reports the node of each page
+		if (syscall(SYS_move_pages, 0, 1UL, &page, nullptr, &status, 0) == 0)
+		{
+			node = status;
+		}
+#	endif
+
+		for (size_t i = 0; i < TPG.Nodes.size(); ++i)
+		{
+			if (TPG.Nodes[i] == node)
+			{
+				return i;
+			}
+		}
+
+		return Default;
+	}
+
+	class NodeScope
+	{
+	private:
+
+		bool m_isBound;
+		NodeMask m_prevMask;
+
+	public:
+
+		// binds the calling thread to the processors of a node, and restores the previous affinity when released
+		explicit NodeScope(size_t Node)
+			:
+			m_isBound(false),
+			m_prevMask()
+		{
+#	if defined(CEX_OS_WINDOWS)
+			m_isBound = (SetThreadGroupAffinity(GetCurrentThread(), &Topology().Masks[Node], &m_prevMask) != 0);
+#	else
+			if (sched_getaffinity(0, sizeof(m_prevMask), &m_prevMask) == 0)
+			{
+				m_isBound = (sched_setaffinity(0, sizeof(NodeMask), &Topology().Masks[Node]) == 0);
+			}
+#	endif
+		}
+
+		~NodeScope()
+		{
+			if (m_isBound)
+			{
+#	if defined(CEX_OS_WINDOWS)
+				SetThreadGroupAffinity(GetCurrentThread(), &m_prevMask, nullptr);
+#	else
+				sched_setaffinity(0, sizeof(m_prevMask), &m_prevMask);
+#	endif
+			}
+		}
+
+		NodeScope(const NodeScope&) = delete;
+		NodeScope& operator=(const NodeScope&) = delete;
+	};
+
+	void PlaceChunk(byte* Output, size_t Length, size_t Node)
+	{
+		const NumaTopology &TPG = Topology();
+		const size_t PAGLEN = TPG.PageSize;
+		// the chunk is placed from its first page boundary; a page that straddles the chunk start is left to the preceding chunk
+		const size_t HDRLEN = (PAGLEN - (reinterpret_cast<size_t>(Output) % PAGLEN)) % PAGLEN;
+
+		if (HDRLEN >= Length)
+		{
+			return;
+		}
+
+#	if defined(CEX_OS_LINUX) && defined(SYS_move_pages)
+		const size_t PAGCNT = (Length - HDRLEN + PAGLEN - 1) / PAGLEN;
+		std::vector<void*> pages(NUMA_PAGEBATCH);
+		std::vector<int> nodes(NUMA_PAGEBATCH, TPG.Nodes[Node]);
+		std::vector<int> status(NUMA_PAGEBATCH);
+
+		for (size_t i = 0; i < PAGCNT; i += NUMA_PAGEBATCH)
+		{
+			const size_t BATCNT = (PAGCNT - i < NUMA_PAGEBATCH) ? PAGCNT - i : NUMA_PAGEBATCH;
+
+			for (size_t j = 0; j < BATCNT; ++j)
+			{
+				pages[j] = Output + HDRLEN + ((i + j) * PAGLEN);
+			}
+
+			// migration is best effort; pages that are not resident or can not be moved are left in place
+			syscall(SYS_move_pages, 0, static_cast<unsigned long>(BATCNT), pages.data(), nodes.data(), status.data(), NUMA_MOVE);
+		}
+#	endif
+
+		// touch each page from this thread, which allocates any page that is not yet backed on the local node
+		for (size_t i = HDRLEN; i < Length; i += PAGLEN)
+		{
+			volatile byte* pagPtr = Output + i;
+			*pagPtr = *pagPtr;
+		}
+	}
+#endif
+	/*! \endcond */
+}
+
+void ParallelUtils::FirstTouch(void* Output, size_t Length, size_t Degree)
+{
+#if defined(CEX_PARALLEL_NUMA)
+	if (Output == nullptr || Length == 0 || Degree == 0 || Topology().Nodes.empty())
+	{
+		return;
+	}
+
+	byte* outPtr = static_cast<byte*>(Output);
+	const size_t CNKLEN = (Length + Degree - 1) / Degree;
+
+	ParallelFor(0, Degree, [outPtr, Length, Degree, CNKLEN](size_t i)
+	{
+		const size_t OFFSET = i * CNKLEN;
+
+		if (OFFSET < Length)
+		{
+			const size_t NODE = DefaultNode(i, Degree);
+			NodeScope scope(NODE);
+			PlaceChunk(outPtr + OFFSET, (Length - OFFSET < CNKLEN) ? Length - OFFSET : CNKLEN, NODE);
+		}
+	});
+#else
+	static_cast<void>(Output);
+	static_cast<void>(Length);
+	static_cast<void>(Degree);
+#endif
+}
+
+size_t ParallelUtils::NumaNodeCount()
+{
+#if defined(CEX_PARALLEL_NUMA)
+	const size_t NODCNT = Topology().Nodes.size();
+
+	return (NODCNT != 0) ? NODCNT : 1;
+#else
+	return 1;
+#endif
+}
+
 size_t ParallelUtils::ProcessorCount()
 {
 #if defined(_OPENMP)
@@ -46,6 +374,37 @@ void ParallelUtils::ParallelFor(size_t From, size_t To, const std::function<void
 #endif
 }
 
+void ParallelUtils::ParallelFor(size_t From, size_t To, const void* Data, size_t ChunkSize, const std::function<void(size_t)> &F)
+{
+#if defined(CEX_PARALLEL_NUMA)
+	if (Data == nullptr || From >= To || Topology().Nodes.empty())
+	{
+		ParallelFor(From, To, F);
+		return;
+	}
+
+	const byte* DATPTR = static_cast<const byte*>(Data);
+	const size_t CNKCNT = To - From;
+	std::vector<size_t> nodes(CNKCNT);
+
+	// resolve the owning node of each chunk before the threads start
+	for (size_t i = 0; i < CNKCNT; ++i)
+	{
+		nodes[i] = PageNode(DATPTR + (i * ChunkSize), DefaultNode(i, CNKCNT));
+	}
+
+	ParallelFor(From, To, [From, &nodes, &F](size_t i)
+	{
+		NodeScope scope(nodes[i - From]);
+		F(i);
+	});
+#else
+	static_cast<void>(Data);
+	static_cast<void>(ChunkSize);
+	ParallelFor(From, To, F);
+#endif
+}
+
 void ParallelUtils::ParallelTask(const std::function<void()> &F)
 {
 #if defined(_OPENMP)
@@ -45,6 +45,36 @@ public:
 	/// <param name="F">The function delegate</param>
 	static void ParallelFor(size_t From, size_t To, const std::function<void(size_t)> &F);
 
+	/// <summary>
+	/// A multi-threaded parallel For loop that runs each index on the NUMA node holding its data.
+	/// <para>Index i processes the chunk at Data + ((i - From) * ChunkSize); the thread that runs it is bound to the processors of the node that owns the first page of that chunk.
+	/// Chunks whose pages are not yet resident are assigned to nodes in the order used by <see cref="FirstTouch"/>.
+	/// If Data is null or the topology can not be read, this is the same as the standard ParallelFor.</para>
+	/// </summary>
+	/// 
+	/// <param name="From">The inclusive starting position</param> 
+	/// <param name="To">The exclusive ending position</param>
+	/// <param name="Data">The base address of the chunked data, normally the output array</param>
+	/// <param name="ChunkSize">The byte length of the chunk processed by each index</param>
+	/// <param name="F">The function delegate</param>
+	static void ParallelFor(size_t From, size_t To, const void* Data, size_t ChunkSize, const std::function<void(size_t)> &F);
+
+	/// <summary>
+	/// Distribute the pages of an I/O buffer across the NUMA nodes, in the chunk order used by the NUMA ParallelFor.
+	/// <para>The buffer is split into Degree chunks, and each chunk is touched by a thread bound to its node; pages that are not yet backed by memory are allocated on that node (first-touch).
+	/// On Linux, pages that are already resident on another node are migrated. The contents of the buffer are not changed.</para>
+	/// </summary>
+	/// 
+	/// <param name="Output">The buffer to distribute</param>
+	/// <param name="Length">The byte length of the buffer</param>
+	/// <param name="Degree">The number of chunks; normally the ParallelMaxDegree of the algorithm that will process the buffer</param>
+	static void FirstTouch(void* Output, size_t Length, size_t Degree);
+
+	/// <summary>
+	/// Get: The number of NUMA nodes with processors; returns 1 on a uniform memory system, or if the topology can not be read
+	/// </summary>
+	static size_t NumaNodeCount();
+
 	/// <summary>
 	/// An SIMD vectorized For loop
 	/// </summary>
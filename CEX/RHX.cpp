@@ -178,18 +178,20 @@ void RHX::EncryptBlock(const std::vector<byte> &Input, const size_t InOffset, st
 
 void RHX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(m_legalKeySizes, KeyParams.Key().size()))
+	SymmetricKeyView keyView(KeyParams);
+
+	if (!SymmetricKeySize::Contains(m_legalKeySizes, keyView.Key().size()))
 		throw CryptoSymmetricCipherException("RHX:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
-	if (m_kdfEngineType != Enumeration::Digests::None && KeyParams.Info().size() > m_kdfInfoMax)
+	if (m_kdfEngineType != Enumeration::Digests::None && keyView.Info().size() > m_kdfInfoMax)
 		throw CryptoSymmetricCipherException("RHX:Initialize", "Invalid info size! Info parameter must be no longer than DistributionCodeMax size.");
 
-	if (KeyParams.Info().size() > 0)
-		m_kdfInfo = KeyParams.Info();
+	if (keyView.Info().size() > 0)
+		m_kdfInfo = keyView.Info();
 
 	m_isEncryption = Encryption;
-	m_cprKeySize = KeyParams.Key().size() * 8;
+	m_cprKeySize = keyView.Key().size() * 8;
 	// expand the key
-	ExpandKey(Encryption, KeyParams.Key());
+	ExpandKey(Encryption, keyView.Key());
 
 #if defined(CEX_PREFETCH_RHX_TABLES)
 	Prefetch();
@@ -453,7 +455,7 @@ void RHX::StandardExpand(const std::vector<byte> &Key)
 	}
 }
 
-void RHX::ExpandRotBlock(std::vector<uint> &Key, size_t KeyIndex, size_t KeyOffset, size_t RconIndex)
+void RHX::ExpandRotBlock(Utility::SecureVector<uint> &Key, size_t KeyIndex, size_t KeyOffset, size_t RconIndex)
 {
 	size_t sub = KeyIndex - KeyOffset;
 
@@ -466,7 +468,7 @@ void RHX::ExpandRotBlock(std::vector<uint> &Key, size_t KeyIndex, size_t KeyOffs
 	Key[KeyIndex] = Key[++sub] ^ Key[KeyIndex - 1];
 }
 
-void RHX::ExpandSubBlock(std::vector<uint> &Key, size_t KeyIndex, size_t KeyOffset)
+void RHX::ExpandSubBlock(Utility::SecureVector<uint> &Key, size_t KeyIndex, size_t KeyOffset)
 {
 	size_t sub = KeyIndex - KeyOffset;
 
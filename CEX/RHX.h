@@ -35,6 +35,7 @@
 #define CEX_RHX_H
 
 #include "IBlockCipher.h"
+#include "SecureAllocator.h"
 
 NAMESPACE_BLOCK
 
@@ -94,6 +95,7 @@ NAMESPACE_BLOCK
 /// <item><description>The internal block size is 16 bytes wide.</description></item>
 /// <item><description>Diffusion rounds assignments are 10 to 38, the default is 22 (128-256 bit key), a 512 bit key is automatically assigned 22 rounds.</description></item>
 /// <item><description>Valid rounds assignments can be found in the <see cref="LegalRounds"/> property.</description></item>
+/// <item><description>The round keys are stored in the page locked <see cref="Utility::SecureArena"/>, and are zeroed when the cipher is destroyed.</description></item>
 /// </list>
 /// 
 /// <description>Guiding Publications:</description>
@@ -126,7 +128,7 @@ private:
 
 	size_t m_cprKeySize;
 	bool m_destroyEngine;
-	std::vector<uint> m_expKey;
+	Utility::SecureVector<uint> m_expKey;
 	std::vector<byte> m_kdfInfo;
 	bool m_isDestroyed;
 	bool m_isEncryption;
@@ -382,8 +384,8 @@ private:
 	void Encrypt1024(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void Encrypt2048(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset);
 	void ExpandKey(bool Encryption, const std::vector<byte> &Key);
-	void ExpandRotBlock(std::vector<uint> &Key, size_t KeyIndex, size_t KeyOffset, size_t RconIndex);
-	void ExpandSubBlock(std::vector<uint> &Key, size_t KeyIndex, size_t KeyOffset);
+	void ExpandRotBlock(Utility::SecureVector<uint> &Key, size_t KeyIndex, size_t KeyOffset, size_t RconIndex);
+	void ExpandSubBlock(Utility::SecureVector<uint> &Key, size_t KeyIndex, size_t KeyOffset);
 	void LoadState(Digests KdfEngineType);
 	void Prefetch();
 	void SecureExpand(const std::vector<byte> &Key);
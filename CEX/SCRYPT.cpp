@@ -129,19 +129,21 @@ size_t SCRYPT::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Leng
 
 void SCRYPT::Initialize(ISymmetricKey &GenParam)
 {
-	if (GenParam.Key().size() < MIN_PASSLEN)
+	SymmetricKeyView keyView(GenParam);
+
+	if (keyView.Key().size() < MIN_PASSLEN)
 		throw CryptoKdfException("SCRYPT:Initialize", "Key size is too small; must be a minumum of 4 bytes!");
 
-	if (GenParam.Nonce().size() != 0)
+	if (keyView.Nonce().size() != 0)
 	{
-		if (GenParam.Info().size() != 0)
-			Initialize(GenParam.Key(), GenParam.Nonce(), GenParam.Info());
+		if (keyView.Info().size() != 0)
+			Initialize(keyView.Key(), keyView.Nonce(), keyView.Info());
 		else
-			Initialize(GenParam.Key(), GenParam.Nonce());
+			Initialize(keyView.Key(), keyView.Nonce());
 	}
 	else
 	{
-		Initialize(GenParam.Key());
+		Initialize(keyView.Key());
 	}
 }
 
@@ -219,9 +221,8 @@ void SCRYPT::Reset()
 
 //~~~Private Functions~~~//
 
-void SCRYPT::BlockMix(std::vector<uint> &State, std::vector<uint> &Y)
+void SCRYPT::BlockMix(std::vector<uint> &State, std::vector<uint> &Y, std::vector<uint> &X)
 {
-	std::vector<uint> X(16);
 	Utility::MemUtils::Copy(State, State.size() - 16, X, 0, 16 * sizeof(uint));
 
 	for (size_t i = 0; i < 2 * MEM_COST; i += 2)
@@ -311,7 +312,10 @@ void SCRYPT::SalsaCore(std::vector<uint> &State)
 	X1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&State[4]));
 	X2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&State[8]));
 	X3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&State[12]));
-	std::vector<__m128i> B { X0, X1, X2, X3};
+	const __m128i B0 = X0;
+	const __m128i B1 = X1;
+	const __m128i B2 = X2;
+	const __m128i B3 = X3;
 
 	for (size_t i = 0; i < 8; i += 2)
 	{
@@ -350,10 +354,10 @@ void SCRYPT::SalsaCore(std::vector<uint> &State)
 		X3 = _mm_shuffle_epi32(X3, 0x93);
 	}
 
-	_mm_storeu_si128(reinterpret_cast<__m128i*>(&State[0]), _mm_add_epi32(B[0], X0));
-	_mm_storeu_si128(reinterpret_cast<__m128i*>(&State[4]), _mm_add_epi32(B[1], X1));
-	_mm_storeu_si128(reinterpret_cast<__m128i*>(&State[8]), _mm_add_epi32(B[2], X2));
-	_mm_storeu_si128(reinterpret_cast<__m128i*>(&State[12]), _mm_add_epi32(B[3], X3));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(&State[0]), _mm_add_epi32(B0, X0));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(&State[4]), _mm_add_epi32(B1, X1));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(&State[8]), _mm_add_epi32(B2, X2));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(&State[12]), _mm_add_epi32(B3, X3));
 }
 
 #else
@@ -466,24 +470,26 @@ void SCRYPT::Scope()
 void SCRYPT::SMix(std::vector<uint> &State, size_t StateOffset, size_t N)
 {
 	size_t bCount = MEM_COST * 32;
+	std::vector<uint> B(16);
 	std::vector<uint> X(bCount);
 	std::vector<uint> Y(bCount);
-	std::vector<std::vector<uint>> V(N);
+	// the rows are stored contiguously in a single allocation
+	std::vector<uint> V(N * bCount);
 
 	Utility::MemUtils::Copy(State, StateOffset, X, 0, bCount * sizeof(uint));
 
 	for (size_t i = 0; i < N; ++i)
 	{
-		V[i] = X;
-		BlockMix(X, Y);
+		Utility::MemUtils::Copy(X, 0, V, i * bCount, bCount * sizeof(uint));
+		BlockMix(X, Y, B);
 	}
 
 	const uint NMASK = (uint)N - 1;
 	for (size_t i = 0; i < N; ++i)
 	{
 		uint j = X[bCount - 16] & NMASK;
-		Utility::MemUtils::XorBlock(V[j], 0, X, 0, X.size() * sizeof(uint));
-		BlockMix(X, Y);
+		Utility::MemUtils::XorBlock(V, j * bCount, X, 0, X.size() * sizeof(uint));
+		BlockMix(X, Y, B);
 	}
 
 	Utility::MemUtils::Copy(X, 0, State, StateOffset, bCount * sizeof(uint));
@@ -286,7 +286,7 @@ public:
 
 private:
 
-	void BlockMix(std::vector<uint> &State, std::vector<uint> &Y);
+	void BlockMix(std::vector<uint> &State, std::vector<uint> &Y, std::vector<uint> &X);
 	size_t Expand(std::vector<byte> &Output, size_t OutOffset, size_t Length);
 	void Extract(std::vector<byte> &Output, size_t OutOffset, std::vector<byte> &Key, std::vector<byte> &Salt, size_t Length);
 	void SalsaCore(std::vector<uint> &Output);
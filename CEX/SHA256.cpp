@@ -2,6 +2,9 @@
 #include "IntUtils.h"
 #include "MemUtils.h"
 #include "ParallelUtils.h"
+#include "SegmentUtils.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
 #if defined(__AVX__)
 #	include "Intrinsics.h"
 #endif
@@ -59,6 +62,7 @@ SHA256::SHA256(bool Parallel)
 	m_msgBuffer(Parallel ? DEF_PRLDEGREE * BLOCK_SIZE : BLOCK_SIZE),
 	m_msgLength(0),
 	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, DEF_PRLDEGREE),
+	m_segmentStage(0),
 	m_dgtState(Parallel ? DEF_PRLDEGREE : 1)
 {
 	if (m_parallelProfile.IsParallel())
@@ -74,7 +78,8 @@ SHA256::SHA256(SHA2Params &Params)
 	m_isDestroyed(false),
 	m_msgBuffer(BLOCK_SIZE),
 	m_msgLength(0),
-	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, m_treeParams.FanOut())
+	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, m_treeParams.FanOut()),
+	m_segmentStage(0)
 {
 	if (m_treeParams.FanOut() > 1)
 	{
@@ -114,6 +119,7 @@ void SHA256::Destroy()
 			m_dgtState[i].Reset();
 
 		Utility::IntUtils::ClearVector(m_msgBuffer);
+		Utility::IntUtils::ClearVector(m_segmentStage);
 		Utility::IntUtils::ClearVector(m_dgtState);
 	}
 }
@@ -182,6 +188,54 @@ size_t SHA256::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 	return DIGEST_SIZE;
 }
 
+void SHA256::LoadState(const std::vector<byte> &State)
+{
+	if (State.size() < 10 + sizeof(ushort))
+		throw CryptoDigestException("SHA256:LoadState", "The state array is too short!");
+
+	IO::MemoryStream strm(State);
+	IO::StreamReader reader(strm);
+
+	if (reader.ReadByte() != STATE_VERSION)
+		throw CryptoDigestException("SHA256:LoadState", "The state version is not supported!");
+	if (reader.ReadByte() != static_cast<byte>(Digests::SHA256))
+		throw CryptoDigestException("SHA256:LoadState", "The state was not created by this digest!");
+
+	const size_t LEAFCNT = reader.ReadInt<uint>();
+	if (LEAFCNT != m_dgtState.size())
+		throw CryptoDigestException("SHA256:LoadState", "The number of tree leaves does not match this digest instance!");
+
+	const size_t PRMLEN = reader.ReadInt<ushort>();
+	if (reader.Position() + PRMLEN + sizeof(uint) > State.size())
+		throw CryptoDigestException("SHA256:LoadState", "The state array is malformed!");
+
+	// the tree parameters are fixed by the instance settings; a state hashed under different parameters is rejected, not adopted
+	if (PRMLEN != m_treeParams.ToBytes().size())
+		throw CryptoDigestException("SHA256:LoadState", "The tree parameters do not match this digest instance!");
+
+	SHA2Params params(reader.ReadBytes(PRMLEN));
+	// the node offset is rewritten as each leaf is reset
+	params.NodeOffset() = m_treeParams.NodeOffset();
+
+	if (params.ToBytes() != m_treeParams.ToBytes())
+		throw CryptoDigestException("SHA256:LoadState", "The tree parameters do not match this digest instance!");
+
+	const size_t MSGLEN = reader.ReadInt<uint>();
+
+	if (MSGLEN > m_msgBuffer.size() || reader.Position() + MSGLEN + (LEAFCNT * ((8 * sizeof(uint)) + sizeof(ulong))) != State.size())
+		throw CryptoDigestException("SHA256:LoadState", "The state array is malformed!");
+
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	reader.Read(m_msgBuffer, 0, MSGLEN);
+	m_msgLength = MSGLEN;
+
+	for (size_t i = 0; i < m_dgtState.size(); ++i)
+	{
+		reader.Read(m_dgtState[i].H, 0, m_dgtState[i].H.size());
+		m_dgtState[i].T = reader.ReadInt<ulong>();
+	}
+}
+
 void SHA256::ParallelMaxDegree(size_t Degree)
 {
 	if (Degree == 0)
@@ -217,6 +271,28 @@ void SHA256::Reset()
 	}
 }
 
+std::vector<byte> SHA256::SaveState()
+{
+	std::vector<byte> params = m_treeParams.ToBytes();
+	IO::StreamWriter writer(10 + sizeof(ushort) + params.size() + m_msgLength + (m_dgtState.size() * ((8 * sizeof(uint)) + sizeof(ulong))));
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Digests::SHA256));
+	writer.Write(static_cast<uint>(m_dgtState.size()));
+	writer.Write(static_cast<ushort>(params.size()));
+	writer.Write(params, 0, params.size());
+	writer.Write(static_cast<uint>(m_msgLength));
+	writer.Write(m_msgBuffer, 0, m_msgLength);
+
+	for (size_t i = 0; i < m_dgtState.size(); ++i)
+	{
+		writer.Write(m_dgtState[i].H);
+		writer.Write(m_dgtState[i].T);
+	}
+
+	return writer.GetBytes();
+}
+
 void SHA256::Update(byte Input)
 {
 	std::vector<byte> inp(1, Input);
@@ -309,6 +385,11 @@ void SHA256::Update(const std::vector<byte> &Input, size_t InOffset, size_t Leng
 	}
 }
 
+void SHA256::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input, m_segmentStage);
+}
+
 //~~~Private Functions~~~//
 
 uint SHA256::BigSigma0(uint W)
@@ -498,7 +579,7 @@ void SHA256::Compress64W(const std::vector<byte> &Input, size_t InOffset, SHA256
 	__m128i M0, M1, M2, M3;
 
 	// Load initial values
-	TMP = _mm_loadu_si128(reinterpret_cast<__m128i*>(&Output.H));
+	TMP = _mm_loadu_si128(reinterpret_cast<__m128i*>(&Output.H[0]));
 	S1 = _mm_loadu_si128(reinterpret_cast<__m128i*>(&Output.H[4]));
 	MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
 	TMP = _mm_shuffle_epi32(TMP, 0xB1);  // CDAB
@@ -672,6 +753,8 @@ void SHA256::Compress64W(const std::vector<byte> &Input, size_t InOffset, SHA256
 	// Save state
 	_mm_storeu_si128(reinterpret_cast<__m128i*>(&Output.H[0]), S0);
 	_mm_storeu_si128(reinterpret_cast<__m128i*>(&Output.H[4]), S1);
+
+	Output.T += BLOCK_SIZE;
 #else
 	Compress64(Input, InOffset, Output);
 #endif
@@ -2,11 +2,41 @@
 #include "IntUtils.h"
 #include "MemUtils.h"
 #include "ParallelUtils.h"
+#include "SegmentUtils.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
+#if defined(__AVX2__)
+#	include "Intrinsics.h"
+#endif
 
 NAMESPACE_DIGEST
 
 const std::string SHA512::CLASS_NAME("SHA512");
 
+const std::vector<ulong> SHA512::K =
+{
+	0x428A2F98D728AE22ULL, 0x7137449123EF65CDULL, 0xB5C0FBCFEC4D3B2FULL, 0xE9B5DBA58189DBBCULL,
+	0x3956C25BF348B538ULL, 0x59F111F1B605D019ULL, 0x923F82A4AF194F9BULL, 0xAB1C5ED5DA6D8118ULL,
+	0xD807AA98A3030242ULL, 0x12835B0145706FBEULL, 0x243185BE4EE4B28CULL, 0x550C7DC3D5FFB4E2ULL,
+	0x72BE5D74F27B896FULL, 0x80DEB1FE3B1696B1ULL, 0x9BDC06A725C71235ULL, 0xC19BF174CF692694ULL,
+	0xE49B69C19EF14AD2ULL, 0xEFBE4786384F25E3ULL, 0x0FC19DC68B8CD5B5ULL, 0x240CA1CC77AC9C65ULL,
+	0x2DE92C6F592B0275ULL, 0x4A7484AA6EA6E483ULL, 0x5CB0A9DCBD41FBD4ULL, 0x76F988DA831153B5ULL,
+	0x983E5152EE66DFABULL, 0xA831C66D2DB43210ULL, 0xB00327C898FB213FULL, 0xBF597FC7BEEF0EE4ULL,
+	0xC6E00BF33DA88FC2ULL, 0xD5A79147930AA725ULL, 0x06CA6351E003826FULL, 0x142929670A0E6E70ULL,
+	0x27B70A8546D22FFCULL, 0x2E1B21385C26C926ULL, 0x4D2C6DFC5AC42AEDULL, 0x53380D139D95B3DFULL,
+	0x650A73548BAF63DEULL, 0x766A0ABB3C77B2A8ULL, 0x81C2C92E47EDAEE6ULL, 0x92722C851482353BULL,
+	0xA2BFE8A14CF10364ULL, 0xA81A664BBC423001ULL, 0xC24B8B70D0F89791ULL, 0xC76C51A30654BE30ULL,
+	0xD192E819D6EF5218ULL, 0xD69906245565A910ULL, 0xF40E35855771202AULL, 0x106AA07032BBD1B8ULL,
+	0x19A4C116B8D2D0C8ULL, 0x1E376C085141AB53ULL, 0x2748774CDF8EEB99ULL, 0x34B0BCB5E19B48A8ULL,
+	0x391C0CB3C5C95A63ULL, 0x4ED8AA4AE3418ACBULL, 0x5B9CCA4F7763E373ULL, 0x682E6FF3D6B2B8A3ULL,
+	0x748F82EE5DEFB2FCULL, 0x78A5636F43172F60ULL, 0x84C87814A1F0AB72ULL, 0x8CC702081A6439ECULL,
+	0x90BEFFFA23631E28ULL, 0xA4506CEBDE82BDE9ULL, 0xBEF9A3F7B2C67915ULL, 0xC67178F2E372532BULL,
+	0xCA273ECEEA26619CULL, 0xD186B8C721C0C207ULL, 0xEADA7DD6CDE0EB1EULL, 0xF57D4F7FEE6ED178ULL,
+	0x06F067AA72176FBAULL, 0x0A637DC5A2C898A6ULL, 0x113F9804BEF90DAEULL, 0x1B710B35131C471BULL,
+	0x28DB77F523047D84ULL, 0x32CAAB7B40C72493ULL, 0x3C9EBE0A15C9BEBCULL, 0x431D67C49C100D4CULL,
+	0x4CC5D4BECB3E42B6ULL, 0x597F299CFC657E2AULL, 0x5FCB6FAB3AD6FAECULL, 0x6C44198C4A475817ULL
+};
+
 // *** Properties *** //
 
 size_t SHA512::BlockSize() 
@@ -56,6 +86,7 @@ SHA512::SHA512(bool Parallel)
 	m_msgBuffer(Parallel ? DEF_PRLDEGREE * BLOCK_SIZE : BLOCK_SIZE),
 	m_msgLength(0),
 	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, DEF_PRLDEGREE),
+	m_segmentStage(0),
 	m_dgtState(Parallel ? DEF_PRLDEGREE : 1)
 {
 	if (m_parallelProfile.IsParallel())
@@ -71,7 +102,8 @@ SHA512::SHA512(SHA2Params &Params)
 	m_isDestroyed(false),
 	m_msgBuffer(BLOCK_SIZE),
 	m_msgLength(0),
-	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, m_treeParams.FanOut())
+	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, m_treeParams.FanOut()),
+	m_segmentStage(0)
 {
 	if (m_treeParams.FanOut() > 1)
 	{
@@ -112,6 +144,7 @@ void SHA512::Destroy()
 
 		Utility::IntUtils::ClearVector(m_dgtState);
 		Utility::IntUtils::ClearVector(m_msgBuffer);
+		Utility::IntUtils::ClearVector(m_segmentStage);
 	}
 }
 
@@ -179,6 +212,54 @@ size_t SHA512::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 	return DIGEST_SIZE;
 }
 
+void SHA512::LoadState(const std::vector<byte> &State)
+{
+	if (State.size() < 10 + sizeof(ushort))
+		throw CryptoDigestException("SHA512:LoadState", "The state array is too short!");
+
+	IO::MemoryStream strm(State);
+	IO::StreamReader reader(strm);
+
+	if (reader.ReadByte() != STATE_VERSION)
+		throw CryptoDigestException("SHA512:LoadState", "The state version is not supported!");
+	if (reader.ReadByte() != static_cast<byte>(Digests::SHA512))
+		throw CryptoDigestException("SHA512:LoadState", "The state was not created by this digest!");
+
+	const size_t LEAFCNT = reader.ReadInt<uint>();
+	if (LEAFCNT != m_dgtState.size())
+		throw CryptoDigestException("SHA512:LoadState", "The number of tree leaves does not match this digest instance!");
+
+	const size_t PRMLEN = reader.ReadInt<ushort>();
+	if (reader.Position() + PRMLEN + sizeof(uint) > State.size())
+		throw CryptoDigestException("SHA512:LoadState", "The state array is malformed!");
+
+	// the tree parameters are fixed by the instance settings; a state hashed under different parameters is rejected, not adopted
+	if (PRMLEN != m_treeParams.ToBytes().size())
+		throw CryptoDigestException("SHA512:LoadState", "The tree parameters do not match this digest instance!");
+
+	SHA2Params params(reader.ReadBytes(PRMLEN));
+	// the node offset is rewritten as each leaf is reset
+	params.NodeOffset() = m_treeParams.NodeOffset();
+
+	if (params.ToBytes() != m_treeParams.ToBytes())
+		throw CryptoDigestException("SHA512:LoadState", "The tree parameters do not match this digest instance!");
+
+	const size_t MSGLEN = reader.ReadInt<uint>();
+
+	if (MSGLEN > m_msgBuffer.size() || reader.Position() + MSGLEN + (LEAFCNT * (10 * sizeof(ulong))) != State.size())
+		throw CryptoDigestException("SHA512:LoadState", "The state array is malformed!");
+
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	reader.Read(m_msgBuffer, 0, MSGLEN);
+	m_msgLength = MSGLEN;
+
+	for (size_t i = 0; i < m_dgtState.size(); ++i)
+	{
+		reader.Read(m_dgtState[i].H, 0, m_dgtState[i].H.size());
+		reader.Read(m_dgtState[i].T, 0, m_dgtState[i].T.size());
+	}
+}
+
 void SHA512::ParallelMaxDegree(size_t Degree)
 {
 	if (Degree == 0)
@@ -209,11 +290,36 @@ void SHA512::Reset()
 		if (m_parallelProfile.IsParallel())
 		{
 			m_treeParams.NodeOffset() = static_cast<uint>(i);
-			Compress(m_treeParams.ToBytes(), 0, m_dgtState[i]);
+			// the serialized parameters are shorter than a block; zero pad to the block size
+			std::vector<byte> params = m_treeParams.ToBytes();
+			params.resize(BLOCK_SIZE, 0);
+			Compress(params, 0, m_dgtState[i]);
 		}
 	}
 }
 
+std::vector<byte> SHA512::SaveState()
+{
+	std::vector<byte> params = m_treeParams.ToBytes();
+	IO::StreamWriter writer(10 + sizeof(ushort) + params.size() + m_msgLength + (m_dgtState.size() * (10 * sizeof(ulong))));
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Digests::SHA512));
+	writer.Write(static_cast<uint>(m_dgtState.size()));
+	writer.Write(static_cast<ushort>(params.size()));
+	writer.Write(params, 0, params.size());
+	writer.Write(static_cast<uint>(m_msgLength));
+	writer.Write(m_msgBuffer, 0, m_msgLength);
+
+	for (size_t i = 0; i < m_dgtState.size(); ++i)
+	{
+		writer.Write(m_dgtState[i].H);
+		writer.Write(m_dgtState[i].T);
+	}
+
+	return writer.GetBytes();
+}
+
 void SHA512::Update(byte Input)
 {
 	std::vector<byte> inp(1, Input);
@@ -288,6 +394,14 @@ void SHA512::Update(const std::vector<byte> &Input, size_t InOffset, size_t Leng
 			Length -= RMDLEN;
 		}
 
+		// consecutive block pairs share a vectorized message schedule
+		while (Length > 2 * BLOCK_SIZE)
+		{
+			CompressX2(Input, InOffset, BLOCK_SIZE, m_dgtState[0]);
+			InOffset += 2 * BLOCK_SIZE;
+			Length -= 2 * BLOCK_SIZE;
+		}
+
 		// sequential loop through blocks
 		while (Length > BLOCK_SIZE)
 		{
@@ -305,6 +419,11 @@ void SHA512::Update(const std::vector<byte> &Input, size_t InOffset, size_t Leng
 	}
 }
 
+void SHA512::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input, m_segmentStage);
+}
+
 //~~~Private Functions~~~//
 
 ulong SHA512::BigSigma0(ulong W)
@@ -323,6 +442,11 @@ ulong SHA512::Ch(ulong B, ulong C, ulong D)
 }
 
 void SHA512::Compress(const std::vector<byte> &Input, size_t InOffset, SHA512State &State)
+{
+	Compress128(Input, InOffset, State);
+}
+
+void SHA512::Compress128(const std::vector<byte> &Input, size_t InOffset, SHA512State &State)
 {
 	ulong A = State.H[0];
 	ulong B = State.H[1];
@@ -511,6 +635,97 @@ void SHA512::Compress(const std::vector<byte> &Input, size_t InOffset, SHA512Sta
 	State.Increase(BLOCK_SIZE);
 }
 
+void SHA512::Compress128W(const std::vector<byte> &Input, size_t InOffset, size_t Stride, SHA512State &State)
+{
+#if defined(__AVX2__)
+	// the message schedules of two blocks are expanded together; the first block in the low, and the second in the high 128 bit lanes
+	std::array<ulong, 160> W;
+	__m256i X[8];
+	__m256i T0, T1, T2, T3;
+	const __m256i MASK = _mm256_set_epi64x(0x08090A0B0C0D0E0FULL, 0x0001020304050607ULL, 0x08090A0B0C0D0E0FULL, 0x0001020304050607ULL);
+
+	for (size_t i = 0; i < 8; ++i)
+	{
+		T0 = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&Input[InOffset + (i * 16)])));
+		T0 = _mm256_inserti128_si256(T0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&Input[InOffset + Stride + (i * 16)])), 1);
+		X[i] = _mm256_shuffle_epi8(T0, MASK);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&W[i * 2]), _mm256_castsi256_si128(X[i]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&W[80 + (i * 2)]), _mm256_extracti128_si256(X[i], 1));
+	}
+
+	// W[t] = Sigma1(W[t-2]) + W[t-7] + Sigma0(W[t-15]) + W[t-16], two words per lane in each step
+	for (size_t i = 8; i < 40; ++i)
+	{
+		// W[t-15], W[t-14]
+		T0 = _mm256_alignr_epi8(X[(i - 7) & 7], X[i & 7], 8);
+		T1 = _mm256_xor_si256(_mm256_xor_si256(_mm256_or_si256(_mm256_srli_epi64(T0, 1), _mm256_slli_epi64(T0, 63)),
+			_mm256_or_si256(_mm256_srli_epi64(T0, 8), _mm256_slli_epi64(T0, 56))), _mm256_srli_epi64(T0, 7));
+		// W[t-7], W[t-6]
+		T2 = _mm256_alignr_epi8(X[(i - 3) & 7], X[(i - 4) & 7], 8);
+		// W[t-2], W[t-1]
+		T0 = X[(i - 1) & 7];
+		T3 = _mm256_xor_si256(_mm256_xor_si256(_mm256_or_si256(_mm256_srli_epi64(T0, 19), _mm256_slli_epi64(T0, 45)),
+			_mm256_or_si256(_mm256_srli_epi64(T0, 61), _mm256_slli_epi64(T0, 3))), _mm256_srli_epi64(T0, 6));
+
+		X[i & 7] = _mm256_add_epi64(_mm256_add_epi64(X[i & 7], T1), _mm256_add_epi64(T2, T3));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&W[i * 2]), _mm256_castsi256_si128(X[i & 7]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&W[80 + (i * 2)]), _mm256_extracti128_si256(X[i & 7], 1));
+	}
+
+	// the scalar rounds consume each expanded schedule in turn
+	for (size_t j = 0; j < 160; j += 80)
+	{
+		ulong A = State.H[0];
+		ulong B = State.H[1];
+		ulong C = State.H[2];
+		ulong D = State.H[3];
+		ulong E = State.H[4];
+		ulong F = State.H[5];
+		ulong G = State.H[6];
+		ulong H = State.H[7];
+
+		for (size_t i = 0; i < 80; i += 8)
+		{
+			Round(A, B, C, D, E, F, G, H, W[j + i], K[i]);
+			Round(H, A, B, C, D, E, F, G, W[j + i + 1], K[i + 1]);
+			Round(G, H, A, B, C, D, E, F, W[j + i + 2], K[i + 2]);
+			Round(F, G, H, A, B, C, D, E, W[j + i + 3], K[i + 3]);
+			Round(E, F, G, H, A, B, C, D, W[j + i + 4], K[i + 4]);
+			Round(D, E, F, G, H, A, B, C, W[j + i + 5], K[i + 5]);
+			Round(C, D, E, F, G, H, A, B, W[j + i + 6], K[i + 6]);
+			Round(B, C, D, E, F, G, H, A, W[j + i + 7], K[i + 7]);
+		}
+
+		State.H[0] += A;
+		State.H[1] += B;
+		State.H[2] += C;
+		State.H[3] += D;
+		State.H[4] += E;
+		State.H[5] += F;
+		State.H[6] += G;
+		State.H[7] += H;
+
+		State.Increase(BLOCK_SIZE);
+	}
+#else
+	Compress128(Input, InOffset, State);
+	Compress128(Input, InOffset + Stride, State);
+#endif
+}
+
+void SHA512::CompressX2(const std::vector<byte> &Input, size_t InOffset, size_t Stride, SHA512State &State)
+{
+	if (m_parallelProfile.HasSimd256())
+	{
+		Compress128W(Input, InOffset, Stride, State);
+	}
+	else
+	{
+		Compress128(Input, InOffset, State);
+		Compress128(Input, InOffset + Stride, State);
+	}
+}
+
 void SHA512::HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, SHA512State &State)
 {
 	State.Increase(Length);
@@ -548,13 +763,20 @@ ulong SHA512::Maj(ulong B, ulong C, ulong D)
 
 void SHA512::ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, SHA512State &State, ulong Length)
 {
-	do
+	// each leaf block is ParallelMinimumSize bytes after the previous one
+	while (Length >= 2 * m_parallelProfile.ParallelMinimumSize())
+	{
+		CompressX2(Input, InOffset, m_parallelProfile.ParallelMinimumSize(), State);
+		InOffset += 2 * m_parallelProfile.ParallelMinimumSize();
+		Length -= 2 * m_parallelProfile.ParallelMinimumSize();
+	}
+
+	while (Length > 0)
 	{
 		Compress(Input, InOffset, State);
 		InOffset += m_parallelProfile.ParallelMinimumSize();
 		Length -= m_parallelProfile.ParallelMinimumSize();
-	} 
-	while (Length > 0);
+	}
 }
 
 void SHA512::Round(ulong A, ulong B, ulong C, ulong &D, ulong E, ulong F, ulong G, ulong &H, ulong M, ulong P)
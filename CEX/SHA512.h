@@ -74,6 +74,7 @@ NAMESPACE_DIGEST
 /// <item><description>The <see cref="Finalize(byte[], size_t)"/> method returns the hash or MAC code and resets the internal state.</description></item>
 /// <item><description>Setting Parallel to true in the constructor instantiates the multi-threaded variant.</description></item>
 /// <item><description>Multi-threaded and sequential versions produce a different output hash for a message, this is expected.</description></item>
+/// <item><description>On AVX2 capable systems, the message schedules of two consecutive blocks are expanded together in 256 bit registers, and consumed by the scalar rounds.</description></item>
 /// </list>
 /// 
 /// <description>Guiding Publications:</description>
@@ -97,8 +98,10 @@ private:
 	static const std::string CLASS_NAME;
 	static const size_t DIGEST_SIZE = 64;
 	static const ulong DEF_PRLDEGREE = 8;
+	static const std::vector<ulong> K;
 	// size of reserved state buffer subtracted from parallel size calculations
 	static const size_t STATE_PRECACHED = 2048;
+	static const byte STATE_VERSION = 1;
 
 	struct SHA512State
 	{
@@ -144,6 +147,7 @@ private:
 	std::vector<byte> m_msgBuffer;
 	size_t m_msgLength;
 	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_segmentStage;
 
 public:
 
@@ -250,6 +254,17 @@ public:
 	/// <exception cref="CryptoDigestException">Thrown if the output array is too short</exception>
 	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset) override;
 
+	/// <summary>
+	/// Restore the internal state from a checkpoint created by the SaveState function.
+	/// <para>The digest must be constructed with the same parallel and tree settings as the instance that created the state;
+	/// hashing resumes from the checkpoint, and subsequent Update and Finalize calls produce the same hash as an uninterrupted digest.</para>
+	/// </summary>
+	///
+	/// <param name="State">The serialized digest state</param>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the state version, digest type, or number of tree leaves do not match this instance</exception>
+	void LoadState(const std::vector<byte> &State) override;
+
 	/// <summary>
 	/// Set the number of threads allocated when using multi-threaded tree hashing processing.
 	/// <para>Thread count must be an even number, and not exceed the number of processor cores.
@@ -266,6 +281,14 @@ public:
 	/// </summary>
 	void Reset() override;
 
+	/// <summary>
+	/// Serialize the internal state; the version, tree parameters, pending message bytes, and the chaining value and counter of each leaf.
+	/// <para>Only the unprocessed bytes of the message buffer are written, and each leaf is stored as its raw chaining and counter words.</para>
+	/// </summary>
+	///
+	/// <returns>The serialized digest state</returns>
+	std::vector<byte> SaveState() override;
+
 	/// <summary>
 	/// Update the hash with a single byte
 	/// </summary>
@@ -282,12 +305,23 @@ public:
 	/// <param name="Length">The number of message bytes to process</param>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the buffer with a message stored as a list of fragments
+	/// <para>The fragments are absorbed in list order as one contiguous message; a partial block is carried across each fragment boundary, so no fragment is copied.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of message fragments</param>
+	void UpdateSegments(const std::vector<MemorySegment> &Input) override;
+
 private:
 
 	static ulong BigSigma0(ulong W);
 	static ulong BigSigma1(ulong W);
 	static ulong Ch(ulong B, ulong C, ulong D);
 	void Compress(const std::vector<byte> &Input, size_t InOffset, SHA512State &State);
+	void Compress128(const std::vector<byte> &Input, size_t InOffset, SHA512State &State);
+	void Compress128W(const std::vector<byte> &Input, size_t InOffset, size_t Stride, SHA512State &State);
+	void CompressX2(const std::vector<byte> &Input, size_t InOffset, size_t Stride, SHA512State &State);
 	void HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, SHA512State &State);
 	static ulong Maj(ulong B, ulong C, ulong D);
 	void ProcessLeaf(const std::vector<byte> &Input, size_t InOffset, SHA512State &State, ulong Length);
@@ -0,0 +1,311 @@
+#include "SHAKE.h"
+#include "IntUtils.h"
+#include "Keccak.h"
+#include "MemUtils.h"
+
+NAMESPACE_KDF
+
+using Digest::Keccak;
+
+const std::string SHAKE::CLASS_NAME("SHAKE");
+
+//~~~Properties~~~//
+
+const size_t SHAKE::BlockSize()
+{
+	return m_blockSize;
+}
+
+const Digests SHAKE::DigestType()
+{
+	return m_kdfDigestType;
+}
+
+const Kdfs SHAKE::Enumeral()
+{
+	return Kdfs::SHAKE;
+}
+
+const bool SHAKE::IsInitialized()
+{
+	return m_isInitialized;
+}
+
+const bool SHAKE::IsParallel()
+{
+	return m_isParallel;
+}
+
+std::vector<SymmetricKeySize> SHAKE::LegalKeySizes() const
+{
+	return m_legalKeySizes;
+}
+
+size_t SHAKE::MinKeySize()
+{
+	return (200 - m_blockSize) / 2;
+}
+
+const std::string SHAKE::Name()
+{
+	std::string name = CLASS_NAME + (m_kdfDigestType == Digests::Keccak256 ? "128" : "256");
+
+	if (m_isParallel)
+		name += "-P" + Utility::IntUtils::ToString(Keccak::PARALLEL_LANES);
+
+	return name;
+}
+
+//~~~Constructor~~~//
+
+SHAKE::SHAKE(Digests DigestType, bool Parallel)
+	:
+	m_blockSize(DigestType == Digests::Keccak256 ? 168 : DigestType == Digests::Keccak512 ? 136 :
+		throw CryptoKdfException("SHAKE:CTor", "The digest type must be Keccak256 or Keccak512!")),
+	m_isDestroyed(false),
+	m_isInitialized(false),
+	m_isParallel(Parallel),
+	m_kdfBuffer(Parallel ? m_blockSize * Keccak::PARALLEL_LANES : m_blockSize),
+	m_kdfDigestType(DigestType),
+	m_kdfPosition(m_kdfBuffer.size()),
+	m_kdfState(Parallel ? STATE_SIZE * Keccak::PARALLEL_LANES : STATE_SIZE, 0),
+	m_legalKeySizes(0)
+{
+	Scope();
+}
+
+SHAKE::~SHAKE()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void SHAKE::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_blockSize = 0;
+		m_isInitialized = false;
+		m_isParallel = false;
+		m_kdfDigestType = Digests::None;
+		m_kdfPosition = 0;
+
+		Utility::IntUtils::ClearVector(m_kdfBuffer);
+		Utility::IntUtils::ClearVector(m_kdfState);
+		Utility::IntUtils::ClearVector(m_legalKeySizes);
+	}
+}
+
+size_t SHAKE::Generate(std::vector<byte> &Output)
+{
+	return Generate(Output, 0, Output.size());
+}
+
+size_t SHAKE::Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length)
+{
+	CexAssert(m_isInitialized, "the generator must be initialized before use");
+	CexAssert(Output.size() - OutOffset >= Length, "the output buffer too small");
+
+	const size_t BUFLEN = m_kdfBuffer.size();
+	const size_t OUTLEN = Length;
+
+	// drain the bytes remaining from the last squeeze
+	if (m_kdfPosition != BUFLEN)
+	{
+		const size_t RMDLEN = Utility::IntUtils::Min(BUFLEN - m_kdfPosition, Length);
+		Utility::MemUtils::Copy(m_kdfBuffer, m_kdfPosition, Output, OutOffset, RMDLEN);
+		m_kdfPosition += RMDLEN;
+		OutOffset += RMDLEN;
+		Length -= RMDLEN;
+	}
+
+	// whole blocks are squeezed directly into the output
+	while (Length >= BUFLEN)
+	{
+		Squeeze(Output, OutOffset);
+		OutOffset += BUFLEN;
+		Length -= BUFLEN;
+	}
+
+	// buffer the remainder
+	if (Length != 0)
+	{
+		Squeeze(m_kdfBuffer, 0);
+		Utility::MemUtils::Copy(m_kdfBuffer, 0, Output, OutOffset, Length);
+		m_kdfPosition = Length;
+	}
+
+	return OUTLEN;
+}
+
+void SHAKE::Initialize(ISymmetricKey &GenParam)
+{
+	SymmetricKeyView keyView(GenParam);
+
+	Initialize(keyView.Key(), keyView.Nonce(), keyView.Info());
+}
+
+void SHAKE::Initialize(const std::vector<byte> &Key)
+{
+	Initialize(Key, std::vector<byte>(0), std::vector<byte>(0));
+}
+
+void SHAKE::Initialize(const std::vector<byte> &Key, const std::vector<byte> &Salt)
+{
+	Initialize(Key, Salt, std::vector<byte>(0));
+}
+
+void SHAKE::Initialize(const std::vector<byte> &Key, const std::vector<byte> &Salt, const std::vector<byte> &Info)
+{
+	if (Key.size() == 0)
+		throw CryptoKdfException("SHAKE:Initialize", "The key can not be zero length!");
+
+	if (m_isInitialized)
+		Reset();
+
+	Absorb(Key, Salt, Info);
+	m_isInitialized = true;
+}
+
+void SHAKE::ReSeed(const std::vector<byte> &Seed)
+{
+	Initialize(Seed);
+}
+
+void SHAKE::Reset()
+{
+	Utility::MemUtils::Clear(m_kdfBuffer, 0, m_kdfBuffer.size());
+	Utility::MemUtils::Clear(m_kdfState, 0, m_kdfState.size() * sizeof(ulong));
+	m_kdfPosition = m_kdfBuffer.size();
+	m_isInitialized = false;
+}
+
+//~~~Private Functions~~~//
+
+void SHAKE::Absorb(const std::vector<byte> &Key, const std::vector<byte> &Customization, const std::vector<byte> &Name)
+{
+	const bool CSHAKE = (Customization.size() != 0 || Name.size() != 0);
+	const size_t LANES = m_isParallel ? Keccak::PARALLEL_LANES : 1;
+	std::vector<byte> msg(0);
+
+	if (CSHAKE)
+	{
+		// bytepad(encode_string(N) || encode_string(S), rate)
+		std::vector<byte> enc = Keccak::LeftEncode(m_blockSize);
+		msg.insert(msg.end(), enc.begin(), enc.end());
+		enc = Keccak::LeftEncode(static_cast<ulong>(Name.size()) * 8);
+		msg.insert(msg.end(), enc.begin(), enc.end());
+		msg.insert(msg.end(), Name.begin(), Name.end());
+		enc = Keccak::LeftEncode(static_cast<ulong>(Customization.size()) * 8);
+		msg.insert(msg.end(), enc.begin(), enc.end());
+		msg.insert(msg.end(), Customization.begin(), Customization.end());
+		msg.resize(msg.size() + ((m_blockSize - (msg.size() % m_blockSize)) % m_blockSize), 0x00);
+	}
+
+	msg.insert(msg.end(), Key.begin(), Key.end());
+
+	// the parallel lanes are separated by a trailing counter byte
+	const size_t CTRPOS = msg.size();
+
+	if (m_isParallel)
+		msg.push_back(0x00);
+
+	// pad10*1 with the domain bits; the padding always adds at least one byte
+	const size_t MSGLEN = msg.size();
+	msg.resize(MSGLEN + (m_blockSize - (MSGLEN % m_blockSize)), 0x00);
+	msg[MSGLEN] = CSHAKE ? CSHAKE_DOMAIN : SHAKE_DOMAIN;
+	msg[msg.size() - 1] |= 0x80;
+
+	Utility::MemUtils::Clear(m_kdfState, 0, m_kdfState.size() * sizeof(ulong));
+
+	if (!m_isParallel)
+	{
+		// the sequential permutation runs on a lane complemented state
+		m_kdfState[1] = ~0ULL;
+		m_kdfState[2] = ~0ULL;
+		m_kdfState[8] = ~0ULL;
+		m_kdfState[12] = ~0ULL;
+		m_kdfState[17] = ~0ULL;
+		m_kdfState[20] = ~0ULL;
+
+		for (size_t i = 0; i < msg.size(); i += m_blockSize)
+			Keccak::Permute(msg, i, m_blockSize, m_kdfState);
+	}
+	else
+	{
+		for (size_t i = 0; i < msg.size(); i += m_blockSize)
+		{
+			for (size_t j = 0; j < m_blockSize / sizeof(ulong); ++j)
+			{
+				const size_t MSGPOS = i + (j * sizeof(ulong));
+
+				for (size_t k = 0; k < LANES; ++k)
+				{
+					// the counter byte is the only difference between the lane inputs
+					msg[CTRPOS] = static_cast<byte>(k);
+					m_kdfState[(j * LANES) + k] ^= Utility::IntUtils::LeBytesTo64(msg, MSGPOS);
+				}
+			}
+
+			Keccak::PermuteP4x(m_kdfState);
+		}
+	}
+
+	Utility::MemUtils::Clear(msg, 0, msg.size());
+	m_kdfPosition = m_kdfBuffer.size();
+}
+
+void SHAKE::Scope()
+{
+	const size_t SECLEN = (200 - m_blockSize) / 2;
+
+	m_legalKeySizes.resize(3);
+	// minimum key size; the security strength
+	m_legalKeySizes[0] = SymmetricKeySize(SECLEN, 0, 0);
+	// recommended size
+	m_legalKeySizes[1] = SymmetricKeySize(SECLEN * 2, 0, 0);
+	// a rate sized key, with the optional cSHAKE customization string
+	m_legalKeySizes[2] = SymmetricKeySize(m_blockSize, SECLEN, 0);
+}
+
+void SHAKE::Squeeze(std::vector<byte> &Output, size_t OutOffset)
+{
+	if (!m_isParallel)
+	{
+		m_kdfState[1] = ~m_kdfState[1];
+		m_kdfState[2] = ~m_kdfState[2];
+		m_kdfState[8] = ~m_kdfState[8];
+		m_kdfState[12] = ~m_kdfState[12];
+		m_kdfState[17] = ~m_kdfState[17];
+		m_kdfState[20] = ~m_kdfState[20];
+
+		for (size_t i = 0; i < m_blockSize / sizeof(ulong); ++i)
+			Utility::IntUtils::Le64ToBytes(m_kdfState[i], Output, OutOffset + (i * sizeof(ulong)));
+
+		m_kdfState[1] = ~m_kdfState[1];
+		m_kdfState[2] = ~m_kdfState[2];
+		m_kdfState[8] = ~m_kdfState[8];
+		m_kdfState[12] = ~m_kdfState[12];
+		m_kdfState[17] = ~m_kdfState[17];
+		m_kdfState[20] = ~m_kdfState[20];
+
+		// advance the sponge for the next block
+		std::vector<byte> empty(0);
+		Keccak::Permute(empty, 0, 0, m_kdfState);
+	}
+	else
+	{
+		// one block from each lane in turn
+		for (size_t k = 0; k < Keccak::PARALLEL_LANES; ++k)
+		{
+			for (size_t i = 0; i < m_blockSize / sizeof(ulong); ++i)
+				Utility::IntUtils::Le64ToBytes(m_kdfState[(i * Keccak::PARALLEL_LANES) + k], Output, OutOffset + (k * m_blockSize) + (i * sizeof(ulong)));
+		}
+
+		Keccak::PermuteP4x(m_kdfState);
+	}
+}
+
+NAMESPACE_KDFEND
@@ -0,0 +1,256 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Principal Algorithms:
+// FIPS 202: SHA-3 Standard: Permutation-Based Hash and Extendable-Output Functions.
+// NIST SP 800-185: SHA-3 Derived Functions: cSHAKE, KMAC, TupleHash and ParallelHash.
+// Implementation Details:
+// An implementation of the SHAKE128 and SHAKE256 extendable output functions, and the customized cSHAKE variants.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_SHAKE_H
+#define CEX_SHAKE_H
+
+#include "Digests.h"
+#include "IKdf.h"
+
+NAMESPACE_KDF
+
+using Enumeration::Digests;
+
+/// <summary>
+/// An implementation of the SHAKE and cSHAKE extendable output functions
+/// </summary>
+///
+/// <example>
+/// <description>Generate an array of pseudo random bytes:</description>
+/// <code>
+/// // SHAKE256, use the Parallel flag for the 4 lane bulk generator
+/// SHAKE kdf(Enumeration::Digests::Keccak512);
+/// // initialize; the optional Salt is the cSHAKE customization string, Info is the function name string
+/// kdf.Initialize(Key, [Salt], [Info]);
+/// // generate bytes; successive calls continue the output stream
+/// kdf.Generate(Output, [Offset], [Size]);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description><B>Overview:</B></description>
+/// <para>SHAKE is the extendable output function of the SHA-3 standard; the key is absorbed into the Keccak sponge, and the output is squeezed from the sponge one rate-sized block at a time. \n
+/// cSHAKE prefixes the key with a padded block containing a function name and a customization string, so that distinct applications produce independent output streams from the same key. \n
+/// The output is incremental, each call to Generate continues the output stream from where the previous call stopped.</para>
+///
+/// <description><B>Description:</B></description> \n
+/// <EM>Legend:</EM> \n
+/// <B>K</B>=key, <B>N</B>=function name, <B>S</B>=customization string, <B>L</B>=output length, <B>||</B>=concatonate \n
+/// <para><EM>Generate:</EM> \n
+/// SHAKE(K, L) = Keccak[c](K || 1111, L) \n
+/// cSHAKE(K, L, N, S) = Keccak[c](bytepad(encode_string(N) || encode_string(S), rate) || K || 00, L) \n
+/// SHAKE-P4(K) = SHAKE(K || 0)[0] || SHAKE(K || 1)[0] || SHAKE(K || 2)[0] || SHAKE(K || 3)[0] || SHAKE(K || 0)[1] || ..., where [j] is the j-th rate-sized output block</para>
+///
+/// <description><B>Implementation Notes:</B></description>
+/// <list type="bullet">
+/// <item><description>The Keccak256 digest type selects SHAKE128 (a 168 byte rate), the Keccak512 digest type selects SHAKE256 (a 136 byte rate).</description></item>
+/// <item><description>Initializing with a Salt (or SymmetricKey Nonce) and/or Info parameter selects cSHAKE; the Salt is the customization string S, and the Info is the function name string N.</description></item>
+/// <item><description>The parallel generator runs 4 independent sponges, each absorbing the key followed by a lane counter byte, and interleaves their output one rate-sized block at a time.</description></item>
+/// <item><description>The 4 lane sponges are permuted together with AVX2 instructions when available; the parallel output is not the same as the sequential SHAKE output.</description></item>
+/// <item><description>Output requests of a block or more are squeezed directly into the output array, partial blocks are buffered for the next call.</description></item>
+/// <item><description>The minimum recommended key size is the security strength; 16 bytes for SHAKE128, and 32 bytes for SHAKE256.</description></item>
+/// </list>
+///
+/// <description><B>Guiding Publications:</B></description>
+/// <list type="number">
+/// <item><description>Fips <a href="http://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.202.pdf">202</a>: SHA-3 Standard: Permutation-Based Hash and Extendable-Output Functions.</description></item>
+/// <item><description>NIST <a href="http://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-185.pdf">SP 800-185</a>: SHA-3 Derived Functions: cSHAKE, KMAC, TupleHash and ParallelHash.</description></item>
+/// </list>
+/// </remarks>
+class SHAKE : public IKdf
+{
+private:
+
+	static const std::string CLASS_NAME;
+	static const byte CSHAKE_DOMAIN = 0x04;
+	static const byte SHAKE_DOMAIN = 0x1F;
+	static const size_t STATE_SIZE = 25;
+
+	size_t m_blockSize;
+	bool m_isDestroyed;
+	bool m_isInitialized;
+	bool m_isParallel;
+	std::vector<byte> m_kdfBuffer;
+	Digests m_kdfDigestType;
+	size_t m_kdfPosition;
+	std::vector<ulong> m_kdfState;
+	std::vector<SymmetricKeySize> m_legalKeySizes;
+
+public:
+
+	SHAKE() = delete;
+	SHAKE(const SHAKE&) = delete;
+	SHAKE& operator=(const SHAKE&) = delete;
+	SHAKE& operator=(SHAKE&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The sponge rate; the number of bytes produced by each permutation of a sponge
+	/// </summary>
+	const size_t BlockSize();
+
+	/// <summary>
+	/// Get: The Keccak strength selector; Keccak256 for SHAKE128, or Keccak512 for SHAKE256
+	/// </summary>
+	const Digests DigestType();
+
+	/// <summary>
+	/// Get: The Kdf generators type name
+	/// </summary>
+	const Kdfs Enumeral() override;
+
+	/// <summary>
+	/// Get: Generator is ready to produce random
+	/// </summary>
+	const bool IsInitialized() override;
+
+	/// <summary>
+	/// Get: The generator is using the 4 lane parallel squeeze
+	/// </summary>
+	const bool IsParallel();
+
+	/// <summary>
+	/// Get: Available Kdf Key Sizes in bytes
+	/// </summary>
+	std::vector<SymmetricKeySize> LegalKeySizes() const override;
+
+	/// <summary>
+	/// Minimum recommended initialization key size in bytes; the security strength of the function
+	/// </summary>
+	size_t MinKeySize() override;
+
+	/// <summary>
+	/// Get: The Kdf generators class name
+	/// </summary>
+	const std::string Name() override;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Instantiate this class using the Keccak digest enumeration name as the strength selector
+	/// </summary>
+	///
+	/// <param name="DigestType">The Keccak digest enumeration name; Keccak256 for SHAKE128, or Keccak512 for SHAKE256</param>
+	/// <param name="Parallel">Use the 4 lane parallel generator; the output differs from the sequential generator</param>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if the digest type is not Keccak256 or Keccak512</exception>
+	explicit SHAKE(Digests DigestType, bool Parallel = false);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~SHAKE() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Fill an array with pseudo random bytes; continues the output stream
+	/// </summary>
+	///
+	/// <param name="Output">Output array filled with random bytes</param>
+	///
+	/// <returns>The number of bytes generated</returns>
+	size_t Generate(std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Generate pseudo random bytes using offset and length parameters; continues the output stream
+	/// </summary>
+	///
+	/// <param name="Output">Output array filled with random bytes</param>
+	/// <param name="OutOffset">The starting position within the Output array</param>
+	/// <param name="Length">The number of bytes to generate</param>
+	///
+	/// <returns>The number of bytes generated</returns>
+	size_t Generate(std::vector<byte> &Output, size_t OutOffset, size_t Length) override;
+
+	/// <summary>
+	/// Initialize the generator with a SymmetricKey structure containing the key, and optional customization (Nonce) and function name (Info) strings
+	/// </summary>
+	///
+	/// <param name="GenParam">The SymmetricKey containing the generators keying material</param>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if the key is empty</exception>
+	void Initialize(ISymmetricKey &GenParam) override;
+
+	/// <summary>
+	/// Initialize the generator with a key; selects SHAKE
+	/// </summary>
+	///
+	/// <param name="Key">The primary key array used to seed the generator</param>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if the key is empty</exception>
+	void Initialize(const std::vector<byte> &Key) override;
+
+	/// <summary>
+	/// Initialize the generator with a key and a customization string; selects cSHAKE
+	/// </summary>
+	///
+	/// <param name="Key">The primary key array used to seed the generator</param>
+	/// <param name="Salt">The cSHAKE customization string</param>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if the key is empty</exception>
+	void Initialize(const std::vector<byte> &Key, const std::vector<byte> &Salt) override;
+
+	/// <summary>
+	/// Initialize the generator with a key, a customization string, and a function name string; selects cSHAKE
+	/// </summary>
+	///
+	/// <param name="Key">The primary key array used to seed the generator</param>
+	/// <param name="Salt">The cSHAKE customization string</param>
+	/// <param name="Info">The cSHAKE function name string</param>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if the key is empty</exception>
+	void Initialize(const std::vector<byte> &Key, const std::vector<byte> &Salt, const std::vector<byte> &Info) override;
+
+	/// <summary>
+	/// Update the generators keying material; restarts the output stream with the new seed
+	/// </summary>
+	///
+	/// <param name="Seed">The new seed value array</param>
+	///
+	/// <exception cref="Exception::CryptoKdfException">Thrown if the seed is empty</exception>
+	void ReSeed(const std::vector<byte> &Seed) override;
+
+	/// <summary>
+	/// Reset the internal state; Kdf must be re-initialized before it can be used again
+	/// </summary>
+	void Reset() override;
+
+private:
+
+	void Absorb(const std::vector<byte> &Key, const std::vector<byte> &Customization, const std::vector<byte> &Name);
+	void Scope();
+	void Squeeze(std::vector<byte> &Output, size_t OutOffset);
+};
+
+NAMESPACE_KDFEND
+#endif
@@ -183,18 +183,20 @@ void SHX::Destroy()
 
 void SHX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(m_legalKeySizes, KeyParams.Key().size()))
+	SymmetricKeyView keyView(KeyParams);
+
+	if (!SymmetricKeySize::Contains(m_legalKeySizes, keyView.Key().size()))
 		throw CryptoSymmetricCipherException("SHX:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
-	if (m_kdfEngineType != Enumeration::Digests::None && KeyParams.Info().size() > m_kdfInfoMax)
+	if (m_kdfEngineType != Enumeration::Digests::None && keyView.Info().size() > m_kdfInfoMax)
 		throw CryptoSymmetricCipherException("SHX:Initialize", "Invalid info size! Info parameter must be no longer than DistributionCodeMax size.");
 
-	if (KeyParams.Info().size() > 0)
-		m_kdfInfo = KeyParams.Info();
+	if (keyView.Info().size() > 0)
+		m_kdfInfo = keyView.Info();
 
 	m_isEncryption = Encryption;
-	m_cprKeySize = KeyParams.Key().size() * 8;
+	m_cprKeySize = keyView.Key().size() * 8;
 	// expand the key
-	ExpandKey(KeyParams.Key());
+	ExpandKey(keyView.Key());
 	// ready to transform data
 	m_isInitialized = true;
 }
@@ -316,7 +318,7 @@ void SHX::StandardExpand(const std::vector<byte> &Key)
 		Wp[index] = 1;
 
 	// initialize the key
-	std::vector<uint> Wk(keySize, 0);
+	Utility::SecureVector<uint> Wk(keySize, 0);
 
 	if (padSize == 16)
 	{
@@ -39,6 +39,7 @@
 #define CEX_SHX_H
 
 #include "IBlockCipher.h"
+#include "SecureAllocator.h"
 
 NAMESPACE_BLOCK
 
@@ -101,6 +102,7 @@ NAMESPACE_BLOCK
 /// <item><description>The internal block size is 16 bytes wide.</description></item>
 /// <item><description>Diffusion rounds assignments are 32, 40, 48, 56, and 64 rounds, default is 32 (128-256 bit key), a 512 bit key is automatically assigned 40 rounds.</description></item>
 /// <item><description>Valid rounds assignments can be found in the LegalRounds property.</description></item>
+/// <item><description>The round keys are stored in the page locked <see cref="Utility::SecureArena"/>, and are zeroed when the cipher is destroyed.</description></item>
 /// </list>
 /// 
 /// <description>Guiding Publications:</description>
@@ -131,7 +133,7 @@ private:
 
 	size_t m_cprKeySize;
 	bool m_destroyEngine;
-	std::vector<uint> m_expKey;
+	Utility::SecureVector<uint> m_expKey;
 	IDigest* m_kdfEngine;
 	Digests m_kdfEngineType;
 	std::vector<byte> m_kdfInfo;
@@ -0,0 +1,1205 @@
+#include "SPXCore.h"
+#include "CryptoAsymmetricException.h"
+#include "DigestFromName.h"
+#include "Digests.h"
+#include "HMAC.h"
+#include "IntUtils.h"
+#include "Keccak.h"
+#include "MemUtils.h"
+#include "ParallelUtils.h"
+#include "SHA512.h"
+#include "SHAKE.h"
+#include "SymmetricKey.h"
+
+NAMESPACE_SPHINCS
+
+using Exception::CryptoAsymmetricException;
+using Enumeration::Digests;
+using Digest::IDigest;
+using Digest::Keccak;
+using Utility::IntUtils;
+using Utility::MemUtils;
+using Utility::ParallelUtils;
+
+const uint SPXCore::SHA256_K[64] =
+{
+	0x428A2F98UL, 0x71374491UL, 0xB5C0FBCFUL, 0xE9B5DBA5UL, 0x3956C25BUL, 0x59F111F1UL, 0x923F82A4UL, 0xAB1C5ED5UL,
+	0xD807AA98UL, 0x12835B01UL, 0x243185BEUL, 0x550C7DC3UL, 0x72BE5D74UL, 0x80DEB1FEUL, 0x9BDC06A7UL, 0xC19BF174UL,
+	0xE49B69C1UL, 0xEFBE4786UL, 0x0FC19DC6UL, 0x240CA1CCUL, 0x2DE92C6FUL, 0x4A7484AAUL, 0x5CB0A9DCUL, 0x76F988DAUL,
+	0x983E5152UL, 0xA831C66DUL, 0xB00327C8UL, 0xBF597FC7UL, 0xC6E00BF3UL, 0xD5A79147UL, 0x06CA6351UL, 0x14292967UL,
+	0x27B70A85UL, 0x2E1B2138UL, 0x4D2C6DFCUL, 0x53380D13UL, 0x650A7354UL, 0x766A0ABBUL, 0x81C2C92EUL, 0x92722C85UL,
+	0xA2BFE8A1UL, 0xA81A664BUL, 0xC24B8B70UL, 0xC76C51A3UL, 0xD192E819UL, 0xD6990624UL, 0xF40E3585UL, 0x106AA070UL,
+	0x19A4C116UL, 0x1E376C08UL, 0x2748774CUL, 0x34B0BCB5UL, 0x391C0CB3UL, 0x4ED8AA4AUL, 0x5B9CCA4FUL, 0x682E6FF3UL,
+	0x748F82EEUL, 0x78A5636FUL, 0x84C87814UL, 0x8CC70208UL, 0x90BEFFFAUL, 0xA4506CEBUL, 0xBEF9A3F7UL, 0xC67178F2UL
+};
+
+const uint SPXCore::SHA256_IV[8] =
+{
+	0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL, 0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+};
+
+//~~~State~~~//
+
+SPXCore::SPXState::SPXState(const SPXParamSet &Params, bool IsParallel)
+	:
+	A(Params.ForsHeight),
+	D(Params.Layers),
+	H(Params.Height),
+	HP(Params.Height / Params.Layers),
+	IsSha512(false),
+	IsShake(Params.ParamName == SPXParams::SHAKEF128 || Params.ParamName == SPXParams::SHAKEF192 || Params.ParamName == SPXParams::SHAKEF256 ||
+		Params.ParamName == SPXParams::SHAKES128 || Params.ParamName == SPXParams::SHAKES192 || Params.ParamName == SPXParams::SHAKES256),
+	K(Params.ForsTrees),
+	Len((2 * Params.N) + WOTS_LEN2),
+	Len1(2 * Params.N),
+	M((((Params.ForsTrees * Params.ForsHeight) + 7) / 8) + (((Params.Height - (Params.Height / Params.Layers)) + 7) / 8) + (((Params.Height / Params.Layers) + 7) / 8)),
+	N(Params.N),
+	Parallel(IsParallel),
+	PkSeed(Params.N),
+	SeedState(),
+	SkSeed(Params.N)
+{
+	// the sha2 192 and 256 bit sets use SHA2-512 for H, T, H_msg and PRF_msg
+	IsSha512 = !IsShake && Params.N > 16;
+}
+
+//~~~Public Functions~~~//
+
+void SPXCore::GetParamSet(SPXParamSet &Params, SPXParams Parameters)
+{
+	switch (Parameters)
+	{
+	case SPXParams::SHA2S128:
+	case SPXParams::SHAKES128:
+		Params.Load(16, 63, 7, 12, 14, 32, 64, 7856, Parameters);
+		break;
+	case SPXParams::SHA2F128:
+	case SPXParams::SHAKEF128:
+		Params.Load(16, 66, 22, 6, 33, 32, 64, 17088, Parameters);
+		break;
+	case SPXParams::SHA2S192:
+	case SPXParams::SHAKES192:
+		Params.Load(24, 63, 7, 14, 17, 48, 96, 16224, Parameters);
+		break;
+	case SPXParams::SHA2F192:
+	case SPXParams::SHAKEF192:
+		Params.Load(24, 66, 22, 8, 33, 48, 96, 35664, Parameters);
+		break;
+	case SPXParams::SHA2S256:
+	case SPXParams::SHAKES256:
+		Params.Load(32, 64, 8, 14, 22, 64, 128, 29792, Parameters);
+		break;
+	case SPXParams::SHA2F256:
+	case SPXParams::SHAKEF256:
+		Params.Load(32, 68, 17, 9, 35, 64, 128, 49856, Parameters);
+		break;
+	default:
+		throw CryptoAsymmetricException("SPXCore:GetParamSet", "The parameter set is not recognized!");
+	}
+}
+
+void SPXCore::Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, std::unique_ptr<IPrng> &Random, const SPXParamSet &Params, bool Parallel)
+{
+	std::vector<byte> seeds(3 * Params.N);
+
+	// SK.seed || SK.prf || PK.seed
+	Random->GetBytes(seeds);
+	Generate(PublicKey, PrivateKey, seeds, Params, Parallel);
+	IntUtils::ClearVector(seeds);
+}
+
+void SPXCore::Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, const std::vector<byte> &Seeds, const SPXParamSet &Params, bool Parallel)
+{
+	CexAssert(Seeds.size() >= 3 * Params.N, "The seed is too small");
+
+	SPXState state(Params, Parallel);
+	const size_t LEAFCNT = static_cast<size_t>(1) << state.HP;
+	std::vector<byte> leaves(LEAFCNT * state.N);
+	std::vector<byte> auth(state.HP * state.N);
+	std::vector<byte> root(state.N);
+	SPXAddress adrs = { 0 };
+
+	MemUtils::Copy(Seeds, 0, state.SkSeed, 0, state.N);
+	MemUtils::Copy(Seeds, 2 * state.N, state.PkSeed, 0, state.N);
+	LoadSeed(state);
+
+	// the public root is the root of the single tree on the top layer of the hypertree
+	ParallelRange(LEAFCNT, Parallel, [&state, &leaves](size_t First, size_t Count)
+	{
+		WotsLeaves(state, leaves, First * state.N, static_cast<uint>(state.D - 1), 0, static_cast<uint>(First), Count);
+	});
+
+	SetLayer(adrs, static_cast<uint>(state.D - 1));
+	SetTree(adrs, 0);
+	SetType(adrs, ADRS_TREE);
+	TreeHash(state, leaves, state.HP, 0, 0, adrs, auth, 0, root, 0);
+
+	PrivateKey.resize(4 * state.N);
+	MemUtils::Copy(Seeds, 0, PrivateKey, 0, 3 * state.N);
+	MemUtils::Copy(root, 0, PrivateKey, 3 * state.N, state.N);
+	PublicKey.resize(2 * state.N);
+	MemUtils::Copy(state.PkSeed, 0, PublicKey, 0, state.N);
+	MemUtils::Copy(root, 0, PublicKey, state.N, state.N);
+
+	IntUtils::ClearVector(state.SkSeed);
+}
+
+void SPXCore::Sign(std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const std::vector<byte> &PrivateKey, std::unique_ptr<IPrng> &Random, const SPXParamSet &Params, bool Parallel)
+{
+	std::vector<byte> optRand(Params.N);
+
+	// the randomizer is hedged with fresh prng output
+	Random->GetBytes(optRand);
+	Sign(Signature, Message, MsgOffset, MsgLength, PrivateKey, optRand, Params, Parallel);
+}
+
+void SPXCore::Sign(std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const std::vector<byte> &PrivateKey, const std::vector<byte> &OptRand, const SPXParamSet &Params, bool Parallel)
+{
+	// pure signing with an empty context string: M' = 0 || 0 || M
+	std::vector<byte> msg(MsgLength + 2, 0);
+
+	MemUtils::Copy(Message, MsgOffset, msg, 2, MsgLength);
+	SignInternal(Signature, msg, PrivateKey, OptRand, Params, Parallel);
+}
+
+void SPXCore::SignInternal(std::vector<byte> &Signature, const std::vector<byte> &Message, const std::vector<byte> &PrivateKey, const std::vector<byte> &OptRand, const SPXParamSet &Params, bool Parallel)
+{
+	CexAssert(PrivateKey.size() >= 4 * Params.N, "The private key is too small");
+	CexAssert(OptRand.size() == Params.N, "The randomizer size is invalid");
+
+	SPXState state(Params, Parallel);
+	const size_t HTOFF = state.N + (state.K * (state.A + 1) * state.N);
+	const size_t XMSSLEN = (state.Len + state.HP) * state.N;
+	std::vector<byte> dgt(state.M);
+	std::vector<uint> idx(state.K);
+	std::vector<byte> pkFors(state.N);
+	std::vector<byte> pkRoot(state.N);
+	std::vector<byte> rnd(state.N);
+	std::vector<byte> roots(state.K * state.N);
+	std::vector<byte> skPrf(state.N);
+	std::vector<SPXAddress> adrs(1);
+	ulong tree;
+	uint leaf;
+
+	MemUtils::Copy(PrivateKey, 0, state.SkSeed, 0, state.N);
+	MemUtils::Copy(PrivateKey, state.N, skPrf, 0, state.N);
+	MemUtils::Copy(PrivateKey, 2 * state.N, state.PkSeed, 0, state.N);
+	MemUtils::Copy(PrivateKey, 3 * state.N, pkRoot, 0, state.N);
+	LoadSeed(state);
+
+	// the message is the formatted M' of FIPS 205 slh_sign_internal
+	PrfMessage(state, rnd, skPrf, OptRand, Message);
+
+	if (Signature.size() < Params.SignatureSize)
+	{
+		Signature.resize(Params.SignatureSize);
+	}
+
+	MemUtils::Copy(rnd, 0, Signature, 0, state.N);
+	HashMessage(state, dgt, rnd, pkRoot, Message);
+	SplitDigest(state, dgt, idx, tree, leaf);
+
+	// the fors trees are independent, each thread signs a contiguous range of trees
+	ParallelRange(state.K, Parallel, [&state, &Signature, &roots, &idx, tree, leaf](size_t First, size_t Count)
+	{
+		ForsSign(state, Signature, state.N, roots, idx, tree, leaf, First, Count);
+	});
+
+	SetLayer(adrs[0], 0);
+	SetTree(adrs[0], tree);
+	SetType(adrs[0], ADRS_FORSROOTS);
+	SetKeyPair(adrs[0], leaf);
+	ThashX(state, pkFors, roots, state.K * state.N, adrs);
+
+	// the tree and leaf index on each layer of the hypertree
+	const ulong LEAFMSK = (static_cast<ulong>(1) << state.HP) - 1;
+	std::vector<ulong> trees(state.D);
+	std::vector<uint> leaves(state.D);
+	std::vector<byte> xroots(state.D * state.N);
+
+	trees[0] = tree;
+	leaves[0] = leaf;
+
+	for (size_t i = 1; i < state.D; ++i)
+	{
+		leaves[i] = static_cast<uint>(trees[i - 1] & LEAFMSK);
+		trees[i] = trees[i - 1] >> state.HP;
+	}
+
+	// the xmss trees do not depend on each other; the authentication paths and roots are built in parallel
+	ParallelRange(state.D, Parallel, [&state, &Signature, &xroots, &trees, &leaves, HTOFF, XMSSLEN](size_t First, size_t Count)
+	{
+		for (size_t i = First; i < First + Count; ++i)
+		{
+			XmssTree(state, static_cast<uint>(i), trees[i], leaves[i], Signature, HTOFF + (i * XMSSLEN) + (state.Len * state.N), xroots, i * state.N);
+		}
+	});
+
+	// each layer signs the root of the layer beneath it, the bottom layer signs the fors public key
+	ParallelRange(state.D, Parallel, [&state, &Signature, &pkFors, &xroots, &trees, &leaves, HTOFF, XMSSLEN](size_t First, size_t Count)
+	{
+		for (size_t i = First; i < First + Count; ++i)
+		{
+			if (i == 0)
+			{
+				WotsSign(state, Signature, HTOFF, pkFors, 0, 0, trees[0], leaves[0]);
+			}
+			else
+			{
+				WotsSign(state, Signature, HTOFF + (i * XMSSLEN), xroots, (i - 1) * state.N, static_cast<uint>(i), trees[i], leaves[i]);
+			}
+		}
+	});
+
+	IntUtils::ClearVector(skPrf);
+	IntUtils::ClearVector(state.SkSeed);
+}
+
+bool SPXCore::Verify(const std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const std::vector<byte> &PublicKey, const SPXParamSet &Params)
+{
+	if (Signature.size() < Params.SignatureSize || PublicKey.size() < 2 * Params.N)
+	{
+		return false;
+	}
+
+	SPXState state(Params, false);
+	const size_t HTOFF = state.N + (state.K * (state.A + 1) * state.N);
+	const size_t XMSSLEN = (state.Len + state.HP) * state.N;
+	const ulong LEAFMSK = (static_cast<ulong>(1) << state.HP) - 1;
+	std::vector<byte> dgt(state.M);
+	std::vector<uint> idx(state.K);
+	std::vector<byte> msg(MsgLength + 2, 0);
+	std::vector<byte> node(state.N);
+	std::vector<byte> pkRoot(state.N);
+	std::vector<byte> rnd(state.N);
+	std::vector<byte> roots(state.K * state.N);
+	std::vector<SPXAddress> adrs(1);
+	ulong tree;
+	uint leaf;
+
+	MemUtils::Copy(PublicKey, 0, state.PkSeed, 0, state.N);
+	MemUtils::Copy(PublicKey, state.N, pkRoot, 0, state.N);
+	LoadSeed(state);
+
+	MemUtils::Copy(Message, MsgOffset, msg, 2, MsgLength);
+	MemUtils::Copy(Signature, 0, rnd, 0, state.N);
+	HashMessage(state, dgt, rnd, pkRoot, msg);
+	SplitDigest(state, dgt, idx, tree, leaf);
+
+	ForsRoots(state, roots, Signature, state.N, idx, tree, leaf);
+	SetLayer(adrs[0], 0);
+	SetTree(adrs[0], tree);
+	SetType(adrs[0], ADRS_FORSROOTS);
+	SetKeyPair(adrs[0], leaf);
+	ThashX(state, node, roots, state.K * state.N, adrs);
+
+	for (size_t i = 0; i < state.D; ++i)
+	{
+		XmssRoot(state, node, Signature, HTOFF + (i * XMSSLEN), static_cast<uint>(i), tree, leaf);
+		leaf = static_cast<uint>(tree & LEAFMSK);
+		tree >>= state.HP;
+	}
+
+	return IntUtils::Compare(node, 0, pkRoot, 0, state.N);
+}
+
+//~~~Hypertree~~~//
+
+void SPXCore::ForsRoots(const SPXState &State, std::vector<byte> &Roots, const std::vector<byte> &Signature, size_t SigOffset, const std::vector<uint> &Indices, ulong Tree, uint KeyPair)
+{
+	const size_t TREELEN = (State.A + 1) * State.N;
+	std::vector<SPXAddress> adrs(State.K);
+	std::vector<byte> nodes(State.K * State.N);
+	std::vector<byte> pairs(2 * State.K * State.N);
+	SPXAddress base = { 0 };
+
+	SetLayer(base, 0);
+	SetTree(base, Tree);
+	SetType(base, ADRS_FORSTREE);
+	SetKeyPair(base, KeyPair);
+
+	// the k trees are climbed together, one level of every tree per hash call
+	for (size_t i = 0; i < State.K; ++i)
+	{
+		MemUtils::Copy(Signature, SigOffset + (i * TREELEN), nodes, i * State.N, State.N);
+		adrs[i] = base;
+		SetTreeHeight(adrs[i], 0);
+		SetTreeIndex(adrs[i], static_cast<uint>((i << State.A) + Indices[i]));
+	}
+
+	ThashX(State, Roots, nodes, State.N, adrs);
+
+	for (size_t i = 0; i < State.A; ++i)
+	{
+		for (size_t j = 0; j < State.K; ++j)
+		{
+			const uint IDX = static_cast<uint>((j << State.A) + Indices[j]);
+			const size_t AUTHOFF = SigOffset + (j * TREELEN) + State.N + (i * State.N);
+
+			if (((IDX >> i) & 1) == 0)
+			{
+				MemUtils::Copy(Roots, j * State.N, pairs, 2 * j * State.N, State.N);
+				MemUtils::Copy(Signature, AUTHOFF, pairs, ((2 * j) + 1) * State.N, State.N);
+			}
+			else
+			{
+				MemUtils::Copy(Signature, AUTHOFF, pairs, 2 * j * State.N, State.N);
+				MemUtils::Copy(Roots, j * State.N, pairs, ((2 * j) + 1) * State.N, State.N);
+			}
+
+			adrs[j] = base;
+			SetTreeHeight(adrs[j], static_cast<uint>(i + 1));
+			SetTreeIndex(adrs[j], IDX >> (i + 1));
+		}
+
+		ThashX(State, Roots, pairs, 2 * State.N, adrs);
+	}
+}
+
+void SPXCore::ForsSign(const SPXState &State, std::vector<byte> &Signature, size_t SigOffset, std::vector<byte> &Roots, const std::vector<uint> &Indices, ulong Tree, uint KeyPair, size_t First, size_t Count)
+{
+	const size_t LEAFCNT = static_cast<size_t>(1) << State.A;
+	const size_t TREELEN = (State.A + 1) * State.N;
+	std::vector<SPXAddress> adrs(LEAFCNT);
+	std::vector<byte> nodes(LEAFCNT * State.N);
+	std::vector<byte> sks(LEAFCNT * State.N);
+	SPXAddress base = { 0 };
+
+	SetLayer(base, 0);
+	SetTree(base, Tree);
+	SetType(base, ADRS_FORSTREE);
+	SetKeyPair(base, KeyPair);
+
+	for (size_t i = First; i < First + Count; ++i)
+	{
+		const uint IDXOFF = static_cast<uint>(i << State.A);
+
+		// the secret leaf values
+		for (size_t j = 0; j < LEAFCNT; ++j)
+		{
+			adrs[j] = base;
+			SetType(adrs[j], ADRS_FORSPRF);
+			SetKeyPair(adrs[j], KeyPair);
+			SetTreeIndex(adrs[j], IDXOFF + static_cast<uint>(j));
+		}
+
+		PrfX(State, sks, adrs);
+		MemUtils::Copy(sks, Indices[i] * State.N, Signature, SigOffset + (i * TREELEN), State.N);
+
+		// the leaves are the hashed secrets
+		for (size_t j = 0; j < LEAFCNT; ++j)
+		{
+			adrs[j] = base;
+			SetTreeHeight(adrs[j], 0);
+			SetTreeIndex(adrs[j], IDXOFF + static_cast<uint>(j));
+		}
+
+		ThashX(State, nodes, sks, State.N, adrs);
+		TreeHash(State, nodes, State.A, Indices[i], IDXOFF, base, Signature, SigOffset + (i * TREELEN) + State.N, Roots, i * State.N);
+	}
+
+	IntUtils::ClearVector(sks);
+}
+
+void SPXCore::TreeHash(const SPXState &State, std::vector<byte> &Nodes, size_t Height, uint LeafIndex, uint IndexOffset, const SPXAddress &Base, std::vector<byte> &Auth, size_t AuthOffset, std::vector<byte> &Root, size_t RootOffset)
+{
+	std::vector<SPXAddress> adrs;
+	std::vector<byte> parents;
+
+	// every level of the tree is hashed in a single multi-lane call
+	for (size_t i = 0; i < Height; ++i)
+	{
+		const size_t PARCNT = static_cast<size_t>(1) << (Height - i - 1);
+
+		MemUtils::Copy(Nodes, ((LeafIndex >> i) ^ 1) * State.N, Auth, AuthOffset + (i * State.N), State.N);
+		adrs.resize(PARCNT);
+		parents.resize(PARCNT * State.N);
+
+		for (size_t j = 0; j < PARCNT; ++j)
+		{
+			adrs[j] = Base;
+			SetTreeHeight(adrs[j], static_cast<uint>(i + 1));
+			SetTreeIndex(adrs[j], (IndexOffset >> (i + 1)) + static_cast<uint>(j));
+		}
+
+		ThashX(State, parents, Nodes, 2 * State.N, adrs);
+		MemUtils::Copy(parents, 0, Nodes, 0, PARCNT * State.N);
+	}
+
+	MemUtils::Copy(Nodes, 0, Root, RootOffset, State.N);
+}
+
+void SPXCore::WotsChain(const SPXState &State, std::vector<byte> &Nodes, const std::vector<SPXAddress> &Address, const std::vector<uint> &Start, const std::vector<uint> &Steps)
+{
+	std::vector<size_t> act;
+	std::vector<SPXAddress> adrs;
+	std::vector<byte> inp;
+	std::vector<byte> otp;
+	uint stpMax = 0;
+
+	for (size_t i = 0; i < Steps.size(); ++i)
+	{
+		stpMax = (Steps[i] > stpMax) ? Steps[i] : stpMax;
+	}
+
+	act.reserve(Address.size());
+	adrs.reserve(Address.size());
+
+	// each step advances every chain that has not reached its end
+	for (uint i = 0; i < stpMax; ++i)
+	{
+		act.clear();
+		adrs.clear();
+
+		for (size_t j = 0; j < Address.size(); ++j)
+		{
+			if (i < Steps[j])
+			{
+				act.push_back(j);
+				adrs.push_back(Address[j]);
+				SetHash(adrs.back(), Start[j] + i);
+			}
+		}
+
+		inp.resize(act.size() * State.N);
+		otp.resize(act.size() * State.N);
+
+		for (size_t j = 0; j < act.size(); ++j)
+		{
+			MemUtils::Copy(Nodes, act[j] * State.N, inp, j * State.N, State.N);
+		}
+
+		ThashX(State, otp, inp, State.N, adrs);
+
+		for (size_t j = 0; j < act.size(); ++j)
+		{
+			MemUtils::Copy(otp, j * State.N, Nodes, act[j] * State.N, State.N);
+		}
+	}
+}
+
+void SPXCore::WotsDigits(const SPXState &State, std::vector<uint> &Digits, const std::vector<byte> &Message, size_t MsgOffset)
+{
+	uint csum = 0;
+
+	BaseB(Digits, Message, MsgOffset, 4, State.Len1);
+
+	for (size_t i = 0; i < State.Len1; ++i)
+	{
+		csum += (WOTS_W - 1) - Digits[i];
+	}
+
+	// the 12 bit checksum, most significant digit first
+	Digits[State.Len1] = (csum >> 8) & 0x0F;
+	Digits[State.Len1 + 1] = (csum >> 4) & 0x0F;
+	Digits[State.Len1 + 2] = csum & 0x0F;
+}
+
+void SPXCore::WotsLeaves(const SPXState &State, std::vector<byte> &Leaves, size_t LeafOffset, uint Layer, ulong Tree, uint FirstLeaf, size_t Count)
+{
+	const size_t CHNCNT = Count * State.Len;
+	std::vector<SPXAddress> adrs(CHNCNT);
+	std::vector<byte> nodes(CHNCNT * State.N);
+	std::vector<SPXAddress> pkAdrs(Count);
+	std::vector<byte> pks(Count * State.N);
+	SPXAddress base = { 0 };
+
+	SetLayer(base, Layer);
+	SetTree(base, Tree);
+
+	// the chains of all the leaves are run together
+	for (size_t i = 0; i < Count; ++i)
+	{
+		for (size_t j = 0; j < State.Len; ++j)
+		{
+			SPXAddress &adr = adrs[(i * State.Len) + j];
+			adr = base;
+			SetType(adr, ADRS_WOTSPRF);
+			SetKeyPair(adr, FirstLeaf + static_cast<uint>(i));
+			SetChain(adr, static_cast<uint>(j));
+		}
+	}
+
+	PrfX(State, nodes, adrs);
+
+	for (size_t i = 0; i < CHNCNT; ++i)
+	{
+		SetType(adrs[i], ADRS_WOTSHASH);
+		SetKeyPair(adrs[i], FirstLeaf + static_cast<uint>(i / State.Len));
+		SetChain(adrs[i], static_cast<uint>(i % State.Len));
+	}
+
+	WotsChain(State, nodes, adrs, std::vector<uint>(CHNCNT, 0), std::vector<uint>(CHNCNT, WOTS_W - 1));
+
+	// compress each chain set to a leaf
+	for (size_t i = 0; i < Count; ++i)
+	{
+		pkAdrs[i] = base;
+		SetType(pkAdrs[i], ADRS_WOTSPK);
+		SetKeyPair(pkAdrs[i], FirstLeaf + static_cast<uint>(i));
+	}
+
+	ThashX(State, pks, nodes, State.Len * State.N, pkAdrs);
+	MemUtils::Copy(pks, 0, Leaves, LeafOffset, Count * State.N);
+}
+
+void SPXCore::WotsSign(const SPXState &State, std::vector<byte> &Signature, size_t SigOffset, const std::vector<byte> &Message, size_t MsgOffset, uint Layer, ulong Tree, uint KeyPair)
+{
+	std::vector<SPXAddress> adrs(State.Len);
+	std::vector<uint> digits(State.Len);
+	std::vector<byte> nodes(State.Len * State.N);
+	SPXAddress base = { 0 };
+
+	WotsDigits(State, digits, Message, MsgOffset);
+	SetLayer(base, Layer);
+	SetTree(base, Tree);
+
+	for (size_t i = 0; i < State.Len; ++i)
+	{
+		adrs[i] = base;
+		SetType(adrs[i], ADRS_WOTSPRF);
+		SetKeyPair(adrs[i], KeyPair);
+		SetChain(adrs[i], static_cast<uint>(i));
+	}
+
+	PrfX(State, nodes, adrs);
+
+	for (size_t i = 0; i < State.Len; ++i)
+	{
+		SetType(adrs[i], ADRS_WOTSHASH);
+		SetKeyPair(adrs[i], KeyPair);
+		SetChain(adrs[i], static_cast<uint>(i));
+	}
+
+	WotsChain(State, nodes, adrs, std::vector<uint>(State.Len, 0), digits);
+	MemUtils::Copy(nodes, 0, Signature, SigOffset, State.Len * State.N);
+}
+
+void SPXCore::XmssRoot(const SPXState &State, std::vector<byte> &Root, const std::vector<byte> &Signature, size_t SigOffset, uint Layer, ulong Tree, uint KeyPair)
+{
+	std::vector<SPXAddress> adrs(State.Len);
+	std::vector<uint> digits(State.Len);
+	std::vector<byte> nodes(State.Len * State.N);
+	std::vector<byte> pair(2 * State.N);
+	std::vector<uint> steps(State.Len);
+	std::vector<SPXAddress> nodeAdrs(1);
+	SPXAddress base = { 0 };
+
+	WotsDigits(State, digits, Root, 0);
+	SetLayer(base, Layer);
+	SetTree(base, Tree);
+	MemUtils::Copy(Signature, SigOffset, nodes, 0, State.Len * State.N);
+
+	// complete the chains from the signed positions
+	for (size_t i = 0; i < State.Len; ++i)
+	{
+		adrs[i] = base;
+		SetType(adrs[i], ADRS_WOTSHASH);
+		SetKeyPair(adrs[i], KeyPair);
+		SetChain(adrs[i], static_cast<uint>(i));
+		steps[i] = (WOTS_W - 1) - digits[i];
+	}
+
+	WotsChain(State, nodes, adrs, digits, steps);
+
+	nodeAdrs[0] = base;
+	SetType(nodeAdrs[0], ADRS_WOTSPK);
+	SetKeyPair(nodeAdrs[0], KeyPair);
+	ThashX(State, Root, nodes, State.Len * State.N, nodeAdrs);
+
+	// climb the tree with the authentication path
+	for (size_t i = 0; i < State.HP; ++i)
+	{
+		const size_t AUTHOFF = SigOffset + ((State.Len + i) * State.N);
+
+		if (((KeyPair >> i) & 1) == 0)
+		{
+			MemUtils::Copy(Root, 0, pair, 0, State.N);
+			MemUtils::Copy(Signature, AUTHOFF, pair, State.N, State.N);
+		}
+		else
+		{
+			MemUtils::Copy(Signature, AUTHOFF, pair, 0, State.N);
+			MemUtils::Copy(Root, 0, pair, State.N, State.N);
+		}
+
+		nodeAdrs[0] = base;
+		SetType(nodeAdrs[0], ADRS_TREE);
+		SetTreeHeight(nodeAdrs[0], static_cast<uint>(i + 1));
+		SetTreeIndex(nodeAdrs[0], KeyPair >> (i + 1));
+		ThashX(State, Root, pair, 2 * State.N, nodeAdrs);
+	}
+}
+
+void SPXCore::XmssTree(const SPXState &State, uint Layer, ulong Tree, uint LeafIndex, std::vector<byte> &Auth, size_t AuthOffset, std::vector<byte> &Root, size_t RootOffset)
+{
+	const size_t LEAFCNT = static_cast<size_t>(1) << State.HP;
+	std::vector<byte> leaves(LEAFCNT * State.N);
+	SPXAddress base = { 0 };
+
+	WotsLeaves(State, leaves, 0, Layer, Tree, 0, LEAFCNT);
+	SetLayer(base, Layer);
+	SetTree(base, Tree);
+	SetType(base, ADRS_TREE);
+	TreeHash(State, leaves, State.HP, LeafIndex, 0, base, Auth, AuthOffset, Root, RootOffset);
+}
+
+//~~~Hashing~~~//
+
+void SPXCore::HashMessage(const SPXState &State, std::vector<byte> &Digest, const std::vector<byte> &R, const std::vector<byte> &PkRoot, const std::vector<byte> &Message)
+{
+	if (State.IsShake)
+	{
+		// H_msg = SHAKE256(R || PK.seed || PK.root || M', m)
+		Kdf::SHAKE gen(Digests::Keccak512);
+		std::vector<byte> key(R.size() + State.PkSeed.size() + PkRoot.size() + Message.size());
+
+		MemUtils::Copy(R, 0, key, 0, R.size());
+		MemUtils::Copy(State.PkSeed, 0, key, R.size(), State.PkSeed.size());
+		MemUtils::Copy(PkRoot, 0, key, R.size() + State.PkSeed.size(), PkRoot.size());
+		MemUtils::Copy(Message, 0, key, R.size() + State.PkSeed.size() + PkRoot.size(), Message.size());
+		gen.Initialize(key);
+		gen.Generate(Digest, 0, State.M);
+	}
+	else
+	{
+		// H_msg = MGF1-SHA2(R || PK.seed || SHA2(R || PK.seed || PK.root || M'), m), SHA2-512 for the 192 and 256 bit sets
+		std::unique_ptr<IDigest> dgt(Helper::DigestFromName::GetInstance(State.IsSha512 ? Digests::SHA512 : Digests::SHA256));
+		std::vector<byte> ctr(4);
+		std::vector<byte> hash(dgt->DigestSize());
+		size_t pos = 0;
+
+		dgt->Update(R, 0, R.size());
+		dgt->Update(State.PkSeed, 0, State.PkSeed.size());
+		dgt->Update(PkRoot, 0, PkRoot.size());
+		dgt->Update(Message, 0, Message.size());
+		dgt->Finalize(hash, 0);
+
+		std::vector<byte> seed(R.size() + State.PkSeed.size() + hash.size());
+		MemUtils::Copy(R, 0, seed, 0, R.size());
+		MemUtils::Copy(State.PkSeed, 0, seed, R.size(), State.PkSeed.size());
+		MemUtils::Copy(hash, 0, seed, R.size() + State.PkSeed.size(), hash.size());
+
+		for (uint i = 0; pos < State.M; ++i)
+		{
+			const size_t RMDLEN = IntUtils::Min(hash.size(), State.M - pos);
+
+			IntUtils::Be32ToBytes(i, ctr, 0);
+			dgt->Update(seed, 0, seed.size());
+			dgt->Update(ctr, 0, ctr.size());
+			dgt->Finalize(hash, 0);
+			MemUtils::Copy(hash, 0, Digest, pos, RMDLEN);
+			pos += RMDLEN;
+		}
+	}
+}
+
+void SPXCore::LoadSeed(SPXState &State)
+{
+	// the sha2 public seed fills a whole block, the state after compressing it is shared by every tweakable hash
+	if (!State.IsShake)
+	{
+		std::array<uint, 16> w = { 0 };
+		std::vector<byte> blk(SHA2_BLOCK, 0);
+
+		MemUtils::Copy(State.PkSeed, 0, blk, 0, State.N);
+
+		for (size_t i = 0; i < w.size(); ++i)
+		{
+			w[i] = IntUtils::BeBytesTo32(blk, i * sizeof(uint));
+		}
+
+		for (size_t i = 0; i < State.SeedState.size(); ++i)
+		{
+			State.SeedState[i] = SHA256_IV[i];
+		}
+
+		Compress(State.SeedState, w);
+	}
+}
+
+void SPXCore::PrfMessage(const SPXState &State, std::vector<byte> &R, const std::vector<byte> &SkPrf, const std::vector<byte> &OptRand, const std::vector<byte> &Message)
+{
+	if (State.IsShake)
+	{
+		// PRF_msg = SHAKE256(SK.prf || OptRand || M', n)
+		Kdf::SHAKE gen(Digests::Keccak512);
+		std::vector<byte> key(SkPrf.size() + OptRand.size() + Message.size());
+
+		MemUtils::Copy(SkPrf, 0, key, 0, SkPrf.size());
+		MemUtils::Copy(OptRand, 0, key, SkPrf.size(), OptRand.size());
+		MemUtils::Copy(Message, 0, key, SkPrf.size() + OptRand.size(), Message.size());
+		gen.Initialize(key);
+		gen.Generate(R, 0, State.N);
+		IntUtils::ClearVector(key);
+	}
+	else
+	{
+		// PRF_msg = HMAC-SHA2(SK.prf, OptRand || M'), truncated to n bytes, SHA2-512 for the 192 and 256 bit sets
+		Mac::HMAC gen(State.IsSha512 ? Digests::SHA512 : Digests::SHA256);
+		Key::Symmetric::SymmetricKey kp(SkPrf);
+		std::vector<byte> code(gen.MacSize());
+
+		gen.Initialize(kp);
+		gen.Update(OptRand, 0, OptRand.size());
+		gen.Update(Message, 0, Message.size());
+		gen.Finalize(code, 0);
+		MemUtils::Copy(code, 0, R, 0, State.N);
+	}
+}
+
+void SPXCore::PrfX(const SPXState &State, std::vector<byte> &Output, const std::vector<SPXAddress> &Address)
+{
+	std::vector<byte> sks(Address.size() * State.N);
+
+	for (size_t i = 0; i < Address.size(); ++i)
+	{
+		MemUtils::Copy(State.SkSeed, 0, sks, i * State.N, State.N);
+	}
+
+	ThashX(State, Output, sks, State.N, Address);
+	IntUtils::ClearVector(sks);
+}
+
+void SPXCore::Sha256X(const SPXState &State, std::vector<byte> &Output, const std::vector<byte> &Input, size_t InLength, const std::vector<SPXAddress> &Address)
+{
+	// the message follows the padded seed block: ADRSc || M || padding
+	const size_t MSGLEN = ADRSC_SIZE + InLength;
+	const size_t BLKCNT = (MSGLEN + 9 + SHA2_BLOCK - 1) / SHA2_BLOCK;
+	const size_t PADLEN = BLKCNT * SHA2_BLOCK;
+	const size_t CNT = Address.size();
+	std::vector<byte> msg(SHA2_LANES * PADLEN);
+	size_t i = 0;
+
+	while (i < CNT)
+	{
+		const size_t LNECNT = IntUtils::Min(SHA2_LANES, CNT - i);
+
+		MemUtils::Clear(msg, 0, msg.size());
+
+		for (size_t j = 0; j < LNECNT; ++j)
+		{
+			const SPXAddress &adr = Address[i + j];
+			const size_t MSGOFF = j * PADLEN;
+
+			// the compressed address: layer, tree, type, and the last three words
+			msg[MSGOFF] = adr[3];
+			MemUtils::Copy(adr, 8, msg, MSGOFF + 1, 8);
+			msg[MSGOFF + 9] = adr[19];
+			MemUtils::Copy(adr, 20, msg, MSGOFF + 10, 12);
+			MemUtils::Copy(Input, (i + j) * InLength, msg, MSGOFF + ADRSC_SIZE, InLength);
+			msg[MSGOFF + MSGLEN] = 0x80;
+			IntUtils::Be64ToBytes(static_cast<ulong>(SHA2_BLOCK + MSGLEN) * 8, msg, MSGOFF + PADLEN - sizeof(ulong));
+		}
+
+		if (LNECNT == 1)
+		{
+			std::array<uint, 8> st = State.SeedState;
+			std::array<uint, 16> w;
+
+			for (size_t j = 0; j < BLKCNT; ++j)
+			{
+				for (size_t k = 0; k < w.size(); ++k)
+				{
+					w[k] = IntUtils::BeBytesTo32(msg, (j * SHA2_BLOCK) + (k * sizeof(uint)));
+				}
+
+				Compress(st, w);
+			}
+
+			for (size_t j = 0; j < State.N / sizeof(uint); ++j)
+			{
+				IntUtils::Be32ToBytes(st[j], Output, (i * State.N) + (j * sizeof(uint)));
+			}
+		}
+		else
+		{
+			// the lanes are transposed, word k of lane j is at [(k * 8) + j]
+			std::array<uint, 8 * SHA2_LANES> st;
+			std::array<uint, 16 * SHA2_LANES> w;
+
+			for (size_t j = 0; j < 8; ++j)
+			{
+				for (size_t k = 0; k < SHA2_LANES; ++k)
+				{
+					st[(j * SHA2_LANES) + k] = State.SeedState[j];
+				}
+			}
+
+			for (size_t j = 0; j < BLKCNT; ++j)
+			{
+				for (size_t k = 0; k < 16; ++k)
+				{
+					for (size_t l = 0; l < SHA2_LANES; ++l)
+					{
+						w[(k * SHA2_LANES) + l] = IntUtils::BeBytesTo32(msg, (l * PADLEN) + (j * SHA2_BLOCK) + (k * sizeof(uint)));
+					}
+				}
+
+				CompressW(st, w);
+			}
+
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				for (size_t k = 0; k < State.N / sizeof(uint); ++k)
+				{
+					IntUtils::Be32ToBytes(st[(k * SHA2_LANES) + j], Output, ((i + j) * State.N) + (k * sizeof(uint)));
+				}
+			}
+		}
+
+		i += LNECNT;
+	}
+}
+
+void SPXCore::Sha512X(const SPXState &State, std::vector<byte> &Output, const std::vector<byte> &Input, size_t InLength, const std::vector<SPXAddress> &Address)
+{
+	// Trunc_n(SHA2-512(PK.seed || toByte(0, 128 - n) || ADRSc || M)), hashed one lane at a time
+	Digest::SHA512 dgt;
+	std::vector<byte> adrc(ADRSC_SIZE);
+	std::vector<byte> blk(SHA512_BLOCK, 0);
+	std::vector<byte> hash(dgt.DigestSize());
+
+	MemUtils::Copy(State.PkSeed, 0, blk, 0, State.N);
+
+	for (size_t i = 0; i < Address.size(); ++i)
+	{
+		const SPXAddress &adr = Address[i];
+
+		adrc[0] = adr[3];
+		MemUtils::Copy(adr, 8, adrc, 1, 8);
+		adrc[9] = adr[19];
+		MemUtils::Copy(adr, 20, adrc, 10, 12);
+		dgt.Update(blk, 0, blk.size());
+		dgt.Update(adrc, 0, adrc.size());
+		dgt.Update(Input, i * InLength, InLength);
+		dgt.Finalize(hash, 0);
+		MemUtils::Copy(hash, 0, Output, i * State.N, State.N);
+	}
+}
+
+void SPXCore::ShakeX(const SPXState &State, std::vector<byte> &Output, const std::vector<byte> &Input, size_t InLength, const std::vector<SPXAddress> &Address)
+{
+	// PK.seed || ADRS || M || padding
+	const size_t MSGLEN = State.N + ADRS_SIZE + InLength;
+	const size_t BLKCNT = (MSGLEN / SHAKE_RATE) + 1;
+	const size_t PADLEN = BLKCNT * SHAKE_RATE;
+	const size_t CNT = Address.size();
+	const size_t LANES = Keccak::PARALLEL_LANES;
+	std::vector<byte> msg(LANES * PADLEN);
+	size_t i = 0;
+
+	while (i < CNT)
+	{
+		const size_t LNECNT = IntUtils::Min(LANES, CNT - i);
+
+		MemUtils::Clear(msg, 0, msg.size());
+
+		for (size_t j = 0; j < LNECNT; ++j)
+		{
+			const size_t MSGOFF = j * PADLEN;
+
+			MemUtils::Copy(State.PkSeed, 0, msg, MSGOFF, State.N);
+			MemUtils::Copy(Address[i + j], 0, msg, MSGOFF + State.N, ADRS_SIZE);
+			MemUtils::Copy(Input, (i + j) * InLength, msg, MSGOFF + State.N + ADRS_SIZE, InLength);
+			msg[MSGOFF + MSGLEN] ^= 0x1F;
+			msg[MSGOFF + PADLEN - 1] ^= 0x80;
+		}
+
+		if (LNECNT == 1)
+		{
+			std::vector<ulong> st(25, 0);
+
+			for (size_t j = 0; j < BLKCNT; ++j)
+			{
+				for (size_t k = 0; k < SHAKE_RATE / sizeof(ulong); ++k)
+				{
+					st[k] ^= IntUtils::LeBytesTo64(msg, (j * SHAKE_RATE) + (k * sizeof(ulong)));
+				}
+
+				Keccak::PermuteR(st, 24);
+			}
+
+			for (size_t j = 0; j < State.N / sizeof(ulong); ++j)
+			{
+				IntUtils::Le64ToBytes(st[j], Output, (i * State.N) + (j * sizeof(ulong)));
+			}
+		}
+		else
+		{
+			std::vector<ulong> st(25 * LANES, 0);
+
+			for (size_t j = 0; j < BLKCNT; ++j)
+			{
+				for (size_t k = 0; k < SHAKE_RATE / sizeof(ulong); ++k)
+				{
+					for (size_t l = 0; l < LANES; ++l)
+					{
+						st[(k * LANES) + l] ^= IntUtils::LeBytesTo64(msg, (l * PADLEN) + (j * SHAKE_RATE) + (k * sizeof(ulong)));
+					}
+				}
+
+				Keccak::PermuteP4x(st);
+			}
+
+			for (size_t j = 0; j < LNECNT; ++j)
+			{
+				for (size_t k = 0; k < State.N / sizeof(ulong); ++k)
+				{
+					IntUtils::Le64ToBytes(st[(k * LANES) + j], Output, ((i + j) * State.N) + (k * sizeof(ulong)));
+				}
+			}
+		}
+
+		i += LNECNT;
+	}
+}
+
+void SPXCore::SplitDigest(const SPXState &State, const std::vector<byte> &Digest, std::vector<uint> &Indices, ulong &Tree, uint &Leaf)
+{
+	const size_t FORSLEN = ((State.K * State.A) + 7) / 8;
+	const size_t TREEBITS = State.H - State.HP;
+	const size_t TREELEN = (TREEBITS + 7) / 8;
+	const size_t LEAFLEN = (State.HP + 7) / 8;
+
+	BaseB(Indices, Digest, 0, State.A, State.K);
+
+	Tree = 0;
+
+	for (size_t i = 0; i < TREELEN; ++i)
+	{
+		Tree = (Tree << 8) | Digest[FORSLEN + i];
+	}
+
+	if (TREEBITS < 64)
+	{
+		Tree &= (static_cast<ulong>(1) << TREEBITS) - 1;
+	}
+
+	Leaf = 0;
+
+	for (size_t i = 0; i < LEAFLEN; ++i)
+	{
+		Leaf = (Leaf << 8) | Digest[FORSLEN + TREELEN + i];
+	}
+
+	Leaf &= (static_cast<uint>(1) << State.HP) - 1;
+}
+
+void SPXCore::ThashX(const SPXState &State, std::vector<byte> &Output, const std::vector<byte> &Input, size_t InLength, const std::vector<SPXAddress> &Address)
+{
+	if (State.IsShake)
+	{
+		ShakeX(State, Output, Input, InLength, Address);
+	}
+	else if (State.IsSha512 && InLength > State.N)
+	{
+		// H and T of the 192 and 256 bit sets, F and PRF remain SHA2-256
+		Sha512X(State, Output, Input, InLength, Address);
+	}
+	else
+	{
+		Sha256X(State, Output, Input, InLength, Address);
+	}
+}
+
+//~~~SHA2~~~//
+
+template <typename T>
+void SPXCore::Compress(std::array<T, 8> &State, std::array<T, 16> &W)
+{
+	T a = State[0];
+	T b = State[1];
+	T c = State[2];
+	T d = State[3];
+	T e = State[4];
+	T f = State[5];
+	T g = State[6];
+	T h = State[7];
+
+	for (size_t i = 0; i < 64; ++i)
+	{
+		if (i >= 16)
+		{
+			T w2 = W[(i - 2) & 15];
+			T w15 = W[(i - 15) & 15];
+			W[i & 15] = W[i & 15] + (RotR(w2, 17) ^ RotR(w2, 19) ^ (w2 >> 10)) + W[(i - 7) & 15] + (RotR(w15, 7) ^ RotR(w15, 18) ^ (w15 >> 3));
+		}
+
+		T t1 = h + (RotR(e, 6) ^ RotR(e, 11) ^ RotR(e, 25)) + ((e & f) ^ (~e & g)) + T(SHA256_K[i]) + W[i & 15];
+		T t2 = (RotR(a, 2) ^ RotR(a, 13) ^ RotR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+
+	State[0] = State[0] + a;
+	State[1] = State[1] + b;
+	State[2] = State[2] + c;
+	State[3] = State[3] + d;
+	State[4] = State[4] + e;
+	State[5] = State[5] + f;
+	State[6] = State[6] + g;
+	State[7] = State[7] + h;
+}
+
+void SPXCore::CompressW(std::array<uint, 8 * SHA2_LANES> &State, std::array<uint, 16 * SHA2_LANES> &W)
+{
+#if defined(__AVX2__)
+
+	std::array<UInt256, 8> st;
+	std::array<UInt256, 16> w;
+
+	for (size_t i = 0; i < st.size(); ++i)
+	{
+		st[i].Load(State, i * SHA2_LANES);
+	}
+
+	for (size_t i = 0; i < w.size(); ++i)
+	{
+		w[i].Load(W, i * SHA2_LANES);
+	}
+
+	Compress(st, w);
+
+	for (size_t i = 0; i < st.size(); ++i)
+	{
+		st[i].Store(State, i * SHA2_LANES);
+	}
+
+#else
+
+	std::array<uint, 8> st;
+	std::array<uint, 16> w;
+
+	for (size_t i = 0; i < SHA2_LANES; ++i)
+	{
+		for (size_t j = 0; j < st.size(); ++j)
+		{
+			st[j] = State[(j * SHA2_LANES) + i];
+		}
+
+		for (size_t j = 0; j < w.size(); ++j)
+		{
+			w[j] = W[(j * SHA2_LANES) + i];
+		}
+
+		Compress(st, w);
+
+		for (size_t j = 0; j < st.size(); ++j)
+		{
+			State[(j * SHA2_LANES) + i] = st[j];
+		}
+	}
+
+#endif
+}
+
+uint SPXCore::RotR(uint X, int Shift)
+{
+	return (X >> Shift) | (X << (32 - Shift));
+}
+
+#if defined(__AVX2__)
+UInt256 SPXCore::RotR(const UInt256 &X, int Shift)
+{
+	return UInt256::RotR32(X, Shift);
+}
+#endif
+
+//~~~Address~~~//
+
+void SPXCore::SetChain(SPXAddress &Address, uint Chain)
+{
+	IntUtils::Be32ToBytes(Chain, Address, 24);
+}
+
+void SPXCore::SetHash(SPXAddress &Address, uint Hash)
+{
+	IntUtils::Be32ToBytes(Hash, Address, 28);
+}
+
+void SPXCore::SetKeyPair(SPXAddress &Address, uint KeyPair)
+{
+	IntUtils::Be32ToBytes(KeyPair, Address, 20);
+}
+
+void SPXCore::SetLayer(SPXAddress &Address, uint Layer)
+{
+	IntUtils::Be32ToBytes(Layer, Address, 0);
+}
+
+void SPXCore::SetTree(SPXAddress &Address, ulong Tree)
+{
+	IntUtils::Be32ToBytes(0, Address, 4);
+	IntUtils::Be64ToBytes(Tree, Address, 8);
+}
+
+void SPXCore::SetTreeHeight(SPXAddress &Address, uint Height)
+{
+	IntUtils::Be32ToBytes(Height, Address, 24);
+}
+
+void SPXCore::SetTreeIndex(SPXAddress &Address, uint Index)
+{
+	IntUtils::Be32ToBytes(Index, Address, 28);
+}
+
+void SPXCore::SetType(SPXAddress &Address, uint Type)
+{
+	// changing the type clears the type specific words
+	IntUtils::Be32ToBytes(Type, Address, 16);
+	MemUtils::Clear(Address, 20, 12);
+}
+
+//~~~Helpers~~~//
+
+void SPXCore::BaseB(std::vector<uint> &Output, const std::vector<byte> &Input, size_t InOffset, size_t Bits, size_t Count)
+{
+	const uint MASK = (static_cast<uint>(1) << Bits) - 1;
+	size_t bitCtr = 0;
+	uint total = 0;
+
+	// most significant bits first
+	for (size_t i = 0; i < Count; ++i)
+	{
+		while (bitCtr < Bits)
+		{
+			total = (total << 8) | Input[InOffset];
+			++InOffset;
+			bitCtr += 8;
+		}
+
+		bitCtr -= Bits;
+		Output[i] = (total >> bitCtr) & MASK;
+	}
+}
+
+void SPXCore::ParallelRange(size_t Count, bool Parallel, const std::function<void(size_t, size_t)> &Function)
+{
+	size_t thdCount = Parallel ? IntUtils::Min(ParallelUtils::ProcessorCount(), Count) : 1;
+
+	if (thdCount > 1)
+	{
+		const size_t CNKCNT = (Count + thdCount - 1) / thdCount;
+		thdCount = (Count + CNKCNT - 1) / CNKCNT;
+
+		ParallelUtils::ParallelFor(0, thdCount, [&Function, Count, CNKCNT](size_t i)
+		{
+			const size_t FIRST = i * CNKCNT;
+			Function(FIRST, IntUtils::Min(CNKCNT, Count - FIRST));
+		});
+	}
+	else
+	{
+		Function(0, Count);
+	}
+}
+
+NAMESPACE_SPHINCSEND
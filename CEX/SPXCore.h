@@ -0,0 +1,195 @@
+// The GPL version 3 License (GPLv3)
+// 
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+// 
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_SPXCORE_H
+#define CEX_SPXCORE_H
+
+#include "CexDomain.h"
+#include "IPrng.h"
+#include "SPXParamSet.h"
+#include <functional>
+#if defined(__AVX2__)
+#	include "UInt256.h"
+#endif
+
+NAMESPACE_SPHINCS
+
+using Prng::IPrng;
+#if defined(__AVX2__)
+using Numeric::UInt256;
+#endif
+
+/**
+* \internal
+*/
+
+/// <summary>
+/// The SPHINCS+ WOTS+, FORS and hypertree functions.
+/// <para>Every tweakable hash is computed in lanes; the chains, leaves and tree levels that do not depend on each other are collected and hashed together,
+/// 8 at a time with a transposed SHA2-256 compression, or 4 at a time with the interleaved Keccak permutation.
+/// The SHA2 192 and 256 bit sets hash H and T with SHA2-512 one lane at a time.</para>
+/// </summary>
+class SPXCore
+{
+private:
+
+	static const size_t ADRS_SIZE = 32;
+	static const size_t ADRSC_SIZE = 22;
+	static const size_t SHA2_BLOCK = 64;
+	static const size_t SHA2_LANES = 8;
+	static const size_t SHA512_BLOCK = 128;
+	static const size_t SHAKE_RATE = 136;
+	static const uint WOTS_W = 16;
+	static const uint WOTS_LEN2 = 3;
+	// the hash address types
+	static const uint ADRS_WOTSHASH = 0;
+	static const uint ADRS_WOTSPK = 1;
+	static const uint ADRS_TREE = 2;
+	static const uint ADRS_FORSTREE = 3;
+	static const uint ADRS_FORSROOTS = 4;
+	static const uint ADRS_WOTSPRF = 5;
+	static const uint ADRS_FORSPRF = 6;
+	static const uint SHA256_K[64];
+	static const uint SHA256_IV[8];
+
+	typedef std::array<byte, ADRS_SIZE> SPXAddress;
+
+	struct SPXState
+	{
+		size_t A;
+		size_t D;
+		size_t H;
+		size_t HP;
+		bool IsSha512;
+		bool IsShake;
+		size_t K;
+		size_t Len;
+		size_t Len1;
+		size_t M;
+		size_t N;
+		bool Parallel;
+		std::vector<byte> PkSeed;
+		std::array<uint, 8> SeedState;
+		std::vector<byte> SkSeed;
+
+		SPXState(const SPXParamSet &Params, bool IsParallel);
+	};
+
+public:
+
+	SPXCore() = delete;
+	SPXCore(const SPXCore&) = delete;
+	SPXCore& operator=(const SPXCore&) = delete;
+	SPXCore& operator=(SPXCore&&) = delete;
+
+	static void GetParamSet(SPXParamSet &Params, SPXParams Parameters);
+
+	static void Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, std::unique_ptr<IPrng> &Random, const SPXParamSet &Params, bool Parallel);
+
+	static void Generate(std::vector<byte> &PublicKey, std::vector<byte> &PrivateKey, const std::vector<byte> &Seeds, const SPXParamSet &Params, bool Parallel);
+
+	static void Sign(std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const std::vector<byte> &PrivateKey, std::unique_ptr<IPrng> &Random, const SPXParamSet &Params, bool Parallel);
+
+	static void Sign(std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const std::vector<byte> &PrivateKey, const std::vector<byte> &OptRand, const SPXParamSet &Params, bool Parallel);
+
+	static void SignInternal(std::vector<byte> &Signature, const std::vector<byte> &Message, const std::vector<byte> &PrivateKey, const std::vector<byte> &OptRand, const SPXParamSet &Params, bool Parallel);
+
+	static bool Verify(const std::vector<byte> &Signature, const std::vector<byte> &Message, size_t MsgOffset, size_t MsgLength, const std::vector<byte> &PublicKey, const SPXParamSet &Params);
+
+private:
+
+	//~~~Hypertree~~~//
+
+	static void ForsRoots(const SPXState &State, std::vector<byte> &Roots, const std::vector<byte> &Signature, size_t SigOffset, const std::vector<uint> &Indices, ulong Tree, uint KeyPair);
+
+	static void ForsSign(const SPXState &State, std::vector<byte> &Signature, size_t SigOffset, std::vector<byte> &Roots, const std::vector<uint> &Indices, ulong Tree, uint KeyPair, size_t First, size_t Count);
+
+	static void TreeHash(const SPXState &State, std::vector<byte> &Nodes, size_t Height, uint LeafIndex, uint IndexOffset, const SPXAddress &Base, std::vector<byte> &Auth, size_t AuthOffset, std::vector<byte> &Root, size_t RootOffset);
+
+	static void WotsChain(const SPXState &State, std::vector<byte> &Nodes, const std::vector<SPXAddress> &Address, const std::vector<uint> &Start, const std::vector<uint> &Steps);
+
+	static void WotsDigits(const SPXState &State, std::vector<uint> &Digits, const std::vector<byte> &Message, size_t MsgOffset);
+
+	static void WotsLeaves(const SPXState &State, std::vector<byte> &Leaves, size_t LeafOffset, uint Layer, ulong Tree, uint FirstLeaf, size_t Count);
+
+	static void WotsSign(const SPXState &State, std::vector<byte> &Signature, size_t SigOffset, const std::vector<byte> &Message, size_t MsgOffset, uint Layer, ulong Tree, uint KeyPair);
+
+	static void XmssRoot(const SPXState &State, std::vector<byte> &Root, const std::vector<byte> &Signature, size_t SigOffset, uint Layer, ulong Tree, uint KeyPair);
+
+	static void XmssTree(const SPXState &State, uint Layer, ulong Tree, uint LeafIndex, std::vector<byte> &Auth, size_t AuthOffset, std::vector<byte> &Root, size_t RootOffset);
+
+	//~~~Hashing~~~//
+
+	static void HashMessage(const SPXState &State, std::vector<byte> &Digest, const std::vector<byte> &R, const std::vector<byte> &PkRoot, const std::vector<byte> &Message);
+
+	static void LoadSeed(SPXState &State);
+
+	static void PrfMessage(const SPXState &State, std::vector<byte> &R, const std::vector<byte> &SkPrf, const std::vector<byte> &OptRand, const std::vector<byte> &Message);
+
+	static void PrfX(const SPXState &State, std::vector<byte> &Output, const std::vector<SPXAddress> &Address);
+
+	static void Sha256X(const SPXState &State, std::vector<byte> &Output, const std::vector<byte> &Input, size_t InLength, const std::vector<SPXAddress> &Address);
+
+	static void Sha512X(const SPXState &State, std::vector<byte> &Output, const std::vector<byte> &Input, size_t InLength, const std::vector<SPXAddress> &Address);
+
+	static void ShakeX(const SPXState &State, std::vector<byte> &Output, const std::vector<byte> &Input, size_t InLength, const std::vector<SPXAddress> &Address);
+
+	static void SplitDigest(const SPXState &State, const std::vector<byte> &Digest, std::vector<uint> &Indices, ulong &Tree, uint &Leaf);
+
+	static void ThashX(const SPXState &State, std::vector<byte> &Output, const std::vector<byte> &Input, size_t InLength, const std::vector<SPXAddress> &Address);
+
+	//~~~SHA2~~~//
+
+	template <typename T>
+	static void Compress(std::array<T, 8> &State, std::array<T, 16> &W);
+
+	static void CompressW(std::array<uint, 8 * SHA2_LANES> &State, std::array<uint, 16 * SHA2_LANES> &W);
+
+	static uint RotR(uint X, int Shift);
+
+#if defined(__AVX2__)
+	static UInt256 RotR(const UInt256 &X, int Shift);
+#endif
+
+	//~~~Address~~~//
+
+	static void SetChain(SPXAddress &Address, uint Chain);
+
+	static void SetHash(SPXAddress &Address, uint Hash);
+
+	static void SetKeyPair(SPXAddress &Address, uint KeyPair);
+
+	static void SetLayer(SPXAddress &Address, uint Layer);
+
+	static void SetTree(SPXAddress &Address, ulong Tree);
+
+	static void SetTreeHeight(SPXAddress &Address, uint Height);
+
+	static void SetTreeIndex(SPXAddress &Address, uint Index);
+
+	static void SetType(SPXAddress &Address, uint Type);
+
+	//~~~Helpers~~~//
+
+	static void BaseB(std::vector<uint> &Output, const std::vector<byte> &Input, size_t InOffset, size_t Bits, size_t Count);
+
+	static void ParallelRange(size_t Count, bool Parallel, const std::function<void(size_t, size_t)> &Function);
+};
+
+NAMESPACE_SPHINCSEND
+#endif
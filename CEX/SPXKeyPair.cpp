@@ -0,0 +1,53 @@
+#include "SPXKeyPair.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+//~~~Constructor~~~//
+
+SPXKeyPair::SPXKeyPair(SPXPrivateKey* PrivateKey, SPXPublicKey* PublicKey)
+	:
+	m_privateKey(PrivateKey),
+	m_publicKey(PublicKey),
+	m_Tag(0)
+{
+}
+
+SPXKeyPair::SPXKeyPair(SPXPrivateKey* PrivateKey, SPXPublicKey* PublicKey, std::vector<byte> &Tag)
+	:
+	m_privateKey(PrivateKey),
+	m_publicKey(PublicKey),
+	m_Tag(Tag)
+{
+}
+
+SPXKeyPair::~SPXKeyPair()
+{
+	Destroy();
+}
+
+//~~~Properties~~~//
+
+IAsymmetricKey* SPXKeyPair::PrivateKey()
+{
+	return m_privateKey;
+}
+
+IAsymmetricKey* SPXKeyPair::PublicKey()
+{
+	return m_publicKey;
+}
+
+const std::vector<byte> &SPXKeyPair::Tag()
+{
+	return m_Tag;
+}
+
+//~~~Private Functions~~~//
+
+void SPXKeyPair::Destroy()
+{
+	if (m_Tag.size() != 0)
+		m_Tag.clear();
+}
+
+NAMESPACE_ASYMMETRICKEYEND
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef CEX_SPXKEYPAIR_H
+#define CEX_SPXKEYPAIR_H
+
+#include "CexDomain.h"
+#include "IAsymmetricKeyPair.h"
+#include "SPXPrivateKey.h"
+#include "SPXPublicKey.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+/// <summary>
+/// A SPHINCS+ public and private key container
+/// </summary>
+class SPXKeyPair final : public IAsymmetricKeyPair
+{
+private:
+
+	SPXPrivateKey* m_privateKey;
+	SPXPublicKey* m_publicKey;
+	std::vector<byte> m_Tag;
+
+public:
+
+	SPXKeyPair(const SPXKeyPair&) = delete;
+	SPXKeyPair& operator=(const SPXKeyPair&) = delete;
+	SPXKeyPair& operator=(SPXKeyPair&&) = delete;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Instantiate this class with the public/private keys
+	/// </summary>
+	/// 
+	/// <param name="PrivateKey">The private key</param>
+	/// <param name="PublicKey">The public key</param>
+	explicit SPXKeyPair(SPXPrivateKey* PrivateKey, SPXPublicKey* PublicKey);
+
+	/// <summary>
+	/// Instantiate this class with the public/private keys and an identification tag
+	/// </summary>
+	/// 
+	/// <param name="PrivateKey">The private key</param>
+	/// <param name="PublicKey">The public key</param>
+	/// <param name="Tag">The identification tag</param>
+	explicit SPXKeyPair(SPXPrivateKey* PrivateKey, SPXPublicKey* PublicKey, std::vector<byte> &Tag);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~SPXKeyPair() override;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// The Private Key
+	/// </summary>
+	IAsymmetricKey* PrivateKey() override;
+
+	/// <summary>
+	/// The Public key
+	/// </summary>
+	IAsymmetricKey* PublicKey() override;
+
+	/// <summary>
+	/// An optional identification tag
+	/// </summary>
+	const std::vector<byte> &Tag() override;
+
+private:
+
+	void Destroy();
+};
+
+NAMESPACE_ASYMMETRICKEYEND
+#endif
+
@@ -0,0 +1,101 @@
+#include "SPXParamSet.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
+
+NAMESPACE_SPHINCS
+
+//~~~Constructor~~~//
+
+SPXParamSet::SPXParamSet()
+	:
+	ForsHeight(0),
+	ForsTrees(0),
+	Height(0),
+	Layers(0),
+	N(0),
+	ParamName(SPXParams::None),
+	PrivateKeySize(0),
+	PublicKeySize(0),
+	SignatureSize(0)
+{}
+
+SPXParamSet::SPXParamSet(uint HashSize, uint TreeHeight, uint TreeLayers, uint FHeight, uint FTrees, uint PubKeySize, uint PriKeySize, uint SigSize, SPXParams ParamSet)
+	:
+	ForsHeight(FHeight),
+	ForsTrees(FTrees),
+	Height(TreeHeight),
+	Layers(TreeLayers),
+	N(HashSize),
+	ParamName(ParamSet),
+	PrivateKeySize(PriKeySize),
+	PublicKeySize(PubKeySize),
+	SignatureSize(SigSize)
+{}
+
+SPXParamSet::SPXParamSet(const std::vector<byte> &ParamArray)
+{
+	IO::MemoryStream ms = IO::MemoryStream(ParamArray);
+	IO::StreamReader reader(ms);
+
+	ForsHeight = reader.ReadInt<uint>();
+	ForsTrees = reader.ReadInt<uint>();
+	Height = reader.ReadInt<uint>();
+	Layers = reader.ReadInt<uint>();
+	N = reader.ReadInt<uint>();
+	ParamName = (SPXParams)reader.ReadByte();
+	PrivateKeySize = reader.ReadInt<uint>();
+	PublicKeySize = reader.ReadInt<uint>();
+	SignatureSize = reader.ReadInt<uint>();
+}
+
+SPXParamSet::~SPXParamSet()
+{
+	Reset();
+}
+
+//~~~Public Functions~~~//
+
+void SPXParamSet::Load(uint HashSize, uint TreeHeight, uint TreeLayers, uint FHeight, uint FTrees, uint PubKeySize, uint PriKeySize, uint SigSize, SPXParams ParamSet)
+{
+	ForsHeight = FHeight;
+	ForsTrees = FTrees;
+	Height = TreeHeight;
+	Layers = TreeLayers;
+	N = HashSize;
+	ParamName = ParamSet;
+	PrivateKeySize = PriKeySize;
+	PublicKeySize = PubKeySize;
+	SignatureSize = SigSize;
+}
+
+void SPXParamSet::Reset()
+{
+	ForsHeight = 0;
+	ForsTrees = 0;
+	Height = 0;
+	Layers = 0;
+	N = 0;
+	ParamName = SPXParams::None;
+	PrivateKeySize = 0;
+	PublicKeySize = 0;
+	SignatureSize = 0;
+}
+
+std::vector<byte> SPXParamSet::ToBytes()
+{
+	IO::StreamWriter writer(33);
+
+	writer.Write<uint>(ForsHeight);
+	writer.Write<uint>(ForsTrees);
+	writer.Write<uint>(Height);
+	writer.Write<uint>(Layers);
+	writer.Write<uint>(N);
+	writer.Write<byte>((byte)ParamName);
+	writer.Write<uint>(PrivateKeySize);
+	writer.Write<uint>(PublicKeySize);
+	writer.Write<uint>(SignatureSize);
+
+	return writer.GetBytes();
+}
+
+NAMESPACE_SPHINCSEND
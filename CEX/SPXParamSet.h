@@ -0,0 +1,147 @@
+// The GPL version 3 License (GPLv3)
+// 
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+// 
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_SPXPARAMSET_H
+#define CEX_SPXPARAMSET_H
+
+#include "CexDomain.h"
+#include "SPXParams.h"
+
+NAMESPACE_SPHINCS
+
+using Enumeration::SPXParams;
+
+struct SPXParamSet
+{
+	SPXParamSet(const SPXParamSet&) = delete;
+	SPXParamSet& operator=(const SPXParamSet&) = delete;
+	SPXParamSet& operator=(SPXParamSet&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// The height of each FORS tree
+	/// </summary>
+	uint ForsHeight;
+
+	/// <summary>
+	/// The number of FORS trees
+	/// </summary>
+	uint ForsTrees;
+
+	/// <summary>
+	/// The total height of the hypertree
+	/// </summary>
+	uint Height;
+
+	/// <summary>
+	/// The number of XMSS layers in the hypertree
+	/// </summary>
+	uint Layers;
+
+	/// <summary>
+	/// The byte size of the hash outputs, and of each secret and public seed
+	/// </summary>
+	uint N;
+
+	/// <summary>
+	/// The parameter sets enumeration name
+	/// </summary>
+	SPXParams ParamName;
+
+	/// <summary>
+	/// The private keys byte size
+	/// </summary>
+	uint PrivateKeySize;
+
+	/// <summary>
+	/// The public keys byte size
+	/// </summary>
+	uint PublicKeySize;
+
+	/// <summary>
+	/// The signatures byte size
+	/// </summary>
+	uint SignatureSize;
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// An empty SPHINCS+ parameter structure
+	/// </summary>
+	SPXParamSet();
+
+	/// <summary>
+	/// Initialize the SPHINCS+ parameter structure
+	/// </summary>
+	///
+	/// <param name="HashSize">The byte size of the hash outputs</param>
+	/// <param name="TreeHeight">The total height of the hypertree</param>
+	/// <param name="TreeLayers">The number of XMSS layers in the hypertree</param>
+	/// <param name="FHeight">The height of each FORS tree</param>
+	/// <param name="FTrees">The number of FORS trees</param>
+	/// <param name="PubKeySize">The public keys byte size</param>
+	/// <param name="PriKeySize">The private keys byte size</param>
+	/// <param name="SigSize">The signatures byte size</param>
+	/// <param name="ParamSet">The parameter sets enumeration name</param>
+	SPXParamSet(uint HashSize, uint TreeHeight, uint TreeLayers, uint FHeight, uint FTrees, uint PubKeySize, uint PriKeySize, uint SigSize, SPXParams ParamSet);
+
+	/// <summary>
+	/// Initialize the SPHINCS+ parameter structure using a byte array
+	/// </summary>
+	/// 
+	/// <param name="ParamArray">The byte array containing the SPXParamSet</param>
+	explicit SPXParamSet(const std::vector<byte> &ParamArray);
+
+	/// <summary>
+	/// Finalize state
+	/// </summary>
+	~SPXParamSet();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Load the parameter values
+	/// </summary>
+	///
+	/// <param name="HashSize">The byte size of the hash outputs</param>
+	/// <param name="TreeHeight">The total height of the hypertree</param>
+	/// <param name="TreeLayers">The number of XMSS layers in the hypertree</param>
+	/// <param name="FHeight">The height of each FORS tree</param>
+	/// <param name="FTrees">The number of FORS trees</param>
+	/// <param name="PubKeySize">The public keys byte size</param>
+	/// <param name="PriKeySize">The private keys byte size</param>
+	/// <param name="SigSize">The signatures byte size</param>
+	/// <param name="ParamSet">The parameter sets enumeration name</param>
+	void Load(uint HashSize, uint TreeHeight, uint TreeLayers, uint FHeight, uint FTrees, uint PubKeySize, uint PriKeySize, uint SigSize, SPXParams ParamSet);
+
+	/// <summary>
+	/// Reset current parameters
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// Convert the SPXParamSet structure to a byte array
+	/// </summary>
+	/// 
+	/// <returns>The byte array containing the SPXParamSet</returns>
+	std::vector<byte> ToBytes();
+};
+
+NAMESPACE_SPHINCSEND
+#endif
@@ -0,0 +1,69 @@
+#ifndef CEX_SPXPARAMS_H
+#define CEX_SPXPARAMS_H
+
+#include "CexDomain.h"
+
+NAMESPACE_ENUMERATION
+
+/// <summary>
+/// The SPHINCS+ parameter sets enumeration.
+/// <para>The twelve FIPS 205 (SLH-DSA) parameter sets; the SHA2 192 and 256 bit sets use SHA2-256 for the chain and PRF functions, and SHA2-512 for the tree and message hashes.</para>
+/// </summary>
+enum class SPXParams : byte
+{
+	/// <summary>
+	/// No parameter set is specified
+	/// </summary>
+	None = 0,
+	/// <summary>
+	/// The SHA2-128f fast signing set; SHA2-256 with a 16 byte hash output, 22 layers of height 3, 33 FORS trees of height 6
+	/// </summary>
+	SHA2F128 = 1,
+	/// <summary>
+	/// The SHAKE-128f fast signing set; SHAKE256 with a 16 byte hash output, 22 layers of height 3, 33 FORS trees of height 6
+	/// </summary>
+	SHAKEF128 = 2,
+	/// <summary>
+	/// The SHAKE-192f fast signing set; SHAKE256 with a 24 byte hash output, 22 layers of height 3, 33 FORS trees of height 8
+	/// </summary>
+	SHAKEF192 = 3,
+	/// <summary>
+	/// The SHAKE-256f fast signing set; SHAKE256 with a 32 byte hash output, 17 layers of height 4, 35 FORS trees of height 9
+	/// </summary>
+	SHAKEF256 = 4,
+	/// <summary>
+	/// The SHA2-128s small signature set; SHA2-256 with a 16 byte hash output, 7 layers of height 9, 14 FORS trees of height 12
+	/// </summary>
+	SHA2S128 = 5,
+	/// <summary>
+	/// The SHA2-192f fast signing set; SHA2-256 and SHA2-512 with a 24 byte hash output, 22 layers of height 3, 33 FORS trees of height 8
+	/// </summary>
+	SHA2F192 = 6,
+	/// <summary>
+	/// The SHA2-192s small signature set; SHA2-256 and SHA2-512 with a 24 byte hash output, 7 layers of height 9, 17 FORS trees of height 14
+	/// </summary>
+	SHA2S192 = 7,
+	/// <summary>
+	/// The SHA2-256f fast signing set; SHA2-256 and SHA2-512 with a 32 byte hash output, 17 layers of height 4, 35 FORS trees of height 9
+	/// </summary>
+	SHA2F256 = 8,
+	/// <summary>
+	/// The SHA2-256s small signature set; SHA2-256 and SHA2-512 with a 32 byte hash output, 8 layers of height 8, 22 FORS trees of height 14
+	/// </summary>
+	SHA2S256 = 9,
+	/// <summary>
+	/// The SHAKE-128s small signature set; SHAKE256 with a 16 byte hash output, 7 layers of height 9, 14 FORS trees of height 12
+	/// </summary>
+	SHAKES128 = 10,
+	/// <summary>
+	/// The SHAKE-192s small signature set; SHAKE256 with a 24 byte hash output, 7 layers of height 9, 17 FORS trees of height 14
+	/// </summary>
+	SHAKES192 = 11,
+	/// <summary>
+	/// The SHAKE-256s small signature set; SHAKE256 with a 32 byte hash output, 8 layers of height 8, 22 FORS trees of height 14
+	/// </summary>
+	SHAKES256 = 12
+};
+
+NAMESPACE_ENUMERATIONEND
+#endif
@@ -0,0 +1,92 @@
+#include "SPXPrivateKey.h"
+#include "CryptoAsymmetricException.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+using Exception::CryptoAsymmetricException;
+
+//~~~Properties~~~//
+
+const AsymmetricEngines SPXPrivateKey::CipherType()
+{
+	return Enumeration::AsymmetricEngines::SphincsPlus;
+}
+
+const SPXParams SPXPrivateKey::Parameters()
+{
+	return m_spxParameters;
+}
+
+const std::vector<byte> &SPXPrivateKey::S()
+{
+	return m_sKey;
+}
+
+//~~~Constructor~~~//
+
+SPXPrivateKey::SPXPrivateKey(SPXParams Parameters, const std::vector<byte> &S)
+	:
+	m_isDestroyed(false),
+	m_sKey(S),
+	m_spxParameters(Parameters)
+{
+}
+
+SPXPrivateKey::SPXPrivateKey(const std::vector<byte> &KeyStream)
+	:
+	m_isDestroyed(false),
+	m_sKey(0),
+	m_spxParameters(SPXParams::None)
+{
+	if (KeyStream.size() < HDR_SIZE)
+	{
+		throw CryptoAsymmetricException("SPXPrivateKey:CTor", "The key stream is too small!");
+	}
+
+	m_spxParameters = static_cast<SPXParams>(KeyStream[0]);
+	uint sLen = Utility::IntUtils::LeBytesTo32(KeyStream, 1);
+
+	if (KeyStream.size() - HDR_SIZE < sLen)
+	{
+		throw CryptoAsymmetricException("SPXPrivateKey:CTor", "The key stream is truncated!");
+	}
+
+	m_sKey.resize(sLen);
+	Utility::MemUtils::Copy(KeyStream, HDR_SIZE, m_sKey, 0, sLen);
+}
+
+SPXPrivateKey::~SPXPrivateKey()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void SPXPrivateKey::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_spxParameters = SPXParams::None;
+
+		if (m_sKey.size() > 0)
+		{
+			Utility::IntUtils::ClearVector(m_sKey);
+		}
+	}
+}
+
+std::vector<byte> SPXPrivateKey::ToBytes()
+{
+	uint sLen = static_cast<uint>(m_sKey.size());
+	std::vector<byte> s(sLen + HDR_SIZE);
+	s[0] = static_cast<byte>(m_spxParameters);
+	Utility::IntUtils::Le32ToBytes(sLen, s, 1);
+	Utility::MemUtils::Copy(m_sKey, 0, s, HDR_SIZE, sLen);
+
+	return s;
+}
+
+NAMESPACE_ASYMMETRICKEYEND
@@ -0,0 +1,105 @@
+// The GPL version 3 License (GPLv3)
+// 
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+// 
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_SPXPRIVATEKEY_H
+#define CEX_SPXPRIVATEKEY_H
+
+#include "CexDomain.h"
+#include "IAsymmetricKey.h"
+#include "SPXParams.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+using Enumeration::SPXParams;
+
+/// <summary>
+/// A SPHINCS+ Private Key container
+/// </summary>
+class SPXPrivateKey final : public IAsymmetricKey
+{
+private:
+
+	static const size_t HDR_SIZE = 5;
+
+	bool m_isDestroyed;
+	std::vector<byte> m_sKey;
+	SPXParams m_spxParameters;
+
+public:
+
+	SPXPrivateKey() = delete;
+	SPXPrivateKey(const SPXPrivateKey&) = delete;
+	SPXPrivateKey& operator=(const SPXPrivateKey&) = delete;
+	SPXPrivateKey& operator=(SPXPrivateKey&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The private keys cipher type name
+	/// </summary>
+	const AsymmetricEngines CipherType() override;
+
+	/// <summary>
+	/// Get: The signature scheme parameters enumeration name
+	/// </summary>
+	const SPXParams Parameters();
+
+	/// <summary>
+	/// Get: The private key; the secret seed, the message prf key, the public seed, and the hypertree root
+	/// </summary>
+	const std::vector<byte> &S();
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Initialize this class with parameters
+	/// </summary>
+	/// 
+	/// <param name="Parameters">The signature scheme parameter enumeration name</param>
+	/// <param name="S">The secret seed, message prf key, public seed, and hypertree root</param>
+	explicit SPXPrivateKey(SPXParams Parameters, const std::vector<byte> &S);
+
+	/// <summary>
+	/// Initialize this class with a serialized private key
+	/// </summary>
+	/// 
+	/// <param name="KeyStream">The serialized private key</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the serialized key is truncated</exception>
+	explicit SPXPrivateKey(const std::vector<byte> &KeyStream);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~SPXPrivateKey() override;
+
+	//~~~Public Methods~~~//
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Serialize a private key to a byte array
+	/// </summary>
+	std::vector<byte> ToBytes() override;
+};
+
+NAMESPACE_ASYMMETRICKEYEND
+#endif
@@ -0,0 +1,92 @@
+#include "SPXPublicKey.h"
+#include "CryptoAsymmetricException.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+using Exception::CryptoAsymmetricException;
+
+//~~~Properties~~~//
+
+const AsymmetricEngines SPXPublicKey::CipherType()
+{
+	return Enumeration::AsymmetricEngines::SphincsPlus;
+}
+
+const SPXParams SPXPublicKey::Parameters()
+{
+	return m_spxParameters;
+}
+
+const std::vector<byte> &SPXPublicKey::P()
+{
+	return m_pKey;
+}
+
+//~~~Constructor~~~//
+
+SPXPublicKey::SPXPublicKey(SPXParams Parameters, const std::vector<byte> &P)
+	:
+	m_isDestroyed(false),
+	m_pKey(P),
+	m_spxParameters(Parameters)
+{
+}
+
+SPXPublicKey::SPXPublicKey(const std::vector<byte> &KeyStream)
+	:
+	m_isDestroyed(false),
+	m_pKey(0),
+	m_spxParameters(SPXParams::None)
+{
+	if (KeyStream.size() < HDR_SIZE)
+	{
+		throw CryptoAsymmetricException("SPXPublicKey:CTor", "The key stream is too small!");
+	}
+
+	m_spxParameters = static_cast<SPXParams>(KeyStream[0]);
+	uint pLen = Utility::IntUtils::LeBytesTo32(KeyStream, 1);
+
+	if (KeyStream.size() - HDR_SIZE < pLen)
+	{
+		throw CryptoAsymmetricException("SPXPublicKey:CTor", "The key stream is truncated!");
+	}
+
+	m_pKey.resize(pLen);
+	Utility::MemUtils::Copy(KeyStream, HDR_SIZE, m_pKey, 0, pLen);
+}
+
+SPXPublicKey::~SPXPublicKey()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void SPXPublicKey::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_spxParameters = SPXParams::None;
+
+		if (m_pKey.size() > 0)
+		{
+			Utility::IntUtils::ClearVector(m_pKey);
+		}
+	}
+}
+
+std::vector<byte> SPXPublicKey::ToBytes()
+{
+	uint pLen = static_cast<uint>(m_pKey.size());
+	std::vector<byte> p(pLen + HDR_SIZE);
+	p[0] = static_cast<byte>(m_spxParameters);
+	Utility::IntUtils::Le32ToBytes(pLen, p, 1);
+	Utility::MemUtils::Copy(m_pKey, 0, p, HDR_SIZE, pLen);
+
+	return p;
+}
+
+NAMESPACE_ASYMMETRICKEYEND
@@ -0,0 +1,105 @@
+// The GPL version 3 License (GPLv3)
+// 
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+// 
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_SPXPUBLICKEY_H
+#define CEX_SPXPUBLICKEY_H
+
+#include "CexDomain.h"
+#include "IAsymmetricKey.h"
+#include "SPXParams.h"
+
+NAMESPACE_ASYMMETRICKEY
+
+using Enumeration::SPXParams;
+
+/// <summary>
+/// A SPHINCS+ Public Key container
+/// </summary>
+class SPXPublicKey final : public IAsymmetricKey
+{
+private:
+
+	static const size_t HDR_SIZE = 5;
+
+	bool m_isDestroyed;
+	std::vector<byte> m_pKey;
+	SPXParams m_spxParameters;
+
+public:
+
+	SPXPublicKey() = delete;
+	SPXPublicKey(const SPXPublicKey&) = delete;
+	SPXPublicKey& operator=(const SPXPublicKey&) = delete;
+	SPXPublicKey& operator=(SPXPublicKey&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The public keys cipher type name
+	/// </summary>
+	const AsymmetricEngines CipherType() override;
+
+	/// <summary>
+	/// Get: The signature scheme parameters enumeration name
+	/// </summary>
+	const SPXParams Parameters();
+
+	/// <summary>
+	/// Get: The public key; the public seed followed by the hypertree root
+	/// </summary>
+	const std::vector<byte> &P();
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Initialize this class with parameters
+	/// </summary>
+	/// 
+	/// <param name="Parameters">The signature scheme parameter enumeration name</param>
+	/// <param name="P">The public seed followed by the hypertree root</param>
+	explicit SPXPublicKey(SPXParams Parameters, const std::vector<byte> &P);
+
+	/// <summary>
+	/// Initialize this class with a serialized public key
+	/// </summary>
+	/// 
+	/// <param name="KeyStream">The serialized public key</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the serialized key is truncated</exception>
+	explicit SPXPublicKey(const std::vector<byte> &KeyStream);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~SPXPublicKey() override;
+
+	//~~~Public Methods~~~//
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Serialize a public key to a byte array
+	/// </summary>
+	std::vector<byte> ToBytes() override;
+};
+
+NAMESPACE_ASYMMETRICKEYEND
+#endif
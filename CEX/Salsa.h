@@ -21,6 +21,7 @@
 
 #include "CexDomain.h"
 #include "IntUtils.h"
+#include "SecureAllocator.h"
 
 NAMESPACE_STREAM
 
@@ -33,7 +34,7 @@ private:
 
 public:
 
-	static void SalsaTransform512(std::vector<byte> &Output, size_t OutOffset, std::vector<uint> &Counter, std::vector<uint> &State, size_t Rounds)
+	static void SalsaTransform512(std::vector<byte> &Output, size_t OutOffset, std::vector<uint> &Counter, Utility::SecureVector<uint> &State, size_t Rounds)
 	{
 		size_t ctr = 0;
 		uint X0 = State[ctr];
@@ -110,7 +111,7 @@ public:
 	}
 
 	template<class T>
-	static void SalsaTransformW(std::vector<byte> &Output, size_t OutOffset, std::vector<uint> &Counter, std::vector<uint> &State, size_t Rounds)
+	static void SalsaTransformW(std::vector<byte> &Output, size_t OutOffset, std::vector<uint> &Counter, Utility::SecureVector<uint> &State, size_t Rounds)
 	{
 #if defined(__AVX__)
 
@@ -79,8 +79,11 @@ Salsa20::Salsa20(size_t Rounds)
 	m_isDestroyed(false),
 	m_isInitialized(false),
 	m_legalKeySizes(0),
+	m_otpBlock(BLOCK_SIZE),
 	m_parallelProfile(BLOCK_SIZE, true, STATE_PRECACHED, true),
 	m_rndCount(Rounds),
+	m_thdBuffer(0),
+	m_thdCounter(0),
 	m_wrkState(14, 0)
 {
 	if (Rounds == 0 || (Rounds & 1) != 0)
@@ -111,38 +114,43 @@ void Salsa20::Destroy()
 		IntUtils::ClearVector(m_dstCode);
 		IntUtils::ClearVector(m_legalKeySizes);
 		IntUtils::ClearVector(m_legalRounds);
+		IntUtils::ClearVector(m_otpBlock);
+		IntUtils::ClearVector(m_thdBuffer);
+		IntUtils::ClearVector(m_thdCounter);
 	}
 }
 
 void Salsa20::Initialize(ISymmetricKey &KeyParams)
 {
+	SymmetricKeyView keyView(KeyParams);
+
 	// recheck params
 	Scope();
 
-	if (KeyParams.Nonce().size() != 8)
+	if (keyView.Nonce().size() != 8)
 		throw CryptoSymmetricCipherException("Salsa20:Initialize", "Requires exactly 8 bytes of Nonce!");
-	if (KeyParams.Key().size() != 16 && KeyParams.Key().size() != 32)
+	if (keyView.Key().size() != 16 && keyView.Key().size() != 32)
 		throw CryptoSymmetricCipherException("Salsa20:Initialize", "Key must be 16 or 32 bytes!");
 	if (IsParallel() && m_parallelProfile.ParallelBlockSize() < m_parallelProfile.ParallelMinimumSize() || m_parallelProfile.ParallelBlockSize() > m_parallelProfile.ParallelMaximumSize())
 		throw CryptoSymmetricCipherException("Salsa20:Initialize", "The parallel block size is out of bounds!");
 	if (IsParallel() && m_parallelProfile.ParallelBlockSize() % m_parallelProfile.ParallelMinimumSize() != 0)
 		throw CryptoSymmetricCipherException("Salsa20:Initialize", "The parallel block size must be evenly aligned to the ParallelMinimumSize!");
 
-	if (KeyParams.Info().size() != 0)
+	if (keyView.Info().size() != 0)
 	{
 		// custom code
-		Utility::MemUtils::Copy(KeyParams.Info(), 0, m_dstCode, 0, (KeyParams.Info().size() > m_dstCode.size()) ? m_dstCode.size() : KeyParams.Info().size());
+		Utility::MemUtils::Copy(keyView.Info(), 0, m_dstCode, 0, (keyView.Info().size() > m_dstCode.size()) ? m_dstCode.size() : keyView.Info().size());
 	}
 	else
 	{
-		if (KeyParams.Key().size() == 32)
+		if (keyView.Key().size() == 32)
 			m_dstCode.assign(SIGMA_INFO.begin(), SIGMA_INFO.end());
 		else
 			m_dstCode.assign(TAU_INFO.begin(), TAU_INFO.end());
 	}
 
 	Reset();
-	Expand(KeyParams.Key(), KeyParams.Nonce());
+	Expand(keyView.Key(), keyView.Nonce());
 	m_isInitialized = true;
 }
 
@@ -156,6 +164,7 @@ void Salsa20::ParallelMaxDegree(size_t Degree)
 		throw CryptoSymmetricCipherException("Salsa20::ParallelMaxDegree", "Parallel degree can not exceed processor count!");
 
 	m_parallelProfile.SetMaxDegree(Degree);
+	Reserve();
 }
 
 void Salsa20::Reset()
@@ -219,7 +228,7 @@ void Salsa20::Expand(const std::vector<byte> &Key, const std::vector<byte> &Iv)
 	}
 }
 
-void Salsa20::Generate(std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Counter, const size_t Length)
+void Salsa20::Generate(std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Counter, const size_t Length, std::vector<uint> &Buffer)
 {
 	size_t ctr = 0;
 
@@ -229,36 +238,35 @@ void Salsa20::Generate(std::vector<byte> &Output, const size_t OutOffset, std::v
 	if (Length >= AVX2BLK)
 	{
 		size_t paln = Length - (Length % AVX2BLK);
-		std::vector<uint> ctrBlk(16);
 
 		// process 8 blocks (uses avx if available)
 		while (ctr != paln)
 		{
-			Utility::MemUtils::Copy(Counter, 0, ctrBlk, 0, 4);
-			Utility::MemUtils::Copy(Counter, 1, ctrBlk, 8, 4);
+			Utility::MemUtils::Copy(Counter, 0, Buffer, 0, 4);
+			Utility::MemUtils::Copy(Counter, 1, Buffer, 8, 4);
 			IntUtils::LeIncrementW(Counter);
-			Utility::MemUtils::Copy(Counter, 0, ctrBlk, 1, 4);
-			Utility::MemUtils::Copy(Counter, 1, ctrBlk, 9, 4);
+			Utility::MemUtils::Copy(Counter, 0, Buffer, 1, 4);
+			Utility::MemUtils::Copy(Counter, 1, Buffer, 9, 4);
 			IntUtils::LeIncrementW(Counter);
-			Utility::MemUtils::Copy(Counter, 0, ctrBlk, 2, 4);
-			Utility::MemUtils::Copy(Counter, 1, ctrBlk, 10, 4);
+			Utility::MemUtils::Copy(Counter, 0, Buffer, 2, 4);
+			Utility::MemUtils::Copy(Counter, 1, Buffer, 10, 4);
 			IntUtils::LeIncrementW(Counter);
-			Utility::MemUtils::Copy(Counter, 0, ctrBlk, 3, 4);
-			Utility::MemUtils::Copy(Counter, 1, ctrBlk, 11, 4);
+			Utility::MemUtils::Copy(Counter, 0, Buffer, 3, 4);
+			Utility::MemUtils::Copy(Counter, 1, Buffer, 11, 4);
 			IntUtils::LeIncrementW(Counter);
-			Utility::MemUtils::Copy(Counter, 0, ctrBlk, 4, 4);
-			Utility::MemUtils::Copy(Counter, 1, ctrBlk, 12, 4);
+			Utility::MemUtils::Copy(Counter, 0, Buffer, 4, 4);
+			Utility::MemUtils::Copy(Counter, 1, Buffer, 12, 4);
 			IntUtils::LeIncrementW(Counter);
-			Utility::MemUtils::Copy(Counter, 0, ctrBlk, 5, 4);
-			Utility::MemUtils::Copy(Counter, 1, ctrBlk, 13, 4);
+			Utility::MemUtils::Copy(Counter, 0, Buffer, 5, 4);
+			Utility::MemUtils::Copy(Counter, 1, Buffer, 13, 4);
 			IntUtils::LeIncrementW(Counter);
-			Utility::MemUtils::Copy(Counter, 0, ctrBlk, 6, 4);
-			Utility::MemUtils::Copy(Counter, 1, ctrBlk, 14, 4);
+			Utility::MemUtils::Copy(Counter, 0, Buffer, 6, 4);
+			Utility::MemUtils::Copy(Counter, 1, Buffer, 14, 4);
 			IntUtils::LeIncrementW(Counter);
-			Utility::MemUtils::Copy(Counter, 0, ctrBlk, 7, 4);
-			Utility::MemUtils::Copy(Counter, 1, ctrBlk, 15, 4);
+			Utility::MemUtils::Copy(Counter, 0, Buffer, 7, 4);
+			Utility::MemUtils::Copy(Counter, 1, Buffer, 15, 4);
 			IntUtils::LeIncrementW(Counter);
-			Salsa::SalsaTransformW<Numeric::UInt256>(Output, OutOffset + ctr, ctrBlk, m_wrkState, m_rndCount);
+			Salsa::SalsaTransformW<Numeric::UInt256>(Output, OutOffset + ctr, Buffer, m_wrkState, m_rndCount);
 			ctr += AVX2BLK;
 		}
 	}
@@ -268,24 +276,23 @@ void Salsa20::Generate(std::vector<byte> &Output, const size_t OutOffset, std::v
 	if (Length >= AVXBLK)
 	{
 		size_t paln = Length - (Length % AVXBLK);
-		std::vector<uint> ctrBlk(8);
 
 		// process 4 blocks (uses sse intrinsics if available)
 		while (ctr != paln)
 		{
-			Utility::MemUtils::Copy(Counter, 0, ctrBlk, 0, 4);
-			Utility::MemUtils::Copy(Counter, 1, ctrBlk, 4, 4);
+			Utility::MemUtils::Copy(Counter, 0, Buffer, 0, 4);
+			Utility::MemUtils::Copy(Counter, 1, Buffer, 4, 4);
 			IntUtils::LeIncrementW(Counter);
-			Utility::MemUtils::Copy(Counter, 0, ctrBlk, 1, 4);
-			Utility::MemUtils::Copy(Counter, 1, ctrBlk, 5, 4);
+			Utility::MemUtils::Copy(Counter, 0, Buffer, 1, 4);
+			Utility::MemUtils::Copy(Counter, 1, Buffer, 5, 4);
 			IntUtils::LeIncrementW(Counter);
-			Utility::MemUtils::Copy(Counter, 0, ctrBlk, 2, 4);
-			Utility::MemUtils::Copy(Counter, 1, ctrBlk, 6, 4);
+			Utility::MemUtils::Copy(Counter, 0, Buffer, 2, 4);
+			Utility::MemUtils::Copy(Counter, 1, Buffer, 6, 4);
 			IntUtils::LeIncrementW(Counter);
-			Utility::MemUtils::Copy(Counter, 0, ctrBlk, 3, 4);
-			Utility::MemUtils::Copy(Counter, 1, ctrBlk, 7, 4);
+			Utility::MemUtils::Copy(Counter, 0, Buffer, 3, 4);
+			Utility::MemUtils::Copy(Counter, 1, Buffer, 7, 4);
 			IntUtils::LeIncrementW(Counter);
-			Salsa::SalsaTransformW<Numeric::UInt128>(Output, OutOffset + ctr, ctrBlk, m_wrkState, m_rndCount);
+			Salsa::SalsaTransformW<Numeric::UInt128>(Output, OutOffset + ctr, Buffer, m_wrkState, m_rndCount);
 			ctr += AVXBLK;
 		}
 	}
@@ -301,10 +308,10 @@ void Salsa20::Generate(std::vector<byte> &Output, const size_t OutOffset, std::v
 
 	if (ctr != Length)
 	{
-		std::vector<byte> outputBlock(BLOCK_SIZE, 0);
-		Salsa::SalsaTransform512(outputBlock, 0, Counter, m_wrkState, m_rndCount);
+		// only the calling thread produces a partial block
+		Salsa::SalsaTransform512(m_otpBlock, 0, Counter, m_wrkState, m_rndCount);
 		const size_t FNLSZE = Length % BLOCK_SIZE;
-		Utility::MemUtils::Copy(outputBlock, 0, Output, OutOffset + (Length - FNLSZE), FNLSZE);
+		Utility::MemUtils::Copy(m_otpBlock, 0, Output, OutOffset + (Length - FNLSZE), FNLSZE);
 		IntUtils::LeIncrementW(Counter);
 	}
 }
@@ -316,7 +323,7 @@ void Salsa20::Process(const std::vector<byte> &Input, const size_t InOffset, std
 	if (!m_parallelProfile.IsParallel() || PRCSZE < m_parallelProfile.ParallelMinimumSize())
 	{
 		// generate random
-		Generate(Output, OutOffset, m_ctrVector, PRCSZE);
+		Generate(Output, OutOffset, m_ctrVector, PRCSZE, m_thdBuffer[0]);
 		// output is input xor random
 		const size_t ALNSZE = PRCSZE - (PRCSZE % BLOCK_SIZE);
 
@@ -336,31 +343,29 @@ void Salsa20::Process(const std::vector<byte> &Input, const size_t InOffset, std
 		const size_t CNKSZE = (PRCSZE / BLOCK_SIZE / m_parallelProfile.ParallelMaxDegree()) * BLOCK_SIZE;
 		const size_t RNDSZE = CNKSZE * m_parallelProfile.ParallelMaxDegree();
 		const size_t CTRLEN = (CNKSZE / BLOCK_SIZE);
-		std::vector<uint> tmpCtr(m_ctrVector.size());
 
-		Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, &tmpCtr, CNKSZE, CTRLEN](size_t i)
+		// the degree may have been changed through the parallel profile
+		if (m_thdCounter.size() < m_parallelProfile.ParallelMaxDegree())
+			Reserve();
+
+		Utility::ParallelUtils::ParallelFor(0, m_parallelProfile.ParallelMaxDegree(), [this, &Input, InOffset, &Output, OutOffset, CNKSZE, CTRLEN](size_t i)
 		{
-			// thread level counter
-			std::vector<uint> thdCtr(m_ctrVector.size());
-			// offset counter by chunk size / block size
-			IntUtils::LeIncreaseW(m_ctrVector, thdCtr, CTRLEN * i);
+			// offset the thread counter by chunk size / block size
+			IntUtils::LeIncreaseW(m_ctrVector, m_thdCounter[i], CTRLEN * i);
 			// create random at offset position
-			this->Generate(Output, OutOffset + (i * CNKSZE), thdCtr, CNKSZE);
+			this->Generate(Output, OutOffset + (i * CNKSZE), m_thdCounter[i], CNKSZE, m_thdBuffer[i]);
 			// xor with input at offset
 			Utility::MemUtils::XorBlock(Input, InOffset + (i * CNKSZE), Output, OutOffset + (i * CNKSZE), CNKSZE);
-			// store last counter
-			if (i == m_parallelProfile.ParallelMaxDegree() - 1)
-				Utility::MemUtils::Copy(thdCtr, 0, tmpCtr, 0, CTR_SIZE);
 		});
 
 		// copy last counter to class variable
-		Utility::MemUtils::Copy(tmpCtr, 0, m_ctrVector, 0, CTR_SIZE);
+		Utility::MemUtils::Copy(m_thdCounter[m_parallelProfile.ParallelMaxDegree() - 1], 0, m_ctrVector, 0, CTR_SIZE);
 
 		// last block processing
 		if (RNDSZE < PRCSZE)
 		{
 			const size_t FNLSZE = PRCSZE % RNDSZE;
-			Generate(Output, RNDSZE, m_ctrVector, FNLSZE);
+			Generate(Output, RNDSZE, m_ctrVector, FNLSZE, m_thdBuffer[0]);
 
 			for (size_t i = 0; i < FNLSZE; ++i)
 				Output[i + OutOffset + RNDSZE] ^= (byte)(Input[i + InOffset + RNDSZE]);
@@ -368,12 +373,23 @@ void Salsa20::Process(const std::vector<byte> &Input, const size_t InOffset, std
 	}
 }
 
+void Salsa20::Reserve()
+{
+	// one counter and staging buffer per thread; sized here so the transform never allocates
+	const size_t THDCNT = IntUtils::Max(m_parallelProfile.ParallelMaxDegree(), static_cast<size_t>(1));
+
+	m_thdBuffer.resize(THDCNT, std::vector<uint>(STAGE_SIZE));
+	m_thdCounter.resize(THDCNT, std::vector<uint>(m_ctrVector.size()));
+}
+
 void Salsa20::Scope()
 {
 	m_legalKeySizes.resize(2);
 	m_legalKeySizes[0] = SymmetricKeySize(16, 8, 0);
 	m_legalKeySizes[1] = SymmetricKeySize(32, 8, 0);
 	m_legalRounds = { 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30 };
+
+	Reserve();
 }
 
 NAMESPACE_STREAMEND
\ No newline at end of file
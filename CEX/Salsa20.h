@@ -32,6 +32,7 @@
 #define CEX_SALSA20_H
 
 #include "IStreamCipher.h"
+#include "SecureAllocator.h"
 
 NAMESPACE_STREAM
 
@@ -83,6 +84,7 @@ NAMESPACE_STREAM
 /// <item><description>The ParallelThreadsMax() property is used as the thread count in the parallel loop; this must be an even number no greater than the number of processer cores on the system.</description></item>
 /// <item><description>ParallelBlockSize() is calculated automatically based on processor(s) cache size but can be user defined, but must be evenly divisible by ParallelMinimumSize().</description></item>
 /// <item><description>The ParallelBlockSize() can be changed through the ParallelProfile() property</description></item>
+/// <item><description>The counter staging buffers are sized for each thread by the constructor and Initialize, the sequential transform does not allocate memory.</description></item>
 /// <item><description>Parallel block calculation ex. <c>ParallelBlockSize = N - (N % .ParallelMinimumSize);</c></description></item>
 /// </list>
 /// 
@@ -104,6 +106,14 @@ private:
 	static const size_t MAX_ROUNDS = 80;
 	static const size_t MIN_ROUNDS = 8;
 	static const size_t STATE_PRECACHED = 2048;
+	// the interleaved counter words; two for each block processed in parallel
+#if defined(__AVX2__)
+	static const size_t STAGE_SIZE = 16;
+#elif defined(__AVX__)
+	static const size_t STAGE_SIZE = 8;
+#else
+	static const size_t STAGE_SIZE = 2;
+#endif
 	static const std::string SIGMA_INFO;
 	static const std::string TAU_INFO;
 
@@ -113,9 +123,12 @@ private:
 	bool m_isInitialized;
 	std::vector<SymmetricKeySize> m_legalKeySizes;
 	std::vector<size_t> m_legalRounds;
+	std::vector<byte> m_otpBlock;
 	ParallelOptions m_parallelProfile;
 	size_t m_rndCount;
-	std::vector<uint> m_wrkState;
+	std::vector<std::vector<uint>> m_thdBuffer;
+	std::vector<std::vector<uint>> m_thdCounter;
+	Utility::SecureVector<uint> m_wrkState;
 
 public:
 
@@ -272,8 +285,9 @@ public:
 private:
 
 	void Expand(const std::vector<byte> &Key, const std::vector<byte> &Iv);
-	void Generate(std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Counter, const size_t Length);
+	void Generate(std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Counter, const size_t Length, std::vector<uint> &Buffer);
 	void Process(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, const size_t Length);
+	void Reserve();
 	void Reset();
 	void Scope();
 };
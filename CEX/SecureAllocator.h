@@ -0,0 +1,105 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_SECUREALLOCATOR_H
+#define CEX_SECUREALLOCATOR_H
+
+#include "CexDomain.h"
+#include "SecureArena.h"
+
+NAMESPACE_UTILITY
+
+/// <summary>
+/// A standard library allocator that stores its elements in the page locked <see cref="SecureArena"/>.
+/// <para>Memory is zeroed when it is released. Use the SecureVector alias to declare a vector that holds key material.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Declaring a round key array:</description>
+/// <code>
+/// SecureVector&lt;uint&gt; expKey(60);
+/// </code>
+/// </example>
+template <typename T>
+class SecureAllocator
+{
+public:
+
+	typedef T value_type;
+
+	/// <summary>
+	/// Initialize the allocator
+	/// </summary>
+	SecureAllocator() noexcept
+	{
+	}
+
+	/// <summary>
+	/// Initialize the allocator from an allocator of another element type
+	/// </summary>
+	template <typename U>
+	SecureAllocator(const SecureAllocator<U> &) noexcept
+	{
+	}
+
+	/// <summary>
+	/// Allocate an array of elements from the arena
+	/// </summary>
+	///
+	/// <param name="Count">The number of elements</param>
+	///
+	/// <returns>A pointer to the uninitialized array</returns>
+	T* allocate(size_t Count)
+	{
+		return static_cast<T*>(SecureArena::Instance().Allocate(Count * sizeof(T)));
+	}
+
+	/// <summary>
+	/// Zero an array of elements and return it to the arena
+	/// </summary>
+	///
+	/// <param name="Block">The pointer returned by allocate</param>
+	/// <param name="Count">The number of elements passed to allocate</param>
+	void deallocate(T* Block, size_t Count) noexcept
+	{
+		SecureArena::Instance().Deallocate(Block, Count * sizeof(T));
+	}
+};
+
+/*! \cond PRIVATE */
+template <typename T, typename U>
+inline bool operator==(const SecureAllocator<T> &, const SecureAllocator<U> &) noexcept
+{
+	return true;
+}
+
+template <typename T, typename U>
+inline bool operator!=(const SecureAllocator<T> &, const SecureAllocator<U> &) noexcept
+{
+	return false;
+}
+/*! \endcond */
+
+/// <summary>
+/// A vector that stores its elements in the page locked secure arena
+/// </summary>
+template <typename T>
+using SecureVector = std::vector<T, SecureAllocator<T>>;
+
+NAMESPACE_UTILITYEND
+#endif
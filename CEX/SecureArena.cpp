@@ -0,0 +1,278 @@
+#include "SecureArena.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(CEX_OS_WINDOWS)
+#	include <Windows.h>
+#elif defined(CEX_OS_LINUX) || defined(CEX_OS_UNIX) || defined(CEX_OS_POSIX) || defined(CEX_OS_ANDROID) || defined(CEX_OS_APPLE)
+#	include <sys/mman.h>
+#	include <unistd.h>
+#	define CEX_SECUREARENA_MMAP
+#endif
+
+NAMESPACE_UTILITY
+
+namespace
+{
+	/*! \cond PRIVATE */
+	CEX_OPTIMIZE_IGNORE
+	/*! \endcond */
+	void ClearBlock(void* Block, size_t Length)
+	{
+		std::memset(Block, 0, Length);
+	}
+	/*! \cond PRIVATE */
+	CEX_OPTIMIZE_RESUME
+	/*! \endcond */
+}
+
+//~~~Properties~~~//
+
+const size_t SecureArena::Capacity()
+{
+	return m_arenaSize;
+}
+
+const bool SecureArena::IsLocked()
+{
+	return m_isLocked;
+}
+
+const size_t SecureArena::Reserved()
+{
+	std::lock_guard<std::mutex> lock(m_mtxLock);
+
+	return m_arenaOffset;
+}
+
+//~~~Constructor~~~//
+
+SecureArena::SecureArena()
+	:
+	m_arenaBase(nullptr),
+	m_arenaOffset(0),
+	m_arenaSize(0),
+	m_freeList(CLASS_COUNT, nullptr),
+	m_isDestroyed(false),
+	m_isLocked(false),
+	m_mtxLock(),
+	m_pageSize(0),
+	m_regionBase(nullptr),
+	m_regionSize(0)
+{
+	Reserve();
+}
+
+//~~~Public Functions~~~//
+
+SecureArena &SecureArena::Instance()
+{
+	// the arena object is intentionally leaked, so that containers with static storage duration
+	// can still release their blocks to it while static objects are being destroyed;
+	// the region itself is wiped and released by the exit handler
+	static SecureArena* arena = new SecureArena();
+	static const int hook = std::atexit(Teardown);
+	static_cast<void>(hook);
+
+	return *arena;
+}
+
+void* SecureArena::Allocate(size_t Length)
+{
+	const size_t CLSIDX = ClassIndex(Length);
+
+	if (CLSIDX < CLASS_COUNT)
+	{
+		std::lock_guard<std::mutex> lock(m_mtxLock);
+
+		if (!m_isDestroyed && m_arenaBase != nullptr)
+		{
+			void* blk = m_freeList[CLSIDX];
+
+			if (blk != nullptr)
+			{
+				// pop the free list, and clear the link
+				std::memcpy(&m_freeList[CLSIDX], blk, sizeof(void*));
+				std::memset(blk, 0, sizeof(void*));
+
+				return blk;
+			}
+
+			const size_t CLSSZE = MIN_CLASS << CLSIDX;
+			// blocks are aligned to their size class
+			const size_t BLKOFF = (m_arenaOffset + (CLSSZE - 1)) & ~(CLSSZE - 1);
+
+			if (BLKOFF + CLSSZE <= m_arenaSize)
+			{
+				m_arenaOffset = BLKOFF + CLSSZE;
+
+				return m_arenaBase + BLKOFF;
+			}
+		}
+	}
+
+	// too large, or the arena is exhausted
+	return ::operator new(Length);
+}
+
+void SecureArena::Deallocate(void* Block, size_t Length)
+{
+	if (Block == nullptr)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mtxLock);
+
+		if (Contains(Block))
+		{
+			if (!m_isDestroyed)
+			{
+				const size_t CLSIDX = ClassIndex(Length);
+
+				ClearBlock(Block, MIN_CLASS << CLSIDX);
+				// push the block onto the free list for its size class
+				std::memcpy(Block, &m_freeList[CLSIDX], sizeof(void*));
+				m_freeList[CLSIDX] = Block;
+			}
+
+			// a destroyed region has already been zeroed and released
+			return;
+		}
+	}
+
+	ClearBlock(Block, Length);
+	::operator delete(Block);
+}
+
+//~~~Private Functions~~~//
+
+size_t SecureArena::ClassIndex(size_t Length)
+{
+	size_t clsIdx = 0;
+	size_t clsSze = MIN_CLASS;
+
+	while (clsSze < Length && clsIdx < CLASS_COUNT)
+	{
+		clsSze <<= 1;
+		++clsIdx;
+	}
+
+	return clsIdx;
+}
+
+bool SecureArena::Contains(const void* Block)
+{
+	const byte* PTR = static_cast<const byte*>(Block);
+
+	return (m_arenaBase != nullptr && PTR >= m_arenaBase && PTR < m_arenaBase + m_arenaSize);
+}
+
+void SecureArena::Destroy()
+{
+	std::lock_guard<std::mutex> lock(m_mtxLock);
+
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+
+		if (m_regionBase != nullptr)
+		{
+			// bulk zeroization of every block carved from the region
+			ClearBlock(m_arenaBase, m_arenaOffset);
+
+			// the pages are released, but the address range stays reserved, so that a late Deallocate of an
+			// arena block is still recognized by Contains and a heap block can never be placed inside the range
+#if defined(CEX_OS_WINDOWS)
+			if (m_isLocked)
+			{
+				VirtualUnlock(m_arenaBase, m_arenaSize);
+			}
+
+			VirtualFree(m_regionBase, m_regionSize, MEM_DECOMMIT);
+#elif defined(CEX_SECUREARENA_MMAP)
+			if (m_isLocked)
+			{
+				munlock(m_arenaBase, m_arenaSize);
+			}
+
+			if (mmap(m_regionBase, m_regionSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_NORESERVE, -1, 0) == MAP_FAILED)
+			{
+				// the range can not be reserved; leave it mapped but inaccessible
+				mprotect(m_regionBase, m_regionSize, PROT_NONE);
+			}
+#endif
+			// without page protection the heap block is kept for the life of the process
+		}
+
+		m_arenaOffset = 0;
+		m_isLocked = false;
+		m_freeList.assign(CLASS_COUNT, nullptr);
+	}
+}
+
+void SecureArena::Reserve()
+{
+#if defined(CEX_OS_WINDOWS)
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	m_pageSize = static_cast<size_t>(sysInfo.dwPageSize);
+#elif defined(CEX_SECUREARENA_MMAP)
+	const long PAGSZE = sysconf(_SC_PAGESIZE);
+	m_pageSize = PAGSZE > 0 ? static_cast<size_t>(PAGSZE) : 4096;
+#else
+	m_pageSize = MAX_CLASS;
+#endif
+
+	m_arenaSize = ((ARENA_SIZE + m_pageSize - 1) / m_pageSize) * m_pageSize;
+	// a guard page on either side of the arena
+	m_regionSize = m_arenaSize + (2 * m_pageSize);
+
+#if defined(CEX_OS_WINDOWS)
+	m_regionBase = static_cast<byte*>(VirtualAlloc(nullptr, m_regionSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+
+	if (m_regionBase != nullptr)
+	{
+		DWORD oldProt;
+		m_arenaBase = m_regionBase + m_pageSize;
+		VirtualProtect(m_regionBase, m_pageSize, PAGE_NOACCESS, &oldProt);
+		VirtualProtect(m_arenaBase + m_arenaSize, m_pageSize, PAGE_NOACCESS, &oldProt);
+		m_isLocked = (VirtualLock(m_arenaBase, m_arenaSize) != 0);
+	}
+#elif defined(CEX_SECUREARENA_MMAP)
+	void* region = mmap(nullptr, m_regionSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (region != MAP_FAILED)
+	{
+		m_regionBase = static_cast<byte*>(region);
+		m_arenaBase = m_regionBase + m_pageSize;
+		mprotect(m_regionBase, m_pageSize, PROT_NONE);
+		mprotect(m_arenaBase + m_arenaSize, m_pageSize, PROT_NONE);
+		m_isLocked = (mlock(m_arenaBase, m_arenaSize) == 0);
+#	if defined(MADV_DONTDUMP)
+		// keep the secrets out of core dumps
+		madvise(m_arenaBase, m_arenaSize, MADV_DONTDUMP);
+#	endif
+	}
+#else
+	// no page protection available; the arena is an ordinary heap block
+	m_regionBase = static_cast<byte*>(::operator new(m_regionSize, std::nothrow));
+	m_arenaBase = m_regionBase != nullptr ? m_regionBase + m_pageSize : nullptr;
+#endif
+
+	if (m_regionBase == nullptr)
+	{
+		// every request is served by the heap
+		m_arenaBase = nullptr;
+		m_arenaSize = 0;
+	}
+}
+
+void SecureArena::Teardown()
+{
+	Instance().Destroy();
+}
+
+NAMESPACE_UTILITYEND
@@ -0,0 +1,135 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// A page locked, guard paged memory arena used to store key material.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_SECUREARENA_H
+#define CEX_SECUREARENA_H
+
+#include "CexDomain.h"
+#include <mutex>
+
+NAMESPACE_UTILITY
+
+/// <summary>
+/// A page locked and guard paged memory arena for secret buffers
+/// </summary>
+///
+/// <remarks>
+/// <description>Overview:</description>
+/// <para>The arena reserves a single region of memory when first used, surrounded by two inaccessible guard pages, and locks the region into physical memory so that its contents are not written to the page file.
+/// Blocks are carved from the region in power of two size classes between 16 and 4096 bytes; a released block is zeroed and placed on the free list for its size class, and is reused by the next request of that class. \n
+/// The region is torn down by an exit handler registered on first use: every block carved from it is zeroed, the pages are unlocked, and the memory is released while the address range remains reserved. \n
+/// The arena object itself is never destroyed, so blocks released by static objects after the teardown are recognized and ignored, and later requests are served from the heap.</para>
+///
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The arena is a process wide instance, accessed through the Instance() function; it is normally used through the <see cref="SecureAllocator"/> class.</description></item>
+/// <item><description>Requests larger than the largest size class, or made after the region is exhausted, are served from the heap, and are zeroed before they are released.</description></item>
+/// <item><description>If the operating system refuses to lock the region (ex. the RLIMIT_MEMLOCK limit is too small), the arena continues to operate, and IsLocked() returns false.</description></item>
+/// <item><description>Blocks are aligned to their size class, so every block is at least 16 byte aligned.</description></item>
+/// <item><description>Allocate and Deallocate are thread safe.</description></item>
+/// </list>
+/// </remarks>
+class SecureArena
+{
+private:
+
+	static const size_t ARENA_SIZE = 256 * 1024;
+	static const size_t CLASS_COUNT = 9;
+	static const size_t MAX_CLASS = 4096;
+	static const size_t MIN_CLASS = 16;
+
+	byte* m_arenaBase;
+	size_t m_arenaOffset;
+	size_t m_arenaSize;
+	std::vector<void*> m_freeList;
+	bool m_isDestroyed;
+	bool m_isLocked;
+	std::mutex m_mtxLock;
+	size_t m_pageSize;
+	byte* m_regionBase;
+	size_t m_regionSize;
+
+public:
+
+	SecureArena(const SecureArena&) = delete;
+	SecureArena& operator=(const SecureArena&) = delete;
+	SecureArena& operator=(SecureArena&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The byte size of the page locked region
+	/// </summary>
+	const size_t Capacity();
+
+	/// <summary>
+	/// Get: The region is locked in physical memory
+	/// </summary>
+	const bool IsLocked();
+
+	/// <summary>
+	/// Get: The number of bytes carved from the region; includes blocks on the free lists
+	/// </summary>
+	const size_t Reserved();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Get the process wide arena instance
+	/// <para>The instance is created on first use; its region is zeroed and released at process exit.</para>
+	/// </summary>
+	///
+	/// <returns>A reference to the arena</returns>
+	static SecureArena &Instance();
+
+	/// <summary>
+	/// Allocate a block of memory
+	/// </summary>
+	///
+	/// <param name="Length">The number of bytes requested</param>
+	///
+	/// <returns>A pointer to a block of at least Length bytes</returns>
+	///
+	/// <exception cref="std::bad_alloc">Thrown if the heap can not satisfy a request that does not fit in the arena</exception>
+	void* Allocate(size_t Length);
+
+	/// <summary>
+	/// Zero a block of memory and release it
+	/// </summary>
+	///
+	/// <param name="Block">The pointer returned by Allocate</param>
+	/// <param name="Length">The number of bytes passed to Allocate</param>
+	void Deallocate(void* Block, size_t Length);
+
+private:
+
+	SecureArena();
+	static size_t ClassIndex(size_t Length);
+	bool Contains(const void* Block);
+	void Destroy();
+	void Reserve();
+	static void Teardown();
+};
+
+NAMESPACE_UTILITYEND
+#endif
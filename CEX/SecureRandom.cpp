@@ -4,6 +4,9 @@
 #include "MemUtils.h"
 #include "ProviderFromName.h"
 #include "PrngFromName.h"
+#if defined(__AVX2__)
+#	include <immintrin.h>
+#endif
 
 NAMESPACE_PRNG
 
@@ -17,7 +20,8 @@ SecureRandom::SecureRandom(Prngs EngineType, Providers ProviderType, Digests Dig
 	m_digestType(DigestType),
 	m_isDestroyed(false),
 	m_prngEngineType(EngineType),
-	m_providerType(ProviderType)
+	m_providerType(ProviderType),
+	m_smpBuffer(sizeof(ulong))
 {
 	Reset();
 }
@@ -41,6 +45,7 @@ void SecureRandom::Destroy()
 		m_providerType = Providers::None;
 
 		Utility::IntUtils::ClearVector(m_rndBuffer);
+		Utility::IntUtils::ClearVector(m_smpBuffer);
 
 		if (m_prngEngine != 0)
 			delete m_prngEngine;
@@ -49,32 +54,130 @@ void SecureRandom::Destroy()
 
 void SecureRandom::Fill(std::vector<ushort> &Output, size_t Offset, size_t Elements)
 {
-	CexAssert(Output.size() - Offset <= Elements, "the output array is too short");
+	CexAssert(Output.size() - Offset >= Elements, "the output array is too short");
 
-	size_t bufLen = Elements * sizeof(ushort);
-	std::vector<byte> buf(bufLen);
-	GetBytes(buf);
-	Utility::MemUtils::Copy(buf, 0, Output, Offset, bufLen);
+	Generate(Output, Offset, Elements);
 }
 
 void SecureRandom::Fill(std::vector<uint> &Output, size_t Offset, size_t Elements)
 {
-	CexAssert(Output.size() - Offset <= Elements, "the output array is too short");
+	CexAssert(Output.size() - Offset >= Elements, "the output array is too short");
 
-	size_t bufLen = Elements * sizeof(uint);
-	std::vector<byte> buf(bufLen);
-	GetBytes(buf);
-	Utility::MemUtils::Copy(buf, 0, Output, Offset, bufLen);
+	Generate(Output, Offset, Elements);
 }
 
 void SecureRandom::Fill(std::vector<ulong> &Output, size_t Offset, size_t Elements)
 {
-	CexAssert(Output.size() - Offset <= Elements, "the output array is too short");
+	CexAssert(Output.size() - Offset >= Elements, "the output array is too short");
 
-	size_t bufLen = Elements * sizeof(ulong);
-	std::vector<byte> buf(bufLen);
-	GetBytes(buf);
-	Utility::MemUtils::Copy(buf, 0, Output, Offset, bufLen);
+	Generate(Output, Offset, Elements);
+}
+
+void SecureRandom::Fill(std::vector<double> &Output, size_t Offset, size_t Elements)
+{
+	CexAssert(Output.size() - Offset >= Elements, "the output array is too short");
+
+	// 2^-53
+	const double DBLSCL = 1.0 / 9007199254740992.0;
+
+	while (Elements != 0)
+	{
+		Refill(sizeof(ulong));
+
+		const size_t CNT = Utility::IntUtils::Min((m_rndBuffer.size() - m_bufferIndex) / sizeof(ulong), Elements);
+
+		for (size_t i = 0; i < CNT; ++i)
+		{
+			// the high 53 bits of each word are scaled to [0, 1)
+			Output[Offset + i] = static_cast<double>(Utility::IntUtils::LeBytesTo64(m_rndBuffer, m_bufferIndex + (i * sizeof(ulong))) >> 11) * DBLSCL;
+		}
+
+		m_bufferIndex += CNT * sizeof(ulong);
+		Offset += CNT;
+		Elements -= CNT;
+	}
+}
+
+void SecureRandom::Fill(std::vector<ushort> &Output, size_t Offset, size_t Elements, ushort Maximum, ushort Minimum)
+{
+	CexAssert(Output.size() - Offset >= Elements, "the output array is too short");
+
+	if (Maximum <= Minimum)
+		throw CryptoRandomException("SecureRandom:Fill", "The maximum must be more than the minimum!");
+
+	GenerateRange(Output, Offset, Elements, static_cast<ulong>(Maximum - Minimum), Minimum);
+}
+
+void SecureRandom::Fill(std::vector<uint> &Output, size_t Offset, size_t Elements, uint Maximum, uint Minimum)
+{
+	CexAssert(Output.size() - Offset >= Elements, "the output array is too short");
+
+	if (Maximum <= Minimum)
+		throw CryptoRandomException("SecureRandom:Fill", "The maximum must be more than the minimum!");
+
+	GenerateRange(Output, Offset, Elements, static_cast<ulong>(Maximum - Minimum), Minimum);
+}
+
+void SecureRandom::Fill(std::vector<ulong> &Output, size_t Offset, size_t Elements, ulong Maximum, ulong Minimum)
+{
+	CexAssert(Output.size() - Offset >= Elements, "the output array is too short");
+
+	if (Maximum <= Minimum)
+		throw CryptoRandomException("SecureRandom:Fill", "The maximum must be more than the minimum!");
+
+	const ulong RNGLEN = Maximum - Minimum;
+
+	if (RNGLEN <= 0xFFFFFFFFULL)
+	{
+		GenerateRange(Output, Offset, Elements, RNGLEN, Minimum);
+	}
+	else
+	{
+		// the smallest all ones mask covering the range; at most half the samples are rejected
+		ulong mask = RNGLEN - 1;
+		mask |= mask >> 1;
+		mask |= mask >> 2;
+		mask |= mask >> 4;
+		mask |= mask >> 8;
+		mask |= mask >> 16;
+		mask |= mask >> 32;
+
+		while (Elements != 0)
+		{
+			Refill(sizeof(ulong));
+
+			const size_t CNT = (m_rndBuffer.size() - m_bufferIndex) / sizeof(ulong);
+
+			for (size_t i = 0; i < CNT && Elements != 0; ++i)
+			{
+				const ulong X = Utility::IntUtils::LeBytesTo64(m_rndBuffer, m_bufferIndex + (i * sizeof(ulong))) & mask;
+
+				if (X < RNGLEN)
+				{
+					Output[Offset] = Minimum + X;
+					++Offset;
+					--Elements;
+				}
+			}
+
+			m_bufferIndex += CNT * sizeof(ulong);
+		}
+	}
+}
+
+void SecureRandom::Permutation(std::vector<uint> &Output, size_t Offset, size_t Elements)
+{
+	CexAssert(Output.size() - Offset >= Elements, "the output array is too short");
+
+	if (Elements > 0xFFFFFFFFULL)
+		throw CryptoRandomException("SecureRandom:Permutation", "The permutation is too large!");
+
+	for (size_t i = 0; i < Elements; ++i)
+	{
+		Output[Offset + i] = static_cast<uint>(i);
+	}
+
+	Shuffle(Output, Offset, Elements);
 }
 
 std::vector<byte> SecureRandom::GetBytes(size_t Size)
@@ -86,17 +189,24 @@ std::vector<byte> SecureRandom::GetBytes(size_t Size)
 
 void SecureRandom::GetBytes(std::vector<byte> &Output)
 {
-	if (Output.size() == 0)
+	GetBytes(Output, 0, Output.size());
+}
+
+void SecureRandom::GetBytes(std::vector<byte> &Output, size_t Offset, size_t Length)
+{
+	if (Length == 0)
 		throw CryptoRandomException("SecureRandom:GetBytes", "Buffer size must be at least 1 byte!");
 
-	if (m_rndBuffer.size() - m_bufferIndex < Output.size())
+	CexAssert(Output.size() - Offset >= Length, "the output array is too short");
+
+	if (m_rndBuffer.size() - m_bufferIndex < Length)
 	{
 		size_t bufSize = m_rndBuffer.size() - m_bufferIndex;
 		// copy remaining bytes
 		if (bufSize != 0)
-			Utility::MemUtils::Copy(m_rndBuffer, m_bufferIndex, Output, 0, bufSize);
+			Utility::MemUtils::Copy(m_rndBuffer, m_bufferIndex, Output, Offset, bufSize);
 
-		size_t rmd = Output.size() - bufSize;
+		size_t rmd = Length - bufSize;
 
 		while (rmd > 0)
 		{
@@ -105,13 +215,13 @@ void SecureRandom::GetBytes(std::vector<byte> &Output)
 
 			if (rmd > m_rndBuffer.size())
 			{
-				Utility::MemUtils::Copy(m_rndBuffer, 0, Output, bufSize, m_rndBuffer.size());
+				Utility::MemUtils::Copy(m_rndBuffer, 0, Output, Offset + bufSize, m_rndBuffer.size());
 				bufSize += m_rndBuffer.size();
 				rmd -= m_rndBuffer.size();
 			}
 			else
 			{
-				Utility::MemUtils::Copy(m_rndBuffer, 0, Output, bufSize, rmd);
+				Utility::MemUtils::Copy(m_rndBuffer, 0, Output, Offset + bufSize, rmd);
 				m_bufferIndex = rmd;
 				rmd = 0;
 			}
@@ -119,30 +229,33 @@ void SecureRandom::GetBytes(std::vector<byte> &Output)
 	}
 	else
 	{
-		Utility::MemUtils::Copy(m_rndBuffer, m_bufferIndex, Output, 0, Output.size());
-		m_bufferIndex += Output.size();
+		Utility::MemUtils::Copy(m_rndBuffer, m_bufferIndex, Output, Offset, Length);
+		m_bufferIndex += Length;
 	}
 }
 
 char SecureRandom::NextChar()
 {
-	return IO::BitConverter::ToChar(GetBytes(sizeof(char)), 0);
+	GetBytes(m_smpBuffer, 0, sizeof(char));
+	return IO::BitConverter::ToChar(m_smpBuffer, 0);
 }
 
 unsigned char SecureRandom::NextUChar()
 {
-	return IO::BitConverter::ToUChar(GetBytes(sizeof(unsigned char)), 0);
+	GetBytes(m_smpBuffer, 0, sizeof(unsigned char));
+	return IO::BitConverter::ToUChar(m_smpBuffer, 0);
 }
 
 double SecureRandom::NextDouble()
 {
-	int sze = sizeof(double);
-	return IO::BitConverter::ToDouble(GetBytes(sizeof(double)), 0);
+	GetBytes(m_smpBuffer, 0, sizeof(double));
+	return IO::BitConverter::ToDouble(m_smpBuffer, 0);
 }
 
 short SecureRandom::NextInt16()
 {
-	return static_cast<short>(Utility::IntUtils::LeBytesTo16(GetBytes(2), 0));
+	GetBytes(m_smpBuffer, 0, 2);
+	return static_cast<short>(Utility::IntUtils::LeBytesTo16(m_smpBuffer, 0));
 }
 
 short SecureRandom::NextInt16(short Maximum)
@@ -169,7 +282,8 @@ short SecureRandom::NextInt16(short Maximum, short Minimum)
 
 ushort SecureRandom::NextUInt16()
 {
-	return Utility::IntUtils::LeBytesTo16(GetBytes(2), 0);
+	GetBytes(m_smpBuffer, 0, 2);
+	return Utility::IntUtils::LeBytesTo16(m_smpBuffer, 0);
 }
 
 ushort SecureRandom::NextUInt16(ushort Maximum)
@@ -198,12 +312,14 @@ ushort SecureRandom::NextUInt16(ushort Maximum, ushort Minimum)
 
 int SecureRandom::Next()
 {
-	return static_cast<int>(Utility::IntUtils::LeBytesTo32(GetBytes(4), 0));
+	GetBytes(m_smpBuffer, 0, 4);
+	return static_cast<int>(Utility::IntUtils::LeBytesTo32(m_smpBuffer, 0));
 }
 
 int SecureRandom::NextInt32()
 {
-	return static_cast<int>(Utility::IntUtils::LeBytesTo32(GetBytes(4), 0));
+	GetBytes(m_smpBuffer, 0, 4);
+	return static_cast<int>(Utility::IntUtils::LeBytesTo32(m_smpBuffer, 0));
 }
 
 int SecureRandom::NextInt32(int Maximum)
@@ -230,7 +346,8 @@ int SecureRandom::NextInt32(int Maximum, int Minimum)
 
 uint SecureRandom::NextUInt32()
 {
-	return Utility::IntUtils::LeBytesTo32(GetBytes(4), 0);
+	GetBytes(m_smpBuffer, 0, 4);
+	return Utility::IntUtils::LeBytesTo32(m_smpBuffer, 0);
 }
 
 uint SecureRandom::NextUInt32(uint Maximum)
@@ -259,12 +376,14 @@ uint SecureRandom::NextUInt32(uint Maximum, uint Minimum)
 
 long SecureRandom::NextLong()
 {
-	return static_cast<long>(Utility::IntUtils::LeBytesTo64(GetBytes(8), 0));
+	GetBytes(m_smpBuffer, 0, 8);
+	return static_cast<long>(Utility::IntUtils::LeBytesTo64(m_smpBuffer, 0));
 }
 
 long SecureRandom::NextInt64()
 {
-	return static_cast<long>(Utility::IntUtils::LeBytesTo64(GetBytes(8), 0));
+	GetBytes(m_smpBuffer, 0, 8);
+	return static_cast<long>(Utility::IntUtils::LeBytesTo64(m_smpBuffer, 0));
 }
 
 long SecureRandom::NextInt64(long Maximum)
@@ -291,7 +410,8 @@ long SecureRandom::NextInt64(long Maximum, long Minimum)
 
 ulong SecureRandom::NextUInt64()
 {
-	return Utility::IntUtils::LeBytesTo64(GetBytes(8), 0);
+	GetBytes(m_smpBuffer, 0, 8);
+	return Utility::IntUtils::LeBytesTo64(m_smpBuffer, 0);
 }
 
 ulong SecureRandom::NextUInt64(ulong Maximum)
@@ -330,29 +450,122 @@ void SecureRandom::Reset()
 
 //~~~Private Functions~~~//
 
+template <typename T>
+void SecureRandom::Generate(std::vector<T> &Output, size_t Offset, size_t Elements)
+{
+	// copy whole elements from the internal buffer; a remainder shorter than an element is skipped on refill
+	const size_t ELMSZE = sizeof(T);
+
+	while (Elements != 0)
+	{
+		if (m_rndBuffer.size() - m_bufferIndex < ELMSZE)
+		{
+			m_prngEngine->GetBytes(m_rndBuffer);
+			m_bufferIndex = 0;
+		}
+
+		const size_t CPYCNT = Utility::IntUtils::Min((m_rndBuffer.size() - m_bufferIndex) / ELMSZE, Elements);
+		Utility::MemUtils::Copy(m_rndBuffer, m_bufferIndex, Output, Offset, CPYCNT * ELMSZE);
+		m_bufferIndex += CPYCNT * ELMSZE;
+		Offset += CPYCNT;
+		Elements -= CPYCNT;
+	}
+}
+
+template <typename T>
+void SecureRandom::GenerateRange(std::vector<T> &Output, size_t Offset, size_t Elements, ulong Range, T Minimum)
+{
+	// Lemire's multiply and reject reduction; a 32 bit sample x maps to (x * range) >> 32,
+	// and is rejected if the low half of the product is below 2^32 mod range, which removes the bias
+	const uint RNGLEN = static_cast<uint>(Range);
+	const uint THRESH = static_cast<uint>(0x100000000ULL % Range);
+
+	while (Elements != 0)
+	{
+		Refill(sizeof(uint));
+
+		const size_t CNT = (m_rndBuffer.size() - m_bufferIndex) / sizeof(uint);
+		size_t i = 0;
+
+#if defined(__AVX2__)
+		const __m256i RNG = _mm256_set1_epi32(static_cast<int>(RNGLEN));
+		const __m256i THR = _mm256_set1_epi32(static_cast<int>(THRESH));
+		std::array<uint, 8> tmp;
+
+		for (; i + 8 <= CNT && Elements != 0; i += 8)
+		{
+			const __m256i X = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&m_rndBuffer[m_bufferIndex + (i * sizeof(uint))]));
+			// 32x32 products of the even and odd lanes
+			const __m256i PEVN = _mm256_mul_epu32(X, RNG);
+			const __m256i PODD = _mm256_mul_epu32(_mm256_srli_epi64(X, 32), RNG);
+			const __m256i LOW = _mm256_blend_epi32(PEVN, _mm256_slli_epi64(PODD, 32), 0xAA);
+			const __m256i HIGH = _mm256_blend_epi32(_mm256_srli_epi64(PEVN, 32), PODD, 0xAA);
+			// unsigned low >= threshold
+			const uint ACCEPT = static_cast<uint>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_max_epu32(LOW, THR), LOW))));
+
+			if (ACCEPT == 0xFF && Elements >= 8 && sizeof(T) == sizeof(uint))
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&Output[Offset]), _mm256_add_epi32(HIGH, _mm256_set1_epi32(static_cast<int>(Minimum))));
+				Offset += 8;
+				Elements -= 8;
+			}
+			else
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp.data()), HIGH);
+
+				for (size_t j = 0; j < 8 && Elements != 0; ++j)
+				{
+					if ((ACCEPT >> j) & 1)
+					{
+						Output[Offset] = static_cast<T>(Minimum + static_cast<T>(tmp[j]));
+						++Offset;
+						--Elements;
+					}
+				}
+			}
+		}
+#endif
+
+		for (; i < CNT && Elements != 0; ++i)
+		{
+			const ulong PRD = static_cast<ulong>(Utility::IntUtils::LeBytesTo32(m_rndBuffer, m_bufferIndex + (i * sizeof(uint)))) * RNGLEN;
+
+			if (static_cast<uint>(PRD) >= THRESH)
+			{
+				Output[Offset] = static_cast<T>(Minimum + static_cast<T>(PRD >> 32));
+				++Offset;
+				--Elements;
+			}
+		}
+
+		m_bufferIndex += i * sizeof(uint);
+	}
+}
+
 ulong SecureRandom::GetRanged(ulong Maximum, size_t Length)
 {
-	std::vector<byte> rand;
+	size_t rndLen;
 
 	if (Maximum < 256)
-		rand = GetBytes(1);
+		rndLen = 1;
 	else if (Maximum < 65536)
-		rand = GetBytes(2);
+		rndLen = 2;
 	else if (Maximum < 16777216)
-		rand = GetBytes(3);
+		rndLen = 3;
 	else if (Maximum < 4294967296)
-		rand = GetBytes(4);
+		rndLen = 4;
 	else if (Maximum < 1099511627776)
-		rand = GetBytes(5);
+		rndLen = 5;
 	else if (Maximum < 281474976710656)
-		rand = GetBytes(6);
+		rndLen = 6;
 	else if (Maximum < 72057594037927936)
-		rand = GetBytes(7);
+		rndLen = 7;
 	else
-		rand = GetBytes(8);
+		rndLen = 8;
 
+	GetBytes(m_smpBuffer, 0, rndLen);
 	ulong val = 0;
-	Utility::MemUtils::CopyToValue(rand, 0, val, rand.size());
+	Utility::MemUtils::CopyToValue(m_smpBuffer, 0, val, rndLen);
 
 	ulong bits = Length * 8;
 	while (val > Maximum && bits != 0)
@@ -364,4 +577,56 @@ ulong SecureRandom::GetRanged(ulong Maximum, size_t Length)
 	return val;
 }
 
+size_t SecureRandom::NextIndex(size_t Range)
+{
+	// a uniform index in [0, Range)
+	if (Range <= 0xFFFFFFFFULL)
+	{
+		const uint RNGLEN = static_cast<uint>(Range);
+		ulong prd;
+
+		do
+		{
+			Refill(sizeof(uint));
+			prd = static_cast<ulong>(Utility::IntUtils::LeBytesTo32(m_rndBuffer, m_bufferIndex)) * RNGLEN;
+			m_bufferIndex += sizeof(uint);
+		}
+		// the modulus is computed only on the rare path where the sample may be biased
+		while (static_cast<uint>(prd) < RNGLEN && static_cast<uint>(prd) < static_cast<uint>(0x100000000ULL % RNGLEN));
+
+		return static_cast<size_t>(prd >> 32);
+	}
+	else
+	{
+		ulong mask = static_cast<ulong>(Range) - 1;
+		mask |= mask >> 1;
+		mask |= mask >> 2;
+		mask |= mask >> 4;
+		mask |= mask >> 8;
+		mask |= mask >> 16;
+		mask |= mask >> 32;
+		ulong val;
+
+		do
+		{
+			Refill(sizeof(ulong));
+			val = Utility::IntUtils::LeBytesTo64(m_rndBuffer, m_bufferIndex) & mask;
+			m_bufferIndex += sizeof(ulong);
+		}
+		while (val >= Range);
+
+		return static_cast<size_t>(val);
+	}
+}
+
+void SecureRandom::Refill(size_t Length)
+{
+	// a remainder shorter than the sample length is discarded
+	if (m_rndBuffer.size() - m_bufferIndex < Length)
+	{
+		m_prngEngine->GetBytes(m_rndBuffer);
+		m_bufferIndex = 0;
+	}
+}
+
 NAMESPACE_PRNGEND
\ No newline at end of file
@@ -32,6 +32,7 @@
 #include "IDigest.h"
 #include "IPrng.h"
 #include "MemUtils.h"
+#include <utility>
 
 NAMESPACE_PRNG
 
@@ -72,6 +73,7 @@ private:
 	IPrng* m_prngEngine;
 	Providers m_providerType;
 	std::vector<byte> m_rndBuffer;
+	std::vector<byte> m_smpBuffer;
 
 	SecureRandom(const SecureRandom&) = delete;
 	SecureRandom& operator=(const SecureRandom&) = delete;
@@ -132,6 +134,86 @@ public:
 	/// <param name="Elements">The number of array elements to fill</param>
 	void Fill(std::vector<ulong> &Output, size_t Offset, size_t Elements);
 
+	//~~~Bulk~~~//
+
+	/// <summary>
+	/// Fill an array with uniformly distributed doubles in the range [0, 1)
+	/// <para>Each value uses 53 random bits, the precision of a double, so every representable multiple of 2^-53 is equally likely.</para>
+	/// </summary>
+	///
+	/// <param name="Output">The double output array</param>
+	/// <param name="Offset">The starting index within the Output array</param>
+	/// <param name="Elements">The number of array elements to fill</param>
+	void Fill(std::vector<double> &Output, size_t Offset, size_t Elements);
+
+	/// <summary>
+	/// Fill an array of uint16 with uniformly distributed integers in the range [Minimum, Maximum)
+	/// <para>The integers are decoded in bulk from the internal keystream buffer with an unbiased multiply and reject reduction.</para>
+	/// </summary>
+	///
+	/// <param name="Output">The uint16 output array</param>
+	/// <param name="Offset">The starting index within the Output array</param>
+	/// <param name="Elements">The number of array elements to fill</param>
+	/// <param name="Maximum">The exclusive upper bound</param>
+	/// <param name="Minimum">The inclusive lower bound</param>
+	void Fill(std::vector<ushort> &Output, size_t Offset, size_t Elements, ushort Maximum, ushort Minimum);
+
+	/// <summary>
+	/// Fill an array of uint32 with uniformly distributed integers in the range [Minimum, Maximum)
+	/// <para>The integers are decoded in bulk from the internal keystream buffer with an unbiased multiply and reject reduction; eight values per step when compiled with AVX2.</para>
+	/// </summary>
+	///
+	/// <param name="Output">The uint32 output array</param>
+	/// <param name="Offset">The starting index within the Output array</param>
+	/// <param name="Elements">The number of array elements to fill</param>
+	/// <param name="Maximum">The exclusive upper bound</param>
+	/// <param name="Minimum">The inclusive lower bound</param>
+	void Fill(std::vector<uint> &Output, size_t Offset, size_t Elements, uint Maximum, uint Minimum);
+
+	/// <summary>
+	/// Fill an array of uint64 with uniformly distributed integers in the range [Minimum, Maximum)
+	/// <para>Ranges that fit in 32 bits use the uint32 reduction; larger ranges are sampled by masking and rejection.</para>
+	/// </summary>
+	///
+	/// <param name="Output">The uint64 output array</param>
+	/// <param name="Offset">The starting index within the Output array</param>
+	/// <param name="Elements">The number of array elements to fill</param>
+	/// <param name="Maximum">The exclusive upper bound</param>
+	/// <param name="Minimum">The inclusive lower bound</param>
+	void Fill(std::vector<ulong> &Output, size_t Offset, size_t Elements, ulong Maximum, ulong Minimum);
+
+	/// <summary>
+	/// Fill an array with a random permutation of the integers [0, Elements)
+	/// </summary>
+	///
+	/// <param name="Output">The uint32 output array</param>
+	/// <param name="Offset">The starting index within the Output array</param>
+	/// <param name="Elements">The number of array elements in the permutation</param>
+	void Permutation(std::vector<uint> &Output, size_t Offset, size_t Elements);
+
+	/// <summary>
+	/// Randomly reorder a section of an array with a Fisher-Yates shuffle
+	/// </summary>
+	///
+	/// <param name="Output">The array to shuffle</param>
+	/// <param name="Offset">The starting index within the Output array</param>
+	/// <param name="Elements">The number of array elements to shuffle</param>
+	template <typename T>
+	void Shuffle(std::vector<T> &Output, size_t Offset, size_t Elements)
+	{
+		CexAssert(Output.size() - Offset >= Elements, "the output array is too short");
+
+		for (size_t i = Elements; i > 1; --i)
+		{
+			const size_t J = NextIndex(i);
+
+			if (J != i - 1)
+			{
+				std::swap(Output[Offset + i - 1], Output[Offset + J]);
+			}
+		}
+	}
+
 	//~~~Byte~~~//
 
 	/// <summary>
@@ -150,6 +232,15 @@ public:
 	/// <param name="Output">Output array</param>
 	void GetBytes(std::vector<byte> &Output);
 
+	/// <summary>
+	/// Fill a section of an array with pseudo random bytes
+	/// </summary>
+	///
+	/// <param name="Output">Output array</param>
+	/// <param name="Offset">The starting index within the Output array</param>
+	/// <param name="Length">The number of bytes to write</param>
+	void GetBytes(std::vector<byte> &Output, size_t Offset, size_t Length);
+
 	//~~~Char~~~//
 
 	/// <summary>
@@ -364,7 +455,13 @@ public:
 
 private:
 
+	template <typename T>
+	void Generate(std::vector<T> &Output, size_t Offset, size_t Elements);
+	template <typename T>
+	void GenerateRange(std::vector<T> &Output, size_t Offset, size_t Elements, ulong Range, T Minimum);
 	ulong GetRanged(ulong Maximum, size_t Length);
+	size_t NextIndex(size_t Range);
+	void Refill(size_t Length);
 };
 
 NAMESPACE_PRNGEND
@@ -0,0 +1,305 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_SEGMENTUTILS_H
+#define CEX_SEGMENTUTILS_H
+
+#include "CexDomain.h"
+#include "CryptoCipherModeException.h"
+#include "IntUtils.h"
+#include "MemorySegment.h"
+#include "MemUtils.h"
+#include "MutableSegment.h"
+
+NAMESPACE_UTILITY
+
+using Common::MemorySegment;
+using Common::MutableSegment;
+
+/// <summary>
+/// Scatter-gather list functions class.
+/// <para>Used by the cipher modes, digests and Macs to implement their segment functions; any staging memory is passed in by, and owned by, the caller.</para>
+/// </summary>
+class SegmentUtils
+{
+public:
+
+	/// <summary>
+	/// Copy a list of fragments into one contiguous array
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of fragments</param>
+	/// <param name="Output">The destination array; grown if it is smaller than the combined length, but never shrunk</param>
+	/// 
+	/// <returns>The number of bytes copied</returns>
+	static size_t Gather(const std::vector<MemorySegment> &Input, std::vector<byte> &Output)
+	{
+		const size_t INPLEN = Length(Input);
+		size_t outPos = 0;
+
+		if (Output.size() < INPLEN)
+			Output.resize(INPLEN);
+
+		for (size_t i = 0; i < Input.size(); ++i)
+		{
+			if (Input[i].Length != 0)
+			{
+				MemUtils::Copy(*Input[i].Data, Input[i].Offset, Output, outPos, Input[i].Length);
+				outPos += Input[i].Length;
+			}
+		}
+
+		return INPLEN;
+	}
+
+	/// <summary>
+	/// Test that every non-empty segment in a list lies within its array
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of segments</param>
+	/// 
+	/// <returns>Returns false if a segment has no array, or exceeds its array</returns>
+	template <typename T>
+	static bool IsValid(const std::vector<T> &Input)
+	{
+		for (size_t i = 0; i < Input.size(); ++i)
+		{
+			if (Input[i].Length != 0 && (Input[i].Data == nullptr || Input[i].Data->size() < Input[i].Offset + Input[i].Length))
+				return false;
+		}
+
+		return true;
+	}
+
+	/// <summary>
+	/// Get the combined length of a list of segments
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of segments</param>
+	/// 
+	/// <returns>The sum of the segment lengths</returns>
+	template <typename T>
+	static size_t Length(const std::vector<T> &Input)
+	{
+		size_t len = 0;
+
+		for (size_t i = 0; i < Input.size(); ++i)
+			len += Input[i].Length;
+
+		return len;
+	}
+
+	/// <summary>
+	/// Transform a list of input fragments to a list of output fragments with a cipher mode.
+	/// <para>The two lists are processed as single contiguous messages, and may be fragmented differently, but must be of equal combined length.
+	/// Runs that are contiguous in both lists are passed straight to the mode's Transform function, one parallel block at a time.
+	/// The short runs between fragment boundaries are gathered into a single parallel block sized transform, so the mode state carries across each boundary.
+	/// The staging array is grown to two parallel blocks on first use, and erased before returning.</para>
+	/// </summary>
+	/// 
+	/// <param name="Cipher">The initialized cipher mode</param>
+	/// <param name="Input">The list of input fragments</param>
+	/// <param name="Output">The list of output fragments</param>
+	/// <param name="Stage">The staging array owned by the cipher mode instance</param>
+	/// 
+	/// <exception cref="Exception::CryptoCipherModeException">Thrown if a segment exceeds its array, or the lists differ in length</exception>
+	template <typename T>
+	static void Transform(T* Cipher, const std::vector<MemorySegment> &Input, std::vector<MutableSegment> &Output, std::vector<byte> &Stage)
+	{
+		if (!IsValid(Input) || !IsValid(Output))
+			throw Exception::CryptoCipherModeException(Cipher->Name() + ":TransformSegments", "A segment exceeds its array!");
+		if (Length(Input) != Length(Output))
+			throw Exception::CryptoCipherModeException(Cipher->Name() + ":TransformSegments", "The input and output lists must be of equal length!");
+
+		const size_t BLKLEN = Cipher->BlockSize();
+		const size_t PRLLEN = (Cipher->IsParallel() && Cipher->ParallelBlockSize() > BLKLEN) ? Cipher->ParallelBlockSize() : BLKLEN;
+		bool isStaged = false;
+		size_t inIdx = 0;
+		size_t inPos = 0;
+		size_t outIdx = 0;
+		size_t outPos = 0;
+		size_t rmdLen = Length(Input);
+
+		while (rmdLen != 0)
+		{
+			while (inPos == Input[inIdx].Length)
+			{
+				++inIdx;
+				inPos = 0;
+			}
+
+			while (outPos == Output[outIdx].Length)
+			{
+				++outIdx;
+				outPos = 0;
+			}
+
+			const size_t RUNLEN = IntUtils::Min(Input[inIdx].Length - inPos, Output[outIdx].Length - outPos);
+
+			if (RUNLEN >= PRLLEN || RUNLEN == rmdLen)
+			{
+				// contiguous in both lists; parallel transforms are passed one parallel block at a time,
+				// and only the final run may end on a partial block
+				const size_t PRCLEN = (RUNLEN < PRLLEN) ? RUNLEN : (PRLLEN != BLKLEN) ? PRLLEN : (RUNLEN == rmdLen) ? RUNLEN : RUNLEN - (RUNLEN % BLKLEN);
+
+				Cipher->Transform(*Input[inIdx].Data, Input[inIdx].Offset + inPos, *Output[outIdx].Data, Output[outIdx].Offset + outPos, PRCLEN);
+				inPos += PRCLEN;
+				outPos += PRCLEN;
+				rmdLen -= PRCLEN;
+			}
+			else
+			{
+				// gather the runs that straddle fragment boundaries
+				size_t prcLen = IntUtils::Min(PRLLEN, rmdLen);
+
+				if (prcLen != rmdLen)
+					prcLen -= prcLen % BLKLEN;
+
+				// the input is staged in the lower half, and transformed to the upper half
+				if (Stage.size() < 2 * PRLLEN)
+					Stage.resize(2 * PRLLEN);
+
+				isStaged = true;
+
+				for (size_t i = 0; i < prcLen;)
+				{
+					while (inPos == Input[inIdx].Length)
+					{
+						++inIdx;
+						inPos = 0;
+					}
+
+					const size_t CPYLEN = IntUtils::Min(Input[inIdx].Length - inPos, prcLen - i);
+					MemUtils::Copy(*Input[inIdx].Data, Input[inIdx].Offset + inPos, Stage, i, CPYLEN);
+					inPos += CPYLEN;
+					i += CPYLEN;
+				}
+
+				Cipher->Transform(Stage, 0, Stage, PRLLEN, prcLen);
+
+				for (size_t i = 0; i < prcLen;)
+				{
+					while (outPos == Output[outIdx].Length)
+					{
+						++outIdx;
+						outPos = 0;
+					}
+
+					const size_t CPYLEN = IntUtils::Min(Output[outIdx].Length - outPos, prcLen - i);
+					MemUtils::Copy(Stage, PRLLEN + i, *Output[outIdx].Data, Output[outIdx].Offset + outPos, CPYLEN);
+					outPos += CPYLEN;
+					i += CPYLEN;
+				}
+
+				rmdLen -= prcLen;
+			}
+		}
+
+		if (isStaged)
+			MemUtils::Clear(Stage, 0, Stage.size());
+	}
+
+	/// <summary>
+	/// Absorb a list of fragments into a digest or Mac, in list order.
+	/// <para>The engine carries a partial block across each fragment boundary in its own buffer, so no fragment is copied.
+	/// Used by the Macs that have no parallel mode; a parallel digest or Mac uses the staging overload, so its lanes are filled across fragment boundaries.</para>
+	/// </summary>
+	/// 
+	/// <param name="Engine">The digest or Mac instance</param>
+	/// <param name="Input">The list of message fragments</param>
+	template <typename T>
+	static void Update(T* Engine, const std::vector<MemorySegment> &Input)
+	{
+		for (size_t i = 0; i < Input.size(); ++i)
+		{
+			if (Input[i].Length != 0)
+				Engine->Update(*Input[i].Data, Input[i].Offset, Input[i].Length);
+		}
+	}
+
+	/// <summary>
+	/// Absorb a list of fragments into a parallel capable digest or Mac, in list order.
+	/// <para>If the engine is not parallel, or a segment exceeds its array, this is the same as the two parameter overload, and the engine's Update reports the error.
+	/// Otherwise fragment runs of at least one parallel block are passed straight to the engine's Update in whole parallel blocks,
+	/// and the short runs between fragment boundaries are gathered into the staging array until it holds a full parallel block,
+	/// so every lane or leaf is filled before it is dispatched.
+	/// The staging array is grown to one parallel block on first use, and erased before returning.</para>
+	/// </summary>
+	/// 
+	/// <param name="Engine">The digest or Mac instance</param>
+	/// <param name="Input">The list of message fragments</param>
+	/// <param name="Stage">The staging array owned by the digest or Mac instance</param>
+	template <typename T>
+	static void Update(T* Engine, const std::vector<MemorySegment> &Input, std::vector<byte> &Stage)
+	{
+		if (!Engine->ParallelProfile().IsParallel() || !IsValid(Input))
+		{
+			Update(Engine, Input);
+			return;
+		}
+
+		const size_t PRLLEN = Engine->ParallelProfile().ParallelBlockSize();
+		size_t stgLen = 0;
+		bool isStaged = false;
+
+		for (size_t i = 0; i < Input.size(); ++i)
+		{
+			size_t inPos = 0;
+
+			while (inPos != Input[i].Length)
+			{
+				const size_t RMDLEN = Input[i].Length - inPos;
+
+				if (stgLen == 0 && RMDLEN >= PRLLEN)
+				{
+					// nothing is staged, pass the whole parallel blocks straight through
+					const size_t PRCLEN = RMDLEN - (RMDLEN % PRLLEN);
+					Engine->Update(*Input[i].Data, Input[i].Offset + inPos, PRCLEN);
+					inPos += PRCLEN;
+				}
+				else
+				{
+					// gather the short runs until they fill a parallel block
+					if (Stage.size() < PRLLEN)
+						Stage.resize(PRLLEN);
+
+					isStaged = true;
+					const size_t CPYLEN = IntUtils::Min(RMDLEN, PRLLEN - stgLen);
+					MemUtils::Copy(*Input[i].Data, Input[i].Offset + inPos, Stage, stgLen, CPYLEN);
+					inPos += CPYLEN;
+					stgLen += CPYLEN;
+
+					if (stgLen == PRLLEN)
+					{
+						Engine->Update(Stage, 0, PRLLEN);
+						stgLen = 0;
+					}
+				}
+			}
+		}
+
+		if (stgLen != 0)
+			Engine->Update(Stage, 0, stgLen);
+
+		if (isStaged)
+			MemUtils::Clear(Stage, 0, Stage.size());
+	}
+};
+
+NAMESPACE_UTILITYEND
+#endif
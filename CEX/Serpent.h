@@ -20,6 +20,7 @@
 #define CEX_SERPENT_H
 
 #include "CexDomain.h"
+#include "SecureAllocator.h"
 
 NAMESPACE_BLOCK
 
@@ -28,7 +29,7 @@ NAMESPACE_BLOCK
 */
 
 template<typename T>
-void SHXDecryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Key)
+void SHXDecryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, Utility::SecureVector<uint> &Key)
 {
 #if defined(__AVX__)
 
@@ -129,7 +130,7 @@ void SHXDecryptW(const std::vector<byte> &Input, const size_t InOffset, std::vec
 }
 
 template<typename T>
-void SHXEncryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Key)
+void SHXEncryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, Utility::SecureVector<uint> &Key)
 {
 #if defined(__AVX__)
 
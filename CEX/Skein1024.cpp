@@ -2,10 +2,14 @@
 #include "IntUtils.h"
 #include "MemUtils.h"
 #include "ParallelUtils.h"
+#include "SegmentUtils.h"
+#include "StreamReader.h"
+#include "StreamWriter.h"
 
 NAMESPACE_DIGEST
 
 const std::string Skein1024::CLASS_NAME("Skein1024");
+const std::vector<byte> Skein1024::ZERO_BLOCK(BLOCK_SIZE, 0);
 
 //~~~Properties~~~//
 
@@ -56,7 +60,8 @@ Skein1024::Skein1024(bool Parallel)
 	m_isInitialized(false),
 	m_msgBuffer(Parallel ? MIN_PRLBLOCK : BLOCK_SIZE, 0),
 	m_msgLength(0),
-	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, DEF_PRLDEGREE)
+	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, DEF_PRLDEGREE),
+	m_segmentStage(0)
 {
 	if (m_parallelProfile.IsParallel())
 		m_parallelProfile.IsParallel() = Parallel;
@@ -77,7 +82,8 @@ Skein1024::Skein1024(SkeinParams &Params)
 	m_isInitialized(false),
 	m_msgBuffer(BLOCK_SIZE),
 	m_msgLength(0),
-	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, m_treeParams.FanOut())
+	m_parallelProfile(BLOCK_SIZE, false, STATE_PRECACHED, false, m_treeParams.FanOut()),
+	m_segmentStage(0)
 {
 	if (m_treeParams.FanOut() > 1)
 	{
@@ -121,6 +127,7 @@ void Skein1024::Destroy()
 
 		Utility::IntUtils::ClearVector(m_dgtState);
 		Utility::IntUtils::ClearVector(m_msgBuffer);
+		Utility::IntUtils::ClearVector(m_segmentStage);
 	}
 }
 
@@ -182,6 +189,91 @@ size_t Skein1024::Finalize(std::vector<byte> &Output, const size_t OutOffset)
 	return DIGEST_SIZE;
 }
 
+void Skein1024::Initialize(ISymmetricKey &MacKey)
+{
+	SymmetricKeyView keyView(MacKey);
+
+	if (keyView.Key().size() == 0)
+		throw CryptoDigestException("Skein1024:Initialize", "The Mac key can not be zero length!");
+
+	std::vector<byte> key = keyView.Key();
+	std::vector<byte> blk(BLOCK_SIZE, 0);
+	size_t keyLen = key.size();
+	size_t keyOff = 0;
+
+	// the key block is compressed from a zero chaining value
+	for (size_t i = 0; i < m_dgtState.size(); ++i)
+		m_dgtState[i].Reset();
+
+	SkeinUbiTweak::StartNewBlockType(m_dgtState[0].T, SkeinUbiType::Key);
+	m_isInitialized = false;
+
+	while (keyLen > BLOCK_SIZE)
+	{
+		ProcessBlock(key, keyOff, m_dgtState, 0);
+		keyOff += BLOCK_SIZE;
+		keyLen -= BLOCK_SIZE;
+	}
+
+	// zero-pad and process the final key block: K' = UBI(0, K, Tkey)
+	Utility::MemUtils::Copy(key, keyOff, blk, 0, keyLen);
+	SkeinUbiTweak::IsFinalBlock(m_dgtState[0].T, true);
+	ProcessBlock(blk, 0, m_dgtState, 0, keyLen);
+	Utility::MemUtils::Clear(blk, 0, blk.size());
+	Utility::MemUtils::Clear(key, 0, key.size());
+
+	// the config block is compressed with K', and the keyed chaining value is stored for reset
+	Initialize();
+}
+
+void Skein1024::LoadState(const std::vector<byte> &State)
+{
+	if (State.size() < 11 + sizeof(ushort))
+		throw CryptoDigestException("Skein1024:LoadState", "The state array is too short!");
+
+	IO::MemoryStream strm(State);
+	IO::StreamReader reader(strm);
+
+	if (reader.ReadByte() != STATE_VERSION)
+		throw CryptoDigestException("Skein1024:LoadState", "The state version is not supported!");
+	if (reader.ReadByte() != static_cast<byte>(Digests::Skein1024))
+		throw CryptoDigestException("Skein1024:LoadState", "The state was not created by this digest!");
+
+	const size_t LEAFCNT = reader.ReadInt<uint>();
+	if (LEAFCNT != m_dgtState.size())
+		throw CryptoDigestException("Skein1024:LoadState", "The number of tree leaves does not match this digest instance!");
+
+	const bool ISINIT = (reader.ReadByte() != 0);
+	const size_t PRMLEN = reader.ReadInt<ushort>();
+	if (reader.Position() + PRMLEN + sizeof(uint) > State.size())
+		throw CryptoDigestException("Skein1024:LoadState", "The state array is malformed!");
+
+	// the tree parameters are fixed by the instance settings; a state hashed under different parameters is rejected, not adopted
+	if (PRMLEN != m_treeParams.ToBytes().size())
+		throw CryptoDigestException("Skein1024:LoadState", "The tree parameters do not match this digest instance!");
+
+	SkeinParams params(reader.ReadBytes(PRMLEN));
+
+	if (params.ToBytes() != m_treeParams.ToBytes())
+		throw CryptoDigestException("Skein1024:LoadState", "The tree parameters do not match this digest instance!");
+
+	const size_t MSGLEN = reader.ReadInt<uint>();
+
+	if (MSGLEN > m_msgBuffer.size() || reader.Position() + MSGLEN + (LEAFCNT * ((STATE_SIZE + 2) * sizeof(ulong))) != State.size())
+		throw CryptoDigestException("Skein1024:LoadState", "The state array is malformed!");
+
+	m_isInitialized = ISINIT;
+	Utility::MemUtils::Clear(m_msgBuffer, 0, m_msgBuffer.size());
+	reader.Read(m_msgBuffer, 0, MSGLEN);
+	m_msgLength = MSGLEN;
+
+	for (size_t i = 0; i < m_dgtState.size(); ++i)
+	{
+		reader.Read(m_dgtState[i].S, 0, m_dgtState[i].S.size());
+		reader.Read(m_dgtState[i].T, 0, m_dgtState[i].T.size());
+	}
+}
+
 void Skein1024::Reset()
 {
 	for (size_t i = 0; i < m_dgtState.size(); ++i)
@@ -196,6 +288,29 @@ void Skein1024::Reset()
 	m_msgLength = 0;
 }
 
+std::vector<byte> Skein1024::SaveState()
+{
+	std::vector<byte> params = m_treeParams.ToBytes();
+	IO::StreamWriter writer(11 + sizeof(ushort) + params.size() + m_msgLength + (m_dgtState.size() * ((STATE_SIZE + 2) * sizeof(ulong))));
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Digests::Skein1024));
+	writer.Write(static_cast<uint>(m_dgtState.size()));
+	writer.Write(static_cast<byte>(m_isInitialized));
+	writer.Write(static_cast<ushort>(params.size()));
+	writer.Write(params, 0, params.size());
+	writer.Write(static_cast<uint>(m_msgLength));
+	writer.Write(m_msgBuffer, 0, m_msgLength);
+
+	for (size_t i = 0; i < m_dgtState.size(); ++i)
+	{
+		writer.Write(m_dgtState[i].S);
+		writer.Write(m_dgtState[i].T);
+	}
+
+	return writer.GetBytes();
+}
+
 void Skein1024::ParallelMaxDegree(size_t Degree)
 {
 	if (Degree == 0)
@@ -278,7 +393,8 @@ void Skein1024::Update(const std::vector<byte> &Input, size_t InOffset, size_t L
 	}
 	else
 	{
-		if (m_msgLength != 0 && (m_msgLength + Length >= BLOCK_SIZE))
+		// the last block is held back for the final block flag
+		if (m_msgLength != 0 && (m_msgLength + Length > BLOCK_SIZE))
 		{
 			const size_t RMDLEN = BLOCK_SIZE - m_msgLength;
 			if (RMDLEN != 0)
@@ -307,25 +423,30 @@ void Skein1024::Update(const std::vector<byte> &Input, size_t InOffset, size_t L
 	}
 }
 
+void Skein1024::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input, m_segmentStage);
+}
+
 //~~~Private Functions~~~//
 
 void Skein1024::HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<Skein1024State> &State, size_t StateOffset)
 {
-	// process message block
+	// process message block; an empty message is processed as a single zero block
 	SkeinUbiTweak::IsFinalBlock(State[StateOffset].T, true);
-	while (Length != 0)
+	do
 	{
 		const size_t MSGRMD = (Length >= BLOCK_SIZE) ? BLOCK_SIZE : Length;
 		ProcessBlock(Input, InOffset, State, StateOffset, MSGRMD);
 		Length -= MSGRMD;
 		InOffset += MSGRMD;
 	}
+	while (Length != 0);
 
 	// finalize block
 	SkeinUbiTweak::StartNewBlockType(State[StateOffset].T, SkeinUbiType::Out);
 	SkeinUbiTweak::IsFinalBlock(State[StateOffset].T, true);
-	std::vector<byte> tmp(BLOCK_SIZE);
-	ProcessBlock(tmp, 0, State, StateOffset, 8);
+	ProcessBlock(ZERO_BLOCK, 0, State, StateOffset, 8);
 }
 
 void Skein1024::ProcessBlock(const std::vector<byte> &Input, size_t InOffset, std::vector<Skein1024State> &State, size_t StateOffset, size_t Length)
@@ -333,12 +454,11 @@ void Skein1024::ProcessBlock(const std::vector<byte> &Input, size_t InOffset, st
 	// update length
 	State[StateOffset].Increase(Length);
 	// encrypt block
-	std::vector<ulong> block(16, 0);
-	Utility::IntUtils::LeBytesToULL1024(Input, InOffset, block, 0);
-	Threefish1024::Transfrom(block, 0, State[StateOffset]);
+	Utility::IntUtils::LeBytesToULL1024(Input, InOffset, State[StateOffset].M, 0);
+	Threefish1024::Transfrom(State[StateOffset].M, 0, State[StateOffset]);
 
 	// feed-forward input with state
-	Utility::MemUtils::XOR1024(block, 0, State[StateOffset].S, 0);
+	Utility::MemUtils::XOR1024(State[StateOffset].M, 0, State[StateOffset].S, 0);
 
 	// clear first flag
 	if (!m_isInitialized && StateOffset == 0)
@@ -394,7 +514,7 @@ void Skein1024::LoadState(Skein1024State &State, std::vector<ulong> &Config)
 	State.Increase(32);
 	Threefish1024::Transfrom(Config, 0, State);
 	// store the initial state for reset
-	Utility::MemUtils::Copy(m_dgtState[0].S, 0, m_dgtState[0].V, 0, m_dgtState[0].V.size() * sizeof(ulong));
+	Utility::MemUtils::Copy(State.S, 0, State.V, 0, State.V.size() * sizeof(ulong));
 	// add the config string
 	Utility::MemUtils::XOR1024(Config, 0, State.V, 0);
 }
@@ -31,12 +31,16 @@
 #define CEX_SKEIN256_H
 
 #include "IDigest.h"
+#include "ISymmetricKey.h"
 #include "SkeinParams.h"
 #include "SkeinUbiTweak.h"
 #include "Threefish256.h"
 
 NAMESPACE_DIGEST
 
+using Key::Symmetric::ISymmetricKey;
+using Key::Symmetric::SymmetricKeyView;
+
 /// <summary>
 /// An implementation of the Skein message digest with a 256 bit digest return size
 /// </summary> 
@@ -102,11 +106,16 @@ private:
 	static const size_t MAX_PRLBLOCK = 1024 * 1000 * DEF_PRLDEGREE * 100;
 	static const size_t MIN_PRLBLOCK = BLOCK_SIZE * DEF_PRLDEGREE;
 	static const size_t STATE_SIZE = 4;
+	static const byte STATE_VERSION = 1;
 	// size of reserved state buffer subtracted from parallel size calculations
 	static const size_t STATE_PRECACHED = 2048;
+	// the output stage processes a single zeroed counter block
+	static const std::vector<byte> ZERO_BLOCK;
 
 	struct Skein256State
 	{
+		// message block
+		std::vector<ulong> M;
 		// state
 		std::vector<ulong> S;
 		// tweak
@@ -116,6 +125,8 @@ private:
 
 		Skein256State()
 			:
+			// message block
+			M(4),
 			// state
 			S(4),
 			// tweak
@@ -132,6 +143,11 @@ private:
 
 		void Reset()
 		{
+			if (M.size() > 0)
+			{
+				for (size_t i = 0; i < M.size(); ++i)
+					M[i] = 0;
+			}
 			if (S.size() > 0)
 			{
 				for (size_t i = 0; i < S.size(); ++i)
@@ -157,6 +173,7 @@ private:
 	std::vector<byte> m_msgBuffer;
 	size_t m_msgLength;
 	ParallelOptions m_parallelProfile;
+	std::vector<byte> m_segmentStage;
 
 public:
 
@@ -263,6 +280,29 @@ public:
 	/// <exception cref="CryptoDigestException">Thrown if the output buffer is too short</exception>
 	size_t Finalize(std::vector<byte> &Output, const size_t OutOffset) override;
 
+	/// <summary>
+	/// Initialize the digest as a Skein-MAC code generator.
+	/// <para>The key is compressed into the chaining value with a Key type UBI block ahead of the configuration block, K' = UBI(0, K, Tkey). 
+	/// The keyed chaining value is retained by Reset, so the digest can compute successive MAC codes without being re-keyed; 
+	/// changing the ParallelMaxDegree setting restores the un-keyed state.</para>
+	/// </summary>
+	/// 
+	/// <param name="MacKey">The input key parameters; the Key must be at least one byte in length, the digest state size (32 bytes) is recommended.</param>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the key is empty</exception>
+	void Initialize(ISymmetricKey &MacKey);
+
+	/// <summary>
+	/// Restore the internal state from a checkpoint created by the SaveState function.
+	/// <para>The digest must be constructed with the same parallel and tree settings as the instance that created the state;
+	/// hashing resumes from the checkpoint, and subsequent Update and Finalize calls produce the same hash as an uninterrupted digest.</para>
+	/// </summary>
+	///
+	/// <param name="State">The serialized digest state</param>
+	///
+	/// <exception cref="CryptoDigestException">Thrown if the state version, digest type, or number of tree leaves do not match this instance</exception>
+	void LoadState(const std::vector<byte> &State) override;
+
 	/// <summary>
 	/// Set the number of threads allocated when using multi-threaded tree hashing processing.
 	/// <para>Thread count must be an even number, and not exceed the number of processor cores.
@@ -279,6 +319,14 @@ public:
 	/// </summary>
 	void Reset() override;
 
+	/// <summary>
+	/// Serialize the internal state; the version, tree parameters, pending message bytes, and the chaining value and counter of each leaf.
+	/// <para>Only the unprocessed bytes of the message buffer are written, and each leaf is stored as its raw chaining and counter words.</para>
+	/// </summary>
+	///
+	/// <returns>The serialized digest state</returns>
+	std::vector<byte> SaveState() override;
+
 	/// <summary>
 	/// Update the message digest with a single byte
 	/// </summary>
@@ -297,6 +345,14 @@ public:
 	/// <exception cref="CryptoDigestException">Thrown if the input buffer is too short</exception>
 	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
 
+	/// <summary>
+	/// Update the buffer with a message stored as a list of fragments
+	/// <para>The fragments are absorbed in list order as one contiguous message; a partial block is carried across each fragment boundary, so no fragment is copied.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of message fragments</param>
+	void UpdateSegments(const std::vector<MemorySegment> &Input) override;
+
 private:
 
 	void HashFinal(std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<Skein256State> &State, size_t StateOffset);
@@ -0,0 +1,255 @@
+#include "SkeinMac.h"
+#include "DigestFromName.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#include "SegmentUtils.h"
+#include "Skein1024.h"
+#include "Skein256.h"
+#include "Skein512.h"
+#include "StreamWriter.h"
+
+NAMESPACE_MAC
+
+const std::string SkeinMac::CLASS_NAME("SkeinMac");
+
+//~~~Properties~~~//
+
+const size_t SkeinMac::BlockSize()
+{
+	return m_msgDigest->BlockSize();
+}
+
+const Digests SkeinMac::DigestType()
+{
+	return m_msgDigestType;
+}
+
+const Macs SkeinMac::Enumeral()
+{
+	return Macs::SkeinMac;
+}
+
+const size_t SkeinMac::MacSize()
+{
+	return m_msgDigest->DigestSize();
+}
+
+const bool SkeinMac::IsInitialized()
+{
+	return m_isInitialized;
+}
+
+std::vector<SymmetricKeySize> SkeinMac::LegalKeySizes() const
+{
+	return m_legalKeySizes;
+}
+
+const bool SkeinMac::IsParallel()
+{
+	return m_msgDigest->IsParallel();
+}
+
+const std::string SkeinMac::Name()
+{
+	return CLASS_NAME + "-" + m_msgDigest->Name();
+}
+
+const size_t SkeinMac::ParallelBlockSize()
+{
+	return m_msgDigest->ParallelBlockSize();
+}
+
+ParallelOptions &SkeinMac::ParallelProfile()
+{
+	return m_msgDigest->ParallelProfile();
+}
+
+//~~~Constructor~~~//
+
+SkeinMac::SkeinMac(Digests DigestType, bool Parallel)
+	:
+	m_msgDigest(DigestType == Digests::Skein256 || DigestType == Digests::Skein512 || DigestType == Digests::Skein1024 ? Helper::DigestFromName::GetInstance(DigestType, Parallel) :
+		throw CryptoMacException("SkeinMac:Ctor", "The digest must be a Skein256, Skein512, or Skein1024 instance!")),
+	m_destroyEngine(true),
+	m_isDestroyed(false),
+	m_isInitialized(false),
+	m_legalKeySizes(0),
+	m_msgDigestType(DigestType),
+	m_segmentStage(0)
+{
+	Scope();
+}
+
+SkeinMac::SkeinMac(IDigest* Digest)
+	:
+	m_msgDigest(Digest != 0 ? Digest : throw CryptoMacException("SkeinMac:Ctor", "The digest can not be null!")),
+	m_destroyEngine(false),
+	m_isDestroyed(false),
+	m_isInitialized(false),
+	m_legalKeySizes(0),
+	m_msgDigestType(m_msgDigest->Enumeral()),
+	m_segmentStage(0)
+{
+	if (m_msgDigestType != Digests::Skein256 && m_msgDigestType != Digests::Skein512 && m_msgDigestType != Digests::Skein1024)
+		throw CryptoMacException("SkeinMac:Ctor", "The digest must be a Skein256, Skein512, or Skein1024 instance!");
+
+	Scope();
+}
+
+SkeinMac::~SkeinMac()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void SkeinMac::Compute(const std::vector<byte> &Input, std::vector<byte> &Output)
+{
+	if (Output.size() != m_msgDigest->DigestSize())
+		Output.resize(m_msgDigest->DigestSize());
+
+	Update(Input, 0, Input.size());
+	Finalize(Output, 0);
+}
+
+void SkeinMac::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_msgDigestType = Digests::None;
+		m_isInitialized = false;
+
+		if (m_destroyEngine)
+		{
+			m_destroyEngine = false;
+
+			if (m_msgDigest != 0)
+				delete m_msgDigest;
+		}
+
+		Utility::IntUtils::ClearVector(m_legalKeySizes);
+		Utility::IntUtils::ClearVector(m_segmentStage);
+	}
+}
+
+size_t SkeinMac::Finalize(std::vector<byte> &Output, size_t OutOffset)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("SkeinMac:Finalize", "The Mac has not been initialized!");
+	if (Output.size() - OutOffset < m_msgDigest->DigestSize())
+		throw CryptoMacException("SkeinMac:Finalize", "The Output buffer is too short!");
+
+	// the digest reset restores the keyed chaining value
+	return m_msgDigest->Finalize(Output, OutOffset);
+}
+
+void SkeinMac::Initialize(ISymmetricKey &KeyParams)
+{
+	if (KeyParams.KeySizes().KeySize() == 0)
+		throw CryptoMacException("SkeinMac:Initialize", "The key can not be zero length!");
+
+	switch (m_msgDigestType)
+	{
+		case Digests::Skein256:
+			static_cast<Digest::Skein256*>(m_msgDigest)->Initialize(KeyParams);
+			break;
+		case Digests::Skein512:
+			static_cast<Digest::Skein512*>(m_msgDigest)->Initialize(KeyParams);
+			break;
+		default:
+			static_cast<Digest::Skein1024*>(m_msgDigest)->Initialize(KeyParams);
+	}
+
+	m_isInitialized = true;
+}
+
+void SkeinMac::LoadState(const std::vector<byte> &State)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("SkeinMac:LoadState", "The Mac has not been initialized!");
+	if (State.size() < 2)
+		throw CryptoMacException("SkeinMac:LoadState", "The state array is too short!");
+	if (State[0] != STATE_VERSION)
+		throw CryptoMacException("SkeinMac:LoadState", "The state version is not supported!");
+	if (State[1] != static_cast<byte>(Macs::SkeinMac))
+		throw CryptoMacException("SkeinMac:LoadState", "The state was not created by this Mac!");
+
+	std::vector<byte> dgtState(State.size() - 2);
+	Utility::MemUtils::Copy(State, 2, dgtState, 0, dgtState.size());
+	m_msgDigest->LoadState(dgtState);
+}
+
+void SkeinMac::ParallelMaxDegree(size_t Degree)
+{
+	try
+	{
+		m_msgDigest->ParallelMaxDegree(Degree);
+	}
+	catch (...)
+	{
+		throw CryptoMacException("SkeinMac:ParallelMaxDegree", "The Degree value must be a non-zero even number less than the number of processor cores!");
+	}
+
+	// the digest state is rebuilt without the key
+	m_isInitialized = false;
+}
+
+void SkeinMac::Reset()
+{
+	m_msgDigest->Reset();
+	m_isInitialized = false;
+}
+
+std::vector<byte> SkeinMac::SaveState()
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("SkeinMac:SaveState", "The Mac has not been initialized!");
+
+	std::vector<byte> dgtState = m_msgDigest->SaveState();
+	IO::StreamWriter writer(2 + dgtState.size());
+
+	writer.Write(STATE_VERSION);
+	writer.Write(static_cast<byte>(Macs::SkeinMac));
+	writer.Write(dgtState, 0, dgtState.size());
+
+	return writer.GetBytes();
+}
+
+void SkeinMac::Update(byte Input)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("SkeinMac:Update", "The Mac has not been initialized!");
+
+	m_msgDigest->Update(Input);
+}
+
+void SkeinMac::Update(const std::vector<byte> &Input, size_t InOffset, size_t Length)
+{
+	if (!m_isInitialized)
+		throw CryptoMacException("SkeinMac:Update", "The Mac has not been initialized!");
+	if (InOffset + Length > Input.size())
+		throw CryptoMacException("SkeinMac:Update", "The Input buffer is too short!");
+
+	m_msgDigest->Update(Input, InOffset, Length);
+}
+
+void SkeinMac::UpdateSegments(const std::vector<MemorySegment> &Input)
+{
+	Utility::SegmentUtils::Update(this, Input, m_segmentStage);
+}
+
+//~~~Private Functions~~~//
+
+void SkeinMac::Scope()
+{
+	m_legalKeySizes.resize(3);
+	// minimum key size
+	m_legalKeySizes[0] = SymmetricKeySize(m_msgDigest->DigestSize() / 2, 0, 0);
+	// recommended size; the digest state size
+	m_legalKeySizes[1] = SymmetricKeySize(m_msgDigest->BlockSize(), 0, 0);
+	// keys longer than the state are compressed over several key blocks
+	m_legalKeySizes[2] = SymmetricKeySize(m_msgDigest->BlockSize() * 2, 0, 0);
+}
+
+NAMESPACE_MACEND
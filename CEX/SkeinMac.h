@@ -0,0 +1,292 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// An implementation of the Skein digests native keyed mode (Skein-MAC) as a Message Authentication Code generator.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_SKEINMAC_H
+#define CEX_SKEINMAC_H
+
+#include "Digests.h"
+#include "IDigest.h"
+#include "IMac.h"
+
+NAMESPACE_MAC
+
+using Enumeration::Digests;
+using Digest::IDigest;
+using Common::ParallelOptions;
+
+/// <summary>
+/// An implementation of the Skein-MAC Message Authentication Code generator
+/// </summary>
+///
+/// <example>
+/// <description>Generating a MAC code</description>
+/// <code>
+/// SkeinMac mac(Enumeration::Digests::Skein512);
+/// SymmetricKey kp(Key);
+/// mac.Initialize(kp);
+/// mac.Update(Input, 0, Input.size());
+/// mac.Finalize(Output, Offset);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description><B>Overview:</B></description>
+/// <para>Skein defines a keyed mode as part of its Unique Block Iteration (UBI) chaining; the key is compressed from a zero chaining value with a Key type UBI block, 
+/// and the result replaces the zero chaining value used to process the configuration block. \n
+/// The Mac is computed in a single pass over the message, and because the keyed chaining value is retained by the digest, re-keying between messages costs nothing.</para>
+///
+/// <description><B>Description:</B></description>
+/// <para><EM>Legend:</EM> \n
+/// <B>UBI</B>=unique block iteration, <B>C</B>=configuration block, <B>K</B>=key, <B>m</B>=message \n
+/// <EM>Generate</EM> \n
+/// K' = UBI(0, K, Tkey) \n
+/// G = UBI(UBI(K', C, Tcfg), m, Tmsg) \n
+/// SkeinMac(K,m) = Output(G)</para>
+///
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>The digest engine is the Skein256, Skein512, or Skein1024 digest, in sequential or parallel (tree hashing) mode.</description></item>
+/// <item><description>The key can be any non-zero length; a key equal to the digests state size is recommended.</description></item>
+/// <item><description>The Mac is not re-keyed after each Finalize call; the keyed chaining value is restored by the digest reset, so successive Mac codes can be computed with the same key.</description></item>
+/// <item><description>The Compute(Input, Output) method wraps the Update(Input, Offset, Length) and Finalize(Output, Offset) methods and should only be used on small to medium sized data.</description>/></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>The Skein Hash Function Family <a href="https://www.schneier.com/academic/paperfiles/skein1.3.pdf">Skein V1.1</a>; section 4.3 Skein-MAC.</description></item>
+/// <item><description>Skein <a href="https://www.schneier.com/academic/paperfiles/skein-proofs.pdf">Provable Security</a> Support for the Skein Hash Family.</description></item>
+/// </list>
+/// </remarks>
+class SkeinMac : public IMac
+{
+private:
+
+	static const std::string CLASS_NAME;
+	static const byte STATE_VERSION = 1;
+
+	IDigest* m_msgDigest;
+	bool m_destroyEngine;
+	bool m_isDestroyed;
+	bool m_isInitialized;
+	std::vector<SymmetricKeySize> m_legalKeySizes;
+	Digests m_msgDigestType;
+	std::vector<byte> m_segmentStage;
+
+public:
+
+	SkeinMac() = delete;
+	SkeinMac(const SkeinMac&) = delete;
+	SkeinMac& operator=(const SkeinMac&) = delete;
+	SkeinMac& operator=(SkeinMac&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The Digests internal blocksize in bytes
+	/// </summary>
+	const size_t BlockSize() override;
+
+	/// <summary>
+	/// Get: The message digest engine type
+	/// </summary>
+	const Digests DigestType();
+
+	/// <summary>
+	/// Get: Mac generators type name
+	/// </summary>
+	const Macs Enumeral() override;
+
+	/// <summary>
+	/// Get: Size of returned mac in bytes
+	/// </summary>
+	const size_t MacSize() override;
+
+	/// <summary>
+	/// Get: Mac is ready to digest data
+	/// </summary>
+	const bool IsInitialized() override;
+
+	/// <summary>
+	/// Get: Recommended Mac key sizes in a SymmetricKeySize array
+	/// </summary>
+	std::vector<SymmetricKeySize> LegalKeySizes() const override;
+
+	/// <summary>
+	/// Get: Processor parallelization availability.
+	/// <para>Indicates whether parallel processing is available on this system.
+	/// If parallel capable, input data array passed to the Update function must be ParallelBlockSize in bytes to trigger parallelization.</para>
+	/// </summary>
+	const bool IsParallel();
+
+	/// <summary>
+	/// Get: Mac generators class name
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Get: Parallel block size; the byte-size of the input data array passed to the Update function that triggers parallel processing.
+	/// <para>This value can be changed through the ParallelProfile class.<para>
+	/// </summary>
+	const size_t ParallelBlockSize();
+
+	/// <summary>
+	/// Get/Set: Contains parallel settings and SIMD capability flags in a ParallelOptions structure.
+	/// <para>The maximum number of threads allocated when using multi-threaded processing can be set with the ParallelMaxDegree(size_t) function.</para>
+	/// </summary>
+	ParallelOptions &ParallelProfile();
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Instantiate this class using the digest enumeration name
+	/// </summary>
+	///
+	/// <param name="DigestType">The Skein digest enumeration name; Skein256, Skein512, or Skein1024</param>
+	/// <param name="Parallel">Initialize the parallelized form of the message digest</param>
+	///
+	/// <exception cref="Exception::CryptoMacException">Thrown if the digest type is not a Skein digest</exception>
+	explicit SkeinMac(Digests DigestType, bool Parallel = false);
+
+	/// <summary>
+	/// Initialize the class with a Skein digest instance
+	/// </summary>
+	///
+	/// <param name="Digest">The Skein256, Skein512, or Skein1024 digest instance</param>
+	///
+	/// <exception cref="Exception::CryptoMacException">Thrown if the digest is null, or is not a Skein digest</exception>
+	explicit SkeinMac(IDigest* Digest);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~SkeinMac() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Process an input array and return the Mac code in the output array.
+	/// </summary>
+	///
+	/// <param name="Input">The input data byte array</param>
+	/// <param name="Output">The output Mac code array</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized</exception>
+	void Compute(const std::vector<byte> &Input, std::vector<byte> &Output) override;
+
+	/// <summary>
+	/// Release all resources associated with the object; optional, called by the finalizer
+	/// </summary>
+	void Destroy() override;
+
+	/// <summary>
+	/// Process the data and return a Mac code.
+	/// <para>The digest is reset to the keyed chaining value after the code is written, and is ready to process a new message.</para>
+	/// </summary>
+	///
+	/// <param name="Output">The output Mac code array</param>
+	/// <param name="OutOffset">The offset in the output array</param>
+	///
+	/// <returns>The number of bytes processed</returns>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized, or the Output array is too small</exception>
+	size_t Finalize(std::vector<byte> &Output, size_t OutOffset) override;
+
+	/// <summary>
+	/// Initialize the MAC generator with a SymmetricKey key container.
+	/// <para>The key can be any non-zero length; the digests state size is recommended. The Nonce and Info parameters are not used.</para>
+	/// </summary>
+	///
+	/// <param name="KeyParams">A SymmetricKey key container class</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the key is empty</exception>
+	void Initialize(ISymmetricKey &KeyParams) override;
+
+	/// <summary>
+	/// Restore the message state from a checkpoint created by the SaveState function.
+	/// <para>The Mac must be initialized with the same key and digest settings before the state is loaded.</para>
+	/// </summary>
+	///
+	/// <param name="State">The serialized Mac state</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized, or the state is malformed or was not created by this Mac</exception>
+	void LoadState(const std::vector<byte> &State) override;
+
+	/// <summary>
+	/// Set the number of threads allocated when using multi-threaded tree hashing processing.
+	/// <para>Thread count must be an even number, and not exceed the number of processor cores.
+	/// Changing this value will change the output Mac code; the digest state is rebuilt and the Mac must be re-initialized.</para>
+	/// </summary>
+	///
+	/// <param name="Degree">The desired number of threads</param>
+	///
+	/// <exception cref="Exception::CryptoMacException">Thrown if an invalid degree setting is used</exception>
+	void ParallelMaxDegree(size_t Degree);
+
+	/// <summary>
+	/// Reset to the default state; Mac must be re-initialized after this call
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Serialize the message state; the serialized state of the keyed digest.
+	/// <para>Key material is not written to the state.</para>
+	/// </summary>
+	///
+	/// <returns>The serialized Mac state</returns>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized</exception>
+	std::vector<byte> SaveState() override;
+
+	/// <summary>
+	/// Update the Mac with a single byte
+	/// </summary>
+	///
+	/// <param name="Input">Input byte to process</param>
+	void Update(byte Input) override;
+
+	/// <summary>
+	/// Update the Mac with a block of bytes
+	/// </summary>
+	///
+	/// <param name="Input">The input data array to process</param>
+	/// <param name="InOffset">Starting position with the input array</param>
+	/// <param name="Length">The length of data to process in bytes</param>
+	///
+	/// <exception cref="CryptoMacException">Thrown if the Mac is not initialized, or the Input array is too small</exception>
+	void Update(const std::vector<byte> &Input, size_t InOffset, size_t Length) override;
+
+	/// <summary>
+	/// Update the Mac with a message stored as a list of fragments
+	/// <para>The fragments are absorbed in list order as one contiguous message; a partial block is carried across each fragment boundary, so no fragment is copied.</para>
+	/// </summary>
+	/// 
+	/// <param name="Input">The list of message fragments</param>
+	void UpdateSegments(const std::vector<MemorySegment> &Input) override;
+
+private:
+
+	void Scope();
+};
+
+NAMESPACE_MACEND
+#endif
@@ -0,0 +1,327 @@
+#include "SphincsPlus.h"
+#include "IntUtils.h"
+#include "MemUtils.h"
+#include "PrngFromName.h"
+#include "SPXCore.h"
+
+NAMESPACE_SPHINCS
+
+const std::string SphincsPlus::CLASS_NAME = "SphincsPlus";
+
+//~~~Properties~~~//
+
+const AsymmetricEngines SphincsPlus::Enumeral()
+{
+	return AsymmetricEngines::SphincsPlus;
+}
+
+const bool SphincsPlus::IsInitialized()
+{
+	return m_isInitialized;
+}
+
+const bool SphincsPlus::IsSigner()
+{
+	return m_isSigner;
+}
+
+const std::string SphincsPlus::Name()
+{
+	std::string name = CLASS_NAME;
+
+	if (m_spxParameters == SPXParams::SHA2S128)
+	{
+		name += "-SHA2S128";
+	}
+	else if (m_spxParameters == SPXParams::SHA2F128)
+	{
+		name += "-SHA2F128";
+	}
+	else if (m_spxParameters == SPXParams::SHA2S192)
+	{
+		name += "-SHA2S192";
+	}
+	else if (m_spxParameters == SPXParams::SHA2F192)
+	{
+		name += "-SHA2F192";
+	}
+	else if (m_spxParameters == SPXParams::SHA2S256)
+	{
+		name += "-SHA2S256";
+	}
+	else if (m_spxParameters == SPXParams::SHA2F256)
+	{
+		name += "-SHA2F256";
+	}
+	else if (m_spxParameters == SPXParams::SHAKES128)
+	{
+		name += "-SHAKES128";
+	}
+	else if (m_spxParameters == SPXParams::SHAKEF128)
+	{
+		name += "-SHAKEF128";
+	}
+	else if (m_spxParameters == SPXParams::SHAKES192)
+	{
+		name += "-SHAKES192";
+	}
+	else if (m_spxParameters == SPXParams::SHAKEF192)
+	{
+		name += "-SHAKEF192";
+	}
+	else if (m_spxParameters == SPXParams::SHAKES256)
+	{
+		name += "-SHAKES256";
+	}
+	else if (m_spxParameters == SPXParams::SHAKEF256)
+	{
+		name += "-SHAKEF256";
+	}
+
+	return name;
+}
+
+const SPXParamSet &SphincsPlus::ParamSet()
+{
+	return m_paramSet;
+}
+
+const SPXParams SphincsPlus::Parameters()
+{
+	return m_spxParameters;
+}
+
+const size_t SphincsPlus::SignatureSize()
+{
+	return m_paramSet.SignatureSize;
+}
+
+std::vector<byte> &SphincsPlus::Tag()
+{
+	return m_keyTag;
+}
+
+//~~~Constructor~~~//
+
+SphincsPlus::SphincsPlus(SPXParams Parameters, Prngs PrngType, bool Parallel)
+	:
+	m_destroyEngine(true),
+	m_isDestroyed(false),
+	m_isInitialized(false),
+	m_isParallel(Parallel),
+	m_isSigner(false),
+	m_keyTag(0),
+	m_paramSet(),
+	m_rndGenerator(Helper::PrngFromName::GetInstance(PrngType)),
+	m_spxParameters(Parameters)
+{
+	if (m_spxParameters == SPXParams::None)
+	{
+		throw CryptoAsymmetricException("SphincsPlus:CTor", "The parameter set is invalid!");
+	}
+
+	Scope();
+}
+
+SphincsPlus::SphincsPlus(SPXParams Parameters, IPrng* Prng, bool Parallel)
+	:
+	m_destroyEngine(false),
+	m_isDestroyed(false),
+	m_isInitialized(false),
+	m_isParallel(Parallel),
+	m_isSigner(false),
+	m_keyTag(0),
+	m_paramSet(),
+	m_rndGenerator(Prng),
+	m_spxParameters(Parameters)
+{
+	if (m_spxParameters == SPXParams::None)
+	{
+		throw CryptoAsymmetricException("SphincsPlus:CTor", "The parameter set is invalid!");
+	}
+	if (m_rndGenerator == nullptr)
+	{
+		throw CryptoAsymmetricException("SphincsPlus:CTor", "The prng can not be null!");
+	}
+
+	Scope();
+}
+
+SphincsPlus::~SphincsPlus()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void SphincsPlus::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		m_isInitialized = false;
+		m_isParallel = false;
+		m_isSigner = false;
+		m_paramSet.Reset();
+		m_spxParameters = SPXParams::None;
+		Utility::IntUtils::ClearVector(m_keyTag);
+
+		// release keys
+		Reset();
+
+		if (m_destroyEngine)
+		{
+			// destroy internally generated objects
+			m_rndGenerator.reset(nullptr);
+			m_destroyEngine = false;
+		}
+		else
+		{
+			// release the external rng (received through ctor2) back to caller
+			m_rndGenerator.release();
+		}
+	}
+}
+
+IAsymmetricKeyPair* SphincsPlus::Generate()
+{
+	CexAssert(m_spxParameters != SPXParams::None, "The parameter setting is invalid");
+
+	std::vector<byte> pk(m_paramSet.PublicKeySize);
+	std::vector<byte> sk(m_paramSet.PrivateKeySize);
+
+	SPXCore::Generate(pk, sk, m_rndGenerator, m_paramSet, m_isParallel);
+
+	Key::Asymmetric::SPXPublicKey* pubK = new Key::Asymmetric::SPXPublicKey(m_spxParameters, pk);
+	Key::Asymmetric::SPXPrivateKey* priK = new Key::Asymmetric::SPXPrivateKey(m_spxParameters, sk);
+	Utility::IntUtils::ClearVector(sk);
+
+	return new Key::Asymmetric::SPXKeyPair(priK, pubK, m_keyTag);
+}
+
+const void SphincsPlus::Initialize(IAsymmetricKey &AsymmetricKey)
+{
+	if (AsymmetricKey.CipherType() != AsymmetricEngines::SphincsPlus)
+	{
+		throw CryptoAsymmetricException("SphincsPlus:Initialize", "The key is not a SphincsPlus key!");
+	}
+
+	Reset();
+
+	SPXPrivateKey* priK = dynamic_cast<SPXPrivateKey*>(&AsymmetricKey);
+
+	if (priK != nullptr)
+	{
+		if (priK->Parameters() != m_spxParameters || priK->S().size() != m_paramSet.PrivateKeySize)
+		{
+			throw CryptoAsymmetricException("SphincsPlus:Initialize", "The private key does not match the parameter set!");
+		}
+
+		m_privateKey = std::unique_ptr<SPXPrivateKey>(priK);
+		m_isSigner = true;
+	}
+	else
+	{
+		SPXPublicKey* pubK = dynamic_cast<SPXPublicKey*>(&AsymmetricKey);
+
+		if (pubK == nullptr || pubK->Parameters() != m_spxParameters || pubK->P().size() != m_paramSet.PublicKeySize)
+		{
+			throw CryptoAsymmetricException("SphincsPlus:Initialize", "The public key does not match the parameter set!");
+		}
+
+		m_publicKey = std::unique_ptr<SPXPublicKey>(pubK);
+		m_isSigner = false;
+	}
+
+	m_isInitialized = true;
+}
+
+void SphincsPlus::Reset()
+{
+	// the keys are owned by the caller
+	if (m_privateKey != nullptr)
+	{
+		m_privateKey.release();
+	}
+	if (m_publicKey != nullptr)
+	{
+		m_publicKey.release();
+	}
+
+	m_isInitialized = false;
+	m_isSigner = false;
+}
+
+void SphincsPlus::Sign(IByteStream &InputStream, size_t InOffset, size_t Length, std::vector<byte> &Output, size_t OutOffset)
+{
+	std::vector<byte> msg(Length);
+
+	InputStream.Seek(InOffset, IO::SeekOrigin::Begin);
+
+	if (InputStream.Read(msg, 0, Length) != Length)
+	{
+		throw CryptoAsymmetricException("SphincsPlus:Sign", "The input stream is too short!");
+	}
+
+	Sign(msg, 0, Length, Output, OutOffset);
+}
+
+void SphincsPlus::Sign(std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<byte> &Output, size_t OutOffset)
+{
+	if (!m_isInitialized || !m_isSigner)
+	{
+		throw CryptoAsymmetricException("SphincsPlus:Sign", "The signature scheme must be initialized with a private key!");
+	}
+
+	CexAssert(Input.size() - InOffset >= Length, "The input array is too small");
+
+	std::vector<byte> sig(m_paramSet.SignatureSize);
+	SPXCore::Sign(sig, Input, InOffset, Length, m_privateKey->S(), m_rndGenerator, m_paramSet, m_isParallel);
+
+	if (Output.size() < OutOffset + sig.size())
+	{
+		Output.resize(OutOffset + sig.size());
+	}
+
+	Utility::MemUtils::Copy(sig, 0, Output, OutOffset, sig.size());
+}
+
+bool SphincsPlus::Verify(IByteStream &InputStream, size_t InOffset, size_t Length, std::vector<byte> &Code)
+{
+	std::vector<byte> msg(Length);
+
+	InputStream.Seek(InOffset, IO::SeekOrigin::Begin);
+
+	if (InputStream.Read(msg, 0, Length) != Length)
+	{
+		return false;
+	}
+
+	return Verify(msg, 0, Length, Code);
+}
+
+bool SphincsPlus::Verify(std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<byte> &Code)
+{
+	if (!m_isInitialized || m_isSigner)
+	{
+		throw CryptoAsymmetricException("SphincsPlus:Verify", "The signature scheme must be initialized with a public key!");
+	}
+
+	CexAssert(Input.size() - InOffset >= Length, "The input array is too small");
+
+	if (Code.size() != m_paramSet.SignatureSize)
+	{
+		return false;
+	}
+
+	return SPXCore::Verify(Code, Input, InOffset, Length, m_publicKey->P(), m_paramSet);
+}
+
+//~~~Private Functions~~~//
+
+void SphincsPlus::Scope()
+{
+	SPXCore::GetParamSet(m_paramSet, m_spxParameters);
+}
+
+NAMESPACE_SPHINCSEND
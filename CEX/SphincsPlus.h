@@ -0,0 +1,278 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef CEX_SPHINCSPLUS_H
+#define CEX_SPHINCSPLUS_H
+
+#include "CexDomain.h"
+#include "IAsymmetricSign.h"
+#include "IPrng.h"
+#include "Prngs.h"
+#include "SPXKeyPair.h"
+#include "SPXParams.h"
+#include "SPXParamSet.h"
+#include "SPXPrivateKey.h"
+#include "SPXPublicKey.h"
+
+NAMESPACE_SPHINCS
+
+using Prng::IPrng;
+using Enumeration::Prngs;
+using Key::Asymmetric::SPXKeyPair;
+using Enumeration::SPXParams;
+using Key::Asymmetric::SPXPrivateKey;
+using Key::Asymmetric::SPXPublicKey;
+
+/// <summary>
+/// An implementation of the SPHINCS+ stateless hash based signature scheme
+/// </summary>
+///
+/// <example>
+/// <description>Key generation:</description>
+/// <code>
+/// SphincsPlus sgn(SPXParams::SHAKEF128, [PrngType], [Parallel]);
+/// IAsymmetricKeyPair* kp = sgn.Generate();
+/// // serialize the public key
+/// SPXPublicKey* pubK = (SPXPublicKey*)kp->PublicKey();
+/// std:vector&lt;byte&gt; skey = pubK->ToBytes();
+/// </code>
+///
+/// <description>Signing:</description>
+/// <code>
+/// SphincsPlus sgn(SPXParams::SHAKEF128);
+/// sgn.Initialize(*kp->PrivateKey());
+/// std:vector&lt;byte&gt; sig(0);
+/// sgn.Sign(msg, 0, msg.size(), sig, 0);
+/// </code>
+///
+/// <description>Verification:</description>
+/// <code>
+/// SphincsPlus sgn(SPXParams::SHAKEF128);
+/// sgn.Initialize(*kp->PublicKey());
+/// bool valid = sgn.Verify(msg, 0, msg.size(), sig);
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <para>SPHINCS+ signs with a FORS few-time signature on a leaf of a hypertree of XMSS trees, each layer signing the root of the layer below with WOTS+ one-time signatures.
+/// Security rests only on the hash function; the private key holds no state between signatures.</para>
+///
+/// <para>The tweakable hash calls that do not depend on each other (WOTS+ chains, tree leaves, the nodes on one level of a tree) are collected and hashed together,
+/// 8 lanes at a time with a transposed SHA2-256 compression on AVX2, or 4 lanes at a time with the interleaved Keccak permutation. \n
+/// When the Parallel flag is set, the FORS trees and the XMSS trees of a signature, and the leaves of the key generation tree, are split across the processor cores.</para>
+///
+/// <list type="bullet">
+/// <item><description>The scheme follows FIPS 205 (SLH-DSA) in pure mode with an empty context string; signatures are hedged with random bytes from the Prng</description></item>
+/// <item><description>All twelve FIPS 205 parameter sets are supported; the SHA2 192 and 256 bit sets hash the tree nodes, the FORS and WOTS+ public keys, and the message with SHA2-512</description></item>
+/// <item><description>The Prng is set through the constructor, as either a prng type-name (default BCR-AES256), which instantiates the function internally, or a pointer to a perisitant external instance of a Prng</description></item>
+/// <item><description>The signature is written to the output array at the offset; the array is resized if it is too small</description></item>
+/// </list>
+///
+/// <description>Guiding Publications:</description>
+/// <list type="number">
+/// <item><description>FIPS 205: <a href="https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.205.pdf">Stateless Hash-Based Digital Signature Standard</a>.</description></item>
+/// <item><description>The <a href="https://sphincs.org/data/sphincs+-r3.1-specification.pdf">SPHINCS+</a> submission to the NIST post-quantum project.</description></item>
+/// </list>
+/// </remarks>
+class SphincsPlus final : public IAsymmetricSign
+{
+private:
+
+	static const std::string CLASS_NAME;
+
+	bool m_destroyEngine;
+	bool m_isDestroyed;
+	bool m_isInitialized;
+	bool m_isParallel;
+	bool m_isSigner;
+	std::vector<byte> m_keyTag;
+	SPXParamSet m_paramSet;
+	std::unique_ptr<SPXPrivateKey> m_privateKey;
+	std::unique_ptr<SPXPublicKey> m_publicKey;
+	std::unique_ptr<IPrng> m_rndGenerator;
+	SPXParams m_spxParameters;
+
+public:
+
+	SphincsPlus() = delete;
+	SphincsPlus(const SphincsPlus&) = delete;
+	SphincsPlus& operator=(const SphincsPlus&) = delete;
+	SphincsPlus& operator=(SphincsPlus&&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The signature schemes type-name
+	/// </summary>
+	const AsymmetricEngines Enumeral() override;
+
+	/// <summary>
+	/// Get: The signature scheme has been initialized with a key
+	/// </summary>
+	const bool IsInitialized() override;
+
+	/// <summary>
+	/// Get: This class is initialized for Signing with the Private key
+	/// </summary>
+	const bool IsSigner() override;
+
+	/// <summary>
+	/// Get: The signature scheme and parameter-set formal names
+	/// </summary>
+	const std::string Name() override;
+
+	/// <summary>
+	/// Get: The signature schemes initialization parameters
+	/// </summary>
+	const SPXParamSet &ParamSet();
+
+	/// <summary>
+	/// Get: The signature schemes parameters enumeration name
+	/// </summary>
+	const SPXParams Parameters();
+
+	/// <summary>
+	/// Get: The byte size of a signature
+	/// </summary>
+	const size_t SignatureSize();
+
+	/// <summary>
+	/// Get/Set: A new asymmetric key-pairs optional identification tag.
+	/// <para>Setting this value must be done before the Generate method is called.</para>
+	/// </summary>
+	std::vector<byte> &Tag();
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Instantiate the signature scheme with an auto-initialized prng
+	/// </summary>
+	///
+	/// <param name="Parameters">The parameter set enumeration name</param>
+	/// <param name="PrngType">The seed prng function type; the default is the BCR generator</param>
+	/// <param name="Parallel">Key generation and signing are multi-threaded</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if an invalid parameter set is specified</exception>
+	explicit SphincsPlus(SPXParams Parameters, Prngs PrngType = Prngs::BCR, bool Parallel = false);
+
+	/// <summary>
+	/// Instantiate this class using an external Prng instance
+	/// </summary>
+	///
+	/// <param name="Parameters">The parameter set enumeration name</param>
+	/// <param name="Prng">A pointer to the seed Prng function</param>
+	/// <param name="Parallel">Key generation and signing are multi-threaded</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if an invalid parameter set is specified, or the prng is null</exception>
+	SphincsPlus(SPXParams Parameters, IPrng* Prng, bool Parallel = false);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~SphincsPlus() override;
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Release all resources associated with the object
+	/// </summary>
+	void Destroy();
+
+	/// <summary>
+	/// Generate a public/private key-pair
+	/// </summary>
+	///
+	/// <returns>A public/private key pair</returns>
+	IAsymmetricKeyPair* Generate();
+
+	/// <summary>
+	/// Initialize the signature scheme for signing (private key) or verifying (public key)
+	/// </summary>
+	///
+	/// <param name="AsymmetricKey">The SPXPrivateKey (signing) or SPXPublicKey (verifying)</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the key is not a SPHINCS+ key, or was created with a different parameter set</exception>
+	const void Initialize(IAsymmetricKey &AsymmetricKey) override;
+
+	/// <summary>
+	/// Reset the underlying engine
+	/// </summary>
+	void Reset() override;
+
+	/// <summary>
+	/// Generate a signature for an input stream
+	/// </summary>
+	///
+	/// <param name="InputStream">The stream containing the data to process</param>
+	/// <param name="InOffset">The starting position within the input strean</param>
+	/// <param name="Length">The number of bytes to process</param>
+	/// <param name="Output">The output array receiving the signature code</param>
+	/// <param name="OutOffset">The starting position within the output array</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the scheme is not initialized for signing</exception>
+	void Sign(IByteStream &InputStream, size_t InOffset, size_t Length, std::vector<byte> &Output, size_t OutOffset) override;
+
+	/// <summary>
+	/// Generate a signature for a message
+	/// </summary>
+	///
+	/// <param name="Input">The byte array containing the data to process</param>
+	/// <param name="InOffset">The starting position within the input array</param>
+	/// <param name="Length">The number of bytes to process</param>
+	/// <param name="Output">The output array receiving the signature code</param>
+	/// <param name="OutOffset">The starting position within the output array</param>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the scheme is not initialized for signing</exception>
+	void Sign(std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<byte> &Output, size_t OutOffset) override;
+
+	/// <summary>
+	/// Verify the signature of an input stream
+	/// </summary>
+	///
+	/// <param name="InputStream">The stream containing the data to test</param>
+	/// <param name="InOffset">The starting offset within the input stream</param>
+	/// <param name="Length">The number of bytes to process</param>
+	/// <param name="Code">The array containing the signature</param>
+	///
+	/// <returns>Returns true if the signature is valid</returns>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the scheme is not initialized for verification</exception>
+	bool Verify(IByteStream &InputStream, size_t InOffset, size_t Length, std::vector<byte> &Code) override;
+
+	/// <summary>
+	/// Verify the signature of a message
+	/// </summary>
+	///
+	/// <param name="Input">The byte array containing the data to test</param>
+	/// <param name="InOffset">The starting offset within the input array</param>
+	/// <param name="Length">The number of bytes to process</param>
+	/// <param name="Code">The array containing the signature</param>
+	///
+	/// <returns>Returns true if the signature is valid</returns>
+	///
+	/// <exception cref="Exception::CryptoAsymmetricException">Thrown if the scheme is not initialized for verification</exception>
+	bool Verify(std::vector<byte> &Input, size_t InOffset, size_t Length, std::vector<byte> &Code) override;
+
+private:
+
+	void Scope();
+};
+
+NAMESPACE_SPHINCSEND
+#endif
@@ -0,0 +1,166 @@
+#include "StreamExecutor.h"
+#include "ParallelUtils.h"
+
+NAMESPACE_PROCESSING
+
+const std::string StreamExecutor::CLASS_NAME("StreamExecutor");
+
+//~~~Properties~~~//
+
+const std::string StreamExecutor::Name()
+{
+	return CLASS_NAME;
+}
+
+size_t StreamExecutor::Pending()
+{
+	std::lock_guard<std::mutex> lock(m_queueMutex);
+	return m_jobCount;
+}
+
+size_t StreamExecutor::Workers()
+{
+	return m_workerThreads.size();
+}
+
+//~~~Constructor~~~//
+
+StreamExecutor::StreamExecutor(size_t Workers)
+	:
+	m_isDestroyed(false),
+	m_isStopping(false),
+	m_jobCount(0),
+	m_queueMutex(),
+	m_queueSignal(),
+	m_runQueue(),
+	m_workerThreads(0)
+{
+	size_t thdCount = (Workers != 0) ? Workers : Utility::ParallelUtils::ProcessorCount();
+
+	if (thdCount == 0)
+		thdCount = 1;
+
+	m_workerThreads.reserve(thdCount);
+
+	for (size_t i = 0; i < thdCount; ++i)
+		m_workerThreads.push_back(std::thread(&StreamExecutor::Worker, this));
+}
+
+StreamExecutor::~StreamExecutor()
+{
+	Destroy();
+}
+
+//~~~Public Functions~~~//
+
+void StreamExecutor::Destroy()
+{
+	if (!m_isDestroyed)
+	{
+		m_isDestroyed = true;
+		std::deque<std::shared_ptr<JobState>> rmdJobs;
+
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			m_isStopping = true;
+			rmdJobs.swap(m_runQueue);
+		}
+
+		m_queueSignal.notify_all();
+
+		for (size_t i = 0; i < rmdJobs.size(); ++i)
+		{
+			rmdJobs[i]->Abort(std::make_exception_ptr(CryptoProcessingException("StreamExecutor:Destroy", "The executor was destroyed before the job completed!")));
+			Complete();
+		}
+
+		for (size_t i = 0; i < m_workerThreads.size(); ++i)
+		{
+			if (m_workerThreads[i].joinable())
+				m_workerThreads[i].join();
+		}
+
+		m_workerThreads.clear();
+	}
+}
+
+//~~~Private Functions~~~//
+
+void StreamExecutor::Complete()
+{
+	std::lock_guard<std::mutex> lock(m_queueMutex);
+	--m_jobCount;
+}
+
+void StreamExecutor::Enqueue(const std::shared_ptr<JobState> &Job)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+
+		if (m_isStopping)
+			throw CryptoProcessingException("StreamExecutor:Submit", "The executor has been destroyed!");
+
+		++m_jobCount;
+		m_runQueue.push_back(Job);
+	}
+
+	m_queueSignal.notify_one();
+}
+
+void StreamExecutor::Worker()
+{
+	while (true)
+	{
+		std::shared_ptr<JobState> job;
+
+		{
+			std::unique_lock<std::mutex> lock(m_queueMutex);
+			m_queueSignal.wait(lock, [this]() { return m_isStopping || !m_runQueue.empty(); });
+
+			if (m_runQueue.empty())
+				break;
+
+			job = m_runQueue.front();
+			m_runQueue.pop_front();
+		}
+
+		bool hasWork = false;
+
+		if (job->IsCancelled())
+		{
+			job->Abort(std::make_exception_ptr(CryptoProcessingException("StreamExecutor:Worker", "The job was cancelled!")));
+		}
+		else
+		{
+			try
+			{
+				hasWork = job->Step();
+			}
+			catch (...)
+			{
+				job->Abort(std::current_exception());
+			}
+		}
+
+		if (hasWork)
+		{
+			std::unique_lock<std::mutex> lock(m_queueMutex);
+
+			if (!m_isStopping)
+			{
+				// round-robin; the job waits behind every other pending job for its next step
+				m_runQueue.push_back(job);
+				lock.unlock();
+				m_queueSignal.notify_one();
+				continue;
+			}
+
+			lock.unlock();
+			job->Abort(std::make_exception_ptr(CryptoProcessingException("StreamExecutor:Worker", "The executor was destroyed before the job completed!")));
+		}
+
+		Complete();
+	}
+}
+
+NAMESPACE_PROCESSINGEND
@@ -0,0 +1,153 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// A fixed worker pool that multiplexes stream jobs with round-robin scheduling.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_STREAMEXECUTOR_H
+#define CEX_STREAMEXECUTOR_H
+
+#include "CexDomain.h"
+#include "CryptoProcessingException.h"
+#include "StreamJob.h"
+#include <deque>
+#include <thread>
+
+NAMESPACE_PROCESSING
+
+using Exception::CryptoProcessingException;
+
+/// <summary>
+/// A shared executor for asynchronous CipherStream, DigestStream and MacStream jobs.
+/// <para>Runs any number of concurrent stream jobs on a fixed pool of worker threads; each job returns a StreamJob future, with cancellation and an awaitable progress counter.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Hash a set of files concurrently:</description>
+/// <code>
+/// StreamExecutor executor;
+/// std::vector&lt;StreamJob&lt;std::vector&lt;byte&gt;&gt;&gt; jobs;
+///
+/// for (size_t i = 0; i &lt; files.size(); ++i)
+///		jobs.push_back(digests[i]-&gt;ComputeAsync(files[i], executor));
+///
+/// for (size_t i = 0; i &lt; jobs.size(); ++i)
+///		hashes[i] = jobs[i].Get();
+/// </code>
+/// </example>
+///
+/// <remarks>
+/// <description>Implementation Notes:</description>
+/// <list type="bullet">
+/// <item><description>A job does not own a thread; it is a step function that processes a bounded slice of its stream each time it runs.
+/// The executor keeps a single run queue; a worker takes the job at the head of the queue, runs one step, and returns the job to the tail of the queue, so every pending job receives a step in turn, and a large file can not starve the small files queued behind it.</description></item>
+/// <item><description>Cancel() on a job is honored before its next step; the jobs future then throws a CryptoProcessingException. Exceptions thrown by a job step are stored in the future.</description></item>
+/// <item><description>The stream objects and the streams passed to an asynchronous call must remain valid, and must not be used by the caller, until the job is complete.</description></item>
+/// <item><description>Destroying the executor cancels the jobs that are still queued, and waits for the steps that are running.</description></item>
+/// <item><description>A job using a multi-threaded cipher or digest runs its parallel blocks on that engines own threads; for many small streams, the sequential engines make better use of the workers.</description></item>
+/// </list>
+/// </remarks>
+class StreamExecutor
+{
+private:
+
+	static const std::string CLASS_NAME;
+
+	bool m_isDestroyed;
+	bool m_isStopping;
+	size_t m_jobCount;
+	std::mutex m_queueMutex;
+	std::condition_variable m_queueSignal;
+	std::deque<std::shared_ptr<JobState>> m_runQueue;
+	std::vector<std::thread> m_workerThreads;
+
+public:
+
+	StreamExecutor(const StreamExecutor&) = delete;
+	StreamExecutor& operator=(const StreamExecutor&) = delete;
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The executors class name
+	/// </summary>
+	const std::string Name();
+
+	/// <summary>
+	/// Get: The number of submitted jobs that have not completed
+	/// </summary>
+	size_t Pending();
+
+	/// <summary>
+	/// Get: The number of worker threads
+	/// </summary>
+	size_t Workers();
+
+	//~~~Constructor~~~//
+
+	/// <summary>
+	/// Initialize the executor and start the worker threads
+	/// </summary>
+	///
+	/// <param name="Workers">The number of worker threads; the default of zero uses the processor count</param>
+	explicit StreamExecutor(size_t Workers = 0);
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	~StreamExecutor();
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Cancel the queued jobs, wait for the running steps, and stop the worker threads; optional, called by the finalizer
+	/// </summary>
+	void Destroy();
+
+	/// <summary>
+	/// Submit a job step function to the executor.
+	/// <para>The step is called repeatedly on the worker threads, and must return false once it has written the jobs result.
+	/// Each call should process a bounded amount of work, so that other jobs are not delayed.</para>
+	/// </summary>
+	///
+	/// <param name="Step">The job step function</param>
+	///
+	/// <returns>The job handle</returns>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the executor has been destroyed</exception>
+	template <typename T>
+	StreamJob<T> Submit(const std::function<bool(JobState &, T &)> &Step)
+	{
+		std::shared_ptr<JobTask<T>> task = std::make_shared<JobTask<T>>(Step);
+		StreamJob<T> job(task);
+		Enqueue(task);
+
+		return job;
+	}
+
+private:
+
+	void Complete();
+	void Enqueue(const std::shared_ptr<JobState> &Job);
+	void Worker();
+};
+
+NAMESPACE_PROCESSINGEND
+#endif
@@ -0,0 +1,363 @@
+// The GPL version 3 License (GPLv3)
+//
+// Copyright (c) 2017 vtdev.com
+// This file is part of the CEX Cryptographic library.
+//
+// This program is free software : you can redistribute it and / or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Implementation Details:
+// The job state and future handle for stream jobs run by a StreamExecutor.
+// Contact: develop@vtdev.com
+
+#ifndef CEX_STREAMJOB_H
+#define CEX_STREAMJOB_H
+
+#include "CexDomain.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+
+NAMESPACE_PROCESSING
+
+/// <summary>
+/// The scheduling state of a stream job; the executor runs the job one step at a time through this interface.
+/// <para>The state also carries the jobs cancellation flag and progress, and is passed to the job step so it can report progress.</para>
+/// </summary>
+class JobState
+{
+private:
+
+	std::atomic<bool> m_isCancelled;
+	bool m_isComplete;
+	std::atomic<int> m_progressPercent;
+	std::mutex m_stateMutex;
+	std::condition_variable m_stateSignal;
+
+public:
+
+	JobState(const JobState&) = delete;
+	JobState& operator=(const JobState&) = delete;
+
+	/// <summary>
+	/// Initialize the job state
+	/// </summary>
+	JobState()
+		:
+		m_isCancelled(false),
+		m_isComplete(false),
+		m_progressPercent(0),
+		m_stateMutex(),
+		m_stateSignal()
+	{
+	}
+
+	/// <summary>
+	/// Finalize objects
+	/// </summary>
+	virtual ~JobState()
+	{
+	}
+
+	/// <summary>
+	/// Get: Cancellation of the job has been requested
+	/// </summary>
+	bool IsCancelled()
+	{
+		return m_isCancelled.load();
+	}
+
+	/// <summary>
+	/// Get: The job has finished; completed, failed, or cancelled
+	/// </summary>
+	bool IsComplete()
+	{
+		std::lock_guard<std::mutex> lock(m_stateMutex);
+		return m_isComplete;
+	}
+
+	/// <summary>
+	/// Get: The last reported progress percentage
+	/// </summary>
+	int Progress()
+	{
+		return m_progressPercent.load();
+	}
+
+	/// <summary>
+	/// Request cancellation; the job is abandoned before its next step is run
+	/// </summary>
+	void Cancel()
+	{
+		m_isCancelled.store(true);
+	}
+
+	/// <summary>
+	/// Report the jobs progress; waiters are woken when the percentage changes
+	/// </summary>
+	///
+	/// <param name="Processed">The number of bytes processed</param>
+	/// <param name="Length">The total number of bytes in the job</param>
+	void Report(ulong Processed, ulong Length)
+	{
+		const int PCTVAL = (Length == 0 || Processed >= Length) ? 100 : static_cast<int>((100 * Processed) / Length);
+
+		if (PCTVAL != m_progressPercent.load())
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_stateMutex);
+				m_progressPercent.store(PCTVAL);
+			}
+			m_stateSignal.notify_all();
+		}
+	}
+
+	/// <summary>
+	/// Wait until the progress percentage is greater than a previously seen value, or the job is complete
+	/// </summary>
+	///
+	/// <param name="Percent">The last progress value seen by the caller; -1 to wait for the first report</param>
+	///
+	/// <returns>The current progress percentage</returns>
+	int WaitProgress(int Percent)
+	{
+		std::unique_lock<std::mutex> lock(m_stateMutex);
+		m_stateSignal.wait(lock, [this, Percent]() { return m_isComplete || m_progressPercent.load() > Percent; });
+
+		return m_progressPercent.load();
+	}
+
+	/// <summary>
+	/// Run the next step of the job
+	/// </summary>
+	///
+	/// <returns>Returns true if the job has more work, false if the result has been set</returns>
+	virtual bool Step() = 0;
+
+	/// <summary>
+	/// End the job with an exception; the exception is rethrown by the jobs future
+	/// </summary>
+	///
+	/// <param name="Error">The exception to store in the future</param>
+	virtual void Abort(std::exception_ptr Error) = 0;
+
+protected:
+
+	void Finish()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_stateMutex);
+			m_isComplete = true;
+		}
+		m_stateSignal.notify_all();
+	}
+};
+
+/// <summary>
+/// A stream job with a typed result.
+/// <para>The step function is called repeatedly by the executor; each call processes a bounded amount of the stream, and returns false after it has written the jobs result.</para>
+/// </summary>
+///
+/// <typeparam name="T">The result type of the job</typeparam>
+template <typename T>
+class JobTask : public JobState
+{
+private:
+
+	std::promise<T> m_jobResult;
+	std::function<bool(JobState &, T &)> m_jobStep;
+	T m_jobValue;
+
+public:
+
+	/// <summary>
+	/// Initialize the task with its step function
+	/// </summary>
+	///
+	/// <param name="Step">The step function; returns true while the job has more work</param>
+	explicit JobTask(const std::function<bool(JobState &, T &)> &Step)
+		:
+		JobState(),
+		m_jobResult(),
+		m_jobStep(Step),
+		m_jobValue()
+	{
+	}
+
+	/// <summary>
+	/// Get: The jobs future
+	/// </summary>
+	std::shared_future<T> Future()
+	{
+		return m_jobResult.get_future().share();
+	}
+
+	void Abort(std::exception_ptr Error) override
+	{
+		m_jobStep = nullptr;
+		Finish();
+		m_jobResult.set_exception(Error);
+	}
+
+	bool Step() override
+	{
+		if (m_jobStep(*this, m_jobValue))
+			return true;
+
+		m_jobStep = nullptr;
+		Report(1, 1);
+		Finish();
+		m_jobResult.set_value(std::move(m_jobValue));
+
+		return false;
+	}
+};
+
+/// <summary>
+/// The handle to a job submitted to a StreamExecutor.
+/// <para>Wraps the jobs future, and exposes cancellation and an awaitable progress counter.</para>
+/// </summary>
+///
+/// <example>
+/// <description>Wait on a jobs progress and result:</description>
+/// <code>
+/// StreamJob&lt;std::vector&lt;byte&gt;&gt; job = ds.ComputeAsync(&amp;inpFile, executor);
+/// int pct = -1;
+///
+/// while (!job.IsComplete())
+/// {
+///		pct = job.WaitProgress(pct);
+///		// report pct..
+/// }
+///
+/// std::vector&lt;byte&gt; hash = job.Get();
+/// </code>
+/// </example>
+///
+/// <typeparam name="T">The result type of the job</typeparam>
+template <typename T>
+class StreamJob
+{
+private:
+
+	std::shared_future<T> m_jobFuture;
+	std::shared_ptr<JobTask<T>> m_jobTask;
+
+public:
+
+	/// <summary>
+	/// Initialize an empty job handle
+	/// </summary>
+	StreamJob()
+		:
+		m_jobFuture(),
+		m_jobTask()
+	{
+	}
+
+	/// <summary>
+	/// Initialize the handle with a job task
+	/// </summary>
+	///
+	/// <param name="Task">The shared job task</param>
+	explicit StreamJob(const std::shared_ptr<JobTask<T>> &Task)
+		:
+		m_jobFuture(Task->Future()),
+		m_jobTask(Task)
+	{
+	}
+
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: Cancellation of the job has been requested
+	/// </summary>
+	bool IsCancelled()
+	{
+		return m_jobTask->IsCancelled();
+	}
+
+	/// <summary>
+	/// Get: The job has finished; completed, failed, or cancelled
+	/// </summary>
+	bool IsComplete()
+	{
+		return m_jobTask->IsComplete();
+	}
+
+	/// <summary>
+	/// Get: The last reported progress percentage
+	/// </summary>
+	int Progress()
+	{
+		return m_jobTask->Progress();
+	}
+
+	/// <summary>
+	/// Get: The jobs shared future
+	/// </summary>
+	std::shared_future<T> Result()
+	{
+		return m_jobFuture;
+	}
+
+	//~~~Public Functions~~~//
+
+	/// <summary>
+	/// Request cancellation of the job; a cancelled job throws CryptoProcessingException from Get()
+	/// </summary>
+	void Cancel()
+	{
+		m_jobTask->Cancel();
+	}
+
+	/// <summary>
+	/// Wait for the job to complete and return its result
+	/// </summary>
+	///
+	/// <returns>The job result</returns>
+	///
+	/// <exception cref="Exception::CryptoProcessingException">Thrown if the job was cancelled; an exception thrown by the job is rethrown</exception>
+	T Get()
+	{
+		return m_jobFuture.get();
+	}
+
+	/// <summary>
+	/// Wait for the job to complete
+	/// </summary>
+	void Wait()
+	{
+		m_jobFuture.wait();
+	}
+
+	/// <summary>
+	/// Wait until the progress percentage is greater than a previously seen value, or the job is complete
+	/// </summary>
+	///
+	/// <param name="Percent">The last progress value seen by the caller; -1 to wait for the first report</param>
+	///
+	/// <returns>The current progress percentage</returns>
+	int WaitProgress(int Percent)
+	{
+		return m_jobTask->WaitProgress(Percent);
+	}
+};
+
+NAMESPACE_PROCESSINGEND
+#endif
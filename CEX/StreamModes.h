@@ -25,7 +25,11 @@ enum class StreamModes : byte
 	/// <summary>
 	/// A SecureStream class, provides streaming encrytped memory storage
 	/// </summary>
-	SecureStream = 4
+	SecureStream = 4,
+	/// <summary>
+	/// An AsyncFileStream class, provides asynchronous queued file access
+	/// </summary>
+	AsyncFileStream = 8
 };
 
 NAMESPACE_ENUMERATIONEND
@@ -64,6 +64,23 @@ public:
 	/// <param name="Length">The number of bytes to read</param>
 	std::vector<byte> ReadBytes(size_t Length);
 
+	/// <summary>
+	/// Reads T sized elements from the stream into an integer array
+	/// </summary>
+	///
+	/// <param name="Output">The destination integer array</param>
+	/// <param name="OutOffset">The starting offset within the destination array</param>
+	/// <param name="Elements">The number of T sized elements to read</param>
+	template <typename T>
+	void Read(std::vector<T> &Output, size_t OutOffset, size_t Elements)
+	{
+		const size_t OTPSZE = sizeof(T) * Elements;
+		CexAssert(m_streamData.Position() + OTPSZE <= m_streamData.Length(), "Stream length exceeded");
+		CexAssert(OutOffset + Elements <= Output.size(), "Output length exceeded");
+		Utility::MemUtils::Copy(m_streamData.ToArray(), m_streamData.Position(), Output, OutOffset, OTPSZE);
+		m_streamData.Seek(m_streamData.Position() + OTPSZE, SeekOrigin::Begin);
+	}
+
 	/// <summary>
 	/// Reads a T integer from the stream
 	/// </summary>
@@ -77,6 +77,42 @@ SymmetricKey::SymmetricKey(const std::vector<byte> &Key, const std::vector<byte>
 		throw CryptoProcessingException("SymmetricKey:Ctor", "The key, nonce, and info can not all be be zero sized!");
 }
 
+SymmetricKey::SymmetricKey(std::vector<byte> &&Key)
+	:
+	m_info(0),
+	m_isDestroyed(false),
+	m_key(std::move(Key)),
+	m_keySizes(m_key.size(), 0, 0),
+	m_nonce(0)
+{
+	if (m_key.size() == 0)
+		throw CryptoProcessingException("SymmetricKey:Ctor", "The key can not be zero sized!");
+}
+
+SymmetricKey::SymmetricKey(std::vector<byte> &&Key, std::vector<byte> &&Nonce)
+	:
+	m_info(0),
+	m_isDestroyed(false),
+	m_key(std::move(Key)),
+	m_keySizes(m_key.size(), Nonce.size(), 0),
+	m_nonce(std::move(Nonce))
+{
+	if (m_key.size() == 0 && m_nonce.size() == 0)
+		throw CryptoProcessingException("SymmetricKey:Ctor", "The key and nonce can not both be be zero sized!");
+}
+
+SymmetricKey::SymmetricKey(std::vector<byte> &&Key, std::vector<byte> &&Nonce, std::vector<byte> &&Info)
+	:
+	m_info(std::move(Info)),
+	m_isDestroyed(false),
+	m_key(std::move(Key)),
+	m_keySizes(m_key.size(), Nonce.size(), m_info.size()),
+	m_nonce(std::move(Nonce))
+{
+	if (m_key.size() == 0 && m_nonce.size() == 0 && m_info.size() == 0)
+		throw CryptoProcessingException("SymmetricKey:Ctor", "The key, nonce, and info can not all be be zero sized!");
+}
+
 SymmetricKey::~SymmetricKey()
 {
 	Destroy();
@@ -126,14 +162,16 @@ SymmetricKey* SymmetricKey::DeSerialize(const MemoryStream &KeyStream)
 
 bool SymmetricKey::Equals(ISymmetricKey &Input)
 {
-	return (Input.Key() == Key() && Input.Nonce() == Nonce() && Input.Info() == Info());
+	SymmetricKeyView inpView(Input);
+
+	return (inpView.Key() == m_key && inpView.Nonce() == m_nonce && inpView.Info() == m_info);
 }
 
 MemoryStream* SymmetricKey::Serialize(SymmetricKey &KeyObj)
 {
-	size_t kLen = KeyObj.Key().size();
-	size_t nLen = KeyObj.Nonce().size();
-	size_t iLen = KeyObj.Info().size();
+	size_t kLen = KeyObj.m_key.size();
+	size_t nLen = KeyObj.m_nonce.size();
+	size_t iLen = KeyObj.m_info.size();
 	size_t tLen = 6 + kLen + nLen + iLen;
 
 	IO::StreamWriter writer(tLen);
@@ -142,11 +180,11 @@ MemoryStream* SymmetricKey::Serialize(SymmetricKey &KeyObj)
 	writer.Write(static_cast<ushort>(iLen));
 
 	if (kLen != 0)
-		writer.Write(KeyObj.Key(), 0, kLen);
+		writer.Write(KeyObj.m_key, 0, kLen);
 	if (nLen != 0)
-		writer.Write(KeyObj.Nonce(), 0, nLen);
+		writer.Write(KeyObj.m_nonce, 0, nLen);
 	if (iLen != 0)
-		writer.Write(KeyObj.Info(), 0, iLen);
+		writer.Write(KeyObj.m_info, 0, iLen);
 
 	IO::MemoryStream* strm = writer.GetStream();
 	strm->Seek(0, IO::SeekOrigin::Begin);
@@ -154,4 +192,30 @@ MemoryStream* SymmetricKey::Serialize(SymmetricKey &KeyObj)
 	return strm;
 }
 
+//~~~Protected Functions~~~//
+
+const std::vector<byte> &SymmetricKey::BorrowInfo()
+{
+	return m_info;
+}
+
+const std::vector<byte> &SymmetricKey::BorrowKey()
+{
+	return m_key;
+}
+
+const std::vector<byte> &SymmetricKey::BorrowNonce()
+{
+	return m_nonce;
+}
+
+void SymmetricKey::Lock()
+{
+	// the key is stored in plaintext; a view borrows the arrays directly
+}
+
+void SymmetricKey::Unlock()
+{
+}
+
 NAMESPACE_SYMMETRICKEYEND
\ No newline at end of file
@@ -74,6 +74,30 @@ public:
 	/// <param name="Info">The personalization string or additional keying material</param>
 	explicit SymmetricKey(const std::vector<byte> &Key, const std::vector<byte> &Nonce, const std::vector<byte> &Info);
 
+	/// <summary>
+	/// Instantiate this class by moving the callers key array into the container
+	/// </summary>
+	///
+	/// <param name="Key">The primary encryption key; the array is moved, and is empty on return</param>
+	explicit SymmetricKey(std::vector<byte> &&Key);
+
+	/// <summary>
+	/// Instantiate this class by moving the callers key and nonce arrays into the container
+	/// </summary>
+	///
+	/// <param name="Key">The primary encryption key; the array is moved, and is empty on return</param>
+	/// <param name="Nonce">The nonce or counter array; the array is moved, and is empty on return</param>
+	explicit SymmetricKey(std::vector<byte> &&Key, std::vector<byte> &&Nonce);
+
+	/// <summary>
+	/// Instantiate this class by moving the callers key, nonce, and info arrays into the container
+	/// </summary>
+	///
+	/// <param name="Key">The primary encryption key; the array is moved, and is empty on return</param>
+	/// <param name="Nonce">The nonce or counter array; the array is moved, and is empty on return</param>
+	/// <param name="Info">The personalization string or additional keying material; the array is moved, and is empty on return</param>
+	explicit SymmetricKey(std::vector<byte> &&Key, std::vector<byte> &&Nonce, std::vector<byte> &&Info);
+
 	/// <summary>
 	/// Finalize objects
 	/// </summary>
@@ -119,6 +143,14 @@ public:
 	/// 
 	/// <returns>A stream containing the SymmetricKey data</returns>
 	static MemoryStream* Serialize(SymmetricKey &KeyObj);
+
+protected:
+
+	const std::vector<byte> &BorrowInfo() override;
+	const std::vector<byte> &BorrowKey() override;
+	const std::vector<byte> &BorrowNonce() override;
+	void Lock() override;
+	void Unlock() override;
 };
 
 NAMESPACE_SYMMETRICKEYEND
@@ -1,22 +1,57 @@
 #include "SymmetricKeyGenerator.h"
 #include "CSP.h"
 #include "DigestFromName.h"
+#include "DrbgFromName.h"
 #include "HMAC.h"
 #include "IntUtils.h"
 #include "ProviderFromName.h"
+#include "SysUtils.h"
 
 NAMESPACE_SYMMETRICKEY
 
+//~~~Properties~~~//
+
+const Drbgs SymmetricKeyGenerator::GeneratorType()
+{
+	return m_drbgType;
+}
+
+const bool SymmetricKeyGenerator::IsBulkMode()
+{
+	return (m_drbgType != Drbgs::None);
+}
+
+size_t &SymmetricKeyGenerator::ReseedThreshold()
+{
+	return m_reseedThreshold;
+}
+
+ulong &SymmetricKeyGenerator::ReseedTimeout()
+{
+	return m_reseedTimeout;
+}
+
 //~~~Constructor~~~//
 
-SymmetricKeyGenerator::SymmetricKeyGenerator(Digests DigestType, Providers ProviderType)
+SymmetricKeyGenerator::SymmetricKeyGenerator(Digests DigestType, Providers ProviderType, Drbgs GeneratorType)
 	:
 	m_dgtType(DigestType),
+	m_drbgEngine(0),
+	m_drbgState(0),
+	m_drbgType(GeneratorType),
 	m_isDestroyed(false),
+	m_macEngine(0),
+	m_macState(0),
+	m_pvdType(ProviderType),
 	m_pvdEngine(0),
-	m_pvdType(ProviderType)
+	m_reseedCounter(0),
+	m_reseedThreshold(DEF_RESEED),
+	m_reseedTime(0),
+	m_reseedTimeout(DEF_TIMEOUT),
+	m_seedLength(0),
+	m_stateOffset(0)
 {
-	// initialize the provider
+	// initialize the provider, and the bulk mode engines
 	Reset();
 }
 
@@ -33,13 +68,62 @@ void SymmetricKeyGenerator::Destroy()
 	{
 		m_isDestroyed = true;
 		m_dgtType = Digests::None;
+		m_drbgType = Drbgs::None;
 		m_pvdType = Providers::None;
+		m_reseedCounter = 0;
+		m_reseedThreshold = 0;
+		m_reseedTime = 0;
+		m_reseedTimeout = 0;
+		m_seedLength = 0;
+		m_stateOffset = 0;
 
+		if (m_drbgEngine != 0)
+			delete m_drbgEngine;
+		if (m_macEngine != 0)
+			delete m_macEngine;
 		if (m_pvdEngine != 0)
 			delete m_pvdEngine;
+
+		Utility::IntUtils::ClearVector(m_drbgState);
+		Utility::IntUtils::ClearVector(m_macState);
 	}
 }
 
+std::vector<SymmetricKey> SymmetricKeyGenerator::Generate(size_t Count, SymmetricKeySize KeySize)
+{
+	if (Count == 0)
+		throw CryptoGeneratorException("SymmetricKeyGenerator::Generate", "The key count can not be zero!");
+	if (KeySize.KeySize() == 0)
+		throw CryptoGeneratorException("SymmetricKeyGenerator::Generate", "The key size can not be zero!");
+
+	const size_t KEYLEN = KeySize.KeySize() + KeySize.NonceSize() + KeySize.InfoSize();
+	std::vector<byte> keyMtl(Count * KEYLEN);
+	std::vector<byte> key(KeySize.KeySize());
+	std::vector<byte> nonce(KeySize.NonceSize());
+	std::vector<byte> info(KeySize.InfoSize());
+	std::vector<SymmetricKey> keys;
+	keys.reserve(Count);
+
+	// generate the keying material for the whole batch in one pass
+	Generate(keyMtl, 0, keyMtl.size());
+
+	for (size_t i = 0; i < Count; ++i)
+	{
+		const size_t KEYOFF = i * KEYLEN;
+		Utility::MemUtils::Copy(keyMtl, KEYOFF, key, 0, key.size());
+		Utility::MemUtils::Copy(keyMtl, KEYOFF + key.size(), nonce, 0, nonce.size());
+		Utility::MemUtils::Copy(keyMtl, KEYOFF + key.size() + nonce.size(), info, 0, info.size());
+		keys.emplace_back(key, nonce, info);
+	}
+
+	Utility::IntUtils::ClearVector(keyMtl);
+	Utility::IntUtils::ClearVector(key);
+	Utility::IntUtils::ClearVector(nonce);
+	Utility::IntUtils::ClearVector(info);
+
+	return keys;
+}
+
 SymmetricKey SymmetricKeyGenerator::GetSymmetricKey(SymmetricKeySize KeySize)
 {
 	if (KeySize.KeySize() == 0)
@@ -86,8 +170,7 @@ SymmetricSecureKey SymmetricKeyGenerator::GetSecureKey(SymmetricKeySize KeySize)
 
 void SymmetricKeyGenerator::GetBytes(std::vector<byte> &Output)
 {
-	std::vector<byte> rnd = Generate(Output.size());
-	Utility::MemUtils::Copy(rnd, 0, Output, 0, rnd.size());
+	Generate(Output, 0, Output.size());
 }
 
 std::vector<byte> SymmetricKeyGenerator::GetBytes(size_t Size)
@@ -111,6 +194,33 @@ void SymmetricKeyGenerator::Reset()
 	// if provider is unavailable, default to system crypto provider
 	if (m_pvdEngine == 0 || !m_pvdEngine->IsAvailable())
 		m_pvdEngine = Helper::ProviderFromName::GetInstance(Providers::CSP);
+
+	if (m_drbgType != Drbgs::None)
+	{
+		if (m_drbgEngine != 0)
+			delete m_drbgEngine;
+		if (m_macEngine != 0)
+			delete m_macEngine;
+
+		try
+		{
+			m_drbgEngine = Helper::DrbgFromName::GetInstance(m_drbgType, m_dgtType, m_pvdEngine->Enumeral());
+			m_macEngine = new Mac::HMAC(m_dgtType);
+		}
+		catch (const std::exception &ex)
+		{
+			throw CryptoGeneratorException("SymmetricKeyGenerator::Reset", "The bulk mode generator could not be created!", std::string(ex.what()));
+		}
+
+		// seed size is a mac input block less finalizer padding
+		m_seedLength = Helper::DigestFromName::GetBlockSize(m_dgtType) - Helper::DigestFromName::GetPaddingSize(m_dgtType);
+		// the drbg state holds a run of seeds, and is refilled with a single request when exhausted
+		const size_t STATELEN = Utility::IntUtils::Min(m_seedLength * BULK_BLOCKS, m_drbgEngine->MaxRequestSize());
+		m_drbgState.resize(STATELEN - (STATELEN % m_seedLength));
+		m_macState.resize(m_macEngine->MacSize());
+
+		Reseed();
+	}
 }
 
 //~~~Private Functions~~~//
@@ -121,22 +231,30 @@ std::vector<byte> SymmetricKeyGenerator::Generate(size_t KeySize)
 		return std::vector<byte>(0);
 
 	std::vector<byte> key(KeySize);
-	size_t keyLen = KeySize;
-	size_t blkOff = 0;
-
-	do
-	{
-		std::vector<byte> rnd = GenerateBlock();
-		size_t alnLen = Utility::IntUtils::Min(keyLen, rnd.size());
-		Utility::MemUtils::Copy(rnd, 0, key, blkOff, alnLen);
-		keyLen -= alnLen;
-		blkOff += alnLen;
-	} 
-	while (keyLen != 0);
+	Generate(key, 0, key.size());
 
 	return key;
 }
 
+void SymmetricKeyGenerator::Generate(std::vector<byte> &Output, size_t Offset, size_t Length)
+{
+	if (m_drbgType != Drbgs::None)
+	{
+		GenerateBulk(Output, Offset, Length);
+	}
+	else
+	{
+		while (Length != 0)
+		{
+			std::vector<byte> rnd = GenerateBlock();
+			const size_t RMDSZE = Utility::IntUtils::Min(Length, rnd.size());
+			Utility::MemUtils::Copy(rnd, 0, Output, Offset, RMDSZE);
+			Length -= RMDSZE;
+			Offset += RMDSZE;
+		}
+	}
+}
+
 std::vector<byte> SymmetricKeyGenerator::GenerateBlock()
 {
 	// seed size is 2x mac input block size less finalizer padding
@@ -162,4 +280,89 @@ std::vector<byte> SymmetricKeyGenerator::GenerateBlock()
 	return output;
 }
 
+void SymmetricKeyGenerator::GenerateBulk(std::vector<byte> &Output, size_t Offset, size_t Length)
+{
+	const size_t MACSZE = m_macEngine->MacSize();
+
+	while (Length != 0)
+	{
+		if (m_stateOffset == m_drbgState.size())
+		{
+			// check the reseed policy once per state refill
+			const ulong ELAPSED = (Utility::SysUtils::TimeCurrentNS() - m_reseedTime) / 1000000;
+
+			if ((m_reseedThreshold != 0 && m_reseedCounter >= m_reseedThreshold) || (m_reseedTimeout != 0 && ELAPSED >= m_reseedTimeout))
+				Reseed();
+
+			// refill the seed state with a single drbg request
+			m_drbgEngine->Generate(m_drbgState, 0, m_drbgState.size());
+			m_stateOffset = 0;
+		}
+
+		// condition a block of drbg output with the keyed hmac
+		m_macEngine->Update(m_drbgState, m_stateOffset, m_seedLength);
+		m_stateOffset += m_seedLength;
+		const size_t RMDSZE = Utility::IntUtils::Min(MACSZE, Length);
+
+		if (RMDSZE == MACSZE)
+		{
+			m_macEngine->Finalize(Output, Offset);
+		}
+		else
+		{
+			m_macEngine->Finalize(m_macState, 0);
+			Utility::MemUtils::Copy(m_macState, 0, Output, Offset, RMDSZE);
+		}
+
+		m_reseedCounter += RMDSZE;
+		Length -= RMDSZE;
+		Offset += RMDSZE;
+	}
+}
+
+void SymmetricKeyGenerator::Reseed()
+{
+	// seed the drbg with the recommended key, nonce, and info sizes drawn from the entropy provider
+	SymmetricKeySize seedSize = m_drbgEngine->LegalKeySizes()[1];
+	std::vector<byte> seed(seedSize.KeySize());
+	std::vector<byte> nonce(seedSize.NonceSize());
+	std::vector<byte> info(seedSize.InfoSize());
+	m_pvdEngine->GetBytes(seed);
+
+	if (nonce.size() != 0)
+	{
+		m_pvdEngine->GetBytes(nonce);
+
+		if (info.size() != 0)
+		{
+			m_pvdEngine->GetBytes(info);
+			m_drbgEngine->Initialize(seed, nonce, info);
+		}
+		else
+		{
+			m_drbgEngine->Initialize(seed, nonce);
+		}
+	}
+	else
+	{
+		m_drbgEngine->Initialize(seed);
+	}
+
+	// re-key the conditioning hmac from the entropy provider
+	std::vector<byte> key(m_macEngine->BlockSize());
+	m_pvdEngine->GetBytes(key);
+	SymmetricKey kp(key);
+	m_macEngine->Initialize(kp);
+
+	Utility::IntUtils::ClearVector(seed);
+	Utility::IntUtils::ClearVector(nonce);
+	Utility::IntUtils::ClearVector(info);
+	Utility::IntUtils::ClearVector(key);
+
+	// force a state refill on the next request
+	m_stateOffset = m_drbgState.size();
+	m_reseedCounter = 0;
+	m_reseedTime = Utility::SysUtils::TimeCurrentNS();
+}
+
 NAMESPACE_SYMMETRICKEYEND
\ No newline at end of file
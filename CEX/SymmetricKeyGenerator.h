@@ -4,6 +4,9 @@
 #include "CexDomain.h"
 #include "CryptoGeneratorException.h"
 #include "Digests.h"
+#include "Drbgs.h"
+#include "IDrbg.h"
+#include "IMac.h"
 #include "IProvider.h"
 #include "Providers.h"
 #include "SymmetricKey.h"
@@ -14,6 +17,7 @@ NAMESPACE_SYMMETRICKEY
 
 using Exception::CryptoGeneratorException;
 using Enumeration::Digests;
+using Enumeration::Drbgs;
 using Enumeration::Providers;
 
 /// <summary>
@@ -33,12 +37,28 @@ using Enumeration::Providers;
 /// </code>
 /// </example>
 /// 
+/// <example>
+/// <description>Generate a batch of keys in bulk mode:</description>
+/// <code>
+/// // seed an HCG once from the provider, condition output with a persistent HMAC
+/// SymmetricKeyGenerator gen(Digests::SHA512, Providers::CSP, Drbgs::HCG);
+/// // reseed after 1MB of output, or after one minute
+/// gen.ReseedThreshold() = 1024 * 1024;
+/// gen.ReseedTimeout() = 60000;
+/// std::vector<SymmetricKey> keys = gen.Generate(1000, SymmetricKeySize(32, 16, 0));
+/// </code>
+/// </example>
+/// 
 /// <remarks>
 /// <description>Implementation Notes:</description>
 /// <list type="bullet">
 /// <item><description>Seed provider can be any of the <see cref="Enumeration::Providers"/> generators.</description></item>
 /// <item><description>Hash can be any of the <see cref="Enumeration::Digests"/> digests.</description></item>
 /// <item><description>Default Prng is CSP, default digest is SHA512.</description></item>
+/// <item><description>In the default mode, every digest-sized block is produced by a new provider seed and a freshly keyed HMAC.</description></item>
+/// <item><description>Setting the GeneratorType to a Drbgs member enables bulk mode; the Drbg is seeded once by the provider, and its output is conditioned by a persistent HMAC.</description></item>
+/// <item><description>In bulk mode the Drbg is reseeded and the HMAC re-keyed when either the ReseedThreshold (bytes) or the ReseedTimeout (milliseconds) has been exceeded.</description></item>
+/// <item><description>The Generate(Count, KeySize) function draws the keying material for a batch of keys in one pass.</description></item>
 /// </list>
 /// </remarks>
 class SymmetricKeyGenerator
@@ -48,23 +68,69 @@ private:
 	SymmetricKeyGenerator& operator=(const SymmetricKeyGenerator&) = delete;
 	SymmetricKeyGenerator& operator=(SymmetricKeyGenerator&&) = delete;
 
+	// the number of seed blocks drawn from the drbg per request in bulk mode
+	static const size_t BULK_BLOCKS = 64;
+	// the default reseed threshold in bulk mode; 1MB
+	static const size_t DEF_RESEED = 1024 * 1024;
+	// the default reseed interval in bulk mode; one minute
+	static const ulong DEF_TIMEOUT = 60000;
+
 	Digests m_dgtType;
+	Drbg::IDrbg* m_drbgEngine;
+	std::vector<byte> m_drbgState;
+	Drbgs m_drbgType;
 	bool m_isDestroyed;
+	Mac::IMac* m_macEngine;
+	std::vector<byte> m_macState;
 	Providers m_pvdType;
 	Provider::IProvider* m_pvdEngine;
+	size_t m_reseedCounter;
+	size_t m_reseedThreshold;
+	ulong m_reseedTime;
+	ulong m_reseedTimeout;
+	size_t m_seedLength;
+	size_t m_stateOffset;
 
 public:
 
+	//~~~Properties~~~//
+
+	/// <summary>
+	/// Get: The Drbg used to generate seed material in bulk mode; None if bulk mode is not enabled
+	/// </summary>
+	const Drbgs GeneratorType();
+
+	/// <summary>
+	/// Get: Bulk mode is enabled; seed material is drawn from a Drbg, and conditioned by a persistent HMAC instance
+	/// </summary>
+	const bool IsBulkMode();
+
+	/// <summary>
+	/// Get/Set: The number of bytes generated in bulk mode that triggers a reseed of the Drbg and a re-key of the HMAC.
+	/// <para>The default is 1MB, a value of zero disables the byte threshold.</para>
+	/// </summary>
+	size_t &ReseedThreshold();
+
+	/// <summary>
+	/// Get/Set: The interval in milliseconds after which the Drbg is reseeded and the HMAC re-keyed in bulk mode.
+	/// <para>The default is 60 seconds, a value of zero disables the time threshold.</para>
+	/// </summary>
+	ulong &ReseedTimeout();
+
 	//~~~Constructor~~~//
 
 	/// <summary>
 	/// Instantiate this class.
-	/// <para>Select provider and digest type generator options, or take the defaults</para>
+	/// <para>Select provider and digest type generator options, or take the defaults.
+	/// Set the GeneratorType to a Drbg type name to enable bulk mode.</para>
 	/// </summary>
 	/// 
 	/// <param name="DigestType">The hash function used to power an hmac used to condition output keying material</param>
 	/// <param name="ProviderType">The entropy provider that supplies the seed material for the key compression cycle</param>
-	explicit SymmetricKeyGenerator(Digests DigestType = Digests::SHA512, Providers ProviderType = Enumeration::Providers::CSP);
+	/// <param name="GeneratorType">The Drbg that generates the seed material in bulk mode; the default is None, which disables bulk mode</param>
+	/// 
+	/// <exception cref="Exception::CryptoGeneratorException">Thrown if the Drbg type is not supported</exception>
+	explicit SymmetricKeyGenerator(Digests DigestType = Digests::SHA512, Providers ProviderType = Enumeration::Providers::CSP, Drbgs GeneratorType = Drbgs::None);
 
 	/// <summary>
 	/// Destructor
@@ -78,6 +144,19 @@ public:
 	/// </summary>
 	void Destroy();
 
+	/// <summary>
+	/// Generate a batch of populated SymmetricKey classes.
+	/// <para>The keying material for the entire batch is generated in a single pass; this is most efficient in bulk mode.</para>
+	/// </summary>
+	/// 
+	/// <param name="Count">The number of keys to generate</param>
+	/// <param name="KeySize">The key, nonce and info sizes in bytes of each key</param>
+	/// 
+	/// <returns>A vector of populated SymmetricKey classes</returns>
+	/// 
+	/// <exception cref="Exception::CryptoGeneratorException">Thrown if the count or the key size is zero</exception>
+	std::vector<SymmetricKey> Generate(size_t Count, SymmetricKeySize KeySize);
+
 	/// <summary>
 	/// Create a populated SymmetricKey class
 	/// </summary>
@@ -120,7 +199,10 @@ public:
 private:
 
 	std::vector<byte> Generate(size_t KeySize);
+	void Generate(std::vector<byte> &Output, size_t Offset, size_t Length);
 	std::vector<byte> GenerateBlock();
+	void GenerateBulk(std::vector<byte> &Output, size_t Offset, size_t Length);
+	void Reseed();
 };
 
 NAMESPACE_SYMMETRICKEYEND
@@ -34,19 +34,29 @@ const std::vector<byte> SymmetricSecureKey::Nonce()
 
 SymmetricSecureKey::SymmetricSecureKey()
 	:
+	m_infoView(0),
 	m_isDestroyed(false),
 	m_keySalt(0),
 	m_keySizes(0, 0, 0),
-	m_keyState(0)
+	m_keyState(0),
+	m_keyView(0),
+	m_mtxLock(),
+	m_nonceView(0),
+	m_unlockCount(0)
 {
 }
 
 SymmetricSecureKey::SymmetricSecureKey(const std::vector<byte> &Key, ulong KeySalt)
 	:
+	m_infoView(0),
 	m_isDestroyed(false),
 	m_keySizes(Key.size(), 0, 0),
 	m_keySalt(0),
-	m_keyState(0)
+	m_keyState(0),
+	m_keyView(0),
+	m_mtxLock(),
+	m_nonceView(0),
+	m_unlockCount(0)
 {
 	if (Key.size() == 0)
 		throw CryptoProcessingException("SymmetricSecureKey:Ctor", "The key can not be zero sized!");
@@ -65,10 +75,15 @@ SymmetricSecureKey::SymmetricSecureKey(const std::vector<byte> &Key, ulong KeySa
 
 SymmetricSecureKey::SymmetricSecureKey(const std::vector<byte> &Key, const std::vector<byte> &Nonce, ulong KeySalt)
 	:
+	m_infoView(0),
 	m_isDestroyed(false),
 	m_keySalt(0),
 	m_keySizes(Key.size(), Nonce.size(), 0),
-	m_keyState(0)
+	m_keyState(0),
+	m_keyView(0),
+	m_mtxLock(),
+	m_nonceView(0),
+	m_unlockCount(0)
 {
 	if (Key.size() == 0 || Nonce.size() == 0)
 		throw CryptoProcessingException("SymmetricSecureKey:Ctor", "The key and nonce can not be zero sized!");
@@ -88,10 +103,15 @@ SymmetricSecureKey::SymmetricSecureKey(const std::vector<byte> &Key, const std::
 
 SymmetricSecureKey::SymmetricSecureKey(const std::vector<byte> &Key, const std::vector<byte> &Nonce, const std::vector<byte> &Info, ulong KeySalt)
 	:
+	m_infoView(0),
 	m_isDestroyed(false),
 	m_keySalt(0),
 	m_keySizes(Key.size(), Nonce.size(), Info.size()),
-	m_keyState(0)
+	m_keyState(0),
+	m_keyView(0),
+	m_mtxLock(),
+	m_nonceView(0),
+	m_unlockCount(0)
 {
 	if (Key.size() == 0 || Nonce.size() == 0 || Info.size() == 0)
 		throw CryptoProcessingException("SymmetricSecureKey:Ctor", "The key, nonce, and info can not be zero sized!");
@@ -110,24 +130,131 @@ SymmetricSecureKey::SymmetricSecureKey(const std::vector<byte> &Key, const std::
 	Transform();
 }
 
+SymmetricSecureKey::SymmetricSecureKey(const SymmetricSecureKey &Other)
+	:
+	m_infoView(0),
+	m_isDestroyed(false),
+	m_keySalt(0),
+	m_keySizes(0, 0, 0),
+	m_keyState(0),
+	m_keyView(0),
+	m_mtxLock(),
+	m_nonceView(0),
+	m_unlockCount(0)
+{
+	std::lock_guard<std::mutex> lock(Other.m_mtxLock);
+
+	m_keySalt = Other.m_keySalt;
+	m_keySizes = Other.m_keySizes;
+	m_keyState = Other.m_keyState;
+}
+
+SymmetricSecureKey::SymmetricSecureKey(SymmetricSecureKey &&Other)
+	:
+	m_infoView(0),
+	m_isDestroyed(false),
+	m_keySalt(0),
+	m_keySizes(0, 0, 0),
+	m_keyState(0),
+	m_keyView(0),
+	m_mtxLock(),
+	m_nonceView(0),
+	m_unlockCount(0)
+{
+	std::lock_guard<std::mutex> lock(Other.m_mtxLock);
+
+	CexAssert(Other.m_unlockCount == 0, "the key can not be moved while a view is open");
+
+	m_keySalt = std::move(Other.m_keySalt);
+	m_keySizes = Other.m_keySizes;
+	m_keyState = std::move(Other.m_keyState);
+	Other.m_isDestroyed = true;
+	Other.m_keySizes = SymmetricKeySize(0, 0, 0);
+}
+
 SymmetricSecureKey::~SymmetricSecureKey()
 {
 	Destroy();
 }
 
+//~~~Operators~~~//
+
+SymmetricSecureKey &SymmetricSecureKey::operator=(const SymmetricSecureKey &Other)
+{
+	if (this != &Other)
+	{
+		std::unique_lock<std::mutex> lockA(m_mtxLock, std::defer_lock);
+		std::unique_lock<std::mutex> lockB(Other.m_mtxLock, std::defer_lock);
+		std::lock(lockA, lockB);
+
+		CexAssert(m_unlockCount == 0, "the key can not be assigned while a view is open");
+
+		Utility::IntUtils::ClearVector(m_infoView);
+		Utility::IntUtils::ClearVector(m_keyView);
+		Utility::IntUtils::ClearVector(m_nonceView);
+		m_isDestroyed = false;
+		m_keySalt = Other.m_keySalt;
+		m_keySizes = Other.m_keySizes;
+		m_keyState = Other.m_keyState;
+		m_unlockCount = 0;
+	}
+
+	return *this;
+}
+
+SymmetricSecureKey &SymmetricSecureKey::operator=(SymmetricSecureKey &&Other)
+{
+	if (this != &Other)
+	{
+		std::unique_lock<std::mutex> lockA(m_mtxLock, std::defer_lock);
+		std::unique_lock<std::mutex> lockB(Other.m_mtxLock, std::defer_lock);
+		std::lock(lockA, lockB);
+
+		CexAssert(m_unlockCount == 0, "the key can not be assigned while a view is open");
+		CexAssert(Other.m_unlockCount == 0, "the key can not be moved while a view is open");
+
+		Utility::IntUtils::ClearVector(m_infoView);
+		Utility::IntUtils::ClearVector(m_keyView);
+		Utility::IntUtils::ClearVector(m_nonceView);
+		Utility::IntUtils::ClearVector(m_keySalt);
+		Utility::IntUtils::ClearVector(m_keyState);
+		m_isDestroyed = false;
+		m_keySalt = std::move(Other.m_keySalt);
+		m_keySizes = Other.m_keySizes;
+		m_keyState = std::move(Other.m_keyState);
+		m_unlockCount = 0;
+		Other.m_isDestroyed = true;
+		Other.m_keySizes = SymmetricKeySize(0, 0, 0);
+	}
+
+	return *this;
+}
+
 //~~~Public Functions~~~//
 
 SymmetricSecureKey* SymmetricSecureKey::Clone()
 {
-	return new SymmetricSecureKey(Key(), Nonce(), Info());
+	SymmetricKeyView keyView(*this);
+
+	return new SymmetricSecureKey(keyView.Key(), keyView.Nonce(), keyView.Info());
 }
 
 void SymmetricSecureKey::Destroy()
 {
+	std::lock_guard<std::mutex> lock(m_mtxLock);
+
+	// destroying the key under an open view would leave the view reading cleared memory
+	CexAssert(m_unlockCount == 0, "the key can not be destroyed while a view is open");
+
 	if (!m_isDestroyed)
 	{
 		m_isDestroyed = true;
 
+		m_unlockCount = 0;
+		Utility::IntUtils::ClearVector(m_infoView);
+		Utility::IntUtils::ClearVector(m_keyView);
+		Utility::IntUtils::ClearVector(m_nonceView);
+
 		if (m_keyState.size() > 0)
 			Utility::IntUtils::ClearVector(m_keyState);
 		if (m_keySalt.size() > 0)
@@ -157,14 +284,19 @@ SymmetricSecureKey* SymmetricSecureKey::DeSerialize(MemoryStream &KeyStream)
 
 bool SymmetricSecureKey::Equals(ISymmetricKey &Input)
 {
-	return (Input.Key() == Key() && Input.Nonce() == Nonce() && Input.Info() == Info());
+	SymmetricKeyView inpView(Input);
+	SymmetricKeyView keyView(*this);
+
+	return (inpView.Key() == keyView.Key() && inpView.Nonce() == keyView.Nonce() && inpView.Info() == keyView.Info());
 }
 
 MemoryStream* SymmetricSecureKey::Serialize(SymmetricSecureKey &KeyObj)
 {
-	size_t kLen = KeyObj.Key().size();
-	size_t nLen = KeyObj.Nonce().size();
-	size_t iLen = KeyObj.Info().size();
+	SymmetricKeyView keyView(KeyObj);
+
+	size_t kLen = keyView.Key().size();
+	size_t nLen = keyView.Nonce().size();
+	size_t iLen = keyView.Info().size();
 	size_t tLen = 6 + kLen + nLen + iLen;
 
 	IO::StreamWriter writer(tLen);
@@ -173,11 +305,11 @@ MemoryStream* SymmetricSecureKey::Serialize(SymmetricSecureKey &KeyObj)
 	writer.Write(static_cast<ushort>(iLen));
 
 	if (kLen != 0)
-		writer.Write(KeyObj.Key(), 0, kLen);
+		writer.Write(keyView.Key(), 0, kLen);
 	if (nLen != 0)
-		writer.Write(KeyObj.Nonce(), 0, nLen);
+		writer.Write(keyView.Nonce(), 0, nLen);
 	if (iLen != 0)
-		writer.Write(KeyObj.Info(), 0, iLen);
+		writer.Write(keyView.Info(), 0, iLen);
 
 	IO::MemoryStream* strm = writer.GetStream();
 	strm->Seek(0, IO::SeekOrigin::Begin);
@@ -185,16 +317,77 @@ MemoryStream* SymmetricSecureKey::Serialize(SymmetricSecureKey &KeyObj)
 	return strm;
 }
 
+//~~~Protected Functions~~~//
+
+const std::vector<byte> &SymmetricSecureKey::BorrowInfo()
+{
+	CexAssert(m_unlockCount != 0, "the key has not been unlocked");
+
+	return m_infoView;
+}
+
+const std::vector<byte> &SymmetricSecureKey::BorrowKey()
+{
+	CexAssert(m_unlockCount != 0, "the key has not been unlocked");
+
+	return m_keyView;
+}
+
+const std::vector<byte> &SymmetricSecureKey::BorrowNonce()
+{
+	CexAssert(m_unlockCount != 0, "the key has not been unlocked");
+
+	return m_nonceView;
+}
+
+void SymmetricSecureKey::Lock()
+{
+	// the views are only written on the first unlock and the last lock, when no other
+	// view can be reading them; the mutex orders those writes against concurrent views
+	std::lock_guard<std::mutex> lock(m_mtxLock);
+
+	if (m_unlockCount != 0)
+	{
+		if (--m_unlockCount == 0)
+		{
+			Utility::IntUtils::ClearVector(m_infoView);
+			Utility::IntUtils::ClearVector(m_keyView);
+			Utility::IntUtils::ClearVector(m_nonceView);
+		}
+	}
+}
+
+void SymmetricSecureKey::Unlock()
+{
+	std::lock_guard<std::mutex> lock(m_mtxLock);
+
+	if (m_unlockCount == 0)
+	{
+		const size_t KEYLEN = m_keySizes.KeySize();
+		const size_t NONLEN = m_keySizes.NonceSize();
+		std::vector<byte> state(m_keyState.size());
+		Transform(m_keyState, state);
+
+		m_keyView.assign(state.begin(), state.begin() + KEYLEN);
+		m_nonceView.assign(state.begin() + KEYLEN, state.begin() + KEYLEN + NONLEN);
+		m_infoView.assign(state.begin() + KEYLEN + NONLEN, state.end());
+		Utility::IntUtils::ClearVector(state);
+	}
+
+	++m_unlockCount;
+}
+
 //~~~Private Functions~~~//
 
 std::vector<byte> SymmetricSecureKey::Extract(size_t Offset, size_t Length)
 {
-	Transform();
-	std::vector<byte> state(Length);
-	Utility::MemUtils::Copy(m_keyState, Offset, state, 0, Length);
-	Transform();
+	std::vector<byte> state(m_keyState.size());
+	Transform(m_keyState, state);
+	std::vector<byte> tmpState(Length);
+	Utility::MemUtils::Copy(state, Offset, tmpState, 0, Length);
+	Utility::IntUtils::ClearVector(state);
 
-	return state;
+	return tmpState;
 }
 
 std::vector<byte> SymmetricSecureKey::GetSystemKey()
@@ -217,6 +410,13 @@ std::vector<byte> SymmetricSecureKey::GetSystemKey()
 }
 
 void SymmetricSecureKey::Transform()
+{
+	std::vector<byte> state(m_keyState.size());
+	Transform(m_keyState, state);
+	m_keyState = std::move(state);
+}
+
+void SymmetricSecureKey::Transform(const std::vector<byte> &Input, std::vector<byte> &Output)
 {
 	std::vector<byte> seed = GetSystemKey();
 	std::vector<byte> key(32);
@@ -224,14 +424,12 @@ void SymmetricSecureKey::Transform()
 
 	Utility::MemUtils::Copy(seed, 0, key, 0, key.size());
 	Utility::MemUtils::Copy(seed, key.size(), iv, 0, iv.size());
-	SymmetricKey kp(key, iv);
+	SymmetricKey kp(std::move(key), std::move(iv));
 
 	// AES256-CTR
 	Cipher::Symmetric::Block::Mode::CTR cpr(Enumeration::BlockCiphers::Rijndael);
 	cpr.Initialize(true, kp);
-	std::vector<byte> state(m_keyState.size());
-	cpr.Transform(m_keyState, 0, state, 0, state.size());
-	m_keyState = state;
+	cpr.Transform(Input, 0, Output, 0, Input.size());
 }
 
 NAMESPACE_SYMMETRICKEYEND
\ No newline at end of file
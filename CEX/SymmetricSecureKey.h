@@ -2,6 +2,8 @@
 #define CEX_SYMMETRICSECUREKEY_H
 
 #include "ISymmetricKey.h"
+#include <atomic>
+#include <mutex>
 
 NAMESPACE_SYMMETRICKEY
 
@@ -14,6 +16,8 @@ NAMESPACE_SYMMETRICKEY
 /// <description>Implementation Notes:</description>
 /// <list type="bullet">
 /// <item><description>Key arrays are encrypted when the class is instantiated with data, and decrypted when accessed through the data arrays getter property functions (Key, Nonce, and Info</description></item>
+/// <item><description>A SymmetricKeyView decrypts the state once for the lifetime of the view, rather than once per property access; the plaintext copy is erased when the last view on the key is released</description></item>
+/// <item><description>Views are reference counted under an internal lock, so a key can be viewed concurrently from several threads</description></item>
 /// <item><description>The key material access is limited to the initializing process, user, and computer; it is not transferrable across process or machine boundaries</description></item>
 /// <item><description>Accessing the property functions from another process, user, or computer, will change the encryption key and return invalid data</description></item>
 /// <item><description>Serializing a SymmetricSecureKey returns a decrypted SymmetricKey stream, deserializing a SymmetricKey stream returns an initialized SymmetricSecureKey</description></item>
@@ -25,10 +29,15 @@ class SymmetricSecureKey : public ISymmetricKey
 {
 private:
 
+	std::vector<byte> m_infoView;
 	bool m_isDestroyed;
 	SymmetricKeySize m_keySizes;
 	std::vector<byte> m_keyState;
 	std::vector<byte> m_keySalt;
+	std::vector<byte> m_keyView;
+	mutable std::mutex m_mtxLock;
+	std::vector<byte> m_nonceView;
+	std::atomic<size_t> m_unlockCount;
 
 public:
 
@@ -91,11 +100,41 @@ public:
 	/// <param name="KeySalt">The secret 64bit salt value used in internal encryption</param>
 	explicit SymmetricSecureKey(const std::vector<byte> &Key, const std::vector<byte> &Nonce, const std::vector<byte> &Info, ulong KeySalt = 0);
 
+	/// <summary>
+	/// Copy constructor; copies the encrypted key state, the copy has no open views
+	/// </summary>
+	///
+	/// <param name="Other">The key to copy</param>
+	SymmetricSecureKey(const SymmetricSecureKey &Other);
+
+	/// <summary>
+	/// Move constructor; takes the encrypted key state, the source must have no open views and is left destroyed
+	/// </summary>
+	///
+	/// <param name="Other">The key to move</param>
+	SymmetricSecureKey(SymmetricSecureKey &&Other);
+
 	/// <summary>
 	/// Finalize objects
 	/// </summary>
 	~SymmetricSecureKey() override;
 
+	//~~~Operators~~~//
+
+	/// <summary>
+	/// Copy assignment; copies the encrypted key state, the target must have no open views
+	/// </summary>
+	///
+	/// <param name="Other">The key to copy</param>
+	SymmetricSecureKey &operator=(const SymmetricSecureKey &Other);
+
+	/// <summary>
+	/// Move assignment; takes the encrypted key state, neither key may have open views and the source is left destroyed
+	/// </summary>
+	///
+	/// <param name="Other">The key to move</param>
+	SymmetricSecureKey &operator=(SymmetricSecureKey &&Other);
+
 	//~~~Public Functions~~~//
 
 	/// <summary>
@@ -135,11 +174,20 @@ public:
 	/// <returns>A stream containing the serialized SymmetricKey data</returns>
 	static MemoryStream* Serialize(SymmetricSecureKey &KeyObj);
 
+protected:
+
+	const std::vector<byte> &BorrowInfo() override;
+	const std::vector<byte> &BorrowKey() override;
+	const std::vector<byte> &BorrowNonce() override;
+	void Lock() override;
+	void Unlock() override;
+
 private:
 
 	std::vector<byte> Extract(size_t Offset, size_t Length);
 	std::vector<byte> GetSystemKey();
 	void Transform();
+	void Transform(const std::vector<byte> &Input, std::vector<byte> &Output);
 };
 
 NAMESPACE_SYMMETRICKEYEND
@@ -190,18 +190,20 @@ void THX::Destroy()
 
 void THX::Initialize(bool Encryption, ISymmetricKey &KeyParams)
 {
-	if (!SymmetricKeySize::Contains(m_legalKeySizes, KeyParams.Key().size()))
+	SymmetricKeyView keyView(KeyParams);
+
+	if (!SymmetricKeySize::Contains(m_legalKeySizes, keyView.Key().size()))
 		throw CryptoSymmetricCipherException("THX:Initialize", "Invalid key size! Key must be one of the LegalKeySizes() in length.");
-	if (m_kdfEngineType != Enumeration::Digests::None && KeyParams.Info().size() > m_kdfInfoMax)
+	if (m_kdfEngineType != Enumeration::Digests::None && keyView.Info().size() > m_kdfInfoMax)
 		throw CryptoSymmetricCipherException("THX:Initialize", "Invalid info size! Info parameter must be no longer than DistributionCodeMax size.");
 
-	if (KeyParams.Info().size() > 0)
-		m_kdfInfo = KeyParams.Info();
+	if (keyView.Info().size() > 0)
+		m_kdfInfo = keyView.Info();
 
 	m_isEncryption = Encryption;
-	m_cprKeySize = KeyParams.Key().size() * 8;
+	m_cprKeySize = keyView.Key().size() * 8;
 	// expand the key
-	ExpandKey(KeyParams.Key());
+	ExpandKey(keyView.Key());
 
 	// load tables into L1
 #if defined(CEX_PREFETCH_THX_TABLES)
@@ -281,7 +283,7 @@ void THX::SecureExpand(const std::vector<byte> &Key)
 	std::vector<byte> sbKey(16, 0);
 	std::vector<uint> eKm(k64Cnt, 0);
 	std::vector<uint> oKm(k64Cnt, 0);
-	std::vector<uint> wK(keySize, 0);
+	Utility::SecureVector<uint> wK(keySize, 0);
 
 	Kdf::HKDF gen(m_kdfEngine);
 
@@ -352,7 +354,7 @@ void THX::StandardExpand(const std::vector<byte> &Key)
 	std::vector<uint> eKm(kmLen, 0);
 	std::vector<uint> oKm(kmLen, 0);
 	std::vector<byte> sbKey(Key.size() == 64 ? 32 : 16, 0);
-	std::vector<uint> wK(m_rndCount * 2 + 8, 0);
+	Utility::SecureVector<uint> wK(m_rndCount * 2 + 8, 0);
 
 	// CHANGE: 512 key gets 4 extra rounds
 	m_rndCount = (Key.size() == 64) ? 20 : DEF_ROUNDS;
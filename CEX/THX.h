@@ -35,6 +35,7 @@
 #define CEX_THX_H
 
 #include "IBlockCipher.h"
+#include "SecureAllocator.h"
 
 NAMESPACE_BLOCK
 
@@ -97,6 +98,7 @@ NAMESPACE_BLOCK
 /// <item><description>The internal block size is 16 bytes wide.</description></item>
 /// <item><description>Diffusion rounds assignments are 16, 18, 20, 22, 24, 26, 28, 30 and 32, default is 16 (128-256 bit key), a 512 bit key is automatically assigned 20 rounds.</description></item>
 /// <item><description>Valid rounds assignments can be found in the <see cref="LegalRounds"/> property.</description></item>
+/// <item><description>The round keys and key dependent s-boxes are stored in the page locked <see cref="Utility::SecureArena"/>, and are zeroed when the cipher is destroyed.</description></item>
 /// </list>
 /// 
 /// <description>Guiding Publications:</description>
@@ -133,7 +135,7 @@ private:
 	static const size_t STATE_PRECACHED = 2048 + 4096;
 
 	bool m_destroyEngine;
-	std::vector<uint> m_expKey;
+	Utility::SecureVector<uint> m_expKey;
 	bool m_isDestroyed;
 	bool m_isEncryption;
 	bool m_isInitialized;
@@ -146,7 +148,7 @@ private:
 	std::vector<SymmetricKeySize> m_legalKeySizes;
 	std::vector<size_t> m_legalRounds;
 	size_t m_rndCount;
-	std::vector<uint> m_sBox;
+	Utility::SecureVector<uint> m_sBox;
 
 public:
 
@@ -20,6 +20,7 @@
 #define CEX_TWOFISH_H
 
 #include "CexDomain.h"
+#include "SecureAllocator.h"
 
 NAMESPACE_BLOCK
 
@@ -28,7 +29,7 @@ NAMESPACE_BLOCK
 */
 
 template<typename T>
-void THXDecryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Key, std::vector<uint> &Sbox)
+void THXDecryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, Utility::SecureVector<uint> &Key, Utility::SecureVector<uint> &Sbox)
 {
 #if defined(__AVX__)
 
@@ -86,7 +87,7 @@ void THXDecryptW(const std::vector<byte> &Input, const size_t InOffset, std::vec
 }
 
 template<typename T>
-void THXEncryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, std::vector<uint> &Key, std::vector<uint> &Sbox)
+void THXEncryptW(const std::vector<byte> &Input, const size_t InOffset, std::vector<byte> &Output, const size_t OutOffset, Utility::SecureVector<uint> &Key, Utility::SecureVector<uint> &Sbox)
 {
 #if defined(__AVX__)
 
@@ -148,7 +149,7 @@ void THXEncryptW(const std::vector<byte> &Input, const size_t InOffset, std::vec
 // only on msc
 #if defined(CEX_COMPILER_MSC)
 	template<typename T, typename U>
-	T Fe0W(const T &X, const std::vector<U> &Sbox)
+	T Fe0W(const T &X, const Utility::SecureVector<U> &Sbox)
 	{
 	#if defined(__AVX512__)
 		return T(
@@ -193,7 +194,7 @@ void THXEncryptW(const std::vector<byte> &Input, const size_t InOffset, std::vec
 
 #if defined(CEX_COMPILER_MSC)
 	template<typename T, typename U>
-	T Fe3W(const T &X, const std::vector<U> &Sbox)
+	T Fe3W(const T &X, const Utility::SecureVector<U> &Sbox)
 	{
 	#if defined(__AVX512__)
 		return T(
@@ -237,13 +238,13 @@ void THXEncryptW(const std::vector<byte> &Input, const size_t InOffset, std::vec
 #endif
 
 template<typename T, typename U>
-T Fe0(const T X, std::vector<U> &Sbox)
+T Fe0(const T X, Utility::SecureVector<U> &Sbox)
 {
 	return Sbox[2 * (byte)X] ^ Sbox[2 * (byte)(X >> 8) + 0x001] ^ Sbox[2 * (byte)(X >> 16) + 0x200] ^ Sbox[2 * (byte)(X >> 24) + 0x201];
 }
 
 template<typename T, typename U>
-T Fe3(const T X, const std::vector<U> &Sbox)
+T Fe3(const T X, const Utility::SecureVector<U> &Sbox)
 {
 	return Sbox[2 * (byte)X + 0x001] ^ Sbox[2 * (byte)(X >> 8) + 0x200] ^ Sbox[2 * (byte)(X >> 16) + 0x201] ^ Sbox[2 * (byte)(X >> 24)];
 }
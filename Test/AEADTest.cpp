@@ -1,6 +1,11 @@
 #include "AEADTest.h"
+#if defined(__AVX__)
+#	include "../CEX/AHX.h"
+#endif
+#include "../CEX/CpuDetect.h"
 #include "../CEX/EAX.h"
 #include "../CEX/GCM.h"
+#include "../CEX/GCMT.h"
 #include "../CEX/GMAC.h"
 #include "../CEX/OCB.h"
 #include "../CEX/RHX.h"
@@ -8,8 +13,12 @@
 
 namespace Test
 {
+#if defined(__AVX__)
+	using Cipher::Symmetric::Block::AHX;
+#endif
 	using Cipher::Symmetric::Block::Mode::EAX;
 	using Cipher::Symmetric::Block::Mode::GCM;
+	using Cipher::Symmetric::Block::Mode::GCMT;
 	using Cipher::Symmetric::Block::Mode::OCB;
 	using Cipher::Symmetric::Block::RHX;
 	using Cipher::Symmetric::Block::IBlockCipher;
@@ -95,6 +104,43 @@ namespace Test
 
 			delete cipher3;
 
+			GCMT<RHX>* cipher4 = new GCMT<RHX>();
+
+			for (size_t i = EAX_TESTSIZE + OCB_TESTSIZE; i < EAX_TESTSIZE + OCB_TESTSIZE + GCM_TESTSIZE; ++i)
+			{
+				CompareVector(cipher4, m_key[i], m_nonce[i], m_associatedText[i], m_plainText[i], m_cipherText[i], m_expectedCode[i]);
+			}
+			OnProgress(std::string("AEADTest: Passed GCMT RHX known answer comparison tests.."));
+
+			StressTest(cipher4);
+			ParallelTest(cipher4);
+			IncrementalCheck(cipher4);
+			OnProgress(std::string("AEADTest: Passed GCMT RHX stress, parallel, and auto incrementing tests.."));
+
+			delete cipher4;
+
+#if defined(__AVX__)
+			Common::CpuDetect detect;
+
+			if (detect.AESNI())
+			{
+				GCMT<AHX>* cipher5 = new GCMT<AHX>();
+
+				for (size_t i = EAX_TESTSIZE + OCB_TESTSIZE; i < EAX_TESTSIZE + OCB_TESTSIZE + GCM_TESTSIZE; ++i)
+				{
+					CompareVector(cipher5, m_key[i], m_nonce[i], m_associatedText[i], m_plainText[i], m_cipherText[i], m_expectedCode[i]);
+				}
+				OnProgress(std::string("AEADTest: Passed GCMT AHX known answer comparison tests.."));
+
+				StressTest(cipher5);
+				ParallelTest(cipher5);
+				IncrementalCheck(cipher5);
+				OnProgress(std::string("AEADTest: Passed GCMT AHX stress, parallel, and auto incrementing tests.."));
+
+				delete cipher5;
+			}
+#endif
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
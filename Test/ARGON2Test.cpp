@@ -0,0 +1,149 @@
+#include "ARGON2Test.h"
+#include "../CEX/ARGON2.h"
+#include "../CEX/SymmetricKey.h"
+
+namespace Test
+{
+	const std::string ARGON2Test::DESCRIPTION = "Argon2id RFC 9106 test vectors.";
+	const std::string ARGON2Test::FAILURE = "FAILURE! ";
+	const std::string ARGON2Test::SUCCESS = "SUCCESS! All Argon2id tests have executed succesfully.";
+
+	ARGON2Test::ARGON2Test()
+		:
+		m_key(2),
+		m_output(0),
+		m_progressEvent(),
+		m_salt(1)
+	{
+	}
+
+	ARGON2Test::~ARGON2Test()
+	{
+	}
+
+	std::string ARGON2Test::Run()
+	{
+		try
+		{
+			Initialize();
+
+			CompareRfc();
+			OnProgress(std::string("ARGON2Test: Passed RFC 9106 KAT vector test.."));
+			CompareVector(m_key[0], m_salt[0], m_output[1], 256, 2, 1);
+			CompareVector(m_key[0], m_salt[0], m_output[2], 256, 2, 2);
+			CompareVector(m_key[0], m_salt[0], m_output[3], 65536, 2, 1);
+			CompareVector(m_key[1], m_salt[0], m_output[4], 65536, 2, 1);
+			OnProgress(std::string("ARGON2Test: Passed reference implementation KAT vector tests.."));
+			CompareParallel();
+			OnProgress(std::string("ARGON2Test: Passed parallel and memory reuse comparison tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void ARGON2Test::CompareParallel()
+	{
+		std::vector<byte> otp1(64);
+		std::vector<byte> otp2(64);
+		std::vector<byte> otp3(64);
+
+		// lanes processed concurrently
+		Kdf::ARGON2 gen1(4096, 2, 8);
+		gen1.Initialize(m_key[0], m_salt[0]);
+		gen1.Generate(otp1);
+
+		// the same lanes processed sequentially
+		Kdf::ARGON2 gen2(4096, 2, 8);
+		gen2.ParallelProfile().IsParallel() = false;
+		gen2.Initialize(m_key[0], m_salt[0]);
+		gen2.Generate(otp2);
+
+		if (otp1 != otp2)
+			throw TestException("Argon2id: Parallel output does not match sequential output!");
+
+		// the retained memory matrix must not affect subsequent derivations
+		gen1.Generate(otp3);
+
+		if (otp3 != otp1)
+			throw TestException("Argon2id: Repeated derivation does not match!");
+
+		gen1.Initialize(m_key[1], m_salt[0]);
+		gen1.Generate(otp3);
+		gen1.Initialize(m_key[0], m_salt[0]);
+		gen1.Generate(otp2);
+
+		if (otp3 == otp1 || otp2 != otp1)
+			throw TestException("Argon2id: Re-initialized derivation does not match!");
+	}
+
+	void ARGON2Test::CompareRfc()
+	{
+		std::vector<byte> key(32, 0x01);
+		std::vector<byte> salt(16, 0x02);
+		std::vector<byte> secret(8, 0x03);
+		std::vector<byte> info(12, 0x04);
+		std::vector<byte> otp(32);
+		Key::Symmetric::SymmetricKey kp(key, salt, info);
+
+		Kdf::ARGON2 gen(32, 3, 4);
+		gen.Secret() = secret;
+		gen.Initialize(kp);
+		gen.Generate(otp);
+
+		if (otp != m_output[0])
+			throw TestException("Argon2id: RFC 9106 vector test failed!");
+	}
+
+	void ARGON2Test::CompareVector(std::vector<byte> &Key, std::vector<byte> &Salt, std::vector<byte> &Expected, size_t MemoryCost, size_t TimeCost, size_t Parallelism)
+	{
+		std::vector<byte> otp(Expected.size());
+
+		Kdf::ARGON2 gen(MemoryCost, TimeCost, Parallelism);
+		gen.Initialize(Key, Salt);
+		gen.Generate(otp, 0, otp.size());
+
+		if (otp != Expected)
+			throw TestException("Argon2id: KAT vector test failed!");
+	}
+
+	void ARGON2Test::Initialize()
+	{
+		const char* output[5] =
+		{
+			("0D640DF58D78766C08C037A34A8B53C9D01EF0452D75B65EB52520E96B01E659"),
+			("9DFEB910E80BAD0311FEE20F9C0E2B12C17987B4CAC90C2EF54D5B3021C68BFE"),
+			("6D093C501FD5999645E0EA3BF620D7B8BE7FD2DB59C20D9FFF9539DA2BF57037"),
+			("09316115D5CF24ED5A15A31A3BA326E5CF32EDC24702987C02B6566F61913CF7"),
+			("0B84D652CF6B0C4BEAEF0DFE278BA6A80DF6696281D7E0D2891B817D8C458FDE")
+		};
+		HexConverter::Decode(output, 5, m_output);
+
+		std::string p1 = "password";
+		m_key[0].reserve(p1.size());
+		for (size_t i = 0; i < p1.size(); ++i)
+			m_key[0].push_back(p1[i]);
+
+		std::string p2 = "differentpassword";
+		m_key[1].reserve(p2.size());
+		for (size_t i = 0; i < p2.size(); ++i)
+			m_key[1].push_back(p2[i]);
+
+		std::string s1 = "somesalt";
+		m_salt[0].reserve(s1.size());
+		for (size_t i = 0; i < s1.size(); ++i)
+			m_salt[0].push_back(s1[i]);
+	}
+
+	void ARGON2Test::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
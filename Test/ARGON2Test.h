@@ -0,0 +1,59 @@
+#ifndef _CEXTEST_ARGON2TEST_H
+#define _CEXTEST_ARGON2TEST_H
+
+#include "ITest.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the Argon2id implementation using vector comparisons.
+	/// <para>Using the official Kats from RFC 9106: https://tools.ietf.org/html/rfc9106 and the Argon2 reference implementation.</para>
+	/// </summary>
+	class ARGON2Test : public ITest
+	{
+	private:
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<std::vector<byte>> m_key;
+		std::vector<std::vector<byte>> m_output;
+		TestEventHandler m_progressEvent;
+		std::vector<std::vector<byte>> m_salt;
+
+	public:
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		virtual const std::string Description() { return DESCRIPTION; }
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		virtual TestEventHandler &Progress() { return m_progressEvent; }
+
+		/// <summary>
+		/// Compares known answer Argon2id vectors for equality
+		/// </summary>
+		ARGON2Test();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~ARGON2Test();
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		virtual std::string Run();
+
+	private:
+		void CompareParallel();
+		void CompareRfc();
+		void CompareVector(std::vector<byte> &Key, std::vector<byte> &Salt, std::vector<byte> &Expected, size_t MemoryCost, size_t TimeCost, size_t Parallelism);
+		void Initialize();
+		void OnProgress(std::string Data);
+	};
+}
+
+#endif
@@ -0,0 +1,224 @@
+#include "AeadBatchTest.h"
+#if defined(__AVX__)
+#	include "../CEX/AHX.h"
+#endif
+#include "../CEX/CpuDetect.h"
+#include "../CEX/EAX.h"
+#include "../CEX/GCM.h"
+#include "../CEX/GCMT.h"
+#include "../CEX/OCB.h"
+#include "../CEX/RHX.h"
+#include "../CEX/SymmetricKey.h"
+
+namespace Test
+{
+#if defined(__AVX__)
+	using Cipher::Symmetric::Block::AHX;
+#endif
+	using Cipher::Symmetric::Block::Mode::AeadPacket;
+	using Cipher::Symmetric::Block::Mode::EAX;
+	using Cipher::Symmetric::Block::Mode::GCM;
+	using Cipher::Symmetric::Block::Mode::GCMT;
+	using Cipher::Symmetric::Block::Mode::OCB;
+	using Cipher::Symmetric::Block::RHX;
+	using Enumeration::BlockCiphers;
+	using Key::Symmetric::SymmetricKey;
+
+	const std::string AeadBatchTest::DESCRIPTION = "AEAD batch test; compares batched Seal and Open with the streaming GCM, GCMT, EAX, and OCB modes.";
+	const std::string AeadBatchTest::FAILURE = "FAILURE! ";
+	const std::string AeadBatchTest::SUCCESS = "SUCCESS! All AEAD batch tests have executed succesfully.";
+
+	AeadBatchTest::AeadBatchTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	AeadBatchTest::~AeadBatchTest()
+	{
+	}
+
+	std::string AeadBatchTest::Run()
+	{
+		try
+		{
+			GCM* gcm1 = new GCM(BlockCiphers::Rijndael);
+			GCM* gcm2 = new GCM(BlockCiphers::Rijndael);
+			CompareBatch(gcm1, gcm2, 12);
+			CompareBatch(gcm1, gcm2, 16);
+			delete gcm1;
+			delete gcm2;
+			OnProgress(std::string("AeadBatchTest: Passed GCM batch Seal and Open tests.."));
+
+			// the specialized mode batches are compared with the streaming GCM output
+			GCM* gcm3 = new GCM(BlockCiphers::Rijndael);
+			GCMT<RHX>* gcm4 = new GCMT<RHX>();
+			CompareBatch(gcm3, gcm4, 12);
+			CompareBatch(gcm3, gcm4, 16);
+			delete gcm4;
+#if defined(__AVX__)
+			Common::CpuDetect detect;
+
+			if (detect.AESNI())
+			{
+				GCMT<AHX>* gcm5 = new GCMT<AHX>();
+				CompareBatch(gcm3, gcm5, 12);
+				CompareBatch(gcm3, gcm5, 16);
+				delete gcm5;
+			}
+#endif
+			delete gcm3;
+			OnProgress(std::string("AeadBatchTest: Passed GCMT batch Seal and Open tests.."));
+
+			EAX* eax1 = new EAX(BlockCiphers::Rijndael);
+			EAX* eax2 = new EAX(BlockCiphers::Rijndael);
+			CompareBatch(eax1, eax2, 16);
+			delete eax1;
+			delete eax2;
+			OnProgress(std::string("AeadBatchTest: Passed EAX batch Seal and Open tests.."));
+
+			OCB* ocb1 = new OCB(BlockCiphers::Rijndael);
+			OCB* ocb2 = new OCB(BlockCiphers::Rijndael);
+			CompareBatch(ocb1, ocb2, 12);
+			CompareBatch(ocb1, ocb2, 15);
+			delete ocb1;
+			delete ocb2;
+			OnProgress(std::string("AeadBatchTest: Passed OCB batch Seal and Open tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void AeadBatchTest::CompareBatch(IAeadMode* Cipher1, IAeadMode* Cipher2, size_t NonceSize)
+	{
+		// empty, partial, single and multi-block messages, with and without associated data
+		const size_t MSGLEN[] = { 0, 1, 15, 16, 17, 33, 64, 100, 257, 1000, 31, 4096 };
+		const size_t AADLEN[] = { 0, 5, 16, 20, 0, 40, 3, 0, 64, 17, 33, 0 };
+		const size_t PKTCNT = sizeof(MSGLEN) / sizeof(size_t);
+		const size_t TAGLEN = 16;
+
+		std::vector<byte> key(32);
+		std::vector<std::vector<byte>> aad(PKTCNT);
+		std::vector<std::vector<byte>> dec(PKTCNT);
+		std::vector<std::vector<byte>> enc(PKTCNT);
+		std::vector<std::vector<byte>> exp(PKTCNT);
+		std::vector<std::vector<byte>> msg(PKTCNT);
+		std::vector<std::vector<byte>> nonce(PKTCNT);
+		std::vector<byte> tags(PKTCNT * TAGLEN);
+		std::vector<AeadPacket> pkts(PKTCNT);
+
+		for (size_t i = 0; i < key.size(); ++i)
+			key[i] = static_cast<byte>(i * 7);
+
+		for (size_t i = 0; i < PKTCNT; ++i)
+		{
+			aad[i].resize(AADLEN[i]);
+			msg[i].resize(MSGLEN[i]);
+			nonce[i].resize(NonceSize);
+
+			for (size_t j = 0; j < aad[i].size(); ++j)
+				aad[i][j] = static_cast<byte>(j + i);
+			for (size_t j = 0; j < msg[i].size(); ++j)
+				msg[i][j] = static_cast<byte>((j * 3) + i);
+			for (size_t j = 0; j < NonceSize; ++j)
+				nonce[i][j] = static_cast<byte>((j * 13) + (i * 31));
+
+			// the expected cipher-text and tag from the streaming interface; padded for modes that write a whole final block
+			SymmetricKey kp(key, nonce[i]);
+			Cipher1->Initialize(true, kp);
+
+			if (AADLEN[i] != 0 || Cipher1->Enumeral() == Enumeration::CipherModes::EAX)
+				Cipher1->SetAssociatedData(aad[i], 0, aad[i].size());
+
+			exp[i].resize(MSGLEN[i] + TAGLEN + 16);
+			Cipher1->Transform(msg[i], 0, exp[i], 0, MSGLEN[i]);
+			Cipher1->Finalize(exp[i], MSGLEN[i], TAGLEN);
+			exp[i].resize(MSGLEN[i] + TAGLEN);
+
+			enc[i].resize(MSGLEN[i]);
+			pkts[i] = AeadPacket(nonce[i], msg[i], 0, enc[i], 0, MSGLEN[i], tags, i * TAGLEN, AADLEN[i] != 0 ? &aad[i] : nullptr);
+		}
+
+		SymmetricKey kp(key, nonce[0]);
+		Cipher2->Initialize(true, kp);
+		Cipher2->Seal(pkts, TAGLEN);
+
+		for (size_t i = 0; i < PKTCNT; ++i)
+		{
+			std::vector<byte> tmp(enc[i]);
+			tmp.insert(tmp.end(), tags.begin() + (i * TAGLEN), tags.begin() + ((i + 1) * TAGLEN));
+
+			if (tmp != exp[i])
+				throw TestException("CompareBatch: The batch output is not equal to the streaming output!");
+		}
+
+		// open in place, with an altered tag and an altered cipher-text
+		Cipher2->Initialize(false, kp);
+
+		for (size_t i = 0; i < PKTCNT; ++i)
+		{
+			dec[i] = enc[i];
+			pkts[i].Input = &dec[i];
+			pkts[i].Output = &dec[i];
+		}
+
+		tags[2 * TAGLEN] ^= 1;
+		dec[9][100] ^= 0x80;
+
+		if (Cipher2->Open(pkts, TAGLEN))
+			throw TestException("CompareBatch: The batch with altered packets was authenticated!");
+
+		// a rejected in-place packet keeps its cipher-text
+		if (pkts[2].Verified || dec[2] != enc[2])
+			throw TestException("CompareBatch: The altered packet was not rejected!");
+
+		std::vector<byte> alt(enc[9]);
+		alt[100] ^= 0x80;
+
+		if (pkts[9].Verified || dec[9] != alt)
+			throw TestException("CompareBatch: The altered packet was not rejected!");
+
+		for (size_t i = 0; i < PKTCNT; ++i)
+		{
+			if (i != 2 && i != 9 && (!pkts[i].Verified || dec[i] != msg[i]))
+				throw TestException("CompareBatch: The batch decryption is not equal to the message!");
+		}
+
+		// a rejected packet with a separate output is zeroed
+		for (size_t i = 0; i < PKTCNT; ++i)
+		{
+			pkts[i].Input = &enc[i];
+			pkts[i].Output = &dec[i];
+		}
+
+		if (Cipher2->Open(pkts, TAGLEN))
+			throw TestException("CompareBatch: The batch with an altered packet was authenticated!");
+		if (pkts[2].Verified || dec[2] != std::vector<byte>(MSGLEN[2], 0))
+			throw TestException("CompareBatch: The altered packet was not rejected!");
+
+		// the restored packets all authenticate
+		tags[2 * TAGLEN] ^= 1;
+
+		if (!Cipher2->Open(pkts, TAGLEN))
+			throw TestException("CompareBatch: The batch was not authenticated!");
+
+		for (size_t i = 0; i < PKTCNT; ++i)
+		{
+			if (dec[i] != msg[i])
+				throw TestException("CompareBatch: The batch decryption is not equal to the message!");
+		}
+	}
+
+	void AeadBatchTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
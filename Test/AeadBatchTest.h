@@ -0,0 +1,57 @@
+#ifndef _CEXTEST_AEADBATCHTEST_H
+#define _CEXTEST_AEADBATCHTEST_H
+
+#include "ITest.h"
+#include "../CEX/IAeadMode.h"
+
+namespace Test
+{
+	using Cipher::Symmetric::Block::Mode::IAeadMode;
+
+	/// <summary>
+	/// Tests the batched Seal and Open functions of the GCM, EAX, and OCB AEAD modes.
+	/// <para>Each packet of a batch is compared with the output of the streaming Transform and Finalize interface,
+	/// and altered packets must be rejected without releasing plain-text; a rejected in-place packet keeps its cipher-text.</para>
+	/// </summary>
+	class AeadBatchTest : public ITest
+	{
+	private:
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		TestEventHandler m_progressEvent;
+
+	public:
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		virtual const std::string Description() { return DESCRIPTION; }
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		virtual TestEventHandler &Progress() { return m_progressEvent; }
+
+		/// <summary>
+		/// Initialize this class
+		/// </summary>
+		AeadBatchTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~AeadBatchTest();
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		virtual std::string Run();
+
+	private:
+		void CompareBatch(IAeadMode* Cipher1, IAeadMode* Cipher2, size_t NonceSize);
+		void OnProgress(std::string Data);
+	};
+}
+
+#endif
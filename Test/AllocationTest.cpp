@@ -0,0 +1,385 @@
+#include "AllocationTest.h"
+#include "../CEX/CBC.h"
+#include "../CEX/CFB.h"
+#include "../CEX/CMAC.h"
+#include "../CEX/CTR.h"
+#include "../CEX/CTRT.h"
+#include "../CEX/ChaCha20.h"
+#include "../CEX/DigestFromName.h"
+#include "../CEX/EAX.h"
+#include "../CEX/GCM.h"
+#include "../CEX/GMAC.h"
+#include "../CEX/HMAC.h"
+#include "../CEX/ICM.h"
+#include "../CEX/OCB.h"
+#include "../CEX/RHX.h"
+#include "../CEX/Salsa20.h"
+#include "../CEX/SecureRandom.h"
+#include "../CEX/SymmetricKey.h"
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	// the replacement allocator counts calls only while a measurement is active
+	bool CountEnabled = false;
+	size_t AllocationCount = 0;
+}
+
+void* operator new(std::size_t Size)
+{
+	if (CountEnabled)
+		++AllocationCount;
+
+	void* ptr = std::malloc(Size != 0 ? Size : 1);
+
+	if (ptr == nullptr)
+		throw std::bad_alloc();
+
+	return ptr;
+}
+
+void operator delete(void* Ptr) noexcept
+{
+	std::free(Ptr);
+}
+
+namespace Test
+{
+	using Enumeration::BlockCiphers;
+	using Cipher::Symmetric::Block::Mode::CBC;
+	using Cipher::Symmetric::Block::Mode::CFB;
+	using Mac::CMAC;
+	using Cipher::Symmetric::Block::Mode::CTR;
+	using Cipher::Symmetric::Block::Mode::CTRT;
+	using Cipher::Symmetric::Stream::ChaCha20;
+	using Enumeration::Digests;
+	using Cipher::Symmetric::Block::Mode::EAX;
+	using Cipher::Symmetric::Block::Mode::GCM;
+	using Mac::GMAC;
+	using Mac::HMAC;
+	using Cipher::Symmetric::Block::Mode::ICM;
+	using Cipher::Symmetric::Block::Mode::OCB;
+	using Cipher::Symmetric::Block::RHX;
+	using Cipher::Symmetric::Stream::Salsa20;
+	using Prng::SecureRandom;
+	using Key::Symmetric::SymmetricKey;
+
+	const std::string AllocationTest::DESCRIPTION = "Heap allocation test; verifies that initialized modes, stream ciphers, digests, and macs do not allocate memory.";
+	const std::string AllocationTest::FAILURE = "FAILURE! ";
+	const std::string AllocationTest::SUCCESS = "SUCCESS! All heap allocation tests have executed succesfully.";
+	const size_t AllocationTest::BLOCK_LENGTHS[4] = { 16, 64, 1008, 4096 };
+	const size_t AllocationTest::MSG_LENGTHS[4] = { 1, 64, 1000, 4099 };
+
+	AllocationTest::AllocationTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	AllocationTest::~AllocationTest()
+	{
+	}
+
+	std::string AllocationTest::Run()
+	{
+		try
+		{
+			CTR* cpr1 = new CTR(BlockCiphers::Rijndael);
+			CheckMode(cpr1);
+			delete cpr1;
+			ICM* cpr2 = new ICM(BlockCiphers::Rijndael);
+			CheckMode(cpr2);
+			delete cpr2;
+			CTRT<RHX>* cpr3 = new CTRT<RHX>();
+			CheckMode(cpr3);
+			delete cpr3;
+			OnProgress(std::string("AllocationTest: Passed CTR, ICM, and CTRT cipher mode transform tests.."));
+
+			CBC* cpr4 = new CBC(BlockCiphers::Rijndael);
+			CheckBlockMode(cpr4);
+			delete cpr4;
+			CFB* cpr5 = new CFB(BlockCiphers::Rijndael);
+			CheckBlockMode(cpr5);
+			delete cpr5;
+			OnProgress(std::string("AllocationTest: Passed CBC and CFB encryption and decryption tests.."));
+
+			GCM* aed1 = new GCM(BlockCiphers::Rijndael);
+			CheckAead(aed1, 12);
+			delete aed1;
+			EAX* aed2 = new EAX(BlockCiphers::Rijndael);
+			CheckAead(aed2, 16);
+			delete aed2;
+			OCB* aed3 = new OCB(BlockCiphers::Rijndael);
+			CheckAead(aed3, 12);
+			delete aed3;
+			OnProgress(std::string("AllocationTest: Passed GCM, EAX, and OCB transform, finalize and verify tests.."));
+
+			ChaCha20* str1 = new ChaCha20(20);
+			CheckStream(str1);
+			delete str1;
+			Salsa20* str2 = new Salsa20(20);
+			CheckStream(str2);
+			delete str2;
+			OnProgress(std::string("AllocationTest: Passed ChaCha20 and Salsa20 transform tests.."));
+
+			const Digests DIGESTS[9] = { Digests::Blake256, Digests::Blake512, Digests::Keccak256, Digests::Keccak512, Digests::SHA256, Digests::SHA512, Digests::Skein256, Digests::Skein512, Digests::Skein1024 };
+			for (size_t i = 0; i < 9; ++i)
+			{
+				IDigest* dgt = Helper::DigestFromName::GetInstance(DIGESTS[i]);
+				CheckDigest(dgt);
+				delete dgt;
+			}
+			OnProgress(std::string("AllocationTest: Passed Blake, Keccak, SHA2, and Skein update and finalize tests.."));
+
+			HMAC* mac1 = new HMAC(Digests::SHA256);
+			CheckMac(mac1);
+			delete mac1;
+			CMAC* mac2 = new CMAC(BlockCiphers::Rijndael);
+			CheckMac(mac2);
+			delete mac2;
+			GMAC* mac3 = new GMAC(BlockCiphers::Rijndael);
+			CheckMac(mac3);
+			delete mac3;
+			OnProgress(std::string("AllocationTest: Passed HMAC, CMAC, and GMAC update and finalize tests.."));
+
+			CheckRandom();
+			OnProgress(std::string("AllocationTest: Passed SecureRandom integer and array fill tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void AllocationTest::CheckAead(IAeadMode* Cipher, size_t NonceSize)
+	{
+		std::vector<byte> key(32, 0x33);
+		std::vector<byte> nonce(NonceSize, 0x11);
+		std::vector<byte> aad(20, 0x22);
+		std::vector<byte> msg(MSG_LENGTHS[3], 0x55);
+		std::vector<byte> enc(MSG_LENGTHS[3]);
+		std::vector<byte> dec(MSG_LENGTHS[3]);
+		std::vector<byte> tag(16);
+		SymmetricKey kp(key, nonce);
+
+		// each message is keyed; the Initialize calls are outside the measurement
+		Cipher->ParallelProfile().IsParallel() = false;
+		Cipher->Initialize(true, kp);
+		// warm up
+		Cipher->SetAssociatedData(aad, 0, aad.size());
+		Cipher->Transform(msg, 0, enc, 0, msg.size());
+		Cipher->Finalize(tag, 0, tag.size());
+
+		AllocationCount = 0;
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			Cipher->Initialize(true, kp);
+			CountEnabled = true;
+			Cipher->SetAssociatedData(aad, 0, aad.size());
+			Cipher->Transform(msg, 0, enc, 0, MSG_LENGTHS[i]);
+			Cipher->Finalize(tag, 0, tag.size());
+			CountEnabled = false;
+
+			Cipher->Initialize(false, kp);
+			CountEnabled = true;
+			Cipher->SetAssociatedData(aad, 0, aad.size());
+			Cipher->Transform(enc, 0, dec, 0, MSG_LENGTHS[i]);
+			const bool VERIFIED = Cipher->Verify(tag, 0, tag.size());
+			CountEnabled = false;
+
+			if (!VERIFIED)
+				throw TestException("CheckAead: The " + Cipher->Name() + " tag did not verify!");
+		}
+
+		if (AllocationCount != 0)
+			throw TestException("CheckAead: The " + Cipher->Name() + " transform allocated memory after initialization!");
+	}
+
+	void AllocationTest::CheckBlockMode(ICipherMode* Cipher)
+	{
+		std::vector<byte> key(32, 0x33);
+		std::vector<byte> iv(16, 0x11);
+		std::vector<byte> msg(BLOCK_LENGTHS[3], 0x55);
+		std::vector<byte> enc(BLOCK_LENGTHS[3]);
+		std::vector<byte> dec(BLOCK_LENGTHS[3]);
+		SymmetricKey kp(key, iv);
+
+		// sequential mode; spawning threads allocates
+		Cipher->ParallelProfile().IsParallel() = false;
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			const bool ENCRYPT = (i == 0);
+			Cipher->Initialize(ENCRYPT, kp);
+			// warm up
+			Cipher->Transform(ENCRYPT ? msg : enc, 0, ENCRYPT ? enc : dec, 0, msg.size());
+
+			AllocationCount = 0;
+			CountEnabled = true;
+
+			for (size_t j = 0; j < 4; ++j)
+				Cipher->Transform(ENCRYPT ? msg : enc, 0, ENCRYPT ? enc : dec, 0, BLOCK_LENGTHS[j]);
+
+			if (ENCRYPT)
+				Cipher->EncryptBlock(msg, 0, enc, 0);
+			else
+				Cipher->DecryptBlock(enc, 0, dec, 0);
+
+			CountEnabled = false;
+
+			if (AllocationCount != 0)
+				throw TestException("CheckBlockMode: The " + Cipher->Name() + (ENCRYPT ? " encryption" : " decryption") + " allocated memory after initialization!");
+		}
+	}
+
+	void AllocationTest::CheckDigest(IDigest* Digest)
+	{
+		std::vector<byte> msg(MSG_LENGTHS[3], 0x55);
+		std::vector<byte> code(Digest->DigestSize());
+
+		// warm up
+		Digest->Update(msg, 0, msg.size());
+		Digest->Finalize(code, 0);
+
+		AllocationCount = 0;
+		CountEnabled = true;
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			Digest->Update(msg, 0, MSG_LENGTHS[i]);
+			Digest->Finalize(code, 0);
+		}
+
+		CountEnabled = false;
+
+		if (AllocationCount != 0)
+			throw TestException("CheckDigest: The " + Digest->Name() + " digest allocated memory after initialization!");
+	}
+
+	void AllocationTest::CheckMac(IMac* Generator)
+	{
+		std::vector<byte> key(32, 0x33);
+		std::vector<byte> nonce(16, 0x11);
+		std::vector<byte> msg(MSG_LENGTHS[3], 0x55);
+		std::vector<byte> code(Generator->MacSize());
+		SymmetricKey kp(key, nonce);
+
+		// gmac clears its nonce on finalize, so each message is keyed outside the measurement
+		Generator->Initialize(kp);
+		// warm up
+		Generator->Update(msg, 0, msg.size());
+		Generator->Finalize(code, 0);
+
+		AllocationCount = 0;
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			Generator->Initialize(kp);
+			CountEnabled = true;
+			Generator->Update(msg, 0, MSG_LENGTHS[i]);
+			Generator->Finalize(code, 0);
+			CountEnabled = false;
+		}
+
+		if (AllocationCount != 0)
+			throw TestException("CheckMac: The " + Generator->Name() + " update or finalizer allocated memory after initialization!");
+	}
+
+	void AllocationTest::CheckMode(ICipherMode* Cipher)
+	{
+		std::vector<byte> key(32, 0x33);
+		std::vector<byte> iv(16, 0x11);
+		std::vector<byte> msg(MSG_LENGTHS[3], 0x55);
+		std::vector<byte> enc(MSG_LENGTHS[3]);
+		SymmetricKey kp(key, iv);
+
+		// sequential mode; spawning threads allocates
+		Cipher->ParallelProfile().IsParallel() = false;
+		Cipher->Initialize(true, kp);
+		// warm up
+		Cipher->Transform(msg, 0, enc, 0, msg.size());
+
+		AllocationCount = 0;
+		CountEnabled = true;
+
+		for (size_t i = 0; i < 4; ++i)
+			Cipher->Transform(msg, 0, enc, 0, MSG_LENGTHS[i]);
+
+		Cipher->EncryptBlock(msg, 0, enc, 0);
+		CountEnabled = false;
+
+		if (AllocationCount != 0)
+			throw TestException("CheckMode: The " + Cipher->Name() + " transform allocated memory after initialization!");
+	}
+
+	void AllocationTest::CheckRandom()
+	{
+		SecureRandom rnd;
+		std::vector<uint> output(1000);
+
+		// warm up
+		rnd.NextUInt32();
+
+		AllocationCount = 0;
+		CountEnabled = true;
+
+		// the internal buffer is smaller than the output; the integer functions read from the buffer
+		for (size_t i = 0; i < 500; ++i)
+		{
+			rnd.NextUInt16();
+			rnd.NextUInt32();
+			rnd.NextUInt64(1000000);
+		}
+
+		CountEnabled = false;
+
+		if (AllocationCount != 0)
+			throw TestException("CheckRandom: The SecureRandom integer functions allocated memory!");
+
+		AllocationCount = 0;
+		CountEnabled = true;
+		rnd.Fill(output, 0, output.size());
+		CountEnabled = false;
+
+		if (AllocationCount != 0)
+			throw TestException("CheckRandom: The SecureRandom Fill function allocated memory!");
+	}
+
+	void AllocationTest::CheckStream(IStreamCipher* Cipher)
+	{
+		std::vector<byte> key(32, 0x33);
+		std::vector<byte> iv(8, 0x11);
+		std::vector<byte> msg(MSG_LENGTHS[3], 0x55);
+		std::vector<byte> enc(MSG_LENGTHS[3]);
+		SymmetricKey kp(key, iv);
+
+		Cipher->ParallelProfile().IsParallel() = false;
+		Cipher->Initialize(kp);
+		// warm up
+		Cipher->Transform(msg, 0, enc, 0, msg.size());
+
+		AllocationCount = 0;
+		CountEnabled = true;
+
+		for (size_t i = 0; i < 4; ++i)
+			Cipher->Transform(msg, 0, enc, 0, MSG_LENGTHS[i]);
+
+		CountEnabled = false;
+
+		if (AllocationCount != 0)
+			throw TestException("CheckStream: The " + Cipher->Name() + " transform allocated memory after initialization!");
+	}
+
+	void AllocationTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
@@ -0,0 +1,76 @@
+#ifndef _CEXTEST_ALLOCATIONTEST_H
+#define _CEXTEST_ALLOCATIONTEST_H
+
+#include "ITest.h"
+#include "../CEX/IAeadMode.h"
+#include "../CEX/ICipherMode.h"
+#include "../CEX/IDigest.h"
+#include "../CEX/IMac.h"
+#include "../CEX/IStreamCipher.h"
+
+namespace Test
+{
+	using Cipher::Symmetric::Block::Mode::IAeadMode;
+	using Cipher::Symmetric::Block::Mode::ICipherMode;
+	using Digest::IDigest;
+	using Mac::IMac;
+	using Cipher::Symmetric::Stream::IStreamCipher;
+
+	/// <summary>
+	/// Tests that the cipher modes, stream ciphers, digests, and macs do not allocate memory once initialized.
+	/// <para>The global operator new is replaced in this test; allocations are counted while a measurement is active.
+	/// Each primitive is warmed up with a single call before the heap is monitored.
+	/// The Aead modes and Macs are keyed before each message; Initialize is not measured.</para>
+	/// </summary>
+	class AllocationTest : public ITest
+	{
+	private:
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+		// the block aligned lengths used by the CBC and CFB modes
+		static const size_t BLOCK_LENGTHS[4];
+		// the message lengths include partial blocks, and are shorter than the parallel block size
+		static const size_t MSG_LENGTHS[4];
+
+		TestEventHandler m_progressEvent;
+
+	public:
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		virtual const std::string Description() { return DESCRIPTION; }
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		virtual TestEventHandler &Progress() { return m_progressEvent; }
+
+		/// <summary>
+		/// Initialize this class
+		/// </summary>
+		AllocationTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~AllocationTest();
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		virtual std::string Run();
+
+	private:
+		void CheckAead(IAeadMode* Cipher, size_t NonceSize);
+		void CheckBlockMode(ICipherMode* Cipher);
+		void CheckDigest(IDigest* Digest);
+		void CheckMac(IMac* Generator);
+		void CheckMode(ICipherMode* Cipher);
+		void CheckRandom();
+		void CheckStream(IStreamCipher* Cipher);
+		void OnProgress(std::string Data);
+	};
+}
+
+#endif
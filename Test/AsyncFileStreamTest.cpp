@@ -0,0 +1,204 @@
+#include "AsyncFileStreamTest.h"
+#include "../CEX/AsyncFileStream.h"
+#include "../CEX/SecureRandom.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace Test
+{
+	using IO::AsyncFileStream;
+
+	const std::string AsyncFileStreamTest::DESCRIPTION = "AsyncFileStream test; compares write and read round trips and seeks on the io_uring and worker pool backends.";
+	const std::string AsyncFileStreamTest::FAILURE = "FAILURE! ";
+	const std::string AsyncFileStreamTest::SUCCESS = "SUCCESS! All AsyncFileStream tests have executed succesfully.";
+
+	AsyncFileStreamTest::AsyncFileStreamTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	AsyncFileStreamTest::~AsyncFileStreamTest()
+	{
+	}
+
+	std::string AsyncFileStreamTest::Run()
+	{
+		try
+		{
+			// the default backend is io_uring where the kernel supports it, and the worker pool otherwise
+			CompareTransfer(false, false, 1);
+			CompareTransfer(false, false, 8);
+			CompareTransfer(false, true, 8);
+			CheckSeek(false, false);
+			CheckSeek(false, true);
+			OnProgress(std::string("AsyncFileStreamTest: Passed default backend write, read, and seek tests.."));
+			CompareTransfer(true, false, 1);
+			CompareTransfer(true, false, 8);
+			CompareTransfer(true, true, 8);
+			CheckSeek(true, false);
+			CheckSeek(true, true);
+			OnProgress(std::string("AsyncFileStreamTest: Passed worker pool write, read, and seek tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(FAILURE + std::string(" : Unknown Error"));
+		}
+	}
+
+	void AsyncFileStreamTest::CheckSeek(bool Pooled, bool Direct)
+	{
+		const std::string FLEPTH = "async_seek.tmp";
+		const size_t BLKLEN = 8192;
+		Prng::SecureRandom rnd;
+		std::vector<byte> data((BLKLEN * 9) + 777);
+		rnd.GetBytes(data);
+
+		{
+			std::ofstream outFile(FLEPTH.c_str(), std::ios::binary | std::ios::trunc);
+			outFile.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		}
+
+		// aligned and unaligned positions, a position inside the final partial block, and a backwards seek
+		const size_t OFFSETS[] = { BLKLEN * 4, 1, (BLKLEN * 2) + 4095, data.size() - 500, 0, BLKLEN * 9 };
+		std::vector<byte> tmp(BLKLEN + 123);
+		bool status = true;
+
+		{
+			AsyncFileStream inpFile(FLEPTH, AsyncFileStream::FileAccess::Read, BLKLEN, 4, Direct, Pooled);
+
+			for (size_t i = 0; i < sizeof(OFFSETS) / sizeof(size_t); ++i)
+			{
+				inpFile.Seek(OFFSETS[i], IO::SeekOrigin::Begin);
+				const size_t EXPLEN = std::min(tmp.size(), data.size() - OFFSETS[i]);
+				const size_t RDLEN = inpFile.Read(tmp, 0, tmp.size());
+
+				if (RDLEN != EXPLEN || inpFile.Position() != OFFSETS[i] + EXPLEN || !std::equal(tmp.begin(), tmp.begin() + EXPLEN, data.begin() + OFFSETS[i]))
+				{
+					status = false;
+					break;
+				}
+			}
+
+			inpFile.Close();
+		}
+
+		std::remove(FLEPTH.c_str());
+
+		if (!status)
+		{
+			throw TestException("AsyncFileStreamTest: The seek output is not equal!");
+		}
+	}
+
+	void AsyncFileStreamTest::CompareTransfer(bool Pooled, bool Direct, size_t QueueDepth)
+	{
+		const std::string FLEPTH = "async_transfer.tmp";
+		const size_t BLKLEN = 16384;
+		Prng::SecureRandom rnd;
+		// several passes through the ring, with a partial final block
+		std::vector<byte> data((BLKLEN * 13) + rnd.NextInt32(BLKLEN - 1, 1));
+		rnd.GetBytes(data);
+
+		// uneven writes, so the buffers are filled across call boundaries, and some calls submit several blocks
+		{
+			AsyncFileStream outFile(FLEPTH, AsyncFileStream::FileAccess::Write, BLKLEN, QueueDepth, Direct, Pooled);
+
+			if (Pooled && outFile.IsUring())
+			{
+				std::remove(FLEPTH.c_str());
+				throw TestException("AsyncFileStreamTest: The pooled stream selected io_uring!");
+			}
+
+			size_t prcLen = 0;
+			size_t wrtLen = 1;
+
+			while (prcLen != data.size())
+			{
+				wrtLen = std::min((wrtLen * 7) % (BLKLEN * 3) + 1, data.size() - prcLen);
+				outFile.Write(data, prcLen, wrtLen);
+				prcLen += wrtLen;
+			}
+
+			if (outFile.Position() != data.size())
+			{
+				std::remove(FLEPTH.c_str());
+				throw TestException("AsyncFileStreamTest: The write position is invalid!");
+			}
+
+			outFile.Close();
+		}
+
+		// the file is compared with a standard reader, so the padding of a direct write must be truncated
+		std::vector<byte> tmp;
+
+		{
+			std::ifstream inpFile(FLEPTH.c_str(), std::ios::binary);
+			tmp.assign(std::istreambuf_iterator<char>(inpFile), std::istreambuf_iterator<char>());
+		}
+
+		if (tmp != data)
+		{
+			std::remove(FLEPTH.c_str());
+			throw TestException("AsyncFileStreamTest: The written file is not equal!");
+		}
+
+		// uneven reads, including reads that span several buffers
+		{
+			AsyncFileStream inpFile(FLEPTH, AsyncFileStream::FileAccess::Read, BLKLEN, QueueDepth, Direct, Pooled);
+			size_t prcLen = 0;
+			size_t rdLen = 1;
+
+			tmp.clear();
+			tmp.resize(data.size());
+
+			if (inpFile.Length() != data.size())
+			{
+				std::remove(FLEPTH.c_str());
+				throw TestException("AsyncFileStreamTest: The read length is invalid!");
+			}
+
+			while (prcLen != data.size())
+			{
+				rdLen = (rdLen * 5) % (BLKLEN * 3) + 1;
+				const size_t RDLEN = inpFile.Read(tmp, prcLen, std::min(rdLen, data.size() - prcLen));
+
+				if (RDLEN == 0)
+				{
+					break;
+				}
+
+				prcLen += RDLEN;
+			}
+
+			// a read at the end of the file returns nothing
+			std::vector<byte> end(16);
+			const size_t ENDLEN = inpFile.Read(end, 0, end.size());
+			inpFile.Close();
+			std::remove(FLEPTH.c_str());
+
+			if (prcLen != data.size() || ENDLEN != 0)
+			{
+				throw TestException("AsyncFileStreamTest: The read length is invalid!");
+			}
+		}
+
+		if (tmp != data)
+		{
+			throw TestException("AsyncFileStreamTest: The read output is not equal!");
+		}
+	}
+
+	void AsyncFileStreamTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
@@ -0,0 +1,54 @@
+#ifndef _CEXTEST_ASYNCFILESTREAMTEST_H
+#define _CEXTEST_ASYNCFILESTREAMTEST_H
+
+#include "ITest.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the AsyncFileStream write and read round trips, and seeking, on the io_uring and the worker pool backends.
+	/// <para>Each backend is run with buffered and direct I/O, and with a single buffer and a full ring.</para>
+	/// </summary>
+	class AsyncFileStreamTest : public ITest
+	{
+	private:
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		TestEventHandler m_progressEvent;
+
+	public:
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		virtual const std::string Description() { return DESCRIPTION; }
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		virtual TestEventHandler &Progress() { return m_progressEvent; }
+
+		/// <summary>
+		/// Initialize this class
+		/// </summary>
+		AsyncFileStreamTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~AsyncFileStreamTest();
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		virtual std::string Run();
+
+	private:
+		void CheckSeek(bool Pooled, bool Direct);
+		void CompareTransfer(bool Pooled, bool Direct, size_t QueueDepth);
+		void OnProgress(std::string Data);
+	};
+}
+
+#endif
@@ -3,7 +3,9 @@
 #include "../CEX/CSP.h"
 #include "../CEX/Blake256.h"
 #include "../CEX/Blake512.h"
+#include "../CEX/Blake2Mac.h"
 #include "../CEX/SymmetricKey.h"
+#include <algorithm>
 #include <fstream>
 #include <string>
 
@@ -41,15 +43,32 @@ namespace Test
 			OnProgress(std::string("Passed Blake2Params parameter serialization test.."));
 			MacParamsTest();
 			OnProgress(std::string("Passed SymmetricKey cloning test.."));
+			MacSaltInfoTest();
+			OnProgress(std::string("Passed Blake2Mac salt and info known answer tests.."));
 			Blake2STest();
-			OnProgress(std::string("Passed Blake2-S 256 vector tests.."));
+			OnProgress(std::string("Passed Blake2-S 256 and Blake2Mac vector tests.."));
 			Blake2SPTest();
 			OnProgress(std::string("Passed Blake2-SP 256 vector tests.."));
 			Blake2BTest();
-			OnProgress(std::string("Passed Blake2-B 512 vector tests.."));
+			OnProgress(std::string("Passed Blake2-B 512 and Blake2Mac vector tests.."));
 			Blake2BPTest();
 			OnProgress(std::string("Passed Blake2-BP 512 vector tests.."));    
 
+			Blake256 bls1;
+			Blake256 bls2;
+			if (!TestUtils::CompareState(&bls1, &bls2))
+				throw TestException("Blake2Test: The resumed digest state hash is not equal!");
+			Blake512 blp1(true);
+			Blake512 blp2(true);
+			if (!TestUtils::CompareState(&blp1, &blp2))
+				throw TestException("Blake2Test: The resumed digest state hash is not equal!");
+			OnProgress(std::string("Passed Blake2 state serialization tests.."));
+			CompareKeyedState(Enumeration::Digests::Blake256, false);
+			CompareKeyedState(Enumeration::Digests::Blake256, true);
+			CompareKeyedState(Enumeration::Digests::Blake512, false);
+			CompareKeyedState(Enumeration::Digests::Blake512, true);
+			OnProgress(std::string("Passed Blake2Mac keyed state serialization tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -68,6 +87,8 @@ namespace Test
 		if (!stream)
 			throw TestException("Could not open file: " + BLAKE2BKAT);
 
+		// the keyed kats are repeated through a single Mac instance, which is re-keyed by each Finalize call
+		Mac::Blake2Mac mac(Enumeration::Digests::Blake512);
 		std::string line;
 
 		while (std::getline(stream, line))
@@ -102,6 +123,14 @@ namespace Test
 
 					if (hash != expect)
 						throw TestException("Blake2BTest: KAT test has failed!");
+
+					if (!mac.IsInitialized())
+						mac.Initialize(mkey);
+
+					mac.Compute(input, hash);
+
+					if (hash != expect)
+						throw TestException("Blake2BTest: Blake2Mac KAT test has failed!");
 				}
 			}
 		}
@@ -165,6 +194,8 @@ namespace Test
 		if (!stream)
 			throw TestException("Could not open file: " + BLAKE2SKAT);
 
+		// the keyed kats are repeated through a single Mac instance, which is re-keyed by each Finalize call
+		Mac::Blake2Mac mac(Enumeration::Digests::Blake256);
 		std::string line;
 
 		while (std::getline(stream, line))
@@ -199,6 +230,14 @@ namespace Test
 
 					if (hash != expect)
 						throw TestException("Blake2STest: KAT test has failed!");
+
+					if (!mac.IsInitialized())
+						mac.Initialize(mkey);
+
+					mac.Compute(input, hash);
+
+					if (hash != expect)
+						throw TestException("Blake2STest: Blake2Mac KAT test has failed!");
 				}
 			}
 		}
@@ -253,6 +292,95 @@ namespace Test
 		stream.close();
 	}
 
+	void Blake2Test::CompareKeyedState(Enumeration::Digests DigestType, bool Parallel)
+	{
+		const size_t KEYLEN = (DigestType == Enumeration::Digests::Blake256) ? 32 : 64;
+		const size_t MSGLEN = 4096 + 13;
+		std::vector<byte> input(MSGLEN);
+		std::vector<byte> info(KEYLEN / 4, 0x5A);
+		std::vector<byte> key(KEYLEN);
+		std::vector<byte> salt(KEYLEN / 4, 0xA5);
+
+		for (size_t i = 0; i < input.size(); ++i)
+			input[i] = (byte)i;
+		for (size_t i = 0; i < key.size(); ++i)
+			key[i] = (byte)(0xF0 - i);
+
+		Key::Symmetric::SymmetricKey mkey(key, salt, info);
+		Mac::Blake2Mac mac1(DigestType, Parallel);
+		Mac::Blake2Mac mac2(DigestType, Parallel);
+		std::vector<byte> hash1(mac1.MacSize());
+		std::vector<byte> hash2(mac1.MacSize());
+		const size_t CUTS[5] = { 0, 1, mac1.BlockSize(), (MSGLEN / 2) + 3, MSGLEN - 1 };
+
+		mac1.Initialize(mkey);
+		mac1.Compute(input, hash1);
+
+		// the salt and info are applied to the node configuration
+		Key::Symmetric::SymmetricKey ukey(key);
+		mac2.Initialize(ukey);
+		mac2.Compute(input, hash2);
+
+		if (hash1 == hash2)
+			throw TestException("Blake2Test: The salt and info parameters were not applied!");
+
+		for (size_t i = 0; i < 5; ++i)
+		{
+			// checkpoint the first mac, and resume the message on a second mac initialized with the same key
+			mac1.Initialize(mkey);
+			mac1.Update(input, 0, CUTS[i]);
+			std::vector<byte> state = mac1.SaveState();
+
+			if (std::search(state.begin(), state.end(), key.begin(), key.end()) != state.end())
+				throw TestException("Blake2Test: The keyed state contains the mac key!");
+
+			mac2.Initialize(mkey);
+			mac2.LoadState(state);
+			mac2.Update(input, CUTS[i], MSGLEN - CUTS[i]);
+			mac2.Finalize(hash2, 0);
+
+			if (hash1 != hash2)
+				throw TestException("Blake2Test: The resumed keyed state hash is not equal!");
+
+			// a state created under a different key length is rejected
+			std::vector<byte> skey(KEYLEN / 2, 1);
+			Key::Symmetric::SymmetricKey shtkey(skey);
+			mac2.Initialize(shtkey);
+			bool status = false;
+
+			try
+			{
+				mac2.LoadState(state);
+			}
+			catch (...)
+			{
+				status = true;
+			}
+
+			if (!status)
+				throw TestException("Blake2Test: A state with mismatched tree parameters was accepted!");
+		}
+
+		// a state with the key block still pending is rejected by a mac that has already compressed its key
+		mac1.Initialize(mkey);
+		std::vector<byte> kstate = mac1.SaveState();
+		mac2.Initialize(mkey);
+		mac2.Update(input, 0, MSGLEN);
+		bool status = false;
+
+		try
+		{
+			mac2.LoadState(kstate);
+		}
+		catch (...)
+		{
+			status = true;
+		}
+
+		if (!status)
+			throw TestException("Blake2Test: A pending key state was loaded into a mac that has absorbed data!");
+	}
+
 	void Blake2Test::MacParamsTest()
 	{
 		std::vector<byte> key(64);
@@ -266,6 +394,50 @@ namespace Test
 			throw TestException("Blake2STest: Mac parameters test failed!");
 	}
 
+	void Blake2Test::MacSaltInfoTest()
+	{
+		// the keyed Blake2-S and Blake2-B hashes of 00 01 .. FE, with the key 00 01 .., the salt A0 A1 .., and the info (personalization) B0 B1 ..;
+		// the expected values were generated with the python hashlib blake2s and blake2b functions
+		const char* expectedEnc[2] =
+		{
+			("6C2CADF116C0C1F3CB7D11F3B8751AE5A3CC724FD21C779626203BCC58F3CD58"),
+			("05C344A47D8F5EA0A4EC77F4C4DE2C2D4BD613370F04514AED6C0CE7F8B6C316167D343FDDD9070F6AC8397E111F854F445A1540D140230DD7506CB78FA772A2")
+		};
+		HexConverter::Decode(expectedEnc, 2, m_expected);
+
+		std::vector<byte> input(255);
+
+		for (size_t i = 0; i < input.size(); ++i)
+			input[i] = (byte)i;
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			const Enumeration::Digests DGTTYPE = (i == 0) ? Enumeration::Digests::Blake256 : Enumeration::Digests::Blake512;
+			const size_t KEYLEN = (i == 0) ? 32 : 64;
+			std::vector<byte> info(KEYLEN / 4);
+			std::vector<byte> key(KEYLEN);
+			std::vector<byte> salt(KEYLEN / 4);
+
+			for (size_t j = 0; j < key.size(); ++j)
+				key[j] = (byte)j;
+			for (size_t j = 0; j < salt.size(); ++j)
+			{
+				salt[j] = (byte)(0xA0 + j);
+				info[j] = (byte)(0xB0 + j);
+			}
+
+			Key::Symmetric::SymmetricKey mkey(key, salt, info);
+			Mac::Blake2Mac mac(DGTTYPE, false);
+			std::vector<byte> hash(mac.MacSize());
+
+			mac.Initialize(mkey);
+			mac.Compute(input, hash);
+
+			if (hash != m_expected[i])
+				throw TestException("Blake2Test: The Blake2Mac salt and info KAT test has failed!");
+		}
+	}
+
 	void Blake2Test::TreeParamsTest()
 	{
 		std::vector<byte> code1(40, 7);
@@ -2,6 +2,7 @@
 #define _BLAKE2TEST_BLAKETEST_H
 
 #include "ITest.h"
+#include "../CEX/IDigest.h"
 
 namespace Test
 {
@@ -56,7 +57,9 @@ namespace Test
 		void Blake2BPTest();
 		void Blake2STest();
 		void Blake2SPTest();
+		void CompareKeyedState(Enumeration::Digests DigestType, bool Parallel);
 		void MacParamsTest();
+		void MacSaltInfoTest();
 		void TreeParamsTest();
 		void OnProgress(std::string Data);
 	};
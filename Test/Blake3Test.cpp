@@ -0,0 +1,223 @@
+#include "Blake3Test.h"
+#include "../CEX/Blake3.h"
+#include "../CEX/DigestFromName.h"
+
+namespace Test
+{
+	using Digest::Blake3;
+
+	const std::string Blake3Test::DESCRIPTION = "BLAKE3 Test Vectors; hash, keyed hash, and extendable output modes.";
+	const std::string Blake3Test::FAILURE = "FAILURE! ";
+	const std::string Blake3Test::SUCCESS = "SUCCESS! All BLAKE3 tests have executed succesfully.";
+
+	Blake3Test::Blake3Test()
+		:
+		m_expected(0),
+		m_progressEvent()
+	{
+	}
+
+	Blake3Test::~Blake3Test()
+	{
+	}
+
+	std::string Blake3Test::Run()
+	{
+		const size_t MSGLEN[14] = { 0, 1, 63, 64, 65, 1023, 1024, 1025, 2048, 2049, 8193, 16384, 31744, 102400 };
+		const size_t KEYLEN[5] = { 0, 1, 1024, 8193, 102400 };
+		const size_t XOFLEN[3] = { 0, 1025, 31744 };
+
+		try
+		{
+			Initialize();
+
+			Blake3* dgt = new Blake3;
+			for (size_t i = 0; i < 14; ++i)
+			{
+				std::vector<byte> msg = Pattern(MSGLEN[i]);
+				CompareVector(dgt, msg, m_expected[i]);
+			}
+			delete dgt;
+			OnProgress(std::string("Blake3Test: Passed BLAKE3 message vector tests.."));
+
+			const std::string KEYSTR = "whats the Elvish word for friend";
+			std::vector<byte> key(KEYSTR.begin(), KEYSTR.end());
+			Blake3 kdgt(key);
+			for (size_t i = 0; i < 5; ++i)
+			{
+				std::vector<byte> msg = Pattern(KEYLEN[i]);
+				CompareVector(&kdgt, msg, m_expected[i + 14]);
+			}
+			OnProgress(std::string("Blake3Test: Passed BLAKE3 keyed hashing tests.."));
+
+			for (size_t i = 0; i < 3; ++i)
+			{
+				std::vector<byte> msg = Pattern(XOFLEN[i]);
+				CompareXof(msg, m_expected[i + 19]);
+			}
+			OnProgress(std::string("Blake3Test: Passed BLAKE3 extendable output tests.."));
+
+			IDigest* idgt = Helper::DigestFromName::GetInstance(Enumeration::Digests::Blake3);
+			std::vector<byte> msg = Pattern(MSGLEN[13]);
+			CompareVector(idgt, msg, m_expected[13]);
+			delete idgt;
+
+			CompareStream(msg, m_expected[13]);
+			OnProgress(std::string("Blake3Test: Passed BLAKE3 incremental update tests.."));
+			CompareState(msg, m_expected[13]);
+			OnProgress(std::string("Blake3Test: Passed BLAKE3 state serialization tests.."));
+			CompareParallel(msg, m_expected[13]);
+			OnProgress(std::string("Blake3Test: Passed BLAKE3 multi-threaded tree hashing tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void Blake3Test::CompareParallel(std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		std::vector<byte> hash(32);
+		Blake3 dgt(true);
+
+		// the threaded path is forced on single core systems; the hash does not depend on the thread count
+		if (!dgt.IsParallel())
+			dgt.ParallelProfile().IsParallel() = true;
+
+		for (size_t i = 2; i <= 4; i += 2)
+		{
+			dgt.ParallelMaxDegree(i);
+			dgt.Compute(Input, hash);
+
+			if (hash != Expected)
+				throw TestException("Blake3Test: The parallel hash is not equal!");
+
+			// a misaligned input runs the buffered, threaded, and grouped paths in one update
+			dgt.Update(Input, 0, 1);
+			dgt.Update(Input, 1, Input.size() - 1);
+			dgt.Finalize(hash, 0);
+
+			if (hash != Expected)
+				throw TestException("Blake3Test: The misaligned parallel hash is not equal!");
+		}
+	}
+
+	void Blake3Test::CompareState(std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		const size_t CUTS[3] = { 500, 9000, 50000 };
+		std::vector<byte> hash(32);
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			Blake3 dgt1;
+			Blake3 dgt2;
+
+			// checkpoint inside the first chunk, the message buffer, and with a populated chaining value stack
+			dgt1.Update(Input, 0, CUTS[i]);
+			dgt2.LoadState(dgt1.SaveState());
+			dgt2.Update(Input, CUTS[i], Input.size() - CUTS[i]);
+			dgt2.Finalize(hash, 0);
+
+			if (hash != Expected)
+				throw TestException("Blake3Test: The restored state hash is not equal!");
+		}
+	}
+
+	void Blake3Test::CompareStream(std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		const size_t CUTS[6] = { 1, 63, 64, 1023, 1025, 16385 };
+		std::vector<byte> hash(32);
+		Blake3 dgt;
+		size_t pos = 0;
+
+		for (size_t i = 0; pos < Input.size(); ++i)
+		{
+			const size_t LEN = (std::min)(CUTS[i % 6], Input.size() - pos);
+			dgt.Update(Input, pos, LEN);
+			pos += LEN;
+		}
+
+		dgt.Finalize(hash, 0);
+
+		if (hash != Expected)
+			throw TestException("Blake3Test: The incremental hash is not equal!");
+	}
+
+	void Blake3Test::CompareVector(IDigest* Digest, std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		std::vector<byte> hash(Digest->DigestSize(), 0);
+
+		Digest->Update(Input, 0, Input.size());
+		Digest->Finalize(hash, 0);
+
+		if (Expected != hash)
+			throw TestException("Blake3Test: Expected hash is not equal!");
+	}
+
+	void Blake3Test::CompareXof(std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		std::vector<byte> output(Expected.size(), 0);
+		Blake3 dgt;
+
+		dgt.Update(Input, 0, Input.size());
+		dgt.Finalize(output, 0, output.size());
+
+		if (Expected != output)
+			throw TestException("Blake3Test: Expected output is not equal!");
+	}
+
+	void Blake3Test::Initialize()
+	{
+		const char* expectedEnc[22] =
+		{
+			// M = ptn(n), for n = 0, 1, 63, 64, 65, 1023, 1024, 1025, 2048, 2049, 8193, 16384, 31744, 102400
+			("AF1349B9F5F9A1A6A0404DEA36DCC9499BCB25C9ADC112B7CC9A93CAE41F3262"),
+			("2D3ADEDFF11B61F14C886E35AFA036736DCD87A74D27B5C1510225D0F592E213"),
+			("E9BC37A594DAAD83BE9470DF7F7B3798297C3D834CE80BA85D6E207627B7DB7B"),
+			("4EED7141EA4A5CD4B788606BD23F46E212AF9CACEBACDC7D1F4C6DC7F2511B98"),
+			("DE1E5FA0BE70DF6D2BE8FFFD0E99CEAA8EB6E8C93A63F2D8D1C30ECB6B263DEE"),
+			("10108970EEDA3EB932BAAC1428C7A2163B0E924C9A9E25B35BBA72B28F70BD11"),
+			("42214739F095A406F3FC83DEB889744AC00DF831C10DAA55189B5D121C855AF7"),
+			("D00278AE47EB27B34FAECF67B4FE263F82D5412916C1FFD97C8CB7FB814B8444"),
+			("E776B6028C7CD22A4D0BA182A8BF62205D2EF576467E838ED6F2529B85FBA24A"),
+			("5F4D72F40D7A5F82B15CA2B2E44B1DE3C2EF86C426C95C1AF0B6879522563030"),
+			("BAB6C09CB8CE8CF459261398D2E7AEF35700BF488116CEB94A36D0F5F1B7BC3B"),
+			("F875D6646DE28985646F34EE13BE9A576FD515F76B5B0A26BB324735041DDDE4"),
+			("62B6960E1A44BCC1EB1A611A8D6235B6B4B78F32E7ABC4FB4C6CDCCE94895C47"),
+			("BC3E3D41A1146B069ABFFAD3C0D44860CF664390AFCE4D9661F7902E7943E085"),
+			// keyed hash, K = "whats the Elvish word for friend", M = ptn(n), for n = 0, 1, 1024, 8193, 102400
+			("92B2B75604ED3C761F9D6F62392C8A9227AD0EA3F09573E783F1498A4ED60D26"),
+			("6D7878DFFF2F485635D39013278AE14F1454B8C0A3A2D34BC1AB38228A80C95B"),
+			("75C46F6F3D9EB4F55ECAAEE480DB732E6C2105546F1E675003687C31719C7BA4"),
+			("954A2A75420C8D6547E3BA5B98D963E6FA6491ADDC8C023189CC519821B4A1F5"),
+			("1C35D1A5811083FD7119F5D5D1BA027B4D01C0C6C49FB6FF2CF75393EA5DB4A7"),
+			// 131 byte extended output, M = ptn(n), for n = 0, 1025, 31744
+			("AF1349B9F5F9A1A6A0404DEA36DCC9499BCB25C9ADC112B7CC9A93CAE41F3262E00F03E7B69AF26B7FAAF09FCD333050338DDFE085B8CC869CA98B206C08243A26F5487789E8F660AFE6C99EF9E0C52B92E7393024A80459CF91F476F9FFDBDA7001C22E159B402631F277CA96F2DEFDF1078282314E763699A31C5363165421CCE14D"),
+			("D00278AE47EB27B34FAECF67B4FE263F82D5412916C1FFD97C8CB7FB814B8444F4C4A22B4B399155358A994E52BF255DE60035742EC71BD08AC275A1B51CC6BFE332B0EF84B409108CDA080E6269ED4B3E2C3F7D722AA4CDC98D16DEB554E5627BE8F955C98E1D5F9565A9194CAD0C4285F93700062D9595ADB992AE68FF12800AB67A"),
+			("62B6960E1A44BCC1EB1A611A8D6235B6B4B78F32E7ABC4FB4C6CDCCE94895C47860CC51F2B0C28A7B77304BD55FE73AF663C02D3F52EA053BA43431CA5BAB7BFEA2F5E9D7121770D88F70AE9649EA713087D1914F7F312147E247F87EB2D4FFEF0AC978BF7B6579D57D533355AA20B8B77B13FD09748728A5CC327A8EC470F4013226F")
+		};
+		HexConverter::Decode(expectedEnc, 22, m_expected);
+	}
+
+	void Blake3Test::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	std::vector<byte> Blake3Test::Pattern(size_t Length)
+	{
+		// ptn(n); the repeating byte sequence 00 01 .. FA
+		std::vector<byte> msg(Length);
+
+		for (size_t i = 0; i < Length; ++i)
+			msg[i] = static_cast<byte>(i % 251);
+
+		return msg;
+	}
+}
@@ -0,0 +1,65 @@
+#ifndef _CEXTEST_BLAKE3TEST_H
+#define _CEXTEST_BLAKE3TEST_H
+
+#include "ITest.h"
+#include "../CEX/IDigest.h"
+
+namespace Test
+{
+	using CEX::Digest::IDigest;
+
+	/// <summary>
+	/// BLAKE3 implementation vector comparison tests.
+	/// <para>Using the official BLAKE3 test vector inputs and key:
+	/// <see href="https://github.com/BLAKE3-team/BLAKE3/blob/master/test_vectors/test_vectors.json"/>,
+	/// with additional chunk and tree boundary vectors generated with the reference implementation.</para>
+	/// </summary>
+	class Blake3Test : public ITest
+	{
+	private:
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<std::vector<byte>> m_expected;
+		TestEventHandler m_progressEvent;
+
+	public:
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		virtual const std::string Description() { return DESCRIPTION; }
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		virtual TestEventHandler &Progress() { return m_progressEvent; }
+
+		/// <summary>
+		/// Compares known answer BLAKE3 vectors for equality
+		/// </summary>
+		Blake3Test();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~Blake3Test();
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		virtual std::string Run();
+
+	private:
+		void CompareParallel(std::vector<byte> &Input, std::vector<byte> &Expected);
+		void CompareState(std::vector<byte> &Input, std::vector<byte> &Expected);
+		void CompareStream(std::vector<byte> &Input, std::vector<byte> &Expected);
+		void CompareVector(IDigest* Digest, std::vector<byte> &Input, std::vector<byte> &Expected);
+		void CompareXof(std::vector<byte> &Input, std::vector<byte> &Expected);
+		void Initialize();
+		void OnProgress(std::string Data);
+		std::vector<byte> Pattern(size_t Length);
+	};
+}
+
+#endif
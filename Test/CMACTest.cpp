@@ -48,6 +48,13 @@ namespace Test
 			CompareAccess(m_keys[2]);
 			OnProgress(std::string("Passed Finalize/Compute methods output comparison.."));
 
+			Mac::CMAC mac1(Enumeration::BlockCiphers::Rijndael);
+			Mac::CMAC mac2(Enumeration::BlockCiphers::Rijndael);
+			SymmetricKey kp(m_keys[2]);
+			if (!TestUtils::CompareState(&mac1, &mac2, kp))
+				throw TestException("CMACTest: The resumed mac state code is not equal!");
+			OnProgress(std::string("CMACTest: Passed CMAC state serialization tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -1,8 +1,15 @@
 #include "CipherModeTest.h"
+#if defined(__AVX__)
+#	include "../CEX/AHX.h"
+#endif
 #include "../CEX/CBC.h"
 #include "../CEX/CFB.h"
+#include "../CEX/CpuDetect.h"
 #include "../CEX/CTR.h"
+#include "../CEX/CTRT.h"
 #include "../CEX/ECB.h"
+#include "../CEX/ICM.h"
+#include "../CEX/ICMT.h"
 #include "../CEX/OFB.h"
 #include "../CEX/RHX.h"
 
@@ -10,7 +17,7 @@ namespace Test
 {
 	using namespace Cipher::Symmetric::Block;
 
-	const std::string CipherModeTest::DESCRIPTION = "NIST SP800-38A KATs testing CBC, CFB, CTR, ECB, and OFB modes.";
+	const std::string CipherModeTest::DESCRIPTION = "NIST SP800-38A KATs testing CBC, CFB, CTR, ECB, and OFB modes, and the cipher specialized CTRT and ICMT modes.";
 	const std::string CipherModeTest::FAILURE = "FAILURE! ";
 	const std::string CipherModeTest::SUCCESS = "SUCCESS! Cipher Mode tests have executed succesfully.";
 
@@ -33,6 +40,7 @@ namespace Test
 		try
 		{
 			Initialize();
+			Common::CpuDetect detect;
 
 			// test modes with each key (128/192/256)
 			CompareCBC(m_keys[0], m_input, m_output);
@@ -50,11 +58,44 @@ namespace Test
 			CompareCTR(m_keys[2], m_input, m_output);
 			OnProgress(std::string("CipherModeTest: Passed CTR 128/192/256 bit key encryption/decryption tests.."));
 
+			Mode::CTRT<RHX>* cpr1 = new Mode::CTRT<RHX>();
+			CompareCTRT(cpr1, m_keys[0], m_input, m_output);
+			CompareCTRT(cpr1, m_keys[1], m_input, m_output);
+			CompareCTRT(cpr1, m_keys[2], m_input, m_output);
+			delete cpr1;
+#if defined(__AVX__)
+			if (detect.AESNI())
+			{
+				Mode::CTRT<AHX>* cpr2 = new Mode::CTRT<AHX>();
+				CompareCTRT(cpr2, m_keys[0], m_input, m_output);
+				CompareCTRT(cpr2, m_keys[1], m_input, m_output);
+				CompareCTRT(cpr2, m_keys[2], m_input, m_output);
+				delete cpr2;
+			}
+#endif
+			OnProgress(std::string("CipherModeTest: Passed CTRT 128/192/256 bit key encryption/decryption tests.."));
+
 			CompareECB(m_keys[0], m_input, m_output);
 			CompareECB(m_keys[1], m_input, m_output);
 			CompareECB(m_keys[2], m_input, m_output);
 			OnProgress(std::string("CipherModeTest: Passed ECB 128/192/256 bit key encryption/decryption tests.."));
 
+			Mode::ICM* cpr3 = new Mode::ICM(Enumeration::BlockCiphers::Rijndael);
+			CompareICM(cpr3);
+			delete cpr3;
+			Mode::ICMT<RHX>* cpr4 = new Mode::ICMT<RHX>();
+			CompareICM(cpr4);
+			delete cpr4;
+#if defined(__AVX__)
+			if (detect.AESNI())
+			{
+				Mode::ICMT<AHX>* cpr5 = new Mode::ICMT<AHX>();
+				CompareICM(cpr5);
+				delete cpr5;
+			}
+#endif
+			OnProgress(std::string("CipherModeTest: Passed ICM and ICMT key stream tests.."));
+
 			CompareOFB(m_keys[0], m_input, m_output);
 			CompareOFB(m_keys[1], m_input, m_output);
 			CompareOFB(m_keys[2], m_input, m_output);
@@ -232,6 +273,48 @@ namespace Test
 		}
 	}
 
+	void CipherModeTest::CompareCTRT(ICipherMode* Cipher, std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output)
+	{
+		std::vector<byte> outBytes(16, 0);
+		std::vector<byte> &iv = m_vectors[1];
+		int index = 24;
+
+		if (Key.size() == 24)
+		{
+			index = 26;
+		}
+		else if (Key.size() == 32)
+		{
+			index = 28;
+		}
+
+		Key::Symmetric::SymmetricKey k(Key, iv);
+		Cipher->Initialize(true, k);
+
+		for (size_t i = 0; i < 4; i++)
+		{
+			Cipher->Transform(Input[index][i], 0, outBytes, 0, outBytes.size());
+
+			if (outBytes != Output[index][i])
+			{
+				throw TestException("CTRT Mode: Encrypted arrays are not equal!");
+			}
+		}
+
+		index++;
+		Cipher->Initialize(false, k);
+
+		for (size_t i = 0; i < 4; i++)
+		{
+			Cipher->Transform(Input[index][i], 0, outBytes, 0, outBytes.size());
+
+			if (outBytes != Output[index][i])
+			{
+				throw TestException("CTRT Mode: Decrypted arrays are not equal!");
+			}
+		}
+	}
+
 	void CipherModeTest::CompareECB(std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output)
 	{
 		std::vector<byte> outBytes(16, 0);
@@ -285,6 +368,40 @@ namespace Test
 		}
 	}
 
+	void CipherModeTest::CompareICM(ICipherMode* Cipher)
+	{
+		std::vector<byte> dec(48, 0);
+		std::vector<byte> enc(48, 0);
+		std::vector<byte> exp;
+		std::vector<byte> iv;
+		std::vector<byte> key;
+		std::vector<byte> msg(48, 0);
+
+		HexConverter::Decode("000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F", key);
+		HexConverter::Decode("00112233445566778899AABBCCDDEEFF", iv);
+		// the counter words are incremented as little-endian integers; the first block is the FIPS-197 C.3 cipher-text
+		HexConverter::Decode("8EA2B7CA516745BFEAFC49904B49608981AE7D5E4138BF730D2A8871FEC2CD0C0F510F50B20995C5731FEB5B94C84EAF", exp);
+
+		Key::Symmetric::SymmetricKey k(key, iv);
+		Cipher->Initialize(true, k);
+		// the counter is carried into the next call
+		Cipher->Transform(msg, 0, enc, 0, 16);
+		Cipher->Transform(msg, 16, enc, 16, enc.size() - 16);
+
+		if (enc != exp)
+		{
+			throw TestException("ICM Mode: Encrypted arrays are not equal!");
+		}
+
+		Cipher->Initialize(false, k);
+		Cipher->Transform(enc, 0, dec, 0, dec.size());
+
+		if (dec != msg)
+		{
+			throw TestException("ICM Mode: Decrypted arrays are not equal!");
+		}
+	}
+
 	void CipherModeTest::CompareOFB(std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output)
 	{
 		std::vector<byte> outBytes(16, 0);
@@ -2,9 +2,12 @@
 #define _CEXTEST_CIPHERMODETEST_H
 
 #include "ITest.h"
+#include "../CEX/ICipherMode.h"
 
 namespace Test
 {
+	using Cipher::Symmetric::Block::Mode::ICipherMode;
+
     /// <summary>
 	/// Cipher Mode implementations vector comparison test sets.
     /// <para>Using vectors from :NIST Special Publication 800-38A:
@@ -53,7 +56,11 @@ namespace Test
 		void CompareCBC(std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output);
 		void CompareCFB(std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output);
 		void CompareCTR(std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output);
+		// runs the F.5 CTR vectors through a counter mode specialized on the cipher type
+		void CompareCTRT(ICipherMode* Cipher, std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output);
 		void CompareECB(std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output);
+		// the first ICM key stream block is the FIPS-197 C.3 AES-256 vector, the later blocks check the little-endian counter increment
+		void CompareICM(ICipherMode* Cipher);
 		void CompareOFB(std::vector<byte> &Key, std::vector<std::vector<std::vector<byte>>> &Input, std::vector<std::vector<std::vector<byte>>> &Output);
 		void Initialize();
 		void OnProgress(std::string Data);
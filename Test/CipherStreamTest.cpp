@@ -1,8 +1,10 @@
 #include "CipherStreamTest.h"
 #include "../CEX/CipherStream.h"
+#include "../CEX/DigestStream.h"
 #include "../CEX/FileStream.h"
 #include "../CEX/MemoryStream.h"
 #include "../CEX/SecureRandom.h"
+#include "../CEX/StreamExecutor.h"
 #include "../CEX/CTR.h"
 #include "../CEX/CBC.h"
 #include "../CEX/CFB.h"
@@ -17,6 +19,7 @@
 #include "../CEX/THX.h"
 #include "../CEX/ChaCha20.h"
 #include "../CEX/Salsa20.h"
+#include <memory>
 
 namespace Test
 {
@@ -74,6 +77,10 @@ namespace Test
 			OnProgress(std::string("Passed MemoryStream self test.. "));
 			OnProgress(std::string(""));
 
+			AsyncJobTest();
+			OnProgress(std::string("Passed asynchronous stream job tests.."));
+			OnProgress(std::string(""));
+
 			SerializeStructTest();
 			OnProgress(std::string("Passed CipherDescription serialization test.."));
 			OnProgress(std::string(""));
@@ -215,6 +222,159 @@ namespace Test
 		fOut4.Close();/**/
 	}
 
+	void CipherStreamTest::AsyncJobTest()
+	{
+		using namespace Enumeration;
+
+		const size_t JOBCNT = 48;
+		Prng::SecureRandom rng;
+		Processing::StreamExecutor exec(4);
+		std::vector<std::vector<byte>> plnText(JOBCNT);
+		std::vector<std::unique_ptr<Processing::CipherStream>> cphStreams(JOBCNT);
+		std::vector<std::unique_ptr<Processing::DigestStream>> dgtStreams(JOBCNT);
+		std::vector<std::unique_ptr<IO::MemoryStream>> inpStreams(JOBCNT);
+		std::vector<std::unique_ptr<IO::MemoryStream>> hshStreams(JOBCNT);
+		std::vector<std::unique_ptr<IO::MemoryStream>> outStreams(JOBCNT);
+		std::vector<Processing::StreamJob<ulong>> cphJobs(JOBCNT);
+		std::vector<Processing::StreamJob<std::vector<byte>>> dgtJobs(JOBCNT);
+
+		AllocateRandom(m_iv, 16);
+		AllocateRandom(m_key, 32);
+		Key::Symmetric::SymmetricKey kpb(m_key, m_iv);
+		Key::Symmetric::SymmetricKey kps(m_key, std::vector<byte>(m_iv.begin(), m_iv.begin() + 8));
+
+		// mixed sizes and modes, all jobs in flight on four workers
+		for (size_t i = 0; i < JOBCNT; ++i)
+		{
+			// the padded mode is given a partial final block, so the padding is never ambiguous
+			plnText[i].resize(rng.NextUInt32(300000, 17) | 1);
+			rng.GetBytes(plnText[i]);
+
+			if (i % 3 == 0)
+				cphStreams[i].reset(new Processing::CipherStream(BlockCiphers::RHX, Digests::None, 14, CipherModes::CBC, PaddingModes::PKCS7));
+			else if (i % 3 == 1)
+				cphStreams[i].reset(new Processing::CipherStream(BlockCiphers::RHX, Digests::None, 14, CipherModes::CTR));
+			else
+				cphStreams[i].reset(new Processing::CipherStream(StreamCiphers::ChaCha20));
+
+			cphStreams[i]->Initialize(true, (i % 3 == 2) ? kps : kpb);
+			inpStreams[i].reset(new IO::MemoryStream(plnText[i]));
+			outStreams[i].reset(new IO::MemoryStream());
+			cphJobs[i] = cphStreams[i]->WriteAsync(inpStreams[i].get(), outStreams[i].get(), exec);
+
+			dgtStreams[i].reset(new Processing::DigestStream(Digests::SHA256));
+			hshStreams[i].reset(new IO::MemoryStream(plnText[i]));
+			dgtJobs[i] = dgtStreams[i]->ComputeAsync(hshStreams[i].get(), exec);
+		}
+
+		for (size_t i = 0; i < JOBCNT; ++i)
+		{
+			const ulong OUTLEN = cphJobs[i].Get();
+			std::vector<byte> encText = outStreams[i]->ToArray();
+
+			if (OUTLEN != encText.size())
+			{
+				throw TestException("AsyncJobTest: The job result is not the output length!");
+			}
+
+			// compare with the synchronous path
+			Processing::CipherStream* cs;
+
+			if (i % 3 == 0)
+				cs = new Processing::CipherStream(BlockCiphers::RHX, Digests::None, 14, CipherModes::CBC, PaddingModes::PKCS7);
+			else if (i % 3 == 1)
+				cs = new Processing::CipherStream(BlockCiphers::RHX, Digests::None, 14, CipherModes::CTR);
+			else
+				cs = new Processing::CipherStream(StreamCiphers::ChaCha20);
+
+			IO::MemoryStream inpStream(plnText[i]);
+			IO::MemoryStream cmpStream;
+			cs->Initialize(true, (i % 3 == 2) ? kps : kpb);
+			cs->Write(&inpStream, &cmpStream);
+
+			if (cmpStream.ToArray() != encText)
+			{
+				delete cs;
+				throw TestException("AsyncJobTest: The asynchronous cipher output is not equal!");
+			}
+
+			// decrypt with a job on a fresh executor
+			Processing::StreamExecutor decExec(1);
+			IO::MemoryStream encStream(encText);
+			IO::MemoryStream decStream;
+			cs->Initialize(false, (i % 3 == 2) ? kps : kpb);
+			cs->WriteAsync(&encStream, &decStream, decExec).Wait();
+			delete cs;
+
+			if (decStream.ToArray() != plnText[i])
+			{
+				throw TestException("AsyncJobTest: The asynchronous decryption is not equal!");
+			}
+
+			Processing::DigestStream ds(Digests::SHA256);
+
+			if (dgtJobs[i].Get() != ds.Compute(plnText[i], 0, plnText[i].size()))
+			{
+				throw TestException("AsyncJobTest: The asynchronous digest output is not equal!");
+			}
+		}
+
+		// progress is awaitable and ends at 100
+		{
+			std::vector<byte> data(1024 * 1024);
+			Processing::DigestStream ds(Digests::SHA256);
+			IO::MemoryStream ms(data);
+			Processing::StreamJob<std::vector<byte>> job = ds.ComputeAsync(&ms, exec);
+			int pct = -1;
+
+			while (!job.IsComplete())
+			{
+				const int NXTPCT = job.WaitProgress(pct);
+
+				if (NXTPCT < pct)
+				{
+					throw TestException("AsyncJobTest: The job progress is not increasing!");
+				}
+
+				pct = NXTPCT;
+			}
+
+			if (job.Progress() != 100 || job.Get().size() != 32)
+			{
+				throw TestException("AsyncJobTest: The job progress did not complete!");
+			}
+		}
+
+		// a cancelled job throws from its future
+		{
+			Processing::StreamJob<int> job = exec.Submit<int>([](Processing::JobState &State, int &Result)
+			{
+				State.Report(1, 2);
+				Result = 1;
+
+				return true;
+			});
+
+			job.WaitProgress(-1);
+			job.Cancel();
+			bool hasThrown = false;
+
+			try
+			{
+				job.Get();
+			}
+			catch (Exception::CryptoProcessingException const &)
+			{
+				hasThrown = true;
+			}
+
+			if (!hasThrown || !job.IsCancelled() || !job.IsComplete())
+			{
+				throw TestException("AsyncJobTest: The cancelled job did not throw!");
+			}
+		}
+	}
+
 	void CipherStreamTest::CbcModeTest()
 	{
 		AllocateRandom(m_iv, 16);
@@ -54,6 +54,16 @@ namespace Test
 			OnProgress(std::string("***The parallel Keccak 1024 digest***"));
 			DigestBlockLoop(Digests::Keccak1024, MB100, 10, true);
 
+			OnProgress(std::string("***The sequential BLAKE3 digest***"));
+			DigestBlockLoop(Digests::Blake3, MB100);
+			OnProgress(std::string("***The parallel BLAKE3 digest***"));
+			DigestBlockLoop(Digests::Blake3, MB100, 10, true);
+
+			OnProgress(std::string("***The sequential KangarooTwelve digest***"));
+			DigestBlockLoop(Digests::K12, MB100);
+			OnProgress(std::string("***The parallel KangarooTwelve digest***"));
+			DigestBlockLoop(Digests::K12, MB100, 10, true);
+
 			OnProgress(std::string("***The sequential SHA2 256 digest***"));
 			DigestBlockLoop(Digests::SHA256, MB100);
 			OnProgress(std::string("***The parallel SHA2 256 digest***"));
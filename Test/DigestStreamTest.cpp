@@ -1,9 +1,12 @@
 #include "DigestStreamTest.h"
 #include "../CEX/SecureRandom.h"
+#include "../CEX/AsyncFileStream.h"
 #include "../CEX/DigestStream.h"
 #include "../CEX/DigestFromName.h"
 #include "../CEX/MemoryStream.h"
 #include "../CEX/IByteStream.h"
+#include <algorithm>
+#include <cstdio>
 
 namespace Test
 {
@@ -17,6 +20,10 @@ namespace Test
 			CompareOutput(Enumeration::Digests::SHA512);
 			OnProgress(std::string("Passed DigestStream SHA512 comparison tests.."));
 
+			CompareAsyncFile(false);
+			CompareAsyncFile(true);
+			OnProgress(std::string("Passed DigestStream AsyncFileStream write and read tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -29,6 +36,60 @@ namespace Test
 		}
 	}
 
+	void DigestStreamTest::CompareAsyncFile(bool Direct)
+	{
+		const std::string FLEPTH = "dgst_async.tmp";
+		const size_t BLKLEN = 16384;
+		Prng::SecureRandom rnd;
+		// several passes through the ring, with a partial final block
+		std::vector<byte> data((BLKLEN * 11) + rnd.NextInt32(BLKLEN - 1, 1));
+		rnd.GetBytes(data);
+
+		Digest::IDigest* eng = Helper::DigestFromName::GetInstance(Enumeration::Digests::SHA256);
+		std::vector<byte> hash1(eng->DigestSize());
+		eng->Compute(data, hash1);
+		delete eng;
+
+		// write in uneven pieces, so the ring buffers fill across call boundaries
+		{
+			IO::AsyncFileStream outFile(FLEPTH, IO::AsyncFileStream::FileAccess::Write, BLKLEN, 4, Direct);
+			size_t prcLen = 0;
+
+			while (prcLen != data.size())
+			{
+				const size_t WRTLEN = (data.size() - prcLen < 5000) ? data.size() - prcLen : 5000;
+				outFile.Write(data, prcLen, WRTLEN);
+				prcLen += WRTLEN;
+			}
+
+			outFile.Close();
+		}
+
+		IO::AsyncFileStream inpFile(FLEPTH, IO::AsyncFileStream::FileAccess::Read, BLKLEN, 4, Direct);
+
+		if (inpFile.Length() != data.size())
+		{
+			std::remove(FLEPTH.c_str());
+			throw TestException("DigestStreamTest: The async file length is invalid!");
+		}
+
+		Processing::DigestStream ds(Enumeration::Digests::SHA256);
+		std::vector<byte> hash2 = ds.Compute(&inpFile);
+
+		// seek back into the middle of the file and read across a block boundary
+		std::vector<byte> tmp(BLKLEN);
+		inpFile.Seek((BLKLEN * 3) - 100, IO::SeekOrigin::Begin);
+		const size_t RDLEN = inpFile.Read(tmp, 0, tmp.size());
+		inpFile.Close();
+		std::remove(FLEPTH.c_str());
+
+		if (hash1 != hash2)
+			throw TestException("DigestStreamTest: The async file hash is not equal!");
+
+		if (RDLEN != tmp.size() || !std::equal(tmp.begin(), tmp.end(), data.begin() + (BLKLEN * 3) - 100))
+			throw TestException("DigestStreamTest: The async file seek output is not equal!");
+	}
+
 	void DigestStreamTest::CompareOutput(Enumeration::Digests Engine)
 	{
 		Prng::SecureRandom rnd;
@@ -49,6 +49,7 @@ namespace Test
 		virtual std::string Run();
 
 	private:
+		void CompareAsyncFile(bool Direct);
 		void CompareOutput(Enumeration::Digests Engine);
 		void OnProgress(std::string Data);
 	};
@@ -0,0 +1,551 @@
+#include "DilithiumTest.h"
+#include "../CEX/BCR.h"
+#include "../CEX/Dilithium.h"
+#include "../CEX/DLMCore.h"
+#include "../CEX/DLMKeyPair.h"
+#include "../CEX/DLMPrivateKey.h"
+#include "../CEX/DLMPublicKey.h"
+#include "../CEX/IAsymmetricKeyPair.h"
+#include "../CEX/MemoryStream.h"
+#include "../CEX/SecureRandom.h"
+#include "../CEX/SHA256.h"
+#include "../CEX/SHAKE.h"
+
+namespace Test
+{
+	using namespace Key::Asymmetric;
+	using namespace Cipher::Asymmetric::Sign::DLM;
+
+	const std::string DilithiumTest::DESCRIPTION = "Dilithium key generation, signing, and verification tests..";
+	const std::string DilithiumTest::FAILURE = "FAILURE! ";
+	const std::string DilithiumTest::SUCCESS = "SUCCESS! Dilithium tests have executed succesfully.";
+
+	DilithiumTest::DilithiumTest()
+		:
+		m_expected(0),
+		m_progressEvent()
+	{
+	}
+
+	DilithiumTest::~DilithiumTest()
+	{
+	}
+
+	std::string DilithiumTest::Run()
+	{
+		try
+		{
+			Initialize();
+
+			KnownAnswerTest();
+			OnProgress(std::string("DilithiumTest: Passed the deterministic key generation and signing known answer tests.."));
+			LayoutCompare();
+			OnProgress(std::string("DilithiumTest: Passed the FIPS 204 key and signature encoding tests.."));
+			NttCompare();
+			OnProgress(std::string("DilithiumTest: Passed the vectorized and scalar NTT equivalence tests.."));
+			StressLoop();
+			OnProgress(std::string("DilithiumTest: Passed signing and verification stress tests.."));
+			BatchCompare();
+			OnProgress(std::string("DilithiumTest: Passed batch verification tests.."));
+			SerializationCompare();
+			OnProgress(std::string("DilithiumTest: Passed key serialization tests.."));
+			AcvpCompare();
+			OnProgress(std::string("DilithiumTest: Passed the NIST ACVP key generation and signature generation vector tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(FAILURE + std::string(" : Unknown Error"));
+		}
+	}
+
+	void DilithiumTest::AcvpCompare()
+	{
+		const std::vector<std::string> SETS = { "ML-DSA-44", "ML-DSA-65", "ML-DSA-87" };
+		std::vector<std::map<std::string, std::string>> cases;
+		std::vector<size_t> genCount(SETS.size(), 0);
+		std::vector<size_t> sigCount(SETS.size(), 0);
+		std::vector<byte> ctx(0);
+		std::vector<byte> exp(0);
+		std::vector<byte> msg(0);
+		std::vector<byte> pk(0);
+		std::vector<byte> rnd(0);
+		std::vector<byte> seed(0);
+		std::vector<byte> sig(0);
+		std::vector<byte> sk(0);
+		std::string data;
+
+		// ML-DSA.KeyGen_internal(xi) must reproduce the official public and private keys
+		TestUtils::Read(TestFiles::ACVP::MLDSAKEYGEN, data);
+		TestUtils::ParseAcvp(data, cases);
+
+		for (size_t i = 0; i < cases.size(); ++i)
+		{
+			const size_t SETIDX = std::find(SETS.begin(), SETS.end(), cases[i]["parameterSet"]) - SETS.begin();
+
+			if (SETIDX == SETS.size() || cases[i].count("seed") == 0)
+			{
+				continue;
+			}
+
+			DLMParamSet params;
+			DLMCore::GetParamSet(params, static_cast<Enumeration::DLMParams>(SETIDX + 1));
+			HexConverter::Decode(cases[i]["seed"], seed);
+			DLMCore::Generate(pk, sk, seed, params);
+
+			HexConverter::Decode(cases[i]["pk"], exp);
+
+			if (pk != exp)
+			{
+				throw TestException("DilithiumTest: The public key does not match the ACVP vector " + cases[i]["tcId"] + "!");
+			}
+
+			HexConverter::Decode(cases[i]["sk"], exp);
+
+			if (sk != exp)
+			{
+				throw TestException("DilithiumTest: The private key does not match the ACVP vector " + cases[i]["tcId"] + "!");
+			}
+
+			++genCount[SETIDX];
+		}
+
+		// ML-DSA.Sign_internal(sk, M', rnd); the pure external groups format M' = 0 || |ctx| || ctx || M,
+		// the internal groups sign the message as M', the pre-hash and external mu groups are not covered
+		TestUtils::Read(TestFiles::ACVP::MLDSASIGGEN, data);
+		TestUtils::ParseAcvp(data, cases);
+
+		for (size_t i = 0; i < cases.size(); ++i)
+		{
+			const size_t SETIDX = std::find(SETS.begin(), SETS.end(), cases[i]["parameterSet"]) - SETS.begin();
+			const std::string IFACE = cases[i]["signatureInterface"];
+
+			if (SETIDX == SETS.size() || cases[i]["externalMu"] == "true")
+			{
+				continue;
+			}
+
+			HexConverter::Decode(cases[i]["message"], msg);
+
+			if (IFACE == "external" && cases[i]["preHash"] == "pure")
+			{
+				HexConverter::Decode(cases[i]["context"], ctx);
+				msg.insert(msg.begin(), ctx.begin(), ctx.end());
+				msg.insert(msg.begin(), static_cast<byte>(ctx.size()));
+				msg.insert(msg.begin(), 0x00);
+			}
+			else if (IFACE != "internal")
+			{
+				continue;
+			}
+
+			if (cases[i]["deterministic"] == "true")
+			{
+				rnd.assign(32, 0x00);
+			}
+			else
+			{
+				HexConverter::Decode(cases[i]["rnd"], rnd);
+			}
+
+			DLMParamSet params;
+			DLMCore::GetParamSet(params, static_cast<Enumeration::DLMParams>(SETIDX + 1));
+			HexConverter::Decode(cases[i]["sk"], sk);
+			HexConverter::Decode(cases[i]["signature"], exp);
+			sig.clear();
+			DLMCore::SignInternal(sig, msg, sk, rnd, params);
+
+			if (sig != exp)
+			{
+				throw TestException("DilithiumTest: The signature does not match the ACVP vector " + cases[i]["tcId"] + "!");
+			}
+
+			++sigCount[SETIDX];
+		}
+
+		for (size_t i = 0; i < SETS.size(); ++i)
+		{
+			if (genCount[i] == 0 || sigCount[i] == 0)
+			{
+				throw TestException("DilithiumTest: The ACVP vector files have no tests for " + SETS[i] + "!");
+			}
+		}
+	}
+
+	void DilithiumTest::BatchCompare()
+	{
+		const size_t BATCH = 8;
+		std::vector<std::vector<byte>> msgs(BATCH);
+		std::vector<std::vector<byte>> sigs(BATCH);
+		std::vector<bool> res;
+		Prng::SecureRandom rnd;
+
+		// the batch verifier must agree with single verification, sequential and multi-threaded
+		Dilithium sgn1(Enumeration::DLMParams::MLDSA65, Enumeration::Prngs::BCR, true);
+		Dilithium sgn2(Enumeration::DLMParams::MLDSA65, Enumeration::Prngs::BCR, false);
+		IAsymmetricKeyPair* kp = sgn1.Generate();
+
+		sgn1.Initialize(*kp->PrivateKey());
+
+		for (size_t i = 0; i < BATCH; ++i)
+		{
+			msgs[i].resize(16 + (i * 16));
+			rnd.GetBytes(msgs[i]);
+			sgn1.Sign(msgs[i], 0, msgs[i].size(), sigs[i], 0);
+		}
+
+		sgn1.Initialize(*kp->PublicKey());
+		sgn2.Initialize(*kp->PublicKey());
+
+		if (!sgn1.Verify(msgs, sigs, res) || res.size() != BATCH)
+		{
+			throw TestException("DilithiumTest: The parallel batch failed verification!");
+		}
+
+		if (!sgn2.Verify(msgs, sigs, res) || res.size() != BATCH)
+		{
+			throw TestException("DilithiumTest: The sequential batch failed verification!");
+		}
+
+		// a bad signature must be flagged at its own position only
+		sigs[3][sigs[3].size() / 2] ^= 1;
+
+		if (sgn1.Verify(msgs, sigs, res))
+		{
+			throw TestException("DilithiumTest: A batch with a modified signature passed verification!");
+		}
+
+		for (size_t i = 0; i < BATCH; ++i)
+		{
+			if (res[i] != (i != 3) || res[i] != sgn2.Verify(msgs[i], 0, msgs[i].size(), sigs[i]))
+			{
+				throw TestException("DilithiumTest: The batch results do not match single verification!");
+			}
+		}
+
+		delete kp->PrivateKey();
+		delete kp->PublicKey();
+		delete kp;
+	}
+
+	void DilithiumTest::Initialize()
+	{
+		const char* expectedEnc[15] =
+		{
+			// regression values: the SHA2-256 hashes of the public key, private key and signature, for the ML-DSA-44, ML-DSA-65 and ML-DSA-87 sets
+			("9F107644C1084526AF3BC8098680B05499A2325A644E388FB4F970E058D19D46"),
+			("04BF6B9F579166A627961DFC5C3BF9717DF868DB88863856356C4668C8B56B0B"),
+			("C69F47B989BB8DDBB7316D978E41EA30321FBDAD6F2960364DAF19CB75003070"),
+			("D666806E11CEE19A7C989F7445F90DD419CF4D2D51DB8C0FDB4C0F0A542238C9"),
+			("9F1E24F47795FE50040384E3D6183988047170FA2D866406B70FE0A3F8216063"),
+			("51B10CA1D423C310726AEC0DA47A6E9A6C8CBFB69D3DEFE716278C6F807D6292"),
+			("91DC389CFAA01470B7F66EEE45A4AE9026D154817C754DFE22298B3FA241FFCD"),
+			("764D3E223ED90C07BC91A0AB6ECD170E5C66FFE39F7039298596039A36005435"),
+			("2CA00B890E48091261FAB96835D4BED56BD663E8317D030C4E8331F259C5FEA8"),
+			// rho and K: bytes 0-31 and 96-127 of SHAKE256(xi || k || l, 128), for the ML-DSA-44, ML-DSA-65 and ML-DSA-87 sets
+			("D7B2B47254AAE0DB45E7930D4A98D2C97D8F1397D1789DAFA17024B316E9BEC9"),
+			("39CE0F7F77F8DB5644DCDA366BFE4734BD95F435FF9A613AA54AA41C2C694C04"),
+			("48683D91978E31EB3DDDB8B0473482D2B88A5F625949FD8F58A561E696BD4C27"),
+			("D853FA69B8199023E8CD678DD9FABF9047646FFD0CB3CC7F795805A71E70D237"),
+			("9792BCEC2F2430686A82FCCF3C2F5FF665E771D7AB41B90258CFA7E90EC97124"),
+			("D8E9EE4E90A16C602F5EC9BC38517DC30E329D5AB27673BD85F4C9B0300F7763")
+		};
+		HexConverter::Decode(expectedEnc, 15, m_expected);
+	}
+
+	void DilithiumTest::KnownAnswerTest()
+	{
+		std::vector<byte> hash(32);
+		std::vector<byte> msg(33);
+		std::vector<byte> pk(0);
+		std::vector<byte> rnd(32, 0);
+		std::vector<byte> seed(32);
+		std::vector<byte> sig(0);
+		std::vector<byte> sk(0);
+
+		// xi = 00 01 .. 1F, M = 00 01 .. 20, pure signing with an empty context, and the deterministic variant with rnd = 0;
+		// the pinned hashes are regression values from a python transcription of FIPS 204 written alongside this code,
+		// the official NIST vectors are checked by AcvpCompare
+		for (size_t i = 0; i < seed.size(); ++i)
+		{
+			seed[i] = static_cast<byte>(i);
+		}
+
+		for (size_t i = 0; i < msg.size(); ++i)
+		{
+			msg[i] = static_cast<byte>(i);
+		}
+
+		for (byte p = 1; p <= 3; ++p)
+		{
+			const size_t EXPOFF = (p - 1) * 3;
+			DLMParamSet params;
+			Digest::SHA256 dgt;
+
+			DLMCore::GetParamSet(params, static_cast<Enumeration::DLMParams>(p));
+			DLMCore::Generate(pk, sk, seed, params);
+
+			dgt.Compute(pk, hash);
+
+			if (hash != m_expected[EXPOFF])
+			{
+				throw TestException("DilithiumTest: The public key does not match the known answer!");
+			}
+
+			dgt.Compute(sk, hash);
+
+			if (hash != m_expected[EXPOFF + 1])
+			{
+				throw TestException("DilithiumTest: The private key does not match the known answer!");
+			}
+
+			sig.clear();
+			DLMCore::Sign(sig, msg, 0, msg.size(), sk, rnd, params);
+			dgt.Compute(sig, hash);
+
+			if (hash != m_expected[EXPOFF + 2])
+			{
+				throw TestException("DilithiumTest: The signature does not match the known answer!");
+			}
+
+			if (!DLMCore::Verify(sig, msg, 0, msg.size(), pk, params))
+			{
+				throw TestException("DilithiumTest: The known answer signature failed verification!");
+			}
+		}
+	}
+
+	void DilithiumTest::LayoutCompare()
+	{
+		// the FIPS 204 public key, private key and signature sizes for ML-DSA-44, ML-DSA-65 and ML-DSA-87
+		const size_t PKSIZE[3] = { 1312, 1952, 2592 };
+		const size_t SKSIZE[3] = { 2560, 4032, 4896 };
+		const size_t SIGSIZE[3] = { 2420, 3309, 4627 };
+		std::vector<byte> msg(33);
+		std::vector<byte> pk(0);
+		std::vector<byte> rnd(32, 0);
+		std::vector<byte> seed(32);
+		std::vector<byte> sig(0);
+		std::vector<byte> sk(0);
+		std::vector<byte> tr(64);
+
+		for (size_t i = 0; i < seed.size(); ++i)
+		{
+			seed[i] = static_cast<byte>(i);
+		}
+
+		for (size_t i = 0; i < msg.size(); ++i)
+		{
+			msg[i] = static_cast<byte>(i);
+		}
+
+		for (byte p = 1; p <= 3; ++p)
+		{
+			const size_t EXPOFF = 9 + ((p - 1) * 2);
+			DLMParamSet params;
+
+			DLMCore::GetParamSet(params, static_cast<Enumeration::DLMParams>(p));
+			DLMCore::Generate(pk, sk, seed, params);
+
+			if (pk.size() != PKSIZE[p - 1] || sk.size() != SKSIZE[p - 1])
+			{
+				throw TestException("DilithiumTest: The key sizes do not match the standard!");
+			}
+
+			// pk = rho || t1, and sk = rho || K || tr || s1 || s2 || t0
+			if (std::vector<byte>(pk.begin(), pk.begin() + 32) != m_expected[EXPOFF] || std::vector<byte>(sk.begin(), sk.begin() + 32) != m_expected[EXPOFF])
+			{
+				throw TestException("DilithiumTest: The public seed is not encoded as the standard requires!");
+			}
+
+			if (std::vector<byte>(sk.begin() + 32, sk.begin() + 64) != m_expected[EXPOFF + 1])
+			{
+				throw TestException("DilithiumTest: The signing seed is not encoded as the standard requires!");
+			}
+
+			// tr = SHAKE256(pk, 64)
+			Kdf::SHAKE gen(Enumeration::Digests::Keccak512);
+			gen.Initialize(pk);
+			gen.Generate(tr);
+
+			if (std::vector<byte>(sk.begin() + 64, sk.begin() + 128) != tr)
+			{
+				throw TestException("DilithiumTest: The public key hash is not encoded as the standard requires!");
+			}
+
+			sig.clear();
+			DLMCore::Sign(sig, msg, 0, msg.size(), sk, rnd, params);
+
+			if (sig.size() != SIGSIZE[p - 1])
+			{
+				throw TestException("DilithiumTest: The signature size does not match the standard!");
+			}
+		}
+	}
+
+	void DilithiumTest::NttCompare()
+	{
+		const int DLMQ = 8380417;
+		std::vector<byte> buf(4 * 256);
+		DLMCore::Poly a1;
+		DLMCore::Poly a2;
+		Prng::SecureRandom rnd;
+
+		// inputs are bounded by q; the transforms may return different representatives, but they must agree modulo q
+		for (size_t i = 0; i < 200; ++i)
+		{
+			rnd.GetBytes(buf);
+
+			for (size_t j = 0; j < a1.size(); ++j)
+			{
+				const uint X = static_cast<uint>(buf[j * 4]) | (static_cast<uint>(buf[(j * 4) + 1]) << 8) | (static_cast<uint>(buf[(j * 4) + 2]) << 16) | (static_cast<uint>(buf[(j * 4) + 3]) << 24);
+				a1[j] = static_cast<int>(X % static_cast<uint>((2 * DLMQ) - 1)) - (DLMQ - 1);
+			}
+
+			a2 = a1;
+
+			// even passes run the forward transform, odd passes the inverse
+			if (i % 2 == 0)
+			{
+				DLMCore::Ntt(a1);
+				DLMCore::NttScalar(a2);
+			}
+			else
+			{
+				DLMCore::NttInv(a1);
+				DLMCore::NttInvScalar(a2);
+			}
+
+			for (size_t j = 0; j < a1.size(); ++j)
+			{
+				if ((((a1[j] - a2[j]) % DLMQ) + DLMQ) % DLMQ != 0)
+				{
+					throw TestException("DilithiumTest: The vectorized and scalar NTT outputs are not equal!");
+				}
+			}
+		}
+	}
+
+	void DilithiumTest::SerializationCompare()
+	{
+		std::vector<byte> skey;
+
+		Dilithium sgn(Enumeration::DLMParams::MLDSA44);
+
+		for (size_t i = 0; i < 10; ++i)
+		{
+			IAsymmetricKeyPair* kp = sgn.Generate();
+			DLMPrivateKey* priK1 = (DLMPrivateKey*)kp->PrivateKey();
+			skey = priK1->ToBytes();
+			DLMPrivateKey priK2(skey);
+
+			if (priK1->S() != priK2.S() || priK1->Parameters() != priK2.Parameters())
+			{
+				throw TestException("DilithiumTest: Private key serialization test has failed!");
+			}
+
+			DLMPublicKey* pubK1 = (DLMPublicKey*)kp->PublicKey();
+			skey = pubK1->ToBytes();
+			DLMPublicKey pubK2(skey);
+
+			if (pubK1->P() != pubK2.P() || pubK1->Parameters() != pubK2.Parameters())
+			{
+				throw TestException("DilithiumTest: Public key serialization test has failed!");
+			}
+
+			delete kp;
+			delete priK1;
+			delete pubK1;
+		}
+	}
+
+	void DilithiumTest::StressLoop()
+	{
+		const std::vector<Enumeration::DLMParams> PARAMS =
+		{
+			Enumeration::DLMParams::MLDSA44,
+			Enumeration::DLMParams::MLDSA65,
+			Enumeration::DLMParams::MLDSA87
+		};
+
+		std::vector<byte> msg(128);
+		std::vector<byte> sig(0);
+		Prng::SecureRandom rnd;
+		Prng::BCR* rngPtr = new Prng::BCR();
+
+		for (size_t i = 0; i < PARAMS.size(); ++i)
+		{
+			Dilithium sgn(PARAMS[i], rngPtr);
+
+			for (size_t j = 0; j < 10; ++j)
+			{
+				rnd.GetBytes(msg);
+				IAsymmetricKeyPair* kp = sgn.Generate();
+
+				sgn.Initialize(*kp->PrivateKey());
+				// sign at an offset within the output array
+				sgn.Sign(msg, 0, msg.size(), sig, 8);
+
+				if (sig.size() != sgn.SignatureSize() + 8)
+				{
+					throw TestException("DilithiumTest: The signature size is invalid!");
+				}
+
+				sig.erase(sig.begin(), sig.begin() + 8);
+				sgn.Initialize(*kp->PublicKey());
+
+				if (!sgn.Verify(msg, 0, msg.size(), sig))
+				{
+					throw TestException("DilithiumTest: The signature failed verification!");
+				}
+
+				// the stream interface signs the same bytes
+				IO::MemoryStream mst(msg);
+
+				if (!sgn.Verify(mst, 0, msg.size(), sig))
+				{
+					throw TestException("DilithiumTest: The stream signature failed verification!");
+				}
+
+				// a changed message must fail
+				msg[j] ^= 1;
+
+				if (sgn.Verify(msg, 0, msg.size(), sig))
+				{
+					throw TestException("DilithiumTest: A modified message passed verification!");
+				}
+
+				// a changed signature must fail
+				msg[j] ^= 1;
+				sig[sig.size() / 2] ^= 1;
+
+				if (sgn.Verify(msg, 0, msg.size(), sig))
+				{
+					throw TestException("DilithiumTest: A modified signature passed verification!");
+				}
+
+				delete kp->PrivateKey();
+				delete kp->PublicKey();
+				delete kp;
+				sig.clear();
+			}
+		}
+
+		if (rngPtr == nullptr)
+		{
+			throw TestException("DilithiumTest: Prng was reset!");
+		}
+
+		delete rngPtr;
+	}
+
+	void DilithiumTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
@@ -0,0 +1,61 @@
+#ifndef _CEXTEST_DILITHIUMTEST_H
+#define _CEXTEST_DILITHIUMTEST_H
+
+#include "ITest.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Dilithium key generation, signing, and verification tests
+	/// </summary>
+	class DilithiumTest : public ITest
+	{
+	private:
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<std::vector<byte>> m_expected;
+		TestEventHandler m_progressEvent;
+
+	public:
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		virtual const std::string Description() { return DESCRIPTION; }
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		virtual TestEventHandler &Progress() { return m_progressEvent; }
+
+		/// <summary>
+		/// 
+		/// </summary>
+		DilithiumTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~DilithiumTest();
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		virtual std::string Run();
+
+	private:
+
+		void OnProgress(std::string Data);
+		void AcvpCompare();
+		void BatchCompare();
+		void Initialize();
+		void KnownAnswerTest();
+		void LayoutCompare();
+		void NttCompare();
+		void SerializationCompare();
+		void StressLoop();
+	};
+}
+
+#endif
@@ -38,6 +38,13 @@ namespace Test
 				GMACCompare(m_key[i], m_nonce[i], m_plainText[i], m_expectedCode[i]);
 			OnProgress(std::string("GMACTest: Passed GMAC known answer vector tests.."));
 
+			Mac::GMAC mac1(Enumeration::BlockCiphers::Rijndael);
+			Mac::GMAC mac2(Enumeration::BlockCiphers::Rijndael);
+			Key::Symmetric::SymmetricKey kp(m_key[0], m_nonce[0]);
+			if (!TestUtils::CompareState(&mac1, &mac2, kp))
+				throw TestException("GMACTest: The resumed mac state code is not equal!");
+			OnProgress(std::string("GMACTest: Passed GMAC state serialization tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
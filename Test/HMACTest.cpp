@@ -53,6 +53,13 @@ namespace Test
 			CompareAccess(m_keys[3]);
 			OnProgress(std::string("Passed Finalize/Compute methods output comparison.."));
 
+			Mac::HMAC mac1(Enumeration::Digests::SHA256);
+			Mac::HMAC mac2(Enumeration::Digests::SHA256);
+			SymmetricKey kp(m_keys[3]);
+			if (!TestUtils::CompareState(&mac1, &mac2, kp))
+				throw TestException("HMACTest: The resumed mac state code is not equal!");
+			OnProgress(std::string("HMACTest: Passed HMAC state serialization tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
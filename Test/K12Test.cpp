@@ -0,0 +1,206 @@
+#include "K12Test.h"
+#include "../CEX/DigestFromName.h"
+#include "../CEX/K12.h"
+
+namespace Test
+{
+	using Digest::K12;
+
+	const std::string K12Test::DESCRIPTION = "KangarooTwelve Test Vectors; single node, tree, and customized hashing.";
+	const std::string K12Test::FAILURE = "FAILURE! ";
+	const std::string K12Test::SUCCESS = "SUCCESS! All KangarooTwelve tests have executed succesfully.";
+
+	K12Test::K12Test()
+		:
+		m_expected(0),
+		m_progressEvent()
+	{
+	}
+
+	K12Test::~K12Test()
+	{
+	}
+
+	std::string K12Test::Run()
+	{
+		try
+		{
+			Initialize();
+
+			K12* dgt = new K12;
+			std::vector<byte> empty(0);
+			size_t len = 1;
+
+			CompareVector(dgt, empty, m_expected[0]);
+
+			for (size_t i = 0; i < 6; ++i)
+			{
+				std::vector<byte> msg = Pattern(len);
+				CompareVector(dgt, msg, m_expected[i + 1]);
+				len *= 17;
+			}
+			delete dgt;
+			OnProgress(std::string("K12Test: Passed KangarooTwelve message vector tests.."));
+
+			len = 1;
+			for (size_t i = 0; i < 4; ++i)
+			{
+				std::vector<byte> msg((static_cast<size_t>(1) << i) - 1, 0xFF);
+				K12 cdgt(Pattern(len));
+				CompareVector(&cdgt, msg, m_expected[i + 7]);
+				len *= 41;
+			}
+			OnProgress(std::string("K12Test: Passed KangarooTwelve customization string tests.."));
+
+			IDigest* idgt = Helper::DigestFromName::GetInstance(Enumeration::Digests::K12);
+			for (size_t i = 0; i < 3; ++i)
+			{
+				std::vector<byte> msg = Pattern(8191 + i);
+				CompareVector(idgt, msg, m_expected[i + 11]);
+			}
+			delete idgt;
+			OnProgress(std::string("K12Test: Passed KangarooTwelve chunk boundary tests.."));
+
+			std::vector<byte> msg = Pattern(83521);
+			CompareStream(msg, m_expected[5]);
+			OnProgress(std::string("K12Test: Passed KangarooTwelve incremental update tests.."));
+			CompareState(msg, m_expected[5]);
+			OnProgress(std::string("K12Test: Passed KangarooTwelve state serialization tests.."));
+
+			msg = Pattern(1419857);
+			CompareParallel(msg, m_expected[6]);
+			OnProgress(std::string("K12Test: Passed KangarooTwelve multi-threaded tree hashing tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void K12Test::CompareParallel(std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		std::vector<byte> hash(32);
+		K12 dgt(true);
+
+		// the threaded path is forced on single core systems; the hash does not depend on the thread count
+		if (!dgt.IsParallel())
+			dgt.ParallelProfile().IsParallel() = true;
+
+		for (size_t i = 2; i <= 4; i += 2)
+		{
+			dgt.ParallelMaxDegree(i);
+			dgt.Compute(Input, hash);
+
+			if (hash != Expected)
+				throw TestException("K12Test: The parallel hash is not equal!");
+
+			// a misaligned input runs the buffered, threaded, and grouped paths in one update
+			dgt.Update(Input, 0, 1);
+			dgt.Update(Input, 1, Input.size() - 1);
+			dgt.Finalize(hash, 0);
+
+			if (hash != Expected)
+				throw TestException("K12Test: The misaligned parallel hash is not equal!");
+		}
+	}
+
+	void K12Test::CompareState(std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		const size_t CUTS[3] = { 5000, 9000, 50000 };
+		std::vector<byte> hash(32);
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			K12 dgt1;
+			K12 dgt2;
+
+			// checkpoint inside the first chunk, the leaf buffer, and after several chunk groups
+			dgt1.Update(Input, 0, CUTS[i]);
+			dgt2.LoadState(dgt1.SaveState());
+			dgt2.Update(Input, CUTS[i], Input.size() - CUTS[i]);
+			dgt2.Finalize(hash, 0);
+
+			if (hash != Expected)
+				throw TestException("K12Test: The restored state hash is not equal!");
+		}
+	}
+
+	void K12Test::CompareStream(std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		const size_t CUTS[6] = { 1, 167, 168, 8191, 8193, 32769 };
+		std::vector<byte> hash(32);
+		K12 dgt;
+		size_t pos = 0;
+
+		for (size_t i = 0; pos < Input.size(); ++i)
+		{
+			const size_t LEN = (std::min)(CUTS[i % 6], Input.size() - pos);
+			dgt.Update(Input, pos, LEN);
+			pos += LEN;
+		}
+
+		dgt.Finalize(hash, 0);
+
+		if (hash != Expected)
+			throw TestException("K12Test: The incremental hash is not equal!");
+	}
+
+	void K12Test::CompareVector(IDigest* Digest, std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		std::vector<byte> hash(Digest->DigestSize(), 0);
+
+		Digest->Update(Input, 0, Input.size());
+		Digest->Finalize(hash, 0);
+
+		if (Expected != hash)
+			throw TestException("K12Test: Expected hash is not equal!");
+	}
+
+	void K12Test::Initialize()
+	{
+		const char* expectedEnc[14] =
+		{
+			// M = empty
+			("1AC2D450FC3B4205D19DA7BFCA1B37513C0803577AC7167F06FE2CE1F0EF39E5"),
+			// M = ptn(17^i) for i = 0 to 5
+			("2BDA92450E8B147F8A7CB629E784A058EFCA7CF7D8218E02D345DFAA65244A1F"),
+			("6BF75FA2239198DB4772E36478F8E19B0F371205F6A9A93A273F51DF37122888"),
+			("0C315EBCDEDBF61426DE7DCF8FB725D1E74675D7F5327A5067F367B108ECB67C"),
+			("CB552E2EC77D9910701D578B457DDF772C12E322E4EE7FE417F92C758F0D59D0"),
+			("8701045E22205345FF4DDA05555CBB5C3AF1A771C2B89BAEF37DB43D9998B9FE"),
+			("844D610933B1B9963CBDEB5AE3B6B05CC7CBD67CEEDF883EB678A0A8E0371682"),
+			// M = 0xFF repeated 2^j - 1 times, C = ptn(41^j) for j = 0 to 3
+			("FAB658DB63E94A246188BF7AF69A133045F46EE984C56E3C3328CAAF1AA1A583"),
+			("D848C5068CED736F4462159B9867FD4C20B808ACC3D5BC48E0B06BA0A3762EC4"),
+			("C389E5009AE57120854C2E8C64670AC01358CF4C1BAF89447A724234DC7CED74"),
+			("75D2F86A2E644566726B4FBCFC5657B9DBCF070C7B0DCA06450AB291D7443BCF"),
+			// M = ptn(8191), ptn(8192), ptn(8193); the single node to tree mode boundary
+			("1B577636F723643E990CC7D6A659837436FD6A103626600EB8301CD1DBE553D6"),
+			("48F256F6772F9EDFB6A8B661EC92DC93B95EBD05A08A17B39AE3490870C926C3"),
+			("BB66FE72EAEA5179418D5295EE1344854D8AD7F3FA17EFCB467EC152341284CF")
+		};
+		HexConverter::Decode(expectedEnc, 14, m_expected);
+	}
+
+	void K12Test::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+
+	std::vector<byte> K12Test::Pattern(size_t Length)
+	{
+		// ptn(n); the repeating byte sequence 00 01 .. FA
+		std::vector<byte> msg(Length);
+
+		for (size_t i = 0; i < Length; ++i)
+			msg[i] = static_cast<byte>(i % 251);
+
+		return msg;
+	}
+}
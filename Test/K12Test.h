@@ -0,0 +1,64 @@
+#ifndef _CEXTEST_K12TEST_H
+#define _CEXTEST_K12TEST_H
+
+#include "ITest.h"
+#include "../CEX/IDigest.h"
+
+namespace Test
+{
+	using CEX::Digest::IDigest;
+
+	/// <summary>
+	/// KangarooTwelve implementation vector comparison tests.
+	/// <para>Using the test vectors from the KangarooTwelve specification and IETF draft:
+	/// <see href="https://datatracker.ietf.org/doc/draft-irtf-cfrg-kangarootwelve/"/>,
+	/// and chunk boundary vectors generated with the Keccak code package.</para>
+	/// </summary>
+	class K12Test : public ITest
+	{
+	private:
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<std::vector<byte>> m_expected;
+		TestEventHandler m_progressEvent;
+
+	public:
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		virtual const std::string Description() { return DESCRIPTION; }
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		virtual TestEventHandler &Progress() { return m_progressEvent; }
+
+		/// <summary>
+		/// Compares known answer KangarooTwelve vectors for equality
+		/// </summary>
+		K12Test();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~K12Test();
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		virtual std::string Run();
+
+	private:
+		void CompareParallel(std::vector<byte> &Input, std::vector<byte> &Expected);
+		void CompareState(std::vector<byte> &Input, std::vector<byte> &Expected);
+		void CompareStream(std::vector<byte> &Input, std::vector<byte> &Expected);
+		void CompareVector(IDigest* Digest, std::vector<byte> &Input, std::vector<byte> &Expected);
+		void Initialize();
+		void OnProgress(std::string Data);
+		std::vector<byte> Pattern(size_t Length);
+	};
+}
+
+#endif
@@ -0,0 +1,186 @@
+#include "KMACTest.h"
+#include "../CEX/KMAC.h"
+#include "../CEX/SymmetricKey.h"
+
+namespace Test
+{
+	using Enumeration::Digests;
+	using Key::Symmetric::SymmetricKey;
+
+	const std::string KMACTest::DESCRIPTION = "NIST SP 800-185 Test Vectors for KMAC128 and KMAC256.";
+	const std::string KMACTest::FAILURE = "FAILURE! ";
+	const std::string KMACTest::SUCCESS = "SUCCESS! All KMAC tests have executed succesfully.";
+
+	KMACTest::KMACTest()
+		:
+		m_custom(0),
+		m_expected(0),
+		m_input(0),
+		m_key(0),
+		m_progressEvent()
+	{
+	}
+
+	KMACTest::~KMACTest()
+	{
+	}
+
+	std::string KMACTest::Run()
+	{
+		try
+		{
+			Initialize();
+
+			CompareVector(Digests::Keccak256, m_key, m_custom[0], m_input[0], m_expected[0]);
+			CompareVector(Digests::Keccak256, m_key, m_custom[1], m_input[0], m_expected[1]);
+			CompareVector(Digests::Keccak256, m_key, m_custom[1], m_input[1], m_expected[2]);
+			OnProgress(std::string("KMACTest: Passed KMAC128 known answer vector tests.."));
+
+			CompareVector(Digests::Keccak512, m_key, m_custom[1], m_input[0], m_expected[3]);
+			CompareVector(Digests::Keccak512, m_key, m_custom[0], m_input[1], m_expected[4]);
+			CompareVector(Digests::Keccak512, m_key, m_custom[1], m_input[1], m_expected[5]);
+			OnProgress(std::string("KMACTest: Passed KMAC256 known answer vector tests.."));
+
+			CompareAccess(Digests::Keccak256);
+			CompareAccess(Digests::Keccak512);
+			OnProgress(std::string("KMACTest: Passed Finalize/Compute methods output comparison.."));
+
+			CompareState(Digests::Keccak256);
+			CompareState(Digests::Keccak512);
+			OnProgress(std::string("KMACTest: Passed KMAC state serialization tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void KMACTest::CompareAccess(Digests DigestType)
+	{
+		std::vector<byte> input(512);
+		Mac::KMAC mac(DigestType);
+		SymmetricKey kp(m_key);
+		std::vector<byte> code1(mac.MacSize());
+		std::vector<byte> code2(mac.MacSize());
+
+		for (size_t i = 0; i < input.size(); ++i)
+			input[i] = (byte)i;
+
+		mac.Initialize(kp);
+		mac.Compute(input, code1);
+
+		// the keyed sponge is restored by finalize; uneven updates that straddle the rate boundary
+		mac.Update(input, 0, 1);
+		mac.Update(input, 1, 200);
+		mac.Update(input, 201, input.size() - 201);
+		mac.Finalize(code2, 0);
+
+		if (code1 != code2)
+			throw TestException("KMACTest: The split update mac code is not equal!");
+
+		std::fill(code2.begin(), code2.end(), 0);
+
+		for (size_t i = 0; i < input.size(); ++i)
+			mac.Update(input[i]);
+
+		mac.Finalize(code2, 0);
+
+		if (code1 != code2)
+			throw TestException("KMACTest: The byte update mac code is not equal!");
+	}
+
+	void KMACTest::CompareState(Digests DigestType)
+	{
+		const size_t CUTS[4] = { 1, 136, 169, 511 };
+		std::vector<byte> input(512);
+		Mac::KMAC mac1(DigestType);
+		Mac::KMAC mac2(DigestType);
+		std::vector<byte> code1(mac1.MacSize());
+		std::vector<byte> code2(mac1.MacSize());
+		SymmetricKey kp(m_key);
+
+		for (size_t i = 0; i < input.size(); ++i)
+			input[i] = (byte)i;
+
+		mac1.Initialize(kp);
+		mac2.Initialize(kp);
+		mac1.Compute(input, code1);
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			// checkpoint the first mac, and resume the message on the second; both share the same key
+			mac1.Update(input, 0, CUTS[i]);
+			std::vector<byte> state = mac1.SaveState();
+			mac1.Reset();
+			mac1.Initialize(kp);
+
+			mac2.LoadState(state);
+			mac2.Update(input, CUTS[i], input.size() - CUTS[i]);
+			mac2.Finalize(code2, 0);
+
+			if (code1 != code2)
+				throw TestException("KMACTest: The resumed mac state code is not equal!");
+		}
+	}
+
+	void KMACTest::CompareVector(Digests DigestType, std::vector<byte> &Key, std::vector<byte> &Custom, std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		std::vector<byte> code(Expected.size());
+		Mac::KMAC mac(DigestType, Expected.size());
+		SymmetricKey kp(Key, std::vector<byte>(0), Custom);
+
+		mac.Initialize(kp);
+		mac.Compute(Input, code);
+
+		if (Expected != code)
+			throw TestException("KMACTest: Return code is not equal!");
+
+		// the keyed state is restored on finalize; a second message must produce the same code
+		mac.Compute(Input, code);
+
+		if (Expected != code)
+			throw TestException("KMACTest: Return code is not equal after finalize!");
+	}
+
+	void KMACTest::Initialize()
+	{
+		m_key.resize(32);
+		for (size_t i = 0; i < m_key.size(); ++i)
+			m_key[i] = (byte)(0x40 + i);
+
+		m_input.resize(2);
+		m_input[0].resize(4);
+		for (size_t i = 0; i < m_input[0].size(); ++i)
+			m_input[0][i] = (byte)i;
+		m_input[1].resize(200);
+		for (size_t i = 0; i < m_input[1].size(); ++i)
+			m_input[1][i] = (byte)i;
+
+		// the empty string, and "My Tagged Application"
+		const std::string tag = "My Tagged Application";
+		m_custom.resize(2);
+		m_custom[1].assign(tag.begin(), tag.end());
+
+		const char* expectedEnc[6] =
+		{
+			("E5780B0D3EA6F7D3A429C5706AA43A00FADBD7D49628839E3187243F456EE14E"),
+			("3B1FBA963CD8B0B59E8C1A6D71888B7143651AF8BA0A7070C0979E2811324AA5"),
+			("1F5B4E6CCA02209E0DCB5CA635B89A15E271ECC760071DFD805FAA38F9729230"),
+			("20C570C31346F703C9AC36C61C03CB64C3970D0CFC787E9B79599D273A68D2F7F69D4CC3DE9D104A351689F27CF6F5951F0103F33F4F24871024D9C27773A8DD"),
+			("75358CF39E41494E949707927CEE0AF20A3FF553904C86B08F21CC414BCFD691589D27CF5E15369CBBFF8B9A4C2EB17800855D0235FF635DA82533EC6B759B69"),
+			("B58618F71F92E1D56C1B8C55DDD7CD188B97B4CA4D99831EB2699A837DA2E4D970FBACFDE50033AEA585F1A2708510C32D07880801BD182898FE476876FC8965")
+		};
+		HexConverter::Decode(expectedEnc, 6, m_expected);
+	}
+
+	void KMACTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
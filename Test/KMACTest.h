@@ -0,0 +1,62 @@
+#ifndef _CEXTEST_KMACTEST_H
+#define _CEXTEST_KMACTEST_H
+
+#include "ITest.h"
+#include "../CEX/Digests.h"
+
+namespace Test
+{
+	/// <summary>
+	/// KMAC implementation vector comparison tests.
+	/// <para>Using the KMAC128 and KMAC256 samples from NIST SP 800-185:
+	/// <see href="https://csrc.nist.gov/CSRC/media/Projects/Cryptographic-Standards-and-Guidelines/documents/examples/KMAC_samples.pdf"/></para>
+	/// </summary>
+	class KMACTest : public ITest
+	{
+	private:
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<std::vector<byte>> m_custom;
+		std::vector<std::vector<byte>> m_expected;
+		std::vector<std::vector<byte>> m_input;
+		std::vector<byte> m_key;
+		TestEventHandler m_progressEvent;
+
+	public:
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		virtual const std::string Description() { return DESCRIPTION; }
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		virtual TestEventHandler &Progress() { return m_progressEvent; }
+
+		/// <summary>
+		/// Compares known answer KMAC vectors for equality
+		/// </summary>
+		KMACTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~KMACTest();
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		virtual std::string Run();
+
+	private:
+		void CompareAccess(Enumeration::Digests DigestType);
+		void CompareState(Enumeration::Digests DigestType);
+		void CompareVector(Enumeration::Digests DigestType, std::vector<byte> &Key, std::vector<byte> &Custom, std::vector<byte> &Input, std::vector<byte> &Expected);
+		void Initialize();
+		void OnProgress(std::string Data);
+	};
+}
+
+#endif
@@ -70,6 +70,22 @@ namespace Test
 			delete kc512;
 			delete kc1024;
 
+			Keccak256 kcs1;
+			Keccak256 kcs2;
+			if (!TestUtils::CompareState(&kcs1, &kcs2))
+				throw TestException("KeccakTest: The resumed digest state hash is not equal!");
+			Keccak512 kcp1(true);
+			Keccak512 kcp2(true);
+			if (!TestUtils::CompareState(&kcp1, &kcp2))
+				throw TestException("KeccakTest: The resumed digest state hash is not equal!");
+			KeccakParams kp512(64, 72, 8);
+			kp512.DistributionCode()[0] = 1;
+			Keccak512 kcp3(true);
+			Keccak512 kcp4(kp512);
+			if (!TestUtils::IsStateRejected(&kcp3, &kcp4))
+				throw TestException("KeccakTest: A state with mismatched tree parameters was accepted!");
+			OnProgress(std::string("KeccakTest: Passed Keccak state serialization tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -1,12 +1,18 @@
 #include "McElieceTest.h"
 #include "../CEX/BCR.h"
+#include "../CEX/FFTM12T62.h"
 #include "../CEX/McEliece.h"
 #include "../CEX/IAsymmetricKeyPair.h"
 #include "../CEX/MPKCKeyPair.h"
 #include "../CEX/MPKCPrivateKey.h"
 #include "../CEX/MPKCPublicKey.h"
+#include "../CEX/MappedFile.h"
+#include "../CEX/PBR.h"
 #include "../CEX/RHX.h"
 #include "../CEX/SecureRandom.h"
+#include <cstdio>
+#include <fstream>
+#include <memory>
 
 namespace Test
 {
@@ -33,8 +39,14 @@ namespace Test
 		{
 			StressLoop();
 			OnProgress(std::string("McElieceTest: Passed encryption and Decryption stress tests.."));
+			BatchCompare();
+			OnProgress(std::string("McElieceTest: Passed batch encryption tests.."));
+			SyndromeCompare();
+			OnProgress(std::string("McElieceTest: Passed batch and single syndrome comparison tests.."));
 			SerializationCompare();
 			OnProgress(std::string("McElieceTest: Passed key serialization tests.."));
+			MappedKeyCompare();
+			OnProgress(std::string("McElieceTest: Passed mapped key file tests.."));
 
 			return SUCCESS;
 		}
@@ -48,6 +60,143 @@ namespace Test
 		}
 	}
 
+	void McElieceTest::BatchCompare()
+	{
+		// spans two batches of the syndrome product, the second one partial
+		const size_t MSGCNT = 70;
+		std::vector<std::vector<byte>> enc;
+		std::vector<std::vector<byte>> msg(MSGCNT);
+		std::vector<byte> dec;
+		Prng::SecureRandom rnd;
+
+		for (size_t i = 0; i < MSGCNT; ++i)
+		{
+			msg[i].resize(32 + (i % 3) * 16);
+			rnd.GetBytes(msg[i]);
+		}
+
+		McEliece cpr(Enumeration::MPKCParams::M12T62, Enumeration::Prngs::BCR, Enumeration::BlockCiphers::Rijndael);
+		IAsymmetricKeyPair* kp = cpr.Generate();
+
+		cpr.Initialize(true, kp);
+		enc = cpr.Encrypt(msg);
+
+		if (enc.size() != MSGCNT)
+		{
+			delete kp;
+			throw TestException("McElieceTest: Batch output count is invalid!");
+		}
+
+		cpr.Initialize(false, kp);
+
+		for (size_t i = 0; i < MSGCNT; ++i)
+		{
+			dec = cpr.Decrypt(enc[i]);
+
+			if (dec != msg[i])
+			{
+				delete kp;
+				throw TestException("McElieceTest: Batch decrypted output is not equal!");
+			}
+		}
+
+		delete kp;
+	}
+
+	void McElieceTest::MappedKeyCompare()
+	{
+		const std::string PUBPATH = "mpkc_test.pub";
+		const std::string PRIPATH = "mpkc_test.pri";
+		std::vector<byte> dec;
+		std::vector<byte> enc;
+		std::vector<byte> msg(128);
+		Prng::SecureRandom rnd;
+
+		McEliece cpr(Enumeration::MPKCParams::M12T62);
+		IAsymmetricKeyPair* kp = cpr.Generate();
+		WriteKey(PUBPATH, kp->PublicKey()->ToBytes());
+		WriteKey(PRIPATH, kp->PrivateKey()->ToBytes());
+
+		try
+		{
+			std::shared_ptr<IO::MappedFile> pubMap = std::make_shared<IO::MappedFile>(PUBPATH);
+			std::shared_ptr<IO::MappedFile> priMap = std::make_shared<IO::MappedFile>(PRIPATH, true);
+			// the keys hold references to the mappings; they are released before the key files are removed
+			std::unique_ptr<MPKCPublicKey> pubK(new MPKCPublicKey(pubMap));
+			std::unique_ptr<MPKCPrivateKey> priK(new MPKCPrivateKey(priMap));
+
+			// the mapped keys read the matrix in place, and serialize to the same key streams
+			if (!pubK->IsMapped() || pubK->PData() != pubMap->Data() + 5 || pubK->ToBytes() != kp->PublicKey()->ToBytes())
+			{
+				throw TestException("McElieceTest: Mapped public key test has failed!");
+			}
+			if (!priK->IsMapped() || priK->SData() != priMap->Data() + 5 || priK->ToBytes() != kp->PrivateKey()->ToBytes())
+			{
+				throw TestException("McElieceTest: Mapped private key test has failed!");
+			}
+
+			// the accessors return copies of the mapped keys, and leave the keys unchanged
+			if (pubK->P() != ((MPKCPublicKey*)kp->PublicKey())->P() || priK->S() != ((MPKCPrivateKey*)kp->PrivateKey())->S() || pubK->PData() != pubMap->Data() + 5)
+			{
+				throw TestException("McElieceTest: Mapped key copy test has failed!");
+			}
+
+			// a mapped public key encrypts to the heap private key, and a mapped private key decrypts
+			std::vector<byte> tag = kp->Tag();
+			MPKCKeyPair encPair(nullptr, pubK.get(), tag);
+			MPKCKeyPair decPair(priK.get(), nullptr, tag);
+			McEliece encMap(Enumeration::MPKCParams::M12T62);
+			McEliece decMap(Enumeration::MPKCParams::M12T62);
+			McEliece encHeap(Enumeration::MPKCParams::M12T62);
+			McEliece decHeap(Enumeration::MPKCParams::M12T62);
+			encMap.Initialize(true, &encPair);
+			decMap.Initialize(false, &decPair);
+			encHeap.Initialize(true, kp);
+			decHeap.Initialize(false, kp);
+
+			for (size_t i = 0; i < 4; ++i)
+			{
+				rnd.GetBytes(msg);
+				enc = encMap.Encrypt(msg);
+				dec = decHeap.Decrypt(enc);
+
+				if (dec != msg)
+				{
+					throw TestException("McElieceTest: Mapped public key output is not equal!");
+				}
+
+				enc = encHeap.Encrypt(msg);
+				dec = decMap.Decrypt(enc);
+
+				if (dec != msg)
+				{
+					throw TestException("McElieceTest: Mapped private key output is not equal!");
+				}
+			}
+
+			// the heap copy is made only on request
+			if (pubK->P() != ((MPKCPublicKey*)kp->PublicKey())->P())
+			{
+				throw TestException("McElieceTest: Mapped public key copy is not equal!");
+			}
+		}
+		catch (...)
+		{
+			std::remove(PUBPATH.c_str());
+			std::remove(PRIPATH.c_str());
+			delete kp->PrivateKey();
+			delete kp->PublicKey();
+			delete kp;
+			throw;
+		}
+
+		std::remove(PUBPATH.c_str());
+		std::remove(PRIPATH.c_str());
+		delete kp->PrivateKey();
+		delete kp->PublicKey();
+		delete kp;
+	}
+
 	void McElieceTest::SerializationCompare()
 	{
 		std::vector<byte> pkey;
@@ -152,8 +301,67 @@ namespace Test
 		delete sycPtr;
 	}
 
+	void McElieceTest::SyndromeCompare()
+	{
+		// a full batch of the syndrome product, and a partial one that ends inside a 64 message plane word
+		const size_t MSGCNT = 300;
+		const size_t ELEN = static_cast<size_t>(1) << (FFTM12T62::M - 3);
+		Prng::SecureRandom rnd;
+		// the generator seed must be at least one SHA512 block
+		std::vector<byte> seed(128);
+		rnd.GetBytes(seed);
+
+		McEliece cpr(Enumeration::MPKCParams::M12T62, Enumeration::Prngs::BCR, Enumeration::BlockCiphers::Rijndael);
+		IAsymmetricKeyPair* kp = cpr.Generate();
+		const std::vector<byte> pubKey = ((MPKCPublicKey*)kp->PublicKey())->P();
+
+		delete kp->PrivateKey();
+		delete kp->PublicKey();
+		delete kp;
+
+		for (size_t p = 0; p < 2; ++p)
+		{
+			// the error vectors are drawn in the same order by both paths, so equal generators produce the same vectors
+			std::unique_ptr<Prng::IPrng> rng1(new Prng::PBR(seed, 1));
+			std::unique_ptr<Prng::IPrng> rng2(new Prng::PBR(seed, 1));
+			std::vector<std::vector<byte>> eBatch(MSGCNT, std::vector<byte>(ELEN));
+			std::vector<std::vector<byte>> sBatch(MSGCNT, std::vector<byte>(FFTM12T62::SECRET_SIZE));
+			std::vector<byte> e(ELEN);
+			std::vector<byte> s(FFTM12T62::SECRET_SIZE);
+
+			FFTM12T62::Encrypt(sBatch, eBatch, pubKey.data(), rng1, p != 0);
+
+			for (size_t i = 0; i < MSGCNT; ++i)
+			{
+				FFTM12T62::Encrypt(s, e, pubKey.data(), rng2);
+
+				if (e != eBatch[i])
+				{
+					throw TestException("McElieceTest: Batch error vector is not equal!");
+				}
+				if (s != sBatch[i])
+				{
+					throw TestException("McElieceTest: Batch syndrome is not equal to the single message syndrome!");
+				}
+			}
+		}
+	}
+
 	void McElieceTest::OnProgress(std::string Data)
 	{
 		m_progressEvent(Data);
 	}
+
+	void McElieceTest::WriteKey(const std::string &FilePath, const std::vector<byte> &Key)
+	{
+		std::ofstream outStream(FilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if (!outStream.is_open())
+		{
+			throw TestException("McElieceTest: The key file could not be created!");
+		}
+
+		outStream.write(reinterpret_cast<const char*>(Key.data()), Key.size());
+		outStream.close();
+	}
 }
\ No newline at end of file
@@ -45,9 +45,13 @@ namespace Test
 
 	private:
 
+		void BatchCompare();
+		void MappedKeyCompare();
 		void OnProgress(std::string Data);
 		void StressLoop();
 		void SerializationCompare();
+		void SyndromeCompare();
+		void WriteKey(const std::string &FilePath, const std::vector<byte> &Key);
 	};
 }
 
@@ -26,6 +26,8 @@ namespace Test
 		{
 			UtilsCompare();
 			OnProgress(std::string("MemUtilsTest: Passed output comparison tests.."));
+			StreamCompare();
+			OnProgress(std::string("MemUtilsTest: Passed non-temporal streaming comparison tests.."));
 
 			return SUCCESS;
 		}
@@ -39,6 +41,90 @@ namespace Test
 		}
 	}
 
+	void MemUtilsTest::StreamCompare()
+	{
+		Prng::SecureRandom rng;
+		const size_t MINSZE = MemUtils::StreamThreshold();
+
+		// unaligned offsets and lengths exercise the head and tail of the streaming kernels
+		for (size_t i = 0; i < 8; ++i)
+		{
+			const size_t INPOFF = rng.NextUInt32(63);
+			const size_t OUTOFF = rng.NextUInt32(63);
+			const size_t INPSZE = MINSZE + rng.NextUInt32(4096);
+			std::vector<byte> input = rng.GetBytes(INPSZE + INPOFF);
+			std::vector<byte> output = rng.GetBytes(INPSZE + OUTOFF);
+			std::vector<byte> expected = output;
+
+			// copy
+			std::memcpy(&expected[OUTOFF], &input[INPOFF], INPSZE);
+			MemUtils::Copy(input, INPOFF, output, OUTOFF, INPSZE);
+
+			if (output != expected)
+			{
+				throw TestException("StreamCompare: streaming copy comparison failed!");
+			}
+
+			// xor
+			for (size_t j = 0; j < INPSZE; ++j)
+			{
+				expected[OUTOFF + j] ^= input[INPOFF + j];
+			}
+
+			MemUtils::XorBlock(input, INPOFF, output, OUTOFF, INPSZE);
+
+			if (output != expected)
+			{
+				throw TestException("StreamCompare: streaming xor comparison failed!");
+			}
+
+			// set
+			const byte VAL = static_cast<byte>(rng.NextUInt32(255, 1));
+			std::memset(&expected[OUTOFF], VAL, INPSZE);
+			MemUtils::SetValue(output, OUTOFF, INPSZE, VAL);
+
+			if (output != expected)
+			{
+				throw TestException("StreamCompare: streaming set comparison failed!");
+			}
+
+			// clear
+			std::memset(&expected[OUTOFF], 0, INPSZE);
+			MemUtils::Clear(output, OUTOFF, INPSZE);
+
+			if (output != expected)
+			{
+				throw TestException("StreamCompare: streaming clear comparison failed!");
+			}
+
+			// secure erase
+			MemUtils::SecureErase(input, 0, input.size());
+
+			if (input != std::vector<byte>(input.size(), 0))
+			{
+				throw TestException("StreamCompare: secure erase comparison failed!");
+			}
+		}
+
+		// 32 bit integer arrays
+		std::vector<uint> input32(MINSZE / sizeof(uint) + 17);
+		std::vector<uint> output32(input32.size());
+		rng.Fill(input32, 0, input32.size());
+		MemUtils::Copy(input32, 0, output32, 0, input32.size() * sizeof(uint));
+
+		if (output32 != input32)
+		{
+			throw TestException("StreamCompare: streaming integer copy comparison failed!");
+		}
+
+		MemUtils::XorBlock(input32, 0, output32, 0, input32.size() * sizeof(uint));
+
+		if (output32 != std::vector<uint>(output32.size(), 0))
+		{
+			throw TestException("StreamCompare: streaming integer xor comparison failed!");
+		}
+	}
+
 	void MemUtilsTest::UtilsCompare()
 	{
 		Prng::SecureRandom rng;
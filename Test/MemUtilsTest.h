@@ -65,6 +65,7 @@ namespace Test
 		uint64_t GetBytesPerSecond(uint64_t DurationTicks, uint64_t DataSize);
 		void PostPerfResult(uint64_t Duration, uint64_t Length, const std::string &Message);
 		void OnProgress(std::string Data);
+		void StreamCompare();
 		void UtilsCompare();
 	};
 }
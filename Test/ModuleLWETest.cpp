@@ -0,0 +1,618 @@
+#include "ModuleLWETest.h"
+#include "../CEX/BCR.h"
+#include "../CEX/CryptoAuthenticationFailure.h"
+#include "../CEX/IAsymmetricKeyPair.h"
+#include "../CEX/ModuleLWE.h"
+#include "../CEX/MLWEKeyPair.h"
+#include "../CEX/MLWEPrivateKey.h"
+#include "../CEX/MLWEPublicKey.h"
+#include "../CEX/MLWEQ3329N256.h"
+#include "../CEX/RHX.h"
+#include "../CEX/SecureRandom.h"
+#include "../CEX/SHA256.h"
+#include "../CEX/SHAKE.h"
+
+namespace Test
+{
+	using namespace Key::Asymmetric;
+	using namespace Cipher::Asymmetric::MLWE;
+
+	const std::string ModuleLWETest::DESCRIPTION = "ModuleLWE key generation, encryption, and decryption tests..";
+	const std::string ModuleLWETest::FAILURE = "FAILURE! ";
+	const std::string ModuleLWETest::SUCCESS = "SUCCESS! ModuleLWE tests have executed succesfully.";
+
+	ModuleLWETest::ModuleLWETest()
+		:
+		m_expected(0),
+		m_progressEvent()
+	{
+	}
+
+	ModuleLWETest::~ModuleLWETest()
+	{
+	}
+
+	std::string ModuleLWETest::Run()
+	{
+		try
+		{
+			Initialize();
+
+			KnownAnswerTest();
+			OnProgress(std::string("ModuleLWETest: Passed the deterministic key generation, encapsulation and decapsulation known answer tests.."));
+			LayoutCompare();
+			OnProgress(std::string("ModuleLWETest: Passed the FIPS 203 key and cipher-text encoding tests.."));
+			NttCompare();
+			OnProgress(std::string("ModuleLWETest: Passed the vectorized and scalar NTT equivalence tests.."));
+			SamplerCompare();
+			OnProgress(std::string("ModuleLWETest: Passed the vectorized and scalar sampler equivalence tests.."));
+			StressLoop();
+			OnProgress(std::string("ModuleLWETest: Passed encryption and Decryption stress tests.."));
+			AuthenticationCheck();
+			OnProgress(std::string("ModuleLWETest: Passed cipher-text authentication tests.."));
+			SerializationCompare();
+			OnProgress(std::string("ModuleLWETest: Passed key serialization tests.."));
+			AcvpCompare();
+			OnProgress(std::string("ModuleLWETest: Passed the NIST ACVP key generation, encapsulation and decapsulation vector tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(FAILURE + std::string(" : Unknown Error"));
+		}
+	}
+
+	void ModuleLWETest::AcvpCompare()
+	{
+		const std::vector<std::string> SETS = { "ML-KEM-512", "ML-KEM-768", "ML-KEM-1024" };
+		std::vector<std::map<std::string, std::string>> cases;
+		std::vector<size_t> decCount(SETS.size(), 0);
+		std::vector<size_t> encCount(SETS.size(), 0);
+		std::vector<size_t> genCount(SETS.size(), 0);
+		std::vector<byte> ct(0);
+		std::vector<byte> exp(0);
+		std::vector<byte> key(0);
+		std::vector<byte> msg(0);
+		std::vector<byte> pk(0);
+		std::vector<byte> sec(0);
+		std::vector<byte> seed(0);
+		std::vector<byte> sk(0);
+		std::string data;
+
+		// ML-KEM.KeyGen_internal(d, z) must reproduce the official encapsulation and decapsulation keys
+		TestUtils::Read(TestFiles::ACVP::MLKEMKEYGEN, data);
+		TestUtils::ParseAcvp(data, cases);
+
+		for (size_t i = 0; i < cases.size(); ++i)
+		{
+			const size_t SETIDX = std::find(SETS.begin(), SETS.end(), cases[i]["parameterSet"]) - SETS.begin();
+
+			if (SETIDX == SETS.size() || cases[i].count("d") == 0 || cases[i].count("z") == 0)
+			{
+				continue;
+			}
+
+			MLWEParamSet params;
+			MLWEQ3329N256::GetParamSet(params, static_cast<Enumeration::MLWEParams>(SETIDX + 1));
+			HexConverter::Decode(cases[i]["d"] + cases[i]["z"], seed);
+			MLWEQ3329N256::Generate(pk, sk, seed, params);
+
+			HexConverter::Decode(cases[i]["ek"], exp);
+
+			if (pk != exp)
+			{
+				throw TestException("ModuleLWETest: The encapsulation key does not match the ACVP vector " + cases[i]["tcId"] + "!");
+			}
+
+			HexConverter::Decode(cases[i]["dk"], exp);
+
+			if (sk != exp)
+			{
+				throw TestException("ModuleLWETest: The decapsulation key does not match the ACVP vector " + cases[i]["tcId"] + "!");
+			}
+
+			++genCount[SETIDX];
+		}
+
+		// ML-KEM.Encaps_internal(ek, m) and ML-KEM.Decaps(dk, c), the key check groups are not covered
+		TestUtils::Read(TestFiles::ACVP::MLKEMENCAPDECAP, data);
+		TestUtils::ParseAcvp(data, cases);
+
+		for (size_t i = 0; i < cases.size(); ++i)
+		{
+			const size_t SETIDX = std::find(SETS.begin(), SETS.end(), cases[i]["parameterSet"]) - SETS.begin();
+			const std::string FUNC = cases[i]["function"];
+
+			if (SETIDX == SETS.size())
+			{
+				continue;
+			}
+
+			MLWEParamSet params;
+			MLWEQ3329N256::GetParamSet(params, static_cast<Enumeration::MLWEParams>(SETIDX + 1));
+			HexConverter::Decode(cases[i]["k"], key);
+
+			if (FUNC == "encapsulation")
+			{
+				HexConverter::Decode(cases[i]["ek"], pk);
+				HexConverter::Decode(cases[i]["m"], msg);
+				HexConverter::Decode(cases[i]["c"], exp);
+				MLWEQ3329N256::Encrypt(sec, ct, pk, msg, params);
+
+				if (ct != exp || sec != key)
+				{
+					throw TestException("ModuleLWETest: The encapsulation does not match the ACVP vector " + cases[i]["tcId"] + "!");
+				}
+
+				++encCount[SETIDX];
+			}
+			else if (FUNC == "decapsulation")
+			{
+				HexConverter::Decode(cases[i]["dk"], sk);
+				HexConverter::Decode(cases[i]["c"], ct);
+				MLWEQ3329N256::Decrypt(sec, ct, sk, params);
+
+				if (sec != key)
+				{
+					throw TestException("ModuleLWETest: The decapsulation does not match the ACVP vector " + cases[i]["tcId"] + "!");
+				}
+
+				++decCount[SETIDX];
+			}
+		}
+
+		for (size_t i = 0; i < SETS.size(); ++i)
+		{
+			if (genCount[i] == 0 || encCount[i] == 0 || decCount[i] == 0)
+			{
+				throw TestException("ModuleLWETest: The ACVP vector files have no tests for " + SETS[i] + "!");
+			}
+		}
+	}
+
+	void ModuleLWETest::AuthenticationCheck()
+	{
+		std::vector<byte> enc;
+		std::vector<byte> msg(64);
+		Prng::SecureRandom rnd;
+		size_t pos;
+
+		for (byte p = 1; p <= 3; ++p)
+		{
+			ModuleLWE cpr(static_cast<Enumeration::MLWEParams>(p), Enumeration::Prngs::BCR, Enumeration::BlockCiphers::Rijndael);
+
+			for (size_t i = 0; i < 10; ++i)
+			{
+				rnd.GetBytes(msg);
+				IAsymmetricKeyPair* kp = cpr.Generate();
+
+				cpr.Initialize(true, kp);
+				enc = cpr.Encrypt(msg);
+
+				// alternate between the encapsulated secret and the encrypted message
+				pos = (i % 2 == 0) ? rnd.NextUInt32(static_cast<uint>(cpr.ParamSet().CipherTextSize - 1)) : cpr.ParamSet().CipherTextSize + (i % msg.size());
+				enc[pos] ^= 1;
+				cpr.Initialize(false, kp);
+
+				bool status = false;
+
+				try
+				{
+					cpr.Decrypt(enc);
+				}
+				catch (Exception::CryptoAuthenticationFailure const &)
+				{
+					status = true;
+				}
+
+				delete kp->PrivateKey();
+				delete kp->PublicKey();
+				delete kp;
+
+				if (!status)
+				{
+					throw TestException("ModuleLWETest: Modified cipher-text was not rejected!");
+				}
+			}
+		}
+	}
+
+	void ModuleLWETest::Initialize()
+	{
+		const char* expectedEnc[18] =
+		{
+			// regression values: the SHA2-256 hashes of the public key, private key and cipher-text, the shared secret, and the implicit rejection secret,
+			// for the ML-KEM-512, ML-KEM-768 and ML-KEM-1024 sets
+			("3AE268DCCC5456AC0D0F9B39257DC48FE081383B97C400512D712B739762DAEE"),
+			("17FB29B8C4BAF74FB81EEA15FFD583B3E37F5A5B8DCF6DB96C72C3B3751D6F17"),
+			("81EFE667826848514DCAE46FC10CFD34F7B95ED6900E094F727C9E7CCCC34DF2"),
+			("14CACE3E48771B316676AFAD2CFCFE8488DAAA4FAD954E57236CAA3F24A42CF7"),
+			("32EE1FB3F7BD2915218E9C1B2D0D2DA88F0EDCE6804278BAB3A6123C5BB64FC4"),
+			("0B7934C83125C788995E2BA6BD761E33046B3E40571BE53E023309A29F398CC9"),
+			("DAC268BDE6A8DD238E9887117D6B664E7A7A9350AD6B7C08A948E504809572A5"),
+			("DBF4E9AA48B078AD46EC1C9C47BDA8C2D2FEC9D0E7A21BD48D2238A2ABEDB856"),
+			("9CDDD089FFE70E3996E76F7C8D06746DF34D07E8657BC0FCF2BB0E1C3084AEA1"),
+			("DCFC80C6DB46FF7028E3A4398651C063AE7A42C107A6DC8CB07141861698AB92"),
+			("C7B8FA0AA471D5AE18922D6CCAD5B31E1D84F92AE723ABFD13747018740A8530"),
+			("3A2A676C5A242EE683CB6097C8F3E64FBEF4D90267F9250EC2BEAB8F99621FAD"),
+			("7C89743960F7C3D17BB69572E49DE14FE0990C9113A0706963A8F4C7B39AFCDF"),
+			("0AD8D1EA1B8DD788979B4379581218DF9321BDCE5567ECA42AE6BE7D395F1A54"),
+			("8F2C880890996C587AA500CF8B6DA03372DE706A9F96075744BB0956EA6FBAAC"),
+			// rho: the first 32 bytes of SHA3-512(d || k), for the ML-KEM-512, ML-KEM-768 and ML-KEM-1024 sets
+			("344BADD000F8D8C537C48F998F05307CEBD1EDE0B81C3BC59A065A1B6D63B26C"),
+			("5E43481C3EEB397EB192505229B67A201EA893C3E2CB32DA8BC342FA4DEA0578"),
+			("44B6C66984A868AA92FA02227A086950EB0C8701ED58DC628776B983882E1175")
+		};
+		HexConverter::Decode(expectedEnc, 18, m_expected);
+	}
+
+	void ModuleLWETest::KnownAnswerTest()
+	{
+		std::vector<byte> ct(0);
+		std::vector<byte> hash(32);
+		std::vector<byte> msg(32);
+		std::vector<byte> pk(0);
+		std::vector<byte> sec1(0);
+		std::vector<byte> sec2(0);
+		std::vector<byte> seed(64);
+		std::vector<byte> sk(0);
+
+		// d || z = 00 01 .. 3F, m = 40 41 .. 5F, and the rejection test flips the low bit of the first cipher-text byte;
+		// the pinned values are regression values from a python transcription of FIPS 203 written alongside this code,
+		// the official NIST vectors are checked by AcvpCompare
+		for (size_t i = 0; i < seed.size(); ++i)
+		{
+			seed[i] = static_cast<byte>(i);
+		}
+
+		for (size_t i = 0; i < msg.size(); ++i)
+		{
+			msg[i] = static_cast<byte>(seed.size() + i);
+		}
+
+		for (byte p = 1; p <= 3; ++p)
+		{
+			const size_t EXPOFF = (p - 1) * 5;
+			MLWEParamSet params;
+			Digest::SHA256 dgt;
+
+			MLWEQ3329N256::GetParamSet(params, static_cast<Enumeration::MLWEParams>(p));
+			MLWEQ3329N256::Generate(pk, sk, seed, params);
+
+			dgt.Compute(pk, hash);
+
+			if (hash != m_expected[EXPOFF])
+			{
+				throw TestException("ModuleLWETest: The public key does not match the known answer!");
+			}
+
+			dgt.Compute(sk, hash);
+
+			if (hash != m_expected[EXPOFF + 1])
+			{
+				throw TestException("ModuleLWETest: The private key does not match the known answer!");
+			}
+
+			MLWEQ3329N256::Encrypt(sec1, ct, pk, msg, params);
+			dgt.Compute(ct, hash);
+
+			if (hash != m_expected[EXPOFF + 2])
+			{
+				throw TestException("ModuleLWETest: The cipher-text does not match the known answer!");
+			}
+
+			if (sec1 != m_expected[EXPOFF + 3])
+			{
+				throw TestException("ModuleLWETest: The encapsulated secret does not match the known answer!");
+			}
+
+			MLWEQ3329N256::Decrypt(sec2, ct, sk, params);
+
+			if (sec2 != m_expected[EXPOFF + 3])
+			{
+				throw TestException("ModuleLWETest: The decapsulated secret does not match the known answer!");
+			}
+
+			ct[0] ^= 1;
+			MLWEQ3329N256::Decrypt(sec2, ct, sk, params);
+
+			if (sec2 != m_expected[EXPOFF + 4])
+			{
+				throw TestException("ModuleLWETest: The implicit rejection secret does not match the known answer!");
+			}
+		}
+	}
+
+	void ModuleLWETest::LayoutCompare()
+	{
+		// the FIPS 203 encapsulation key, decapsulation key and cipher-text sizes for ML-KEM-512, ML-KEM-768 and ML-KEM-1024
+		const size_t PKSIZE[3] = { 800, 1184, 1568 };
+		const size_t SKSIZE[3] = { 1632, 2400, 3168 };
+		const size_t CTSIZE[3] = { 768, 1088, 1568 };
+		std::vector<byte> ct(0);
+		std::vector<byte> msg(32);
+		std::vector<byte> pk(0);
+		std::vector<byte> rej(32);
+		std::vector<byte> sec(0);
+		std::vector<byte> seed(64);
+		std::vector<byte> sk(0);
+
+		for (size_t i = 0; i < seed.size(); ++i)
+		{
+			seed[i] = static_cast<byte>(i);
+		}
+
+		for (size_t i = 0; i < msg.size(); ++i)
+		{
+			msg[i] = static_cast<byte>(seed.size() + i);
+		}
+
+		for (byte p = 1; p <= 3; ++p)
+		{
+			const size_t K = p + 1;
+			MLWEParamSet params;
+
+			MLWEQ3329N256::GetParamSet(params, static_cast<Enumeration::MLWEParams>(p));
+			MLWEQ3329N256::Generate(pk, sk, seed, params);
+
+			if (pk.size() != PKSIZE[p - 1] || sk.size() != SKSIZE[p - 1])
+			{
+				throw TestException("ModuleLWETest: The key sizes do not match the standard!");
+			}
+
+			// ek = t || rho, and dk = s || ek || H(ek) || z
+			if (std::vector<byte>(pk.begin() + (384 * K), pk.end()) != m_expected[15 + (p - 1)])
+			{
+				throw TestException("ModuleLWETest: The public seed is not encoded as the standard requires!");
+			}
+
+			if (std::vector<byte>(sk.begin() + (384 * K), sk.begin() + (384 * K) + pk.size()) != pk)
+			{
+				throw TestException("ModuleLWETest: The encapsulation key is not embedded in the decapsulation key!");
+			}
+
+			if (std::vector<byte>(sk.end() - 32, sk.end()) != std::vector<byte>(seed.begin() + 32, seed.end()))
+			{
+				throw TestException("ModuleLWETest: The rejection seed is not encoded as the standard requires!");
+			}
+
+			MLWEQ3329N256::Encrypt(sec, ct, pk, msg, params);
+
+			if (ct.size() != CTSIZE[p - 1] || sec.size() != 32)
+			{
+				throw TestException("ModuleLWETest: The cipher-text size does not match the standard!");
+			}
+
+			// a modified cipher-text decapsulates to J(z || c) = SHAKE256(z || c, 32)
+			ct[0] ^= 1;
+			MLWEQ3329N256::Decrypt(sec, ct, sk, params);
+
+			std::vector<byte> zct(seed.begin() + 32, seed.end());
+			zct.insert(zct.end(), ct.begin(), ct.end());
+			Kdf::SHAKE gen(Enumeration::Digests::Keccak512);
+			gen.Initialize(zct);
+			gen.Generate(rej);
+
+			if (sec != rej)
+			{
+				throw TestException("ModuleLWETest: The implicit rejection secret is not derived as the standard requires!");
+			}
+		}
+	}
+
+	void ModuleLWETest::NttCompare()
+	{
+		const int MLWEQ = 3329;
+		std::vector<byte> buf(2 * 256);
+		MLWEQ3329N256::Poly a1;
+		MLWEQ3329N256::Poly a2;
+		Prng::SecureRandom rnd;
+
+		// inputs are bounded by q; the transforms may return different representatives, but they must agree modulo q
+		for (size_t i = 0; i < 200; ++i)
+		{
+			rnd.GetBytes(buf);
+
+			for (size_t j = 0; j < a1.size(); ++j)
+			{
+				const uint X = static_cast<uint>(buf[j * 2]) | (static_cast<uint>(buf[(j * 2) + 1]) << 8);
+				a1[j] = static_cast<short>(static_cast<int>(X % static_cast<uint>((2 * MLWEQ) - 1)) - (MLWEQ - 1));
+			}
+
+			a2 = a1;
+
+			// even passes run the forward transform, odd passes the inverse
+			if (i % 2 == 0)
+			{
+				MLWEQ3329N256::Ntt(a1);
+				MLWEQ3329N256::NttScalar(a2);
+			}
+			else
+			{
+				MLWEQ3329N256::NttInv(a1);
+				MLWEQ3329N256::NttInvScalar(a2);
+			}
+
+			for (size_t j = 0; j < a1.size(); ++j)
+			{
+				if ((((static_cast<int>(a1[j]) - static_cast<int>(a2[j])) % MLWEQ) + MLWEQ) % MLWEQ != 0)
+				{
+					throw TestException("ModuleLWETest: The vectorized and scalar NTT outputs are not equal!");
+				}
+			}
+		}
+	}
+
+	void ModuleLWETest::SamplerCompare()
+	{
+		std::vector<byte> buf(3 * 168);
+		MLWEQ3329N256::Poly a1;
+		MLWEQ3329N256::Poly a2;
+		size_t ctr1;
+		size_t ctr2;
+		Prng::SecureRandom rnd;
+
+		for (size_t i = 0; i < 200; ++i)
+		{
+			rnd.GetBytes(buf);
+
+			// the binomial noise sampler, with eta 2 on even passes and eta 3 on odd passes
+			const uint ETA = (i % 2 == 0) ? 2 : 3;
+			MLWEQ3329N256::Cbd(a1, buf, 0, ETA);
+			MLWEQ3329N256::CbdScalar(a2, buf, 0, ETA);
+
+			if (a1 != a2)
+			{
+				throw TestException("ModuleLWETest: The vectorized and scalar noise sampler outputs are not equal!");
+			}
+
+			// the uniform rejection sampler; short inputs leave the polynomial partially filled, and the fill is resumed from a second block
+			const size_t INPLEN = (i % 2 == 0) ? buf.size() : 168;
+			ctr1 = 0;
+			ctr2 = 0;
+			MLWEQ3329N256::RejUniform(a1, ctr1, buf, 0, INPLEN);
+			MLWEQ3329N256::RejUniformScalar(a2, ctr2, buf, 0, INPLEN);
+
+			if (ctr1 < a1.size())
+			{
+				rnd.GetBytes(buf);
+				MLWEQ3329N256::RejUniform(a1, ctr1, buf, 0, buf.size());
+				MLWEQ3329N256::RejUniformScalar(a2, ctr2, buf, 0, buf.size());
+			}
+
+			if (ctr1 != ctr2 || a1 != a2)
+			{
+				throw TestException("ModuleLWETest: The vectorized and scalar rejection sampler outputs are not equal!");
+			}
+		}
+	}
+
+	void ModuleLWETest::SerializationCompare()
+	{
+		std::vector<byte> skey;
+
+		for (byte p = 1; p <= 3; ++p)
+		{
+			ModuleLWE cpr(static_cast<Enumeration::MLWEParams>(p));
+
+			for (size_t i = 0; i < 33; ++i)
+			{
+				IAsymmetricKeyPair* kp = cpr.Generate();
+				MLWEPrivateKey* priK1 = (MLWEPrivateKey*)kp->PrivateKey();
+				skey = priK1->ToBytes();
+				MLWEPrivateKey priK2(skey);
+
+				if (priK1->S() != priK2.S() || priK1->Parameters() != priK2.Parameters())
+				{
+					throw TestException("ModuleLWETest: Private key serialization test has failed!");
+				}
+
+				MLWEPublicKey* pubK1 = (MLWEPublicKey*)kp->PublicKey();
+				skey = pubK1->ToBytes();
+				MLWEPublicKey pubK2(skey);
+
+				if (pubK1->P() != pubK2.P() || pubK1->Parameters() != pubK2.Parameters())
+				{
+					throw TestException("ModuleLWETest: Public key serialization test has failed!");
+				}
+
+				delete kp;
+				delete priK1;
+				delete pubK1;
+			}
+		}
+	}
+
+	void ModuleLWETest::StressLoop()
+	{
+		std::vector<byte> enc;
+		std::vector<byte> dec;
+		std::vector<byte> msg(128);
+		Prng::SecureRandom rnd;
+
+		for (byte p = 1; p <= 3; ++p)
+		{
+			Prng::BCR* rngPtr = new Prng::BCR();
+			// test the extended cipher implementation
+			Cipher::Symmetric::Block::RHX* sycPtr = new Cipher::Symmetric::Block::RHX(Enumeration::Digests::SHA256);
+
+			// note: as with RingLWE, an HX cipher uses k512=keccak1024(ss) -> GCM(AHX||SHX||THX(k512))
+			// and a standard cipher uses k256=keccak512(ss) -> GCM(AES||Serpent||Twofish(k256))
+			ModuleLWE cpr1(static_cast<Enumeration::MLWEParams>(p), rngPtr, sycPtr);
+			msg.resize(128);
+
+			for (size_t i = 0; i < 33; ++i)
+			{
+				rnd.GetBytes(msg);
+				IAsymmetricKeyPair* kp = cpr1.Generate();
+
+				cpr1.Initialize(true, kp);
+				enc = cpr1.Encrypt(msg);
+
+				cpr1.Initialize(false, kp);
+				dec = cpr1.Decrypt(enc);
+
+				delete kp->PrivateKey();
+				delete kp->PublicKey();
+				delete kp;
+
+				if (dec != msg)
+				{
+					throw TestException("ModuleLWETest: Decrypted output is not equal!");
+				}
+			}
+
+			// test the standard cipher implementation
+			ModuleLWE cpr2(static_cast<Enumeration::MLWEParams>(p), Enumeration::Prngs::BCR, Enumeration::BlockCiphers::Rijndael);
+			msg.resize(64);
+
+			for (size_t i = 0; i < 33; ++i)
+			{
+				rnd.GetBytes(msg);
+				IAsymmetricKeyPair* kp = cpr2.Generate();
+
+				cpr2.Initialize(true, kp);
+				enc = cpr2.Encrypt(msg);
+
+				if (enc.size() != cpr2.ParamSet().CipherTextSize + msg.size() + 16)
+				{
+					throw TestException("ModuleLWETest: Cipher-text size is incorrect!");
+				}
+
+				cpr2.Initialize(false, kp);
+				dec = cpr2.Decrypt(enc);
+
+				delete kp->PrivateKey();
+				delete kp->PublicKey();
+				delete kp;
+
+				if (dec != msg)
+				{
+					throw TestException("ModuleLWETest: Decrypted output is not equal!");
+				}
+			}
+
+			if (rngPtr == nullptr)
+			{
+				throw TestException("ModuleLWETest: Prng was reset!");
+			}
+			if (sycPtr == nullptr)
+			{
+				throw TestException("ModuleLWETest: Block cipher was reset!");
+			}
+
+			delete rngPtr;
+			delete sycPtr;
+		}
+	}
+
+	void ModuleLWETest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef _CEXTEST_MODULELWETEST_H
+#define _CEXTEST_MODULELWETEST_H
+
+#include "ITest.h"
+
+namespace Test
+{
+	/// <summary>
+	/// ModuleLWE (Kyber) key generation, encryption, and decryption tests
+	/// </summary>
+	class ModuleLWETest : public ITest
+	{
+	private:
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<std::vector<byte>> m_expected;
+		TestEventHandler m_progressEvent;
+
+	public:
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		virtual const std::string Description() { return DESCRIPTION; }
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		virtual TestEventHandler &Progress() { return m_progressEvent; }
+
+		/// <summary>
+		/// 
+		/// </summary>
+		ModuleLWETest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~ModuleLWETest();
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		virtual std::string Run();
+
+	private:
+
+		void OnProgress(std::string Data);
+		void AcvpCompare();
+		void AuthenticationCheck();
+		void Initialize();
+		void KnownAnswerTest();
+		void LayoutCompare();
+		void NttCompare();
+		void SamplerCompare();
+		void SerializationCompare();
+		void StressLoop();
+	};
+}
+
+#endif
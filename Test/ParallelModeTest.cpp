@@ -9,8 +9,10 @@
 #include "../CEX/CpuDetect.h"
 #include "../CEX/CSP.h"
 #include "../CEX/CTR.h"
+#include "../CEX/CTRT.h"
 #include "../CEX/ECB.h"
 #include "../CEX/ICM.h"
+#include "../CEX/ICMT.h"
 #include "../CEX/ParallelUtils.h"
 #include "../CEX/RHX.h"
 #include "../CEX/SecureRandom.h"
@@ -91,6 +93,39 @@ namespace Test
 			}
 #endif
 
+#if defined(__AVX__)
+			if (m_hasAESNI)
+			{
+				CTR* ctr1 = new CTR(BlockCiphers::Rijndael);
+				CTRT<AHX>* ctr2 = new CTRT<AHX>();
+				CompareModeT(ctr1, ctr2);
+				delete ctr1;
+				delete ctr2;
+				OnProgress(std::string("ParallelModeTest: AHX Passed AES-NI specialized CTR comparison tests.."));
+
+				ICM* icm1 = new ICM(BlockCiphers::Rijndael);
+				ICMT<AHX>* icm2 = new ICMT<AHX>();
+				CompareModeT(icm1, icm2);
+				delete icm1;
+				delete icm2;
+				OnProgress(std::string("ParallelModeTest: AHX Passed AES-NI specialized ICM comparison tests.."));
+			}
+#endif
+
+			CTR* ctr3 = new CTR(BlockCiphers::Serpent);
+			CTRT<SHX>* ctr4 = new CTRT<SHX>();
+			CompareModeT(ctr3, ctr4);
+			delete ctr3;
+			delete ctr4;
+			OnProgress(std::string("ParallelModeTest: SHX Passed Serpent specialized CTR comparison tests.."));
+
+			ICM* icm3 = new ICM(BlockCiphers::Serpent);
+			ICMT<SHX>* icm4 = new ICMT<SHX>();
+			CompareModeT(icm3, icm4);
+			delete icm3;
+			delete icm4;
+			OnProgress(std::string("ParallelModeTest: SHX Passed Serpent specialized ICM comparison tests.."));
+
 			SHX* eng2 = new SHX();
 			CompareBcrSimd(eng2);
 			OnProgress(std::string("ParallelModeTest: SHX Passed Serpent Parallel Intrinsics Integrity tests.."));
@@ -130,6 +165,8 @@ namespace Test
 			OnProgress(std::string("ParallelModeTest: Passed CBC/CFB/CTR/ICM Parallel encryption and decryption looping Integrity tests.."));
 			CompareParallelOutput();
 			OnProgress(std::string("ParallelModeTest: Passed CBC/CFB/CTR/ICM Parallel output encryption and decryption tests.."));
+			CompareNumaOutput();
+			OnProgress(std::string("ParallelModeTest: Passed CTR/ICM NUMA placement output tests.."));
 
 			return SUCCESS;
 		}
@@ -513,6 +550,85 @@ namespace Test
 		}
 	}
 
+	void ParallelModeTest::CompareModeT(ICipherMode* Cipher1, ICipherMode* Cipher2)
+	{
+		std::vector<byte> data;
+		std::vector<byte> dec;
+		std::vector<byte> enc1;
+		std::vector<byte> enc2;
+		std::vector<byte> key(32);
+		std::vector<byte> iv(16);
+		Prng::SecureRandom rng;
+
+		for (size_t i = 0; i < TEST_LOOPS; ++i)
+		{
+			// unaligned lengths and piece sizes exercise the partial block, and carry the counter between calls
+			const size_t SMPSZE = rng.NextInt32(MAX_ALLOC, 1);
+			const size_t PCESZE = rng.NextInt32(200, 1);
+			data.resize(SMPSZE);
+			dec.resize(SMPSZE);
+			enc1.resize(SMPSZE);
+			enc2.resize(SMPSZE);
+			rng.GetBytes(data);
+			GetBytes(32, key);
+			GetBytes(16, iv);
+			Key::Symmetric::SymmetricKey keyParam(key, iv);
+
+			Cipher1->ParallelProfile().IsParallel() = false;
+			Cipher1->Initialize(true, keyParam);
+			Transform3(Cipher1, data, enc1);
+
+			Cipher2->ParallelProfile().IsParallel() = false;
+			Cipher2->Initialize(true, keyParam);
+			Transform3(Cipher2, data, enc2);
+
+			if (enc1 != enc2)
+				throw TestException("Specialized mode: Encrypted output is not equal!");
+
+			Cipher1->Initialize(true, keyParam);
+			Transform2(Cipher1, data, PCESZE, enc1);
+
+			Cipher2->Initialize(true, keyParam);
+			Transform2(Cipher2, data, PCESZE, enc2);
+
+			if (enc1 != enc2)
+				throw TestException("Specialized mode: Encrypted piecewise output is not equal!");
+
+			Cipher2->Initialize(false, keyParam);
+			Transform2(Cipher2, enc2, PCESZE, dec);
+
+			if (dec != data)
+				throw TestException("Specialized mode: Decrypted output is not equal!");
+		}
+
+		// the threaded path is forced on single core systems
+		const size_t PRLSZE = Cipher2->ParallelProfile().ParallelMinimumSize() * Cipher2->ParallelProfile().ProcessorCount();
+
+		for (size_t i = 0; i < TEST_LOOPS; ++i)
+		{
+			const size_t SMPSZE = (PRLSZE * 2) + rng.NextInt32(PRLSZE, 1);
+			data.resize(SMPSZE);
+			enc1.resize(SMPSZE);
+			enc2.resize(SMPSZE);
+			rng.GetBytes(data);
+			GetBytes(32, key);
+			GetBytes(16, iv);
+			Key::Symmetric::SymmetricKey keyParam(key, iv);
+
+			Cipher1->ParallelProfile().IsParallel() = false;
+			Cipher1->Initialize(true, keyParam);
+			Transform3(Cipher1, data, enc1);
+
+			Cipher2->ParallelProfile().ParallelBlockSize() = PRLSZE;
+			Cipher2->ParallelProfile().IsParallel() = true;
+			Cipher2->Initialize(true, keyParam);
+			Transform3(Cipher2, data, enc2);
+
+			if (enc1 != enc2)
+				throw TestException("Specialized mode: Parallel encrypted output is not equal!");
+		}
+	}
+
 	void ParallelModeTest::CompareCbcDecrypt(IBlockCipher* Engine1, IBlockCipher* Engine2)
 	{
 		std::vector<byte> data;
@@ -778,6 +894,73 @@ namespace Test
 		OnProgress(std::string("Passed CFB Mode tests.."));
 	}
 
+	void ParallelModeTest::CompareNumaOutput()
+	{
+		std::vector<byte> data;
+		std::vector<byte> enc1;
+		std::vector<byte> enc2;
+		std::vector<byte> key;
+		std::vector<byte> iv;
+
+		GetBytes(32, key);
+		GetBytes(16, iv);
+		Key::Symmetric::SymmetricKey keyParam(key, iv);
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			RHX* eng = new RHX();
+			Mode::ICipherMode* cipher;
+
+			if (i == 0)
+			{
+				cipher = new Mode::CTR(eng);
+			}
+			else
+			{
+				cipher = new Mode::ICM(eng);
+			}
+
+			cipher->ParallelProfile().SetMaxDegree(4);
+			cipher->ParallelProfile().IsParallel() = true;
+			const size_t PRLLEN = cipher->ParallelBlockSize();
+
+			GetBytes(PRLLEN * 4, data);
+			enc1.resize(data.size());
+			enc2.resize(data.size());
+
+			// distributing the pages must not change the contents of the buffers
+			std::vector<byte> tmp = data;
+			Utility::ParallelUtils::FirstTouch(data.data(), data.size(), cipher->ParallelProfile().ParallelMaxDegree());
+			Utility::ParallelUtils::FirstTouch(enc2.data(), enc2.size(), cipher->ParallelProfile().ParallelMaxDegree());
+
+			if (tmp != data)
+			{
+				throw TestException("CompareNumaOutput: Page placement changed the buffer!");
+			}
+
+			cipher->Initialize(true, keyParam);
+			cipher->ParallelProfile().IsParallel() = false;
+			cipher->Transform(data, 0, enc1, 0, data.size());
+
+			cipher->Initialize(true, keyParam);
+			cipher->ParallelProfile().IsParallel() = true;
+			cipher->ParallelProfile().IsNumaAware() = true;
+
+			for (size_t j = 0; j < data.size(); j += PRLLEN)
+			{
+				cipher->Transform(data, j, enc2, j, PRLLEN);
+			}
+
+			if (enc1 != enc2)
+			{
+				throw TestException("CompareNumaOutput: Encrypted output is not equal!");
+			}
+
+			delete cipher;
+			delete eng;
+		}
+	}
+
 	void ParallelModeTest::CompareParallelOutput()
 	{
 		// compares sequential and parallel output
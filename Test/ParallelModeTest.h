@@ -72,12 +72,16 @@ namespace Test
 		void CompareBcrKat(IBlockCipher* Engine, std::vector<byte> Expected);
 		// Looping integrity test, compares CTR multi-threaded/SIMD with sequentially generated output
 		void CompareBcrSimd(IBlockCipher* Engine);
+		// Looping integrity test, compares a cipher specialized counter mode (CTRT or ICMT) with its interface based counterpart
+		void CompareModeT(ICipherMode* Cipher1, ICipherMode* Cipher2);
 		// Looping integrity tests, compares CBC Decrypt multi-threaded/SIMD with sequentially generated output
 		void CompareCbcDecrypt(IBlockCipher* Engine1, IBlockCipher* Engine2);
 		// Looping CBC/CFB/CTR integrity tests, compares sequential to parallel output
 		void CompareParallelLoop();
 		// Compares CBC/CFB/CTR output check, compares output across each block access method 
 		void CompareParallelOutput();
+		// Compares CTR/ICM output with NUMA chunk placement enabled to sequential output, and checks that page placement preserves the buffer
+		void CompareNumaOutput();
 		// Looping reduction Kat, compares parallel Salsa/Chacha with vectors generated in sequential mode
 		void CompareStmKat(IStreamCipher* Engine, std::vector<byte> Expected);
 		// Looping integrity test, compares Salsa/Chacha multi-threaded/SIMD with sequentially generated output
@@ -2,6 +2,7 @@
 #include "../CEX/BCR.h"
 #include "../CEX/DCR.h"
 #include "../CEX/HCR.h"
+#include "../CEX/SecureRandom.h"
 
 namespace Test
 {
@@ -47,7 +48,8 @@ namespace Test
 			MeanValue(rnd3);
 			delete rnd3;
 
-			OnProgress(std::string(".."));
+			VariateRange();
+			OnProgress(std::string("Passed SecureRandom bulk variate range and permutation tests.."));
 
 			return SUCCESS;
 		}
@@ -101,4 +103,90 @@ namespace Test
 	{
 		m_progressEvent(Data);
 	}
+
+	void PrngTest::VariateRange()
+	{
+		const size_t SMPLEN = 10000;
+		Prng::SecureRandom rnd;
+
+		// doubles in [0, 1)
+		std::vector<double> dbl(SMPLEN);
+		rnd.Fill(dbl, 0, SMPLEN);
+		double sum = 0.0;
+
+		for (size_t i = 0; i < SMPLEN; ++i)
+		{
+			if (dbl[i] < 0.0 || dbl[i] >= 1.0)
+				throw TestException("VariateRange: double output is out of range!");
+
+			sum += dbl[i];
+		}
+
+		if (sum / SMPLEN < 0.45 || sum / SMPLEN > 0.55)
+			throw TestException("VariateRange: double output mean is out of range!");
+
+		// ranged integers, with the bounds reachable and the maximum excluded
+		std::vector<ushort> smp16(SMPLEN + 1, 0xFFFF);
+		rnd.Fill(smp16, 1, SMPLEN, 17, 10);
+		bool hasMin = false;
+		bool hasMax = false;
+
+		for (size_t i = 1; i < smp16.size(); ++i)
+		{
+			if (smp16[i] < 10 || smp16[i] >= 17)
+				throw TestException("VariateRange: ushort output is out of range!");
+
+			hasMin |= (smp16[i] == 10);
+			hasMax |= (smp16[i] == 16);
+		}
+
+		if (smp16[0] != 0xFFFF || !hasMin || !hasMax)
+			throw TestException("VariateRange: ushort output range is invalid!");
+
+		std::vector<uint> smp32(SMPLEN);
+		rnd.Fill(smp32, 0, SMPLEN, 1000003, 1000);
+
+		for (size_t i = 0; i < SMPLEN; ++i)
+		{
+			if (smp32[i] < 1000 || smp32[i] >= 1000003)
+				throw TestException("VariateRange: uint output is out of range!");
+		}
+
+		std::vector<ulong> smp64(SMPLEN);
+		const ulong MAX64 = 0x0000500000000001ULL;
+		rnd.Fill(smp64, 0, SMPLEN, MAX64, 5);
+
+		for (size_t i = 0; i < SMPLEN; ++i)
+		{
+			if (smp64[i] < 5 || smp64[i] >= MAX64)
+				throw TestException("VariateRange: ulong output is out of range!");
+		}
+
+		rnd.Fill(smp64, 0, SMPLEN, 0x100000005ULL, 0x100000000ULL);
+
+		for (size_t i = 0; i < SMPLEN; ++i)
+		{
+			if (smp64[i] < 0x100000000ULL || smp64[i] >= 0x100000005ULL)
+				throw TestException("VariateRange: ulong output is out of range!");
+		}
+
+		// a permutation contains each index exactly once
+		std::vector<uint> perm(SMPLEN);
+		rnd.Permutation(perm, 0, SMPLEN);
+		std::vector<byte> seen(SMPLEN, 0);
+		size_t fixed = 0;
+
+		for (size_t i = 0; i < SMPLEN; ++i)
+		{
+			if (perm[i] >= SMPLEN || seen[perm[i]] != 0)
+				throw TestException("VariateRange: permutation is invalid!");
+
+			seen[perm[i]] = 1;
+			fixed += (perm[i] == i) ? 1 : 0;
+		}
+
+		// the expected number of fixed points is 1
+		if (fixed > 10)
+			throw TestException("VariateRange: permutation is not shuffled!");
+	}
 }
\ No newline at end of file
@@ -48,6 +48,7 @@ namespace Test
 		void ChiSquare(Prng::IPrng* Rng);
 		void MeanValue(Prng::IPrng* Rng);
 		void OnProgress(std::string Data);
+		void VariateRange();
 	};
 }
 
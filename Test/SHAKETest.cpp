@@ -0,0 +1,178 @@
+#include "SHAKETest.h"
+#include "../CEX/SHAKE.h"
+
+namespace Test
+{
+	using Enumeration::Digests;
+
+	const std::string SHAKETest::DESCRIPTION = "NIST SP 800-185 and FIPS 202 Test Vectors for SHAKE128, SHAKE256, cSHAKE128, and cSHAKE256.";
+	const std::string SHAKETest::FAILURE = "FAILURE! ";
+	const std::string SHAKETest::SUCCESS = "SUCCESS! All SHAKE tests have executed succesfully.";
+
+	SHAKETest::SHAKETest()
+		:
+		m_custom(0),
+		m_expected(0),
+		m_input(0),
+		m_progressEvent()
+	{
+	}
+
+	SHAKETest::~SHAKETest()
+	{
+	}
+
+	std::string SHAKETest::Run()
+	{
+		try
+		{
+			Initialize();
+			std::vector<byte> empty(0);
+
+			CompareVector(Digests::Keccak256, m_input[0], empty, m_expected[0]);
+			CompareVector(Digests::Keccak256, m_input[1], empty, m_expected[1]);
+			CompareVector(Digests::Keccak512, m_input[0], empty, m_expected[2]);
+			CompareVector(Digests::Keccak512, m_input[1], empty, m_expected[3]);
+			OnProgress(std::string("SHAKETest: Passed SHAKE128 and SHAKE256 known answer vector tests.."));
+
+			CompareVector(Digests::Keccak256, m_input[0], m_custom, m_expected[4]);
+			CompareVector(Digests::Keccak256, m_input[1], m_custom, m_expected[5]);
+			CompareVector(Digests::Keccak512, m_input[0], m_custom, m_expected[6]);
+			CompareVector(Digests::Keccak512, m_input[1], m_custom, m_expected[7]);
+			OnProgress(std::string("SHAKETest: Passed cSHAKE128 and cSHAKE256 known answer vector tests.."));
+
+			CompareStream(Digests::Keccak256, m_expected[8]);
+			CompareStream(Digests::Keccak512, m_expected[9]);
+			OnProgress(std::string("SHAKETest: Passed incremental output stream tests.."));
+
+			CompareParallel(Digests::Keccak256, empty);
+			CompareParallel(Digests::Keccak512, empty);
+			CompareParallel(Digests::Keccak256, m_custom);
+			CompareParallel(Digests::Keccak512, m_custom);
+			OnProgress(std::string("SHAKETest: Passed 4 lane parallel generator tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void SHAKETest::CompareParallel(Digests DigestType, std::vector<byte> &Custom)
+	{
+		const size_t LANES = 4;
+		std::vector<byte> key(m_input[1]);
+		Kdf::SHAKE gen1(DigestType, true);
+		const size_t BLKLEN = gen1.BlockSize();
+		std::vector<byte> output1(BLKLEN * LANES * 3);
+		std::vector<byte> output2(output1.size());
+
+		gen1.Initialize(key, Custom);
+		// an uneven first request exercises the buffered squeeze
+		gen1.Generate(output1, 0, 7);
+		gen1.Generate(output1, 7, output1.size() - 7);
+
+		// each lane is the sequential function of the key and the lane counter
+		key.push_back(0);
+
+		for (size_t i = 0; i < LANES; ++i)
+		{
+			Kdf::SHAKE gen2(DigestType);
+			std::vector<byte> lane(BLKLEN * 3);
+
+			key[key.size() - 1] = (byte)i;
+			gen2.Initialize(key, Custom);
+			gen2.Generate(lane);
+
+			for (size_t j = 0; j < 3; ++j)
+				std::memcpy(&output2[(j * LANES * BLKLEN) + (i * BLKLEN)], &lane[j * BLKLEN], BLKLEN);
+		}
+
+		if (output1 != output2)
+			throw TestException("SHAKETest: The parallel output is not equal to the sequential lanes!");
+	}
+
+	void SHAKETest::CompareStream(Digests DigestType, std::vector<byte> &Expected)
+	{
+		const size_t CUTS[5] = { 1, 31, 136, 168, 331 };
+		std::vector<byte> output1(1000);
+		std::vector<byte> output2(1000);
+		std::vector<byte> tail(Expected.size());
+		Kdf::SHAKE gen(DigestType);
+
+		gen.Initialize(m_input[1]);
+		gen.Generate(output1);
+		std::memcpy(&tail[0], &output1[output1.size() - tail.size()], tail.size());
+
+		if (tail != Expected)
+			throw TestException("SHAKETest: The output stream is not equal!");
+
+		// the same stream requested in uneven lengths
+		gen.Initialize(m_input[1]);
+		size_t pos = 0;
+
+		for (size_t i = 0; pos < output2.size(); ++i)
+		{
+			const size_t LEN = (std::min)(CUTS[i % 5], output2.size() - pos);
+			gen.Generate(output2, pos, LEN);
+			pos += LEN;
+		}
+
+		if (output1 != output2)
+			throw TestException("SHAKETest: The incremental output stream is not equal!");
+	}
+
+	void SHAKETest::CompareVector(Digests DigestType, std::vector<byte> &Input, std::vector<byte> &Custom, std::vector<byte> &Expected)
+	{
+		std::vector<byte> output(Expected.size());
+		Kdf::SHAKE gen(DigestType);
+
+		gen.Initialize(Input, Custom);
+		gen.Generate(output);
+
+		if (output != Expected)
+			throw TestException("SHAKETest: Output is not equal!");
+	}
+
+	void SHAKETest::Initialize()
+	{
+		m_input.resize(2);
+		m_input[0].resize(4);
+		for (size_t i = 0; i < m_input[0].size(); ++i)
+			m_input[0][i] = (byte)i;
+		m_input[1].resize(200);
+		for (size_t i = 0; i < m_input[1].size(); ++i)
+			m_input[1][i] = (byte)i;
+
+		const std::string custom = "Email Signature";
+		m_custom.assign(custom.begin(), custom.end());
+
+		const char* expectedEnc[10] =
+		{
+			// SHAKE128, SHAKE256
+			("0B0CC28E60E37698B411234B1158A5D42636440432A28E8B8DF5BE04208878F9"),
+			("0C4234CA1E31801AE606F8B8D8E0665C66F42A21D601C2681858A92C79AD5D69"),
+			("48B8D57A5F8C29D0326049216380AA85D2D7A58B784F5A49E980CA93409E3D4BAC25509371F937EF3224820EDA0AF0915C10D07E2DF78BAFE7208D23F36388A9"),
+			("4EE1CA03272B05D3BFB1E1C79A967F823B9FC5E4BB3987B1BA9E9CB5AFB07A5EE3A07FBD457A94364964A841E7F466E5A022E21AB7F673C18BA98CDB1D5AECFA"),
+			// cSHAKE128, cSHAKE256; SP 800-185 samples 1 to 4
+			("C1C36925B6409A04F1B504FCBCA9D82B4017277CB5ED2B2065FC1D3814D5AAF5"),
+			("C5221D50E4F822D96A2E8881A961420F294B7B24FE3D2094BAED2C6524CC166B"),
+			("D008828E2B80AC9D2218FFEE1D070C48B8E4C87BFF32C9699D5B6896EEE0EDD164020E2BE0560858D9C00C037E34A96937C561A74C412BB4C746469527281C8C"),
+			("07DC27B11E51FBAC75BC7B3C1D983E8B4B85FB1DEFAF218912AC86430273091727F42B17ED1DF63E8EC118F04B23633C1DFB1574C8FB55CB45DA8E25AFB092BB"),
+			// the last 32 bytes of a 1000 byte SHAKE128 and SHAKE256 output stream
+			("41BEDED8EC83DF44E69F3F5462D818058DB6CA17DF9BD00747B84E92E68BC165"),
+			("3602CF96361FCC19E7D18E144ACC3F98FF0816C8096DC480B33E2D1F5D84774A")
+		};
+		HexConverter::Decode(expectedEnc, 10, m_expected);
+	}
+
+	void SHAKETest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef _CEXTEST_SHAKETEST_H
+#define _CEXTEST_SHAKETEST_H
+
+#include "ITest.h"
+#include "../CEX/Digests.h"
+
+namespace Test
+{
+	/// <summary>
+	/// SHAKE and cSHAKE implementation vector comparison tests.
+	/// <para>Using the cSHAKE128 and cSHAKE256 samples from NIST SP 800-185:
+	/// <see href="https://csrc.nist.gov/CSRC/media/Projects/Cryptographic-Standards-and-Guidelines/documents/examples/cSHAKE_samples.pdf"/>,
+	/// and SHAKE128 and SHAKE256 vectors generated with the Keccak code package.</para>
+	/// </summary>
+	class SHAKETest : public ITest
+	{
+	private:
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<byte> m_custom;
+		std::vector<std::vector<byte>> m_expected;
+		std::vector<std::vector<byte>> m_input;
+		TestEventHandler m_progressEvent;
+
+	public:
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		virtual const std::string Description() { return DESCRIPTION; }
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		virtual TestEventHandler &Progress() { return m_progressEvent; }
+
+		/// <summary>
+		/// Compares known answer SHAKE and cSHAKE vectors for equality
+		/// </summary>
+		SHAKETest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~SHAKETest();
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		virtual std::string Run();
+
+	private:
+		void CompareParallel(Enumeration::Digests DigestType, std::vector<byte> &Custom);
+		void CompareStream(Enumeration::Digests DigestType, std::vector<byte> &Expected);
+		void CompareVector(Enumeration::Digests DigestType, std::vector<byte> &Input, std::vector<byte> &Custom, std::vector<byte> &Expected);
+		void Initialize();
+		void OnProgress(std::string Data);
+	};
+}
+
+#endif
@@ -0,0 +1,203 @@
+#include "SecureArenaTest.h"
+#include "../CEX/IntUtils.h"
+#include "../CEX/RHX.h"
+#include "../CEX/SecureAllocator.h"
+#include "../CEX/SHX.h"
+#include "../CEX/SymmetricKey.h"
+#include "../CEX/THX.h"
+
+namespace Test
+{
+	using Enumeration::Digests;
+	using Cipher::Symmetric::Block::RHX;
+	using Utility::SecureArena;
+	using Utility::SecureVector;
+	using Cipher::Symmetric::Block::SHX;
+	using Key::Symmetric::SymmetricKey;
+	using Cipher::Symmetric::Block::THX;
+
+	const std::string SecureArenaTest::DESCRIPTION = "SecureArena test; checks block reuse, zeroization, the heap fallback, and the ciphers that store round keys in the arena.";
+	const std::string SecureArenaTest::FAILURE = "FAILURE! ";
+	const std::string SecureArenaTest::SUCCESS = "SUCCESS! All SecureArena tests have executed succesfully.";
+
+	SecureArenaTest::SecureArenaTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	SecureArenaTest::~SecureArenaTest()
+	{
+	}
+
+	std::string SecureArenaTest::Run()
+	{
+		try
+		{
+			CheckReuse();
+			OnProgress(std::string("SecureArenaTest: Passed block reuse and zeroization tests.."));
+			CheckFallback();
+			OnProgress(std::string("SecureArenaTest: Passed oversized block heap fallback tests.."));
+			CheckVector();
+			OnProgress(std::string("SecureArenaTest: Passed SecureVector allocation and copy tests.."));
+			CheckCipher();
+			OnProgress(std::string("SecureArenaTest: Passed RHX, SHX, and THX arena round key tests.."));
+
+			if (SecureArena::Instance().IsLocked())
+				OnProgress(std::string("SecureArenaTest: The arena is locked in physical memory.."));
+			else
+				OnProgress(std::string("SecureArenaTest: The operating system refused to lock the arena; the memory lock limit may be too small.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void SecureArenaTest::CheckCipher()
+	{
+		std::vector<byte> key(32);
+		std::vector<byte> msg(16);
+		std::vector<byte> enc(16);
+		std::vector<byte> dec(16);
+		std::vector<byte> exp;
+
+		for (size_t i = 0; i < key.size(); ++i)
+			key[i] = static_cast<byte>(i);
+		for (size_t i = 0; i < msg.size(); ++i)
+			msg[i] = static_cast<byte>((i << 4) | i);
+
+		// FIPS 197 C.3
+		HexConverter::Decode("8EA2B7CA516745BFEAFC49904B496089", exp);
+
+		SymmetricKey kp(key);
+		RHX rhx;
+		rhx.Initialize(true, kp);
+		rhx.EncryptBlock(msg, enc);
+
+		if (enc != exp)
+			throw TestException("CheckCipher: The RHX cipher text does not match the known answer!");
+
+		rhx.Initialize(false, kp);
+		rhx.DecryptBlock(enc, dec);
+
+		if (dec != msg)
+			throw TestException("CheckCipher: The RHX decryption is not equal to the message!");
+
+		// standard and extended key schedules
+		const Digests KDFS[2] = { Digests::None, Digests::SHA256 };
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			SHX shx(KDFS[i]);
+			shx.Initialize(true, kp);
+			shx.EncryptBlock(msg, enc);
+			shx.Initialize(false, kp);
+			shx.DecryptBlock(enc, dec);
+
+			if (dec != msg || enc == msg)
+				throw TestException("CheckCipher: The SHX decryption is not equal to the message!");
+
+			THX thx(KDFS[i]);
+			thx.Initialize(true, kp);
+			thx.EncryptBlock(msg, enc);
+			thx.Initialize(false, kp);
+			thx.DecryptBlock(enc, dec);
+
+			if (dec != msg || enc == msg)
+				throw TestException("CheckCipher: The THX decryption is not equal to the message!");
+		}
+	}
+
+	void SecureArenaTest::CheckFallback()
+	{
+		SecureArena &arena = SecureArena::Instance();
+		const size_t RSVLEN = arena.Reserved();
+		// larger than the largest size class
+		const size_t BLKLEN = 16 * 1024;
+
+		byte* blk = static_cast<byte*>(arena.Allocate(BLKLEN));
+
+		for (size_t i = 0; i < BLKLEN; ++i)
+			blk[i] = static_cast<byte>(i);
+
+		if (arena.Reserved() != RSVLEN)
+			throw TestException("CheckFallback: An oversized block was carved from the arena!");
+
+		arena.Deallocate(blk, BLKLEN);
+	}
+
+	void SecureArenaTest::CheckReuse()
+	{
+		SecureArena &arena = SecureArena::Instance();
+		const size_t BLKLEN = 48;
+
+		byte* blk1 = static_cast<byte*>(arena.Allocate(BLKLEN));
+
+		if (reinterpret_cast<size_t>(blk1) % 16 != 0)
+			throw TestException("CheckReuse: The block is not 16 byte aligned!");
+
+		for (size_t i = 0; i < BLKLEN; ++i)
+			blk1[i] = 0xFF;
+
+		arena.Deallocate(blk1, BLKLEN);
+
+		// the released block is zeroed beyond the free list link
+		for (size_t i = sizeof(void*); i < BLKLEN; ++i)
+		{
+			if (blk1[i] != 0)
+				throw TestException("CheckReuse: The released block was not zeroed!");
+		}
+
+		// the next request in the same size class takes the released block
+		byte* blk2 = static_cast<byte*>(arena.Allocate(BLKLEN + 8));
+
+		if (blk2 != blk1)
+			throw TestException("CheckReuse: The released block was not reused!");
+
+		for (size_t i = 0; i < BLKLEN + 8; ++i)
+		{
+			if (blk2[i] != 0)
+				throw TestException("CheckReuse: The reused block is not empty!");
+		}
+
+		arena.Deallocate(blk2, BLKLEN + 8);
+	}
+
+	void SecureArenaTest::CheckVector()
+	{
+		SecureVector<uint> vec1(60);
+
+		for (size_t i = 0; i < vec1.size(); ++i)
+			vec1[i] = static_cast<uint>(i * 0x01010101UL);
+
+		SecureVector<uint> vec2 = vec1;
+
+		if (vec2 != vec1)
+			throw TestException("CheckVector: The vector copy is not equal!");
+
+		vec2.resize(1000);
+
+		for (size_t i = 0; i < vec1.size(); ++i)
+		{
+			if (vec2[i] != vec1[i])
+				throw TestException("CheckVector: The vector was not preserved by the resize!");
+		}
+
+		Utility::IntUtils::ClearVector(vec2);
+
+		if (vec2.size() != 0)
+			throw TestException("CheckVector: The vector was not cleared!");
+	}
+
+	void SecureArenaTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
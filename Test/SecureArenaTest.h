@@ -0,0 +1,56 @@
+#ifndef _CEXTEST_SECUREARENATEST_H
+#define _CEXTEST_SECUREARENATEST_H
+
+#include "ITest.h"
+
+namespace Test
+{
+	/// <summary>
+	/// Tests the SecureArena block reuse and zeroization, and the SecureAllocator vector type.
+	/// <para>Also compares the output of the block ciphers that store their round keys in the arena with the ciphers KAT vectors.</para>
+	/// </summary>
+	class SecureArenaTest : public ITest
+	{
+	private:
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		TestEventHandler m_progressEvent;
+
+	public:
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		virtual const std::string Description() { return DESCRIPTION; }
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		virtual TestEventHandler &Progress() { return m_progressEvent; }
+
+		/// <summary>
+		/// Initialize this class
+		/// </summary>
+		SecureArenaTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~SecureArenaTest();
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		virtual std::string Run();
+
+	private:
+		void CheckCipher();
+		void CheckFallback();
+		void CheckReuse();
+		void CheckVector();
+		void OnProgress(std::string Data);
+	};
+}
+
+#endif
@@ -0,0 +1,324 @@
+#include "SegmentTest.h"
+#include "../CEX/Blake3.h"
+#include "../CEX/Blake512.h"
+#include "../CEX/CBC.h"
+#include "../CEX/CMAC.h"
+#include "../CEX/CTR.h"
+#include "../CEX/EAX.h"
+#include "../CEX/GCM.h"
+#include "../CEX/HMAC.h"
+#include "../CEX/K12.h"
+#include "../CEX/Keccak512.h"
+#include "../CEX/OCB.h"
+#include "../CEX/SHA256.h"
+#include "../CEX/SymmetricKey.h"
+
+namespace Test
+{
+	using Digest::Blake3;
+	using Digest::Blake512;
+	using Cipher::Symmetric::Block::Mode::CBC;
+	using Mac::CMAC;
+	using Cipher::Symmetric::Block::Mode::CTR;
+	using Cipher::Symmetric::Block::Mode::EAX;
+	using Cipher::Symmetric::Block::Mode::GCM;
+	using Mac::HMAC;
+	using Digest::K12;
+	using Digest::Keccak512;
+	using Common::MemorySegment;
+	using Common::MutableSegment;
+	using Cipher::Symmetric::Block::Mode::OCB;
+	using Digest::SHA256;
+	using Enumeration::BlockCiphers;
+	using Enumeration::Digests;
+	using Key::Symmetric::SymmetricKey;
+
+	const std::string SegmentTest::DESCRIPTION = "Scatter-gather test; compares fragmented messages with contiguous messages in the cipher modes, digests, and Macs.";
+	const std::string SegmentTest::FAILURE = "FAILURE! ";
+	const std::string SegmentTest::SUCCESS = "SUCCESS! All scatter-gather tests have executed succesfully.";
+
+	SegmentTest::SegmentTest()
+		:
+		m_progressEvent()
+	{
+	}
+
+	SegmentTest::~SegmentTest()
+	{
+	}
+
+	std::string SegmentTest::Run()
+	{
+		try
+		{
+			// parallel and sequential transforms
+			CTR* ctr = new CTR(BlockCiphers::Rijndael);
+			ctr->ParallelProfile().IsParallel() = true;
+			CompareMode(ctr, true);
+			ctr->ParallelProfile().IsParallel() = false;
+			CompareMode(ctr, true);
+			delete ctr;
+			CBC* cbc = new CBC(BlockCiphers::Rijndael);
+			CompareMode(cbc, true);
+			cbc->ParallelProfile().IsParallel() = true;
+			CompareMode(cbc, false);
+			cbc->ParallelProfile().IsParallel() = false;
+			CompareMode(cbc, false);
+			delete cbc;
+			OnProgress(std::string("SegmentTest: Passed CTR and CBC segmented transform tests.."));
+
+			GCM* gcm = new GCM(BlockCiphers::Rijndael);
+			CompareAead(gcm);
+			delete gcm;
+			EAX* eax = new EAX(BlockCiphers::Rijndael);
+			CompareAead(eax);
+			delete eax;
+			OCB* ocb = new OCB(BlockCiphers::Rijndael);
+			CompareAead(ocb);
+			delete ocb;
+			OnProgress(std::string("SegmentTest: Passed GCM, EAX, and OCB segmented transform tests.."));
+
+			SHA256* sha = new SHA256(false);
+			CompareDigest(sha);
+			delete sha;
+			sha = new SHA256(true);
+			CompareDigest(sha);
+			delete sha;
+			Blake512* blk = new Blake512(true);
+			CompareDigest(blk);
+			delete blk;
+			Keccak512* kcc = new Keccak512(false);
+			CompareDigest(kcc);
+			delete kcc;
+			Blake3* bl3 = new Blake3(true);
+			CompareDigest(bl3);
+			delete bl3;
+			K12* k12 = new K12(true);
+			CompareDigest(k12);
+			delete k12;
+			OnProgress(std::string("SegmentTest: Passed SHA256, Blake512, Keccak512, Blake3, and K12 segmented update tests.."));
+
+			HMAC* hmac = new HMAC(Digests::SHA256);
+			CompareMac(hmac);
+			delete hmac;
+			CMAC* cmac = new CMAC(BlockCiphers::Rijndael);
+			CompareMac(cmac);
+			delete cmac;
+			OnProgress(std::string("SegmentTest: Passed HMAC and CMAC segmented update tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(std::string(FAILURE + std::string(" : Unknown Error")));
+		}
+	}
+
+	void SegmentTest::CompareAead(IAeadMode* Cipher)
+	{
+		const size_t PRLLEN = Cipher->ParallelBlockSize();
+		const size_t MSGLEN = (3 * PRLLEN) + 1237;
+		// input and output lists are fragmented differently, and include empty fragments
+		const std::vector<size_t> INSZE = { 5, 0, 16, 100, PRLLEN + 3, 17, 4096, 1, PRLLEN };
+		const std::vector<size_t> OUTSZE = { 33, PRLLEN - 13, 7, 0, 1024, 2 * PRLLEN };
+		std::vector<byte> aad(61);
+		std::vector<byte> key(32);
+		std::vector<byte> msg(MSGLEN);
+		std::vector<byte> nonce(16);
+		std::vector<byte> enc1(MSGLEN + 16);
+		std::vector<byte> enc2(MSGLEN + 16);
+		std::vector<byte> dec(MSGLEN + 16);
+		std::vector<MemorySegment> aadSeg;
+		std::vector<MemorySegment> inSeg;
+		std::vector<MutableSegment> outSeg;
+
+		for (size_t i = 0; i < aad.size(); ++i)
+			aad[i] = static_cast<byte>(i * 5);
+		for (size_t i = 0; i < key.size(); ++i)
+			key[i] = static_cast<byte>(i);
+		for (size_t i = 0; i < msg.size(); ++i)
+			msg[i] = static_cast<byte>(i * 3);
+		for (size_t i = 0; i < nonce.size(); ++i)
+			nonce[i] = static_cast<byte>(i + 7);
+
+		// the OCB nonce is limited to 15 bytes
+		nonce.resize(Cipher->Enumeral() == Enumeration::CipherModes::OCB ? 12 : 16);
+		SymmetricKey kp(key, nonce);
+
+		Cipher->Initialize(true, kp);
+		Cipher->SetAssociatedData(aad, 0, aad.size());
+		Transform(Cipher, msg, enc1, MSGLEN);
+		Cipher->Finalize(enc1, MSGLEN, 16);
+
+		Cipher->Initialize(true, kp);
+		Fragment(aad, aad.size(), { 3, 0, 40, 18 }, aadSeg);
+		Cipher->SetAssociatedSegments(aadSeg);
+		Fragment(msg, MSGLEN, INSZE, inSeg);
+		Fragment(enc2, MSGLEN, OUTSZE, outSeg);
+		Cipher->TransformSegments(inSeg, outSeg);
+		Cipher->Finalize(enc2, MSGLEN, 16);
+
+		if (enc1 != enc2)
+			throw TestException("CompareAead: The segmented output is not equal to the contiguous output!");
+
+		// the decryption lists are fragmented in reverse
+		Cipher->Initialize(false, kp);
+		Cipher->SetAssociatedSegments(aadSeg);
+		Fragment(enc2, MSGLEN, OUTSZE, inSeg);
+		Fragment(dec, MSGLEN, INSZE, outSeg);
+		Cipher->TransformSegments(inSeg, outSeg);
+
+		if (!Cipher->Verify(enc2, MSGLEN, 16))
+			throw TestException("CompareAead: The segmented message failed authentication!");
+
+		dec.resize(MSGLEN);
+
+		if (dec != msg)
+			throw TestException("CompareAead: The segmented decryption is not equal to the message!");
+	}
+
+	void SegmentTest::CompareDigest(IDigest* Digest)
+	{
+		const size_t MSGLEN = (2 * Digest->ParallelBlockSize()) + 999;
+		std::vector<byte> msg(MSGLEN);
+		std::vector<byte> hash1(Digest->DigestSize());
+		std::vector<byte> hash2(Digest->DigestSize());
+		std::vector<MemorySegment> inSeg;
+
+		for (size_t i = 0; i < msg.size(); ++i)
+			msg[i] = static_cast<byte>(i * 7);
+
+		Digest->Compute(msg, hash1);
+		Digest->Reset();
+		Fragment(msg, MSGLEN, { 1, 63, 0, 65, Digest->ParallelBlockSize() + 1, 200 }, inSeg);
+		Digest->UpdateSegments(inSeg);
+		Digest->Finalize(hash2, 0);
+
+		if (hash1 != hash2)
+			throw TestException("CompareDigest: The segmented hash is not equal to the contiguous hash!");
+
+		// short fragments only, so every parallel block is gathered across fragment boundaries
+		Fragment(msg, MSGLEN, { 7, 1, 250 }, inSeg);
+		Digest->UpdateSegments(inSeg);
+		Digest->Finalize(hash2, 0);
+
+		if (hash1 != hash2)
+			throw TestException("CompareDigest: The staged segmented hash is not equal to the contiguous hash!");
+	}
+
+	void SegmentTest::CompareMac(IMac* Generator)
+	{
+		const size_t MSGLEN = 10000;
+		std::vector<byte> key(32);
+		std::vector<byte> msg(MSGLEN);
+		std::vector<byte> code1(Generator->MacSize());
+		std::vector<byte> code2(Generator->MacSize());
+		std::vector<MemorySegment> inSeg;
+
+		for (size_t i = 0; i < key.size(); ++i)
+			key[i] = static_cast<byte>(i);
+		for (size_t i = 0; i < msg.size(); ++i)
+			msg[i] = static_cast<byte>(i * 11);
+
+		SymmetricKey kp(key);
+		Generator->Initialize(kp);
+		Generator->Compute(msg, code1);
+		Generator->Initialize(kp);
+		Fragment(msg, MSGLEN, { 15, 1, 0, 16, 33, 1000 }, inSeg);
+		Generator->UpdateSegments(inSeg);
+		Generator->Finalize(code2, 0);
+
+		if (code1 != code2)
+			throw TestException("CompareMac: The segmented code is not equal to the contiguous code!");
+	}
+
+	void SegmentTest::CompareMode(ICipherMode* Cipher, bool Encryption)
+	{
+		const size_t PRLLEN = Cipher->ParallelBlockSize();
+		// block aligned, so that the message is valid for the padded modes
+		const size_t MSGLEN = (3 * PRLLEN) + 1248;
+		std::vector<byte> key(32);
+		std::vector<byte> iv(16);
+		std::vector<byte> msg(MSGLEN);
+		std::vector<byte> out1(MSGLEN);
+		std::vector<byte> out2(MSGLEN);
+		std::vector<MemorySegment> inSeg;
+		std::vector<MutableSegment> outSeg;
+
+		for (size_t i = 0; i < key.size(); ++i)
+			key[i] = static_cast<byte>(i);
+		for (size_t i = 0; i < iv.size(); ++i)
+			iv[i] = static_cast<byte>(i * 9);
+		for (size_t i = 0; i < msg.size(); ++i)
+			msg[i] = static_cast<byte>(i * 13);
+
+		SymmetricKey kp(key, iv);
+		Cipher->Initialize(Encryption, kp);
+		Transform(Cipher, msg, out1, MSGLEN);
+
+		Cipher->Initialize(Encryption, kp);
+		Fragment(msg, MSGLEN, { 3, 29, 0, PRLLEN + 7, 16, 1, 2 * PRLLEN }, inSeg);
+		Fragment(out2, MSGLEN, { PRLLEN - 8, 0, 40, 5, 2048 }, outSeg);
+		Cipher->TransformSegments(inSeg, outSeg);
+
+		if (out1 != out2)
+			throw TestException("CompareMode: The segmented output is not equal to the contiguous output!");
+	}
+
+	void SegmentTest::Fragment(const std::vector<byte> &Input, size_t Length, const std::vector<size_t> &Sizes, std::vector<MemorySegment> &Segments)
+	{
+		size_t pos = 0;
+
+		Segments.clear();
+
+		// cycle through the fragment sizes until the length is consumed
+		for (size_t i = 0; pos != Length; ++i)
+		{
+			const size_t SEGLEN = Utility::IntUtils::Min(Sizes[i % Sizes.size()], Length - pos);
+			Segments.push_back(MemorySegment(Input, pos, SEGLEN));
+			pos += SEGLEN;
+		}
+	}
+
+	void SegmentTest::Fragment(std::vector<byte> &Output, size_t Length, const std::vector<size_t> &Sizes, std::vector<MutableSegment> &Segments)
+	{
+		size_t pos = 0;
+
+		Segments.clear();
+
+		for (size_t i = 0; pos != Length; ++i)
+		{
+			const size_t SEGLEN = Utility::IntUtils::Min(Sizes[i % Sizes.size()], Length - pos);
+			Segments.push_back(MutableSegment(Output, pos, SEGLEN));
+			pos += SEGLEN;
+		}
+	}
+
+	void SegmentTest::Transform(ICipherMode* Cipher, const std::vector<byte> &Input, std::vector<byte> &Output, size_t Length)
+	{
+		const size_t PRLLEN = Cipher->ParallelBlockSize();
+		size_t pos = 0;
+
+		// the contiguous message is passed in parallel block sized steps, as CipherStream does
+		if (Cipher->IsParallel())
+		{
+			while (Length - pos >= PRLLEN)
+			{
+				Cipher->Transform(Input, pos, Output, pos, PRLLEN);
+				pos += PRLLEN;
+			}
+		}
+
+		if (pos != Length)
+			Cipher->Transform(Input, pos, Output, pos, Length - pos);
+	}
+
+	void SegmentTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
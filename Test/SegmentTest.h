@@ -0,0 +1,67 @@
+#ifndef _CEXTEST_SEGMENTTEST_H
+#define _CEXTEST_SEGMENTTEST_H
+
+#include "ITest.h"
+#include "../CEX/IAeadMode.h"
+#include "../CEX/IDigest.h"
+#include "../CEX/IMac.h"
+
+namespace Test
+{
+	using Cipher::Symmetric::Block::Mode::IAeadMode;
+	using Cipher::Symmetric::Block::Mode::ICipherMode;
+	using Digest::IDigest;
+	using Mac::IMac;
+
+	/// <summary>
+	/// Tests the scatter-gather segment functions of the cipher modes, AEAD modes, digests, and Macs.
+	/// <para>A message split into fragments of varied size must produce the same output as the contiguous message.</para>
+	/// </summary>
+	class SegmentTest : public ITest
+	{
+	private:
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		TestEventHandler m_progressEvent;
+
+	public:
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		virtual const std::string Description() { return DESCRIPTION; }
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		virtual TestEventHandler &Progress() { return m_progressEvent; }
+
+		/// <summary>
+		/// Initialize this class
+		/// </summary>
+		SegmentTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~SegmentTest();
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		virtual std::string Run();
+
+	private:
+		void CompareAead(IAeadMode* Cipher);
+		void CompareDigest(IDigest* Digest);
+		void CompareMac(IMac* Generator);
+		void CompareMode(ICipherMode* Cipher, bool Encryption);
+		static void Fragment(const std::vector<byte> &Input, size_t Length, const std::vector<size_t> &Sizes, std::vector<Common::MemorySegment> &Segments);
+		static void Fragment(std::vector<byte> &Output, size_t Length, const std::vector<size_t> &Sizes, std::vector<Common::MutableSegment> &Segments);
+		void OnProgress(std::string Data);
+		static void Transform(ICipherMode* Cipher, const std::vector<byte> &Input, std::vector<byte> &Output, size_t Length);
+	};
+}
+
+#endif
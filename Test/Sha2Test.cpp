@@ -48,6 +48,38 @@ namespace Test
 			delete sha512;
 			OnProgress(std::string("Sha2Test: Passed SHA-2 512 bit digest vector tests.."));
 
+			SHA256 sha256s1;
+			SHA256 sha256s2;
+			if (!TestUtils::CompareState(&sha256s1, &sha256s2))
+				throw TestException("SHA2Test: The resumed digest state hash is not equal!");
+			SHA512 sha512p1(true);
+			SHA512 sha512p2(true);
+			if (!TestUtils::CompareState(&sha512p1, &sha512p2))
+				throw TestException("SHA2Test: The resumed digest state hash is not equal!");
+			SHA2Params sp256(32, 64, 8);
+			sp256.DistributionCode()[0] = 1;
+			SHA256 sha256p1(true);
+			SHA256 sha256p2(sp256);
+			if (!TestUtils::IsStateRejected(&sha256p1, &sha256p2))
+				throw TestException("SHA2Test: A state with mismatched tree parameters was accepted!");
+			OnProgress(std::string("Sha2Test: Passed SHA-2 state serialization tests.."));
+
+			LongVectorTest();
+			OnProgress(std::string("Sha2Test: Passed SHA-2 long message vector tests.."));
+			SHA512 sha512s3;
+			CompareUpdate(&sha512s3);
+			SHA512 sha512p3(true);
+			// run the tree on 8 leaves even on a single core, so the leaf loops are exercised
+			sha512p3.ParallelProfile().IsParallel() = true;
+			sha512p3.ParallelMaxDegree(8);
+			CompareUpdate(&sha512p3);
+			SHA256 sha256s3;
+			CompareUpdate(&sha256s3);
+			OnProgress(std::string("Sha2Test: Passed SHA-2 block pair and single block equivalence tests.."));
+
+			ParallelVectorTest();
+			OnProgress(std::string("Sha2Test: Passed SHA-2 512 bit tree hashing vector tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -60,6 +92,33 @@ namespace Test
 		}
 	}
 
+	void SHA2Test::CompareUpdate(IDigest* Digest)
+	{
+		// a message absorbed in one call is compressed in block pairs, and one absorbed in short updates is compressed one block at a time
+		const size_t MSGLEN = (Digest->ParallelProfile().ParallelMinimumSize() * 8) + 13;
+		const size_t STEPS[5] = { 1, Digest->BlockSize() - 1, Digest->BlockSize(), Digest->BlockSize() + 1, 3 * Digest->BlockSize() / 2 };
+		std::vector<byte> input(MSGLEN);
+		std::vector<byte> hash1(Digest->DigestSize());
+		std::vector<byte> hash2(Digest->DigestSize());
+
+		for (size_t i = 0; i < input.size(); ++i)
+			input[i] = (byte)((i * 7) + (i >> 8));
+
+		Digest->Compute(input, hash1);
+
+		for (size_t i = 0, j = 0; i < MSGLEN; ++j)
+		{
+			const size_t PRCLEN = (STEPS[j % 5] < MSGLEN - i) ? STEPS[j % 5] : MSGLEN - i;
+			Digest->Update(input, i, PRCLEN);
+			i += PRCLEN;
+		}
+
+		Digest->Finalize(hash2, 0);
+
+		if (hash1 != hash2)
+			throw TestException("SHA2Test: The block pair and single block outputs are not equal!");
+	}
+
 	void SHA2Test::CompareVector(IDigest *Digest, std::vector<byte> &Input, std::vector<byte> &Expected)
 	{
 		std::vector<byte> hash(Digest->DigestSize(), 0);
@@ -105,11 +164,58 @@ namespace Test
 		HexConverter::Decode(exp512Encoded, 4, m_expected512);
 	}
 
+	void SHA2Test::LongVectorTest()
+	{
+		// one million repetitions of 'a'; the NIST long message vector
+		std::vector<byte> input(1000000, 0x61);
+		std::vector<byte> expected256;
+		std::vector<byte> expected512;
+		HexConverter::Decode("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", expected256);
+		HexConverter::Decode("e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973ebde0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b", expected512);
+
+		// on SHA-NI capable systems, this checks that the byte counter is advanced by the intrinsics compression
+		SHA256 sha256;
+		CompareVector(&sha256, input, expected256);
+		SHA512 sha512;
+		CompareVector(&sha512, input, expected512);
+	}
+
 	void SHA2Test::OnProgress(std::string Data)
 	{
 		m_progressEvent(Data);
 	}
 
+	void SHA2Test::ParallelVectorTest()
+	{
+		// the tree output with 8 leaves; each leaf absorbs its serialized tree parameters, zero padded to one block,
+		// and every 8th message block. The expected values are regression values, the library output after the padding fix.
+		const size_t MSGLEN[4] = { 0, 3000, 8192, 9000 };
+		const char* expEncoded[4] =
+		{
+			("b3e5bfb7b5f90c7d3703caec9ee8359808eab97babc5f1b628637be38bebda2d6765a2e86b5afebb3986fe464597bb9ad4f49ea5596897ce553d35c17e5b828a"),
+			("a6a866f974ccace930c085f889de33ed5cb8865531a519d71b3645968625b459ced3ca3673680d8f7060d15980edb8eaff4bec87d9ecc6c7b77a8f9553a10422"),
+			("12714df475b14733b03d7976f9c8cffa0a297ac362e508c0523529382559f6e5412c612086d44c3faac856c3cd8e0fa4566bcaf13b0ec133639053f1016b9b0e"),
+			("189b5e30a0031e62baa76da2311a420126e9a77d93c208ba5305a9296e86c4ecc45f982b6c0d8c6471749ce61354af584b95c419069f1c8b6ba118517eb4e6a7")
+		};
+		std::vector<std::vector<byte>> expected;
+		HexConverter::Decode(expEncoded, 4, expected);
+
+		SHA512 sha512(true);
+		// the leaf count follows the processor count by default; fix it so the output does not depend on the system
+		sha512.ParallelProfile().IsParallel() = true;
+		sha512.ParallelMaxDegree(8);
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			std::vector<byte> input(MSGLEN[i]);
+
+			for (size_t j = 0; j < input.size(); ++j)
+				input[j] = (byte)j;
+
+			CompareVector(&sha512, input, expected[i]);
+		}
+	}
+
 	void SHA2Test::TreeParamsTest()
 	{
 		std::vector<byte> code1(8, 7);
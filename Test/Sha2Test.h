@@ -50,9 +50,12 @@ namespace Test
 		virtual std::string Run();
         
     private:
+		void CompareUpdate(Digest::IDigest* Digest);
 		void CompareVector(Digest::IDigest *Digest, std::vector<byte> &Input, std::vector<byte> &Expected);
 		void Initialize();
+		void LongVectorTest();
 		void OnProgress(std::string Data);
+		void ParallelVectorTest();
 		void TreeParamsTest();
     };
 }
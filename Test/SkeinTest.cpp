@@ -2,7 +2,9 @@
 #include "../CEX/Skein256.h"
 #include "../CEX/Skein512.h"
 #include "../CEX/Skein1024.h"
+#include "../CEX/SkeinMac.h"
 #include "../CEX/SecureRandom.h"
+#include "../CEX/SymmetricKey.h"
 
 namespace Test
 {
@@ -44,6 +46,7 @@ namespace Test
 			CompareVector(sk256, m_message256[0], m_expected256[0]);
 			CompareVector(sk256, m_message256[1], m_expected256[1]);
 			CompareVector(sk256, m_message256[2], m_expected256[2]);
+			CompareVector(sk256, m_message256[3], m_expected256[3]);
 			OnProgress(std::string("Passed Skein 256 bit digest vector tests.."));
 			delete sk256;
 
@@ -51,6 +54,7 @@ namespace Test
 			CompareVector(sk512, m_message512[0], m_expected512[0]);
 			CompareVector(sk512, m_message512[1], m_expected512[1]);
 			CompareVector(sk512, m_message512[2], m_expected512[2]);
+			CompareVector(sk512, m_message512[3], m_expected512[3]);
 			delete sk512;
 			OnProgress(std::string("Passed Skein 512 bit digest vector tests.."));
 
@@ -58,9 +62,13 @@ namespace Test
 			CompareVector(sk1024, m_message1024[0], m_expected1024[0]);
 			CompareVector(sk1024, m_message1024[1], m_expected1024[1]);
 			CompareVector(sk1024, m_message1024[2], m_expected1024[2]);
+			CompareVector(sk1024, m_message1024[3], m_expected1024[3]);
 			delete sk1024;
 			OnProgress(std::string("Passed Skein 1024 bit digest vector tests.."));
 
+			MacTest();
+			OnProgress(std::string("Passed Skein-MAC vector tests.."));
+
 			Skein256* sks2 = new Skein256(true);
 			SkeinParams sp1(32, 32, 8);
 			Skein256* sks3 = new Skein256(sp1);
@@ -85,6 +93,22 @@ namespace Test
 			delete skl3;
 			OnProgress(std::string("Passed Skein 1024 parallelization tests.."));
 
+			Skein512 skn1;
+			Skein512 skn2;
+			if (!TestUtils::CompareState(&skn1, &skn2))
+				throw TestException("SkeinTest: The resumed digest state hash is not equal!");
+			Skein256 skt1(true);
+			Skein256 skt2(true);
+			if (!TestUtils::CompareState(&skt1, &skt2))
+				throw TestException("SkeinTest: The resumed digest state hash is not equal!");
+			SkeinParams sp4(32, 32, 8);
+			sp4.DistributionCode()[0] = 1;
+			Skein256 skt3(true);
+			Skein256 skt4(sp4);
+			if (!TestUtils::IsStateRejected(&skt3, &skt4))
+				throw TestException("SkeinTest: A state with mismatched tree parameters was accepted!");
+			OnProgress(std::string("Passed Skein state serialization tests.."));
+
 			return SUCCESS;
 		}
 		catch (TestException const &ex)
@@ -97,6 +121,30 @@ namespace Test
 		}
 	}
 
+	void SkeinTest::CompareMac(Enumeration::Digests DigestType, std::vector<byte> &Key, std::vector<byte> &Input, std::vector<byte> &Expected)
+	{
+		Mac::SkeinMac mac(DigestType);
+		Key::Symmetric::SymmetricKey kp(Key);
+		std::vector<byte> code(mac.MacSize());
+
+		mac.Initialize(kp);
+		mac.Compute(Input, code);
+
+		if (Expected != code)
+			throw TestException("SkeinTest: Expected Mac code is not equal!");
+
+		// the keyed chaining value is retained after finalizing; split the input at every position
+		for (size_t i = 0; i < Input.size(); ++i)
+		{
+			mac.Update(Input, 0, i);
+			mac.Update(Input, i, Input.size() - i);
+			mac.Finalize(code, 0);
+
+			if (Expected != code)
+				throw TestException("SkeinTest: Expected Mac code is not equal!");
+		}
+	}
+
 	void SkeinTest::CompareParallel(IDigest* Dgt1, IDigest* Dgt2)
 	{
 		std::vector<byte> hash1(Dgt1->DigestSize(), 0);
@@ -155,57 +203,74 @@ namespace Test
 		Digest->Compute(Input, hash);
 		if (Expected != hash)
 			throw TestException("SKein Vector: Expected hash is not equal!");
+
+		// split the input at every position; an update that ends on a block boundary must not compress the last block early
+		for (size_t i = 0; i < Input.size(); ++i)
+		{
+			Digest->Update(Input, 0, i);
+			Digest->Update(Input, i, Input.size() - i);
+			Digest->Finalize(hash, 0);
+
+			if (Expected != hash)
+				throw TestException("SKein Vector: Expected hash is not equal!");
+		}
 	}
 
 	void SkeinTest::Initialize()
 	{
-		const char* message256Encoded[3] =
+		const char* message256Encoded[4] =
 		{
+			(""),
 			("FF"),
 			("FFFEFDFCFBFAF9F8F7F6F5F4F3F2F1F0EFEEEDECEBEAE9E8E7E6E5E4E3E2E1E0"),
 			("FFFEFDFCFBFAF9F8F7F6F5F4F3F2F1F0EFEEEDECEBEAE9E8E7E6E5E4E3E2E1E0DFDEDDDCDBDAD9D8D7D6D5D4D3D2D1D0CFCECDCCCBCAC9C8C7C6C5C4C3C2C1C0")
 		};
-		HexConverter::Decode(message256Encoded, 3, m_message256);
+		HexConverter::Decode(message256Encoded, 4, m_message256);
 
-		const char* message512Encoded[3] =
+		const char* message512Encoded[4] =
 		{
+			(""),
 			("FF"),
 			("FFFEFDFCFBFAF9F8F7F6F5F4F3F2F1F0EFEEEDECEBEAE9E8E7E6E5E4E3E2E1E0DFDEDDDCDBDAD9D8D7D6D5D4D3D2D1D0CFCECDCCCBCAC9C8C7C6C5C4C3C2C1C0"),
 			("FFFEFDFCFBFAF9F8F7F6F5F4F3F2F1F0EFEEEDECEBEAE9E8E7E6E5E4E3E2E1E0DFDEDDDCDBDAD9D8D7D6D5D4D3D2D1D0CFCECDCCCBCAC9C8C7C6C5C4C3C2C1C0BFBEBDBCBBBAB9B8B7B6B5B4B3B2B1B0AFAEADACABAAA9A8A7A6A5A4A3A2A1A09F9E9D9C9B9A999897969594939291908F8E8D8C8B8A89888786858483828180")
 		};
-		HexConverter::Decode(message512Encoded, 3, m_message512);
+		HexConverter::Decode(message512Encoded, 4, m_message512);
 
-		const char* message1024Encoded[3] =
+		const char* message1024Encoded[4] =
 		{
+			(""),
 			("FF"),
 			("FFFEFDFCFBFAF9F8F7F6F5F4F3F2F1F0EFEEEDECEBEAE9E8E7E6E5E4E3E2E1E0DFDEDDDCDBDAD9D8D7D6D5D4D3D2D1D0CFCECDCCCBCAC9C8C7C6C5C4C3C2C1C0BFBEBDBCBBBAB9B8B7B6B5B4B3B2B1B0AFAEADACABAAA9A8A7A6A5A4A3A2A1A09F9E9D9C9B9A999897969594939291908F8E8D8C8B8A89888786858483828180"),
 			("FFFEFDFCFBFAF9F8F7F6F5F4F3F2F1F0EFEEEDECEBEAE9E8E7E6E5E4E3E2E1E0DFDEDDDCDBDAD9D8D7D6D5D4D3D2D1D0CFCECDCCCBCAC9C8C7C6C5C4C3C2C1C0BFBEBDBCBBBAB9B8B7B6B5B4B3B2B1B0AFAEADACABAAA9A8A7A6A5A4A3A2A1A09F9E9D9C9B9A999897969594939291908F8E8D8C8B8A898887868584838281807F7E7D7C7B7A797877767574737271706F6E6D6C6B6A696867666564636261605F5E5D5C5B5A595857565554535251504F4E4D4C4B4A494847464544434241403F3E3D3C3B3A393837363534333231302F2E2D2C2B2A292827262524232221201F1E1D1C1B1A191817161514131211100F0E0D0C0B0A09080706050403020100")
 		};
-		HexConverter::Decode(message1024Encoded, 3, m_message1024);
+		HexConverter::Decode(message1024Encoded, 4, m_message1024);
 
-		const char* expected256Encoded[3] =
+		const char* expected256Encoded[4] =
 		{
+			("C8877087DA56E072870DAA843F176E9453115929094C3A40C463A196C29BF7BA"),
 			("0B98DCD198EA0E50A7A244C444E25C23DA30C10FC9A1F270A6637F1F34E67ED2"),
 			("8D0FA4EF777FD759DFD4044E6F6A5AC3C774AEC943DCFC07927B723B5DBF408B"),
 			("DF28E916630D0B44C4A849DC9A02F07A07CB30F732318256B15D865AC4AE162F")
 		};
-		HexConverter::Decode(expected256Encoded, 3, m_expected256);
+		HexConverter::Decode(expected256Encoded, 4, m_expected256);
 
-		const char* expected512Encoded[3] =
+		const char* expected512Encoded[4] =
 		{
+			("BC5B4C50925519C290CC634277AE3D6257212395CBA733BBAD37A4AF0FA06AF41FCA7903D06564FEA7A2D3730DBDB80C1F85562DFCC070334EA4D1D9E72CBA7A"),
 			("71B7BCE6FE6452227B9CED6014249E5BF9A9754C3AD618CCC4E0AAE16B316CC8CA698D864307ED3E80B6EF1570812AC5272DC409B5A012DF2A579102F340617A"),
 			("45863BA3BE0C4DFC27E75D358496F4AC9A736A505D9313B42B2F5EADA79FC17F63861E947AFB1D056AA199575AD3F8C9A3CC1780B5E5FA4CAE050E989876625B"),
 			("91CCA510C263C4DDD010530A33073309628631F308747E1BCBAA90E451CAB92E5188087AF4188773A332303E6667A7A210856F742139000071F48E8BA2A5ADB7")
 		};
-		HexConverter::Decode(expected512Encoded, 3, m_expected512);
+		HexConverter::Decode(expected512Encoded, 4, m_expected512);
 
-		const char* expected1024Encoded[3] =
+		const char* expected1024Encoded[4] =
 		{
+			("0FFF9563BB3279289227AC77D319B6FFF8D7E9F09DA1247B72A0A265CD6D2A62645AD547ED8193DB48CFF847C06494A03F55666D3B47EB4C20456C9373C86297D630D5578EBD34CB40991578F9F52B18003EFA35D3DA6553FF35DB91B81AB890BEC1B189B7F52CB2A783EBB7D823D725B0B4A71F6824E88F68F982EEFC6D19C6"),
 			("E62C05802EA0152407CDD8787FDA9E35703DE862A4FBC119CFF8590AFE79250BCCC8B3FAF1BD2422AB5C0D263FB2F8AFB3F796F048000381531B6F00D85161BC0FFF4BEF2486B1EBCD3773FABF50AD4AD5639AF9040E3F29C6C931301BF79832E9DA09857E831E82EF8B4691C235656515D437D2BDA33BCEC001C67FFDE15BA8"),
 			("1F3E02C46FB80A3FCD2DFBBC7C173800B40C60C2354AF551189EBF433C3D85F9FF1803E6D920493179ED7AE7FCE69C3581A5A2F82D3E0C7A295574D0CD7D217C484D2F6313D59A7718EAD07D0729C24851D7E7D2491B902D489194E6B7D369DB0AB7AA106F0EE0A39A42EFC54F18D93776080985F907574F995EC6A37153A578"),
 			("842A53C99C12B0CF80CF69491BE5E2F7515DE8733B6EA9422DFD676665B5FA42FFB3A9C48C217777950848CECDB48F640F81FB92BEF6F88F7A85C1F7CD1446C9161C0AFE8F25AE444F40D3680081C35AA43F640FD5FA3C3C030BCC06ABAC01D098BCC984EBD8322712921E00B1BA07D6D01F26907050255EF2C8E24F716C52A5")
 		};
-		HexConverter::Decode(expected1024Encoded, 3, m_expected1024);
+		HexConverter::Decode(expected1024Encoded, 4, m_expected1024);
 	}
 
 	void SkeinTest::TreeParamsTest()
@@ -229,6 +294,48 @@ namespace Test
 			throw std::string("SkeinTest: Tree parameters test failed!");
 	}
 
+	void SkeinTest::MacTest()
+	{
+		std::vector<byte> exp;
+		std::vector<byte> key(32);
+		std::vector<byte> msg(100);
+
+		// Skein-MAC; K' = UBI(0, K, Tkey) replaces the zero chaining value ahead of the configuration block
+		for (size_t i = 0; i < key.size(); ++i)
+			key[i] = (byte)i;
+		for (size_t i = 0; i < msg.size(); ++i)
+			msg[i] = (byte)i;
+
+		HexConverter::Decode("0F04381097F505F946252E5CA4923E192512D7064F068DB7802C5E9F957DB3CE", exp);
+		CompareMac(Enumeration::Digests::Skein256, key, msg, exp);
+
+		// a message of exactly one block
+		key.resize(64);
+		msg.resize(64);
+		for (size_t i = 0; i < key.size(); ++i)
+			key[i] = (byte)i;
+
+		HexConverter::Decode("2308F5418EC03C53476615DC0CBEFE257ABD84CBEEC791E8CD0093520F04B39C080B17C5629B65E3E83565B4E0193D4B9565F66A805DB3E5FC363D5B5900BCA7", exp);
+		CompareMac(Enumeration::Digests::Skein512, key, msg, exp);
+
+		// an empty message
+		msg.clear();
+		HexConverter::Decode("54F7518545762B1003D548DFDBC81725894B30DA23BD8C3DC045641EF87361A6585B7EC242A339167F846445F2B682E4BE7D216FC12D24735C535C703E45FBAF", exp);
+		CompareMac(Enumeration::Digests::Skein512, key, msg, exp);
+
+		// a key longer than one block
+		key.resize(160);
+		msg.resize(200);
+		for (size_t i = 0; i < key.size(); ++i)
+			key[i] = (byte)i;
+		for (size_t i = 0; i < msg.size(); ++i)
+			msg[i] = (byte)(i * 3);
+
+		HexConverter::Decode("32A208467262393143BF40E84C31A936C1DD8742E4E8CF8D458656FC09EA153891EB63070C4684C9370127AB32B13D770CD9ABCDACDAA8608B666E2DC597C241"
+			"889275EE25DC248734BC59D90D8DF885DBA63227873050936ADBEAF8687EC9F60898BFEAFEDBD722FD19F7BB336A3ECE5486DCF4A697976F37F351BE5C3B719A", exp);
+		CompareMac(Enumeration::Digests::Skein1024, key, msg, exp);
+	}
+
 	void SkeinTest::OnProgress(std::string Data)
 	{
 		m_progressEvent(Data);
@@ -57,7 +57,9 @@ namespace Test
 	private:
 		void CompareParallel(IDigest* Dgt1, IDigest* Dgt2);
 		void CompareVector(IDigest* Digest, std::vector<byte> &Input, std::vector<byte> &Expected);
+		void CompareMac(Enumeration::Digests DigestType, std::vector<byte> &Key, std::vector<byte> &Input, std::vector<byte> &Expected);
 		void Initialize();
+		void MacTest();
 		void OnProgress(std::string Data);
 		void TreeParamsTest();
 	};
@@ -0,0 +1,472 @@
+#include "SphincsPlusTest.h"
+#include "../CEX/BCR.h"
+#include "../CEX/IAsymmetricKeyPair.h"
+#include "../CEX/MemoryStream.h"
+#include "../CEX/SecureRandom.h"
+#include "../CEX/SHA256.h"
+#include "../CEX/SphincsPlus.h"
+#include "../CEX/SPXCore.h"
+#include "../CEX/SPXKeyPair.h"
+#include "../CEX/SPXPrivateKey.h"
+#include "../CEX/SPXPublicKey.h"
+
+namespace Test
+{
+	using namespace Key::Asymmetric;
+	using namespace Cipher::Asymmetric::Sign::SPHINCS;
+
+	const std::string SphincsPlusTest::DESCRIPTION = "SphincsPlus key generation, signing, and verification tests..";
+	const std::string SphincsPlusTest::FAILURE = "FAILURE! ";
+	const std::string SphincsPlusTest::SUCCESS = "SUCCESS! SphincsPlus tests have executed succesfully.";
+
+	SphincsPlusTest::SphincsPlusTest()
+		:
+		m_expected(0),
+		m_progressEvent()
+	{
+	}
+
+	SphincsPlusTest::~SphincsPlusTest()
+	{
+	}
+
+	std::string SphincsPlusTest::Run()
+	{
+		try
+		{
+			Initialize();
+
+			KnownAnswerTest();
+			OnProgress(std::string("SphincsPlusTest: Passed the deterministic known answer tests for all twelve parameter sets.."));
+			StressLoop();
+			OnProgress(std::string("SphincsPlusTest: Passed signing and verification stress tests.."));
+			ParallelCompare();
+			OnProgress(std::string("SphincsPlusTest: Passed parallel signing tests.."));
+			SerializationCompare();
+			OnProgress(std::string("SphincsPlusTest: Passed key serialization tests.."));
+			AcvpCompare();
+			OnProgress(std::string("SphincsPlusTest: Passed the NIST ACVP key generation and signature generation vector tests.."));
+
+			return SUCCESS;
+		}
+		catch (TestException const &ex)
+		{
+			throw TestException(FAILURE + std::string(" : ") + ex.Message());
+		}
+		catch (...)
+		{
+			throw TestException(FAILURE + std::string(" : Unknown Error"));
+		}
+	}
+
+	void SphincsPlusTest::AcvpCompare()
+	{
+		const std::vector<std::string> SETS =
+		{
+			"SLH-DSA-SHA2-128s", "SLH-DSA-SHA2-128f", "SLH-DSA-SHA2-192s", "SLH-DSA-SHA2-192f", "SLH-DSA-SHA2-256s", "SLH-DSA-SHA2-256f",
+			"SLH-DSA-SHAKE-128s", "SLH-DSA-SHAKE-128f", "SLH-DSA-SHAKE-192s", "SLH-DSA-SHAKE-192f", "SLH-DSA-SHAKE-256s", "SLH-DSA-SHAKE-256f"
+		};
+		const std::vector<Enumeration::SPXParams> PARAMS =
+		{
+			Enumeration::SPXParams::SHA2S128, Enumeration::SPXParams::SHA2F128, Enumeration::SPXParams::SHA2S192,
+			Enumeration::SPXParams::SHA2F192, Enumeration::SPXParams::SHA2S256, Enumeration::SPXParams::SHA2F256,
+			Enumeration::SPXParams::SHAKES128, Enumeration::SPXParams::SHAKEF128, Enumeration::SPXParams::SHAKES192,
+			Enumeration::SPXParams::SHAKEF192, Enumeration::SPXParams::SHAKES256, Enumeration::SPXParams::SHAKEF256
+		};
+
+		std::vector<std::map<std::string, std::string>> cases;
+		std::vector<size_t> genCount(SETS.size(), 0);
+		std::vector<size_t> sigCount(SETS.size(), 0);
+		std::vector<byte> ctx(0);
+		std::vector<byte> exp(0);
+		std::vector<byte> msg(0);
+		std::vector<byte> optRand(0);
+		std::vector<byte> pk(0);
+		std::vector<byte> seed(0);
+		std::vector<byte> sig(0);
+		std::vector<byte> sk(0);
+		std::string data;
+
+		// slh_keygen_internal(SK.seed, SK.prf, PK.seed) must reproduce the official keys;
+		// the small signature sets are slow, so the first vector of each parameter set is checked
+		TestUtils::Read(TestFiles::ACVP::SLHDSAKEYGEN, data);
+		TestUtils::ParseAcvp(data, cases);
+
+		for (size_t i = 0; i < cases.size(); ++i)
+		{
+			const size_t SETIDX = std::find(SETS.begin(), SETS.end(), cases[i]["parameterSet"]) - SETS.begin();
+
+			if (SETIDX == SETS.size() || genCount[SETIDX] != 0 || cases[i].count("skSeed") == 0)
+			{
+				continue;
+			}
+
+			SPXParamSet params;
+			SPXCore::GetParamSet(params, PARAMS[SETIDX]);
+			HexConverter::Decode(cases[i]["skSeed"] + cases[i]["skPrf"] + cases[i]["pkSeed"], seed);
+			SPXCore::Generate(pk, sk, seed, params, true);
+
+			HexConverter::Decode(cases[i]["pk"], exp);
+
+			if (pk != exp)
+			{
+				throw TestException("SphincsPlusTest: The public key does not match the ACVP vector " + cases[i]["tcId"] + "!");
+			}
+
+			HexConverter::Decode(cases[i]["sk"], exp);
+
+			if (sk != exp)
+			{
+				throw TestException("SphincsPlusTest: The private key does not match the ACVP vector " + cases[i]["tcId"] + "!");
+			}
+
+			++genCount[SETIDX];
+		}
+
+		// slh_sign_internal(M', SK, opt_rand); the pure external groups format M' = 0 || |ctx| || ctx || M, the internal
+		// groups sign the message as M', and the deterministic variant uses PK.seed as opt_rand; pre-hash groups are not covered
+		TestUtils::Read(TestFiles::ACVP::SLHDSASIGGEN, data);
+		TestUtils::ParseAcvp(data, cases);
+
+		for (size_t i = 0; i < cases.size(); ++i)
+		{
+			const size_t SETIDX = std::find(SETS.begin(), SETS.end(), cases[i]["parameterSet"]) - SETS.begin();
+			const std::string IFACE = cases[i]["signatureInterface"];
+
+			if (SETIDX == SETS.size() || sigCount[SETIDX] != 0)
+			{
+				continue;
+			}
+
+			HexConverter::Decode(cases[i]["message"], msg);
+
+			if (IFACE == "external" && cases[i]["preHash"] == "pure")
+			{
+				HexConverter::Decode(cases[i]["context"], ctx);
+				msg.insert(msg.begin(), ctx.begin(), ctx.end());
+				msg.insert(msg.begin(), static_cast<byte>(ctx.size()));
+				msg.insert(msg.begin(), 0x00);
+			}
+			else if (IFACE != "internal")
+			{
+				continue;
+			}
+
+			SPXParamSet params;
+			SPXCore::GetParamSet(params, PARAMS[SETIDX]);
+			HexConverter::Decode(cases[i]["sk"], sk);
+
+			if (cases[i]["deterministic"] == "true")
+			{
+				optRand.assign(sk.begin() + (2 * params.N), sk.begin() + (3 * params.N));
+			}
+			else
+			{
+				HexConverter::Decode(cases[i]["additionalRandomness"], optRand);
+			}
+
+			HexConverter::Decode(cases[i]["signature"], exp);
+			sig.clear();
+			SPXCore::SignInternal(sig, msg, sk, optRand, params, true);
+
+			if (sig != exp)
+			{
+				throw TestException("SphincsPlusTest: The signature does not match the ACVP vector " + cases[i]["tcId"] + "!");
+			}
+
+			++sigCount[SETIDX];
+		}
+
+		for (size_t i = 0; i < SETS.size(); ++i)
+		{
+			if (genCount[i] == 0 || sigCount[i] == 0)
+			{
+				throw TestException("SphincsPlusTest: The ACVP vector files have no tests for " + SETS[i] + "!");
+			}
+		}
+	}
+
+	void SphincsPlusTest::Initialize()
+	{
+		const char* expectedEnc[30] =
+		{
+			// regression values: the public key, and the SHA2-256 hash of the signature, for each set in KnownAnswerTest
+			("202122232425262728292A2B2C2D2E2F990CE6298792B128846A8E4A3A68954C"),
+			("5502E5D4E82341AEE35FBAC0D11628C75985B40AF7F1360CD270D2F96B3388C3"),
+			("202122232425262728292A2B2C2D2E2F3B56E816847F000386AEEC2E2BB9E1B5"),
+			("6C9DCFDE328291CD895F9D69ECCE5B76DD407CB4D8284E8CBCE73522DAA78CF5"),
+			("303132333435363738393A3B3C3D3E3F4041424344454647B6F282CE116FF59BCE2D9FC4A67C6031DABDCE326C34F541"),
+			("3CB97B43E6C2B40050EED1B6D2B3DEB77FDB4353A31AD5CA1F3FB004115EB5C8"),
+			("303132333435363738393A3B3C3D3E3F40414243444546479236CCEBBB3A90AC2452DD89DE49DAB1340EC02419A2870E"),
+			("3EF1316A0C98D6EFAF41D21035190B2011BEAD1BC753427186F3AB2C2EA49242"),
+			("404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5FDA7163E601352515BC0F06F9F4F44BE71A5A65EE9DCA5575CF4A7B6D4A87D6E2"),
+			("C4101B3BE29783CFB94F98CAA32174F2BD0E6654B5AFE087F5C5881B1FEB87BE"),
+			("404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F42CFFE64DDBD6731063752684DF77C8B58C225DC6B491208916B654EA1393176"),
+			("93DE1E069A26E92E21F454277CCF14AEBD3AE59AD22E8A5AE65D13573C740FC7"),
+			("202122232425262728292A2B2C2D2E2F89FD81FDBB5B94129B14761BDC6BF682"),
+			("9F14DB761764AE7BC3BCF33F55A889E5DFBF9490E7EA86CB2F29448E2FB05E71"),
+			("202122232425262728292A2B2C2D2E2FA90E4715B9A925C332801767FD786371"),
+			("7522C60FAC7D13458C8D129125EC16B88B3EEE38D3222E4F66B3D26C6B8330BE"),
+			("303132333435363738393A3B3C3D3E3F4041424344454647EB247F955D8ECA24A5860536C56B2C4D1E8D8E835EB27D2D"),
+			("F5AB51364F9BF5C5808BC2F5309F4F09139A9ACF59CBF3DA94EFD3E31E206BFC"),
+			("303132333435363738393A3B3C3D3E3F40414243444546473F01B06BEBED020A459696868D115FE8507DED8DC08E825D"),
+			("82A8E1471EF2BE1461EE7DDEBD6C92EA745D97BAA10671E4E2B44B80B951DEAC"),
+			("404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F27EA444DBC8CA9C169FD484B9E977EB77A4F233550757E025CF180EDE7E8839F"),
+			("5F216A32063B2EA16B0FAE7F24260DB2D13B078F185A75C9A8106897752DB77F"),
+			("404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F818D7E76BEEF979B5BBF9161FDEFA21BD0FE0BFE19157A5711A8DE8A8F6878E6"),
+			("04DDE2A7AF2227D4D662138279D22FAEA480854A9B97754C9E46647BF04472F3"),
+			// the signature randomizer R = PRF_msg(SK.prf, opt_rand, 00 00 || M), shared by the s and f variants;
+			// HMAC-SHA2-256 for SHA2-128, HMAC-SHA2-512 for SHA2-192 and SHA2-256, and SHAKE256 for the SHAKE sets
+			("71FF36DB6BD5E06CCC438AEC66756A93"),
+			("283117733DBC4AA3EC918236359238B91D60A9C1082872F8"),
+			("C762D16CDDFDA3F900BF26E943BD5E80289779E7E919FD69D0D08C9A1CFC3A30"),
+			("15497AEEB70A304CE6C46F9CFD728370"),
+			("E74C5512A58363F60F8977FF917BBCC0D79F17B03F790F35"),
+			("6E194F641A4126EB7A939981363D01FDDC29635C4C1823749C4FEBEC327A5365")
+		};
+		HexConverter::Decode(expectedEnc, 30, m_expected);
+	}
+
+	void SphincsPlusTest::KnownAnswerTest()
+	{
+		const std::vector<Enumeration::SPXParams> PARAMS =
+		{
+			Enumeration::SPXParams::SHA2S128,
+			Enumeration::SPXParams::SHA2F128,
+			Enumeration::SPXParams::SHA2S192,
+			Enumeration::SPXParams::SHA2F192,
+			Enumeration::SPXParams::SHA2S256,
+			Enumeration::SPXParams::SHA2F256,
+			Enumeration::SPXParams::SHAKES128,
+			Enumeration::SPXParams::SHAKEF128,
+			Enumeration::SPXParams::SHAKES192,
+			Enumeration::SPXParams::SHAKEF192,
+			Enumeration::SPXParams::SHAKES256,
+			Enumeration::SPXParams::SHAKEF256
+		};
+
+		// the FIPS 205 signature sizes, in the same order as the parameter sets
+		const size_t SIGSIZE[6] = { 7856, 17088, 16224, 35664, 29792, 49856 };
+		std::vector<byte> hash(32);
+		std::vector<byte> msg(33);
+		std::vector<byte> optRand(0);
+		std::vector<byte> pk(0);
+		std::vector<byte> seed(0);
+		std::vector<byte> sig(0);
+		std::vector<byte> sk(0);
+
+		// SK.seed || SK.prf || PK.seed = 00 01 02 .., M = 00 01 .. 20, pure mode with an empty context,
+		// and the deterministic variant with opt_rand = PK.seed; the pinned keys and signature hashes are regression values
+		// from a python transcription of FIPS 205 written alongside this code, the official NIST vectors are checked by AcvpCompare
+		for (size_t i = 0; i < msg.size(); ++i)
+		{
+			msg[i] = static_cast<byte>(i);
+		}
+
+		for (size_t i = 0; i < PARAMS.size(); ++i)
+		{
+			SPXParamSet params;
+			Digest::SHA256 dgt;
+
+			SPXCore::GetParamSet(params, PARAMS[i]);
+			seed.resize(3 * params.N);
+
+			for (size_t j = 0; j < seed.size(); ++j)
+			{
+				seed[j] = static_cast<byte>(j);
+			}
+
+			SPXCore::Generate(pk, sk, seed, params, true);
+
+			if (pk != m_expected[2 * i])
+			{
+				throw TestException("SphincsPlusTest: The public key does not match the known answer!");
+			}
+
+			// pk = PK.seed || PK.root, and sk = SK.seed || SK.prf || PK.seed || PK.root
+			if (sk.size() != 4 * params.N || std::vector<byte>(sk.begin(), sk.begin() + (3 * params.N)) != seed || std::vector<byte>(sk.begin() + (2 * params.N), sk.end()) != pk)
+			{
+				throw TestException("SphincsPlusTest: The private key is not encoded as the standard requires!");
+			}
+
+			optRand.assign(pk.begin(), pk.begin() + params.N);
+			sig.clear();
+			SPXCore::Sign(sig, msg, 0, msg.size(), sk, optRand, params, true);
+
+			if (sig.size() != params.SignatureSize || sig.size() != SIGSIZE[i % 6])
+			{
+				throw TestException("SphincsPlusTest: The known answer signature size is invalid!");
+			}
+
+			if (std::vector<byte>(sig.begin(), sig.begin() + params.N) != m_expected[24 + (i / 2)])
+			{
+				throw TestException("SphincsPlusTest: The signature randomizer is not derived as the standard requires!");
+			}
+
+			dgt.Compute(sig, hash);
+
+			if (hash != m_expected[(2 * i) + 1])
+			{
+				throw TestException("SphincsPlusTest: The signature does not match the known answer!");
+			}
+
+			if (!SPXCore::Verify(sig, msg, 0, msg.size(), pk, params))
+			{
+				throw TestException("SphincsPlusTest: The known answer signature failed verification!");
+			}
+		}
+	}
+
+	void SphincsPlusTest::ParallelCompare()
+	{
+		std::vector<byte> msg(64);
+		std::vector<byte> sig(0);
+		Prng::SecureRandom rnd;
+
+		// signatures made by the multi-threaded signer must verify with a sequential instance
+		SphincsPlus sgn1(Enumeration::SPXParams::SHA2F128, Enumeration::Prngs::BCR, true);
+		SphincsPlus sgn2(Enumeration::SPXParams::SHA2F128, Enumeration::Prngs::BCR, false);
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			rnd.GetBytes(msg);
+			IAsymmetricKeyPair* kp = sgn1.Generate();
+
+			sgn1.Initialize(*kp->PrivateKey());
+			sgn1.Sign(msg, 0, msg.size(), sig, 0);
+
+			sgn2.Initialize(*kp->PublicKey());
+			bool valid = sgn2.Verify(msg, 0, msg.size(), sig);
+
+			delete kp->PrivateKey();
+			delete kp->PublicKey();
+			delete kp;
+
+			if (!valid)
+			{
+				throw TestException("SphincsPlusTest: Parallel signature failed verification!");
+			}
+		}
+	}
+
+	void SphincsPlusTest::SerializationCompare()
+	{
+		std::vector<byte> skey;
+
+		SphincsPlus sgn(Enumeration::SPXParams::SHAKEF128);
+
+		for (size_t i = 0; i < 10; ++i)
+		{
+			IAsymmetricKeyPair* kp = sgn.Generate();
+			SPXPrivateKey* priK1 = (SPXPrivateKey*)kp->PrivateKey();
+			skey = priK1->ToBytes();
+			SPXPrivateKey priK2(skey);
+
+			if (priK1->S() != priK2.S() || priK1->Parameters() != priK2.Parameters())
+			{
+				throw TestException("SphincsPlusTest: Private key serialization test has failed!");
+			}
+
+			SPXPublicKey* pubK1 = (SPXPublicKey*)kp->PublicKey();
+			skey = pubK1->ToBytes();
+			SPXPublicKey pubK2(skey);
+
+			if (pubK1->P() != pubK2.P() || pubK1->Parameters() != pubK2.Parameters())
+			{
+				throw TestException("SphincsPlusTest: Public key serialization test has failed!");
+			}
+
+			delete kp;
+			delete priK1;
+			delete pubK1;
+		}
+	}
+
+	void SphincsPlusTest::StressLoop()
+	{
+		const std::vector<Enumeration::SPXParams> PARAMS =
+		{
+			Enumeration::SPXParams::SHA2F128,
+			Enumeration::SPXParams::SHA2F192,
+			Enumeration::SPXParams::SHA2F256,
+			Enumeration::SPXParams::SHAKEF128,
+			Enumeration::SPXParams::SHAKEF192,
+			Enumeration::SPXParams::SHAKEF256
+		};
+
+		std::vector<byte> msg(128);
+		std::vector<byte> sig(0);
+		Prng::SecureRandom rnd;
+		Prng::BCR* rngPtr = new Prng::BCR();
+
+		for (size_t i = 0; i < PARAMS.size(); ++i)
+		{
+			SphincsPlus sgn(PARAMS[i], rngPtr);
+
+			for (size_t j = 0; j < 2; ++j)
+			{
+				rnd.GetBytes(msg);
+				IAsymmetricKeyPair* kp = sgn.Generate();
+
+				sgn.Initialize(*kp->PrivateKey());
+				// sign at an offset within the output array
+				sgn.Sign(msg, 0, msg.size(), sig, 8);
+
+				if (sig.size() != sgn.SignatureSize() + 8)
+				{
+					throw TestException("SphincsPlusTest: The signature size is invalid!");
+				}
+
+				sig.erase(sig.begin(), sig.begin() + 8);
+				sgn.Initialize(*kp->PublicKey());
+
+				if (!sgn.Verify(msg, 0, msg.size(), sig))
+				{
+					throw TestException("SphincsPlusTest: The signature failed verification!");
+				}
+
+				// the stream interface signs the same bytes
+				IO::MemoryStream mst(msg);
+
+				if (!sgn.Verify(mst, 0, msg.size(), sig))
+				{
+					throw TestException("SphincsPlusTest: The stream signature failed verification!");
+				}
+
+				// a changed message must fail
+				msg[j] ^= 1;
+
+				if (sgn.Verify(msg, 0, msg.size(), sig))
+				{
+					throw TestException("SphincsPlusTest: A modified message passed verification!");
+				}
+
+				// a changed signature must fail
+				msg[j] ^= 1;
+				sig[sig.size() / 2] ^= 1;
+
+				if (sgn.Verify(msg, 0, msg.size(), sig))
+				{
+					throw TestException("SphincsPlusTest: A modified signature passed verification!");
+				}
+
+				delete kp->PrivateKey();
+				delete kp->PublicKey();
+				delete kp;
+				sig.clear();
+			}
+		}
+
+		if (rngPtr == nullptr)
+		{
+			throw TestException("SphincsPlusTest: Prng was reset!");
+		}
+
+		delete rngPtr;
+	}
+
+	void SphincsPlusTest::OnProgress(std::string Data)
+	{
+		m_progressEvent(Data);
+	}
+}
@@ -0,0 +1,59 @@
+#ifndef _CEXTEST_SPHINCSPLUSTEST_H
+#define _CEXTEST_SPHINCSPLUSTEST_H
+
+#include "ITest.h"
+
+namespace Test
+{
+	/// <summary>
+	/// SphincsPlus key generation, signing, and verification tests
+	/// </summary>
+	class SphincsPlusTest : public ITest
+	{
+	private:
+		static const std::string DESCRIPTION;
+		static const std::string FAILURE;
+		static const std::string SUCCESS;
+
+		std::vector<std::vector<byte>> m_expected;
+		TestEventHandler m_progressEvent;
+
+	public:
+		/// <summary>
+		/// Get: The test description
+		/// </summary>
+		virtual const std::string Description() { return DESCRIPTION; }
+
+		/// <summary>
+		/// Progress return event callback
+		/// </summary>
+		virtual TestEventHandler &Progress() { return m_progressEvent; }
+
+		/// <summary>
+		/// 
+		/// </summary>
+		SphincsPlusTest();
+
+		/// <summary>
+		/// Destructor
+		/// </summary>
+		~SphincsPlusTest();
+
+		/// <summary>
+		/// Start the tests
+		/// </summary>
+		virtual std::string Run();
+
+	private:
+
+		void AcvpCompare();
+		void Initialize();
+		void KnownAnswerTest();
+		void OnProgress(std::string Data);
+		void ParallelCompare();
+		void SerializationCompare();
+		void StressLoop();
+	};
+}
+
+#endif
@@ -29,6 +29,8 @@ namespace Test
 			OnProgress(std::string("SymmetricKeyGenerator: Passed initialization tests.."));
 			CheckAccess();
 			OnProgress(std::string("SymmetricKeyGenerator: Passed output comparison tests.."));
+			CheckBulk();
+			OnProgress(std::string("SymmetricKeyGenerator: Passed bulk mode and batch generation tests.."));
 
 			return SUCCESS;
 		}
@@ -66,6 +68,53 @@ namespace Test
 			throw TestException("CheckAccess: The key is invalid!");
 	}
 
+	void SymmetricKeyGeneratorTest::CheckBulk()
+	{
+		// test the bulk mode generators and batch output
+		const size_t KEYCNT = 100;
+		SymmetricKeySize keySize(32, 16, 0);
+		CpuDetect detect;
+
+		SymmetricKeyGenerator keyGen1(Digests::SHA512, Providers::CSP, Drbgs::HCG);
+		// force several reseed cycles
+		keyGen1.ReseedThreshold() = 1024;
+		std::vector<SymmetricKey> keys1 = keyGen1.Generate(KEYCNT, keySize);
+
+		if (keys1.size() != KEYCNT)
+			throw TestException("CheckBulk: The batch size is invalid!");
+
+		for (size_t i = 0; i < keys1.size(); ++i)
+		{
+			if (!IsValidKey(keys1[i]))
+				throw TestException("CheckBulk: Key generation has failed!");
+			if (keys1[i].Key().size() != keySize.KeySize() || keys1[i].Nonce().size() != keySize.NonceSize())
+				throw TestException("CheckBulk: The key size is invalid!");
+			if (i != 0 && keys1[i].Key() == keys1[i - 1].Key())
+				throw TestException("CheckBulk: The generator produced a duplicate key!");
+		}
+
+		std::vector<byte> data(1024);
+		keyGen1.GetBytes(data);
+		if (!IsGoodRun(data))
+			throw TestException("CheckBulk: The output is invalid!");
+
+		SymmetricKey symKey1 = keyGen1.GetSymmetricKey(SymmetricKeySize(64, 16, 64));
+		if (!IsValidKey(symKey1))
+			throw TestException("CheckBulk: Key generation has failed!");
+
+		if (detect.AESNI())
+		{
+			SymmetricKeyGenerator keyGen2(Digests::SHA256, Providers::CSP, Drbgs::BCG);
+			std::vector<SymmetricKey> keys2 = keyGen2.Generate(KEYCNT, SymmetricKeySize(64, 0, 0));
+
+			for (size_t i = 0; i < keys2.size(); ++i)
+			{
+				if (!IsValidKey(keys2[i]))
+					throw TestException("CheckBulk: Key generation has failed!");
+			}
+		}
+	}
+
 	void SymmetricKeyGeneratorTest::CheckInit()
 	{
 		// test each access interface for valid output
@@ -46,6 +46,7 @@ namespace Test
 
 	private:
 		void CheckAccess();
+		void CheckBulk();
 		void CheckInit();
 		bool IsGoodRun(const std::vector<byte> &Input);
 		bool IsValidKey(Key::Symmetric::ISymmetricKey &KeyParam);
@@ -1,7 +1,9 @@
 #include "SymmetricKeyTest.h"
 #include "../CEX/CSP.h"
 #include "../CEX/MemoryStream.h"
+#include "../CEX/ParallelUtils.h"
 #include "../CEX/SymmetricKeyGenerator.h"
+#include <atomic>
 
 namespace Test
 {
@@ -30,6 +32,10 @@ namespace Test
 			OnProgress(std::string("SymmetricKeyTest: Passed initialization tests.."));
 			CheckAccess();
 			OnProgress(std::string("SymmetricKeyTest: Passed output comparison tests.."));
+			CheckView();
+			OnProgress(std::string("SymmetricKeyTest: Passed key view tests.."));
+			CheckConcurrentView();
+			OnProgress(std::string("SymmetricKeyTest: Passed concurrent key view tests.."));
 			CompareSerial();
 			OnProgress(std::string("SymmetricKeyTest: Passed key serialization tests.."));
 
@@ -73,6 +79,53 @@ namespace Test
 			throw TestException("CheckAccess: The secure info is invalid!");
 	}
 
+	void SymmetricKeyTest::CheckConcurrentView()
+	{
+		const size_t THDCNT = 8;
+		const size_t VIEWCNT = 1000;
+		Provider::CSP rnd;
+		std::vector<byte> key = rnd.GetBytes(32);
+		std::vector<byte> iv = rnd.GetBytes(16);
+		std::vector<byte> info = rnd.GetBytes(64);
+		SymmetricSecureKey secKey(key, iv, info);
+		std::atomic<size_t> errCount(0);
+
+		// open and release views on one key from several threads; the shared plaintext copy
+		// must stay valid while any view is open, and must not be erased under a reader
+		Utility::ParallelUtils::ParallelFor(0, THDCNT, [&secKey, &key, &iv, &info, &errCount, VIEWCNT](size_t)
+		{
+			for (size_t i = 0; i < VIEWCNT; ++i)
+			{
+				SymmetricKeyView keyView(secKey);
+
+				if (keyView.Key() != key || keyView.Nonce() != iv || keyView.Info() != info)
+				{
+					++errCount;
+				}
+			}
+		});
+
+		if (errCount != 0)
+			throw TestException("CheckConcurrentView: A concurrent secure key view is invalid!");
+
+		// the copy holds the same encrypted state, and no open views
+		SymmetricSecureKey cpyKey(secKey);
+
+		if (!cpyKey.Equals(secKey) || cpyKey.Key() != key)
+			throw TestException("CheckConcurrentView: The copied secure key is invalid!");
+
+		// a moved key takes the encrypted state, and the source is left empty
+		SymmetricSecureKey movKey(std::move(cpyKey));
+
+		if (!movKey.Equals(secKey) || cpyKey.KeySizes().KeySize() != 0)
+			throw TestException("CheckConcurrentView: The moved secure key is invalid!");
+
+		cpyKey = std::move(movKey);
+
+		if (cpyKey.Key() != key || cpyKey.Nonce() != iv || movKey.KeySizes().KeySize() != 0)
+			throw TestException("CheckConcurrentView: The move assigned secure key is invalid!");
+	}
+
 	void SymmetricKeyTest::CheckInit()
 	{
 		Provider::CSP rnd;
@@ -119,6 +172,54 @@ namespace Test
 			throw TestException("CheckInit: The secure key is invalid!");
 	}
 
+	void SymmetricKeyTest::CheckView()
+	{
+		Provider::CSP rnd;
+		std::vector<byte> key = rnd.GetBytes(32);
+		std::vector<byte> iv = rnd.GetBytes(16);
+		std::vector<byte> info = rnd.GetBytes(64);
+
+		// test the move constructors
+		std::vector<byte> tmpKey = key;
+		std::vector<byte> tmpIv = iv;
+		std::vector<byte> tmpInfo = info;
+		SymmetricKey symKey(std::move(tmpKey), std::move(tmpIv), std::move(tmpInfo));
+
+		if (symKey.Key() != key || symKey.Nonce() != iv || symKey.Info() != info)
+			throw TestException("CheckView: The moved symmetric key is invalid!");
+
+		// test a view of a symmetric key
+		{
+			SymmetricKeyView keyView(symKey);
+
+			if (keyView.Key() != key || keyView.Nonce() != iv || keyView.Info() != info)
+				throw TestException("CheckView: The symmetric key view is invalid!");
+			if (keyView.KeySizes().KeySize() != key.size())
+				throw TestException("CheckView: The symmetric key view sizes are invalid!");
+		}
+
+		// test nested views of a secure key
+		SymmetricSecureKey secKey(key, iv, info);
+
+		{
+			SymmetricKeyView outView(secKey);
+
+			{
+				SymmetricKeyView inView(secKey);
+
+				if (inView.Key() != key || inView.Nonce() != iv || inView.Info() != info)
+					throw TestException("CheckView: The nested secure key view is invalid!");
+			}
+
+			if (outView.Key() != key || outView.Nonce() != iv || outView.Info() != info)
+				throw TestException("CheckView: The secure key view is invalid!");
+		}
+
+		// the key is still accessible after the views are released
+		if (secKey.Key() != key || !secKey.Equals(symKey))
+			throw TestException("CheckView: The secure key is invalid after release!");
+	}
+
 	void SymmetricKeyTest::CompareSerial()
 	{
 		SymmetricKeySize keySize(64, 16, 64);
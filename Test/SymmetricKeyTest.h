@@ -49,7 +49,9 @@ namespace Test
 	private:
 
 		void CheckAccess();
+		void CheckConcurrentView();
 		void CheckInit();
+		void CheckView();
 		void CompareSerial();
 		void OnProgress(std::string Data);
 	};
@@ -172,10 +172,15 @@
 #include "../Test/TestFiles.h"
 #include "../Test/TestUtils.h"
 #include "../Test/AEADTest.h"
+#include "../Test/AeadBatchTest.h"
+#include "../Test/AllocationTest.h"
 #include "../Test/AesAvsTest.h"
 #include "../Test/AesFipsTest.h"
+#include "../Test/ARGON2Test.h"
 #include "../Test/AsymmetricSpeedTest.h"
+#include "../Test/AsyncFileStreamTest.h"
 #include "../Test/Blake2Test.h"
+#include "../Test/Blake3Test.h"
 #include "../Test/ChaChaTest.h"
 #include "../Test/CipherModeTest.h"
 #include "../Test/CipherSpeedTest.h"
@@ -186,9 +191,12 @@
 #include "../Test/DCGTest.h"
 #include "../Test/DigestSpeedTest.h"
 #include "../Test/DigestStreamTest.h"
+#include "../Test/DilithiumTest.h"
 #include "../Test/GMACTest.h"
+#include "../Test/K12Test.h"
 #include "../Test/KDF2Test.h"
 #include "../Test/KeccakTest.h"
+#include "../Test/KMACTest.h"
 #include "../Test/HKDFTest.h"
 #include "../Test/HMACTest.h"
 #include "../Test/HMGTest.h"
@@ -197,6 +205,7 @@
 #include "../Test/MacStreamTest.h"
 #include "../Test/McElieceTest.h"
 #include "../Test/MemUtilsTest.h"
+#include "../Test/ModuleLWETest.h"
 #include "../Test/PaddingTest.h"
 #include "../Test/ParallelModeTest.h"
 #include "../Test/PBKDF2Test.h"
@@ -206,12 +215,16 @@
 #include "../Test/RingLWETest.h"
 #include "../Test/SalsaTest.h"
 #include "../Test/SCRYPTTest.h"
+#include "../Test/SecureArenaTest.h"
 #include "../Test/SecureStreamTest.h"
+#include "../Test/SegmentTest.h"
 #include "../Test/SerpentTest.h"
 #include "../Test/Sha2Test.h"
+#include "../Test/SHAKETest.h"
 #include "../Test/SimdSpeedTest.h"
 #include "../Test/SimdWrapperTest.h"
 #include "../Test/SkeinTest.h"
+#include "../Test/SphincsPlusTest.h"
 #include "../Test/SymmetricKeyGeneratorTest.h"
 #include "../Test/SymmetricKeyTest.h"
 #include "../Test/TwofishTest.h"
@@ -442,32 +455,41 @@ int main()
 			RunTest(new CipherModeTest());
 			PrintHeader("TESTING SYMMETRIC CIPHER AEAD MODES");
 			RunTest(new AEADTest());
+			RunTest(new AeadBatchTest());
 			PrintHeader("TESTING PARALLEL CIPHER MODES");
 			RunTest(new ParallelModeTest());
+			PrintHeader("TESTING SCATTER-GATHER SEGMENTS");
+			RunTest(new SegmentTest());
 			PrintHeader("TESTING CIPHER PADDING MODES");
 			RunTest(new PaddingTest());
 			PrintHeader("TESTING SYMMETRIC STREAM CIPHERS");
 			RunTest(new ChaChaTest());
 			RunTest(new SalsaTest());
 			PrintHeader("TESTING CRYPTOGRAPHIC STREAM PROCESSORS");
+			RunTest(new AsyncFileStreamTest());
 			RunTest(new CipherStreamTest());
 			RunTest(new DigestStreamTest());
 			RunTest(new MacStreamTest());
 			PrintHeader("TESTING CRYPTOGRAPHIC HASH GENERATORS");
 			RunTest(new Blake2Test());
+			RunTest(new Blake3Test());
+			RunTest(new K12Test());
 			RunTest(new KeccakTest());
 			RunTest(new SHA2Test());
 			RunTest(new SkeinTest());
 			PrintHeader("TESTING MESSAGE AUTHENTICATION CODE GENERATORS");
 			RunTest(new CMACTest());
 			RunTest(new HMACTest());
+			RunTest(new KMACTest());
 			PrintHeader("TESTING PSEUDO RANDOM NUMBER GENERATORS");
 			RunTest(new PrngTest());
 			PrintHeader("TESTING KEY DERIVATION FUNCTIONS");
+			RunTest(new ARGON2Test());
 			RunTest(new HKDFTest());
 			RunTest(new KDF2Test());
 			RunTest(new PBKDF2Test());
 			RunTest(new SCRYPTTest());
+			RunTest(new SHAKETest());
 			PrintHeader("TESTING DETERMINISTIC RANDOM BYTE GENERATORS");
 			RunTest(new CMGTest());
 			RunTest(new DCGTest());
@@ -479,9 +501,16 @@ int main()
 			PrintHeader("TESTING VECTORIZED MEMORY FUNCTIONS");
 			RunTest(new MemUtilsTest());
 			RunTest(new SimdWrapperTest());
+			PrintHeader("TESTING HEAP ALLOCATIONS AND SECURE MEMORY");
+			RunTest(new AllocationTest());
+			RunTest(new SecureArenaTest());
 			PrintHeader("TESTING ASYMMETRIC CIPHERS");
 			RunTest(new RingLWETest());
+			RunTest(new ModuleLWETest());
 			RunTest(new McElieceTest());
+			PrintHeader("TESTING ASYMMETRIC SIGNATURE SCHEMES");
+			RunTest(new SphincsPlusTest());
+			RunTest(new DilithiumTest());
 		}
 		else
 		{
@@ -7,6 +7,17 @@ namespace Test
 {
 	namespace TestFiles
 	{
+		namespace ACVP
+		{
+			// the internalProjection.json files of the NIST ACVP-Server gen-val/json-files folders of the same name
+			const std::string MLDSAKEYGEN = "Vectors/ACVP/ML-DSA-keyGen-FIPS204.json";
+			const std::string MLDSASIGGEN = "Vectors/ACVP/ML-DSA-sigGen-FIPS204.json";
+			const std::string MLKEMENCAPDECAP = "Vectors/ACVP/ML-KEM-encapDecap-FIPS203.json";
+			const std::string MLKEMKEYGEN = "Vectors/ACVP/ML-KEM-keyGen-FIPS203.json";
+			const std::string SLHDSAKEYGEN = "Vectors/ACVP/SLH-DSA-keyGen-FIPS205.json";
+			const std::string SLHDSASIGGEN = "Vectors/ACVP/SLH-DSA-sigGen-FIPS205.json";
+		}
+
 		namespace AESAVS
 		{
 			const std::string AESAVSKEY128 = "Vectors/AESAVS/keyvect128.txt";
@@ -42,6 +42,37 @@ namespace Test
 		return PoChiSq(chisq, 255);
 	}
 
+	bool TestUtils::CompareState(IDigest* Dgt1, IDigest* Dgt2)
+	{
+		const size_t MSGLEN = (Dgt1->ParallelProfile().ParallelMinimumSize() * 8) + 13;
+		const std::vector<size_t> CUTS = { 1, Dgt1->BlockSize(), (MSGLEN / 2) + 3, MSGLEN - 1 };
+		std::vector<byte> input(MSGLEN);
+		std::vector<byte> hash(Dgt1->DigestSize());
+
+		for (size_t i = 0; i < input.size(); ++i)
+			input[i] = (byte)i;
+
+		Dgt1->Compute(input, hash);
+
+		return ResumeState(Dgt1, Dgt2, input, CUTS, hash, [](IDigest* Dgt) { Dgt->Reset(); });
+	}
+
+	bool TestUtils::CompareState(IMac* Mac1, IMac* Mac2, ISymmetricKey &KeyParams)
+	{
+		const std::vector<size_t> CUTS = { 1, 16, 131, 255 };
+		std::vector<byte> input(256);
+		std::vector<byte> code(Mac1->MacSize());
+
+		for (size_t i = 0; i < input.size(); ++i)
+			input[i] = (byte)i;
+
+		Mac1->Initialize(KeyParams);
+		Mac1->Compute(input, code);
+
+		// both macs share the same key; the key is never part of the saved state
+		return ResumeState(Mac1, Mac2, input, CUTS, code, [&KeyParams](IMac* Mac) { Mac->Initialize(KeyParams); });
+	}
+
 	void TestUtils::CopyVector(const std::vector<int> &SrcArray, size_t SrcIndex, std::vector<int> &DstArray, size_t DstIndex, size_t Length)
 	{
 		std::memcpy(&DstArray[DstIndex], &SrcArray[SrcIndex], Length * sizeof(SrcArray[SrcIndex]));
@@ -124,6 +155,28 @@ namespace Test
 		rng.GetBytes(Data);
 	}
 
+	bool TestUtils::IsStateRejected(IDigest* Dgt1, IDigest* Dgt2)
+	{
+		std::vector<byte> input(Dgt1->BlockSize() + 1, 0x5A);
+		bool status = false;
+
+		// a state saved under different tree parameters is rejected, rather than reconfiguring the loading digest
+		Dgt1->Update(input, 0, input.size());
+		std::vector<byte> state = Dgt1->SaveState();
+		Dgt1->Reset();
+
+		try
+		{
+			Dgt2->LoadState(state);
+		}
+		catch (...)
+		{
+			status = true;
+		}
+
+		return status;
+	}
+
 	double TestUtils::MeanValue(std::vector<byte> &Input)
 	{
 		double ret = 0;
@@ -134,6 +187,85 @@ namespace Test
 		return ret / Input.size();
 	}
 
+	void TestUtils::ParseAcvp(const std::string &Contents, std::vector<std::map<std::string, std::string>> &Cases)
+	{
+		std::map<std::string, std::string> header;
+		std::map<std::string, std::string> group;
+		bool inGroup = false;
+		bool inCase = false;
+		size_t pos = 0;
+
+		Cases.clear();
+
+		// the files are a flat walk of "name": value pairs; a tgId opens a test group and a tcId opens a test case,
+		// the group fields precede the tests array, so every case inherits the fields of its group
+		while ((pos = Contents.find('"', pos)) != std::string::npos)
+		{
+			const size_t KEYEND = Contents.find('"', pos + 1);
+
+			if (KEYEND == std::string::npos)
+				break;
+
+			std::string name = Contents.substr(pos + 1, KEYEND - pos - 1);
+			size_t vpos = Contents.find_first_not_of(" \t\r\n", KEYEND + 1);
+			pos = KEYEND + 1;
+
+			// a string inside an array, not a name
+			if (vpos == std::string::npos || Contents[vpos] != ':')
+				continue;
+
+			vpos = Contents.find_first_not_of(" \t\r\n", vpos + 1);
+
+			if (vpos == std::string::npos)
+				break;
+
+			// objects and arrays are walked into, only scalar values are stored
+			if (Contents[vpos] == '{' || Contents[vpos] == '[')
+			{
+				pos = vpos + 1;
+				continue;
+			}
+
+			std::string value;
+
+			if (Contents[vpos] == '"')
+			{
+				const size_t VALEND = Contents.find('"', vpos + 1);
+
+				if (VALEND == std::string::npos)
+					break;
+
+				value = Contents.substr(vpos + 1, VALEND - vpos - 1);
+				pos = VALEND + 1;
+			}
+			else
+			{
+				const size_t VALEND = Contents.find_first_of(",}] \t\r\n", vpos);
+				value = Contents.substr(vpos, VALEND - vpos);
+				pos = VALEND;
+			}
+
+			if (name == "tgId")
+			{
+				group = header;
+				inGroup = true;
+				inCase = false;
+			}
+			else if (name == "tcId")
+			{
+				Cases.push_back(group);
+				inCase = true;
+			}
+
+			if (inCase)
+				Cases.back()[name] = value;
+			else if (inGroup)
+				group[name] = value;
+			else
+				header[name] = value;
+		}
+	}
+
 	double TestUtils::Poz(const double Z)
 	{
 		// borrowed from the ENT project: https://www.fourmilab.ch/random/
@@ -242,7 +374,7 @@ namespace Test
 
 		if (!ifs || !ifs.is_open())
 		{
-			throw TestException("Could not open the KAT file!");
+			throw TestException("Could not open the KAT file: " + FilePath);
 		}
 		else
 		{
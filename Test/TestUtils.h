@@ -2,11 +2,17 @@
 #define _CEXTEST_TESTUTILS_H
 
 #include <algorithm>
+#include <map>
 #include <sstream>
+#include "../CEX/IDigest.h"
+#include "../CEX/IMac.h"
 #include "../CEX/SymmetricKey.h"
 
 namespace Test
 {
+	using CEX::Digest::IDigest;
+	using CEX::Mac::IMac;
+	using CEX::Key::Symmetric::ISymmetricKey;
 	using CEX::Key::Symmetric::SymmetricKey;
 
 	class TestUtils
@@ -28,6 +34,37 @@ namespace Test
 			return oss.str();
 		}
 
+		/// <summary>
+		/// Checkpoint a message on the first digest at several offsets, resume it on the second with LoadState, and compare with a one-pass hash
+		/// </summary>
+		/// 
+		/// <param name="Dgt1">The digest that saves the state</param>
+		/// <param name="Dgt2">The digest that loads the state; must have the same configuration</param>
+		/// 
+		/// <returns>Returns true if every resumed hash matches</returns>
+		static bool CompareState(IDigest* Dgt1, IDigest* Dgt2);
+
+		/// <summary>
+		/// Checkpoint a message on the first mac at several offsets, resume it on the second with LoadState, and compare with a one-pass code
+		/// </summary>
+		/// 
+		/// <param name="Mac1">The mac that saves the state</param>
+		/// <param name="Mac2">The mac that loads the state</param>
+		/// <param name="KeyParams">The key both macs are initialized with</param>
+		/// 
+		/// <returns>Returns true if every resumed code matches</returns>
+		static bool CompareState(IMac* Mac1, IMac* Mac2, ISymmetricKey &KeyParams);
+
+		/// <summary>
+		/// Save a state on the first digest and load it into the second, which has different tree parameters
+		/// </summary>
+		/// 
+		/// <param name="Dgt1">The digest that saves the state</param>
+		/// <param name="Dgt2">The digest that loads the state</param>
+		/// 
+		/// <returns>Returns true if the second digest rejected the state</returns>
+		static bool IsStateRejected(IDigest* Dgt1, IDigest* Dgt2);
+
 		static double MeanValue(std::vector<byte> &Input);
 		static double ChiSquare(std::vector<byte> &Input);
 		static void CopyVector(const std::vector<int> &SrcArray, size_t SrcIndex, std::vector<int> &DstArray, size_t DstIndex, size_t Length);
@@ -36,6 +73,14 @@ namespace Test
 		static SymmetricKey GetRandomKey(size_t KeySize, size_t IvSize);
 		static void GetRandom(std::vector<byte> &Data);
 
+		/// <summary>
+		/// Parse the test cases of a NIST ACVP json vector file; each case holds its own fields and those of its test group
+		/// </summary>
+		/// 
+		/// <param name="Contents">The contents of the vector file</param>
+		/// <param name="Cases">Receives the test cases; strings are stored without quotes, numbers and booleans as written</param>
+		static void ParseAcvp(const std::string &Contents, std::vector<std::map<std::string, std::string>> &Cases);
+
 		static bool Read(const std::string &FilePath, std::string &Contents);
 		static std::vector<byte> Reduce(std::vector<byte> Seed);
 		static void Reverse(std::vector<byte> &Data);
@@ -51,6 +96,30 @@ namespace Test
 		const static double BIGX;
 		static double PoChiSq(const double Ax, const int Df);
 		static double Poz(const double Z);
+
+		template<typename T, typename R>
+		static bool ResumeState(T* Engine1, T* Engine2, const std::vector<byte> &Input, const std::vector<size_t> &Cuts, const std::vector<byte> &Expected, R Rewind)
+		{
+			std::vector<byte> code(Expected.size());
+
+			for (size_t i = 0; i < Cuts.size(); ++i)
+			{
+				// checkpoint the first engine, and resume the message on the second
+				Rewind(Engine1);
+				Engine1->Update(Input, 0, Cuts[i]);
+				std::vector<byte> state = Engine1->SaveState();
+
+				Rewind(Engine2);
+				Engine2->LoadState(state);
+				Engine2->Update(Input, Cuts[i], Input.size() - Cuts[i]);
+				Engine2->Finalize(code, 0);
+
+				if (code != Expected)
+					return false;
+			}
+
+			return true;
+		}
 	};
 }
 #endif